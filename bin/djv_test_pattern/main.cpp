@@ -6,8 +6,8 @@
 
 #include <djvAV/AVSystem.h>
 #include <djvAV/IO.h>
-#include <djvAV/OpenGLOffscreenBuffer.h>
-#include <djvAV/Render2D.h>
+#include <djvAV/Image.h>
+#include <djvAV/Render2DRasterizer.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/Error.h>
@@ -62,8 +62,7 @@ namespace djv
             AV::Image::Info _info;
             std::list<std::shared_ptr<AV::Image::Image> > _images;
             float _x = 0.F;
-            std::shared_ptr<AV::OpenGL::OffscreenBuffer> _offscreenBuffer;
-            std::shared_ptr<AV::Render2D::Render> _render;
+            std::shared_ptr<AV::Render2D::Rasterizer> _rasterizer;
             std::shared_ptr<AV::IO::IWrite> _write;
             std::shared_ptr<Core::Time::Timer> _statsTimer;
         };
@@ -101,8 +100,9 @@ namespace djv
             }
             _info = AV::Image::Info(*_size, *_type);
 
-            _offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(_info.size, _info.type);
-            _render = getSystemT<AV::Render2D::Render>();
+            // The frames are drawn on the CPU so they do not need to be read
+            // back from an OpenGL context.
+            _rasterizer = AV::Render2D::Rasterizer::create();
 
             auto io = getSystemT<AV::IO::System>();
             AV::IO::WriteOptions writeOptions;
@@ -142,31 +142,20 @@ namespace djv
             }
             if (_frame < *_frameCount && !_images.size())
             {
-                const AV::OpenGL::OffscreenBufferBinding binding(_offscreenBuffer);
-                _render->beginFrame(*_size);
-                _render->setFillColor(AV::Image::Color(.5F, .5F, .5F));
-                _render->drawRect(Core::BBox2f(0.F, 0.F, static_cast<float>(_size->w), static_cast<float>(_size->h)));
-                _render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F));
+                _rasterizer->beginFrame(*_size);
+                _rasterizer->setFillColor(AV::Image::Color(.5F, .5F, .5F));
+                _rasterizer->drawRect(Core::BBox2f(0.F, 0.F, static_cast<float>(_size->w), static_cast<float>(_size->h)));
+                _rasterizer->setFillColor(AV::Image::Color(1.F, 1.F, 1.F));
                 const float rectWidth = 10.F;
                 const float rectSpacing = 100.F;
                 for (float x = _x - (static_cast<int>(_x / rectSpacing) * rectSpacing) - rectWidth;
                     x < static_cast<float>(_size->w - 1 + rectWidth);
                     x = x + rectSpacing)
                 {
-                    _render->drawRect(Core::BBox2f(x, 0.F, rectWidth, static_cast<float>(_size->h - 1)));
+                    _rasterizer->drawRect(Core::BBox2f(x, 0.F, rectWidth, static_cast<float>(_size->h - 1)));
                 }
                 _x = _x + 1.F;
-                _render->endFrame();
-                auto image = AV::Image::Image::create(_info);
-                glPixelStorei(GL_PACK_ALIGNMENT, 1);
-#if !defined(DJV_OPENGL_ES2)
-                glPixelStorei(GL_PACK_SWAP_BYTES, _info.layout.endian != Core::Memory::getEndian());
-#endif
-                glReadPixels(
-                    0, 0, _info.size.w, _info.size.h,
-                    _info.getGLFormat(),
-                    _info.getGLType(),
-                    image->getData());
+                auto image = _rasterizer->endFrame(_info.type);
                 _images.push_back(image);
             }
             if (!_write->isRunning())
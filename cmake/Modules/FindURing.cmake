@@ -0,0 +1,39 @@
+# Find the liburing library.
+#
+# This module defines the following variables:
+#
+# * URing_FOUND
+# * URing_INCLUDE_DIRS
+# * URing_LIBRARIES
+#
+# This module defines the following imported targets:
+#
+# * URing::URing
+#
+# This module defines the following interfaces:
+#
+# * URing
+
+find_path(URing_INCLUDE_DIR NAMES liburing.h)
+set(URing_INCLUDE_DIRS ${URing_INCLUDE_DIR})
+
+find_library(URing_LIBRARY NAMES uring)
+set(URing_LIBRARIES ${URing_LIBRARY})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(
+    URing
+    REQUIRED_VARS URing_INCLUDE_DIR URing_LIBRARY)
+mark_as_advanced(URing_INCLUDE_DIR URing_LIBRARY)
+
+if(URing_FOUND AND NOT TARGET URing::URing)
+    add_library(URing::URing UNKNOWN IMPORTED)
+    set_target_properties(URing::URing PROPERTIES
+        IMPORTED_LOCATION "${URing_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${URing_INCLUDE_DIR}"
+        INTERFACE_COMPILE_DEFINITIONS URing_FOUND)
+endif()
+if(URing_FOUND AND NOT TARGET URing)
+    add_library(URing INTERFACE)
+    target_link_libraries(URing INTERFACE URing::URing)
+endif()
@@ -38,6 +38,7 @@ uniform float       softClip;
 uniform int         imageChannel;
 uniform int         colorMode;
 uniform vec4        color;
+uniform float       sdfSmoothing;
 uniform sampler2D   textureSampler;
 
 // djv::AV::Image::Channels
@@ -61,6 +62,7 @@ uniform sampler2D   textureSampler;
 #define COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA_B 4
 #define COLOR_MODE_COLOR_AND_TEXTURE          5
 #define COLOR_MODE_SHADOW                     6
+#define COLOR_MODE_SDF_TEXT                   7
 
 vec4 colorMatrixFunc(vec4 value, mat4 color)
 {
@@ -234,4 +236,12 @@ void main()
     {
         gl_FragColor = color * Texture.x;
     }
+    else if (COLOR_MODE_SDF_TEXT == colorMode)
+    {
+        vec4 t = texture2D(textureSampler, Texture);
+        gl_FragColor.r = color.r;
+        gl_FragColor.g = color.g;
+        gl_FragColor.b = color.b;
+        gl_FragColor.a = color.a * smoothstep(0.5 - sdfSmoothing, 0.5 + sdfSmoothing, t.r);
+    }
 }
@@ -37,6 +37,7 @@ uniform float       softClip            = 0.0;
 uniform int         imageChannel        = 0;
 uniform int         colorMode           = 0;
 uniform vec4        color;
+uniform float       sdfSmoothing        = 0.0;
 uniform sampler2D   textureSampler;
 uniform int         colorSpace          = 0;
 uniform sampler3D   colorSpaceSampler;
@@ -62,6 +63,7 @@ uniform sampler3D   colorSpaceSampler;
 #define COLOR_MODE_COLOR_WITH_TEXTURE_ALPHA_B 4
 #define COLOR_MODE_COLOR_AND_TEXTURE          5
 #define COLOR_MODE_SHADOW                     6
+#define COLOR_MODE_SDF_TEXT                   7
 
 //$colorSpaceFunctions
 
@@ -244,4 +246,12 @@ void main()
     {
         FragColor = color * Texture.x;
     }
+    else if (COLOR_MODE_SDF_TEXT == colorMode)
+    {
+        vec4 t = texture(textureSampler, Texture);
+        FragColor.r = color.r;
+        FragColor.g = color.g;
+        FragColor.b = color.b;
+        FragColor.a = color.a * smoothstep(0.5 - sdfSmoothing, 0.5 + sdfSmoothing, t.r);
+    }
 }
@@ -35,6 +35,8 @@ namespace djv
             std::shared_ptr<ValueSubject<Time::FPS> > defaultSpeed;
             std::shared_ptr<ValueSubject<Render2D::ImageFilterOptions> > imageFilterOptions;
             std::shared_ptr<ValueSubject<bool> > lcdText;
+            std::shared_ptr<ValueSubject<bool> > sdfText;
+            std::shared_ptr<Font::System> fontSystem;
             std::shared_ptr<ThumbnailSystem> thumbnailSystem;
             std::shared_ptr<Render2D::Render> render2D;
         };
@@ -49,25 +51,51 @@ namespace djv
             p.defaultSpeed = ValueSubject<Time::FPS>::create(Time::getDefaultSpeed());
             p.imageFilterOptions = ValueSubject<Render2D::ImageFilterOptions>::create();
             p.lcdText = ValueSubject<bool>::create(true);
+            p.sdfText = ValueSubject<bool>::create(false);
 
-            auto glfwSystem = GLFW::System::create(context);
+            // The OpenGL systems are optional so that command line
+            // applications can run without a display.
+            std::shared_ptr<GLFW::System> glfwSystem;
+            try
+            {
+                glfwSystem = GLFW::System::create(context);
+            }
+            catch (const std::exception& e)
+            {
+                if (auto system = context->getSystemT<GLFW::System>())
+                {
+                    context->removeSystem(system);
+                }
+                _log(e.what(), LogLevel::Warning);
+            }
             auto ocioSystem = OCIO::System::create(context);
             auto ioSystem = IO::System::create(context);
-            auto fontSystem = Font::System::create(context);
-            p.thumbnailSystem = ThumbnailSystem::create(context);
-            auto shaderSystem = Render::ShaderSystem::create(context);
-            p.render2D = Render2D::Render::create(context);
-            auto render3D = Render3D::Render::create(context);
+            p.fontSystem = Font::System::create(context);
+            std::shared_ptr<Render::ShaderSystem> shaderSystem;
+            std::shared_ptr<Render3D::Render> render3D;
+            if (glfwSystem)
+            {
+                p.thumbnailSystem = ThumbnailSystem::create(context);
+                shaderSystem = Render::ShaderSystem::create(context);
+                p.render2D = Render2D::Render::create(context);
+                render3D = Render3D::Render::create(context);
+            }
             auto audioSystem = Audio::System::create(context);
 
-            addDependency(glfwSystem);
+            if (glfwSystem)
+            {
+                addDependency(glfwSystem);
+            }
             addDependency(ocioSystem);
             addDependency(ioSystem);
-            addDependency(fontSystem);
-            addDependency(p.thumbnailSystem);
-            addDependency(shaderSystem);
-            addDependency(p.render2D);
-            addDependency(render3D);
+            addDependency(p.fontSystem);
+            if (glfwSystem)
+            {
+                addDependency(p.thumbnailSystem);
+                addDependency(shaderSystem);
+                addDependency(p.render2D);
+                addDependency(render3D);
+            }
             addDependency(audioSystem);
         }
 
@@ -82,6 +110,7 @@ namespace djv
         {
             auto out = std::shared_ptr<AVSystem>(new AVSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -116,7 +145,10 @@ namespace djv
             if (p.defaultSpeed->setIfChanged(value))
             {
                 Time::setDefaultSpeed(value);
-                p.thumbnailSystem->clearCache();
+                if (p.thumbnailSystem)
+                {
+                    p.thumbnailSystem->clearCache();
+                }
             }
         }
 
@@ -130,7 +162,10 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.imageFilterOptions->setIfChanged(value))
             {
-                p.render2D->setImageFilterOptions(value);
+                if (p.render2D)
+                {
+                    p.render2D->setImageFilterOptions(value);
+                }
             }
         }
 
@@ -144,7 +179,24 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.lcdText->setIfChanged(value))
             {
-                p.render2D->setLCDText(value);
+                if (p.render2D)
+                {
+                    p.render2D->setLCDText(value);
+                }
+            }
+        }
+
+        std::shared_ptr<IValueSubject<bool> > AVSystem::observeSDFText() const
+        {
+            return _p->sdfText;
+        }
+
+        void AVSystem::setSDFText(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            if (p.sdfText->setIfChanged(value))
+            {
+                p.fontSystem->setSDFEnabled(value);
             }
         }
 
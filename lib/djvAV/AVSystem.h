@@ -21,7 +21,8 @@ namespace djv
 
         } // namespace Render2D
 
-        //! This class provides an AV system.
+        //! This class provides an AV system. The OpenGL systems are only
+        //! created when a display is available.
         class AVSystem : public Core::ISystem
         {
             DJV_NON_COPYABLE(AVSystem);
@@ -50,6 +51,9 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<bool> > observeLCDText() const;
             void setLCDText(bool);
 
+            std::shared_ptr<Core::IValueSubject<bool> > observeSDFText() const;
+            void setSDFText(bool);
+
         private:
             DJV_PRIVATE();
         };
@@ -13,6 +13,9 @@
 
 #include <RtAudio.h>
 
+#include <future>
+#include <map>
+
 using namespace djv::Core;
 
 namespace djv
@@ -26,6 +29,7 @@ namespace djv
                 std::unique_ptr<RtAudio> rtAudio;
                 std::vector<std::string> apis;
                 std::vector<Device> devices;
+                std::future<void> devicesFuture;
             };
 
             void System::_init(const std::shared_ptr<Core::Context>& context)
@@ -52,110 +56,123 @@ namespace djv
                     _log(ss.str());
                 }
 
-                try
+                // Probing the devices can be slow so it is done in the
+                // background, and waited for when the devices are needed.
+                auto textSystem = context->getSystemT<TextSystem>();
+                std::map<DeviceFormat, std::string> formatText;
+                for (auto i : getDeviceFormatEnums())
                 {
-                    p.rtAudio.reset(new RtAudio);
-                    const unsigned int rtDeviceCount = p.rtAudio->getDeviceCount();
-                    for (unsigned int i = 0; i < rtDeviceCount; ++i)
+                    std::stringstream ss;
+                    ss << i;
+                    formatText[i] = textSystem->getText(ss.str());
+                }
+                const std::string errorText = textSystem->getText(DJV_TEXT("error_rtaudio_init"));
+                p.devicesFuture = std::async(
+                    std::launch::async,
+                    [this, formatText, errorText]
+                {
+                    DJV_PRIVATE_PTR();
+                    try
                     {
-                        const RtAudio::DeviceInfo rtInfo = p.rtAudio->getDeviceInfo(i);
-                        if (rtInfo.probed)
+                        p.rtAudio.reset(new RtAudio);
+                        const unsigned int rtDeviceCount = p.rtAudio->getDeviceCount();
+                        for (unsigned int i = 0; i < rtDeviceCount; ++i)
                         {
-                            Device device;
-                            device.name = rtInfo.name;
-                            device.outputChannels = rtInfo.outputChannels;
-                            device.inputChannels  = rtInfo.inputChannels;
-                            device.duplexChannels = rtInfo.duplexChannels;
-                            for (auto j : rtInfo.sampleRates)
-                            {
-                                device.sampleRates.push_back(j);
-                            }
-                            device.preferredSampleRate = rtInfo.preferredSampleRate;
-                            if (rtInfo.nativeFormats & RTAUDIO_SINT8)
-                            {
-                                device.nativeFormats.push_back(DeviceFormat::S8);
-                            }
-                            if (rtInfo.nativeFormats & RTAUDIO_SINT8)
-                            {
-                                device.nativeFormats.push_back(DeviceFormat::S16);
-                            }
-                            if (rtInfo.nativeFormats & RTAUDIO_SINT16)
-                            {
-                                device.nativeFormats.push_back(DeviceFormat::S24);
-                            }
-                            if (rtInfo.nativeFormats & RTAUDIO_SINT24)
-                            {
-                                device.nativeFormats.push_back(DeviceFormat::S32);
-                            }
-                            if (rtInfo.nativeFormats & RTAUDIO_FLOAT32)
-                            {
-                                device.nativeFormats.push_back(DeviceFormat::F32);
-                            }
-                            if (rtInfo.nativeFormats & RTAUDIO_FLOAT64)
-                            {
-                                device.nativeFormats.push_back(DeviceFormat::F64);
-                            }
-                            p.devices.push_back(device);
+                            const RtAudio::DeviceInfo rtInfo = p.rtAudio->getDeviceInfo(i);
+                            if (rtInfo.probed)
                             {
-                                std::stringstream ss;
-                                ss << "Device: " << device.name;
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "    Channels (output, input, duplex): " <<
-                                    size_t(device.outputChannels) << ", " <<
-                                    size_t(device.inputChannels) << ", " <<
-                                    size_t(device.duplexChannels);
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "    Sample rates: ";
-                                for (auto j : device.sampleRates)
+                                Device device;
+                                device.name = rtInfo.name;
+                                device.outputChannels = rtInfo.outputChannels;
+                                device.inputChannels  = rtInfo.inputChannels;
+                                device.duplexChannels = rtInfo.duplexChannels;
+                                for (auto j : rtInfo.sampleRates)
                                 {
-                                    ss << j << " ";
+                                    device.sampleRates.push_back(j);
+                                }
+                                device.preferredSampleRate = rtInfo.preferredSampleRate;
+                                if (rtInfo.nativeFormats & RTAUDIO_SINT8)
+                                {
+                                    device.nativeFormats.push_back(DeviceFormat::S8);
+                                }
+                                if (rtInfo.nativeFormats & RTAUDIO_SINT8)
+                                {
+                                    device.nativeFormats.push_back(DeviceFormat::S16);
+                                }
+                                if (rtInfo.nativeFormats & RTAUDIO_SINT16)
+                                {
+                                    device.nativeFormats.push_back(DeviceFormat::S24);
+                                }
+                                if (rtInfo.nativeFormats & RTAUDIO_SINT24)
+                                {
+                                    device.nativeFormats.push_back(DeviceFormat::S32);
+                                }
+                                if (rtInfo.nativeFormats & RTAUDIO_FLOAT32)
+                                {
+                                    device.nativeFormats.push_back(DeviceFormat::F32);
+                                }
+                                if (rtInfo.nativeFormats & RTAUDIO_FLOAT64)
+                                {
+                                    device.nativeFormats.push_back(DeviceFormat::F64);
+                                }
+                                p.devices.push_back(device);
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device: " << device.name;
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "    Channels (output, input, duplex): " <<
+                                        size_t(device.outputChannels) << ", " <<
+                                        size_t(device.inputChannels) << ", " <<
+                                        size_t(device.duplexChannels);
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "    Sample rates: ";
+                                    for (auto j : device.sampleRates)
+                                    {
+                                        ss << j << " ";
+                                    }
+                                    _log(ss.str());
                                 }
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "    Preferred sample rate: " << device.preferredSampleRate;
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "    Native formats: ";
-                                auto textSystem = context->getSystemT<TextSystem>();
-                                for (auto j : device.nativeFormats)
                                 {
-                                    std::stringstream ss2;
-                                    ss2 << j;
-                                    ss << textSystem->getText(ss2.str()) << " ";
+                                    std::stringstream ss;
+                                    ss << "    Preferred sample rate: " << device.preferredSampleRate;
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "    Native formats: ";
+                                    for (auto j : device.nativeFormats)
+                                    {
+                                        ss << formatText.at(j) << " ";
+                                    }
+                                    _log(ss.str());
                                 }
-                                _log(ss.str());
                             }
                         }
+                        {
+                            std::stringstream ss;
+                            ss << "    Default input device: " << p.rtAudio->getDefaultInputDevice();
+                            _log(ss.str());
+                        }
+                        {
+                            std::stringstream ss;
+                            ss << "    Default output device: " << p.rtAudio->getDefaultOutputDevice();
+                            _log(ss.str());
+                        }
                     }
+                    catch (const std::exception& e)
                     {
-                        std::stringstream ss;
-                        ss << "    Default input device: " << p.rtAudio->getDefaultInputDevice();
-                        _log(ss.str());
-                    }
-                    {
-                        std::stringstream ss;
-                        ss << "    Default output device: " << p.rtAudio->getDefaultOutputDevice();
-                        _log(ss.str());
+                        std::vector<std::string> messages;
+                        messages.push_back(errorText);
+                        messages.push_back(e.what());
+                        _log(String::join(messages, ' '), LogLevel::Error);
                     }
-                }
-                catch (const std::exception& e)
-                {
-                    std::vector<std::string> messages;
-                    auto textSystem = context->getSystemT<TextSystem>();
-                    messages.push_back(textSystem->getText(DJV_TEXT("error_rtaudio_init")));
-                    messages.push_back(e.what());
-                    _log(String::join(messages, ' '), LogLevel::Error);
-                }
+                });
             }
 
             System::System() :
@@ -163,12 +180,19 @@ namespace djv
             {}
 
             System::~System()
-            {}
+            {
+                DJV_PRIVATE_PTR();
+                if (p.devicesFuture.valid())
+                {
+                    p.devicesFuture.get();
+                }
+            }
 
             std::shared_ptr<System> System::create(const std::shared_ptr<Core::Context>& context)
             {
                 auto out = std::shared_ptr<System>(new System);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
 
@@ -179,12 +203,18 @@ namespace djv
 
             const std::vector<Device>& System::getDevices() const
             {
+                _waitForDevices();
                 return _p->devices;
             }
                 
             unsigned int System::getDefaultInputDevice()
             {
                 DJV_PRIVATE_PTR();
+                _waitForDevices();
+                if (!p.rtAudio)
+                {
+                    return 0;
+                }
                 unsigned int out = p.rtAudio->getDefaultInputDevice();
                 const unsigned int rtDeviceCount = p.rtAudio->getDeviceCount();
                 std::vector<uint8_t> inputChannels;
@@ -212,6 +242,11 @@ namespace djv
             unsigned int System::getDefaultOutputDevice()
             {
                 DJV_PRIVATE_PTR();
+                _waitForDevices();
+                if (!p.rtAudio)
+                {
+                    return 0;
+                }
                 unsigned int out = p.rtAudio->getDefaultOutputDevice();
                 const unsigned int rtDeviceCount = p.rtAudio->getDeviceCount();
                 std::vector<uint8_t> outputChannels;
@@ -236,6 +271,14 @@ namespace djv
                 return out;
             }
 
+            void System::_waitForDevices() const
+            {
+                if (_p->devicesFuture.valid())
+                {
+                    _p->devicesFuture.get();
+                }
+            }
+
         } // namespace Audio
     } // namespace AV
 
@@ -40,6 +40,9 @@ namespace djv
             };
 
             //! This class provides an audio system.
+            //!
+            //! The devices are probed in the background, the functions that
+            //! need them wait for the probing to finish.
             class System : public Core::ISystem
             {
                 DJV_NON_COPYABLE(System);
@@ -60,6 +63,8 @@ namespace djv
                 unsigned int getDefaultOutputDevice();
 
             private:
+                void _waitForDevices() const;
+
                 DJV_PRIVATE();
             };
 
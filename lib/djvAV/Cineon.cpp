@@ -592,6 +592,7 @@ namespace djv
 
                 struct Plugin::Private
                 {
+                    Options options;
                 };
 
                 Plugin::Plugin() :
@@ -609,9 +610,19 @@ namespace djv
                     return out;
                 }
 
+                picojson::value Plugin::getOptions() const
+                {
+                    return toJSON(_p->options);
+                }
+
+                void Plugin::setOptions(const picojson::value & value)
+                {
+                    fromJSON(value, _p->options);
+                }
+
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo & fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _textSystem, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
@@ -622,5 +633,36 @@ namespace djv
             } // namespace Cineon
         } // namespace IO
     } // namespace AV
+
+    picojson::value toJSON(const AV::IO::Cineon::Options& value)
+    {
+        picojson::value out(picojson::object_type, true);
+        {
+            std::stringstream ss;
+            ss << value.readType;
+            out.get<picojson::object>()["ReadType"] = picojson::value(ss.str());
+        }
+        return out;
+    }
+
+    void fromJSON(const picojson::value& value, AV::IO::Cineon::Options& out)
+    {
+        if (value.is<picojson::object>())
+        {
+            for (const auto& i : value.get<picojson::object>())
+            {
+                if ("ReadType" == i.first)
+                {
+                    std::stringstream ss(i.second.get<std::string>());
+                    ss >> out.readType;
+                }
+            }
+        }
+        else
+        {
+            //! \todo How can we translate this?
+            throw std::invalid_argument(DJV_TEXT("error_cannot_parse_the_value"));
+        }
+    }
 } // namespace djv
 
@@ -186,6 +186,12 @@ namespace djv
                 //! Finish writing the Cineon file header after image data is written.
                 void writeFinish(const std::shared_ptr<Core::FileSystem::FileIO>&);
 
+                //! This struct provides the Cineon file I/O options.
+                struct Options
+                {
+                    Core::FileSystem::ReadType readType = Core::FileSystem::ReadType::Normal;
+                };
+
                 //! This class provides the Cineon file reader.
                 class Read : public ISequenceRead
                 {
@@ -200,10 +206,14 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const Options&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
 
+                    //! Read the image data. When the file data is in memory and
+                    //! already matches the image layout the image references it
+                    //! directly.
                     static std::shared_ptr<Image::Image> readImage(
                         const Info&,
                         const std::shared_ptr<Core::FileSystem::FileIO>&);
@@ -257,6 +267,9 @@ namespace djv
                 public:
                     static std::shared_ptr<Plugin> create(const std::shared_ptr<Core::Context>&);
 
+                    picojson::value getOptions() const override;
+                    void setOptions(const picojson::value &) override;
+
                     std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const override;
                     std::shared_ptr<IWrite> write(const Core::FileSystem::FileInfo&, const Info &, const WriteOptions&) const override;
 
@@ -267,4 +280,10 @@ namespace djv
             } // namespace Cineon
         } // namespace IO
     } // namespace AV
+
+    picojson::value toJSON(const AV::IO::Cineon::Options&);
+
+    //! Throws:
+    //! - std::exception
+    void fromJSON(const picojson::value&, AV::IO::Cineon::Options&);
 } // namespace djv
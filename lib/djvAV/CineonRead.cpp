@@ -33,11 +33,13 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo & fileInfo,
                     const ReadOptions& readOptions,
+                    const Options& options,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
+                    out->_readType = options.readType;
                     out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
                     return out;
                 }
@@ -46,34 +48,44 @@ namespace djv
                     const Info& info,
                     const std::shared_ptr<FileSystem::FileIO>& io)
                 {
-#if defined(DJV_MMAP)
-                    auto out = Image::Image::create(info.video[0].info, io);
-#else // DJV_MMAP
-                    auto infoTmp = info;
-                    bool convertEndian = false;
-                    if (infoTmp.video[0].info.layout.endian != Memory::getEndian())
+                    auto imageInfo = info.video[0].info;
+                    size_t wordSize = 1;
+                    switch (Image::getDataType(imageInfo.type))
                     {
-                        convertEndian = true;
-                        infoTmp.video[0].info.layout.endian = Memory::getEndian();
+                    case Image::DataType::U10: wordSize = 4; break;
+                    case Image::DataType::U16: wordSize = 2; break;
+                    default: break;
                     }
-                    auto out = Image::Image::create(infoTmp.video[0].info);
-                    io->read(out->getData(), out->getDataByteCount());
-                    if (convertEndian)
+                    const bool convertEndian = wordSize > 1 && imageInfo.layout.endian != Memory::getEndian();
+                    imageInfo.layout.endian = Memory::getEndian();
+                    std::shared_ptr<Image::Image> out;
+                    const uint8_t* p = io->mmapP();
+                    const size_t dataByteCount = imageInfo.getDataByteCount();
+                    if (p && static_cast<size_t>(io->mmapEnd() - p) >= dataByteCount)
                     {
-                        const size_t dataByteCount = out->getDataByteCount();
-                        switch (Image::getDataType(infoTmp.video[0].info.type))
+                        if (!convertEndian)
                         {
-                            case Image::DataType::U10:
-                                Memory::endian(out->getData(), dataByteCount / 4, 4);
-                                break;
-                            case Image::DataType::U16:
-                                Memory::endian(out->getData(), dataByteCount / 2, 2);
-                                break;
-                            default: break;                            
+                            // The file data already matches the image layout.
+                            out = Image::Image::create(imageInfo, io);
+                        }
+                        else
+                        {
+                            // Convert the endian while copying out of memory.
+                            out = Image::Image::create(imageInfo);
+                            Memory::endian(p, out->getData(), dataByteCount / wordSize, wordSize);
+                            io->seek(dataByteCount);
+                        }
+                    }
+                    else
+                    {
+                        out = Image::Image::create(imageInfo);
+                        io->read(out->getData(), dataByteCount);
+                        if (convertEndian)
+                        {
+                            Memory::endian(out->getData(), dataByteCount / wordSize, wordSize);
                         }
                     }
-#endif // DJV_MMAP
-                    out->setTags(infoTmp.tags);
+                    out->setTags(info.tags);
                     return out;
                 }
 
@@ -95,7 +107,7 @@ namespace djv
                 Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
                 {
                     DJV_PRIVATE_PTR();
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    _openFile(fileName, io);
                     Info info;
                     info.video.resize(1);
                     read(io, info, p.colorProfile, _textSystem);
@@ -144,6 +144,18 @@ namespace djv
                             *in < _floatMax;
                     }
 
+                    size_t getLinePadding(const Header& header)
+                    {
+                        return isValid(&header.image.elem[0].linePadding) ? header.image.elem[0].linePadding : 0;
+                    }
+
+                    size_t getDataByteCount(const Info& info, const Header& header)
+                    {
+                        const size_t h = info.video[0].info.size.h;
+                        const size_t linePadding = getLinePadding(header);
+                        return info.video[0].info.getDataByteCount() + (h > 0 ? (h - 1) * linePadding : 0);
+                    }
+
                 } // namespace
 
                 Header read(
@@ -217,44 +229,35 @@ namespace djv
                     }
 
                     info.video[0].info.type = Image::Type::None;
+                    uint8_t channels = 0;
+                    switch (static_cast<Descriptor>(out.image.elem[0].descriptor))
+                    {
+                    case Descriptor::L:    channels = 1; break;
+                    case Descriptor::RGB:  channels = 3; break;
+                    case Descriptor::RGBA: channels = 4; break;
+                    default: break;
+                    }
                     switch (static_cast<Components>(out.image.elem[0].packing))
                     {
                     case Components::Pack:
-                    {
-                        uint8_t channels = 0;
-                        switch (static_cast<Descriptor>(out.image.elem[0].descriptor))
-                        {
-                        case Descriptor::L:    channels = 1; break;
-                        case Descriptor::RGB:  channels = 3; break;
-                        case Descriptor::RGBA: channels = 4; break;
-                        default: break;
-                        }
                         info.video[0].info.type = Image::getIntType(channels, out.image.elem[0].bitDepth);
-                    }
-                    break;
+                        break;
                     case Components::TypeA:
+                    case Components::TypeB:
                         switch (out.image.elem[0].bitDepth)
                         {
                         case 10:
-                            if (Descriptor::RGB == static_cast<Descriptor>(out.image.elem[0].descriptor))
+                            if (3 == channels)
                             {
                                 info.video[0].info.type = Image::Type::RGB_U10;
                                 info.video[0].info.layout.alignment = 4;
                             }
                             break;
+                        case 12:
                         case 16:
-                        {
-                            uint8_t channels = 0;
-                            switch (static_cast<Descriptor>(out.image.elem[0].descriptor))
-                            {
-                            case Descriptor::L:    channels = 1; break;
-                            case Descriptor::RGB:  channels = 3; break;
-                            case Descriptor::RGBA: channels = 4; break;
-                            default: break;
-                            }
-                            info.video[0].info.type = Image::getIntType(channels, out.image.elem[0].bitDepth);
+                            // The 12-bit data is expanded to 16-bit when it is read.
+                            info.video[0].info.type = Image::getIntType(channels, 16);
                             break;
-                        }
                         default: break;
                         }
                         break;
@@ -266,7 +269,7 @@ namespace djv
                             arg(io->getFileName()).
                             arg(textSystem->getText(DJV_TEXT("error_unsupported_file"))));
                     }
-                    const size_t dataByteCount = info.video[0].info.getDataByteCount();
+                    const size_t dataByteCount = getDataByteCount(info, out);
                     const size_t ioSize = io->getSize();
                     if (dataByteCount > ioSize - out.file.imageOffset)
                     {
@@ -282,13 +285,6 @@ namespace djv
                             arg(textSystem->getText(DJV_TEXT("error_unsupported_file"))));
                     }
 
-                    if (isValid(&out.image.elem[0].linePadding) && out.image.elem[0].linePadding)
-                    {
-                        throw FileSystem::Error(String::Format("{0}: {1}").
-                            arg(io->getFileName()).
-                            arg(textSystem->getText(DJV_TEXT("error_unsupported_file"))));
-                    }
-
                     if (Transfer::FilmPrint == static_cast<Transfer>(out.image.elem[0].transfer))
                     {
                         colorProfile = Cineon::ColorProfile::FilmPrint;
@@ -518,6 +514,147 @@ namespace djv
                     return out;
                 }
 
+                void convert(
+                    const uint8_t* in,
+                    uint8_t*       out,
+                    size_t         size,
+                    uint8_t        bitDepth,
+                    Components     packing,
+                    bool           endian)
+                {
+                    switch (bitDepth)
+                    {
+                    case 10:
+                        if (Components::TypeB == packing)
+                        {
+                            // Move the padding bits from the most significant
+                            // bits to the least significant bits.
+                            if (endian)
+                            {
+                                for (size_t i = 0; i < size; ++i, in += 4, out += 4)
+                                {
+                                    uint32_t value;
+                                    memcpy(&value, in, 4);
+                                    value = Memory::byteSwap(value) << 2;
+                                    memcpy(out, &value, 4);
+                                }
+                            }
+                            else
+                            {
+                                for (size_t i = 0; i < size; ++i, in += 4, out += 4)
+                                {
+                                    uint32_t value;
+                                    memcpy(&value, in, 4);
+                                    value <<= 2;
+                                    memcpy(out, &value, 4);
+                                }
+                            }
+                        }
+                        else if (endian)
+                        {
+                            Memory::endian(in, out, size, 4);
+                        }
+                        else
+                        {
+                            memcpy(out, in, size * 4);
+                        }
+                        break;
+                    case 12:
+                    {
+                        // Expand the 12-bit values to 16-bit by replicating
+                        // the most significant bits.
+                        const uint16_t mask = Components::TypeB == packing ? 0x0fff : 0xfff0;
+                        const int shift = Components::TypeB == packing ? 4 : 0;
+                        for (size_t i = 0; i < size; ++i, in += 2, out += 2)
+                        {
+                            uint16_t value;
+                            memcpy(&value, in, 2);
+                            if (endian)
+                            {
+                                value = Memory::byteSwap(value);
+                            }
+                            value = static_cast<uint16_t>((value & mask) << shift);
+                            value |= value >> 12;
+                            memcpy(out, &value, 2);
+                        }
+                        break;
+                    }
+                    case 16:
+                        if (endian)
+                        {
+                            Memory::endian(in, out, size, 2);
+                        }
+                        else
+                        {
+                            memcpy(out, in, size * 2);
+                        }
+                        break;
+                    default:
+                        memcpy(out, in, size);
+                        break;
+                    }
+                }
+
+                std::shared_ptr<Image::Image> readImage(
+                    const Info& info,
+                    const Header& header,
+                    const std::shared_ptr<Core::FileSystem::FileIO>& io)
+                {
+                    const auto& elem = header.image.elem[0];
+                    const Components packing = static_cast<Components>(elem.packing);
+                    const size_t linePadding = getLinePadding(header);
+                    if (!linePadding &&
+                        elem.bitDepth != 12 &&
+                        !(10 == elem.bitDepth && Components::TypeB == packing))
+                    {
+                        // The file data can be used without unpacking.
+                        return Cineon::Read::readImage(info, io);
+                    }
+
+                    auto imageInfo = info.video[0].info;
+                    const bool endian = imageInfo.layout.endian != Memory::getEndian();
+                    imageInfo.layout.endian = Memory::getEndian();
+                    auto out = Image::Image::create(imageInfo);
+                    size_t wordSize = 1;
+                    switch (Image::getDataType(imageInfo.type))
+                    {
+                    case Image::DataType::U10: wordSize = 4; break;
+                    case Image::DataType::U16: wordSize = 2; break;
+                    default: break;
+                    }
+                    const size_t h = imageInfo.size.h;
+                    const size_t scanlineByteCount = out->getScanlineByteCount();
+                    const size_t fileScanlineByteCount = scanlineByteCount + linePadding;
+                    const size_t dataByteCount = getDataByteCount(info, header);
+
+                    // Convert the scanlines while copying them out of memory,
+                    // or out of a buffer if the file is not memory mapped.
+                    const uint8_t* p = io->mmapP();
+                    std::vector<uint8_t> buf;
+                    if (p && static_cast<size_t>(io->mmapEnd() - p) >= dataByteCount)
+                    {
+                        io->seek(dataByteCount);
+                    }
+                    else
+                    {
+                        buf.resize(dataByteCount);
+                        io->read(buf.data(), dataByteCount);
+                        p = buf.data();
+                    }
+                    for (size_t y = 0; y < h; ++y)
+                    {
+                        convert(
+                            p + y * fileScanlineByteCount,
+                            out->getData(y),
+                            scanlineByteCount / wordSize,
+                            elem.bitDepth,
+                            packing,
+                            endian);
+                    }
+                    out->setTags(info.tags);
+                    return out;
+                }
+
                 void write(
                     const std::shared_ptr<Core::FileSystem::FileIO>& io,
                     const Info& info,
@@ -926,6 +1063,11 @@ namespace djv
                 ss << value.endian;
                 out.get<picojson::object>()["Endian"] = picojson::value(ss.str());
             }
+            {
+                std::stringstream ss;
+                ss << value.readType;
+                out.get<picojson::object>()["ReadType"] = picojson::value(ss.str());
+            }
         }
         return out;
     }
@@ -946,6 +1088,11 @@ namespace djv
                     std::stringstream ss(i.second.get<std::string>());
                     ss >> out.endian;
                 }
+                else if ("ReadType" == i.first)
+                {
+                    std::stringstream ss(i.second.get<std::string>());
+                    ss >> out.readType;
+                }
             }
         }
         else
@@ -274,6 +274,32 @@ namespace djv
                     Cineon::ColorProfile&,
                     const std::shared_ptr<Core::TextSystem>&);
                 
+                //! Convert a scanline of DPX file data to the image layout. The
+                //! endian conversion and the unpacking are done in a single
+                //! pass while copying the data:
+                //! - 10-bit data filled with method B is shifted to the method
+                //!   A layout used by Image::Type::RGB_U10
+                //! - 12-bit data filled with method A or B is expanded to 16-bit
+                //!
+                //! The size is the number of 32-bit words for 10-bit data and
+                //! the number of components otherwise.
+                void convert(
+                    const uint8_t* in,
+                    uint8_t*       out,
+                    size_t         size,
+                    uint8_t        bitDepth,
+                    Components,
+                    bool           endian);
+
+                //! Read the DPX file image data.
+                //!
+                //! Throws:
+                //! - Core::FileSystem::Error
+                std::shared_ptr<Image::Image> readImage(
+                    const Info&,
+                    const Header&,
+                    const std::shared_ptr<Core::FileSystem::FileIO>&);
+
                 //! Write a DPX file header.
                 //!
                 //! Throws:
@@ -291,8 +317,9 @@ namespace djv
                 //! This struct provides the DPX file I/O options.
                 struct Options
                 {
-                    Version     version    = Version::_2_0;
-                    Endian      endian     = Endian::MSB;
+                    Version                     version    = Version::_2_0;
+                    Endian                      endian     = Endian::MSB;
+                    Core::FileSystem::ReadType  readType   = Core::FileSystem::ReadType::Normal;
                 };
 
                 //! This class provides the DPX file reader.
@@ -319,7 +346,7 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string &) override;
 
                 private:
-                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&);
+                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&, Header&);
 
                     DJV_PRIVATE();
                 };
@@ -41,6 +41,7 @@ namespace djv
                 {
                     auto out = std::shared_ptr<Read>(new Read);
                     out->_p->options = options;
+                    out->_readType = options.readType;
                     out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
                     return out;
                 }
@@ -48,25 +49,30 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    Header header;
+                    return _open(fileName, io, header);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
-                    auto out = Cineon::Read::readImage(info, io);
+                    Header header;
+                    const auto info = _open(fileName, io, header);
+                    auto out = readImage(info, header, io);
                     out->setPluginName(pluginName);
                     return out;
                 }
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                Info Read::_open(
+                    const std::string & fileName,
+                    const std::shared_ptr<FileSystem::FileIO>& io,
+                    Header& header)
                 {
                     DJV_PRIVATE_PTR();
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    _openFile(fileName, io);
                     Info info;
                     info.video.resize(1);
-                    DPX::read(io, info, p.colorProfile, _textSystem);
+                    header = DPX::read(io, info, p.colorProfile, _textSystem);
                     info.video[0].sequence = _sequence;
                     return info;
                 }
@@ -20,9 +20,12 @@
 #include <codecvt>
 #include <condition_variable>
 #include <cwctype>
+#include <functional>
 #include <locale>
 #include <mutex>
+#include <set>
 #include <thread>
+#include <tuple>
 
 using namespace djv::Core;
 
@@ -36,6 +39,10 @@ namespace djv
             {
                 //! \todo Should this be configurable?
                 const size_t glyphCacheMax = 10000;
+                const size_t textRunCacheMax = 10000;
+                const size_t sdfCacheMax = 4096;
+                const size_t rasterizerCountMax = 4;
+                const size_t rasterizerGlyphsMin = 32;
                 const bool lcdHinting = true;
 
                 class MetricsRequest
@@ -56,6 +63,7 @@ namespace djv
 
                     std::string text;
                     Info info;
+                    bool sdf = false;
                     uint16_t maxLineWidth = std::numeric_limits<uint16_t>::max();
                     std::promise<glm::vec2> promise;
                 };
@@ -68,6 +76,7 @@ namespace djv
 
                     std::string text;
                     Info info;
+                    bool sdf = false;
                     uint16_t maxLineWidth = std::numeric_limits<uint16_t>::max();
                     std::promise<std::vector<BBox2f> > promise;
                 };
@@ -80,6 +89,7 @@ namespace djv
 
                     std::string text;
                     Info info;
+                    bool sdf = false;
                     bool cacheOnly = false;
                     std::promise<std::vector<std::shared_ptr<Glyph> > > promise;
                 };
@@ -92,10 +102,270 @@ namespace djv
 
                     std::string text;
                     Info info;
+                    bool sdf = false;
                     uint16_t maxLineWidth = std::numeric_limits<uint16_t>::max();
                     std::promise<std::vector<TextLine> > promise;
                 };
 
+                //! This struct provides the cached measurements and glyphs for
+                //! a run of text. Runs are not modified once they are in the
+                //! cache so they can be shared between threads.
+                struct TextRun
+                {
+                    bool measured = false;
+                    glm::vec2 size = glm::vec2(0.F, 0.F);
+                    std::vector<BBox2f> glyphGeom;
+                    bool hasGlyphs = false;
+                    std::vector<std::shared_ptr<Glyph> > glyphs;
+                };
+
+                typedef std::tuple<std::string, Info, bool> TextRunKey;
+
+                //! This struct provides a signed distance field glyph rasterized
+                //! at sdfSize.
+                struct SDFGlyph
+                {
+                    std::shared_ptr<Image::Data> data;
+                    glm::vec2 offset = glm::vec2(0.F, 0.F);
+                };
+
+                //! This struct provides the FreeType state for rasterizing glyphs
+                //! on another thread, FreeType faces cannot be shared between threads.
+                struct Rasterizer
+                {
+                    FT_Library ftLibrary = nullptr;
+                    std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
+                };
+
+                FT_Face findFace(const std::map<FamilyID, std::map<FaceID, FT_Face> >& fontFaces, const Info& info)
+                {
+                    FT_Face out = nullptr;
+                    const auto i = fontFaces.find(info.getFamily());
+                    if (i != fontFaces.end())
+                    {
+                        const auto j = i->second.find(info.getFace());
+                        if (j != i->second.end())
+                        {
+                            out = j->second;
+                        }
+                    }
+                    return out;
+                }
+
+                std::shared_ptr<Glyph> renderGlyph(const GlyphInfo& info, FT_Face ftFace)
+                {
+                    auto out = Glyph::create();
+                    out->info = info;
+                    if (ftFace)
+                    {
+                        /*FT_Error ftError = FT_Set_Char_Size(
+                            ftFace,
+                            0,
+                            static_cast<int>(request.info.getSize() * 64.F),
+                            request.info.getDPI(),
+                            request.info.getDPI());*/
+                        FT_Error ftError = FT_Set_Pixel_Sizes(
+                            ftFace,
+                            0,
+                            static_cast<int>(info.info.getSize()));
+                        if (ftError)
+                        {
+                            //std::cout << "FT_Set_Char_Size error: " << getFTError(ftError) << std::endl;
+                            return nullptr;
+                        }
+
+                        if (auto ftGlyphIndex = FT_Get_Char_Index(ftFace, info.code))
+                        {
+                            ftError = FT_Load_Glyph(ftFace, ftGlyphIndex, FT_LOAD_FORCE_AUTOHINT);
+                            if (ftError)
+                            {
+                                //std::cout << "FT_Load_Glyph error: " << getFTError(ftError) << std::endl;
+                                return nullptr;
+                            }
+                            FT_Render_Mode renderMode = FT_RENDER_MODE_NORMAL;
+                            uint8_t renderModeChannels = 1;
+                            if (lcdHinting)
+                            {
+                                renderMode = FT_RENDER_MODE_LCD;
+                                renderModeChannels = 3;
+                            }
+                            ftError = FT_Render_Glyph(ftFace->glyph, renderMode);
+                            if (ftError)
+                            {
+                                //std::cout << "FT_Render_Glyph error: " << getFTError(ftError) << std::endl;
+                                return nullptr;
+                            }
+                            FT_Glyph ftGlyph;
+                            ftError = FT_Get_Glyph(ftFace->glyph, &ftGlyph);
+                            if (ftError)
+                            {
+                                //std::cout << "FT_Get_Glyph error: " << getFTError(ftError) << std::endl;
+                                return nullptr;
+                            }
+                            FT_Vector v;
+                            v.x = 0;
+                            v.y = 0;
+                            ftError = FT_Glyph_To_Bitmap(&ftGlyph, renderMode, &v, 0);
+                            if (ftError)
+                            {
+                                //std::cout << "FT_Glyph_To_Bitmap error: " << getFTError(ftError) << std::endl;
+                                FT_Done_Glyph(ftGlyph);
+                                return nullptr;
+                            }
+                            FT_BitmapGlyph bitmap = (FT_BitmapGlyph)ftGlyph;
+                            const Image::Info imageInfo = Image::Info(
+                                bitmap->bitmap.width / static_cast<int>(renderModeChannels),
+                                bitmap->bitmap.rows,
+                                Image::getIntType(renderModeChannels, 8));
+                            auto imageData = Image::Data::create(imageInfo);
+                            for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                            {
+                                memcpy(
+                                    imageData->getData(y),
+                                    bitmap->bitmap.buffer + static_cast<size_t>(y) * bitmap->bitmap.pitch,
+                                    static_cast<size_t>(imageInfo.size.w) * renderModeChannels);
+                            }
+                            out->imageData = imageData;
+                            out->offset = glm::vec2(ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top);
+                            out->advance = ftFace->glyph->advance.x / 64.F;
+                            out->lsbDelta = ftFace->glyph->lsb_delta;
+                            out->rsbDelta = ftFace->glyph->rsb_delta;
+                            FT_Done_Glyph(ftGlyph);
+                        }
+                    }
+                    return out;
+                }
+
+                std::shared_ptr<Glyph> renderSDFGlyph(const GlyphInfo& info, FT_Face ftFace, std::shared_ptr<SDFGlyph>& sdf)
+                {
+                    auto out = Glyph::create();
+                    out->info = info;
+                    if (ftFace)
+                    {
+                        if (auto ftGlyphIndex = FT_Get_Char_Index(ftFace, info.code))
+                        {
+                            // Rasterize the signed distance field if it is not already
+                            // available from another font size.
+                            if (!sdf)
+                            {
+                                FT_Error ftError = FT_Set_Pixel_Sizes(ftFace, 0, sdfSize);
+                                if (ftError)
+                                {
+                                    return nullptr;
+                                }
+                                ftError = FT_Load_Glyph(ftFace, ftGlyphIndex, FT_LOAD_NO_HINTING);
+                                if (ftError)
+                                {
+                                    return nullptr;
+                                }
+                                ftError = FT_Render_Glyph(ftFace->glyph, FT_RENDER_MODE_NORMAL);
+                                if (ftError)
+                                {
+                                    return nullptr;
+                                }
+                                const FT_Bitmap& bitmap = ftFace->glyph->bitmap;
+                                const Image::Info imageInfo = Image::Info(bitmap.width, bitmap.rows, Image::Type::L_U8);
+                                auto imageData = Image::Data::create(imageInfo);
+                                for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                                {
+                                    memcpy(
+                                        imageData->getData(y),
+                                        bitmap.buffer + static_cast<size_t>(y) * bitmap.pitch,
+                                        imageInfo.size.w);
+                                }
+                                sdf.reset(new SDFGlyph);
+                                sdf->data = imageData->isValid() ? createSDF(*imageData, sdfSpread) : imageData;
+                                sdf->offset = glm::vec2(
+                                    ftFace->glyph->bitmap_left - static_cast<int>(sdfSpread),
+                                    ftFace->glyph->bitmap_top + static_cast<int>(sdfSpread));
+                            }
+
+                            // Get the metrics for this font size.
+                            FT_Error ftError = FT_Set_Pixel_Sizes(
+                                ftFace,
+                                0,
+                                static_cast<int>(info.info.getSize()));
+                            if (ftError)
+                            {
+                                return nullptr;
+                            }
+                            ftError = FT_Load_Glyph(ftFace, ftGlyphIndex, FT_LOAD_FORCE_AUTOHINT);
+                            if (ftError)
+                            {
+                                return nullptr;
+                            }
+                            const float scale = info.info.getSize() / static_cast<float>(sdfSize);
+                            out->sdfData = sdf->data;
+                            out->sdfOffset = sdf->offset * scale;
+                            out->sdfScale = scale;
+                            out->advance = ftFace->glyph->advance.x / 64.F;
+                            out->lsbDelta = ftFace->glyph->lsb_delta;
+                            out->rsbDelta = ftFace->glyph->rsb_delta;
+                        }
+                    }
+                    return out;
+                }
+
+                //! Compute the squared distance transform of a row or column
+                //! (P. Felzenszwalb and D. Huttenlocher, "Distance Transforms of
+                //! Sampled Functions").
+                void distanceTransform(const float* f, size_t size, float* d, int* v, float* z)
+                {
+                    const float inf = std::numeric_limits<float>::max();
+                    int k = 0;
+                    v[0] = 0;
+                    z[0] = -inf;
+                    z[1] = inf;
+                    for (int q = 1; q < static_cast<int>(size); ++q)
+                    {
+                        float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+                        while (k > 0 && s <= z[k])
+                        {
+                            --k;
+                            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+                        }
+                        ++k;
+                        v[k] = q;
+                        z[k] = s;
+                        z[k + 1] = inf;
+                    }
+                    k = 0;
+                    for (int q = 0; q < static_cast<int>(size); ++q)
+                    {
+                        while (z[k + 1] < q)
+                        {
+                            ++k;
+                        }
+                        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+                    }
+                }
+
+                void distanceTransform(std::vector<float>& data, size_t w, size_t h)
+                {
+                    const size_t size = std::max(w, h);
+                    std::vector<float> f(size);
+                    std::vector<float> d(size);
+                    std::vector<int> v(size);
+                    std::vector<float> z(size + 1);
+                    for (size_t x = 0; x < w; ++x)
+                    {
+                        for (size_t y = 0; y < h; ++y)
+                        {
+                            f[y] = data[y * w + x];
+                        }
+                        distanceTransform(f.data(), h, d.data(), v.data(), z.data());
+                        for (size_t y = 0; y < h; ++y)
+                        {
+                            data[y * w + x] = d[y];
+                        }
+                    }
+                    for (size_t y = 0; y < h; ++y)
+                    {
+                        distanceTransform(&data[y * w], w, d.data(), v.data(), z.data());
+                        memcpy(&data[y * w], d.data(), w * sizeof(float));
+                    }
+                }
+
                 constexpr bool isSpace(djv_char_t c)
                 {
                     return ' ' == c || '\t' == c;
@@ -135,6 +405,52 @@ namespace djv
                 return std::shared_ptr<Glyph>(new Glyph);
             }
 
+            std::shared_ptr<Image::Data> createSDF(const Image::Data& data, uint16_t spread)
+            {
+                const size_t w = data.getWidth() + spread * 2;
+                const size_t h = data.getHeight() + spread * 2;
+                const Image::Info info(static_cast<uint16_t>(w), static_cast<uint16_t>(h), Image::Type::L_U8);
+                auto out = Image::Data::create(info);
+
+                // Find the squared distances from the outside pixels to the inside
+                // pixels, and from the inside pixels to the outside pixels.
+                const float far = static_cast<float>(w * w + h * h);
+                std::vector<float> outside(w * h, far);
+                std::vector<float> inside(w * h, 0.F);
+                const size_t pixelByteCount = data.getPixelByteCount();
+                for (uint16_t y = 0; y < data.getHeight(); ++y)
+                {
+                    const uint8_t* p = data.getData(y);
+                    for (uint16_t x = 0; x < data.getWidth(); ++x, p += pixelByteCount)
+                    {
+                        if (*p >= 128)
+                        {
+                            const size_t i = (y + spread) * w + x + spread;
+                            outside[i] = 0.F;
+                            inside[i] = far;
+                        }
+                    }
+                }
+                distanceTransform(outside, w, h);
+                distanceTransform(inside, w, h);
+
+                // The outline is half way between the inside and outside pixels.
+                for (size_t y = 0; y < h; ++y)
+                {
+                    uint8_t* p = out->getData(static_cast<uint16_t>(y));
+                    for (size_t x = 0; x < w; ++x, ++p)
+                    {
+                        const size_t i = y * w + x;
+                        const float d = outside[i] > 0.F ?
+                            (sqrtf(outside[i]) - .5F) :
+                            (.5F - sqrtf(inside[i]));
+                        const float v = Math::clamp(.5F - d / (spread * 2.F), 0.F, 1.F);
+                        *p = static_cast<uint8_t>(lrintf(v * 255.F));
+                    }
+                }
+                return out;
+            }
+
             Error::Error(const std::string& what) :
                 std::runtime_error(what)
             {}
@@ -151,6 +467,7 @@ namespace djv
                 std::map<FamilyID, std::map<FaceID, std::string> > fontFaceNames;
                 std::shared_ptr<MapSubject<FamilyID, std::map<FaceID, std::string> > > fontFaceNamesSubject;
                 std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
+                std::map<FamilyID, std::map<FaceID, std::string> > fontFaceFileNames;
                 std::map<std::string, FamilyID> fontNameToID;
                 std::map<std::pair<FamilyID, std::string>, FamilyID> fontFaceNameToID;
 
@@ -171,20 +488,39 @@ namespace djv
                 Memory::Cache<GlyphInfo, std::shared_ptr<Glyph> > glyphCache;
                 std::atomic<size_t> glyphCacheSize;
                 std::atomic<float> glyphCachePercentageUsed;
+                std::vector<Rasterizer> rasterizers;
+
+                std::atomic<bool> sdf;
+                std::atomic<bool> clearGlyphCaches;
+                Memory::Cache<GlyphInfo, std::shared_ptr<Glyph> > sdfGlyphCache;
+                Memory::Cache<GlyphInfo, std::shared_ptr<SDFGlyph> > sdfCache;
+                std::atomic<size_t> sdfCacheSize;
+
+                Memory::Cache<TextRunKey, std::shared_ptr<TextRun> > textRunCache;
+                std::mutex textRunCacheMutex;
+                std::atomic<size_t> textRunCacheSize;
+                std::atomic<float> textRunCachePercentageUsed;
+                std::atomic<size_t> textRunRequests;
+                std::atomic<size_t> textRunHits;
 
                 std::shared_ptr<Time::Timer> statsTimer;
                 std::thread thread;
                 std::atomic<bool> running;
 
                 bool getText(const std::string&, const Info&, std::basic_string<djv_char_t>&, FT_Face&, std::string& error);
-                std::shared_ptr<Glyph> getGlyph(const GlyphInfo &);
+                FT_Face getFace(Rasterizer&, const Info&) const;
+                std::vector<std::shared_ptr<Glyph> > getGlyphs(const std::basic_string<djv_char_t>&, const Info&, bool sdf);
                 void measure(
                     const std::basic_string<djv_char_t>& utf32,
                     const Info&,
+                    bool sdf,
                     FT_Face,
                     uint16_t maxLineWidth,
                     glm::vec2&,
                     std::vector<BBox2f>* = nullptr);
+
+                std::shared_ptr<TextRun> getTextRun(const std::string&, const Info&, bool sdf);
+                void setTextRun(const std::string&, const Info&, bool sdf, const std::function<void(TextRun&)>&);
             };
 
             void System::_init(const std::shared_ptr<Core::Context>& context)
@@ -201,6 +537,16 @@ namespace djv
                 p.glyphCache.setMax(glyphCacheMax);
                 p.glyphCacheSize = 0;
                 p.glyphCachePercentageUsed = 0.F;
+                p.textRunCache.setMax(textRunCacheMax);
+                p.textRunCacheSize = 0;
+                p.textRunCachePercentageUsed = 0.F;
+                p.textRunRequests = 0;
+                p.textRunHits = 0;
+                p.sdf = false;
+                p.clearGlyphCaches = false;
+                p.sdfGlyphCache.setMax(glyphCacheMax);
+                p.sdfCache.setMax(sdfCacheMax);
+                p.sdfCacheSize = 0;
 
                 p.fontNamesTimer = Time::Timer::create(context);
                 p.fontNamesTimer->setRepeating(true);
@@ -228,7 +574,10 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     std::stringstream ss;
-                    ss << "Glyph cache: " << p.glyphCacheSize << ", " << p.glyphCachePercentageUsed << "%";
+                    ss << "Glyph cache: " << p.glyphCacheSize << ", " << p.glyphCachePercentageUsed << "%\n";
+                    ss << "SDF cache: " << p.sdfCacheSize << "\n";
+                    ss << "Text run cache: " << p.textRunCacheSize << ", " << p.textRunCachePercentageUsed << "%, ";
+                    ss << getTextRunCacheHitRate() << "% hits";
                     _log(ss.str());
                 });
 
@@ -249,6 +598,7 @@ namespace djv
                             {
                                 DJV_PRIVATE_PTR();
                                 return
+                                    p.clearGlyphCaches ||
                                     p.metricsQueue.size() ||
                                     p.measureQueue.size() ||
                                     p.glyphsQueue.size() ||
@@ -260,6 +610,15 @@ namespace djv
                             p.glyphsRequests = std::move(p.glyphsQueue);
                             p.textLinesRequests = std::move(p.textLinesQueue);
                         }
+                        if (p.clearGlyphCaches.exchange(false))
+                        {
+                            p.glyphCache.clear();
+                            p.sdfGlyphCache.clear();
+                            p.sdfCache.clear();
+                            p.glyphCacheSize = 0;
+                            p.glyphCachePercentageUsed = 0.F;
+                            p.sdfCacheSize = 0;
+                        }
                         if (p.metricsRequests.size())
                         {
                             _handleMetricsRequests();
@@ -303,6 +662,7 @@ namespace djv
             {
                 auto out = std::shared_ptr<System>(new System);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
             
@@ -336,12 +696,23 @@ namespace djv
                 MeasureRequest request;
                 request.text = text;
                 request.info = info;
+                request.sdf = p.sdf;
                 auto future = request.promise.get_future();
+                ++p.textRunRequests;
+                const auto textRun = p.getTextRun(text, info, request.sdf);
+                if (textRun && textRun->measured)
                 {
-                    std::unique_lock<std::mutex> lock(p.requestMutex);
-                    p.measureQueue.push_back(std::move(request));
+                    ++p.textRunHits;
+                    request.promise.set_value(textRun->size);
+                }
+                else
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(p.requestMutex);
+                        p.measureQueue.push_back(std::move(request));
+                    }
+                    p.requestCV.notify_one();
                 }
-                p.requestCV.notify_one();
                 return future;
             }
 
@@ -351,12 +722,23 @@ namespace djv
                 MeasureGlyphsRequest request;
                 request.text = text;
                 request.info = info;
+                request.sdf = p.sdf;
                 auto future = request.promise.get_future();
+                ++p.textRunRequests;
+                const auto textRun = p.getTextRun(text, info, request.sdf);
+                if (textRun && textRun->measured)
                 {
-                    std::unique_lock<std::mutex> lock(p.requestMutex);
-                    p.measureGlyphsQueue.push_back(std::move(request));
+                    ++p.textRunHits;
+                    request.promise.set_value(textRun->glyphGeom);
+                }
+                else
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(p.requestMutex);
+                        p.measureGlyphsQueue.push_back(std::move(request));
+                    }
+                    p.requestCV.notify_one();
                 }
-                p.requestCV.notify_one();
                 return future;
             }
 
@@ -366,12 +748,23 @@ namespace djv
                 GlyphsRequest request;
                 request.text = text;
                 request.info = info;
+                request.sdf = p.sdf;
                 auto future = request.promise.get_future();
+                ++p.textRunRequests;
+                const auto textRun = p.getTextRun(text, info, request.sdf);
+                if (textRun && textRun->hasGlyphs)
                 {
-                    std::unique_lock<std::mutex> lock(p.requestMutex);
-                    p.glyphsQueue.push_back(std::move(request));
+                    ++p.textRunHits;
+                    request.promise.set_value(textRun->glyphs);
+                }
+                else
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(p.requestMutex);
+                        p.glyphsQueue.push_back(std::move(request));
+                    }
+                    p.requestCV.notify_one();
                 }
-                p.requestCV.notify_one();
                 return future;
             }
 
@@ -381,6 +774,7 @@ namespace djv
                 TextLinesRequest request;
                 request.text = text;
                 request.info = info;
+                request.sdf = p.sdf;
                 request.maxLineWidth = maxLineWidth;
                 auto future = request.promise.get_future();
                 {
@@ -397,6 +791,7 @@ namespace djv
                 GlyphsRequest request;
                 request.text = text;
                 request.info = info;
+                request.sdf = p.sdf;
                 request.cacheOnly = true;
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
@@ -415,6 +810,51 @@ namespace djv
                 return _p->glyphCachePercentageUsed;
             }
 
+            bool System::isSDFEnabled() const
+            {
+                return _p->sdf;
+            }
+
+            void System::setSDFEnabled(bool value)
+            {
+                DJV_PRIVATE_PTR();
+                if (value == p.sdf)
+                    return;
+                p.sdf = value;
+
+                // The glyph caches are only used by the font thread.
+                p.clearGlyphCaches = true;
+                p.requestCV.notify_one();
+                {
+                    std::unique_lock<std::mutex> lock(p.textRunCacheMutex);
+                    p.textRunCache.clear();
+                    p.textRunCacheSize = 0;
+                    p.textRunCachePercentageUsed = 0.F;
+                }
+            }
+
+            size_t System::getSDFCacheSize() const
+            {
+                return _p->sdfCacheSize;
+            }
+
+            size_t System::getTextRunCacheSize() const
+            {
+                return _p->textRunCacheSize;
+            }
+
+            float System::getTextRunCachePercentage() const
+            {
+                return _p->textRunCachePercentageUsed;
+            }
+
+            float System::getTextRunCacheHitRate() const
+            {
+                DJV_PRIVATE_PTR();
+                const size_t requests = p.textRunRequests;
+                return requests > 0 ? (p.textRunHits / static_cast<float>(requests) * 100.F) : 0.F;
+            }
+
             void System::_initFreeType()
             {
                 DJV_PRIVATE_PTR();
@@ -497,12 +937,31 @@ namespace djv
                             p.fontNames[familyID] = ftFace->family_name;
                             p.fontFaceNames[familyID][faceID] = ftFace->style_name;
                             p.fontFaces[familyID][faceID] = ftFace;
+                            p.fontFaceFileNames[familyID][faceID] = fileName;
                         }
                     }
                     if (!p.fontFaces.size())
                     {
                         throw Error("No fonts were found.");
                     }
+
+                    // Create the FreeType state for the additional rasterizer threads,
+                    // the font faces are loaded as they are needed.
+                    const size_t threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+                    const size_t rasterizerCount = std::min(threadCount, rasterizerCountMax) - 1;
+                    for (size_t i = 0; i < rasterizerCount; ++i)
+                    {
+                        Rasterizer rasterizer;
+                        if (!FT_Init_FreeType(&rasterizer.ftLibrary))
+                        {
+                            p.rasterizers.push_back(rasterizer);
+                        }
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << "Glyph rasterizer threads: " << (p.rasterizers.size() + 1);
+                        _log(ss.str());
+                    }
                 }
                 catch (const std::exception & e)
                 {
@@ -513,6 +972,18 @@ namespace djv
             void System::_delFreeType()
             {
                 DJV_PRIVATE_PTR();
+                for (const auto& rasterizer : p.rasterizers)
+                {
+                    for (const auto& i : rasterizer.fontFaces)
+                    {
+                        for (const auto& j : i.second)
+                        {
+                            FT_Done_Face(j.second);
+                        }
+                    }
+                    FT_Done_FreeType(rasterizer.ftLibrary);
+                }
+                p.rasterizers.clear();
                 if (p.ftLibrary)
                 {
                     for (const auto & i : p.fontFaces)
@@ -566,13 +1037,32 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 for (auto& request : p.measureRequests)
                 {
+                    // The text may have been measured by an earlier request.
+                    const auto textRun = p.getTextRun(request.text, request.info, request.sdf);
+                    if (textRun && textRun->measured)
+                    {
+                        request.promise.set_value(textRun->size);
+                        continue;
+                    }
+
                     std::basic_string<djv_char_t> utf32;
                     FT_Face font;
                     std::string error;
                     glm::vec2 size = glm::vec2(0.F, 0.F);
                     if (p.getText(request.text, request.info, utf32, font, error))
                     {
-                        p.measure(utf32, request.info, font, request.maxLineWidth, size);
+                        std::vector<BBox2f> glyphGeom;
+                        p.measure(utf32, request.info, request.sdf, font, request.maxLineWidth, size, &glyphGeom);
+                        p.setTextRun(
+                            request.text,
+                            request.info,
+                            request.sdf,
+                            [&size, &glyphGeom](TextRun& value)
+                            {
+                                value.measured = true;
+                                value.size = size;
+                                value.glyphGeom = std::move(glyphGeom);
+                            });
                     }
                     else
                     {
@@ -590,6 +1080,13 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 for (auto& request : p.measureGlyphsRequests)
                 {
+                    const auto textRun = p.getTextRun(request.text, request.info, request.sdf);
+                    if (textRun && textRun->measured)
+                    {
+                        request.promise.set_value(textRun->glyphGeom);
+                        continue;
+                    }
+
                     std::basic_string<djv_char_t> utf32;
                     FT_Face font;
                     std::string error;
@@ -597,7 +1094,17 @@ namespace djv
                     std::vector<BBox2f> glyphGeom;
                     if (p.getText(request.text, request.info, utf32, font, error))
                     {
-                        p.measure(utf32, request.info, font, request.maxLineWidth, size, &glyphGeom);
+                        p.measure(utf32, request.info, request.sdf, font, request.maxLineWidth, size, &glyphGeom);
+                        p.setTextRun(
+                            request.text,
+                            request.info,
+                            request.sdf,
+                            [&size, &glyphGeom](TextRun& value)
+                            {
+                                value.measured = true;
+                                value.size = size;
+                                value.glyphGeom = glyphGeom;
+                            });
                     }
                     else
                     {
@@ -615,6 +1122,16 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 for (auto & request : p.glyphsRequests)
                 {
+                    if (!request.cacheOnly)
+                    {
+                        const auto textRun = p.getTextRun(request.text, request.info, request.sdf);
+                        if (textRun && textRun->hasGlyphs)
+                        {
+                            request.promise.set_value(textRun->glyphs);
+                            continue;
+                        }
+                    }
+
                     std::basic_string<djv_char_t> utf32;
                     try
                     {
@@ -626,22 +1143,19 @@ namespace djv
                         ss << "Error converting string" << " '" << request.text << "': " << e.what();
                         _log(ss.str(), LogLevel::Error);
                     }
-                    const size_t size = utf32.size();
-                    if (request.cacheOnly)
-                    {
-                        for (size_t i = 0; i < size; ++i)
-                        {
-                            p.getGlyph(GlyphInfo(utf32[i], request.info));
-                        }
-                    }
-                    else
+                    const auto glyphs = p.getGlyphs(utf32, request.info, request.sdf);
+                    if (!request.cacheOnly)
                     {
-                        std::vector<std::shared_ptr<Glyph> > glyphs(size);
-                        for (size_t i = 0; i < size; ++i)
-                        {
-                            glyphs[i] = p.getGlyph(GlyphInfo(utf32[i], request.info));
-                        }
-                        request.promise.set_value(std::move(glyphs));
+                        p.setTextRun(
+                            request.text,
+                            request.info,
+                            request.sdf,
+                            [&glyphs](TextRun& value)
+                            {
+                                value.hasGlyphs = true;
+                                value.glyphs = glyphs;
+                            });
+                        request.promise.set_value(glyphs);
                     }
                 }
                 p.glyphsRequests.clear();
@@ -674,22 +1188,15 @@ namespace djv
                     if (p.getText(request.text, request.info, utf32, font, error))
                     {
                         // Get the glyphs.
-                        std::vector<std::shared_ptr<Glyph> > glyphs(utf32.size());
-                        const auto utf32Begin = utf32.begin();
-                        auto i = utf32Begin;
-                        for (; i != utf32.end(); ++i)
-                        {
-                            const auto info = GlyphInfo(*i, request.info);
-                            auto glyph = p.getGlyph(info);
-                            glyphs[i - utf32Begin] = glyph;
-                        }
+                        const auto glyphs = p.getGlyphs(utf32, request.info, request.sdf);
 
+                        const auto utf32Begin = utf32.begin();
                         glm::vec2 pos = glm::vec2(0.F, font->size->metrics.height / 64.F);
                         auto lineBegin = utf32Begin;
                         auto lineBreak = utf32.end();
                         float lineBreakPos = 0.F;
                         int32_t rsbDeltaPrev = 0;
-                        i = utf32Begin;
+                        auto i = utf32Begin;
                         for (; i != utf32.end(); ++i)
                         {
                             // Get the current glyph's advance.
@@ -875,105 +1382,130 @@ namespace djv
                 return out;
             }
 
-            std::shared_ptr<Glyph> System::Private::getGlyph(const GlyphInfo & info)
+            FT_Face System::Private::getFace(Rasterizer& rasterizer, const Info& info) const
             {
-                std::shared_ptr<Glyph> out;
-                FT_Face ftFace = nullptr;
-                if (!glyphCache.get(info, out))
+                FT_Face out = findFace(rasterizer.fontFaces, info);
+                if (!out)
                 {
-                    out = Glyph::create();
-                    out->info = info;
-                    if (info.info.getFamily() != 0 || info.info.getFace() != 0)
+                    const auto i = fontFaceFileNames.find(info.getFamily());
+                    if (i != fontFaceFileNames.end())
                     {
-                        const auto i = fontFaces.find(info.info.getFamily());
-                        if (i != fontFaces.end())
+                        const auto j = i->second.find(info.getFace());
+                        if (j != i->second.end())
                         {
-                            const auto j = i->second.find(info.info.getFace());
-                            if (j != i->second.end())
+                            if (!FT_New_Face(rasterizer.ftLibrary, j->second.c_str(), 0, &out))
+                            {
+                                rasterizer.fontFaces[info.getFamily()][info.getFace()] = out;
+                            }
+                            else
                             {
-                                ftFace = j->second;
+                                out = nullptr;
                             }
                         }
                     }
-                    if (ftFace)
+                }
+                return out;
+            }
+
+            std::vector<std::shared_ptr<Glyph> > System::Private::getGlyphs(
+                const std::basic_string<djv_char_t>& utf32,
+                const Info& info,
+                bool sdf)
+            {
+                // Get the glyphs from the cache.
+                auto& cache = sdf ? sdfGlyphCache : glyphCache;
+                const size_t size = utf32.size();
+                std::vector<std::shared_ptr<Glyph> > out(size);
+                std::vector<GlyphInfo> missing;
+                std::set<djv_char_t> missingCodes;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const GlyphInfo glyphInfo(utf32[i], info);
+                    if (!cache.get(glyphInfo, out[i]) && missingCodes.insert(utf32[i]).second)
                     {
-                        /*FT_Error ftError = FT_Set_Char_Size(
-                            ftFace,
-                            0,
-                            static_cast<int>(request.info.getSize() * 64.F),
-                            request.info.getDPI(),
-                            request.info.getDPI());*/
-                        FT_Error ftError = FT_Set_Pixel_Sizes(
-                            ftFace,
-                            0,
-                            static_cast<int>(info.info.getSize()));
-                        if (ftError)
+                        missing.push_back(glyphInfo);
+                    }
+                }
+
+                if (missing.size())
+                {
+                    // Rasterize the new glyphs, splitting them between this thread
+                    // and the rasterizer threads.
+                    const size_t missingSize = missing.size();
+                    std::vector<std::shared_ptr<SDFGlyph> > sdfs(missingSize);
+                    if (sdf)
+                    {
+                        for (size_t i = 0; i < missingSize; ++i)
                         {
-                            //std::cout << "FT_Set_Char_Size error: " << getFTError(ftError) << std::endl;
-                            return nullptr;
+                            const Info& glyphInfo = missing[i].info;
+                            sdfCache.get(
+                                GlyphInfo(missing[i].code, Info(glyphInfo.getFamily(), glyphInfo.getFace(), sdfSize, dpiDefault)),
+                                sdfs[i]);
                         }
+                    }
+                    const size_t threadCount = std::min(
+                        rasterizers.size() + 1,
+                        std::max(missingSize / rasterizerGlyphsMin, static_cast<size_t>(1)));
+                    std::vector<std::shared_ptr<Glyph> > rendered(missingSize);
+                    auto render = [sdf, &missing, &sdfs, &rendered](size_t index, FT_Face ftFace)
+                    {
+                        rendered[index] = sdf ?
+                            renderSDFGlyph(missing[index], ftFace, sdfs[index]) :
+                            renderGlyph(missing[index], ftFace);
+                    };
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 1; i < threadCount; ++i)
+                    {
+                        futures.push_back(std::async(
+                            std::launch::async,
+                            [this, i, threadCount, &missing, &render]
+                            {
+                                auto& rasterizer = rasterizers[i - 1];
+                                for (size_t j = i; j < missing.size(); j += threadCount)
+                                {
+                                    render(j, getFace(rasterizer, missing[j].info));
+                                }
+                            }));
+                    }
+                    for (size_t j = 0; j < missingSize; j += threadCount)
+                    {
+                        render(j, findFace(fontFaces, missing[j].info));
+                    }
+                    for (auto& future : futures)
+                    {
+                        future.get();
+                    }
 
-                        if (auto ftGlyphIndex = FT_Get_Char_Index(ftFace, info.code))
+                    // Add the new glyphs to the cache.
+                    std::map<djv_char_t, std::shared_ptr<Glyph> > renderedCodes;
+                    for (size_t i = 0; i < missingSize; ++i)
+                    {
+                        if (rendered[i])
                         {
-                            ftError = FT_Load_Glyph(ftFace, ftGlyphIndex, FT_LOAD_FORCE_AUTOHINT);
-                            if (ftError)
-                            {
-                                //std::cout << "FT_Load_Glyph error: " << getFTError(ftError) << std::endl;
-                                return nullptr;
-                            }
-                            FT_Render_Mode renderMode = FT_RENDER_MODE_NORMAL;
-                            uint8_t renderModeChannels = 1;
-                            if (lcdHinting)
-                            {
-                                renderMode = FT_RENDER_MODE_LCD;
-                                renderModeChannels = 3;
-                            }
-                            ftError = FT_Render_Glyph(ftFace->glyph, renderMode);
-                            if (ftError)
-                            {
-                                //std::cout << "FT_Render_Glyph error: " << getFTError(ftError) << std::endl;
-                                return nullptr;
-                            }
-                            FT_Glyph ftGlyph;
-                            ftError = FT_Get_Glyph(ftFace->glyph, &ftGlyph);
-                            if (ftError)
-                            {
-                                //std::cout << "FT_Get_Glyph error: " << getFTError(ftError) << std::endl;
-                                return nullptr;
-                            }
-                            FT_Vector v;
-                            v.x = 0;
-                            v.y = 0;
-                            ftError = FT_Glyph_To_Bitmap(&ftGlyph, renderMode, &v, 0);
-                            if (ftError)
-                            {
-                                //std::cout << "FT_Glyph_To_Bitmap error: " << getFTError(ftError) << std::endl;
-                                FT_Done_Glyph(ftGlyph);
-                                return nullptr;
-                            }
-                            FT_BitmapGlyph bitmap = (FT_BitmapGlyph)ftGlyph;
-                            const Image::Info imageInfo = Image::Info(
-                                bitmap->bitmap.width / static_cast<int>(renderModeChannels),
-                                bitmap->bitmap.rows,
-                                Image::getIntType(renderModeChannels, 8));
-                            auto imageData = Image::Data::create(imageInfo);
-                            for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                            cache.add(missing[i], rendered[i]);
+                            renderedCodes[missing[i].code] = rendered[i];
+                        }
+                        if (sdfs[i])
+                        {
+                            const Info& glyphInfo = missing[i].info;
+                            sdfCache.add(
+                                GlyphInfo(missing[i].code, Info(glyphInfo.getFamily(), glyphInfo.getFace(), sdfSize, dpiDefault)),
+                                sdfs[i]);
+                        }
+                    }
+                    glyphCacheSize = glyphCache.getSize();
+                    glyphCachePercentageUsed = glyphCache.getPercentageUsed();
+                    sdfCacheSize = sdfCache.getSize();
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        if (!out[i])
+                        {
+                            const auto j = renderedCodes.find(utf32[i]);
+                            if (j != renderedCodes.end())
                             {
-                                memcpy(
-                                    imageData->getData(y),
-                                    bitmap->bitmap.buffer + static_cast<size_t>(y) * bitmap->bitmap.pitch,
-                                    static_cast<size_t>(imageInfo.size.w) * renderModeChannels);
+                                out[i] = j->second;
                             }
-                            out->imageData = imageData;
-                            out->offset = glm::vec2(ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top);
-                            out->advance = ftFace->glyph->advance.x / 64.F;
-                            out->lsbDelta = ftFace->glyph->lsb_delta;
-                            out->rsbDelta = ftFace->glyph->rsb_delta;
-                            FT_Done_Glyph(ftGlyph);
                         }
-                        glyphCache.add(info, out);
-                        glyphCacheSize = glyphCache.getSize();
-                        glyphCachePercentageUsed = glyphCache.getPercentageUsed();
                     }
                 }
                 return out;
@@ -982,32 +1514,34 @@ namespace djv
             void System::Private::measure(
                 const std::basic_string<djv_char_t>& utf32,
                 const Info& info,
+                bool sdf,
                 FT_Face font,
                 uint16_t maxLineWidth,
                 glm::vec2& size,
                 std::vector<BBox2f>* glyphGeom)
             {
+                const auto glyphs = getGlyphs(utf32, info, sdf);
                 glm::vec2 pos(0.F, font->size->metrics.height / 64.F);
                 auto textLine = utf32.end();
                 float textLineX = 0.F;
                 int32_t rsbDeltaPrev = 0;
                 for (auto i = utf32.begin(); i != utf32.end(); ++i)
                 {
-                    const auto glyphInfo = GlyphInfo(*i, info);
-                    const auto glyph = getGlyph(glyphInfo);
+                    const auto& glyph = glyphs[i - utf32.begin()];
 
                     if (glyphGeom)
                     {
+                        const float advance = glyph ? glyph->advance : 0.F;
                         glyphGeom->push_back(BBox2f(
                             pos.x,
-                            glyph->advance,
-                            glyph->advance,
+                            advance,
+                            advance,
                             font->size->metrics.height / 64.F));
                     }
 
                     int32_t x = 0;
                     glm::vec2 posAndSize(0.F, 0.F);
-                    if (glyph->imageData)
+                    if (glyph && (glyph->imageData || glyph->sdfData))
                     {
                         x = glyph->advance;
                         if (rsbDeltaPrev - glyph->lsbDelta > 32)
@@ -1064,6 +1598,32 @@ namespace djv
                 size.y = pos.y;
             }
 
+            std::shared_ptr<TextRun> System::Private::getTextRun(const std::string& text, const Info& info, bool sdf)
+            {
+                std::shared_ptr<TextRun> out;
+                std::unique_lock<std::mutex> lock(textRunCacheMutex);
+                textRunCache.get(std::make_tuple(text, info, sdf), out);
+                return out;
+            }
+
+            void System::Private::setTextRun(
+                const std::string& text,
+                const Info& info,
+                bool sdf,
+                const std::function<void(TextRun&)>& callback)
+            {
+                const auto key = std::make_tuple(text, info, sdf);
+                std::unique_lock<std::mutex> lock(textRunCacheMutex);
+                std::shared_ptr<TextRun> textRun;
+                auto out = textRunCache.get(key, textRun) ?
+                    std::shared_ptr<TextRun>(new TextRun(*textRun)) :
+                    std::shared_ptr<TextRun>(new TextRun);
+                callback(*out);
+                textRunCache.add(key, out);
+                textRunCacheSize = textRunCache.getSize();
+                textRunCachePercentageUsed = textRunCache.getPercentageUsed();
+            }
+
         } // namespace Font
     } // namespace AV
 } // namespace djv
@@ -27,6 +27,13 @@ namespace djv
             const std::string faceDefault   = "Regular";
             const std::string familyMono    = "Noto Mono";
 
+            //! The font size used to rasterize signed distance field glyphs.
+            const uint16_t sdfSize   = 48;
+
+            //! The distance in pixels covered by the signed distance field
+            //! values, relative to sdfSize.
+            const uint16_t sdfSpread = 6;
+
             //! This class provides font information.
             class Info
             {
@@ -92,6 +99,12 @@ namespace djv
                 uint16_t                     advance   = 0;
                 int32_t                      lsbDelta  = 0;
                 int32_t                      rsbDelta  = 0;
+
+                //! The signed distance field is shared between all of the sizes
+                //! of a glyph, the offset and scale place it at this size.
+                std::shared_ptr<Image::Data> sdfData;
+                glm::vec2                    sdfOffset = glm::vec2(0.F, 0.F);
+                float                        sdfScale  = 1.F;
             };
 
             //! This struct provides a line of text.
@@ -106,6 +119,12 @@ namespace djv
                 std::vector<std::shared_ptr<Glyph> > glyphs;
             };
             
+            //! Create a signed distance field from a glyph coverage bitmap. The
+            //! output is padded by the spread on each side, pixels on the
+            //! glyph outline have a value of 0.5, inside values are greater and
+            //! outside values are less.
+            std::shared_ptr<Image::Data> createSDF(const Image::Data&, uint16_t spread);
+
             //! This class provides a font error.
             class Error : public std::runtime_error
             {
@@ -115,6 +134,10 @@ namespace djv
 
             //! This class provides a font system.
             //!
+            //! Measurements and glyphs for previously requested text are kept
+            //! in a text run cache, requests that hit the cache are answered
+            //! immediately without going through the FreeType thread.
+            //!
             //! \todo Add support for LCD pixel sub-sampling and gamma correction:
             //! - https://www.freetype.org/freetype2/docs/text-rendering-general.html
             class System : public Core::ISystem
@@ -167,11 +190,33 @@ namespace djv
                 //! Request font glyphs to be cached.
                 void cacheGlyphs(const std::string& text, const Info&);
 
+                //! Get whether glyphs are provided as signed distance fields.
+                bool isSDFEnabled() const;
+
+                //! Set whether glyphs are provided as signed distance fields
+                //! instead of bitmaps. Signed distance field glyphs are only
+                //! rasterized once and shared between all font sizes. Changing
+                //! this clears the glyph and text run caches.
+                void setSDFEnabled(bool);
+
                 //! Get the glyph cache size.
                 size_t getGlyphCacheSize() const;
 
                 //! Get the glyph cache percentage used.
                 float getGlyphCachePercentage() const;
+
+                //! Get the number of signed distance fields.
+                size_t getSDFCacheSize() const;
+
+                //! Get the text run cache size.
+                size_t getTextRunCacheSize() const;
+
+                //! Get the text run cache percentage used.
+                float getTextRunCachePercentage() const;
+
+                //! Get the percentage of measure and glyph requests that were
+                //! answered from the text run cache.
+                float getTextRunCacheHitRate() const;
             
             private:
                 void _initFreeType();
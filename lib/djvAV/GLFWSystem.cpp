@@ -207,6 +207,7 @@ namespace djv
             {
                 auto out = std::shared_ptr<System>(new System);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
 
@@ -50,10 +50,11 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
 
                 private:
-                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&);
-                    
-                    int  _tiles       = 0;
-                    bool _compression = false;
+                    Info _open(
+                        const std::string &,
+                        const std::shared_ptr<Core::FileSystem::FileIO>&,
+                        int& tiles,
+                        bool& compression);
                 };
 
                 //! This class provides the IFF file I/O plugin.
@@ -67,6 +68,7 @@ namespace djv
                 public:
                     static std::shared_ptr<Plugin> create(const std::shared_ptr<Core::Context>&);
 
+                    bool hasDecodeThreads() const override;
                     std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const override;
                 };
 
@@ -10,6 +10,8 @@
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -33,37 +35,143 @@ namespace djv
                         return size;
                     }
 
-                    size_t readRle(const std::shared_ptr<FileSystem::FileIO>& io, uint8_t* out, size_t size)
+                    //! This struct provides a tile read from the file.
+                    struct Tile
+                    {
+                        uint16_t xmin = 0;
+                        uint16_t ymin = 0;
+                        uint16_t xmax = 0;
+                        uint16_t ymax = 0;
+                        std::vector<uint8_t> data;
+                    };
+
+                    // Decompress RLE data from memory, expanding the packets with
+                    // memset() and memcpy(). Returns the number of bytes read or
+                    // zero if the data is not valid.
+                    size_t readRle(const uint8_t* in, const uint8_t* inEnd, uint8_t* out, size_t size)
                     {
-                        const size_t pos = io->getPos();
-                        const uint8_t* const end = out + size;
-                        while (out < end)
+                        const uint8_t* const inStart = in;
+                        const uint8_t* const outEnd = out + size;
+                        while (out < outEnd)
                         {
                             // Information.
-                            uint8_t in = 0;
-                            io->readU8(&in);
-                            const uint8_t count = (in & 0x7f) + 1;
-                            const bool run = (in & 0x80) ? true : false;
+                            if (in >= inEnd)
+                            {
+                                return 0;
+                            }
+                            const size_t count = (*in & 0x7f) + 1;
+                            const bool run = (*in & 0x80) ? true : false;
+                            ++in;
+                            if (out + count > outEnd)
+                            {
+                                return 0;
+                            }
 
                             // Find runs.
                             if (!run)
                             {
                                 // Verbatim.
-                                io->readU8(out, count);
-                                out += count;
+                                if (in + count > inEnd)
+                                {
+                                    return 0;
+                                }
+                                memcpy(out, in, count);
+                                in += count;
                             }
                             else
                             {
                                 // Duplicate.
-                                io->readU8(&in);
-                                const uint8_t p = in;
-                                for (int i = 0; i < count; i++)
+                                if (in >= inEnd)
                                 {
-                                    *out++ = p;
+                                    return 0;
                                 }
+                                memset(out, *in, count);
+                                ++in;
                             }
+                            out += count;
                         }
-                        return io->getPos() - pos;
+                        return in - inStart;
+                    }
+
+                    bool readTile(const Tile& tile, Image::Type type, uint8_t* out, size_t scanlineByteCount)
+                    {
+                        const size_t channels = Image::getChannelCount(type);
+                        const size_t channelByteCount = Image::getByteCount(Image::getDataType(type));
+                        const size_t byteCount = Image::getByteCount(type);
+                        const size_t tw = static_cast<size_t>(tile.xmax) - tile.xmin + 1;
+                        const size_t th = static_cast<size_t>(tile.ymax) - tile.ymin + 1;
+                        const uint8_t* inP = tile.data.data();
+                        const uint8_t* const inEnd = inP + tile.data.size();
+
+                        // If tile compression fails to be less than image data
+                        // stored uncompressed, the tile is written uncompressed.
+                        if (tile.data.size() < tw * th * byteCount)
+                        {
+                            // Set map.
+                            int map[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+                            if (2 == channelByteCount)
+                            {
+                                const bool lsb = Memory::getEndian() == Memory::Endian::LSB;
+                                const int rgb16Lsb[] = { 0, 2, 4, 1, 3, 5 };
+                                const int rgba16Lsb[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
+                                const int rgb16Msb[] = { 1, 3, 5, 0, 2, 4 };
+                                const int rgba16Msb[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
+                                const int* p = 3 == channels ?
+                                    (lsb ? rgb16Lsb : rgb16Msb) :
+                                    (lsb ? rgba16Lsb : rgba16Msb);
+                                std::copy(p, p + channels * channelByteCount, map);
+                            }
+
+                            // Map: RGB(A) BGRA to RGBA
+                            std::vector<uint8_t> plane(tw * th);
+                            for (int c = static_cast<int>(channels * channelByteCount) - 1; c >= 0; --c)
+                            {
+                                // Uncompress.
+                                const size_t size = readRle(inP, inEnd, plane.data(), plane.size());
+                                if (!size)
+                                {
+                                    return false;
+                                }
+                                inP += size;
+
+                                const uint8_t* planeP = plane.data();
+                                for (size_t y = tile.ymin; y <= tile.ymax; ++y)
+                                {
+                                    uint8_t* outP = out + y * scanlineByteCount + tile.xmin * byteCount + map[c];
+                                    for (size_t x = 0; x < tw; ++x, outP += byteCount)
+                                    {
+                                        *outP = *planeP++;
+                                    }
+                                }
+                            }
+
+                            // Test.
+                            return inEnd == inP;
+                        }
+
+                        // Map: RGB(A) ABGR to ARGB
+                        const bool endian = 2 == channelByteCount && Memory::getEndian() == Memory::Endian::LSB;
+                        for (size_t y = tile.ymin; y <= tile.ymax; ++y)
+                        {
+                            uint8_t* outP = out + y * scanlineByteCount + tile.xmin * byteCount;
+                            for (size_t x = 0; x < tw; ++x, inP += byteCount)
+                            {
+                                for (int c = static_cast<int>(channels) - 1; c >= 0; --c, outP += channelByteCount)
+                                {
+                                    const uint8_t* p = inP + c * channelByteCount;
+                                    if (endian)
+                                    {
+                                        outP[0] = p[1];
+                                        outP[1] = p[0];
+                                    }
+                                    else
+                                    {
+                                        memcpy(outP, p, channelByteCount);
+                                    }
+                                }
+                            }
+                        }
+                        return true;
                     }
 
                 } // namespace
@@ -91,25 +199,30 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    int tiles = 0;
+                    bool compression = false;
+                    return _open(fileName, io, tiles, compression);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
                     std::shared_ptr<Image::Image> out;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
-                    out = Image::Image::create(info.video[0].info);
+                    int tiles = 0;
+                    bool compression = false;
+                    const auto info = _open(fileName, io, tiles, compression);
+                    const Image::Info& imageInfo = info.video[0].info;
+                    out = Image::Image::create(imageInfo);
                     out->setPluginName(pluginName);
 
                     uint8_t type[4];
-                    uint8_t pixels[32];
                     uint32_t size;
                     uint32_t chunkSize;
-                    uint32_t tilesRgba = _tiles;
+                    uint32_t tilesRgba = tiles;
 
-                    const size_t channelByteCount = Image::getByteCount(Image::getDataType(info.video[0].info.type));
-                    const size_t byteCount = Image::getByteCount(info.video[0].info.type);
+                    // Read the tiles from the file. They are decompressed
+                    // afterwards in parallel.
+                    std::vector<Tile> tileList;
 
                     // Read FOR4 <size> TBMP block
                     while (!io->isEOF())
@@ -172,278 +285,35 @@ namespace djv
                                         type[2] == 'B' &&
                                         type[3] == 'A')
                                     {
-                                        // Set image size.
-                                        uint32_t imageSize = size;
-
                                         // Get tile coordinates.
-                                        uint16_t xmin;
-                                        uint16_t xmax;
-                                        uint16_t ymin;
-                                        uint16_t ymax;
-                                        io->readU16(&xmin, 1);
-                                        io->readU16(&ymin, 1);
-                                        io->readU16(&xmax, 1);
-                                        io->readU16(&ymax, 1);
-
-                                        if (xmin > xmax ||
-                                            ymin > ymax ||
-                                            xmax >= info.video[0].info.size.w ||
-                                            ymax >= info.video[0].info.size.h)
-                                        {
-                                            throw FileSystem::Error(String::Format("{0}: {1}").
-                                                arg(fileName).
-                                                arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
-                                        }
+                                        Tile tile;
+                                        io->readU16(&tile.xmin, 1);
+                                        io->readU16(&tile.ymin, 1);
+                                        io->readU16(&tile.xmax, 1);
+                                        io->readU16(&tile.ymax, 1);
 
                                         // NOTE: tile w = xmax - xmin + 1
                                         //       tile h = ymax - ymin + 1
-
-                                        uint32_t tw = xmax - xmin + 1;
-                                        uint32_t th = ymax - ymin + 1;
-
-                                        if (!tw || !th)
+                                        if (size < 8 ||
+                                            tile.xmin > tile.xmax ||
+                                            tile.ymin > tile.ymax ||
+                                            tile.xmax >= imageInfo.size.w ||
+                                            tile.ymax >= imageInfo.size.h)
                                         {
                                             throw FileSystem::Error(String::Format("{0}: {1}").
                                                 arg(fileName).
                                                 arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
                                         }
 
-                                        bool tile_compress = false;
-
-                                        // If tile compression fails to be less than
-                                        // image data stored uncompressed, the tile
-                                        // is written uncompressed.
-
-                                        // Set channels.
-                                        uint8_t channels = Image::getChannelCount(info.video[0].info.type);
-
-                                        // Set tile pixels.
-
-                                        // Append xmin, xmax, ymin and ymax.
-                                        uint32_t tileSize =
-                                            tw * th * channels *
-                                            Image::getByteCount(Image::getDataType(info.video[0].info.type)) + 8;
-
-                                        // Test compressed.
-                                        if (tileSize > imageSize)
-                                        {
-                                            tile_compress = true;
-                                        }
-
-                                        // Handle 8-bit data.
-                                        if (info.video[0].info.type == Image::Type::RGB_U8 ||
-                                            info.video[0].info.type == Image::Type::RGBA_U8)
-                                        {
-                                            // Tile compress.
-                                            if (tile_compress)
-                                            {
-                                                int p = 0;
-
-                                                // Map: RGB(A)8 BGRA to RGBA
-                                                for (int c = (channels * channelByteCount) - 1;
-                                                    c >= 0;
-                                                    --c)
-                                                {
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
-
-                                                    // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
-
-                                                    for (uint16_t py = ymin; py <= ymax; py++)
-                                                    {
-                                                        uint8_t* out_dy = out->getData(0, py);
-
-                                                        for (uint16_t px = xmin; px <= xmax; px++)
-                                                        {
-                                                            uint8_t* outP = out_dy + px * byteCount + c;
-                                                            *outP++ = *inP++;
-                                                        }
-                                                    }
-                                                }
-
-                                                // Test.
-                                                if (p != imageSize - 8)
-                                                {
-                                                    throw FileSystem::Error(String::Format("{0}: {1}").
-                                                        arg(fileName).
-                                                        arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
-                                                }
-                                            }
-                                            else
-                                            {
-                                                for (uint16_t py = ymin; py <= ymax; py++)
-                                                {
-                                                    uint8_t* out_dy = out->getData(xmin, py);
-
-                                                    // Tile scanline.
-                                                    std::vector<uint8_t> scanline(tw * byteCount);
-                                                    uint8_t* outP = scanline.data();
-
-                                                    // Set bytes.
-                                                    for (uint16_t px = xmin; px <= xmax; px++)
-                                                    {
-                                                        // Get pixels.
-                                                        io->read(&pixels, byteCount);
-
-                                                        if (size < static_cast<uint32_t>(byteCount))
-                                                        {
-                                                            throw FileSystem::Error(String::Format("{0}: {1}").
-                                                                arg(fileName).
-                                                                arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
-                                                        }
-
-                                                        size -= byteCount;
-
-                                                        // Map: RGB(A)8 ABGR to ARGB
-                                                        for (int c = channels - 1; c >= 0; --c)
-                                                        {
-                                                            uint8_t pixel;
-                                                            uint8_t* inP = pixels + c * channelByteCount;
-                                                            memcpy(&pixel, inP, 1);
-                                                            *outP++ = pixel;
-                                                        }
-                                                    }
-
-                                                    // Copy data.
-                                                    memcpy(out_dy, scanline.data(), tw * byteCount);
-                                                }
-                                            }
-                                        }
-                                        // Handle 16-bit data.
-                                        else if (
-                                            info.video[0].info.type == Image::Type::RGB_U16 ||
-                                            info.video[0].info.type == Image::Type::RGBA_U16)
-                                        {
-                                            if (tile_compress)
-                                            {
-                                                // Set bytes.
-                                                int p = 0;
-
-                                                // Set map.
-                                                int* map = NULL;
-
-                                                if (Memory::getEndian() == Memory::Endian::LSB)
-                                                {
-                                                    int rgb16[] = { 0, 2, 4, 1, 3, 5 };
-                                                    int rgba16[] = { 0, 2, 4, 7, 1, 3, 5, 6 };
-
-                                                    if (info.video[0].info.type == Image::Type::RGB_U16)
-                                                    {
-                                                        map = rgb16;
-                                                    }
-                                                    else
-                                                    {
-                                                        map = rgba16;
-                                                    }
-                                                }
-                                                else
-                                                {
-                                                    int rgb16[] = { 1, 3, 5, 0, 2, 4 };
-                                                    int rgba16[] = { 1, 3, 5, 7, 0, 2, 4, 6 };
-
-                                                    if (info.video[0].info.type == Image::Type::RGB_U16)
-                                                    {
-                                                        map = rgb16;
-                                                    }
-                                                    else
-                                                    {
-                                                        map = rgba16;
-                                                    }
-                                                }
-
-                                                // Map: RGB(A)8 BGRA to RGBA
-                                                for (int c = (channels * channelByteCount) - 1; c >= 0; --c)
-                                                {
-                                                    int mc = map[c];
-
-                                                    std::vector<uint8_t> in(static_cast<size_t>(tw) * static_cast<size_t>(th));
-                                                    uint8_t* inP = in.data();
-
-                                                    // Uncompress.
-                                                    p += readRle(io, in.data(), static_cast<size_t>(tw) * static_cast<size_t>(th));
-
-                                                    for (uint16_t py = ymin; py <= ymax; py++)
-                                                    {
-                                                        uint8_t* out_dy = out->getData(0, py);
-
-                                                        for (uint16_t px = xmin; px <= xmax; px++)
-                                                        {
-                                                            uint8_t* outP = out_dy + px * byteCount + mc;
-                                                            *outP++ = *inP++;
-                                                        }
-                                                    }
-                                                }
-
-                                                // Test.
-                                                if (p != imageSize - 8)
-                                                {
-                                                    throw FileSystem::Error(String::Format("{0}: {1}").
-                                                        arg(fileName).
-                                                        arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
-                                                }
-                                            }
-                                            else
-                                            {
-                                                for (uint16_t py = ymin; py <= ymax; py++)
-                                                {
-                                                    uint8_t* out_dy = out->getData(xmin, py);
-
-                                                    // Tile scanline.
-                                                    std::vector<uint16_t> scanline(tw * byteCount);
-                                                    uint16_t* outP = scanline.data();
-
-                                                    // Set bytes.
-                                                    for (uint16_t px = xmin; px <= xmax; px++)
-                                                    {
-                                                        // Get pixels.
-                                                        io->read(&pixels, byteCount);
-
-                                                        if (size < static_cast<uint32_t>(byteCount))
-                                                        {
-                                                            throw FileSystem::Error(String::Format("{0}: {1}").
-                                                                arg(fileName).
-                                                                arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
-                                                        }
-
-                                                        size -= byteCount;
-
-                                                        // Map: RGB8 ABGR to ARGB
-                                                        for (int c = channels - 1; c >= 0; --c)
-                                                        {
-                                                            uint16_t pixel;
-                                                            uint8_t* in = pixels + c * channelByteCount;
-
-                                                            if (Memory::getEndian() == Memory::Endian::LSB)
-                                                            {
-                                                                Memory::endian(in, &pixel, 1, 2);
-                                                            }
-                                                            else
-                                                            {
-                                                                memcpy(&pixel, in, 2);
-                                                            }
-
-                                                            // Set pixel.
-                                                            *outP++ = pixel;
-                                                        }
-                                                    }
-
-                                                    // Copy data.
-                                                    memcpy(out_dy, scanline.data(), tw * byteCount);
-                                                }
-                                            }
-                                        }
-                                        else
-                                        {
-                                            io->seek(chunkSize);
-                                        }
+                                        // Get the tile pixels.
+                                        tile.data.resize(size - 8);
+                                        io->read(tile.data.data(), tile.data.size());
+                                        tileList.push_back(std::move(tile));
 
                                         // Seek to align to chunksize.
-                                        size = chunkSize - imageSize;
-
-                                        if (size)
+                                        if (chunkSize > size)
                                         {
-                                            io->seek(size);
+                                            io->seek(chunkSize - size);
                                         }
 
                                         tilesRgba--;
@@ -476,6 +346,50 @@ namespace djv
                         }
                     }
 
+                    // Decompress the tiles. The tiles do not overlap so each
+                    // thread can write directly into the image.
+                    switch (imageInfo.type)
+                    {
+                    case Image::Type::RGB_U8:
+                    case Image::Type::RGBA_U8:
+                    case Image::Type::RGB_U16:
+                    case Image::Type::RGBA_U16:
+                    {
+                        uint8_t* outData = out->getData();
+                        const size_t scanlineByteCount = out->getScanlineByteCount();
+                        const size_t tileCount = tileList.size();
+                        const size_t threadCount = std::min(getDecodeThreadCount(), tileCount);
+                        std::vector<std::future<bool> > futures;
+                        for (size_t i = 0; i < threadCount; ++i)
+                        {
+                            futures.push_back(std::async(
+                                threadCount > 1 ? std::launch::async : std::launch::deferred,
+                                [&tileList, &imageInfo, outData, scanlineByteCount, tileCount, threadCount, i]
+                                {
+                                    bool out = true;
+                                    for (size_t j = tileCount * i / threadCount; j < tileCount * (i + 1) / threadCount && out; ++j)
+                                    {
+                                        out = readTile(tileList[j], imageInfo.type, outData, scanlineByteCount);
+                                    }
+                                    return out;
+                                }));
+                        }
+                        bool valid = true;
+                        for (auto& i : futures)
+                        {
+                            valid &= i.get();
+                        }
+                        if (!valid)
+                        {
+                            throw FileSystem::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(_textSystem->getText(DJV_TEXT("error_file_not_supported"))));
+                        }
+                        break;
+                    }
+                    default: break;
+                    }
+
                     return out;
                 }
 
@@ -737,12 +651,16 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                Info Read::_open(
+                    const std::string & fileName,
+                    const std::shared_ptr<FileSystem::FileIO>& io,
+                    int& tiles,
+                    bool& compression)
                 {
                     io->setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    _openFile(fileName, io);
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _tiles, _compression, _textSystem);
+                    Header().read(io, imageInfo, tiles, compression, _textSystem);
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
@@ -8,6 +8,7 @@
 #include <djvAV/DPX.h>
 #include <djvAV/GLFWSystem.h>
 #include <djvAV/IFF.h>
+#include <djvAV/ImageUtil.h>
 #include <djvAV/PPM.h>
 #include <djvAV/RLA.h>
 #include <djvAV/SGI.h>
@@ -32,11 +33,15 @@
 #include <djvCore/Context.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Math.h>
 #include <djvCore/Path.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
+#include <djvCore/Timer.h>
+
+#include <thread>
 
 using namespace djv::Core;
 
@@ -46,6 +51,43 @@ namespace djv
     {
         namespace IO
         {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const uint16_t proxyScale = 4;
+
+                Frame::Sequence toSequence(std::vector<Frame::Index>& frames)
+                {
+                    Frame::Sequence out;
+                    const size_t size = frames.size();
+                    if (size)
+                    {
+                        std::sort(frames.begin(), frames.end());
+                        Frame::Number rangeStart = frames[0];
+                        Frame::Number prevFrame = frames[0];
+                        size_t i = 1;
+                        for (; i < size; prevFrame = frames[i], ++i)
+                        {
+                            if (frames[i] != prevFrame + 1)
+                            {
+                                out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
+                                rangeStart = frames[i];
+                            }
+                        }
+                        if (size > 1)
+                        {
+                            out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
+                        }
+                        else
+                        {
+                            out.ranges.push_back(Frame::Range(rangeStart));
+                        }
+                    }
+                    return out;
+                }
+
+            } // namespace
+
             void VideoQueue::setMax(size_t value)
             {
                 _max = value;
@@ -140,37 +182,28 @@ namespace djv
 
             Frame::Sequence Cache::getFrames() const
             {
-                Frame::Sequence out;
                 std::vector<Frame::Index> frames;
                 for (const auto& i : _cache)
                 {
                     frames.push_back(i.first);
                 }
-                const size_t size = frames.size();
-                if (size)
+                return toSequence(frames);
+            }
+
+            const Frame::Sequence& Cache::getSequence() const
+            {
+                if (!_sequenceValid)
                 {
-                    std::sort(frames.begin(), frames.end());
-                    Frame::Number rangeStart = frames[0];
-                    Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
-                    {
-                        if (frames[i] != prevFrame + 1)
-                        {
-                            out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
-                        }
-                    }
-                    if (size > 1)
-                    {
-                        out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
-                    }
-                    else
+                    std::vector<Frame::Index> frames;
+                    frames.reserve(_plan.size());
+                    for (const auto& i : _planPositions)
                     {
-                        out.ranges.push_back(Frame::Range(rangeStart));
+                        frames.push_back(i.first);
                     }
+                    _sequence = toSequence(frames);
+                    _sequenceValid = true;
                 }
-                return out;
+                return _sequence;
             }
 
             void Cache::setMax(size_t value)
@@ -199,9 +232,26 @@ namespace djv
 
             void Cache::setDirection(Direction value)
             {
-                if (value == _direction)
+                if (value == _playhead.direction)
+                    return;
+                _playhead.direction = value;
+                _cacheUpdate();
+            }
+
+            void Cache::setPlayhead(const Playhead& value)
+            {
+                if (value == _playhead)
                     return;
-                _direction = value;
+                _playhead = value;
+                _cacheUpdate();
+            }
+
+            void Cache::setSpeed(const Time::Speed& value)
+            {
+                const float speed = value.toFloat();
+                if (speed == _speed)
+                    return;
+                _speed = speed;
                 _cacheUpdate();
             }
 
@@ -210,102 +260,553 @@ namespace djv
                 if (value == _currentFrame)
                     return;
                 _currentFrame = value;
-                _cacheUpdate();
+                if (!_cacheMove())
+                {
+                    _cacheUpdate();
+                }
             }
 
-            void Cache::add(Frame::Index index, const std::shared_ptr<AV::Image::Image>& image)
+            void Cache::setReadTime(float value)
             {
-                _cache[index] = image;
-                _cacheUpdate();
+                if (value == _readTime)
+                    return;
+                _readTime = value;
+                _readOrderUpdate();
+            }
+
+            float Cache::getTime(Frame::Index value) const
+            {
+                const auto i = _planPositions.find(value);
+                return i != _planPositions.end() ?
+                    (static_cast<float>(i->second - _planPosition) * _planFrameTime) :
+                    -1.F;
+            }
+
+            bool Cache::add(Frame::Index index, const std::shared_ptr<AV::Image::Image>& image)
+            {
+                const bool out = _planPositions.find(index) != _planPositions.end();
+                if (out)
+                {
+                    _cache[index] = VideoFrame(index, image);
+                }
+                return out;
+            }
+
+            bool Cache::add(const VideoFrame& value)
+            {
+                const bool out = _planPositions.find(value.frame) != _planPositions.end();
+                if (out)
+                {
+                    _cache[value.frame] = value;
+                }
+                return out;
             }
 
             void Cache::_cacheUpdate()
             {
+                _plan.clear();
+                _planAhead = 0;
+                _planStep = 1;
+                _planFrameTime = 0.F;
+                _planMovable = false;
+                _planPositions.clear();
+                _planPosition = 0;
+                _sequenceValid = false;
                 const auto range = _inOutPoints.getRange(_sequenceSize);
-                Frame::Index frame = _currentFrame;
-                _sequence = Frame::Sequence();
-                switch (_direction)
+                const Frame::Index rangeSize = range.max - range.min + 1;
+                if (_max > 0 && _sequenceSize > 0 && rangeSize > 0)
                 {
-                case Direction::Forward:
-                {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    const size_t max = std::min(_max, static_cast<size_t>(rangeSize));
+                    const size_t behind = std::min(_readBehind, max / 2);
+
+                    // Find the time between the frames that are shown. When
+                    // frames are skipped to keep up with the playback speed
+                    // only every n-th frame is needed.
+                    const bool playback = _playhead.playback;
+                    const float speed = playback ? std::max(_playhead.speed, .01F) : 1.F;
+                    _planStep = playback && !_playhead.everyFrame ?
+                        std::max(static_cast<Frame::Index>(roundf(speed)), static_cast<Frame::Index>(1)) :
+                        1;
+                    _planFrameTime = static_cast<float>(_planStep) / ((_speed > 0.F ? _speed : 24.F) * speed);
+
+                    // Walk the playhead forward in time.
+                    const Frame::Index start = Math::clamp(_currentFrame, range.min, range.max);
+                    const Frame::Index startDirection = Direction::Forward == _playhead.direction ? 1 : -1;
+                    Frame::Index frame = start;
+                    Frame::Index direction = startDirection;
+                    Frame::Index position = 0;
+                    bool wrapped = false;
+                    _plan.push_back(frame);
+                    _planPositions[frame] = position;
+                    for (Frame::Index i = 0; _plan.size() < max - behind && i < rangeSize * 2; ++i)
                     {
-                        --frame;
-                        if (frame < range.min)
+                        frame += direction * _planStep;
+                        if (frame < range.min || frame > range.max)
+                        {
+                            wrapped = true;
+                            if (_playhead.pingPong)
+                            {
+                                direction = -direction;
+                                frame = Math::clamp(
+                                    frame > range.max ? (range.max * 2 - frame) : (range.min * 2 - frame),
+                                    range.min,
+                                    range.max);
+                            }
+                            else if (_playhead.loop)
+                            {
+                                frame = range.min + ((frame - range.min) % rangeSize + rangeSize) % rangeSize;
+                            }
+                            else
+                            {
+                                break;
+                            }
+                        }
+                        ++position;
+                        if (_planPositions.insert(std::make_pair(frame, position)).second)
                         {
-                            frame = range.max;
+                            _plan.push_back(frame);
                         }
                     }
-                    _sequence.ranges.push_back(Frame::Range(frame));
-                    const Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
+                    _planAhead = _plan.size();
+
+                    // Fill the rest with the frames behind the playhead, these
+                    // have the lowest priority.
+                    frame = start;
+                    for (Frame::Index i = 0; _plan.size() < max && i < rangeSize; ++i)
                     {
-                        ++frame;
-                        if (first == frame)
-                        {
-                            break;
-                        }
-                        if (frame > range.max)
+                        frame -= startDirection;
+                        if (frame < range.min || frame > range.max)
                         {
-                            frame = range.min;
-                            if (frame != _sequence.ranges.back().max)
+                            wrapped = true;
+                            if (!_playhead.loop)
                             {
-                                _sequence.ranges.push_back(Frame::Range(frame));
+                                break;
                             }
+                            frame = frame < range.min ? range.max : range.min;
                         }
-                        else
+                        ++position;
+                        if (_planPositions.insert(std::make_pair(frame, position)).second)
                         {
-                            _sequence.ranges.back().max = frame;
+                            _plan.push_back(frame);
                         }
                     }
-                    break;
+
+                    _planMovable = !wrapped && max - behind == _planAhead && max == _plan.size();
                 }
-                case Direction::Reverse:
+
+                // Evict the frames that are not planned, these are the frames
+                // needed furthest in the future.
+                auto i = _cache.begin();
+                while (i != _cache.end())
                 {
-                    for (size_t i = 0; i < _readBehind; ++i)
+                    if (_planPositions.find(i->first) == _planPositions.end())
                     {
-                        ++frame;
-                        if (frame > range.max)
-                        {
-                            frame = range.min;
-                        }
+                        i = _cache.erase(i);
                     }
-                    _sequence.ranges.push_back(Frame::Range(frame));
-                    const Frame::Index first = frame;
-                    for (size_t i = 0; i < _max; ++i)
+                    else
                     {
-                        --frame;
-                        if (first == frame)
-                        {
-                            break;
-                        }
-                        if (frame < range.min)
+                        ++i;
+                    }
+                }
+
+                _readOrderUpdate();
+            }
+
+            bool Cache::_cacheMove()
+            {
+                // When the playhead moves forward inside of the range the plan
+                // is moved instead of rebuilt; frames are added to the front of
+                // the read-ahead window, the read-behind window follows the
+                // playhead, and only the frames that leave are evicted.
+                if (!_planMovable)
+                {
+                    return false;
+                }
+                const auto range = _inOutPoints.getRange(_sequenceSize);
+                const Frame::Index direction = Direction::Forward == _playhead.direction ? 1 : -1;
+                const Frame::Index offset = (_currentFrame - _plan[0]) * direction;
+                if (offset <= 0 || offset % _planStep != 0)
+                {
+                    return false;
+                }
+                const size_t count = static_cast<size_t>(offset / _planStep);
+                const size_t behind = _plan.size() - _planAhead;
+                if (count >= _planAhead)
+                {
+                    return false;
+                }
+                const Frame::Index aheadEnd = _plan[_planAhead - 1] + direction * _planStep * static_cast<Frame::Index>(count);
+                const Frame::Index behindEnd = _currentFrame - direction * static_cast<Frame::Index>(behind);
+                if (aheadEnd < range.min || aheadEnd > range.max ||
+                    behindEnd < range.min || behindEnd > range.max)
+                {
+                    return false;
+                }
+
+                // Remove the frames that leave the read-ahead window and the
+                // previous read-behind window.
+                for (size_t i = 0; i < count; ++i)
+                {
+                    _planPositions.erase(_plan[i]);
+                }
+                for (size_t i = _planAhead; i < _plan.size(); ++i)
+                {
+                    _planPositions.erase(_plan[i]);
+                }
+
+                // Add the frames that enter the read-ahead window, followed by
+                // the new read-behind window.
+                Frame::Index position = _planPosition + static_cast<Frame::Index>(_planAhead) - 1;
+                _planPosition += static_cast<Frame::Index>(count);
+                Frame::Index frame = _plan[_planAhead - 1];
+                for (size_t i = 0; i < count; ++i)
+                {
+                    frame += direction * _planStep;
+                    _planPositions[frame] = ++position;
+                }
+                frame = _currentFrame;
+                for (size_t i = 0; i < behind; ++i)
+                {
+                    frame -= direction;
+                    _planPositions[frame] = ++position;
+                }
+
+                // Evict the frames that are no longer planned.
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (_planPositions.find(_plan[i]) == _planPositions.end())
+                    {
+                        _cache.erase(_plan[i]);
+                    }
+                }
+                for (size_t i = _planAhead; i < _plan.size(); ++i)
+                {
+                    if (_planPositions.find(_plan[i]) == _planPositions.end())
+                    {
+                        _cache.erase(_plan[i]);
+                    }
+                }
+
+                _plan.erase(_plan.begin(), _plan.begin() + count);
+                _plan.resize(_planAhead - count);
+                frame = _plan.back();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    frame += direction * _planStep;
+                    _plan.push_back(frame);
+                }
+                frame = _currentFrame;
+                for (size_t i = 0; i < behind; ++i)
+                {
+                    frame -= direction;
+                    _plan.push_back(frame);
+                }
+
+                _sequenceValid = false;
+                _readOrderUpdate();
+                return true;
+            }
+
+            void Cache::_readOrderUpdate()
+            {
+                _readOrder.clear();
+                if (_playhead.playback && !_playhead.everyFrame && _readTime > 0.F)
+                {
+                    // Frames that cannot be read before they are needed will
+                    // be skipped, so read them last.
+                    std::vector<Frame::Index> late;
+                    float readTime = 0.F;
+                    for (const auto i : _plan)
+                    {
+                        if (!contains(i))
                         {
-                            frame = range.max;
-                            if (frame != _sequence.ranges.back().min)
+                            if (readTime + _readTime > getTime(i))
                             {
-                                _sequence.ranges.push_back(Frame::Range(frame));
+                                late.push_back(i);
+                                continue;
                             }
+                            readTime += _readTime;
                         }
-                        else
-                        {
-                            _sequence.ranges.back().min = frame;
-                        }
+                        _readOrder.push_back(i);
                     }
-                    break;
+                    _readOrder.insert(_readOrder.end(), late.begin(), late.end());
+                }
+                else
+                {
+                    _readOrder = _plan;
                 }
-                default: break;
+            }
+
+            Frame::Sequence ProxyCache::getFrames() const
+            {
+                std::vector<Frame::Index> frames;
+                for (const auto& i : _cache)
+                {
+                    frames.push_back(i.first);
+                }
+                return toSequence(frames);
+            }
+
+            bool ProxyCache::add(Frame::Index index, const std::shared_ptr<AV::Image::Image>& image)
+            {
+                bool out = false;
+                const size_t byteCount = image ? image->getDataByteCount() : 0;
+                if (image && byteCount <= _maxByteCount)
+                {
+                    const auto i = _cache.find(index);
+                    if (i != _cache.end())
+                    {
+                        _byteCount -= i->second->getDataByteCount();
+                        _cache.erase(i);
+                        _timestamps.erase(index);
+                    }
+                    while (_byteCount + byteCount > _maxByteCount && _cache.size())
+                    {
+                        _evict();
+                    }
+                    _cache[index] = image;
+                    _timestamps[index] = ++_timestamp;
+                    _byteCount += byteCount;
+                    out = true;
                 }
+                return out;
+            }
+
+            void ProxyCache::crop(const Range::Range<Frame::Index>& range)
+            {
                 auto i = _cache.begin();
                 while (i != _cache.end())
                 {
-                    auto j = i;
-                    ++i;
-                    if (!_sequence.contains(j->first))
+                    if (i->first < range.min || i->first > range.max)
+                    {
+                        _byteCount -= i->second->getDataByteCount();
+                        _timestamps.erase(i->first);
+                        i = _cache.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+
+            float ProxyCache::getScale()
+            {
+                return 1.F / static_cast<float>(proxyScale);
+            }
+
+            AV::Image::Info ProxyCache::getInfo(const AV::Image::Info& value)
+            {
+                AV::Image::Info out(
+                    std::max(static_cast<uint16_t>(value.size.w / proxyScale), static_cast<uint16_t>(1)),
+                    std::max(static_cast<uint16_t>(value.size.h / proxyScale), static_cast<uint16_t>(1)),
+                    AV::Image::getIntType(AV::Image::getChannelCount(value.type), 8));
+                out.pixelAspectRatio = value.pixelAspectRatio;
+                return out;
+            }
+
+            std::shared_ptr<AV::Image::Image> ProxyCache::create(const AV::Image::Image& value)
+            {
+                auto out = AV::Image::Image::create(getInfo(value.getInfo()));
+                AV::Image::resize(value, *out);
+                out->setPluginName(value.getPluginName());
+                return out;
+            }
+
+            std::vector<Frame::Index> ProxyCache::getOrder(const Range::Range<Frame::Index>& range)
+            {
+                std::vector<Frame::Index> out;
+                if (range.max >= range.min)
+                {
+                    const size_t size = static_cast<size_t>(range.max - range.min) + 1;
+                    out.reserve(size);
+                    size_t stride = 1;
+                    while (stride * 2 < size)
+                    {
+                        stride *= 2;
+                    }
+                    for (size_t i = 0; i < size; i += stride)
                     {
-                        _cache.erase(j);
+                        out.push_back(range.min + static_cast<Frame::Index>(i));
+                    }
+                    for (; stride > 1; stride /= 2)
+                    {
+                        for (size_t i = stride / 2; i < size; i += stride)
+                        {
+                            out.push_back(range.min + static_cast<Frame::Index>(i));
+                        }
                     }
                 }
+                return out;
+            }
+
+            void ProxyCache::_evict()
+            {
+                auto oldest = _timestamps.begin();
+                for (auto i = _timestamps.begin(); i != _timestamps.end(); ++i)
+                {
+                    if (i->second < oldest->second)
+                    {
+                        oldest = i;
+                    }
+                }
+                if (oldest != _timestamps.end())
+                {
+                    const auto i = _cache.find(oldest->first);
+                    if (i != _cache.end())
+                    {
+                        _byteCount -= i->second->getDataByteCount();
+                        _cache.erase(i);
+                    }
+                    _timestamps.erase(oldest);
+                }
+            }
+
+            ThreadSplit::ThreadSplit()
+            {}
+
+            ThreadSplit::ThreadSplit(size_t frameThreads, size_t decodeThreads) :
+                frameThreads(frameThreads),
+                decodeThreads(decodeThreads)
+            {}
+
+            bool ThreadSplit::operator == (const ThreadSplit& other) const
+            {
+                return
+                    frameThreads == other.frameThreads &&
+                    decodeThreads == other.decodeThreads &&
+                    throughput == other.throughput;
+            }
+
+            bool ThreadSplit::operator != (const ThreadSplit& other) const
+            {
+                return !(*this == other);
+            }
+
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t balanceSampleFrames = 8;
+                const float balanceDropThreshold = .75F;
+
+            } // namespace
+
+            ThreadBalancer::ThreadBalancer()
+            {
+                setThreadCount(1, false, false);
+            }
+
+            size_t ThreadBalancer::getThreadCount() const
+            {
+                return _threadCount;
+            }
+
+            const ThreadSplit& ThreadBalancer::getSplit() const
+            {
+                return _splits[_index];
+            }
+
+            const std::vector<ThreadSplit>& ThreadBalancer::getSplits() const
+            {
+                return _splits;
+            }
+
+            bool ThreadBalancer::isSettled() const
+            {
+                return 0 == _step;
+            }
+
+            void ThreadBalancer::setThreadCount(size_t value, bool frameThreads, bool decodeThreads)
+            {
+                _threadCount = std::max(value, static_cast<size_t>(1));
+                _splits.clear();
+                if (frameThreads && decodeThreads)
+                {
+                    for (size_t i = 1; i < _threadCount; i *= 2)
+                    {
+                        _splits.push_back(ThreadSplit(i, _threadCount / i));
+                    }
+                    _splits.push_back(ThreadSplit(_threadCount, 1));
+                }
+                else if (frameThreads)
+                {
+                    _splits.push_back(ThreadSplit(_threadCount, 1));
+                }
+                else if (decodeThreads)
+                {
+                    _splits.push_back(ThreadSplit(1, _threadCount));
+                }
+                else
+                {
+                    _splits.push_back(ThreadSplit(1, 1));
+                }
+                _index = _splits.size() / 2;
+                _step = _splits.size() > 1 ? 1 : 0;
+                _pending = DecodeStats();
+            }
+
+            bool ThreadBalancer::addSample(const DecodeStats& value)
+            {
+                _pending.frames += value.frames;
+                _pending.seconds += value.seconds;
+                const size_t frameThreads = _splits[_index].frameThreads;
+                if (_pending.frames < std::max(balanceSampleFrames, frameThreads * 2) || _pending.seconds <= 0.F)
+                    return false;
+
+                // The frames are decoded concurrently so the throughput is scaled
+                // by the number of frame threads.
+                const float throughput = frameThreads * _pending.frames / _pending.seconds;
+                _pending = DecodeStats();
+                if (0 == _step)
+                {
+                    const float prev = _splits[_index].throughput;
+                    _splits[_index].throughput = throughput;
+                    if (_splits.size() < 2 || throughput >= prev * balanceDropThreshold)
+                        return false;
+
+                    // The throughput dropped so measure the other splits again.
+                    for (size_t i = 0; i < _splits.size(); ++i)
+                    {
+                        if (i != _index)
+                        {
+                            _splits[i].throughput = 0.F;
+                        }
+                    }
+                    _step = 1;
+                }
+                else
+                {
+                    _splits[_index].throughput = throughput;
+                }
+
+                // Continue in the same direction while the throughput improves,
+                // then try the other direction, then settle on the best split.
+                size_t best = 0;
+                for (size_t i = 1; i < _splits.size(); ++i)
+                {
+                    if (_splits[i].throughput > _splits[best].throughput)
+                    {
+                        best = i;
+                    }
+                }
+                const size_t prevIndex = _index;
+                auto tryStep = [this, best](int step)
+                {
+                    const int next = static_cast<int>(best) + step;
+                    if (next >= 0 && next < static_cast<int>(_splits.size()) && 0.F == _splits[next].throughput)
+                    {
+                        _index = static_cast<size_t>(next);
+                        _step = step;
+                        return true;
+                    }
+                    return false;
+                };
+                if (!((_index == best && tryStep(_step)) || tryStep(1) || tryStep(-1)))
+                {
+                    _index = best;
+                    _step = 0;
+                }
+                return _index != prevIndex;
             }
 
             void IRead::_init(
@@ -317,6 +818,7 @@ namespace djv
             {
                 IIO::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _options = options;
+                _decodeThreadCount = std::max(options.decodeThreadCount, static_cast<size_t>(1));
             }
 
             IRead::~IRead()
@@ -339,6 +841,24 @@ namespace djv
                 std::lock_guard<std::mutex> lock(_mutex);
                 _inOutPoints = value;
             }
+
+            void IRead::setPlaybackSpeed(float value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _playbackSpeed = value;
+            }
+
+            void IRead::setPlayEveryFrame(bool value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _playEveryFrame = value;
+            }
+
+            void IRead::setPingPong(bool value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _pingPong = value;
+            }
             
             bool IRead::isCacheEnabled() const
             {
@@ -380,6 +900,64 @@ namespace djv
                 _cacheMaxByteCount = value;
             }
 
+            bool IRead::isProxyEnabled() const
+            {
+                return _proxyEnabled;
+            }
+
+            size_t IRead::getProxyMaxByteCount() const
+            {
+                return _proxyMaxByteCount;
+            }
+
+            Frame::Sequence IRead::getProxyFrames()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _proxyCache.getFrames();
+            }
+
+            bool IRead::getProxy(Frame::Index index, std::shared_ptr<AV::Image::Image>& out)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _proxyCache.get(index, out);
+            }
+
+            void IRead::setProxyEnabled(bool value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _proxyEnabled = value;
+            }
+
+            void IRead::setProxyMaxByteCount(size_t value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _proxyMaxByteCount = value;
+            }
+
+            FileSystem::ReadAheadStats IRead::getReadAheadStats()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _readAheadStats;
+            }
+
+            DecodeStats IRead::getDecodeStats()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _decodeStats;
+            }
+
+            size_t IRead::getDecodeThreadCount()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _decodeThreadCount;
+            }
+
+            void IRead::setDecodeThreadCount(size_t value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _decodeThreadCount = std::max(value, static_cast<size_t>(1));
+            }
+
             void IWrite::_init(
                 const FileSystem::FileInfo& fileInfo,
                 const Info & info,
@@ -449,6 +1027,16 @@ namespace djv
                 // Default implementation does nothing.
             }
 
+            bool IPlugin::hasDecodeThreads() const
+            {
+                return false;
+            }
+
+            void IPlugin::setDecodeThreadCount(size_t)
+            {
+                // Default implementation does nothing.
+            }
+
             std::shared_ptr<IRead> IPlugin::read(const FileSystem::FileInfo&, const ReadOptions&) const
             {
                 return nullptr;
@@ -465,6 +1053,20 @@ namespace djv
                 std::shared_ptr<ValueSubject<bool> > optionsChanged;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
+
+                struct Reader
+                {
+                    std::string pluginName;
+                    std::weak_ptr<IRead> read;
+                    bool decodeThreadsFixed = false;
+                    DecodeStats decodeStats;
+                };
+                std::mutex mutex;
+                size_t threadCount = 4;
+                std::map<std::string, ThreadBalancer> balancers;
+                std::vector<Reader> readers;
+                std::shared_ptr<MapSubject<std::string, ThreadSplit> > threadSplits;
+                std::shared_ptr<Time::Timer> balanceTimer;
             };
 
             void System::_init(const std::shared_ptr<Context>& context)
@@ -473,7 +1075,10 @@ namespace djv
 
                 DJV_PRIVATE_PTR();
 
-                addDependency(context->getSystemT<GLFW::System>());
+                if (auto glfwSystem = context->getSystemT<GLFW::System>())
+                {
+                    addDependency(glfwSystem);
+                }
 
                 p.textSystem = context->getSystemT<TextSystem>();
 
@@ -516,6 +1121,31 @@ namespace djv
                     ss << "    File extensions: " << String::joinSet(i.second->getFileExtensions(), ", ") << '\n';
                     _log(ss.str());
                 }
+
+                const size_t hardwareThreads = std::thread::hardware_concurrency();
+                if (hardwareThreads > 0)
+                {
+                    p.threadCount = hardwareThreads;
+                }
+                p.threadSplits = MapSubject<std::string, ThreadSplit>::create();
+                for (const auto& i : p.plugins)
+                {
+                    p.balancers[i.first].setThreadCount(p.threadCount, i.second->canSequence(), i.second->hasDecodeThreads());
+                    _splitUpdate(i.first);
+                }
+
+                auto weak = std::weak_ptr<System>(std::dynamic_pointer_cast<System>(shared_from_this()));
+                p.balanceTimer = Time::Timer::create(context);
+                p.balanceTimer->setRepeating(true);
+                p.balanceTimer->start(
+                    Time::getTime(Time::TimerValue::Slow),
+                    [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            system->_balanceUpdate();
+                        }
+                    });
             }
 
             System::System() :
@@ -529,6 +1159,7 @@ namespace djv
             {
                 auto out = std::shared_ptr<System>(new System);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
 
@@ -582,6 +1213,32 @@ namespace djv
                 return _p->optionsChanged;
             }
 
+            size_t System::getThreadCount() const
+            {
+                return _p->threadCount;
+            }
+
+            void System::setThreadCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                if (value == p.threadCount)
+                    return;
+                p.threadCount = value;
+                for (const auto& i : p.plugins)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        p.balancers[i.first].setThreadCount(value, i.second->canSequence(), i.second->hasDecodeThreads());
+                    }
+                    _splitUpdate(i.first);
+                }
+            }
+
+            std::shared_ptr<IMapSubject<std::string, ThreadSplit> > System::observeThreadSplits() const
+            {
+                return _p->threadSplits;
+            }
+
             const std::set<std::string>& System::getSequenceExtensions() const
             {
                 return _p->sequenceExtensions;
@@ -630,7 +1287,29 @@ namespace djv
                 {
                     if (i.second->canRead(fileInfo))
                     {
-                        out = i.second->read(fileInfo, options);
+                        // Set the decode threads in the options so they are used
+                        // from the start of the read.
+                        ReadOptions readOptions = options;
+                        ThreadSplit split;
+                        {
+                            std::lock_guard<std::mutex> lock(p.mutex);
+                            split = p.balancers[i.first].getSplit();
+                        }
+                        if (0 == readOptions.decodeThreadCount)
+                        {
+                            readOptions.decodeThreadCount = split.decodeThreads;
+                        }
+                        out = i.second->read(fileInfo, readOptions);
+                        if (out)
+                        {
+                            out->setThreadCount(split.frameThreads);
+                            Private::Reader reader;
+                            reader.pluginName = i.first;
+                            reader.read = out;
+                            reader.decodeThreadsFixed = options.decodeThreadCount > 0;
+                            std::lock_guard<std::mutex> lock(p.mutex);
+                            p.readers.push_back(reader);
+                        }
                         break;
                     }
                 }
@@ -664,6 +1343,106 @@ namespace djv
                 return out;
             }
 
+            void System::_balanceUpdate()
+            {
+                DJV_PRIVATE_PTR();
+
+                // Collect the decoding statistics of the readers since the last
+                // update.
+                std::map<std::string, DecodeStats> decodeStats;
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    auto i = p.readers.begin();
+                    while (i != p.readers.end())
+                    {
+                        if (auto read = i->read.lock())
+                        {
+                            const DecodeStats stats = read->getDecodeStats();
+                            auto& pluginStats = decodeStats[i->pluginName];
+                            pluginStats.frames += stats.frames - i->decodeStats.frames;
+                            pluginStats.seconds += stats.seconds - i->decodeStats.seconds;
+                            i->decodeStats = stats;
+                            ++i;
+                        }
+                        else
+                        {
+                            i = p.readers.erase(i);
+                        }
+                    }
+                }
+
+                // Update the thread splits.
+                for (const auto& i : decodeStats)
+                {
+                    if (i.second.frames > 0)
+                    {
+                        ThreadSplit prev;
+                        ThreadSplit split;
+                        bool changed = false;
+                        {
+                            std::lock_guard<std::mutex> lock(p.mutex);
+                            auto& balancer = p.balancers[i.first];
+                            prev = balancer.getSplit();
+                            changed = balancer.addSample(i.second);
+                            split = balancer.getSplit();
+                        }
+                        if (changed)
+                        {
+                            _splitUpdate(i.first);
+                            std::stringstream ss;
+                            ss << i.first << " thread split: " << prev.frameThreads << "x" << prev.decodeThreads <<
+                                " -> " << split.frameThreads << "x" << split.decodeThreads;
+                            _log(ss.str());
+                        }
+                        else if (p.threadSplits->hasKey(i.first))
+                        {
+                            p.threadSplits->setItemOnlyIfChanged(i.first, split);
+                        }
+                    }
+                }
+            }
+
+            void System::_splitUpdate(const std::string& pluginName)
+            {
+                DJV_PRIVATE_PTR();
+                const auto i = p.plugins.find(pluginName);
+                if (i != p.plugins.end())
+                {
+                    ThreadSplit split;
+                    size_t splitCount = 0;
+                    std::vector<std::pair<std::shared_ptr<IRead>, bool> > reads;
+                    {
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        const auto& balancer = p.balancers[pluginName];
+                        split = balancer.getSplit();
+                        splitCount = balancer.getSplits().size();
+                        for (const auto& j : p.readers)
+                        {
+                            if (j.pluginName == pluginName)
+                            {
+                                if (auto read = j.read.lock())
+                                {
+                                    reads.push_back(std::make_pair(read, j.decodeThreadsFixed));
+                                }
+                            }
+                        }
+                    }
+                    i->second->setDecodeThreadCount(split.decodeThreads);
+                    for (const auto& read : reads)
+                    {
+                        read.first->setThreadCount(split.frameThreads);
+                        if (!read.second)
+                        {
+                            read.first->setDecodeThreadCount(split.decodeThreads);
+                        }
+                    }
+                    if (splitCount > 1)
+                    {
+                        p.threadSplits->setItemOnlyIfChanged(pluginName, split);
+                    }
+                }
+            }
+
         } // namespace IO
     } // namespace AV
 } // namespace djv
@@ -8,10 +8,13 @@
 #include <djvAV/Image.h>
 #include <djvAV/Tags.h>
 
+#include <djvCore/BBox.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/ISystem.h>
+#include <djvCore/MapObserver.h>
 #include <djvCore/PicoJSON.h>
+#include <djvCore/ReadAhead.h>
 #include <djvCore/Speed.h>
 #include <djvCore/Time.h>
 #include <djvCore/ValueObserver.h>
@@ -90,11 +93,18 @@ namespace djv
             {
             public:
                 VideoFrame();
-                VideoFrame(Core::Frame::Number, const std::shared_ptr<Image::Image>&);
+                VideoFrame(
+                    Core::Frame::Number,
+                    const std::shared_ptr<Image::Image>&,
+                    const std::vector<std::shared_ptr<Image::Image> >& layers = std::vector<std::shared_ptr<Image::Image> >());
 
                 Core::Frame::Number           frame = 0;
                 std::shared_ptr<Image::Image> image;
 
+                //! The images for all of the layers, indexed by layer, when they
+                //! were read in a single pass (see ReadOptions::allLayers).
+                std::vector<std::shared_ptr<Image::Image> > layers;
+
                 bool operator == (const VideoFrame&) const;
             };
 
@@ -212,6 +222,31 @@ namespace djv
             {
                 size_t layer = 0;
                 std::string colorSpace;
+
+                //! The region of interest in image pixel coordinates. Readers that
+                //! support it only decode the data intersecting the region and may
+                //! leave the rest of the image black. An empty region reads the
+                //! whole image.
+                Core::BBox2i roi = Core::BBox2i(0, 0, 0, 0);
+
+                //! The scale the images will be displayed at. Readers that support
+                //! multi-resolution files (for example tiled and mipmapped OpenEXR
+                //! files) read the smallest level that is at least this size, so the
+                //! images may be smaller than the video information.
+                float scale = 1.F;
+
+                //! Read all of the layers in a single pass. The images are available
+                //! in VideoFrame::layers so switching layers does not require
+                //! reading the files again.
+                bool allLayers = false;
+
+                //! Compute the image statistics on the decode threads after the
+                //! images are read (see Image::getStats()).
+                bool stats = false;
+
+                //! The number of threads used to decode each frame. Zero uses
+                //! the thread split from the I/O system.
+                size_t decodeThreadCount = 0;
             };
 
             //! This class provides playback in/out points.
@@ -242,7 +277,37 @@ namespace djv
                 Reverse
             };
 
+            //! This class provides the playback state used to plan which frames
+            //! are read into the cache.
+            class Playhead
+            {
+            public:
+                Playhead();
+
+                Direction direction  = Direction::Forward;
+                bool      playback   = false;
+                float     speed      = 1.F;   //!< Playback speed relative to the file speed
+                bool      everyFrame = true;  //!< Whether every frame is shown or frames are skipped to keep up
+                bool      loop       = true;
+                bool      pingPong   = false;
+
+                bool operator == (const Playhead&) const;
+                bool operator != (const Playhead&) const;
+            };
+
             //! This class provides a frame cache.
+            //!
+            //! The frames that are kept are planned by walking the playhead
+            //! forward in time, taking the speed, frame skipping, loop, and
+            //! ping-pong into account. Each frame is ranked by the time until
+            //! it is needed and the frames needed furthest in the future are
+            //! evicted first. A few frames behind the playhead are also kept
+            //! with the lowest priority for stepping backwards.
+            //!
+            //! The plan is rebuilt when one of the inputs changes, including
+            //! the current frame, so it is walked once for each frame that is
+            //! shown. The walk is bounded by the maximum number of frames.
+            //! Adding a frame does not walk the plan.
             class Cache
             {
             public:
@@ -254,29 +319,181 @@ namespace djv
                 Core::Frame::Sequence getFrames() const;
                 size_t getReadBehind() const;
                 const Core::Frame::Sequence& getSequence() const;
+                const Playhead& getPlayhead() const;
                 void setMax(size_t);
                 void setSequenceSize(size_t);
                 void setInOutPoints(const InOutPoints&);
                 void setDirection(Direction);
+                void setPlayhead(const Playhead&);
+                void setSpeed(const Core::Time::Speed&);
                 void setCurrentFrame(Core::Frame::Index);
 
+                //! Set the measured time to read a frame, divided by the number
+                //! of threads reading frames.
+                void setReadTime(float);
+
+                //! Get the frames that should be cached in the order they
+                //! should be read. When frames are skipped to keep up with the
+                //! playback speed, the frames that cannot be read before they
+                //! are needed are moved to the end.
+                const std::vector<Core::Frame::Index>& getReadOrder() const;
+
+                //! Get the time in seconds until a frame is needed, or a
+                //! negative value if the frame is not planned.
+                float getTime(Core::Frame::Index) const;
+
                 bool contains(Core::Frame::Index) const;
                 bool get(Core::Frame::Index, std::shared_ptr<AV::Image::Image>&) const;
-                void add(Core::Frame::Index, const std::shared_ptr<AV::Image::Image>&);
+                bool get(Core::Frame::Index, VideoFrame&) const;
+
+                //! Add a frame to the cache. Frames that are not planned, for
+                //! example because the playhead moved while the frame was being
+                //! read, are not added and false is returned.
+                bool add(Core::Frame::Index, const std::shared_ptr<AV::Image::Image>&);
+                bool add(const VideoFrame&);
                 void clear();
 
             private:
                 void _cacheUpdate();
+                bool _cacheMove();
+                void _readOrderUpdate();
 
                 size_t _max = 0;
                 size_t _sequenceSize = 0;
                 InOutPoints _inOutPoints;
-                Direction _direction = Direction::Forward;
+                Playhead _playhead;
+                float _speed = 24.F;
+                float _readTime = 0.F;
                 Core::Frame::Index _currentFrame = 0;
                 //! \todo Should this be configurable?
                 size_t _readBehind = 10;
-                Core::Frame::Sequence _sequence;
+                //! The planned frames, the frames ahead of the playhead are
+                //! followed by the frames behind it.
+                std::vector<Core::Frame::Index> _plan;
+                size_t _planAhead = 0;
+                Core::Frame::Index _planStep = 1;
+                float _planFrameTime = 0.F;
+                //! Whether the plan is a window that can be moved with the
+                //! playhead, without wrapping around the ends of the range.
+                bool _planMovable = false;
+                //! The position of each planned frame in the playhead model;
+                //! the time until a frame is needed is its position minus the
+                //! current position times the frame time.
+                std::map<Core::Frame::Index, Core::Frame::Index> _planPositions;
+                Core::Frame::Index _planPosition = 0;
+                std::vector<Core::Frame::Index> _readOrder;
+                mutable bool _sequenceValid = false;
+                mutable Core::Frame::Sequence _sequence;
+                std::map<Core::Frame::Index, VideoFrame> _cache;
+            };
+
+            //! This class provides a cache of reduced size proxy images that
+            //! can be displayed while scrubbing, before the full resolution
+            //! frames are read. When the memory budget is reached the least
+            //! recently used proxy images are evicted.
+            class ProxyCache
+            {
+            public:
+                ProxyCache();
+
+                size_t getMaxByteCount() const;
+                size_t getByteCount() const;
+                size_t getCount() const;
+                Core::Frame::Sequence getFrames() const;
+                void setMaxByteCount(size_t);
+
+                //! Get whether the memory budget has been reached.
+                bool isFull() const;
+
+                bool contains(Core::Frame::Index) const;
+                bool get(Core::Frame::Index, std::shared_ptr<AV::Image::Image>&) const;
+
+                //! Add a proxy image, evicting the least recently used proxy
+                //! images to make room. Returns false if the image is larger
+                //! than the memory budget.
+                bool add(Core::Frame::Index, const std::shared_ptr<AV::Image::Image>&);
+
+                //! Remove the proxy images outside of the given range.
+                void crop(const Core::Range::Range<Core::Frame::Index>&);
+
+                void clear();
+
+                //! Get the scale of the proxy images.
+                static float getScale();
+
+                //! Get the proxy image information for an image.
+                static AV::Image::Info getInfo(const AV::Image::Info&);
+
+                //! Create a proxy image.
+                static std::shared_ptr<AV::Image::Image> create(const AV::Image::Image&);
+
+                //! Get the order that proxy images are read in. The frames are
+                //! spread out over the range first and then filled in, so the
+                //! whole range is covered quickly.
+                static std::vector<Core::Frame::Index> getOrder(const Core::Range::Range<Core::Frame::Index>&);
+
+            private:
+                void _evict();
+
+                size_t _maxByteCount = 0;
+                size_t _byteCount = 0;
                 std::map<Core::Frame::Index, std::shared_ptr<AV::Image::Image> > _cache;
+                mutable uint64_t _timestamp = 0;
+                mutable std::map<Core::Frame::Index, uint64_t> _timestamps;
+            };
+
+            //! This struct provides how threads are split between reading frames
+            //! concurrently and decoding each frame with multiple threads.
+            struct ThreadSplit
+            {
+                ThreadSplit();
+                ThreadSplit(size_t frameThreads, size_t decodeThreads);
+
+                size_t frameThreads  = 1;
+                size_t decodeThreads = 1;
+                float  throughput    = 0.F; //!< Measured frames per second, zero if unknown
+
+                bool operator == (const ThreadSplit&) const;
+                bool operator != (const ThreadSplit&) const;
+            };
+
+            //! This struct provides decoding statistics.
+            struct DecodeStats
+            {
+                size_t frames  = 0;
+                float  seconds = 0.F; //!< Total time spent decoding the frames
+            };
+
+            //! This class balances a number of threads between reading frames
+            //! concurrently and decoding each frame with multiple threads. The
+            //! throughput of neighboring splits is measured and the fastest one
+            //! is kept until the throughput drops, for example when a different
+            //! kind of file is read.
+            class ThreadBalancer
+            {
+            public:
+                ThreadBalancer();
+
+                size_t getThreadCount() const;
+                const ThreadSplit& getSplit() const;
+                const std::vector<ThreadSplit>& getSplits() const;
+                bool isSettled() const;
+
+                //! Set the number of threads and whether frames can be read
+                //! concurrently or decoded with multiple threads. This resets the
+                //! measurements.
+                void setThreadCount(size_t, bool frameThreads, bool decodeThreads);
+
+                //! Add statistics measured with the current split. Returns true if
+                //! the split changed.
+                bool addSample(const DecodeStats&);
+
+            private:
+                size_t _threadCount = 0;
+                std::vector<ThreadSplit> _splits;
+                size_t _index = 0;
+                int _step = 0;
+                DecodeStats _pending;
             };
 
             //! This class provides an interface for reading.
@@ -299,6 +516,17 @@ namespace djv
                 void setLoop(bool);
                 void setInOutPoints(const InOutPoints&);
 
+                //! \name Playhead
+                //! These values are used to plan which frames are cached.
+                ///@{
+
+                //! Set the playback speed relative to the file speed.
+                void setPlaybackSpeed(float);
+                void setPlayEveryFrame(bool);
+                void setPingPong(bool);
+
+                ///@}
+
                 //! \param value For video files this value represents the
                 //! frame number, for audio files it represents the audio sample.
                 virtual void seek(int64_t value, Direction) = 0;
@@ -312,18 +540,59 @@ namespace djv
                 void setCacheEnabled(bool);
                 void setCacheMaxByteCount(size_t);
 
+                //! \name Proxies
+                //! Readers that have a cache also read reduced size proxy
+                //! images in the background when playback is stopped.
+                ///@{
+
+                bool isProxyEnabled() const;
+                size_t getProxyMaxByteCount() const;
+                Core::Frame::Sequence getProxyFrames();
+                bool getProxy(Core::Frame::Index, std::shared_ptr<AV::Image::Image>&);
+                void setProxyEnabled(bool);
+                void setProxyMaxByteCount(size_t);
+
+                ///@}
+
+                //! Get the read-ahead statistics.
+                Core::FileSystem::ReadAheadStats getReadAheadStats();
+
+                //! Get the decoding statistics.
+                DecodeStats getDecodeStats();
+
+                //! \name Decoding Threads
+                //! Readers that support it split the decoding of a frame
+                //! between this number of threads. The value is set by the I/O
+                //! system for the plugins that have decode threads, unless it
+                //! was given in the read options.
+                ///@{
+
+                size_t getDecodeThreadCount();
+                void setDecodeThreadCount(size_t);
+
+                ///@}
+
             protected:
                 ReadOptions _options;
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
                 bool _playback = false;
                 bool _loop = false;
+                float _playbackSpeed = 1.F;
+                bool _playEveryFrame = true;
+                bool _pingPong = false;
                 bool _cacheEnabled = false;
                 size_t _cacheMaxByteCount = 0;
                 size_t _cacheByteCount = 0;
                 Core::Frame::Sequence _cacheSequence;
                 Core::Frame::Sequence _cachedFrames;
                 Cache _cache;
+                bool _proxyEnabled = false;
+                size_t _proxyMaxByteCount = 0;
+                ProxyCache _proxyCache;
+                Core::FileSystem::ReadAheadStats _readAheadStats;
+                DecodeStats _decodeStats;
+                size_t _decodeThreadCount = 1;
             };
 
             //! This class provides options for writing.
@@ -379,6 +648,12 @@ namespace djv
                 //! - std::invalid_argument
                 virtual void setOptions(const picojson::value &);
 
+                //! Get whether the plugin can decode a frame with multiple threads.
+                virtual bool hasDecodeThreads() const;
+
+                //! Set the number of threads used to decode a frame.
+                virtual void setDecodeThreadCount(size_t);
+
                 //! Throws:
                 //! - Core::FileSystem::Error
                 virtual std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const;
@@ -422,6 +697,18 @@ namespace djv
 
                 std::shared_ptr<Core::IValueSubject<bool> > observeOptionsChanged() const;
 
+                //! Get the total number of threads used for reading.
+                size_t getThreadCount() const;
+
+                //! Set the total number of threads used for reading. The threads
+                //! are split between reading frames concurrently and decoding each
+                //! frame for the plugins that support both.
+                void setThreadCount(size_t);
+
+                //! Observe the thread splits of the plugins that can decode frames
+                //! with multiple threads.
+                std::shared_ptr<Core::IMapSubject<std::string, ThreadSplit> > observeThreadSplits() const;
+
                 const std::set<std::string>& getSequenceExtensions() const;
                 bool canSequence(const Core::FileSystem::FileInfo&) const;
                 bool canRead(const Core::FileSystem::FileInfo&) const;
@@ -436,6 +723,9 @@ namespace djv
                 std::shared_ptr<IWrite> write(const Core::FileSystem::FileInfo&, const Info &, const WriteOptions& = WriteOptions());
 
             private:
+                void _balanceUpdate();
+                void _splitUpdate(const std::string& pluginName);
+
                 DJV_PRIVATE();
             };
 
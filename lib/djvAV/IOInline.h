@@ -74,14 +74,18 @@ namespace djv
             inline VideoFrame::VideoFrame()
             {}
 
-            inline VideoFrame::VideoFrame(Core::Frame::Number frame, const std::shared_ptr<Image::Image>& image) :
+            inline VideoFrame::VideoFrame(
+                Core::Frame::Number frame,
+                const std::shared_ptr<Image::Image>& image,
+                const std::vector<std::shared_ptr<Image::Image> >& layers) :
                 frame(frame),
-                image(image)
+                image(image),
+                layers(layers)
             {}
             
             inline bool VideoFrame::operator == (const VideoFrame& other) const
             {
-                return frame == other.frame && image == other.image;
+                return frame == other.frame && image == other.image && layers == other.layers;
             }
 
             inline VideoQueue::VideoQueue()
@@ -222,6 +226,25 @@ namespace djv
                     _out == other._out;
             }
 
+            inline Playhead::Playhead()
+            {}
+
+            inline bool Playhead::operator == (const Playhead& other) const
+            {
+                return
+                    direction == other.direction &&
+                    playback == other.playback &&
+                    speed == other.speed &&
+                    everyFrame == other.everyFrame &&
+                    loop == other.loop &&
+                    pingPong == other.pingPong;
+            }
+
+            inline bool Playhead::operator != (const Playhead& other) const
+            {
+                return !(*this == other);
+            }
+
             inline Cache::Cache()
             {}
             
@@ -240,9 +263,19 @@ namespace djv
                 size_t out = 0;
                 for (const auto& i : _cache)
                 {
-                    if (i.second)
+                    if (i.second.layers.size())
+                    {
+                        for (const auto& j : i.second.layers)
+                        {
+                            if (j)
+                            {
+                                out += j->getDataByteCount();
+                            }
+                        }
+                    }
+                    else if (i.second.image)
                     {
-                        out += i.second->getDataByteCount();
+                        out += i.second.image->getDataByteCount();
                     }
                 }
                 return out;
@@ -268,9 +301,14 @@ namespace djv
                 return _readBehind;
             }
 
-            inline const Core::Frame::Sequence& Cache::getSequence() const
+            inline const Playhead& Cache::getPlayhead() const
+            {
+                return _playhead;
+            }
+
+            inline const std::vector<Core::Frame::Index>& Cache::getReadOrder() const
             {
-                return _sequence;
+                return _readOrder;
             }
 
             inline bool Cache::contains(Core::Frame::Index value) const
@@ -279,6 +317,17 @@ namespace djv
             }
 
             inline bool Cache::get(Core::Frame::Index index, std::shared_ptr<AV::Image::Image>& out) const
+            {
+                const auto i = _cache.find(index);
+                const bool found = i != _cache.end();
+                if (found)
+                {
+                    out = i->second.image;
+                }
+                return found;
+            }
+
+            inline bool Cache::get(Core::Frame::Index index, VideoFrame& out) const
             {
                 const auto i = _cache.find(index);
                 const bool found = i != _cache.end();
@@ -294,6 +343,62 @@ namespace djv
                 _cache.clear();
             }
 
+            inline ProxyCache::ProxyCache()
+            {}
+
+            inline size_t ProxyCache::getMaxByteCount() const
+            {
+                return _maxByteCount;
+            }
+
+            inline size_t ProxyCache::getByteCount() const
+            {
+                return _byteCount;
+            }
+
+            inline size_t ProxyCache::getCount() const
+            {
+                return _cache.size();
+            }
+
+            inline void ProxyCache::setMaxByteCount(size_t value)
+            {
+                _maxByteCount = value;
+                while (_byteCount > _maxByteCount && _cache.size())
+                {
+                    _evict();
+                }
+            }
+
+            inline bool ProxyCache::isFull() const
+            {
+                return _byteCount >= _maxByteCount;
+            }
+
+            inline bool ProxyCache::contains(Core::Frame::Index value) const
+            {
+                return _cache.find(value) != _cache.end();
+            }
+
+            inline bool ProxyCache::get(Core::Frame::Index index, std::shared_ptr<AV::Image::Image>& out) const
+            {
+                const auto i = _cache.find(index);
+                const bool found = i != _cache.end();
+                if (found)
+                {
+                    out = i->second;
+                    _timestamps[index] = ++_timestamp;
+                }
+                return found;
+            }
+
+            inline void ProxyCache::clear()
+            {
+                _cache.clear();
+                _timestamps.clear();
+                _byteCount = 0;
+            }
+
         } // namespace IO
     } // namespace AV
 } // namespace djv
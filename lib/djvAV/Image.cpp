@@ -4,6 +4,8 @@
 
 #include <djvAV/Image.h>
 
+#include <djvAV/ImageStats.h>
+
 namespace djv
 {
     namespace AV
@@ -21,21 +23,12 @@ namespace djv
             Image::~Image()
             {}
 
-#if defined(DJV_MMAP)
             std::shared_ptr<Image> Image::create(const Info& value, const std::shared_ptr<Core::FileSystem::FileIO>& io)
             {
                 auto out = std::shared_ptr<Image>(new Image);
                 out->_init(value, io);
                 return out;
             }
-#else // DJV_MMAP
-            std::shared_ptr<Image> Image::create(const Info & value)
-            {
-                auto out = std::shared_ptr<Image>(new Image);
-                out->_init(value, nullptr);
-                return out;
-            }
-#endif // DJV_MMAP
 
             const std::string& Image::getPluginName() const
             {
@@ -55,6 +48,17 @@ namespace djv
             void Image::setTags(const Tags& value)
             {
                 _tags = value;
+                _tags.share();
+            }
+
+            const std::shared_ptr<Stats>& Image::getStats() const
+            {
+                return _stats;
+            }
+
+            void Image::setStats(const std::shared_ptr<Stats>& value)
+            {
+                _stats = value;
             }
 
         } // namespace Image
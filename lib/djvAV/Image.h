@@ -13,6 +13,8 @@ namespace djv
     {
         namespace Image
         {
+            struct Stats;
+
             //! This class provides an image.
             class Image : public Data
             {
@@ -25,11 +27,10 @@ namespace djv
             public:
                 ~Image();
 
-#if defined(DJV_MMAP)
+                //! Create a new image. If the file data is in memory and matches
+                //! the image layout it is referenced directly instead of being
+                //! copied.
                 static std::shared_ptr<Image> create(const Info&, const std::shared_ptr<Core::FileSystem::FileIO>& = nullptr);
-#else // DJV_MMAP
-                static std::shared_ptr<Image> create(const Info&);
-#endif // DJV_MMAP
 
                 const std::string& getPluginName() const;
                 void setPluginName(const std::string&);
@@ -37,9 +38,19 @@ namespace djv
                 const Tags& getTags() const;
                 void setTags(const Tags&);
 
+                //! Get the image statistics. The statistics are computed by
+                //! the readers when ReadOptions::stats is enabled, otherwise
+                //! this returns null.
+                const std::shared_ptr<Stats>& getStats() const;
+
+                //! Set the image statistics. This should only be called before
+                //! the image is shared with other threads.
+                void setStats(const std::shared_ptr<Stats>&);
+
             private:
                 std::string _pluginName;
                 Tags _tags;
+                std::shared_ptr<Stats> _stats;
             };
 
         } // namespace Image
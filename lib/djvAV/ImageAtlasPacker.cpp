@@ -0,0 +1,434 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/ImageAtlasPacker.h>
+
+#include <algorithm>
+#include <list>
+#include <map>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const float shelfWasteMax = .5F;
+
+                struct Span
+                {
+                    int x = 0;
+                    int w = 0;
+                };
+
+                struct Shelf
+                {
+                    int y = 0;
+                    int h = 0;
+                    std::vector<Span> free;
+                    size_t itemCount = 0;
+                };
+
+                struct Page
+                {
+                    std::vector<Shelf> shelves;
+                    int top = 0;
+                };
+
+            } // namespace
+
+            struct AtlasPacker::Private
+            {
+                uint8_t pageCount = 0;
+                uint16_t pageSize = 0;
+                uint8_t border = 0;
+                std::vector<Page> pages;
+                struct Entry
+                {
+                    AtlasPackerItem item;
+                    std::list<UID>::iterator lru;
+                };
+                std::map<UID, Entry> items;
+                std::list<UID> lru;
+                UID uid = 0;
+                size_t usedArea = 0;
+                size_t evictionCount = 0;
+
+                bool allocate(int w, int h, uint8_t firstPage, uint8_t lastPage, bool anyShelf, AtlasPackerItem&);
+                void place(uint8_t page, size_t shelf, int w, int h, AtlasPackerItem&);
+                void release(const AtlasPackerItem&);
+                size_t findShelf(uint8_t page, int y) const;
+            };
+
+            AtlasPacker::AtlasPacker(uint8_t pageCount, uint16_t pageSize, uint8_t border) :
+                _p(new Private)
+            {
+                DJV_PRIVATE_PTR();
+                p.pageCount = pageCount;
+                p.pageSize = pageSize;
+                p.border = border;
+                p.pages.resize(pageCount);
+            }
+
+            AtlasPacker::~AtlasPacker()
+            {}
+
+            uint8_t AtlasPacker::getPageCount() const
+            {
+                return _p->pageCount;
+            }
+
+            uint16_t AtlasPacker::getPageSize() const
+            {
+                return _p->pageSize;
+            }
+
+            uint8_t AtlasPacker::getBorder() const
+            {
+                return _p->border;
+            }
+
+            bool AtlasPacker::hasItem(UID uid) const
+            {
+                return _p->items.find(uid) != _p->items.end();
+            }
+
+            bool AtlasPacker::getItem(UID uid, AtlasPackerItem& out)
+            {
+                DJV_PRIVATE_PTR();
+                const auto i = p.items.find(uid);
+                if (i != p.items.end())
+                {
+                    p.lru.splice(p.lru.begin(), p.lru, i->second.lru);
+                    out = i->second.item;
+                    return true;
+                }
+                return false;
+            }
+
+            UID AtlasPacker::addItem(uint16_t w, uint16_t h, AtlasPackerItem& out)
+            {
+                DJV_PRIVATE_PTR();
+                const int w2 = w + p.border * 2;
+                const int h2 = h + p.border * 2;
+                if (0 == p.pageCount || 0 == w || 0 == h || w2 > p.pageSize || h2 > p.pageSize)
+                {
+                    return 0;
+                }
+
+                // Try to find room without wasting too much of a shelf, then
+                // accept any shelf before evicting items.
+                const uint8_t lastPage = p.pageCount - 1;
+                bool allocated =
+                    p.allocate(w2, h2, 0, lastPage, false, out) ||
+                    p.allocate(w2, h2, 0, lastPage, true, out);
+
+                // Evict the least recently used items until there is room, only
+                // checking the page that changed.
+                while (!allocated && !p.lru.empty())
+                {
+                    const auto i = p.items.find(p.lru.back());
+                    const uint8_t page = i->second.item.page;
+                    p.release(i->second.item);
+                    p.items.erase(i);
+                    p.lru.pop_back();
+                    ++p.evictionCount;
+                    allocated = p.allocate(w2, h2, page, page, true, out);
+                }
+
+                UID out2 = 0;
+                if (allocated)
+                {
+                    out2 = ++p.uid;
+                    p.lru.push_front(out2);
+                    Private::Entry entry;
+                    entry.item = out;
+                    entry.lru = p.lru.begin();
+                    p.items[out2] = entry;
+                }
+                return out2;
+            }
+
+            void AtlasPacker::removeItem(UID uid)
+            {
+                DJV_PRIVATE_PTR();
+                const auto i = p.items.find(uid);
+                if (i != p.items.end())
+                {
+                    p.release(i->second.item);
+                    p.lru.erase(i->second.lru);
+                    p.items.erase(i);
+                }
+            }
+
+            void AtlasPacker::clear()
+            {
+                DJV_PRIVATE_PTR();
+                p.pages.clear();
+                p.pages.resize(p.pageCount);
+                p.items.clear();
+                p.lru.clear();
+                p.usedArea = 0;
+            }
+
+            bool AtlasPacker::isFree(uint8_t page, const BBox2i& bbox) const
+            {
+                DJV_PRIVATE_PTR();
+                if (page >= p.pageCount ||
+                    bbox.min.x < 0 || bbox.min.y < 0 || bbox.max.x >= p.pageSize || bbox.max.y >= p.pageSize)
+                {
+                    return false;
+                }
+                for (const auto& shelf : p.pages[page].shelves)
+                {
+                    if (shelf.y > bbox.max.y)
+                    {
+                        break;
+                    }
+                    if (shelf.y + shelf.h > bbox.min.y)
+                    {
+                        bool free = false;
+                        for (const auto& span : shelf.free)
+                        {
+                            if (bbox.min.x >= span.x && bbox.max.x < span.x + span.w)
+                            {
+                                free = true;
+                                break;
+                            }
+                        }
+                        if (!free)
+                        {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            size_t AtlasPacker::getItemCount() const
+            {
+                return _p->items.size();
+            }
+
+            size_t AtlasPacker::getEvictionCount() const
+            {
+                return _p->evictionCount;
+            }
+
+            float AtlasPacker::getPercentageUsed() const
+            {
+                DJV_PRIVATE_PTR();
+                const size_t area = static_cast<size_t>(p.pageSize) * static_cast<size_t>(p.pageSize) * p.pageCount;
+                return area > 0 ? (p.usedArea / static_cast<float>(area) * 100.F) : 0.F;
+            }
+
+            float AtlasPacker::getFragmentation() const
+            {
+                DJV_PRIVATE_PTR();
+                float out = 0.F;
+                for (const auto& page : p.pages)
+                {
+                    const size_t topArea = static_cast<size_t>(p.pageSize) * (p.pageSize - page.top);
+                    size_t freeArea = topArea;
+                    size_t largest = topArea;
+                    for (const auto& shelf : page.shelves)
+                    {
+                        for (const auto& span : shelf.free)
+                        {
+                            const size_t spanArea = static_cast<size_t>(span.w) * shelf.h;
+                            freeArea += spanArea;
+                            largest = std::max(largest, spanArea);
+                        }
+                    }
+                    if (freeArea > 0)
+                    {
+                        out += 1.F - largest / static_cast<float>(freeArea);
+                    }
+                }
+                return p.pageCount > 0 ? (out / static_cast<float>(p.pageCount) * 100.F) : 0.F;
+            }
+
+            bool AtlasPacker::Private::allocate(
+                int w,
+                int h,
+                uint8_t firstPage,
+                uint8_t lastPage,
+                bool anyShelf,
+                AtlasPackerItem& out)
+            {
+                // Find the existing shelf that wastes the least height.
+                bool found = false;
+                uint8_t bestPage = 0;
+                size_t bestShelf = 0;
+                int bestWaste = 0;
+                for (uint8_t i = firstPage; i <= lastPage; ++i)
+                {
+                    const auto& shelves = pages[i].shelves;
+                    for (size_t j = 0; j < shelves.size(); ++j)
+                    {
+                        const auto& shelf = shelves[j];
+                        if (shelf.h < h)
+                        {
+                            continue;
+                        }
+                        // Empty shelves are split to the item height.
+                        const int waste = shelf.itemCount > 0 ? (shelf.h - h) : 0;
+                        if ((!anyShelf && waste > shelf.h * shelfWasteMax) || (found && waste >= bestWaste))
+                        {
+                            continue;
+                        }
+                        for (const auto& span : shelf.free)
+                        {
+                            if (span.w >= w)
+                            {
+                                found = true;
+                                bestPage = i;
+                                bestShelf = j;
+                                bestWaste = waste;
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (found)
+                {
+                    place(bestPage, bestShelf, w, h, out);
+                    return true;
+                }
+
+                // Start a new shelf.
+                for (uint8_t i = firstPage; i <= lastPage; ++i)
+                {
+                    auto& page = pages[i];
+                    if (page.top + h <= pageSize)
+                    {
+                        Shelf shelf;
+                        shelf.y = page.top;
+                        shelf.h = h;
+                        Span span;
+                        span.w = pageSize;
+                        shelf.free.push_back(span);
+                        page.shelves.push_back(shelf);
+                        page.top += h;
+                        place(i, page.shelves.size() - 1, w, h, out);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void AtlasPacker::Private::place(uint8_t page, size_t shelfIndex, int w, int h, AtlasPackerItem& out)
+            {
+                auto& shelves = pages[page].shelves;
+                if (0 == shelves[shelfIndex].itemCount && shelves[shelfIndex].h > h)
+                {
+                    Shelf remainder;
+                    remainder.y = shelves[shelfIndex].y + h;
+                    remainder.h = shelves[shelfIndex].h - h;
+                    Span span;
+                    span.w = pageSize;
+                    remainder.free.push_back(span);
+                    shelves[shelfIndex].h = h;
+                    shelves.insert(shelves.begin() + shelfIndex + 1, remainder);
+                }
+                auto& shelf = shelves[shelfIndex];
+                for (auto i = shelf.free.begin(); i != shelf.free.end(); ++i)
+                {
+                    if (i->w >= w)
+                    {
+                        out.page = page;
+                        out.bbox = BBox2i(i->x, shelf.y, w, h);
+                        i->x += w;
+                        i->w -= w;
+                        if (0 == i->w)
+                        {
+                            shelf.free.erase(i);
+                        }
+                        break;
+                    }
+                }
+                ++shelf.itemCount;
+                usedArea += static_cast<size_t>(w) * h;
+            }
+
+            void AtlasPacker::Private::release(const AtlasPackerItem& item)
+            {
+                auto& page = pages[item.page];
+                const size_t shelfIndex = findShelf(item.page, item.bbox.min.y);
+                auto& shelf = page.shelves[shelfIndex];
+
+                // Return the span and merge it with its neighbors.
+                Span span;
+                span.x = item.bbox.min.x;
+                span.w = item.bbox.w();
+                auto i = std::lower_bound(
+                    shelf.free.begin(),
+                    shelf.free.end(),
+                    span,
+                    [](const Span& a, const Span& b)
+                    {
+                        return a.x < b.x;
+                    });
+                i = shelf.free.insert(i, span);
+                if (i + 1 != shelf.free.end() && i->x + i->w == (i + 1)->x)
+                {
+                    i->w += (i + 1)->w;
+                    shelf.free.erase(i + 1);
+                }
+                if (i != shelf.free.begin() && (i - 1)->x + (i - 1)->w == i->x)
+                {
+                    (i - 1)->w += i->w;
+                    shelf.free.erase(i);
+                }
+                --shelf.itemCount;
+                usedArea -= static_cast<size_t>(item.bbox.getArea());
+
+                // Merge empty shelves so the space can be reused by taller
+                // items, and give empty shelves at the top back to the page.
+                if (0 == shelf.itemCount)
+                {
+                    size_t j = shelfIndex;
+                    if (j + 1 < page.shelves.size() && 0 == page.shelves[j + 1].itemCount)
+                    {
+                        page.shelves[j].h += page.shelves[j + 1].h;
+                        page.shelves.erase(page.shelves.begin() + j + 1);
+                    }
+                    if (j > 0 && 0 == page.shelves[j - 1].itemCount)
+                    {
+                        page.shelves[j - 1].h += page.shelves[j].h;
+                        page.shelves.erase(page.shelves.begin() + j);
+                        --j;
+                    }
+                    if (j + 1 == page.shelves.size())
+                    {
+                        page.top = page.shelves[j].y;
+                        page.shelves.pop_back();
+                    }
+                }
+            }
+
+            size_t AtlasPacker::Private::findShelf(uint8_t page, int y) const
+            {
+                const auto& shelves = pages[page].shelves;
+                Shelf shelf;
+                shelf.y = y;
+                const auto i = std::lower_bound(
+                    shelves.begin(),
+                    shelves.end(),
+                    shelf,
+                    [](const Shelf& a, const Shelf& b)
+                    {
+                        return a.y < b.y;
+                    });
+                return i - shelves.begin();
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/BBox.h>
+#include <djvCore/UID.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This struct provides information about a packed atlas item.
+            struct AtlasPackerItem
+            {
+                uint8_t page = 0;
+
+                //! The area allocated for the item, including the border.
+                Core::BBox2i bbox;
+            };
+
+            //! This class provides rectangle packing for texture atlases. It
+            //! does not depend on OpenGL so it can be tested and benchmarked
+            //! without a context.
+            //!
+            //! Each page is divided into horizontal shelves, and each shelf
+            //! keeps a sorted list of free spans so that items can be
+            //! removed and the space reused. When the pages are full the least
+            //! recently used items are evicted until the new item fits.
+            //!
+            //! References:
+            //! - Jukka Jylanki, "A Thousand Ways to Pack the Bin"
+            class AtlasPacker
+            {
+                DJV_NON_COPYABLE(AtlasPacker);
+
+            public:
+                AtlasPacker(uint8_t pageCount, uint16_t pageSize, uint8_t border = 0);
+                ~AtlasPacker();
+
+                uint8_t getPageCount() const;
+                uint16_t getPageSize() const;
+                uint8_t getBorder() const;
+
+                //! Get whether an item is in the atlas without changing the
+                //! least recently used order.
+                bool hasItem(Core::UID) const;
+
+                //! Get an item and mark it as the most recently used.
+                bool getItem(Core::UID, AtlasPackerItem&);
+
+                //! Add an item, evicting the least recently used items if
+                //! necessary. Returns zero if the item is larger than a page.
+                Core::UID addItem(uint16_t w, uint16_t h, AtlasPackerItem&);
+
+                void removeItem(Core::UID);
+                void clear();
+
+                //! Get whether an area of a page is unallocated.
+                bool isFree(uint8_t page, const Core::BBox2i&) const;
+
+                size_t getItemCount() const;
+                size_t getEvictionCount() const;
+
+                //! Get the percentage of the pages covered by items.
+                float getPercentageUsed() const;
+
+                //! Get the percentage of the free area that is outside of the
+                //! largest free rectangle, averaged over the pages.
+                float getFragmentation() const;
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
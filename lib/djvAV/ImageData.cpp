@@ -19,10 +19,10 @@ namespace djv
                 _pixelByteCount = info.getPixelByteCount();
                 _scanlineByteCount = info.getScanlineByteCount();
                 _dataByteCount = info.getDataByteCount();
-#if defined(DJV_MMAP)
-                _fileIO = fileIO;
-                if (_fileIO)
+                if (fileIO && fileIO->mmapP() &&
+                    static_cast<size_t>(fileIO->mmapEnd() - fileIO->mmapP()) >= _dataByteCount)
                 {
+                    _fileIO = fileIO;
                     _p = _fileIO->mmapP();
                 }
                 else if (_dataByteCount)
@@ -30,13 +30,6 @@ namespace djv
                     _data = new uint8_t[_dataByteCount];
                     _p = _data;
                 }
-#else // DJV_MMAP
-                if (_dataByteCount)
-                {
-                    _data = new uint8_t[_dataByteCount];
-                    _p = _data;
-                }
-#endif // DJV_MMAP
             }
 
             Data::~Data()
@@ -44,51 +37,42 @@ namespace djv
                 delete[] _data;
             }
 
-#if defined(DJV_MMAP)
             std::shared_ptr<Data> Data::create(const Info& info, const std::shared_ptr<Core::FileSystem::FileIO>& fileIO)
             {
                 auto out = std::shared_ptr<Data>(new Data);
                 out->_init(info, fileIO);
                 return out;
             }
-#else // DJV_MMAP
-            std::shared_ptr<Data> Data::create(const Info& info)
-            {
-                auto out = std::shared_ptr<Data>(new Data);
-                out->_init(info, nullptr);
-                return out;
-            }
-#endif // DJV_MMAP
 
             size_t Data::getDataByteCount() const
             {
-#if defined(DJV_MMAP)
-                return _fileIO ? (_fileIO->getSize() - _fileIO->getPos()) : _dataByteCount;
-#else
                 return _dataByteCount;
-#endif // DJV_MMAP
             }
 
             void Data::zero()
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                if (_fileIO)
+                {
+                    _copy();
+                }
                 memset(_data, 0, _dataByteCount);
             }
 
-#if defined(DJV_MMAP)
             void Data::detach()
             {
-                if (_fileIO)
+                if (_fileIO && _fileIO->isMemoryMapped())
                 {
-                    _data = new uint8_t[_dataByteCount];
-                    memcpy(_data, _fileIO->mmapP(), std::min(_fileIO->getSize() - _fileIO->getPos(), _dataByteCount));
-                    _p = _data;
-                    _fileIO.reset();
+                    _copy();
                 }
             }
-#endif // DJV_MMAP
+
+            void Data::_copy()
+            {
+                _data = new uint8_t[_dataByteCount];
+                memcpy(_data, _p, _dataByteCount);
+                _p = _data;
+                _fileIO.reset();
+            }
 
             bool Data::operator == (const Data& other) const
             {
@@ -113,11 +113,10 @@ namespace djv
             public:
                 ~Data();
 
-#if defined(DJV_MMAP)
+                //! Create new image data. If the file data is in memory and
+                //! matches the image layout it is referenced directly instead
+                //! of being copied.
                 static std::shared_ptr<Data> create(const Info&, const std::shared_ptr<Core::FileSystem::FileIO>& = nullptr);
-#else // DJV_MMAP
-                static std::shared_ptr<Data> create(const Info&);
-#endif // DJV_MMAP
 
                 Core::UID getUID() const;
 
@@ -146,14 +145,20 @@ namespace djv
 
                 void zero();
 
-#if defined(DJV_MMAP)
+                //! Get whether the data references the memory of the file it
+                //! was read from.
+                bool hasFileIO() const;
+
+                //! Copy the data if it references a memory-mapped file, so that
+                //! the file is not held open.
                 void detach();
-#endif // DJV_MMAP
 
                 bool operator == (const Data&) const;
                 bool operator != (const Data&) const;
 
             private:
+                void _copy();
+
                 Core::UID _uid = 0;
                 Info _info;
                 uint8_t _pixelByteCount = 0;
@@ -161,9 +166,7 @@ namespace djv
                 size_t _dataByteCount = 0;
                 uint8_t* _data = nullptr;
                 const uint8_t* _p = nullptr;
-#if defined(DJV_MMAP)
                 std::shared_ptr<Core::FileSystem::FileIO> _fileIO;
-#endif // DJV_MMAP
             };
 
         } // namespace Image
@@ -150,6 +150,11 @@ namespace djv
                 return _info.isValid();
             }
 
+            inline bool Data::hasFileIO() const
+            {
+                return _fileIO != nullptr;
+            }
+
             inline const Info& Data::getInfo() const
             {
                 return _info;
@@ -222,25 +227,28 @@ namespace djv
 
             inline uint8_t* Data::getData()
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                if (_fileIO)
+                {
+                    _copy();
+                }
                 return _data;
             }
 
             inline uint8_t* Data::getData(uint16_t y)
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                if (_fileIO)
+                {
+                    _copy();
+                }
                 return _data + y * _scanlineByteCount;
             }
 
             inline uint8_t* Data::getData(uint16_t x, uint16_t y)
             {
-#if defined(DJV_MMAP)
-                detach();
-#endif // DJV_MMAP
+                if (_fileIO)
+                {
+                    _copy();
+                }
                 return _data + y * _scanlineByteCount + x * static_cast<size_t>(_pixelByteCount);
             }
 
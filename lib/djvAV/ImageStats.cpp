@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/ImageStats.h>
+
+#include <djvCore/Memory.h>
+
+#include <algorithm>
+#include <future>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                struct Accumulator
+                {
+                    Accumulator(uint8_t channels, size_t bins) :
+                        min(channels, std::numeric_limits<float>::max()),
+                        max(channels, -std::numeric_limits<float>::max()),
+                        sum(channels, 0.0),
+                        histogram(channels * bins, 0)
+                    {}
+
+                    std::vector<float> min;
+                    std::vector<float> max;
+                    std::vector<double> sum;
+                    std::vector<size_t> histogram;
+                };
+
+                template<uint8_t C>
+                void accumulate(const F32_T* data, size_t count, size_t bins, Accumulator& out)
+                {
+                    float min[C];
+                    float max[C];
+                    float sum[C];
+                    for (uint8_t c = 0; c < C; ++c)
+                    {
+                        min[c] = out.min[c];
+                        max[c] = out.max[c];
+                        sum[c] = 0.F;
+                    }
+                    const F32_T* p = data;
+                    for (size_t i = 0; i < count; ++i, p += C)
+                    {
+                        for (uint8_t c = 0; c < C; ++c)
+                        {
+                            min[c] = std::min(min[c], p[c]);
+                            max[c] = std::max(max[c], p[c]);
+                            sum[c] += p[c];
+                        }
+                    }
+                    for (uint8_t c = 0; c < C; ++c)
+                    {
+                        out.min[c] = min[c];
+                        out.max[c] = max[c];
+                        out.sum[c] += sum[c];
+                    }
+
+                    const float scale = static_cast<float>(bins);
+                    const float binMax = static_cast<float>(bins - 1);
+                    size_t* histogram = out.histogram.data();
+                    p = data;
+                    for (size_t i = 0; i < count; ++i, p += C)
+                    {
+                        for (uint8_t c = 0; c < C; ++c)
+                        {
+                            const float v = p[c] * scale;
+                            const size_t bin = v > 0.F ? static_cast<size_t>(std::min(v, binMax)) : 0;
+                            ++histogram[c * bins + bin];
+                        }
+                    }
+                }
+
+            } // namespace
+
+            Stats getStats(const Data& data, const StatsOptions& options)
+            {
+                Stats out;
+                const Info& info = data.getInfo();
+                const uint16_t w = info.size.w;
+                const uint16_t h = info.size.h;
+                const uint8_t channels = getChannelCount(info.type);
+                const size_t bins = std::max(options.histogramBins, static_cast<size_t>(1));
+                out.channelCount = channels;
+                out.min.resize(channels, 0.F);
+                out.max.resize(channels, 0.F);
+                out.mean.resize(channels, 0.F);
+                out.histogram.resize(channels, std::vector<size_t>(bins, 0));
+                if (!w || !h || !channels)
+                    return out;
+
+                const BBox2i bounds(0, 0, w, h);
+                const BBox2i roi = options.roi.w() > 0 && options.roi.h() > 0 ? bounds.intersect(options.roi) : bounds;
+                out.roi = roi;
+                if (roi.w() <= 0 || roi.h() <= 0)
+                    return out;
+
+                // Find the part of each scanline that is inside the region,
+                // taking the mirroring into account.
+                const size_t roiW = static_cast<size_t>(roi.w());
+                const size_t roiH = static_cast<size_t>(roi.h());
+                const size_t x0 = info.layout.mirror.x ? (w - 1 - roi.max.x) : roi.min.x;
+                const size_t pixelByteCount = getByteCount(info.type);
+                const DataType dataType = getDataType(info.type);
+                const bool endian = info.layout.endian != Memory::getEndian();
+                const size_t wordSize = DataType::U10 == dataType ? 4 : getByteCount(dataType);
+                const Type floatType = getFloatType(channels, 32);
+
+                const size_t threadCount = std::min(
+                    options.threadCount ?
+                        options.threadCount :
+                        std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1)),
+                    roiH);
+                std::vector<Accumulator> accumulators(threadCount, Accumulator(channels, bins));
+                std::vector<std::future<void> > futures;
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    futures.push_back(std::async(
+                        threadCount > 1 ? std::launch::async : std::launch::deferred,
+                        [&data, &info, &roi, &accumulators, i, threadCount, h, roiW, roiH, x0, pixelByteCount,
+                        endian, wordSize, floatType, channels, bins]
+                        {
+                            std::vector<uint8_t> endianRow(endian ? roiW * pixelByteCount : 0);
+                            std::vector<F32_T> row(roiW * channels);
+                            auto& accumulator = accumulators[i];
+                            for (size_t j = roiH * i / threadCount; j < roiH * (i + 1) / threadCount; ++j)
+                            {
+                                const size_t y = roi.min.y + j;
+                                const uint8_t* p = data.getData(static_cast<uint16_t>(info.layout.mirror.y ? (h - 1 - y) : y)) +
+                                    x0 * pixelByteCount;
+                                if (endian)
+                                {
+                                    Memory::endian(p, endianRow.data(), roiW * pixelByteCount / wordSize, wordSize);
+                                    p = endianRow.data();
+                                }
+                                convert(p, info.type, row.data(), floatType, roiW);
+                                switch (channels)
+                                {
+                                case 1: accumulate<1>(row.data(), roiW, bins, accumulator); break;
+                                case 2: accumulate<2>(row.data(), roiW, bins, accumulator); break;
+                                case 3: accumulate<3>(row.data(), roiW, bins, accumulator); break;
+                                case 4: accumulate<4>(row.data(), roiW, bins, accumulator); break;
+                                default: break;
+                                }
+                            }
+                        }));
+                }
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+
+                // Merge the results from each thread.
+                Accumulator total(channels, bins);
+                for (const auto& i : accumulators)
+                {
+                    for (uint8_t c = 0; c < channels; ++c)
+                    {
+                        total.min[c] = std::min(total.min[c], i.min[c]);
+                        total.max[c] = std::max(total.max[c], i.max[c]);
+                        total.sum[c] += i.sum[c];
+                    }
+                    for (size_t j = 0; j < total.histogram.size(); ++j)
+                    {
+                        total.histogram[j] += i.histogram[j];
+                    }
+                }
+                out.pixelCount = roiW * roiH;
+                for (uint8_t c = 0; c < channels; ++c)
+                {
+                    out.min[c] = total.min[c];
+                    out.max[c] = total.max[c];
+                    out.mean[c] = static_cast<float>(total.sum[c] / static_cast<double>(out.pixelCount));
+                    std::copy(
+                        total.histogram.begin() + c * bins,
+                        total.histogram.begin() + (c + 1) * bins,
+                        out.histogram[c].begin());
+                }
+                return out;
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
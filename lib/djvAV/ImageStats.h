@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/ImageData.h>
+
+#include <djvCore/BBox.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This struct provides image statistics options.
+            struct StatsOptions
+            {
+                //! The region of interest in image pixel coordinates. An empty
+                //! region uses the whole image.
+                Core::BBox2i roi = Core::BBox2i(0, 0, 0, 0);
+
+                size_t histogramBins = 256;
+
+                //! The number of threads, or zero to use the hardware
+                //! concurrency.
+                size_t threadCount = 0;
+            };
+
+            //! This struct provides image statistics.
+            //!
+            //! The values are normalized to the range 0-1 for integer types.
+            //! Floating point values outside of that range are included in
+            //! the minimum, maximum, and mean but are clamped to the first
+            //! and last histogram bins.
+            struct Stats
+            {
+                uint8_t channelCount = 0;
+                size_t pixelCount = 0;
+                Core::BBox2i roi = Core::BBox2i(0, 0, 0, 0);
+                std::vector<float> min;
+                std::vector<float> max;
+                std::vector<float> mean;
+                std::vector<std::vector<size_t> > histogram;
+            };
+
+            //! Compute image statistics. The scanlines are split between
+            //! threads and each thread converts them to floating point and
+            //! accumulates the results.
+            Stats getStats(const Data&, const StatsOptions& = StatsOptions());
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
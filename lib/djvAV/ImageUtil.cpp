@@ -5,7 +5,9 @@
 #include <djvAV/ImageUtil.h>
 
 #include <djvAV/Color.h>
-#include <djvAV/ImageData.h>
+#include <djvAV/ImageStats.h>
+
+#include <djvCore/Memory.h>
 
 using namespace djv::Core;
 
@@ -15,75 +17,102 @@ namespace djv
     {
         namespace Image
         {
-            namespace
+            Color getAverageColor(const std::shared_ptr<Data>& data)
             {
-                template<typename T, typename T2>
-                void getAverageColor(const uint8_t* data, uint16_t width, uint16_t height, uint8_t channels, uint8_t* out)
+                Color out;
+                if (data && data->isValid())
                 {
-                    std::vector<T2> average(channels, T2(0));
-                    const T* p = reinterpret_cast<const T*>(data);
-                    for (uint16_t y = 0; y < height; ++y)
-                    {
-                        for (uint16_t x = 0; x < width; ++x)
-                        {
-                            for (uint8_t c = 0; c < channels; ++c)
-                            {
-                                average[c] += *p++;
-                            }
-                        }
-                    }
-                    T* outP = reinterpret_cast<T*>(out);
+                    const Stats stats = getStats(*data);
+                    const Type type = data->getType();
+                    const uint8_t channels = getChannelCount(type);
+                    Color color(getFloatType(channels, 32));
                     for (uint8_t c = 0; c < channels; ++c)
                     {
-                        outP[c] = average[c] / static_cast<float>(width * height);
+                        color.setF32(stats.mean[c], c);
                     }
+                    out = color.convert(type);
+                }
+                return out;
+            }
+
+            void resize(const Data& in, Data& out)
+            {
+                const Info& inInfo = in.getInfo();
+                const Info& outInfo = out.getInfo();
+                const uint16_t inW = inInfo.size.w;
+                const uint16_t inH = inInfo.size.h;
+                const uint16_t outW = outInfo.size.w;
+                const uint16_t outH = outInfo.size.h;
+                if (!inW || !inH || !outW || !outH)
+                    return;
+
+                // The pixels are accumulated as floating point values with the
+                // same number of channels as the input.
+                const uint8_t channels = getChannelCount(inInfo.type);
+                const Type floatType = getFloatType(channels, 32);
+                const DataType dataType = getDataType(inInfo.type);
+                const bool endian = inInfo.layout.endian != Memory::getEndian();
+                const size_t wordSize = DataType::U10 == dataType ? 4 : getByteCount(dataType);
+
+                // Find the input pixels for each output column.
+                std::vector<uint16_t> x0(outW);
+                std::vector<uint16_t> x1(outW);
+                for (uint16_t x = 0; x < outW; ++x)
+                {
+                    x0[x] = static_cast<uint16_t>(static_cast<size_t>(x) * inW / outW);
+                    x1[x] = std::max(static_cast<uint16_t>((x + 1) * static_cast<size_t>(inW) / outW), static_cast<uint16_t>(x0[x] + 1));
                 }
 
-                void getAverageColorU10(const uint8_t* data, uint16_t width, uint16_t height, uint8_t* out)
+                std::vector<uint8_t> endianRow(endian ? in.getScanlineByteCount() : 0);
+                std::vector<F32_T> inRow(inW * channels);
+                std::vector<F32_T> outRow(outW * channels);
+                for (uint16_t y = 0; y < outH; ++y)
                 {
-                    uint64_t average[3] = { 0, 0, 0 };
-                    const U10_S_LSB* p = reinterpret_cast<const U10_S_LSB*>(data);
-                    for (uint16_t y = 0; y < height; ++y)
+                    const uint16_t y0 = static_cast<uint16_t>(static_cast<size_t>(y) * inH / outH);
+                    const uint16_t y1 = std::max(static_cast<uint16_t>((y + 1) * static_cast<size_t>(inH) / outH), static_cast<uint16_t>(y0 + 1));
+                    std::fill(outRow.begin(), outRow.end(), 0.F);
+                    for (uint16_t inY = y0; inY < y1; ++inY)
                     {
-                        for (uint16_t x = 0; x < width; ++x)
+                        const uint8_t* p = in.getData(inInfo.layout.mirror.y ? (inH - 1 - inY) : inY);
+                        if (endian)
                         {
-                            average[0] += p->r;
-                            average[1] += p->g;
-                            average[2] += p->b;
-                            ++p;
+                            Memory::endian(p, endianRow.data(), inW * getByteCount(inInfo.type) / wordSize, wordSize);
+                            p = endianRow.data();
+                        }
+                        convert(p, inInfo.type, inRow.data(), floatType, inW);
+                        for (uint16_t x = 0; x < outW; ++x)
+                        {
+                            F32_T* outP = outRow.data() + x * channels;
+                            for (uint16_t inX = x0[x]; inX < x1[x]; ++inX)
+                            {
+                                const F32_T* inP = inRow.data() +
+                                    (inInfo.layout.mirror.x ? (inW - 1 - inX) : inX) * channels;
+                                for (uint8_t c = 0; c < channels; ++c)
+                                {
+                                    outP[c] += inP[c];
+                                }
+                            }
                         }
                     }
-                    U10_S_LSB* outP = reinterpret_cast<U10_S_LSB*>(out);
-                    outP->r = average[0] / static_cast<float>(width * height);
-                    outP->g = average[1] / static_cast<float>(width * height);
-                    outP->b = average[2] / static_cast<float>(width * height);
-                }
-
-            } // namespace
-
-            Color getAverageColor(const std::shared_ptr<Data>& data)
-            {
-                Color out;
-                if (data && data->isValid())
-                {
-                    const uint16_t w = data->getWidth();
-                    const uint16_t h = data->getHeight();
-                    const AV::Image::Type type = data->getType();
-                    const uint8_t c = getChannelCount(type);
-                    const uint8_t* p = data->getData();
-                    out = Color(type);
-                    switch (getDataType(type))
+                    for (uint16_t x = 0; x < outW; ++x)
+                    {
+                        const float n = static_cast<float>((x1[x] - x0[x]) * (y1 - y0));
+                        F32_T* outP = outRow.data() + x * channels;
+                        for (uint8_t c = 0; c < channels; ++c)
+                        {
+                            outP[c] /= n;
+                        }
+                    }
+                    uint8_t* outP = out.getData(y);
+                    convert(outRow.data(), floatType, outP, outInfo.type, outW);
+                    if (outInfo.layout.endian != Memory::getEndian())
                     {
-                    case DataType::U8:  getAverageColor<U8_T,  uint64_t>(p, w, h, c, out.getData()); break;
-                    case DataType::U16: getAverageColor<U16_T, uint64_t>(p, w, h, c, out.getData()); break;
-                    case DataType::U10: getAverageColorU10(p, w, h, out.getData()); break;
-                    case DataType::U32: getAverageColor<U32_T, uint64_t>(p, w, h, c, out.getData()); break;
-                    case DataType::F16: getAverageColor<F16_T, double>(p, w, h, c, out.getData()); break;
-                    case DataType::F32: getAverageColor<F32_T, double>(p, w, h, c, out.getData()); break;
-                    default: break;
+                        const size_t outWordSize = DataType::U10 == getDataType(outInfo.type) ?
+                            4 :
+                            getByteCount(getDataType(outInfo.type));
+                        Memory::endian(outP, outW * getByteCount(outInfo.type) / outWordSize, outWordSize);
                     }
                 }
-                return out;
             }
 
         } // namespace Image
@@ -19,6 +19,11 @@ namespace djv
 
             Color getAverageColor(const std::shared_ptr<Data>&);
 
+            //! Resize and convert image data on the CPU. A box filter is used
+            //! when reducing the size, and the input mirroring and endian are
+            //! removed.
+            void resize(const Data&, Data&);
+
         } // namespace Image
     } // namespace AV
 } // namespace djv
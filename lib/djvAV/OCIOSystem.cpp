@@ -12,6 +12,8 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include <future>
+
 // These need to be included last on OSX.
 #include <djvCore/PicoJSONTemplates.h>
 #include <djvUI/ISettingsTemplates.h>
@@ -57,6 +59,8 @@ namespace djv
                 std::shared_ptr<ListSubject<std::string> > colorSpacesSubject;
                 std::shared_ptr<ListSubject<Display> > displaysSubject;
                 std::shared_ptr<ListSubject<std::string> > viewsSubject;
+                std::string envFileName;
+                std::future<_OCIO::ConstConfigRcPtr> envConfigFuture;
             };
 
             void System::_init(const std::shared_ptr<Core::Context>& context)
@@ -83,19 +87,18 @@ namespace djv
                 
                 _configUpdate();
 
-                std::string env = OS::getEnv("OCIO");
-                if (!env.empty())
+                // Reading the configuration from the environment can be slow
+                // so it is done in the background. It is finished by the next
+                // tick, or by the first call that changes the configurations.
+                p.envFileName = OS::getEnv("OCIO");
+                if (!p.envFileName.empty())
                 {
-                    if (auto ocioConfig = _OCIO::Config::CreateFromEnv())
-                    {
-                        Config config;
-                        config.fileName = env;
-                        config.name = AV::OCIO::Config::getNameFromFileName(env);
-                        p.ocioConfigs.push_back(ocioConfig);
-                        p.configs.push_back(config);
-                        p.configsSubject->setIfChanged(p.configs);
-                        setCurrentIndex(0);
-                    }
+                    p.envConfigFuture = std::async(
+                        std::launch::async,
+                        []
+                        {
+                            return _OCIO::Config::CreateFromEnv();
+                        });
                 }
             }
 
@@ -110,9 +113,20 @@ namespace djv
             {
                 auto out = std::shared_ptr<System>(new System);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
 
+            void System::tick()
+            {
+                DJV_PRIVATE_PTR();
+                if (p.envConfigFuture.valid() &&
+                    p.envConfigFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    _envConfigFinish();
+                }
+            }
+
             std::shared_ptr<Core::IListSubject<Config> > System::observeConfigs() const
             {
                 return _p->configsSubject;
@@ -134,6 +148,7 @@ namespace djv
             void System::removeConfig(int value)
             {
                 DJV_PRIVATE_PTR();
+                _envConfigFinish();
                 if (value >= 0 && value < p.configs.size())
                 {
                     p.ocioConfigs.erase(p.ocioConfigs.begin() + value);
@@ -185,6 +200,7 @@ namespace djv
             void System::setCurrentConfig(const Config& value)
             {
                 DJV_PRIVATE_PTR();
+                _envConfigFinish();
                 if (value == p.currentConfig)
                     return;
                 const int index = p.currentIndex;
@@ -203,6 +219,7 @@ namespace djv
             void System::setCurrentIndex(int value)
             {
                 DJV_PRIVATE_PTR();
+                _envConfigFinish();
                 int tmp = -1;
                 if (p.configs.size())
                 {
@@ -240,9 +257,35 @@ namespace djv
                 return std::string();
             }
 
+            void System::_envConfigFinish()
+            {
+                DJV_PRIVATE_PTR();
+                if (p.envConfigFuture.valid())
+                {
+                    try
+                    {
+                        if (auto ocioConfig = p.envConfigFuture.get())
+                        {
+                            Config config;
+                            config.fileName = p.envFileName;
+                            config.name = AV::OCIO::Config::getNameFromFileName(p.envFileName);
+                            p.ocioConfigs.push_back(ocioConfig);
+                            p.configs.push_back(config);
+                            p.configsSubject->setIfChanged(p.configs);
+                            setCurrentIndex(0);
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), LogLevel::Error);
+                    }
+                }
+            }
+
             int System::_addConfig(const Config& config, bool init)
             {
                 DJV_PRIVATE_PTR();
+                _envConfigFinish();
                 int out = -1;
                 if (auto context = getContext().lock())
                 {
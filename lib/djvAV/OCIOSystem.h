@@ -50,6 +50,8 @@ namespace djv
                 ~System() override;
                 static std::shared_ptr<System> create(const std::shared_ptr<Core::Context>&);
 
+                void tick() override;
+
                 //! \name Configurations
                 ///@{
 
@@ -84,6 +86,7 @@ namespace djv
                 ///@}
                 
             private:
+                void _envConfigFinish();
                 int _addConfig(const Config&, bool init);
                 void _configUpdate();
 
@@ -543,6 +543,57 @@ namespace djv
                     return BBox2i(glm::ivec2(value.min.x, value.min.y), glm::ivec2(value.max.x, value.max.y));
                 }
 
+                int getLineBlockSize(Imf::Compression value)
+                {
+                    int out = 1;
+                    switch (value)
+                    {
+                    case Imf::ZIP_COMPRESSION:
+                    case Imf::PXR24_COMPRESSION: out = 16; break;
+                    case Imf::PIZ_COMPRESSION:
+                    case Imf::B44_COMPRESSION:
+                    case Imf::B44A_COMPRESSION:
+                    case Imf::DWAA_COMPRESSION: out = 32; break;
+                    case Imf::DWAB_COMPRESSION: out = 256; break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                int getLevel(float scale, int levels)
+                {
+                    int out = 0;
+                    float levelScale = 1.F;
+                    while (out < levels - 1 && levelScale * .5F >= scale)
+                    {
+                        levelScale *= .5F;
+                        ++out;
+                    }
+                    return out;
+                }
+
+                namespace
+                {
+                    int floorShift(int value, int level)
+                    {
+                        return value >= 0 ?
+                            (value >> level) :
+                            -((-value + (1 << level) - 1) >> level);
+                    }
+
+                } // namespace
+
+                BBox2i toLevel(const BBox2i& value, const glm::ivec2& origin, int level)
+                {
+                    return BBox2i(
+                        glm::ivec2(
+                            origin.x + floorShift(value.min.x - origin.x, level),
+                            origin.y + floorShift(value.min.y - origin.y, level)),
+                        glm::ivec2(
+                            origin.x + floorShift(value.max.x - origin.x, level),
+                            origin.y + floorShift(value.max.y - origin.y, level)));
+                }
+
                 Imf::PixelType toImf(Image::DataType value)
                 {
                     Imf::PixelType out = Imf::PixelType::HALF;
@@ -579,6 +630,16 @@ namespace djv
                 struct Plugin::Private
                 {
                     Options options;
+                    size_t decodeThreadCount = 1;
+
+                    void threadCountUpdate()
+                    {
+                        const int value = static_cast<int>(options.threadCount > 0 ? options.threadCount : decodeThreadCount);
+                        if (value != Imf::globalThreadCount())
+                        {
+                            Imf::setGlobalThreadCount(value);
+                        }
+                    }
                 };
 
                 Plugin::Plugin() :
@@ -588,7 +649,6 @@ namespace djv
                 std::shared_ptr<Plugin> Plugin::create(const std::shared_ptr<Context>& context)
                 {
                     auto out = std::shared_ptr<Plugin>(new Plugin);
-                    Imf::setGlobalThreadCount(out->_p->options.threadCount);
                     out->_init(
                         pluginName,
                         DJV_TEXT("plugin_openexr_io"),
@@ -606,7 +666,19 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     fromJSON(value, p.options);
-                    Imf::setGlobalThreadCount(p.options.threadCount);
+                    p.threadCountUpdate();
+                }
+
+                bool Plugin::hasDecodeThreads() const
+                {
+                    return true;
+                }
+
+                void Plugin::setDecodeThreadCount(size_t value)
+                {
+                    DJV_PRIVATE_PTR();
+                    p.decodeThreadCount = value;
+                    p.threadCountUpdate();
                 }
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
@@ -26,7 +26,6 @@ namespace djv
             //! - http://www.openexr.com
             //!
             //! \todo Add support for writing luminance/chroma images.
-            //! \todo Add better support for tiled images.
             namespace OpenEXR
             {
                 static const std::string pluginName = "OpenEXR";
@@ -110,6 +109,16 @@ namespace djv
                 //! Convert an Imath box type.
                 Core::BBox2i fromImath(const Imath::Box2i&);
 
+                //! Get the number of scanlines that are compressed together.
+                int getLineBlockSize(Imf::Compression);
+
+                //! Get the resolution level for the given display scale.
+                int getLevel(float scale, int levels);
+
+                //! Convert a full resolution box to the given resolution level. The
+                //! origin is the data window minimum which is shared by all levels.
+                Core::BBox2i toLevel(const Core::BBox2i&, const glm::ivec2& origin, int level);
+
                 //! Convert to an Imf pixel type.
                 Imf::PixelType toImf(Image::DataType);
 
@@ -122,32 +131,23 @@ namespace djv
                 //! This struct provides the OpenEXR file I/O optioms.
                 struct Options
                 {
-                    size_t      threadCount         = 4;
+                    size_t      threadCount         = 0; //!< Zero uses the I/O system thread split
                     Channels    channels            = Channels::Known;
                     Compression compression         = Compression::None;
                     float       dwaCompressionLevel = 45.F;
                 };
 
-                //! This class provides a memory-mapped input stream.
-                class MemoryMappedIStream : public Imf::IStream
-                {
-                    DJV_NON_COPYABLE(MemoryMappedIStream);
-
-                public:
-                    MemoryMappedIStream(const char fileName[]);
-                    ~MemoryMappedIStream() override;
-
-                    bool isMemoryMapped() const override;
-                    char* readMemoryMapped(int n) override;
-                    bool read(char c[], int n) override;
-                    Imf::Int64 tellg() override;
-                    void seekg(Imf::Int64 pos) override;
-
-                private:
-                    DJV_PRIVATE();
-                };
-
                 //! This class provides the OpenEXR file reader.
+                //!
+                //! Scanline images are decoded in chunks of whole line blocks and tiled
+                //! images with a single call for all of the visible tiles so that the
+                //! OpenEXR thread pool can decode them in parallel. Only the data
+                //! intersecting the region of interest is decoded, and for mipmapped
+                //! images the level is chosen from the display scale.
+                //!
+                //! Multi-part files are supported, with the layers of each part named
+                //! after the part. Deep data parts are skipped. When all of the layers
+                //! are requested each part is only decoded once.
                 class Read : public ISequenceRead
                 {
                     DJV_NON_COPYABLE(Read);
@@ -169,10 +169,19 @@ namespace djv
                 protected:
                     Info _readInfo(const std::string & fileName) override;
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
+                    std::vector<std::shared_ptr<Image::Image> > _readLayers(const std::string & fileName) override;
+                    std::shared_ptr<Image::Image> _readProxy(const std::string & fileName, float scale) override;
 
                 private:
                     struct File;
                     Info _open(const std::string &, File &);
+                    std::vector<std::shared_ptr<Image::Image> > _read(
+                        File&,
+                        size_t part,
+                        const Info&,
+                        const std::vector<size_t>& layers,
+                        float scale,
+                        const Core::BBox2i& roi);
 
                     DJV_PRIVATE();
                 };
@@ -220,6 +229,12 @@ namespace djv
                     picojson::value getOptions() const override;
                     void setOptions(const picojson::value &) override;
 
+                    //! The OpenEXR thread pool is shared by all of the readers and
+                    //! writers. The thread count option overrides the decode thread
+                    //! count when it is non-zero.
+                    bool hasDecodeThreads() const override;
+                    void setDecodeThreadCount(size_t) override;
+
                     std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const override;
                     std::shared_ptr<IWrite> write(const Core::FileSystem::FileInfo&, const Info &, const WriteOptions&) const override;
 
@@ -4,15 +4,18 @@
 
 #include <djvAV/OpenEXR.h>
 
-#include <djvCore/FileIO.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 
 #include <ImfChannelList.h>
 #include <ImfHeader.h>
-#include <ImfInputFile.h>
+#include <ImfInputPart.h>
+#include <ImfMultiPartInputFile.h>
+#include <ImfPartType.h>
 #include <ImfRgbaYca.h>
+#include <ImfThreading.h>
+#include <ImfTiledInputPart.h>
 
 using namespace djv::Core;
 
@@ -24,81 +27,23 @@ namespace djv
         {
             namespace OpenEXR
             {
-#if defined(DJV_MMAP)
-                struct MemoryMappedIStream::Private
-                {
-                    FileSystem::FileIO  f;
-                    uint64_t            size    = 0;
-                    uint64_t            pos     = 0;
-                    char*               p       = nullptr;
-                };
-
-                MemoryMappedIStream::MemoryMappedIStream(const char fileName[]) :
-                    IStream(fileName),
-                    _p(new Private)
-                {
-                    DJV_PRIVATE_PTR();
-                    p.f.open(fileName, FileSystem::FileIO::Mode::Read);
-                    p.size = p.f.getSize();
-                    p.p = (char*)(p.f.mmapP());
-                }
-
-                MemoryMappedIStream::~MemoryMappedIStream()
-                {}
-
-                bool MemoryMappedIStream::isMemoryMapped() const
-                {
-                    return true;
-                }
-
-                char* MemoryMappedIStream::readMemoryMapped(int n)
-                {
-                    DJV_PRIVATE_PTR();
-                    if (p.pos >= p.size)
-                        throw FileSystem::Error("Error reading OpenEXR file.");
-                    if (p.pos + n > p.size)
-                        throw FileSystem::Error("Error reading OpenEXR file.");
-                    char* out = p.p + p.pos;
-                    p.pos += n;
-                    return out;
-                }
-
-                bool MemoryMappedIStream::read(char c[], int n)
-                {
-                    DJV_PRIVATE_PTR();
-                    if (p.pos >= p.size)
-                        throw FileSystem::Error("Error reading OpenEXR file.");
-                    if (p.pos + n > p.size)
-                        throw FileSystem::Error("Error reading OpenEXR file.");
-                    memcpy(c, p.p + p.pos, n);
-                    p.pos += n;
-                    return p.pos < p.size;
-                }
-
-                Imf::Int64 MemoryMappedIStream::tellg()
-                {
-                    return _p->pos;
-                }
-
-                void MemoryMappedIStream::seekg(Imf::Int64 pos)
-                {
-                    _p->pos = pos;
-                }
-#endif // DJV_MMAP
-
                 struct Read::File
                 {
-                    ~File()
+                    struct Part
                     {
-                    }
+                        int                                   index         = 0;
+                        std::unique_ptr<Imf::InputPart>       f;
+                        std::unique_ptr<Imf::TiledInputPart>  t;
+                        BBox2i                                displayWindow;
+                        BBox2i                                dataWindow;
+                        bool                                  subsampled    = false;
+                        int                                   lineBlockSize = 1;
+                    };
 
-                    std::unique_ptr<MemoryMappedIStream> s;
-                    std::unique_ptr<Imf::InputFile>      f;
-                    BBox2i                               displayWindow;
-                    BBox2i                               dataWindow;
-                    BBox2i                               intersectedWindow;
-                    std::vector<OpenEXR::Layer>          layers;
-                    bool                                 fast              = false;
+                    std::unique_ptr<Imf::MultiPartInputFile>  m;
+                    std::vector<Part>                         parts;
+                    std::vector<OpenEXR::Layer>               layers;
+                    std::vector<size_t>                       layerParts;
                 };
 
                 struct Read::Private
@@ -138,74 +83,246 @@ namespace djv
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
                     File f;
-                    Info info = _open(fileName, f);
-                    Image::Info imageInfo = info.video[std::min(_options.layer, info.video.size() - 1)].info;
-                    std::shared_ptr<Image::Image> out = Image::Image::create(imageInfo);
-                    out->setPluginName(pluginName);
-                    out->setTags(info.tags);
-                    const size_t channels = Image::getChannelCount(imageInfo.type);
-                    const size_t channelByteCount = Image::getByteCount(getDataType(imageInfo.type));
-                    const size_t cb = channels * channelByteCount;
-                    const size_t scb = imageInfo.size.w * channels * channelByteCount;
-                    if (f.fast)
+                    const Info info = _open(fileName, f);
+                    const size_t layer = std::min(_options.layer, info.video.size() - 1);
+                    return _read(f, f.layerParts[layer], info, { layer }, _options.scale, _options.roi)[0];
+                }
+
+                std::vector<std::shared_ptr<Image::Image> > Read::_readLayers(const std::string & fileName)
+                {
+                    File f;
+                    const Info info = _open(fileName, f);
+
+                    // Decode each part once, filling all of its layers.
+                    std::vector<std::shared_ptr<Image::Image> > out(info.video.size());
+                    for (size_t part = 0; part < f.parts.size(); ++part)
                     {
-                        Imf::FrameBuffer frameBuffer;
-                        for (size_t c = 0; c < channels; ++c)
+                        std::vector<size_t> layers;
+                        for (size_t i = 0; i < f.layerParts.size(); ++i)
+                        {
+                            if (part == f.layerParts[i])
+                            {
+                                layers.push_back(i);
+                            }
+                        }
+                        if (layers.size())
                         {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
-                            frameBuffer.insert(
-                                name.c_str(),
-                                Imf::Slice(
-                                    toImf(Image::getDataType(imageInfo.type)),
-                                    (char*)out->getData() + (c * channelByteCount),
-                                    cb,
-                                    scb,
-                                    sampling.x,
-                                    sampling.y,
-                                    0.F));
+                            const auto images = _read(f, part, info, layers, _options.scale, _options.roi);
+                            for (size_t i = 0; i < layers.size(); ++i)
+                            {
+                                out[layers[i]] = images[i];
+                            }
                         }
-                        f.f->setFrameBuffer(frameBuffer);
-                        f.f->readPixels(f.displayWindow.min.y, f.displayWindow.max.y);
                     }
-                    else
+                    return out;
+                }
+
+                std::shared_ptr<Image::Image> Read::_readProxy(const std::string & fileName, float scale)
+                {
+                    // Read the whole image from the smallest level that is
+                    // large enough for the proxy.
+                    File f;
+                    const Info info = _open(fileName, f);
+                    const size_t layer = std::min(_options.layer, info.video.size() - 1);
+                    return _read(f, f.layerParts[layer], info, { layer }, scale, BBox2i(0, 0, 0, 0))[0];
+                }
+
+                std::vector<std::shared_ptr<Image::Image> > Read::_read(
+                    File& f,
+                    size_t partIndex,
+                    const Info& info,
+                    const std::vector<size_t>& layers,
+                    float scale,
+                    const BBox2i& roi)
+                {
+                    auto& part = f.parts[partIndex];
+
+                    // Select the resolution level.
+                    int level = 0;
+                    BBox2i displayWindow = part.displayWindow;
+                    BBox2i dataWindow = part.dataWindow;
+                    if (part.t)
                     {
-                        Imf::FrameBuffer frameBuffer;
-                        std::vector<char> buf(f.dataWindow.w() * cb);
-                        for (int c = 0; c < channels; ++c)
+                        level = getLevel(scale, std::min(part.t->numXLevels(), part.t->numYLevels()));
+                        if (level > 0)
                         {
-                            const std::string& name = f.layers[_options.layer].channels[c].name;
-                            const glm::ivec2& sampling = f.layers[_options.layer].channels[c].sampling;
-                            frameBuffer.insert(
-                                name.c_str(),
-                                Imf::Slice(
-                                    toImf(Image::getDataType(imageInfo.type)),
-                                    buf.data() - (f.dataWindow.min.x * cb) + (c * channelByteCount),
-                                    cb,
-                                    0,
-                                    sampling.x,
-                                    sampling.y,
-                                    0.F));
+                            dataWindow = fromImath(part.t->dataWindowForLevel(level, level));
+                            displayWindow = part.displayWindow == part.dataWindow ?
+                                dataWindow :
+                                toLevel(part.displayWindow, part.dataWindow.min, level);
                         }
-                        f.f->setFrameBuffer(frameBuffer);
-                        for (int y = f.displayWindow.min.y; y <= f.displayWindow.max.y; ++y)
+                    }
+
+                    // Find the window of data to decode.
+                    BBox2i window = displayWindow.intersect(dataWindow);
+                    if (roi.w() > 0 && roi.h() > 0)
+                    {
+                        const BBox2i partROI(
+                            part.displayWindow.min + roi.min,
+                            part.displayWindow.min + roi.max);
+                        window = window.intersect(toLevel(partROI, part.dataWindow.min, level));
+                    }
+
+                    // Create an image for each layer. The layers are decoded
+                    // together so the file is only read once.
+                    struct Target
+                    {
+                        const std::vector<Channel>* channels         = nullptr;
+                        Image::DataType             dataType         = Image::DataType::None;
+                        size_t                      channelByteCount = 0;
+                        size_t                      cb               = 0;
+                        uint8_t*                    p                = nullptr;
+                        std::vector<uint8_t>        buf;
+                    };
+                    std::vector<Target> targets;
+                    std::vector<std::shared_ptr<Image::Image> > out;
+                    for (const auto layer : layers)
+                    {
+                        Image::Info imageInfo = info.video[layer].info;
+                        imageInfo.size.w = displayWindow.w();
+                        imageInfo.size.h = displayWindow.h();
+                        auto image = Image::Image::create(imageInfo);
+                        image->setPluginName(pluginName);
+                        image->setTags(info.tags);
+                        if (window != displayWindow)
+                        {
+                            image->zero();
+                        }
+                        Target target;
+                        target.channels = &f.layers[layer].channels;
+                        target.dataType = Image::getDataType(imageInfo.type);
+                        target.channelByteCount = Image::getByteCount(target.dataType);
+                        target.cb = Image::getChannelCount(imageInfo.type) * target.channelByteCount;
+                        target.p = image->getData();
+                        targets.push_back(std::move(target));
+                        out.push_back(image);
+                    }
+                    if (window.min.x > window.max.x || window.min.y > window.max.y)
+                        return out;
+
+                    // Allocate temporary buffers for decoding regions that do not
+                    // fit inside the images.
+                    auto allocate = [&](size_t pixelCount)
+                    {
+                        for (auto& t : targets)
+                        {
+                            t.buf.resize(pixelCount * t.cb);
+                        }
+                    };
+
+                    // Copy a decoded region from the temporary buffers into the images.
+                    auto copy = [&](const BBox2i& region)
+                    {
+                        const int y0 = std::max(region.min.y, window.min.y);
+                        const int y1 = std::min(region.max.y, window.max.y);
+                        for (const auto& t : targets)
                         {
-                            uint8_t* p = out->getData() + ((y - f.displayWindow.min.y) * scb);
-                            uint8_t* end = p + scb;
-                            if (y >= f.intersectedWindow.min.y && y <= f.intersectedWindow.max.y)
+                            const size_t scb = displayWindow.w() * t.cb;
+                            const size_t rowByteCount = region.w() * t.cb;
+                            const size_t size = window.w() * t.cb;
+                            for (int y = y0; y <= y1; ++y)
                             {
-                                size_t size = (f.intersectedWindow.min.x - f.displayWindow.min.x) * cb;
-                                memset(p, 0, size);
-                                p += size;
-                                size = f.intersectedWindow.w() * cb;
-                                f.f->readPixels(y, y);
                                 memcpy(
-                                    p,
-                                    buf.data() + std::max(f.displayWindow.min.x - f.dataWindow.min.x, 0) * cb,
+                                    t.p + (y - displayWindow.min.y) * scb + (window.min.x - displayWindow.min.x) * t.cb,
+                                    t.buf.data() + (y - region.min.y) * rowByteCount + (window.min.x - region.min.x) * t.cb,
                                     size);
-                                p += size;
                             }
-                            memset(p, 0, end - p);
+                        }
+                    };
+
+                    // Create a frame buffer where the pixel (x, y) is located at
+                    // p + x * xStride + y * yStride, with p pointing either at the
+                    // images or the temporary buffers.
+                    auto frameBuffer = [&](bool buffer, const glm::ivec2& origin, size_t rowPixels)
+                    {
+                        Imf::FrameBuffer out;
+                        for (auto& t : targets)
+                        {
+                            uint8_t* p = buffer ? t.buf.data() : t.p;
+                            const size_t yStride = rowPixels * t.cb;
+                            const auto& channels = *t.channels;
+                            for (size_t c = 0; c < channels.size(); ++c)
+                            {
+                                out.insert(
+                                    channels[c].name.c_str(),
+                                    Imf::Slice(
+                                        toImf(t.dataType),
+                                        reinterpret_cast<char*>(p) -
+                                            static_cast<ptrdiff_t>(origin.x) * static_cast<ptrdiff_t>(t.cb) -
+                                            static_cast<ptrdiff_t>(origin.y) * static_cast<ptrdiff_t>(yStride) +
+                                            c * t.channelByteCount,
+                                        t.cb,
+                                        yStride,
+                                        channels[c].sampling.x,
+                                        channels[c].sampling.y,
+                                        0.F));
+                            }
+                        }
+                        return out;
+                    };
+
+                    if (part.t)
+                    {
+                        // Read all of the tiles intersecting the window with a single
+                        // call so they can be decoded in parallel.
+                        const glm::ivec2 tileSize(part.t->tileXSize(), part.t->tileYSize());
+                        const glm::ivec2 t0(
+                            (window.min.x - dataWindow.min.x) / tileSize.x,
+                            (window.min.y - dataWindow.min.y) / tileSize.y);
+                        const glm::ivec2 t1(
+                            (window.max.x - dataWindow.min.x) / tileSize.x,
+                            (window.max.y - dataWindow.min.y) / tileSize.y);
+                        const BBox2i tiles(
+                            dataWindow.min + t0 * tileSize,
+                            glm::ivec2(
+                                std::min(dataWindow.min.x + (t1.x + 1) * tileSize.x - 1, dataWindow.max.x),
+                                std::min(dataWindow.min.y + (t1.y + 1) * tileSize.y - 1, dataWindow.max.y)));
+                        if (tiles.min.x >= displayWindow.min.x && tiles.max.x <= displayWindow.max.x &&
+                            tiles.min.y >= displayWindow.min.y && tiles.max.y <= displayWindow.max.y)
+                        {
+                            part.t->setFrameBuffer(frameBuffer(false, displayWindow.min, displayWindow.w()));
+                            part.t->readTiles(t0.x, t1.x, t0.y, t1.y, level, level);
+                        }
+                        else
+                        {
+                            allocate(tiles.w() * tiles.h());
+                            part.t->setFrameBuffer(frameBuffer(true, tiles.min, tiles.w()));
+                            part.t->readTiles(t0.x, t1.x, t0.y, t1.y, level, level);
+                            copy(tiles);
+                        }
+                    }
+                    else if (!part.subsampled &&
+                        dataWindow.min.x >= displayWindow.min.x &&
+                        dataWindow.max.x <= displayWindow.max.x)
+                    {
+                        // The scanlines fit inside the images so decode them directly.
+                        part.f->setFrameBuffer(frameBuffer(false, displayWindow.min, displayWindow.w()));
+                        part.f->readPixels(window.min.y, window.max.y);
+                    }
+                    else
+                    {
+                        // Decode the scanlines in chunks of whole line blocks, large
+                        // enough to keep the OpenEXR threads busy.
+                        int chunkLines = 1;
+                        if (!part.subsampled)
+                        {
+                            chunkLines = part.lineBlockSize * std::max(Imf::globalThreadCount(), 1);
+                        }
+                        allocate(dataWindow.w() * chunkLines);
+                        for (int y = window.min.y; y <= window.max.y;)
+                        {
+                            const int chunk = (y - dataWindow.min.y) / chunkLines;
+                            const BBox2i region(
+                                glm::ivec2(dataWindow.min.x, y),
+                                glm::ivec2(
+                                    dataWindow.max.x,
+                                    std::min(dataWindow.min.y + (chunk + 1) * chunkLines - 1, window.max.y)));
+                            part.f->setFrameBuffer(part.subsampled ?
+                                frameBuffer(true, glm::ivec2(dataWindow.min.x, 0), 0) :
+                                frameBuffer(true, region.min, dataWindow.w()));
+                            part.f->readPixels(region.min.y, region.max.y);
+                            copy(region);
+                            y = region.max.y + 1;
                         }
                     }
                     return out;
@@ -218,56 +335,85 @@ namespace djv
                     Info out;
 
                     // Open the file.
-#if defined(DJV_MMAP)
-                    f.s.reset(new MemoryMappedIStream(fileName.c_str()));
-                    f.f.reset(new Imf::InputFile(*f.s.get()));
-#else // DJV_MMAP
-                    f.f.reset(new Imf::InputFile(fileName.c_str()));
-#endif // DJV_MMAP
-
-                    // Get the display and data windows.
-                    f.displayWindow = fromImath(f.f->header().displayWindow());
-                    f.dataWindow = fromImath(f.f->header().dataWindow());
-                    f.intersectedWindow = f.displayWindow.intersect(f.dataWindow);
-                    f.fast = f.displayWindow == f.dataWindow;
-
-                    // Get the tags.
-                    readTags(f.f->header(), out.tags, _speed);
-
-                    // Get the layers.
-                    f.layers = getLayers(f.f->header().channels(), p.options.channels);
+                    f.m.reset(new Imf::MultiPartInputFile(fileName.c_str()));
+
+                    // Get the tags. The tags are shared so the frames of a
+                    // sequence with identical headers use the same copy.
+                    readTags(f.m->header(0), out.tags, _speed);
+                    out.tags.share();
+
+                    // Get the parts and layers.
                     out.fileName = fileName;
-                    out.video.resize(f.layers.size());
-                    for (size_t i = 0; i < f.layers.size(); ++i)
+                    const int partCount = f.m->parts();
+                    for (int i = 0; i < partCount; ++i)
                     {
-                        const auto& layer = f.layers[i];
-                        const glm::ivec2 sampling(layer.channels[0].sampling.x, layer.channels[0].sampling.y);
-                        if (sampling.x != 1 || sampling.y != 1)
-                            f.fast = false;
-                        auto& info = out.video[i].info;
-                        info.name = layer.name;
-                        info.size.w = f.displayWindow.w();
-                        info.size.h = f.displayWindow.h();
-                        info.pixelAspectRatio = f.f->header().pixelAspectRatio();
-                        switch (layer.channels[0].type)
+                        const Imf::Header& header = f.m->header(i);
+
+                        // Deep data parts are not supported.
+                        if (header.hasType() && Imf::isDeepData(header.type()))
+                            continue;
+
+                        File::Part part;
+                        part.index = i;
+                        if (header.hasType() ? Imf::isTiled(header.type()) : header.hasTileDescription())
                         {
-                        case Image::DataType::F16:
-                        case Image::DataType::F32:
-                            info.type = Image::getFloatType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
-                            break;
-                        case Image::DataType::U32:
-                            info.type = Image::getIntType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
-                            break;
-                        default: break;
+                            part.t.reset(new Imf::TiledInputPart(*f.m, i));
                         }
-                        if (Image::Type::None == info.type)
+                        else
                         {
-                            throw FileSystem::Error(String::Format("{0}: {1}").
-                                arg(fileName).
-                                arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
+                            part.f.reset(new Imf::InputPart(*f.m, i));
                         }
-                        out.video[i].sequence = _sequence;
-                        out.video[i].speed = _speed;
+
+                        // Get the display and data windows.
+                        part.displayWindow = fromImath(header.displayWindow());
+                        part.dataWindow = fromImath(header.dataWindow());
+                        part.lineBlockSize = getLineBlockSize(header.compression());
+
+                        for (auto layer : getLayers(header.channels(), p.options.channels))
+                        {
+                            if (partCount > 1 && header.hasName())
+                            {
+                                layer.name = String::Format("{0}/{1}").arg(header.name()).arg(layer.name);
+                            }
+                            const glm::ivec2 sampling(layer.channels[0].sampling.x, layer.channels[0].sampling.y);
+                            if (sampling.x != 1 || sampling.y != 1)
+                                part.subsampled = true;
+                            VideoInfo videoInfo;
+                            auto& info = videoInfo.info;
+                            info.name = layer.name;
+                            info.size.w = part.displayWindow.w();
+                            info.size.h = part.displayWindow.h();
+                            info.pixelAspectRatio = header.pixelAspectRatio();
+                            switch (layer.channels[0].type)
+                            {
+                            case Image::DataType::F16:
+                            case Image::DataType::F32:
+                                info.type = Image::getFloatType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
+                                break;
+                            case Image::DataType::U32:
+                                info.type = Image::getIntType(layer.channels.size(), Image::getBitDepth(layer.channels[0].type));
+                                break;
+                            default: break;
+                            }
+                            if (Image::Type::None == info.type)
+                            {
+                                throw FileSystem::Error(String::Format("{0}: {1}").
+                                    arg(fileName).
+                                    arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
+                            }
+                            videoInfo.sequence = _sequence;
+                            videoInfo.speed = _speed;
+                            out.video.push_back(videoInfo);
+                            f.layers.push_back(layer);
+                            f.layerParts.push_back(f.parts.size());
+                        }
+                        f.parts.push_back(std::move(part));
+                    }
+                    if (f.layers.empty())
+                    {
+                        throw FileSystem::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
                     }
 
                     return out;
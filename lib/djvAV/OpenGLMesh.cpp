@@ -38,6 +38,66 @@ namespace djv
                     unsigned int a : 8;
                 };
 
+                uint8_t* packVertex(const Geom::TriangleMesh& mesh, const Geom::TriangleMesh::Vertex& vertex, VBOType type, uint8_t* p)
+                {
+                    const uint32_t v = vertex.v;
+                    const uint32_t t = vertex.t;
+                    const uint32_t n = vertex.n;
+                    switch (type)
+                    {
+                    case VBOType::Pos3_F32_UV_U16_Normal_U10:
+                    case VBOType::Pos3_F32_UV_U16_Normal_U10_Color_U8:
+                    {
+                        float* pf = reinterpret_cast<float*>(p);
+                        pf[0] = v ? mesh.v[v - 1][0] : 0.F;
+                        pf[1] = v ? mesh.v[v - 1][1] : 0.F;
+                        pf[2] = v ? mesh.v[v - 1][2] : 0.F;
+                        p += 3 * sizeof(float);
+
+                        uint16_t* pu16 = reinterpret_cast<uint16_t*>(p);
+                        pu16[0] = t ? Math::clamp(static_cast<int>(mesh.t[t - 1][0] * 65535.F), 0, 65535) : 0;
+                        pu16[1] = t ? Math::clamp(static_cast<int>(mesh.t[t - 1][1] * 65535.F), 0, 65535) : 0;
+                        p += 2 * sizeof(uint16_t);
+
+                        auto packedNormal = reinterpret_cast<PackedNormal*>(p);
+                        packedNormal->x = n ? Math::clamp(static_cast<int>(mesh.n[n - 1][0] * 511.F), -512, 511) : 0;
+                        packedNormal->y = n ? Math::clamp(static_cast<int>(mesh.n[n - 1][1] * 511.F), -512, 511) : 0;
+                        packedNormal->z = n ? Math::clamp(static_cast<int>(mesh.n[n - 1][2] * 511.F), -512, 511) : 0;
+                        p += sizeof(PackedNormal);
+
+                        if (VBOType::Pos3_F32_UV_U16_Normal_U10_Color_U8 == type)
+                        {
+                            auto packedColor = reinterpret_cast<PackedColor*>(p);
+                            packedColor->r = v ? Math::clamp(static_cast<int>(mesh.c[v - 1][0] * 255.F), 0, 255) : 0;
+                            packedColor->g = v ? Math::clamp(static_cast<int>(mesh.c[v - 1][1] * 255.F), 0, 255) : 0;
+                            packedColor->b = v ? Math::clamp(static_cast<int>(mesh.c[v - 1][2] * 255.F), 0, 255) : 0;
+                            packedColor->a = 255;
+                            p += sizeof(PackedColor);
+                        }
+                        break;
+                    }
+                    case VBOType::Pos3_F32_UV_F32_Normal_F32_Color_F32:
+                    {
+                        float* pf = reinterpret_cast<float*>(p);
+                        pf[0] = v ? mesh.v[v - 1][0] : 0.F;
+                        pf[1] = v ? mesh.v[v - 1][1] : 0.F;
+                        pf[2] = v ? mesh.v[v - 1][2] : 0.F;
+                        pf[3] = t ? mesh.t[t - 1][0] : 0.F;
+                        pf[4] = t ? mesh.t[t - 1][1] : 0.F;
+                        pf[5] = n ? mesh.n[n - 1][0] : 0.F;
+                        pf[6] = n ? mesh.n[n - 1][1] : 0.F;
+                        pf[7] = n ? mesh.n[n - 1][2] : 0.F;
+                        pf[8] = v ? mesh.c[v - 1][0] : 1.F;
+                        pf[9] = v ? mesh.c[v - 1][1] : 1.F;
+                        pf[10] = v ? mesh.c[v - 1][2] : 1.F;
+                        p += 11 * sizeof(float);
+                        break;
+                    }
+                    default: break;
+                    }
+                    return p;
+                }
+
             } // namespace
 
             void VBO::_init(size_t size, VBOType type)
@@ -134,126 +194,64 @@ namespace djv
                 const size_t vertexByteCount = getVertexByteCount(type);
                 std::vector<uint8_t> out((range.max - range.min + 1) * 3 * vertexByteCount);
                 uint8_t * p = out.data();
-                switch (type)
+                for (size_t i = range.min; i <= range.max; ++i)
                 {
-                case VBOType::Pos3_F32_UV_U16_Normal_U10:
-                    for (size_t i = range.min; i <= range.max; ++i)
-                    {
-                        const Geom::TriangleMesh::Vertex* vertices[] =
-                        {
-                            &mesh.triangles[i].v0,
-                            &mesh.triangles[i].v1,
-                            &mesh.triangles[i].v2
-                        };
-                        for (size_t k = 0; k < 3; ++k)
-                        {
-                            const size_t v = vertices[k]->v;
-                            float* pf = reinterpret_cast<float*>(p);
-                            pf[0] = v ? mesh.v[v - 1][0] : 0.F;
-                            pf[1] = v ? mesh.v[v - 1][1] : 0.F;
-                            pf[2] = v ? mesh.v[v - 1][2] : 0.F;
-                            p += 3 * sizeof(float);
-
-                            const size_t t = vertices[k]->t;
-                            uint16_t* pu16 = reinterpret_cast<uint16_t*>(p);
-                            pu16[0] = t ? Math::clamp(static_cast<int>(mesh.t[t - 1][0] * 65535.F), 0, 65535) : 0;
-                            pu16[1] = t ? Math::clamp(static_cast<int>(mesh.t[t - 1][1] * 65535.F), 0, 65535) : 0;
-                            p += 2 * sizeof(uint16_t);
-
-                            const size_t n = vertices[k]->n;
-                            auto packedNormal = reinterpret_cast<PackedNormal*>(p);
-                            packedNormal->x = n ? Math::clamp(static_cast<int>(mesh.n[n - 1][0] * 511.F), -512, 511) : 0;
-                            packedNormal->y = n ? Math::clamp(static_cast<int>(mesh.n[n - 1][1] * 511.F), -512, 511) : 0;
-                            packedNormal->z = n ? Math::clamp(static_cast<int>(mesh.n[n - 1][2] * 511.F), -512, 511) : 0;
-                            p += sizeof(PackedNormal);
-                        }
-                    }
-                    break;
-                case VBOType::Pos3_F32_UV_U16_Normal_U10_Color_U8:
-                    for (size_t i = range.min; i <= range.max; ++i)
-                    {
-                        const Geom::TriangleMesh::Vertex* vertices[] =
-                        {
-                            &mesh.triangles[i].v0,
-                            &mesh.triangles[i].v1,
-                            &mesh.triangles[i].v2
-                        };
-                        for (size_t k = 0; k < 3; ++k)
-                        {
-                            const size_t v = vertices[k]->v;
-                            float* pf = reinterpret_cast<float*>(p);
-                            pf[0] = v ? mesh.v[v - 1][0] : 0.F;
-                            pf[1] = v ? mesh.v[v - 1][1] : 0.F;
-                            pf[2] = v ? mesh.v[v - 1][2] : 0.F;
-                            p += 3 * sizeof(float);
-
-                            const size_t t = vertices[k]->t;
-                            uint16_t* pu16 = reinterpret_cast<uint16_t*>(p);
-                            pu16[0] = t ? Math::clamp(static_cast<int>(mesh.t[t - 1][0] * 65535.F), 0, 65535) : 0;
-                            pu16[1] = t ? Math::clamp(static_cast<int>(mesh.t[t - 1][1] * 65535.F), 0, 65535) : 0;
-                            p += 2 * sizeof(uint16_t);
-
-                            const size_t n = vertices[k]->n;
-                            auto packedNormal = reinterpret_cast<PackedNormal*>(p);
-                            packedNormal->x = n ? Math::clamp(static_cast<int>(mesh.n[n - 1][0] * 511.F), -512, 511) : 0;
-                            packedNormal->y = n ? Math::clamp(static_cast<int>(mesh.n[n - 1][1] * 511.F), -512, 511) : 0;
-                            packedNormal->z = n ? Math::clamp(static_cast<int>(mesh.n[n - 1][2] * 511.F), -512, 511) : 0;
-                            p += sizeof(PackedNormal);
+                    const auto& triangle = mesh.triangles[i];
+                    p = packVertex(mesh, triangle.v0, type, p);
+                    p = packVertex(mesh, triangle.v1, type, p);
+                    p = packVertex(mesh, triangle.v2, type, p);
+                }
+                return out;
+            }
 
-                            auto packedColor = reinterpret_cast<PackedColor*>(p);
-                            packedColor->r = v ? Math::clamp(static_cast<int>(mesh.c[v - 1][0] * 255.F), 0, 255) : 0;
-                            packedColor->g = v ? Math::clamp(static_cast<int>(mesh.c[v - 1][1] * 255.F), 0, 255) : 0;
-                            packedColor->b = v ? Math::clamp(static_cast<int>(mesh.c[v - 1][2] * 255.F), 0, 255) : 0;
-                            packedColor->a = 255;
-                            p += sizeof(PackedColor);
-                        }
-                    }
-                    break;
-                case VBOType::Pos3_F32_UV_F32_Normal_F32_Color_F32:
-                    for (size_t i = range.min; i <= range.max; ++i)
-                    {
-                        const Geom::TriangleMesh::Vertex* vertices[] =
-                        {
-                            &mesh.triangles[i].v0,
-                            &mesh.triangles[i].v1,
-                            &mesh.triangles[i].v2
-                        };
-                        for (size_t k = 0; k < 3; ++k)
-                        {
-                            const size_t v = vertices[k]->v;
-                            float* pf = reinterpret_cast<float*>(p);
-                            pf[0] = v ? mesh.v[v - 1][0] : 0.F;
-                            pf[1] = v ? mesh.v[v - 1][1] : 0.F;
-                            pf[2] = v ? mesh.v[v - 1][2] : 0.F;
-                            p += 3 * sizeof(float);
-
-                            const size_t t = vertices[k]->t;
-                            pf = reinterpret_cast<float*>(p);
-                            pf[0] = t ? mesh.t[t - 1][0] : 0.F;
-                            pf[1] = t ? mesh.t[t - 1][1] : 0.F;
-                            p += 2 * sizeof(float);
-
-                            const size_t n = vertices[k]->n;
-                            pf = reinterpret_cast<float*>(p);
-                            pf[0] = n ? mesh.n[n - 1][0] : 0.F;
-                            pf[1] = n ? mesh.n[n - 1][1] : 0.F;
-                            pf[2] = n ? mesh.n[n - 1][2] : 0.F;
-                            p += 3 * sizeof(float);
-
-                            pf = reinterpret_cast<float*>(p);
-                            pf[0] = v ? mesh.c[v - 1][0] : 1.F;
-                            pf[1] = v ? mesh.c[v - 1][1] : 1.F;
-                            pf[2] = v ? mesh.c[v - 1][2] : 1.F;
-                            p += 3 * sizeof(float);
-                        }
-                    }
-                    break;
-                    default: break;
+            std::vector<uint8_t> VBO::convert(const Geom::TriangleMesh& mesh, const std::vector<Geom::TriangleMesh::Vertex>& vertices, VBOType type)
+            {
+                std::vector<uint8_t> out(vertices.size() * getVertexByteCount(type));
+                uint8_t* p = out.data();
+                for (const auto& i : vertices)
+                {
+                    p = packVertex(mesh, i, type, p);
+                }
+                return out;
+            }
+
+            void EBO::_init(size_t size)
+            {
+                _size = size;
+                glGenBuffers(1, &_ebo);
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizei>(_size * sizeof(uint32_t)), NULL, GL_DYNAMIC_DRAW);
+            }
+
+            EBO::~EBO()
+            {
+                if (_ebo)
+                {
+                    glDeleteBuffers(1, &_ebo);
+                    _ebo = 0;
                 }
+            }
+
+            std::shared_ptr<EBO> EBO::create(size_t size)
+            {
+                auto out = std::shared_ptr<EBO>(new EBO);
+                out->_init(size);
                 return out;
             }
 
-            void VAO::_init(VBOType type, GLuint vbo)
+            void EBO::copy(const std::vector<uint32_t>& data)
+            {
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+                glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, static_cast<GLsizei>(data.size() * sizeof(uint32_t)), (void*)data.data());
+            }
+
+            void EBO::copy(const std::vector<uint32_t>& data, size_t offset)
+            {
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+                glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(uint32_t), static_cast<GLsizei>(data.size() * sizeof(uint32_t)), (void*)data.data());
+            }
+
+            void VAO::_init(VBOType type, GLuint vbo, GLuint ebo)
             {
 #if defined(DJV_OPENGL_ES2)
                 glGenVertexArraysOES(1, &_vao);
@@ -263,6 +261,11 @@ namespace djv
                 glBindVertexArray(_vao);
 #endif // DJV_OPENGL_ES2
                 glBindBuffer(GL_ARRAY_BUFFER, vbo);
+                if (ebo)
+                {
+                    // The element buffer binding is part of the VAO state.
+                    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+                }
                 const size_t vertexByteCount = getVertexByteCount(type);
                 switch (type)
                 {
@@ -333,7 +336,14 @@ namespace djv
             std::shared_ptr<VAO> VAO::create(VBOType type, GLuint vbo)
             {
                 auto out = std::shared_ptr<VAO>(new VAO);
-                out->_init(type, vbo);
+                out->_init(type, vbo, 0);
+                return out;
+            }
+
+            std::shared_ptr<VAO> VAO::create(VBOType type, GLuint vbo, GLuint ebo)
+            {
+                auto out = std::shared_ptr<VAO>(new VAO);
+                out->_init(type, vbo, ebo);
                 return out;
             }
 
@@ -351,6 +361,15 @@ namespace djv
                 glDrawArrays(mode, static_cast<GLsizei>(offset), static_cast<GLsizei>(size));
             }
 
+            void VAO::drawElements(GLenum mode, size_t offset, size_t size)
+            {
+                glDrawElements(
+                    mode,
+                    static_cast<GLsizei>(size),
+                    GL_UNSIGNED_INT,
+                    reinterpret_cast<const GLvoid*>(offset * sizeof(uint32_t)));
+            }
+
         } // namespace OpenGL
     } // namespace AV
 
@@ -61,29 +61,66 @@ namespace djv
                 static std::vector<uint8_t> convert(const Geom::TriangleMesh&, VBOType);
                 static std::vector<uint8_t> convert(const Geom::TriangleMesh &, VBOType, const Core::SizeTRange &);
 
+                //! Convert the welded vertices of a mesh for indexed drawing.
+                //! \sa Geom::TriangleMesh::weld()
+                static std::vector<uint8_t> convert(
+                    const Geom::TriangleMesh &,
+                    const std::vector<Geom::TriangleMesh::Vertex> &,
+                    VBOType);
+
             private:
                 size_t _size = 0;
                 VBOType _type = VBOType::First;
                 GLuint _vbo = 0;
             };
 
+            //! This class provides an OpenGL element buffer object with 32-bit
+            //! indices.
+            class EBO
+            {
+                DJV_NON_COPYABLE(EBO);
+                void _init(size_t size);
+                EBO();
+
+            public:
+                ~EBO();
+
+                //! Create a new element buffer with the given number of indices.
+                static std::shared_ptr<EBO> create(size_t size);
+
+                size_t getSize() const;
+                GLuint getID() const;
+
+                void copy(const std::vector<uint32_t>&);
+                void copy(const std::vector<uint32_t>&, size_t offset);
+
+            private:
+                size_t _size = 0;
+                GLuint _ebo = 0;
+            };
+
             //! This class provides an OpenGL vertex array object.
             class VAO
             {
                 DJV_NON_COPYABLE(VAO);
-                void _init(VBOType, GLuint vbo);
+                void _init(VBOType, GLuint vbo, GLuint ebo);
                 VAO();
 
             public:
                 ~VAO();
 
                 static std::shared_ptr<VAO> create(VBOType, GLuint vbo);
+                static std::shared_ptr<VAO> create(VBOType, GLuint vbo, GLuint ebo);
 
                 GLuint getID() const;
 
                 void bind();
                 void draw(GLenum mode, size_t offset, size_t size);
 
+                //! Draw with the element buffer, the offset and size are in
+                //! indices.
+                void drawElements(GLenum mode, size_t offset, size_t size);
+
             private:
                 GLuint _vao = 0;
             };
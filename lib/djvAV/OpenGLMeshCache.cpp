@@ -18,29 +18,91 @@ namespace djv
             {
                 uint64_t _timestamp = 0;
 
+                bool findRange(std::set<SizeTRange>& empty, size_t size, SizeTRange& out)
+                {
+                    for (auto i = empty.begin(); i != empty.end(); ++i)
+                    {
+                        const size_t emptySize = i->max - i->min + 1;
+                        if (size == emptySize)
+                        {
+                            out = *i;
+                            empty.erase(i);
+                            return true;
+                        }
+                        else if (size < emptySize)
+                        {
+                            out.min = i->min;
+                            out.max = i->min + size - 1;
+                            const SizeTRange remaining(out.max + 1, i->max);
+                            empty.erase(i);
+                            empty.insert(remaining);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                void freeRange(std::set<SizeTRange>& empty, const SizeTRange& range)
+                {
+                    // Merge the range with any adjacent empty ranges.
+                    SizeTRange newRange = range;
+                    auto i = empty.begin();
+                    while (i != empty.end())
+                    {
+                        if (i->max + 1 == newRange.min || newRange.max + 1 == i->min)
+                        {
+                            newRange.expand(*i);
+                            i = empty.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                    empty.insert(newRange);
+                }
+
             } // namespace
 
             struct MeshCache::Private
             {
                 size_t vboSize = 0;
+                size_t eboSize = 0;
                 VBOType vboType = VBOType::Pos3_F32_UV_U16_Normal_U10;
                 std::shared_ptr<VBO> vbo;
+                std::shared_ptr<EBO> ebo;
                 std::shared_ptr<VAO> vao;
-                std::map<SizeTRange, UID> ranges;
-                std::map<UID, SizeTRange> uids;
-                std::set<SizeTRange> empty;
+                std::map<UID, SizeTRange> vboRanges;
+                std::map<UID, SizeTRange> eboRanges;
+                std::set<SizeTRange> vboEmpty;
+                std::set<SizeTRange> eboEmpty;
                 std::map<uint64_t, UID> timestamps;
+                std::map<UID, uint64_t> uidTimestamps;
+
+                void touch(UID);
+                UID add(const SizeTRange& vboRange, const SizeTRange* eboRange);
+                bool evict();
             };
 
-            MeshCache::MeshCache(size_t vboSize, VBOType vboType) :
+            MeshCache::MeshCache(size_t vboSize, VBOType vboType, size_t eboSize) :
                 _p(new Private)
             {
                 DJV_PRIVATE_PTR();
                 p.vboSize = vboSize;
+                p.eboSize = eboSize;
                 p.vboType = vboType;
                 p.vbo = VBO::create(vboSize, vboType);
-                p.vao = VAO::create(p.vbo->getType(), p.vbo->getID());
-                p.empty.insert(SizeTRange(0, p.vboSize));
+                p.vboEmpty.insert(SizeTRange(0, p.vboSize - 1));
+                if (eboSize > 0)
+                {
+                    p.ebo = EBO::create(eboSize);
+                    p.eboEmpty.insert(SizeTRange(0, p.eboSize - 1));
+                    p.vao = VAO::create(p.vbo->getType(), p.vbo->getID(), p.ebo->getID());
+                }
+                else
+                {
+                    p.vao = VAO::create(p.vbo->getType(), p.vbo->getID());
+                }
             }
 
             MeshCache::~MeshCache()
@@ -51,6 +113,11 @@ namespace djv
                 return _p->vboSize;
             }
 
+            size_t MeshCache::getEBOSize() const
+            {
+                return _p->eboSize;
+            }
+
             VBOType MeshCache::getVBOType() const
             {
                 return _p->vboType;
@@ -61,6 +128,11 @@ namespace djv
                 return _p->vbo;
             }
 
+            const std::shared_ptr<EBO>& MeshCache::getEBO() const
+            {
+                return _p->ebo;
+            }
+
             const std::shared_ptr<VAO>& MeshCache::getVAO() const
             {
                 return _p->vao;
@@ -69,80 +141,80 @@ namespace djv
             bool MeshCache::getItem(UID uid, SizeTRange& out)
             {
                 DJV_PRIVATE_PTR();
-                const auto i = p.uids.find(uid);
-                if (i != p.uids.end())
+                const auto i = p.vboRanges.find(uid);
+                if (i != p.vboRanges.end())
                 {
-                    const auto j = p.timestamps.find(uid);
-                    if (j != p.timestamps.end())
-                    {
-                        j->second = ++_timestamp;
-                    }
+                    p.touch(uid);
                     out = i->second;
                     return true;
                 }
                 return false;
             }
 
-            UID MeshCache::addItem(const std::vector<uint8_t>& data, SizeTRange& out)
+            bool MeshCache::getItem(UID uid, SizeTRange& vboRange, SizeTRange& eboRange)
             {
                 DJV_PRIVATE_PTR();
+                const auto i = p.vboRanges.find(uid);
+                const auto j = p.eboRanges.find(uid);
+                if (i != p.vboRanges.end() && j != p.eboRanges.end())
+                {
+                    p.touch(uid);
+                    vboRange = i->second;
+                    eboRange = j->second;
+                    return true;
+                }
+                return false;
+            }
 
+            UID MeshCache::addItem(const std::vector<uint8_t>& data, SizeTRange& out)
+            {
+                DJV_PRIVATE_PTR();
                 const size_t vertexByteCount = getVertexByteCount(p.vboType);
                 const size_t dataSize = data.size() / vertexByteCount;
-                if (_find(dataSize, out))
+                if (dataSize > 0)
                 {
-                    const UID uid = createUID();
-                    p.ranges[out] = uid;
-                    p.uids[uid] = out;
-                    ++_timestamp;
-                    p.timestamps[_timestamp] = uid;
-                    p.vbo->copy(data, out.min * vertexByteCount);
-                    return uid;
+                    do
+                    {
+                        if (findRange(p.vboEmpty, dataSize, out))
+                        {
+                            p.vbo->copy(data, out.min * vertexByteCount);
+                            return p.add(out, nullptr);
+                        }
+                    } while (p.evict());
                 }
+                return 0;
+            }
 
-                auto i = p.timestamps.begin();
-                while (i != p.timestamps.end())
+            UID MeshCache::addItem(
+                const std::vector<uint8_t>& data,
+                const std::vector<uint32_t>& indices,
+                SizeTRange& vboRange,
+                SizeTRange& eboRange)
+            {
+                DJV_PRIVATE_PTR();
+                const size_t vertexByteCount = getVertexByteCount(p.vboType);
+                const size_t dataSize = data.size() / vertexByteCount;
+                if (p.ebo && dataSize > 0 && indices.size() > 0)
                 {
-                    const auto j = p.uids.find(i->second);
-                    if (j != p.uids.end())
+                    do
                     {
-                        const auto k = p.ranges.find(j->second);
-                        if (k != p.ranges.end())
+                        if (findRange(p.vboEmpty, dataSize, vboRange))
                         {
-                            bool intersects = false;
-                            for (auto l = p.empty.begin(); l != p.empty.end(); ++l)
+                            if (findRange(p.eboEmpty, indices.size(), eboRange))
                             {
-                                if (k->first.intersects(*l))
+                                p.vbo->copy(data, vboRange.min * vertexByteCount);
+                                std::vector<uint32_t> offsetIndices(indices.size());
+                                for (size_t i = 0; i < indices.size(); ++i)
                                 {
-                                    intersects = true;
-                                    SizeTRange newRange = k->first;
-                                    newRange.expand(*l);
-                                    p.empty.erase(l);
-                                    p.empty.insert(newRange);
+                                    offsetIndices[i] = indices[i] + static_cast<uint32_t>(vboRange.min);
                                 }
+                                p.ebo->copy(offsetIndices, eboRange.min);
+                                return p.add(vboRange, &eboRange);
                             }
-                            if (!intersects)
-                            {
-                                p.empty.insert(k->first);
-                            }
-                            p.ranges.erase(k);
+                            freeRange(p.vboEmpty, vboRange);
                         }
-                        p.uids.erase(j);
-                    }
-                    i = p.timestamps.erase(i);
-
-                    if (_find(dataSize, out))
-                    {
-                        const UID uid = createUID();
-                        p.ranges[out] = uid;
-                        p.uids[uid] = out;
-                        ++_timestamp;
-                        p.timestamps[_timestamp] = uid;
-                        p.vbo->copy(data, out.min * vertexByteCount);
-                        return uid;
-                    }
+                    } while (p.evict());
                 }
-
                 return 0;
             }
 
@@ -150,36 +222,62 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 size_t used = 0;
-                for (const auto& i : p.ranges)
+                for (const auto& i : p.vboRanges)
                 {
-                    used += i.first.max - i.first.min + 1;
+                    used += i.second.max - i.second.min + 1;
                 }
                 return used / static_cast<float>(p.vboSize) * 100.F;
             }
 
-            bool MeshCache::_find(size_t size, SizeTRange& out)
+            void MeshCache::Private::touch(UID uid)
             {
-                DJV_PRIVATE_PTR();
-                for (auto i = p.empty.begin(); i != p.empty.end(); ++i)
+                const auto i = uidTimestamps.find(uid);
+                if (i != uidTimestamps.end())
                 {
-                    const size_t emptySize = i->max - i->min + 1;
-                    if (size == emptySize)
-                    {
-                        out = *i;
-                        p.empty.erase(i);
-                        return true;
-                    }
-                    else if (size < emptySize)
-                    {
-                        out.min = i->min;
-                        out.max = i->min + size - 1;
-                        SizeTRange empty(out.max + 1, i->max);
-                        p.empty.erase(i);
-                        p.empty.insert(empty);
-                        return true;
-                    }
+                    timestamps.erase(i->second);
+                    i->second = ++_timestamp;
+                    timestamps[i->second] = uid;
                 }
-                return false;
+            }
+
+            UID MeshCache::Private::add(const SizeTRange& vboRange, const SizeTRange* eboRange)
+            {
+                const UID uid = createUID();
+                vboRanges[uid] = vboRange;
+                if (eboRange)
+                {
+                    eboRanges[uid] = *eboRange;
+                }
+                ++_timestamp;
+                timestamps[_timestamp] = uid;
+                uidTimestamps[uid] = _timestamp;
+                return uid;
+            }
+
+            bool MeshCache::Private::evict()
+            {
+                // Remove the least recently used item.
+                const auto i = timestamps.begin();
+                if (i == timestamps.end())
+                {
+                    return false;
+                }
+                const UID uid = i->second;
+                const auto j = vboRanges.find(uid);
+                if (j != vboRanges.end())
+                {
+                    freeRange(vboEmpty, j->second);
+                    vboRanges.erase(j);
+                }
+                const auto k = eboRanges.find(uid);
+                if (k != eboRanges.end())
+                {
+                    freeRange(eboEmpty, k->second);
+                    eboRanges.erase(k);
+                }
+                uidTimestamps.erase(uid);
+                timestamps.erase(i);
+                return true;
             }
 
         } // namespace OpenGL
@@ -14,32 +14,41 @@ namespace djv
         namespace OpenGL
         {
             class VBO;
+            class EBO;
             class VAO;
 
-            //! This class provides a mesh cache.
+            //! This class provides a mesh cache. If the element buffer size is
+            //! non-zero the cache also stores indices for indexed drawing.
             class MeshCache
             {
                 DJV_NON_COPYABLE(MeshCache);
 
             public:
-                MeshCache(size_t vboSize, OpenGL::VBOType);
+                MeshCache(size_t vboSize, OpenGL::VBOType, size_t eboSize = 0);
                 ~MeshCache();
 
                 size_t getVBOSize() const;
+                size_t getEBOSize() const;
                 OpenGL::VBOType getVBOType() const;
                 const std::shared_ptr<OpenGL::VBO>& getVBO() const;
+                const std::shared_ptr<OpenGL::EBO>& getEBO() const;
                 const std::shared_ptr<OpenGL::VAO>& getVAO() const;
 
                 bool getItem(Core::UID, Core::SizeTRange&);
+                bool getItem(Core::UID, Core::SizeTRange& vboRange, Core::SizeTRange& eboRange);
                 Core::UID addItem(const std::vector<uint8_t>&, Core::SizeTRange&);
 
+                //! Add an indexed item. The indices are relative to the start
+                //! of the vertex data.
+                Core::UID addItem(
+                    const std::vector<uint8_t>&,
+                    const std::vector<uint32_t>& indices,
+                    Core::SizeTRange& vboRange,
+                    Core::SizeTRange& eboRange);
+
                 float getPercentageUsed() const;
 
             private:
-                class BoxPackingNode;
-
-                bool _find(size_t, Core::SizeTRange&);
-
                 DJV_PRIVATE();
             };
 
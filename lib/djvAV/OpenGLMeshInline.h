@@ -40,6 +40,19 @@ namespace djv
                 return _vbo;
             }
 
+            inline EBO::EBO()
+            {}
+
+            inline size_t EBO::getSize() const
+            {
+                return _size;
+            }
+
+            inline GLuint EBO::getID() const
+            {
+                return _ebo;
+            }
+
             inline VAO::VAO()
             {}
 
@@ -6,7 +6,7 @@
 
 #include <djvAV/OpenGLTexture.h>
 
-#include <djvCore/BBox.h>
+#include <algorithm>
 
 using namespace djv::Core;
 
@@ -18,104 +18,21 @@ namespace djv
         {
             namespace
             {
-                uint64_t _timestamp = 0;
-
-            } // namespace
-
-            //! This class provides the nodes used for box packing.
-            //!
-            //! References:
-            //! - http://blackpawn.com/texts/lightmaps/
-            class TextureAtlas::BoxPackingNode : public std::enable_shared_from_this< TextureAtlas::BoxPackingNode>
-            {
-            private:
-                explicit BoxPackingNode(int border);
-
-            public:
-                static std::shared_ptr<BoxPackingNode> create(int border);
-
-                UID uid = 0;
-                uint64_t timestamp = 0;
-
-                BBox2i bbox;
-                uint8_t border = 0;
-                uint8_t textureIndex = 0;
-                std::shared_ptr<BoxPackingNode> children[2];
-
-                bool isBranch() const { return children[0].get(); }
-                bool isOccupied() const { return uid != 0; }
-
-                std::shared_ptr<BoxPackingNode> insert(const std::shared_ptr<Image::Data> &);
-            };
-
-            TextureAtlas::BoxPackingNode::BoxPackingNode(int border) :
-                timestamp(++_timestamp),
-                border(border)
-            {}
-
-            std::shared_ptr<TextureAtlas::BoxPackingNode> TextureAtlas::BoxPackingNode::create(int border)
-            {
-                auto out = std::shared_ptr<BoxPackingNode>(new BoxPackingNode(border));
-                return out;
-            }
-
-            std::shared_ptr<TextureAtlas::BoxPackingNode> TextureAtlas::BoxPackingNode::insert(const std::shared_ptr<Image::Data> & data)
-            {
-                if (isBranch())
-                {
-                    if (auto node = children[0]->insert(data))
-                    {
-                        return node;
-                    }
-                    return children[1]->insert(data);
-                }
-                else if (isOccupied())
+                struct Upload
                 {
-                    return nullptr;
-                }
-                else
+                    Image::AtlasPackerItem item;
+                    std::shared_ptr<Image::Data> data;
+                };
+
+                bool isBatchCompatible(const Image::Info& a, const Image::Info& b)
                 {
-                    const glm::ivec2 & dataSize = glm::ivec2(data->getWidth(), data->getHeight()) + border * 2;
-                    const glm::ivec2 & bboxSize = bbox.getSize();
-                    if (dataSize.x > bboxSize.x || dataSize.y > bboxSize.y)
-                    {
-                        return nullptr;
-                    }
-                    if (dataSize == bboxSize)
-                    {
-                        return shared_from_this();
-                    }
-                    children[0] = create(border);
-                    children[1] = create(border);
-                    const int dw = bboxSize.x - dataSize.x;
-                    const int dh = bboxSize.y - dataSize.y;
-                    if (dw > dh)
-                    {
-                        children[0]->bbox.min.x = bbox.min.x;
-                        children[0]->bbox.min.y = bbox.min.y;
-                        children[0]->bbox.max.x = bbox.min.x + dataSize.x - 1;
-                        children[0]->bbox.max.y = bbox.max.y;
-                        children[1]->bbox.min.x = bbox.min.x + dataSize.x;
-                        children[1]->bbox.min.y = bbox.min.y;
-                        children[1]->bbox.max.x = bbox.max.x;
-                        children[1]->bbox.max.y = bbox.max.y;
-                    }
-                    else
-                    {
-                        children[0]->bbox.min.x = bbox.min.x;
-                        children[0]->bbox.min.y = bbox.min.y;
-                        children[0]->bbox.max.x = bbox.max.x;
-                        children[0]->bbox.max.y = bbox.min.y + dataSize.y - 1;
-                        children[1]->bbox.min.x = bbox.min.x;
-                        children[1]->bbox.min.y = bbox.min.y + dataSize.y;
-                        children[1]->bbox.max.x = bbox.max.x;
-                        children[1]->bbox.max.y = bbox.max.y;
-                    }
-                    children[0]->textureIndex = textureIndex;
-                    children[1]->textureIndex = textureIndex;
-                    return children[0]->insert(data);
+                    return
+                        a.type == b.type &&
+                        a.layout.alignment == b.layout.alignment &&
+                        a.layout.endian == b.layout.endian;
                 }
-            }
+
+            } // namespace
 
             struct TextureAtlas::Private
             {
@@ -124,8 +41,9 @@ namespace djv
                 Image::Type textureType = Image::Type::None;
                 uint8_t border = 0;
                 std::vector<std::shared_ptr<Texture> > textures;
-                std::vector<std::shared_ptr<BoxPackingNode> > boxPackingNodes;
-                std::map<UID, std::shared_ptr<BoxPackingNode> > cache;
+                std::unique_ptr<Image::AtlasPacker> packer;
+                std::map<UID, Upload> uploads;
+                size_t uploadCount = 0;
             };
 
             TextureAtlas::TextureAtlas(uint8_t textureCount, uint16_t textureSize, Image::Type textureType, GLenum filter, uint8_t border) :
@@ -135,20 +53,15 @@ namespace djv
                 p.textureCount = textureCount;
                 p.textureSize = textureSize;
                 p.textureType = textureType;
+                p.border = border;
 
                 for (uint8_t i = 0; i < p.textureCount; ++i)
                 {
                     auto texture = Texture::create(Image::Info(textureSize, textureSize, textureType), filter, filter);
                     p.textures.push_back(std::move(texture));
-
-                    auto node = BoxPackingNode::create(border);
-                    node->bbox.min.x = 0;
-                    node->bbox.min.y = 0;
-                    node->bbox.max.x = textureSize - 1;
-                    node->bbox.max.y = textureSize - 1;
-                    node->textureIndex = i;
-                    p.boxPackingNodes.push_back(node);
                 }
+
+                p.packer.reset(new Image::AtlasPacker(textureCount, textureSize, border));
             }
 
             TextureAtlas::~TextureAtlas()
@@ -183,10 +96,10 @@ namespace djv
             bool TextureAtlas::getItem(UID uid, TextureAtlasItem & out)
             {
                 DJV_PRIVATE_PTR();
-                const auto & i = p.cache.find(uid);
-                if (i != p.cache.end())
+                Image::AtlasPackerItem item;
+                if (p.packer->getItem(uid, item))
                 {
-                    _toTextureAtlasItem(i->second, out);
+                    _toTextureAtlasItem(item, out);
                     return true;
                 }
                 return false;
@@ -195,151 +108,144 @@ namespace djv
             UID TextureAtlas::addItem(const std::shared_ptr<Image::Data> & data, TextureAtlasItem & out)
             {
                 DJV_PRIVATE_PTR();
+                Image::AtlasPackerItem item;
+                const UID uid = p.packer->addItem(data->getWidth(), data->getHeight(), item);
+                if (uid)
+                {
+                    Upload upload;
+                    upload.item = item;
+                    upload.data = data;
+                    p.uploads[uid] = upload;
+                    _toTextureAtlasItem(item, out);
+                }
+                return uid;
+            }
 
-                static UID _uid = 0;
+            void TextureAtlas::flush()
+            {
+                DJV_PRIVATE_PTR();
 
-                for (uint8_t i = 0; i < p.textureCount; ++i)
+                // Discard items that were evicted before they were uploaded.
+                std::vector<Upload> uploads;
+                for (const auto& i : p.uploads)
                 {
-                    if (auto node = p.boxPackingNodes[i]->insert(data))
+                    if (p.packer->hasItem(i.first))
                     {
-                        // The data has been added to the atlas.
-                        node->uid = ++_uid;
-                        p.textures[node->textureIndex]->copy(*data, node->bbox.min.x + p.border, node->bbox.min.y + p.border);
-                        p.cache[node->uid] = node;
-                        _toTextureAtlasItem(node, out);
-                        return node->uid;
+                        uploads.push_back(i.second);
                     }
                 }
-
-                // The atlas is full, over-write older data.
-                std::vector<std::shared_ptr<BoxPackingNode> > nodes;
-                for (uint8_t i = 0; i < p.textureCount; ++i)
-                {
-                    _getAllNodes(p.boxPackingNodes[i], nodes);
-                }
-                std::sort(nodes.begin(), nodes.end(),
-                    [](const std::shared_ptr<BoxPackingNode>& a, const std::shared_ptr<BoxPackingNode>& b)
-                {
-                    return a->timestamp < b->timestamp;
-                });
-                const glm::ivec2 dataSize = glm::ivec2(data->getWidth(), data->getHeight()) + p.border * 2;
-                for (auto node : nodes)
-                {
-                    const glm::ivec2 nodeSize = node->bbox.getSize();
-                    if (dataSize.x <= nodeSize.x && dataSize.y <= nodeSize.y)
+                p.uploads.clear();
+                std::sort(
+                    uploads.begin(),
+                    uploads.end(),
+                    [](const Upload& a, const Upload& b)
                     {
-                        auto old = node;
-                        _removeFromAtlas(old);
-                        if (old->isBranch())
+                        return
+                            a.item.page < b.item.page ||
+                            (a.item.page == b.item.page && a.item.bbox.min.y < b.item.bbox.min.y) ||
+                            (a.item.page == b.item.page && a.item.bbox.min.y == b.item.bbox.min.y && a.item.bbox.min.x < b.item.bbox.min.x);
+                    });
+
+                p.uploadCount = 0;
+                size_t i = 0;
+                while (i < uploads.size())
+                {
+                    // Find the run of items on the same shelf that are separated
+                    // only by free space.
+                    const auto& first = uploads[i];
+                    const auto& info = first.data->getInfo();
+                    BBox2i bbox = first.item.bbox;
+                    size_t j = i + 1;
+                    for (; j < uploads.size(); ++j)
+                    {
+                        const auto& next = uploads[j];
+                        if (next.item.page != first.item.page ||
+                            next.item.bbox.min.y != first.item.bbox.min.y ||
+                            !isBatchCompatible(next.data->getInfo(), info))
                         {
-                            for (uint8_t i = 0; i < 2; ++i)
-                            {
-                                old->children[i].reset();
-                            }
+                            break;
                         }
-                        old->uid = 0;
-                        old->timestamp = ++_timestamp;
-                        if (auto node2 = old->insert(data))
+                        const int gap = next.item.bbox.min.x - bbox.max.x - 1;
+                        if (gap > 0 && !p.packer->isFree(first.item.page, BBox2i(bbox.max.x + 1, bbox.min.y, gap, 1)))
                         {
-                            node2->uid = ++_uid;
-
-                            //! \todo Do we need to zero out the old data?
-                            //auto zero = Image::Data::create(Image::Info(data->getSize() + p.border * 2, p.textureType));
-                            //zero->zero();
-                            //p.textures[node2->texture]->copy(zero, node2->bbox.min);
-
-                            p.textures[node2->textureIndex]->copy(
-                                *data,
-                                static_cast<uint16_t>(node2->bbox.min.x + p.border),
-                                static_cast<uint16_t>(node2->bbox.min.y + p.border));
-                            p.cache[node2->uid] = node2;
-                            _toTextureAtlasItem(node2, out);
-
-                            return node2->uid;
+                            break;
                         }
+                        bbox.expand(next.item.bbox);
                     }
-                }
-                return 0;
-            }
 
-            float TextureAtlas::getPercentageUsed() const
-            {
-                DJV_PRIVATE_PTR();
-                float out = 0.F;
-                for (uint8_t i = 0; i < p.textureCount; ++i)
-                {
-                    size_t used = 0;
-                    std::vector<std::shared_ptr<BoxPackingNode> > leafs;
-                    _getLeafNodes(p.boxPackingNodes[i], leafs);
-                    for (const auto & j : leafs)
+                    // Single items without a border are copied directly, otherwise
+                    // the border needs to be cleared so filtering does not sample
+                    // the previous contents of the texture.
+                    auto& texture = p.textures[first.item.page];
+                    if (1 == j - i && 0 == p.border)
+                    {
+                        texture->copy(
+                            *first.data,
+                            static_cast<uint16_t>(bbox.min.x + p.border),
+                            static_cast<uint16_t>(bbox.min.y + p.border));
+                    }
+                    else
                     {
-                        if (j->isOccupied())
+                        // The staging buffer is zeroed so the borders and the
+                        // space between the items are cleared.
+                        auto staging = Image::Data::create(Image::Info(
+                            bbox.w(),
+                            bbox.h(),
+                            info.type,
+                            Image::Layout(Image::Mirror(), info.layout.alignment, info.layout.endian)));
+                        staging->zero();
+                        for (size_t k = i; k < j; ++k)
                         {
-                            used += j->bbox.getArea();
+                            const auto& data = uploads[k].data;
+                            const uint16_t x = uploads[k].item.bbox.min.x - bbox.min.x + p.border;
+                            const size_t byteCount = static_cast<size_t>(data->getWidth()) * data->getPixelByteCount();
+                            for (uint16_t y = 0; y < data->getHeight(); ++y)
+                            {
+                                memcpy(staging->getData(x, y + p.border), data->getData(y), byteCount);
+                            }
                         }
+                        texture->copy(
+                            *staging,
+                            static_cast<uint16_t>(bbox.min.x),
+                            static_cast<uint16_t>(bbox.min.y));
                     }
-                    out += used;
+                    ++p.uploadCount;
+                    i = j;
                 }
-                return out / static_cast<float>(p.textureSize * p.textureSize) / static_cast<float>(p.textureCount) * 100.F;
             }
 
-            void TextureAtlas::_getAllNodes(
-                const std::shared_ptr<BoxPackingNode>& node,
-                std::vector<std::shared_ptr<BoxPackingNode> > & out)
+            float TextureAtlas::getPercentageUsed() const
             {
-                out.push_back(node);
-                if (node->isBranch())
-                {
-                    _getAllNodes(node->children[0], out);
-                    _getAllNodes(node->children[1], out);
-                }
+                return _p->packer->getPercentageUsed();
             }
 
-            void TextureAtlas::_getLeafNodes(
-                const std::shared_ptr<BoxPackingNode>& node,
-                std::vector<std::shared_ptr<BoxPackingNode> > & out) const
+            float TextureAtlas::getFragmentation() const
             {
-                if (node->isBranch())
-                {
-                    _getLeafNodes(node->children[0], out);
-                    _getLeafNodes(node->children[1], out);
-                }
-                else
-                {
-                    out.push_back(node);
-                }
+                return _p->packer->getFragmentation();
             }
 
-            void TextureAtlas::_toTextureAtlasItem(
-                const std::shared_ptr<BoxPackingNode>& node,
-                TextureAtlasItem & out)
+            size_t TextureAtlas::getEvictionCount() const
             {
-                DJV_PRIVATE_PTR();
-                out.w = node->bbox.w();
-                out.h = node->bbox.h();
-                out.textureIndex = node->textureIndex;
-                out.textureU = FloatRange(
-                    (node->bbox.min.x + p.border)     / static_cast<float>(p.textureSize),
-                    (node->bbox.max.x - p.border + 1) / static_cast<float>(p.textureSize));
-                out.textureV = FloatRange(
-                    (node->bbox.min.y + p.border)     / static_cast<float>(p.textureSize),
-                    (node->bbox.max.y - p.border + 1) / static_cast<float>(p.textureSize));
+                return _p->packer->getEvictionCount();
             }
 
-            void TextureAtlas::_removeFromAtlas(const std::shared_ptr<BoxPackingNode>& node)
+            size_t TextureAtlas::getUploadCount() const
+            {
+                return _p->uploadCount;
+            }
+
+            void TextureAtlas::_toTextureAtlasItem(const Image::AtlasPackerItem& item, TextureAtlasItem & out)
             {
                 DJV_PRIVATE_PTR();
-                auto i = p.cache.find(node->uid);
-                if (i != p.cache.end())
-                {
-                    node->uid = 0;
-                    p.cache.erase(i);
-                }
-                if (node->isBranch())
-                {
-                    _removeFromAtlas(node->children[0]);
-                    _removeFromAtlas(node->children[1]);
-                }
+                out.w = item.bbox.w();
+                out.h = item.bbox.h();
+                out.textureIndex = item.page;
+                out.textureU = FloatRange(
+                    (item.bbox.min.x + p.border)     / static_cast<float>(p.textureSize),
+                    (item.bbox.max.x - p.border + 1) / static_cast<float>(p.textureSize));
+                out.textureV = FloatRange(
+                    (item.bbox.min.y + p.border)     / static_cast<float>(p.textureSize),
+                    (item.bbox.max.y - p.border + 1) / static_cast<float>(p.textureSize));
             }
 
         } // namespace OpenGL
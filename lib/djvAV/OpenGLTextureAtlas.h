@@ -2,6 +2,7 @@
 // Copyright (c) 2004-2020 Darby Johnston
 // All rights reserved.
 
+#include <djvAV/ImageAtlasPacker.h>
 #include <djvAV/ImageData.h>
 #include <djvAV/OpenGL.h>
 
@@ -25,6 +26,10 @@ namespace djv
             };
 
             //! This class provides a texture atlas.
+            //!
+            //! The packing is done by Image::AtlasPacker. New items are not
+            //! uploaded until flush() is called, so that items added in the
+            //! same frame can be batched together.
             class TextureAtlas
             {
                 DJV_NON_COPYABLE(TextureAtlas);
@@ -41,21 +46,20 @@ namespace djv
                 bool getItem(Core::UID, TextureAtlasItem &);
                 Core::UID addItem(const std::shared_ptr<Image::Data> &, TextureAtlasItem &);
 
+                //! Upload the items that have been added since the last call.
+                //! Items that are next to each other on the same shelf are
+                //! copied into a staging buffer and uploaded together.
+                void flush();
+
                 float getPercentageUsed() const;
+                float getFragmentation() const;
+                size_t getEvictionCount() const;
 
-            private:
-                class BoxPackingNode;
+                //! Get the number of texture uploads in the last flush.
+                size_t getUploadCount() const;
 
-                void _getAllNodes(
-                    const std::shared_ptr<BoxPackingNode>&,
-                    std::vector<std::shared_ptr<BoxPackingNode> >&);
-                void _getLeafNodes(
-                    const std::shared_ptr<BoxPackingNode>&,
-                    std::vector<std::shared_ptr<BoxPackingNode> >&) const;
-                void _toTextureAtlasItem(
-                    const std::shared_ptr<BoxPackingNode>&,
-                    TextureAtlasItem&);
-                void _removeFromAtlas(const std::shared_ptr<BoxPackingNode>&);
+            private:
+                void _toTextureAtlasItem(const Image::AtlasPackerItem&, TextureAtlasItem&);
 
                 DJV_PRIVATE();
             };
@@ -126,7 +126,7 @@ namespace djv
 
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
-                    return Read::create(fileInfo, options, _textSystem, _resourceSystem, _logSystem);
+                    return Read::create(fileInfo, options, _p->options, _textSystem, _resourceSystem, _logSystem);
                 }
 
                 std::shared_ptr<IWrite> Plugin::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options) const
@@ -146,6 +146,11 @@ namespace djv
             ss << value.data;
             out.get<picojson::object>()["Data"] = picojson::value(ss.str());
         }
+        {
+            std::stringstream ss;
+            ss << value.readType;
+            out.get<picojson::object>()["ReadType"] = picojson::value(ss.str());
+        }
         return out;
     }
 
@@ -160,6 +165,11 @@ namespace djv
                     std::stringstream ss(i.second.get<std::string>());
                     ss >> out.data;
                 }
+                else if ("ReadType" == i.first)
+                {
+                    std::stringstream ss(i.second.get<std::string>());
+                    ss >> out.readType;
+                }
             }
         }
         else
@@ -36,7 +36,8 @@ namespace djv
                 //! This struct provides the PPM file I/O options.
                 struct Options
                 {
-                    Data data = Data::Binary;
+                    Data                        data        = Data::Binary;
+                    Core::FileSystem::ReadType  readType    = Core::FileSystem::ReadType::Normal;
                 };
 
                 //! Get the number of bytes in a scanline.
@@ -73,6 +74,7 @@ namespace djv
                     static std::shared_ptr<Read> create(
                         const Core::FileSystem::FileInfo&,
                         const ReadOptions&,
+                        const Options&,
                         const std::shared_ptr<Core::TextSystem>&,
                         const std::shared_ptr<Core::ResourceSystem>&,
                         const std::shared_ptr<Core::LogSystem>&);
@@ -30,11 +30,13 @@ namespace djv
                 std::shared_ptr<Read> Read::create(
                     const FileSystem::FileInfo& fileInfo,
                     const ReadOptions& readOptions,
+                    const Options& options,
                     const std::shared_ptr<TextSystem>& textSystem,
                     const std::shared_ptr<ResourceSystem>& resourceSystem,
                     const std::shared_ptr<LogSystem>& logSystem)
                 {
                     auto out = std::shared_ptr<Read>(new Read);
+                    out->_readType = options.readType;
                     out->_init(fileInfo, readOptions, textSystem, resourceSystem, logSystem);
                     return out;
                 }
@@ -69,33 +71,36 @@ namespace djv
                     }
                     case Data::Binary:
                     {
-#if defined(DJV_MMAP)
-                        out = Image::Image::create(imageInfo, io);
-#else // DJV_MMAP
-                        bool convertEndian = false;
-                        if (imageInfo.layout.endian != Memory::getEndian())
+                        const size_t wordSize = Image::DataType::U16 == Image::getDataType(imageInfo.type) ? 2 : 1;
+                        const bool convertEndian = wordSize > 1 && imageInfo.layout.endian != Memory::getEndian();
+                        imageInfo.layout.endian = Memory::getEndian();
+                        const uint8_t* p = io->mmapP();
+                        const size_t dataByteCount = imageInfo.getDataByteCount();
+                        if (p && static_cast<size_t>(io->mmapEnd() - p) >= dataByteCount)
                         {
-                            convertEndian = true;
-                            imageInfo.layout.endian = Memory::getEndian();
+                            if (!convertEndian)
+                            {
+                                // The file data already matches the image layout.
+                                out = Image::Image::create(imageInfo, io);
+                            }
+                            else
+                            {
+                                // Convert the endian while copying out of memory.
+                                out = Image::Image::create(imageInfo);
+                                Memory::endian(p, out->getData(), dataByteCount / wordSize, wordSize);
+                                io->seek(dataByteCount);
+                            }
                         }
-                        out = Image::Image::create(imageInfo);
-                        out->setPluginName(pluginName);
-                        io->read(out->getData(), out->getDataByteCount());
-                        if (convertEndian)
+                        else
                         {
-                            const size_t dataByteCount = out->getDataByteCount();
-                            switch (Image::getDataType(imageInfo.type))
+                            out = Image::Image::create(imageInfo);
+                            io->read(out->getData(), dataByteCount);
+                            if (convertEndian)
                             {
-                                case Image::DataType::U10:
-                                    Memory::endian(out->getData(), dataByteCount / 4, 4);
-                                    break;
-                                case Image::DataType::U16:
-                                    Memory::endian(out->getData(), dataByteCount / 2, 2);
-                                    break;
-                                default: break;                            
+                                Memory::endian(out->getData(), dataByteCount / wordSize, wordSize);
                             }
                         }
-#endif // DJV_MMAP
+                        out->setPluginName(pluginName);
                         break;
                     }
                     default: break;
@@ -105,7 +110,7 @@ namespace djv
 
                 Info Read::_open(const std::string& fileName, const std::shared_ptr<FileSystem::FileIO>& io, Data& data)
                 {
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    _openFile(fileName, io);
 
                     char magic[] = { 0, 0, 0 };
                     io->read(magic, 2);
@@ -45,9 +45,10 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
 
                 private:
-                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&);
-
-                    std::vector<int32_t> _rleOffset;
+                    Info _open(
+                        const std::string &,
+                        const std::shared_ptr<Core::FileSystem::FileIO>&,
+                        std::vector<int32_t>& rleOffset);
                 };
 
                 //! This class provides the RLA file I/O plugin.
@@ -61,6 +62,7 @@ namespace djv
                 public:
                     static std::shared_ptr<Plugin> create(const std::shared_ptr<Core::Context>&);
 
+                    bool hasDecodeThreads() const override;
                     std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const override;
 
                 private:
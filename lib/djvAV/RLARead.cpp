@@ -9,6 +9,8 @@
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -42,65 +44,113 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    std::vector<int32_t> rleOffset;
+                    return _open(fileName, io, rleOffset);
                 }
 
                 namespace
                 {
-                    void readRle(
-                        const std::shared_ptr<FileSystem::FileIO>& io,
-                        uint8_t* out,
-                        size_t size,
-                        size_t channels,
-                        size_t bytes)
+                    // Decompress a RLE channel. Returns the end of the data that
+                    // was read or null if the data is not valid.
+                    const uint8_t* readRle(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         channels,
+                        size_t         bytes)
                     {
-                        int16_t _size = 0;
-                        io->read16(&_size);
-                        std::vector<uint8_t> buf;
-                        buf.resize(_size);
-                        io->read(buf.data(), _size);
-                        const uint8_t* p = buf.data();
+                        if (in + 2 > end)
+                        {
+                            return nullptr;
+                        }
+                        const size_t dataSize = (static_cast<size_t>(in[0]) << 8) | in[1];
+                        in += 2;
+                        if (in + dataSize > end)
+                        {
+                            return nullptr;
+                        }
+                        const uint8_t* p = in;
+                        const uint8_t* const pEnd = in + dataSize;
+                        const size_t outInc = channels * bytes;
                         for (size_t b = 0; b < bytes; ++b)
                         {
                             uint8_t* outP = out + (Memory::Endian::LSB == Memory::getEndian() ? (bytes - 1 - b) : b);
-                            const size_t outInc = channels * bytes;
                             for (size_t i = 0; i < size;)
                             {
+                                if (p >= pEnd)
+                                {
+                                    return nullptr;
+                                }
                                 int count = *((const int8_t*)p);
                                 ++p;
                                 if (count >= 0)
                                 {
                                     ++count;
-                                    for (int j = 0; j < count; ++j, outP += outInc)
+                                    if (i + count > size || p >= pEnd)
+                                    {
+                                        return nullptr;
+                                    }
+                                    if (1 == outInc)
+                                    {
+                                        memset(outP, *p, count);
+                                    }
+                                    else
                                     {
-                                        *outP = *p;
+                                        for (int j = 0; j < count; ++j)
+                                        {
+                                            outP[j * outInc] = *p;
+                                        }
                                     }
                                     ++p;
                                 }
                                 else
                                 {
                                     count = -count;
-                                    for (int j = 0; j < count; ++j, ++p, outP += outInc)
+                                    if (i + count > size || p + count > pEnd)
+                                    {
+                                        return nullptr;
+                                    }
+                                    if (1 == outInc)
+                                    {
+                                        memcpy(outP, p, count);
+                                    }
+                                    else
                                     {
-                                        *outP = *p;
+                                        for (int j = 0; j < count; ++j)
+                                        {
+                                            outP[j * outInc] = p[j];
+                                        }
                                     }
+                                    p += count;
                                 }
+                                outP += count * outInc;
                                 i += count;
                             }
                         }
+                        return pEnd;
                     }
 
-                    void readFloat(
-                        const std::shared_ptr<FileSystem::FileIO>& io,
-                        uint8_t* out,
-                        size_t size,
-                        size_t channels)
+                    // Returns the end of the data that was read or null if
+                    // the data is not valid.
+                    const uint8_t* readFloat(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         channels)
                     {
-                        int16_t _size = 0;
-                        io->read16(&_size);
-                        std::vector<uint8_t> buf(_size);
-                        io->read(buf.data(), _size);
-                        const uint8_t* p = buf.data();
+                        if (in + 2 > end)
+                        {
+                            return nullptr;
+                        }
+                        const size_t dataSize = (static_cast<size_t>(in[0]) << 8) | in[1];
+                        in += 2;
+                        if (in + dataSize > end || dataSize < size * 4)
+                        {
+                            return nullptr;
+                        }
+                        const uint8_t* p = in;
                         const size_t outInc = channels * 4;
                         if (Memory::Endian::LSB == Memory::getEndian())
                         {
@@ -122,6 +172,7 @@ namespace djv
                                 out[3] = p[3];
                             }
                         }
+                        return in + dataSize;
                     }
 
                 } // namespace
@@ -130,30 +181,74 @@ namespace djv
                 {
                     std::shared_ptr<Image::Image> out;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
+                    std::vector<int32_t> rleOffset;
+                    const auto info = _open(fileName, io, rleOffset);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
+                    // Read the scanline data.
+                    const size_t pos = io->getPos();
+                    const size_t size = io->getSize() - pos;
+                    std::vector<uint8_t> data(size);
+                    io->read(data.data(), size);
+
+                    // Decompress the scanlines in parallel.
                     const size_t w = info.video[0].info.size.w;
                     const size_t h = info.video[0].info.size.h;
                     const size_t channels = Image::getChannelCount(info.video[0].info.type);
                     const size_t bytes = Image::getByteCount(Image::getDataType(info.video[0].info.type));
                     const Image::DataType dataType = Image::getDataType(info.video[0].info.type);
-                    uint8_t* dataP = out->getData();
-                    for (uint16_t y = 0; y < h; ++y, dataP += w * channels * bytes)
+                    const uint8_t* dataP = data.data();
+                    const size_t threadCount = std::min(getDecodeThreadCount(), std::max(h, static_cast<size_t>(1)));
+                    std::vector<std::future<bool> > futures;
+                    for (size_t i = 0; i < threadCount; ++i)
                     {
-                        io->setPos(_rleOffset[y]);
-                        for (int c = 0; c < channels; ++c)
-                        {
-                            if (Image::DataType::F32 == dataType)
-                            {
-                                readFloat(io, dataP + c * bytes, w, channels);
-                            }
-                            else
+                        futures.push_back(std::async(
+                            threadCount > 1 ? std::launch::async : std::launch::deferred,
+                            [&out, &rleOffset, dataP, pos, size, w, h, channels, bytes, dataType, threadCount, i]
                             {
-                                readRle(io, dataP + c * bytes, w, channels, bytes);
-                            }
-                        }
+                                const size_t y0 = h * i / threadCount;
+                                const size_t y1 = h * (i + 1) / threadCount;
+                                const uint8_t* const end = dataP + size;
+                                for (size_t y = y0; y < y1; ++y)
+                                {
+                                    if (rleOffset[y] < 0 ||
+                                        static_cast<size_t>(rleOffset[y]) < pos ||
+                                        static_cast<size_t>(rleOffset[y]) - pos > size)
+                                    {
+                                        return false;
+                                    }
+                                    const uint8_t* p = dataP + rleOffset[y] - pos;
+                                    uint8_t* outP = out->getData(0, y);
+                                    for (size_t c = 0; c < channels && p; ++c)
+                                    {
+                                        if (Image::DataType::F32 == dataType)
+                                        {
+                                            p = readFloat(p, end, outP + c * bytes, w, channels);
+                                        }
+                                        else
+                                        {
+                                            p = readRle(p, end, outP + c * bytes, w, channels, bytes);
+                                        }
+                                    }
+                                    if (!p)
+                                    {
+                                        return false;
+                                    }
+                                }
+                                return true;
+                            }));
+                    }
+                    bool valid = true;
+                    for (auto& i : futures)
+                    {
+                        valid &= i.get();
+                    }
+                    if (!valid)
+                    {
+                        throw FileSystem::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
                     }
 
                     return out;
@@ -219,11 +314,14 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string& fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                Info Read::_open(
+                    const std::string& fileName,
+                    const std::shared_ptr<FileSystem::FileIO>& io,
+                    std::vector<int32_t>& rleOffset)
                 {
                     // Open the file.
                     io->setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    _openFile(fileName, io);
 
                     // Read the header.
                     Header header;
@@ -236,8 +334,8 @@ namespace djv
                     const int h = header.active[3] - header.active[2] + 1;
 
                     // Read the scanline table.
-                    _rleOffset.resize(h);
-                    io->read32(_rleOffset.data(), h);
+                    rleOffset.resize(h);
+                    io->read32(rleOffset.data(), h);
 
                     // Get file information.
                     if (header.matteChannels > 1)
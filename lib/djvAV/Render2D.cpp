@@ -42,6 +42,7 @@ namespace djv
                 //! \todo Should this be configurable?
                 const uint8_t  textureAtlasCount      = 4;
                 const uint16_t textureAtlasSize       = 8192;
+                const uint16_t sdfTextureAtlasSize    = 2048;
                 const size_t   dynamicTextureCount    = 16;
                 const size_t   dynamicTextureCacheMax = 16;
 #if !defined(DJV_OPENGL_ES2)
@@ -60,7 +61,9 @@ namespace djv
                     ColorWithTextureAlphaG,
                     ColorWithTextureAlphaB,
                     ColorAndTexture,        // Use the uniform variable "color" multiplied by the texture     
-                    Shadow                  // Use the uniform variable "color" multiplied by the "U" texture coordinate
+                    Shadow,                 // Use the uniform variable "color" multiplied by the "U" texture coordinate
+                    SDFText                 // Use the uniform variable "color" with the alpha from the signed
+                                            // distance field in the red channel of the texture
                 };
 
                 //! This struct provides data used to draw the render primitive.
@@ -94,6 +97,7 @@ namespace djv
                     GLint softClipLoc           = 0;
                     GLint imageChannelLoc       = 0;
                     GLint textureSamplerLoc     = 0;
+                    GLint sdfSmoothingLoc       = 0;
                 };
 
                 //! This class provides the base functionality for render primitives.
@@ -121,11 +125,18 @@ namespace djv
                 class TextPrimitive : public Primitive
                 {
                 public:
-                    uint8_t atlasIndex = 0;
+                    uint8_t atlasIndex   = 0;
+                    bool    sdf          = false;
+                    float   sdfSmoothing = 0.F;
 
                     void bind(const PrimitiveData& data, const std::shared_ptr<OpenGL::Shader>& shader) override
                     {
-                        if (!lcdText)
+                        if (sdf)
+                        {
+                            shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::SDFText));
+                            shader->setUniform(data.sdfSmoothingLoc, sdfSmoothing);
+                        }
+                        else if (!lcdText)
                         {
                             shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlpha));
                         }
@@ -442,6 +453,16 @@ namespace djv
                     saturationMatrix(in.saturation, in.saturation, in.saturation);
             }
 
+            ExposureData exposureData(const ImageExposure& in)
+            {
+                ExposureData out;
+                out.v = powf(2.F, in.exposure + 2.47393F);
+                out.d = in.defog;
+                out.k = powf(2.F, in.kneeLow);
+                out.f = knee2(powf(2.F, in.kneeHigh) - out.k, powf(2.F, 3.5F) - out.k);
+                return out;
+            }
+
             GLenum toGL(ImageFilter value)
             {
                 GLenum out = GL_NONE;
@@ -467,6 +488,9 @@ namespace djv
                 std::shared_ptr<OpenGL::TextureAtlas>               textureAtlas;
                 std::map<UID, uint64_t>                             textureIDs;
                 std::map<UID, uint64_t>                             glyphTextureIDs;
+                std::shared_ptr<OpenGL::TextureAtlas>               sdfTextureAtlas;
+                std::map<UID, uint64_t>                             sdfTextureIDs;
+                size_t                                              glyphAtlasMissCount = 0;
                 std::vector<std::shared_ptr<OpenGL::Texture> >      dynamicTextures;
                 std::map<UID, std::shared_ptr<OpenGL::Texture> >    dynamicTextureCache;
 #if !defined(DJV_OPENGL_ES2)
@@ -535,6 +559,15 @@ namespace djv
                     0));
                 p.primitiveData.textureAtlasCount = _textureAtlasCount;
 
+                // Signed distance field glyphs are stored in a separate atlas so
+                // they can be linearly filtered.
+                p.sdfTextureAtlas.reset(new OpenGL::TextureAtlas(
+                    1,
+                    std::min(maxTextureSize, static_cast<GLint>(sdfTextureAtlasSize)),
+                    Image::Type::L_U8,
+                    GL_LINEAR,
+                    1));
+
                 _updateImageFilter();
 
                 auto resourceSystem = context->getSystemT<ResourceSystem>();
@@ -564,8 +597,14 @@ namespace djv
                         DJV_PRIVATE_PTR();
                         std::stringstream ss;
                         ss << "Texture atlas: " << p.textureAtlas->getPercentageUsed() << "%\n";
+                        ss << "Texture atlas fragmentation: " << p.textureAtlas->getFragmentation() << "%\n";
+                        ss << "Texture atlas evictions: " << p.textureAtlas->getEvictionCount() << "\n";
+                        ss << "Texture atlas uploads: " << p.textureAtlas->getUploadCount() << "\n";
                         ss << "Texture IDs: " << p.textureIDs.size() << "%\n";
                         ss << "Glyph texture IDs: " << p.glyphTextureIDs.size() << "\n";
+                        ss << "SDF texture atlas: " << p.sdfTextureAtlas->getPercentageUsed() << "%\n";
+                        ss << "SDF texture IDs: " << p.sdfTextureIDs.size() << "\n";
+                        ss << "Glyph atlas misses: " << p.glyphAtlasMissCount << "\n";
                         ss << "Dynamic textures: " << p.dynamicTextures.size() << "\n";
                         ss << "Dynamic texture cache: " << p.dynamicTextureCache.size() << "\n";
 #if !defined(DJV_OPENGL_ES2)
@@ -587,6 +626,7 @@ namespace djv
             {
                 auto out = std::shared_ptr<Render>(new Render);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
 
@@ -633,6 +673,7 @@ namespace djv
                     p.primitiveData.colorModeLoc = glGetUniformLocation(program, "colorMode");
                     p.primitiveData.colorLoc = glGetUniformLocation(program, "color");
                     p.primitiveData.textureSamplerLoc = glGetUniformLocation(program, "textureSampler");
+                    p.primitiveData.sdfSmoothingLoc = glGetUniformLocation(program, "sdfSmoothing");
                 }
                 p.shader->bind();
 
@@ -664,12 +705,16 @@ namespace djv
                     -1.F, 1.F);
                 p.shader->setUniform(p.mvpLoc, viewMatrix);
 
+                p.textureAtlas->flush();
+                p.sdfTextureAtlas->flush();
                 const auto& atlasTextures = p.textureAtlas->getTextures();
                 for (GLuint i = 0; i < static_cast<GLuint>(atlasTextures.size()); ++i)
                 {
                     glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + i));
                     glBindTexture(GL_TEXTURE_2D, atlasTextures[i]);
                 }
+                glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + p.primitiveData.textureAtlasCount + 2));
+                glBindTexture(GL_TEXTURE_2D, p.sdfTextureAtlas->getTextures()[0]);
 
                 const size_t vertexByteCount = AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
                 if (!p.vbo || p.vboDataSize / vertexByteCount > p.vbo->getSize())
@@ -1043,29 +1088,48 @@ namespace djv
                     }
                     rsbDeltaPrev = glyph->rsbDelta;
 
-                    if (glyph->imageData && glyph->imageData->isValid())
+                    std::shared_ptr<Image::Data> data;
+                    BBox2f bbox;
+                    bool sdf = false;
+                    if (glyph->sdfData && glyph->sdfData->isValid())
                     {
-                        const uint16_t width = glyph->imageData->getWidth();
-                        const uint16_t height = glyph->imageData->getHeight();
+                        data = glyph->sdfData;
+                        sdf = true;
+                        const glm::vec2& offset = glyph->sdfOffset;
+                        bbox = BBox2f(
+                            pos.x + x + offset.x,
+                            pos.y - offset.y,
+                            data->getWidth() * glyph->sdfScale,
+                            data->getHeight() * glyph->sdfScale);
+                    }
+                    else if (glyph->imageData && glyph->imageData->isValid())
+                    {
+                        data = glyph->imageData;
                         const glm::vec2& offset = glyph->offset;
-                        const BBox2f bbox(pos.x + x + offset.x, pos.y - offset.y, width, height);
+                        bbox = BBox2f(pos.x + x + offset.x, pos.y - offset.y, data->getWidth(), data->getHeight());
+                    }
+                    if (data)
+                    {
                         if (bbox.intersects(_currentClipRect))
                         {
-                            const auto uid = glyph->imageData->getUID();
+                            auto& textureAtlas = sdf ? p.sdfTextureAtlas : p.textureAtlas;
+                            auto& textureIDs = sdf ? p.sdfTextureIDs : p.glyphTextureIDs;
+                            const auto uid = data->getUID();
                             uint64_t id = 0;
-                            const auto i = p.glyphTextureIDs.find(uid);
-                            if (i != p.glyphTextureIDs.end())
+                            const auto i = textureIDs.find(uid);
+                            if (i != textureIDs.end())
                             {
                                 id = i->second;
                             }
                             OpenGL::TextureAtlasItem item;
-                            if (!p.textureAtlas->getItem(id, item))
+                            if (!textureAtlas->getItem(id, item))
                             {
-                                id = p.textureAtlas->addItem(glyph->imageData, item);
-                                p.glyphTextureIDs[uid] = id;
+                                id = textureAtlas->addItem(data, item);
+                                textureIDs[uid] = id;
+                                ++p.glyphAtlasMissCount;
                             }
                             
-                            if (!primitive || item.textureIndex != textureIndex)
+                            if (!primitive || item.textureIndex != textureIndex || primitive->sdf != sdf)
                             {
                                 primitive = new TextPrimitive;
                                 primitive->clipRect = _currentClipRect;
@@ -1073,10 +1137,20 @@ namespace djv
                                 primitive->color[1] = _finalColor[1];
                                 primitive->color[2] = _finalColor[2];
                                 primitive->color[3] = _finalColor[3];
-                                primitive->atlasIndex = item.textureIndex;
                                 primitive->vaoOffset = p.vboDataSize / AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
                                 primitive->vaoSize = 0;
-                                primitive->lcdText = p.lcdText;
+                                if (sdf)
+                                {
+                                    primitive->atlasIndex = p.primitiveData.textureAtlasCount + 2;
+                                    primitive->sdf = true;
+                                    // Blend over about one pixel at the current size.
+                                    primitive->sdfSmoothing = 1.F / (4.F * Font::sdfSpread * glyph->sdfScale);
+                                }
+                                else
+                                {
+                                    primitive->atlasIndex = item.textureIndex;
+                                    primitive->lcdText = p.lcdText;
+                                }
                                 p.primitives.push_back(primitive);
                                 textureIndex = item.textureIndex;
                             }
@@ -1450,6 +1524,16 @@ namespace djv
                 return _p->textureAtlas->getPercentageUsed();
             }
 
+            float Render::getSDFTextureAtlasPercentage() const
+            {
+                return _p->sdfTextureAtlas->getPercentageUsed();
+            }
+
+            size_t Render::getGlyphAtlasMissCount() const
+            {
+                return _p->glyphAtlasMissCount;
+            }
+
             size_t Render::getDynamicTextureCount() const
             {
                 return _p->dynamicTextureCache.size();
@@ -1549,17 +1633,11 @@ namespace djv
                     primitive->exposureEnabled = options.exposureEnabled;
                     if (primitive->exposureEnabled)
                     {
-                        primitive->exposureV = powf(
-                            2.F,
-                            options.exposure.exposure + 2.47393F);
-                        primitive->exposureD = options.exposure.defog;
-                        primitive->exposureK = powf(
-                            2.F,
-                            options.exposure.kneeLow);
-                        primitive->exposureF = knee2(
-                            powf(2.F, options.exposure.kneeHigh) -
-                            primitive->exposureK,
-                            powf(2.F, 3.5F) - primitive->exposureK);
+                        const ExposureData exposure = exposureData(options.exposure);
+                        primitive->exposureV = exposure.v;
+                        primitive->exposureD = exposure.d;
+                        primitive->exposureK = exposure.k;
+                        primitive->exposureF = exposure.f;
                     }
                     primitive->softClip = options.softClipEnabled ? options.softClip : 0.F;
                     primitive->imageCache = options.cache;
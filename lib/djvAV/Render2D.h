@@ -112,6 +112,19 @@ namespace djv
                 bool operator != (const ImageExposure&) const;
             };
 
+            //! This struct provides the exposure values used by the display
+            //! pipeline.
+            struct ExposureData
+            {
+                float v = 0.F;
+                float d = 0.F;
+                float k = 0.F;
+                float f = 0.F;
+            };
+
+            //! Create the exposure values used by the display pipeline.
+            ExposureData exposureData(const ImageExposure&);
+
             //! This class provides image options.
             class ImageOptions
             {
@@ -275,6 +288,11 @@ namespace djv
                 ///@{
 
                 float getTextureAtlasPercentage() const;
+                float getSDFTextureAtlasPercentage() const;
+
+                //! Get the number of glyphs that have been added to the texture atlases.
+                size_t getGlyphAtlasMissCount() const;
+
                 size_t getDynamicTextureCount() const;
                 size_t getVBOSize() const;
 
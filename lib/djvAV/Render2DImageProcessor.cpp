@@ -0,0 +1,404 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/Render2DImageProcessor.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <algorithm>
+#include <future>
+#include <thread>
+
+using namespace djv::Core;
+namespace _OCIO = OCIO_NAMESPACE;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Render2D
+        {
+            namespace
+            {
+                //! \todo This should be the same as the Render2D 3D LUT size.
+                const size_t lut3DSize = 32;
+
+                // The functions below match the fragment shader.
+
+                void colorMatrixFunc(float* p, size_t count, const glm::mat4x4& m)
+                {
+                    for (size_t i = 0; i < count; ++i, p += 4)
+                    {
+                        const float r = p[0];
+                        const float g = p[1];
+                        const float b = p[2];
+                        p[0] = r * m[0][0] + g * m[0][1] + b * m[0][2] + m[0][3];
+                        p[1] = r * m[1][0] + g * m[1][1] + b * m[1][2] + m[1][3];
+                        p[2] = r * m[2][0] + g * m[2][1] + b * m[2][2] + m[2][3];
+                    }
+                }
+
+                void invertFunc(float* p, size_t count)
+                {
+                    for (size_t i = 0; i < count; ++i, p += 4)
+                    {
+                        p[0] = 1.F - p[0];
+                        p[1] = 1.F - p[1];
+                        p[2] = 1.F - p[2];
+                    }
+                }
+
+                void levelsFunc(float* p, size_t count, const ImageLevels& levels, float gamma)
+                {
+                    for (size_t i = 0; i < count; ++i, p += 4)
+                    {
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            float tmp = (p[c] - levels.inLow) / levels.inHigh;
+                            if (tmp >= 0.F)
+                            {
+                                tmp = powf(tmp, gamma);
+                            }
+                            p[c] = tmp * levels.outHigh + levels.outLow;
+                        }
+                    }
+                }
+
+                void exposureFunc(float* p, size_t count, const ExposureData& data)
+                {
+                    for (size_t i = 0; i < count; ++i, p += 4)
+                    {
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            float tmp = std::max(0.F, p[c] - data.d) * data.v;
+                            if (tmp > data.k)
+                            {
+                                tmp = data.k + logf((tmp - data.k) * data.f + 1.F) / data.f;
+                            }
+                            p[c] = tmp * .332F;
+                        }
+                    }
+                }
+
+                void softClipFunc(float* p, size_t count, float softClip)
+                {
+                    const float tmp = 1.F - softClip;
+                    for (size_t i = 0; i < count; ++i, p += 4)
+                    {
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            if (p[c] > tmp)
+                            {
+                                p[c] = tmp + (1.F - expf(-(p[c] - tmp) / softClip)) * softClip;
+                            }
+                        }
+                    }
+                }
+
+                // Sample the 3D LUT with trilinear interpolation, the same as
+                // the OpenGL texture lookup.
+                void lut3DFunc(float* p, size_t count, const std::vector<float>& lut, size_t edgeLen)
+                {
+                    const float max = static_cast<float>(edgeLen - 1);
+                    const size_t rStride = 3;
+                    const size_t gStride = edgeLen * rStride;
+                    const size_t bStride = edgeLen * gStride;
+                    for (size_t i = 0; i < count; ++i, p += 4)
+                    {
+                        size_t index[3];
+                        size_t next[3];
+                        float t[3];
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            const float v = Math::clamp(p[c] * max, 0.F, max);
+                            index[c] = std::min(static_cast<size_t>(v), edgeLen - 1);
+                            next[c] = std::min(index[c] + 1, edgeLen - 1);
+                            t[c] = v - index[c];
+                        }
+                        const float* lut000 = lut.data() + index[0] * rStride + index[1] * gStride + index[2] * bStride;
+                        const float* lut100 = lut.data() + next[0] * rStride + index[1] * gStride + index[2] * bStride;
+                        const float* lut010 = lut.data() + index[0] * rStride + next[1] * gStride + index[2] * bStride;
+                        const float* lut110 = lut.data() + next[0] * rStride + next[1] * gStride + index[2] * bStride;
+                        const float* lut001 = lut.data() + index[0] * rStride + index[1] * gStride + next[2] * bStride;
+                        const float* lut101 = lut.data() + next[0] * rStride + index[1] * gStride + next[2] * bStride;
+                        const float* lut011 = lut.data() + index[0] * rStride + next[1] * gStride + next[2] * bStride;
+                        const float* lut111 = lut.data() + next[0] * rStride + next[1] * gStride + next[2] * bStride;
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            const float v00 = Math::lerp(t[0], lut000[c], lut100[c]);
+                            const float v10 = Math::lerp(t[0], lut010[c], lut110[c]);
+                            const float v01 = Math::lerp(t[0], lut001[c], lut101[c]);
+                            const float v11 = Math::lerp(t[0], lut011[c], lut111[c]);
+                            p[c] = Math::lerp(t[2], Math::lerp(t[1], v00, v10), Math::lerp(t[1], v01, v11));
+                        }
+                    }
+                }
+
+                void channelFunc(float* p, size_t count, ImageChannel channel)
+                {
+                    size_t c = 0;
+                    switch (channel)
+                    {
+                    case ImageChannel::Red:   c = 0; break;
+                    case ImageChannel::Green: c = 1; break;
+                    case ImageChannel::Blue:  c = 2; break;
+                    case ImageChannel::Alpha: c = 3; break;
+                    default: return;
+                    }
+                    for (size_t i = 0; i < count; ++i, p += 4)
+                    {
+                        const float v = p[c];
+                        p[0] = v;
+                        p[1] = v;
+                        p[2] = v;
+                        p[3] = ImageChannel::Alpha == channel ? v : p[3];
+                    }
+                }
+
+                // Expand the image channels to RGBA, reversing the order of
+                // the pixels if the image is mirrored.
+                template<uint8_t C>
+                void toRGBA(const float* in, float* out, size_t count, bool mirror)
+                {
+                    const float* p = mirror ? in + (count - 1) * C : in;
+                    const int step = mirror ? -C : C;
+                    for (size_t i = 0; i < count; ++i, p += step, out += 4)
+                    {
+                        switch (C)
+                        {
+                        case 1:
+                            out[0] = out[1] = out[2] = p[0];
+                            out[3] = 1.F;
+                            break;
+                        case 2:
+                            out[0] = out[1] = out[2] = p[0];
+                            out[3] = p[1];
+                            break;
+                        case 3:
+                            out[0] = p[0];
+                            out[1] = p[1];
+                            out[2] = p[2];
+                            out[3] = 1.F;
+                            break;
+                        case 4:
+                            out[0] = p[0];
+                            out[1] = p[1];
+                            out[2] = p[2];
+                            out[3] = p[3];
+                            break;
+                        default: break;
+                        }
+                    }
+                }
+
+            } // namespace
+
+            struct ImageProcessor::Private
+            {
+                ImageOptions options;
+                size_t threadCount = 0;
+
+                bool colorMatrixEnabled = false;
+                glm::mat4x4 colorMatrix = glm::mat4x4(1.F);
+                bool colorInvert = false;
+                bool levelsEnabled = false;
+                float levelsGamma = 1.F;
+                bool exposureEnabled = false;
+                ExposureData exposure;
+                float softClip = 0.F;
+                std::vector<float> lut3D;
+            };
+
+            void ImageProcessor::_init(const ImageOptions& options, size_t threadCount)
+            {
+                setOptions(options);
+                setThreadCount(threadCount);
+            }
+
+            ImageProcessor::ImageProcessor() :
+                _p(new Private)
+            {}
+
+            ImageProcessor::~ImageProcessor()
+            {}
+
+            std::shared_ptr<ImageProcessor> ImageProcessor::create(const ImageOptions& options, size_t threadCount)
+            {
+                auto out = std::shared_ptr<ImageProcessor>(new ImageProcessor);
+                out->_init(options, threadCount);
+                return out;
+            }
+
+            const ImageOptions& ImageProcessor::getOptions() const
+            {
+                return _p->options;
+            }
+
+            size_t ImageProcessor::getThreadCount() const
+            {
+                return _p->threadCount;
+            }
+
+            void ImageProcessor::setOptions(const ImageOptions& value)
+            {
+                DJV_PRIVATE_PTR();
+                if (!(value.colorSpace == p.options.colorSpace) || (value.colorSpace.isValid() && p.lut3D.empty()))
+                {
+                    p.lut3D.clear();
+                    if (value.colorSpace.isValid())
+                    {
+                        auto config = _OCIO::GetCurrentConfig();
+                        auto processor = config->getProcessor(value.colorSpace.input.c_str(), value.colorSpace.output.c_str());
+                        _OCIO::GpuShaderDesc shaderDesc;
+                        shaderDesc.setLanguage(_OCIO::GPU_LANGUAGE_GLSL_1_3);
+                        shaderDesc.setLut3DEdgeLen(lut3DSize);
+                        std::vector<float> lut3D(3 * lut3DSize * lut3DSize * lut3DSize);
+                        processor->getGpuLut3D(lut3D.data(), shaderDesc);
+                        p.lut3D = std::move(lut3D);
+                    }
+                }
+                p.options = value;
+                p.colorMatrixEnabled = value.colorEnabled && value.color != ImageColor();
+                p.colorMatrix = p.colorMatrixEnabled ? colorMatrix(value.color) : glm::mat4x4(1.F);
+                p.colorInvert = value.colorEnabled && value.color.invert;
+                p.levelsEnabled = value.levelsEnabled && value.levels != ImageLevels();
+                p.levelsGamma = 1.F / value.levels.gamma;
+                p.exposureEnabled = value.exposureEnabled;
+                p.exposure = p.exposureEnabled ? exposureData(value.exposure) : ExposureData();
+                p.softClip = value.softClipEnabled ? value.softClip : 0.F;
+            }
+
+            void ImageProcessor::setThreadCount(size_t value)
+            {
+                _p->threadCount = value;
+            }
+
+            void ImageProcessor::process(glm::vec4* values, size_t count) const
+            {
+                DJV_PRIVATE_PTR();
+                float* data = &values[0][0];
+                if (p.colorMatrixEnabled)
+                {
+                    colorMatrixFunc(data, count, p.colorMatrix);
+                }
+                if (p.colorInvert)
+                {
+                    invertFunc(data, count);
+                }
+                if (p.levelsEnabled)
+                {
+                    levelsFunc(data, count, p.options.levels, p.levelsGamma);
+                }
+                if (p.exposureEnabled)
+                {
+                    exposureFunc(data, count, p.exposure);
+                }
+                if (p.softClip > 0.F)
+                {
+                    softClipFunc(data, count, p.softClip);
+                }
+                if (!p.lut3D.empty())
+                {
+                    lut3DFunc(data, count, p.lut3D, lut3DSize);
+                }
+                channelFunc(data, count, p.options.channel);
+            }
+
+            glm::vec4 ImageProcessor::process(const Image::Data& data, const glm::ivec2& pos) const
+            {
+                glm::vec4 out(0.F, 0.F, 0.F, 0.F);
+                const auto result = process(data, BBox2i(pos.x, pos.y, 1, 1));
+                if (1 == result->getWidth() && 1 == result->getHeight())
+                {
+                    const float* p = reinterpret_cast<const float*>(result->getData());
+                    out = glm::vec4(p[0], p[1], p[2], p[3]);
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image::Data> ImageProcessor::process(
+                const Image::Data& data,
+                const BBox2i& value,
+                Image::Type type) const
+            {
+                DJV_PRIVATE_PTR();
+                const Image::Info& info = data.getInfo();
+                const uint16_t w = info.size.w;
+                const uint16_t h = info.size.h;
+                const uint8_t channels = Image::getChannelCount(info.type);
+                const BBox2i bounds(0, 0, w, h);
+                const BBox2i roi = value.w() > 0 && value.h() > 0 ? bounds.intersect(value) : bounds;
+                if (!w || !h || !channels || roi.w() <= 0 || roi.h() <= 0)
+                {
+                    return Image::Data::create(Image::Info(0, 0, type));
+                }
+                const size_t roiW = static_cast<size_t>(roi.w());
+                const size_t roiH = static_cast<size_t>(roi.h());
+                auto out = Image::Data::create(Image::Info(roiW, roiH, type));
+
+                // Find the part of each scanline that is inside the region,
+                // taking the mirroring into account.
+                const bool mirrorX = info.layout.mirror.x != p.options.mirror.x;
+                const bool mirrorY = info.layout.mirror.y != p.options.mirror.y;
+                const size_t x0 = mirrorX ? (w - 1 - roi.max.x) : roi.min.x;
+                const size_t pixelByteCount = Image::getByteCount(info.type);
+                const Image::DataType dataType = Image::getDataType(info.type);
+                const bool endian = info.layout.endian != Memory::getEndian();
+                const size_t wordSize = Image::DataType::U10 == dataType ? 4 : Image::getByteCount(dataType);
+                const Image::Type floatType = Image::getFloatType(channels, 32);
+
+                const size_t threadCount = std::min(
+                    p.threadCount ?
+                        p.threadCount :
+                        std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1)),
+                    roiH);
+                std::vector<std::future<void> > futures;
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    futures.push_back(std::async(
+                        threadCount > 1 ? std::launch::async : std::launch::deferred,
+                        [this, &data, &info, &roi, &out, i, threadCount, h, roiW, roiH, x0, mirrorX, mirrorY,
+                        pixelByteCount, endian, wordSize, floatType, channels, type]
+                        {
+                            std::vector<uint8_t> endianRow(endian ? roiW * pixelByteCount : 0);
+                            std::vector<float> row(roiW * channels);
+                            std::vector<glm::vec4> rgba(roiW);
+                            for (size_t j = roiH * i / threadCount; j < roiH * (i + 1) / threadCount; ++j)
+                            {
+                                const size_t y = roi.min.y + j;
+                                const uint8_t* in = data.getData(static_cast<uint16_t>(mirrorY ? (h - 1 - y) : y)) +
+                                    x0 * pixelByteCount;
+                                if (endian)
+                                {
+                                    Memory::endian(in, endianRow.data(), roiW * pixelByteCount / wordSize, wordSize);
+                                    in = endianRow.data();
+                                }
+                                Image::convert(in, info.type, row.data(), floatType, roiW);
+                                float* rgbaData = &rgba[0][0];
+                                switch (channels)
+                                {
+                                case 1: toRGBA<1>(row.data(), rgbaData, roiW, mirrorX); break;
+                                case 2: toRGBA<2>(row.data(), rgbaData, roiW, mirrorX); break;
+                                case 3: toRGBA<3>(row.data(), rgbaData, roiW, mirrorX); break;
+                                case 4: toRGBA<4>(row.data(), rgbaData, roiW, mirrorX); break;
+                                default: break;
+                                }
+                                process(rgba.data(), roiW);
+                                Image::convert(rgbaData, Image::Type::RGBA_F32, out->getData(static_cast<uint16_t>(j)), type, roiW);
+                            }
+                        }));
+                }
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+                return out;
+            }
+
+        } // namespace Render2D
+    } // namespace AV
+} // namespace djv
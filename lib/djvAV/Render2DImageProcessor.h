@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/Render2D.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Render2D
+        {
+            //! This class provides a CPU implementation of the image display
+            //! pipeline. The results match the values drawn by
+            //! Render::drawImage() without requiring an OpenGL context.
+            //!
+            //! The color space conversion samples the same OpenColorIO 3D LUT
+            //! as the OpenGL path. Alpha blending is not applied.
+            class ImageProcessor
+            {
+                DJV_NON_COPYABLE(ImageProcessor);
+
+            protected:
+                void _init(const ImageOptions&, size_t threadCount);
+                ImageProcessor();
+
+            public:
+                ~ImageProcessor();
+
+                //! Create a new image processor. A thread count of zero uses
+                //! the hardware concurrency.
+                //! Throws:
+                //! - std::exception
+                static std::shared_ptr<ImageProcessor> create(
+                    const ImageOptions& = ImageOptions(),
+                    size_t threadCount = 0);
+
+                const ImageOptions& getOptions() const;
+                size_t getThreadCount() const;
+
+                //! Throws:
+                //! - std::exception
+                void setOptions(const ImageOptions&);
+                void setThreadCount(size_t);
+
+                //! Process RGBA values in place.
+                void process(glm::vec4*, size_t count) const;
+
+                //! Process a single pixel. The position is in display
+                //! coordinates, taking the image layout and the mirror
+                //! options into account.
+                glm::vec4 process(const Image::Data&, const glm::ivec2&) const;
+
+                //! Process a region of the image. The region is in display
+                //! coordinates and an empty region processes the whole image.
+                //! The scanlines are split between threads.
+                std::shared_ptr<Image::Data> process(
+                    const Image::Data&,
+                    const Core::BBox2i& = Core::BBox2i(0, 0, 0, 0),
+                    Image::Type = Image::Type::RGBA_F32) const;
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace Render2D
+    } // namespace AV
+} // namespace djv
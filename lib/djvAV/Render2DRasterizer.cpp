@@ -0,0 +1,1020 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/Render2DRasterizer.h>
+
+#include <djvAV/Color.h>
+#include <djvAV/Render2DImageProcessor.h>
+
+#include <djvCore/Cache.h>
+#include <djvCore/Math.h>
+
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Render2D
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const int    bandHeight    = 16;
+                const size_t glyphCacheMax = 1000;
+
+                struct Vertex
+                {
+                    Vertex(float x, float y, float u = 1.F) :
+                        x(x),
+                        y(y),
+                        u(u)
+                    {}
+
+                    float x;
+                    float y;
+                    float u; // The color is multiplied by this value (e.g., used for drawing shadows)
+                };
+
+                // This struct provides the pixels covered by a primitive, the
+                // maximum values are exclusive.
+                struct Bounds
+                {
+                    Bounds()
+                    {}
+
+                    Bounds(int x0, int y0, int x1, int y1) :
+                        x0(x0),
+                        y0(y0),
+                        x1(x1),
+                        y1(y1)
+                    {}
+
+                    int x0 = 0;
+                    int y0 = 0;
+                    int x1 = 0;
+                    int y1 = 0;
+
+                    bool isValid() const
+                    {
+                        return x1 > x0 && y1 > y0;
+                    }
+
+                    Bounds intersect(const Bounds& value) const
+                    {
+                        return Bounds(
+                            std::max(x0, value.x0),
+                            std::max(y0, value.y0),
+                            std::min(x1, value.x1),
+                            std::min(y1, value.y1));
+                    }
+                };
+
+                // Get the pixels whose centers are inside of a rectangle.
+                Bounds toBounds(const BBox2f& value)
+                {
+                    return Bounds(
+                        static_cast<int>(std::ceil(value.min.x - .5F)),
+                        static_cast<int>(std::ceil(value.min.y - .5F)),
+                        static_cast<int>(std::ceil(value.max.x - .5F)),
+                        static_cast<int>(std::ceil(value.max.y - .5F)));
+                }
+
+                // This enumeration provides how a texture is combined with the color.
+                enum class TextureMode
+                {
+                    Color, // Multiply the color by the texture (e.g., used for drawing images)
+                    Alpha, // Use the color with the alpha multiplied by the red channel
+                           // from the texture (e.g., used for drawing text)
+                    SDF    // Use the color with the alpha from the signed distance field
+                           // in the red channel of the texture
+                };
+
+                struct Primitive
+                {
+                    Bounds                       bounds;
+                    glm::vec4                    color        = glm::vec4(1.F, 1.F, 1.F, 1.F);
+                    AlphaBlend                   alphaBlend   = AlphaBlend::Straight;
+                    size_t                       vertexOffset = 0;
+                    size_t                       vertexCount  = 0;
+                    bool                         shade        = false;
+                    std::shared_ptr<Image::Data> texture;
+                    glm::mat3x3                  toTexture    = glm::mat3x3(1.F);
+                    TextureMode                  textureMode  = TextureMode::Color;
+                    float                        sdfSmoothing = 0.F;
+                };
+
+                // Cosine and sine with the values at multiples of 90 degrees
+                // snapped so the facets line up with the neighboring geometry.
+                glm::vec2 arcPoint(const glm::vec2& center, float radius, float degrees)
+                {
+                    float c = cosf(Math::deg2rad(degrees));
+                    float s = sinf(Math::deg2rad(degrees));
+                    if (fabsf(c) < 1.e-6F)
+                    {
+                        c = 0.F;
+                    }
+                    if (fabsf(s) < 1.e-6F)
+                    {
+                        s = 0.F;
+                    }
+                    return glm::vec2(center.x + c * radius, center.y + s * radius);
+                }
+
+                void addArc(
+                    std::vector<Vertex>& out,
+                    const glm::vec2& center,
+                    float radius,
+                    float degrees,
+                    float range,
+                    size_t facets,
+                    float centerU = 1.F,
+                    float edgeU = 1.F)
+                {
+                    for (size_t i = 0; i < facets; ++i)
+                    {
+                        const glm::vec2 a = arcPoint(center, radius, i / static_cast<float>(facets) * range + degrees);
+                        const glm::vec2 b = arcPoint(center, radius, (i + 1) / static_cast<float>(facets) * range + degrees);
+                        out.push_back(Vertex(center.x, center.y, centerU));
+                        out.push_back(Vertex(a.x, a.y, edgeU));
+                        out.push_back(Vertex(b.x, b.y, edgeU));
+                    }
+                }
+
+                void addQuad(std::vector<Vertex>& out, const Vertex& a, const Vertex& b, const Vertex& c, const Vertex& d)
+                {
+                    out.push_back(a);
+                    out.push_back(b);
+                    out.push_back(c);
+                    out.push_back(c);
+                    out.push_back(d);
+                    out.push_back(a);
+                }
+
+                // The functions below work on scanlines of RGBA values.
+
+                void blend(const float* src, float* dst, size_t count, AlphaBlend alphaBlend)
+                {
+                    switch (alphaBlend)
+                    {
+                    case AlphaBlend::None:
+                        memcpy(dst, src, count * 4 * sizeof(float));
+                        break;
+                    case AlphaBlend::Straight:
+                        for (size_t i = 0; i < count * 4; i += 4)
+                        {
+                            const float a = src[i + 3];
+                            const float b = 1.F - a;
+                            dst[i    ] = src[i    ] * a + dst[i    ] * b;
+                            dst[i + 1] = src[i + 1] * a + dst[i + 1] * b;
+                            dst[i + 2] = src[i + 2] * a + dst[i + 2] * b;
+                            dst[i + 3] = src[i + 3] * a + dst[i + 3] * b;
+                        }
+                        break;
+                    case AlphaBlend::Premultiplied:
+                        for (size_t i = 0; i < count * 4; i += 4)
+                        {
+                            const float b = 1.F - src[i + 3];
+                            dst[i    ] = src[i    ] + dst[i    ] * b;
+                            dst[i + 1] = src[i + 1] + dst[i + 1] * b;
+                            dst[i + 2] = src[i + 2] + dst[i + 2] * b;
+                            dst[i + 3] = src[i + 3] + dst[i + 3] * b;
+                        }
+                        break;
+                    default: break;
+                    }
+                }
+
+                void fill(float* out, size_t count, const glm::vec4& color)
+                {
+                    for (size_t i = 0; i < count * 4; i += 4)
+                    {
+                        out[i    ] = color.x;
+                        out[i + 1] = color.y;
+                        out[i + 2] = color.z;
+                        out[i + 3] = color.w;
+                    }
+                }
+
+                void shade(float* out, size_t count, const glm::vec4& color, float u, float du)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        const float v = u + du * i;
+                        out[i * 4    ] = color.x * v;
+                        out[i * 4 + 1] = color.y * v;
+                        out[i * 4 + 2] = color.z * v;
+                        out[i * 4 + 3] = color.w * v;
+                    }
+                }
+
+                void drawTriangles(
+                    const Primitive& primitive,
+                    const Vertex* vertices,
+                    const Bounds& band,
+                    float* frame,
+                    int frameWidth,
+                    float* span)
+                {
+                    const Bounds bounds = primitive.bounds.intersect(band);
+                    if (!primitive.shade)
+                    {
+                        fill(span, bounds.x1 - bounds.x0, primitive.color);
+                    }
+                    for (size_t i = 0; i + 2 < primitive.vertexCount; i += 3)
+                    {
+                        const Vertex* v = vertices + primitive.vertexOffset + i;
+                        const float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+                        if (0.F == area)
+                        {
+                            continue;
+                        }
+                        const float dudx = ((v[1].u - v[0].u) * (v[2].y - v[0].y) - (v[2].u - v[0].u) * (v[1].y - v[0].y)) / area;
+                        const float dudy = ((v[2].u - v[0].u) * (v[1].x - v[0].x) - (v[1].u - v[0].u) * (v[2].x - v[0].x)) / area;
+
+                        const float yMin = std::min(std::min(v[0].y, v[1].y), v[2].y);
+                        const float yMax = std::max(std::max(v[0].y, v[1].y), v[2].y);
+                        const int y0 = std::max(bounds.y0, static_cast<int>(std::ceil(yMin - .5F)));
+                        const int y1 = std::min(bounds.y1, static_cast<int>(std::ceil(yMax - .5F)));
+                        for (int y = y0; y < y1; ++y)
+                        {
+                            // Find where the scanline crosses the edges. The
+                            // edges are always evaluated in the same direction
+                            // so triangles that share an edge do not overlap.
+                            const float yc = y + .5F;
+                            float x[2] = { 0.F, 0.F };
+                            size_t n = 0;
+                            for (size_t j = 0; j < 3 && n < 2; ++j)
+                            {
+                                const Vertex& a = v[j];
+                                const Vertex& b = v[(j + 1) % 3];
+                                if ((a.y <= yc) != (b.y <= yc))
+                                {
+                                    const Vertex& lo = a.y < b.y ? a : b;
+                                    const Vertex& hi = a.y < b.y ? b : a;
+                                    x[n++] = lo.x + (yc - lo.y) * (hi.x - lo.x) / (hi.y - lo.y);
+                                }
+                            }
+                            if (n < 2)
+                            {
+                                continue;
+                            }
+                            const int x0 = std::max(bounds.x0, static_cast<int>(std::ceil(std::min(x[0], x[1]) - .5F)));
+                            const int x1 = std::min(bounds.x1, static_cast<int>(std::ceil(std::max(x[0], x[1]) - .5F)));
+                            if (x0 >= x1)
+                            {
+                                continue;
+                            }
+                            const size_t count = static_cast<size_t>(x1 - x0);
+                            float* src = span;
+                            if (primitive.shade)
+                            {
+                                const float u = v[0].u + dudx * (x0 + .5F - v[0].x) + dudy * (yc - v[0].y);
+                                shade(span, count, primitive.color, u, dudx);
+                            }
+                            else
+                            {
+                                src += (x0 - bounds.x0) * 4;
+                            }
+                            blend(src, frame + (static_cast<size_t>(y) * frameWidth + x0) * 4, count, primitive.alphaBlend);
+                        }
+                    }
+                }
+
+                // Narrow the range of pixels [min, max) to those where the
+                // texture coordinate "t + d * i" is inside of the texture.
+                bool clipRange(float t, float d, float size, float& min, float& max)
+                {
+                    if (0.F == d)
+                    {
+                        if (t < 0.F || t >= size)
+                        {
+                            return false;
+                        }
+                    }
+                    else
+                    {
+                        float a = -t / d;
+                        float b = (size - t) / d;
+                        if (a > b)
+                        {
+                            std::swap(a, b);
+                        }
+                        min = std::max(min, a);
+                        max = std::min(max, b);
+                    }
+                    return min < max;
+                }
+
+                void drawTexture(
+                    const Primitive& primitive,
+                    const Bounds& band,
+                    float* frame,
+                    int frameWidth,
+                    float* span)
+                {
+                    const Bounds bounds = primitive.bounds.intersect(band);
+                    const auto& info = primitive.texture->getInfo();
+                    const int textureW = info.size.w;
+                    const int textureH = info.size.h;
+                    const float* texture = reinterpret_cast<const float*>(primitive.texture->getData());
+                    const glm::mat3x3& m = primitive.toTexture;
+                    const glm::vec4& color = primitive.color;
+                    for (int y = bounds.y0; y < bounds.y1; ++y)
+                    {
+                        const glm::vec3 t = m * glm::vec3(bounds.x0 + .5F, y + .5F, 1.F);
+                        const float dx = m[0][0];
+                        const float dy = m[0][1];
+                        float min = 0.F;
+                        float max = static_cast<float>(bounds.x1 - bounds.x0);
+                        if (!clipRange(t.x, dx, static_cast<float>(textureW), min, max) ||
+                            !clipRange(t.y, dy, static_cast<float>(textureH), min, max))
+                        {
+                            continue;
+                        }
+                        const int i0 = static_cast<int>(std::ceil(min));
+                        const int i1 = static_cast<int>(std::ceil(max));
+                        if (i0 >= i1)
+                        {
+                            continue;
+                        }
+                        const size_t count = static_cast<size_t>(i1 - i0);
+
+                        // Sample the texture with nearest filtering.
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            const float k = static_cast<float>(i0 + i);
+                            const int tx = Math::clamp(static_cast<int>(std::floor(t.x + dx * k)), 0, textureW - 1);
+                            const int ty = Math::clamp(static_cast<int>(std::floor(t.y + dy * k)), 0, textureH - 1);
+                            const float* texel = texture + (static_cast<size_t>(ty) * textureW + tx) * 4;
+                            memcpy(span + i * 4, texel, 4 * sizeof(float));
+                        }
+                        switch (primitive.textureMode)
+                        {
+                        case TextureMode::Color:
+                            for (size_t i = 0; i < count * 4; i += 4)
+                            {
+                                span[i    ] *= color.x;
+                                span[i + 1] *= color.y;
+                                span[i + 2] *= color.z;
+                                span[i + 3] *= color.w;
+                            }
+                            break;
+                        case TextureMode::Alpha:
+                            for (size_t i = 0; i < count * 4; i += 4)
+                            {
+                                span[i + 3] = color.w * span[i];
+                                span[i    ] = color.x;
+                                span[i + 1] = color.y;
+                                span[i + 2] = color.z;
+                            }
+                            break;
+                        case TextureMode::SDF:
+                        {
+                            const float e0 = .5F - primitive.sdfSmoothing;
+                            const float e1 = .5F + primitive.sdfSmoothing;
+                            const float r = e1 > e0 ? 1.F / (e1 - e0) : 0.F;
+                            for (size_t i = 0; i < count * 4; i += 4)
+                            {
+                                float a = 0.F;
+                                if (r > 0.F)
+                                {
+                                    a = Math::clamp((span[i] - e0) * r, 0.F, 1.F);
+                                    a = a * a * (3.F - 2.F * a);
+                                }
+                                else
+                                {
+                                    a = span[i] >= e1 ? 1.F : 0.F;
+                                }
+                                span[i + 3] = color.w * a;
+                                span[i    ] = color.x;
+                                span[i + 1] = color.y;
+                                span[i + 2] = color.z;
+                            }
+                            break;
+                        }
+                        default: break;
+                        }
+                        blend(span, frame + (static_cast<size_t>(y) * frameWidth + bounds.x0 + i0) * 4, count, primitive.alphaBlend);
+                    }
+                }
+
+            } // namespace
+
+            struct Rasterizer::Private
+            {
+                size_t threadCount = 0;
+                std::shared_ptr<ImageProcessor> imageProcessor;
+                std::shared_ptr<ImageProcessor> textureProcessor;
+                Memory::Cache<UID, std::shared_ptr<Image::Data> > glyphCache;
+
+                Image::Size size;
+                std::list<glm::mat3x3> transforms;
+                std::list<BBox2f> clipRects;
+                BBox2f currentClipRect = BBox2f(0.F, 0.F, 0.F, 0.F);
+                glm::vec4 fillColor = glm::vec4(1.F, 1.F, 1.F, 1.F);
+                float colorMult = 1.F;
+                float alphaMult = 1.F;
+                glm::vec4 finalColor = glm::vec4(1.F, 1.F, 1.F, 1.F);
+                float lineWidth = 1.F;
+
+                std::vector<Vertex> vertices;
+                std::vector<Primitive> primitives;
+                std::vector<float> frame;
+
+                size_t getThreadCount() const;
+                const glm::mat3x3& getCurrentTransform() const;
+                Bounds getClipBounds() const;
+                void updateFinalColor();
+
+                void addTriangles(const std::vector<Vertex>&, bool shade);
+                void addTexture(
+                    const std::shared_ptr<Image::Data>&,
+                    const BBox2f&,
+                    const glm::mat3x3& toTexture,
+                    TextureMode,
+                    AlphaBlend,
+                    float sdfSmoothing = 0.F);
+                void drawImage(
+                    const std::shared_ptr<Image::Image>&,
+                    const glm::vec2& pos,
+                    const ImageOptions&,
+                    TextureMode);
+            };
+
+            void Rasterizer::_init(size_t threadCount)
+            {
+                DJV_PRIVATE_PTR();
+                p.threadCount = threadCount;
+                p.imageProcessor = ImageProcessor::create(ImageOptions(), threadCount);
+                p.textureProcessor = ImageProcessor::create(ImageOptions(), threadCount);
+                p.glyphCache.setMax(glyphCacheMax);
+            }
+
+            Rasterizer::Rasterizer() :
+                _p(new Private)
+            {}
+
+            Rasterizer::~Rasterizer()
+            {}
+
+            std::shared_ptr<Rasterizer> Rasterizer::create(size_t threadCount)
+            {
+                auto out = std::shared_ptr<Rasterizer>(new Rasterizer);
+                out->_init(threadCount);
+                return out;
+            }
+
+            size_t Rasterizer::getThreadCount() const
+            {
+                return _p->threadCount;
+            }
+
+            void Rasterizer::setThreadCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                p.threadCount = value;
+                p.imageProcessor->setThreadCount(value);
+                p.textureProcessor->setThreadCount(value);
+            }
+
+            void Rasterizer::beginFrame(const Image::Size& size)
+            {
+                DJV_PRIVATE_PTR();
+                p.size = size;
+                p.transforms.clear();
+                p.clipRects.clear();
+                p.currentClipRect = BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
+                p.vertices.clear();
+                p.primitives.clear();
+            }
+
+            std::shared_ptr<Image::Image> Rasterizer::endFrame(Image::Type type)
+            {
+                DJV_PRIVATE_PTR();
+                auto out = Image::Image::create(Image::Info(p.size, type, Image::Layout(Image::Mirror(false, true))));
+                const int w = p.size.w;
+                const int h = p.size.h;
+                if (w > 0 && h > 0)
+                {
+                    // Bin the primitives into bands of scanlines. The bands
+                    // are drawn independently and the primitives keep their
+                    // order within each band.
+                    const int bandCount = (h + bandHeight - 1) / bandHeight;
+                    std::vector<std::vector<size_t> > bins(bandCount);
+                    for (size_t i = 0; i < p.primitives.size(); ++i)
+                    {
+                        const Bounds& bounds = p.primitives[i].bounds;
+                        for (int j = bounds.y0 / bandHeight; j <= (bounds.y1 - 1) / bandHeight; ++j)
+                        {
+                            bins[j].push_back(i);
+                        }
+                    }
+
+                    p.frame.resize(static_cast<size_t>(w) * h * 4);
+
+                    // The bands are interleaved between the threads so the
+                    // work is balanced when the drawing is not spread evenly
+                    // across the frame.
+                    const size_t threadCount = std::min(p.getThreadCount(), static_cast<size_t>(bandCount));
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 0; i < threadCount; ++i)
+                    {
+                        futures.push_back(std::async(
+                            threadCount > 1 ? std::launch::async : std::launch::deferred,
+                            [this, &bins, &out, i, threadCount, bandCount, w, h, type]
+                            {
+                                DJV_PRIVATE_PTR();
+                                std::vector<float> span(static_cast<size_t>(w) * 4);
+                                float* frame = p.frame.data();
+                                for (size_t j = i; j < static_cast<size_t>(bandCount); j += threadCount)
+                                {
+                                    const int y0 = static_cast<int>(j) * bandHeight;
+                                    const int y1 = std::min(y0 + bandHeight, h);
+                                    std::fill(
+                                        frame + static_cast<size_t>(y0) * w * 4,
+                                        frame + static_cast<size_t>(y1) * w * 4,
+                                        0.F);
+                                    const Bounds band(0, y0, w, y1);
+                                    for (const auto k : bins[j])
+                                    {
+                                        const auto& primitive = p.primitives[k];
+                                        if (primitive.texture)
+                                        {
+                                            drawTexture(primitive, band, frame, w, span.data());
+                                        }
+                                        else
+                                        {
+                                            drawTriangles(primitive, p.vertices.data(), band, frame, w, span.data());
+                                        }
+                                    }
+                                    for (int y = y0; y < y1; ++y)
+                                    {
+                                        Image::convert(
+                                            frame + static_cast<size_t>(y) * w * 4,
+                                            Image::Type::RGBA_F32,
+                                            out->getData(static_cast<uint16_t>(y)),
+                                            type,
+                                            w);
+                                    }
+                                }
+                            }));
+                    }
+                    for (auto& i : futures)
+                    {
+                        i.get();
+                    }
+                }
+                p.transforms.clear();
+                p.clipRects.clear();
+                p.vertices.clear();
+                p.primitives.clear();
+                return out;
+            }
+
+            void Rasterizer::pushTransform(const glm::mat3x3& value)
+            {
+                DJV_PRIVATE_PTR();
+                p.transforms.push_back(p.transforms.size() ? p.transforms.back() * value : value);
+            }
+
+            void Rasterizer::popTransform()
+            {
+                DJV_PRIVATE_PTR();
+                if (p.transforms.size())
+                {
+                    p.transforms.pop_back();
+                }
+            }
+
+            void Rasterizer::pushClipRect(const BBox2f& value)
+            {
+                DJV_PRIVATE_PTR();
+                if (!p.clipRects.size())
+                {
+                    p.currentClipRect = value;
+                }
+                else
+                {
+                    p.currentClipRect = p.currentClipRect.intersect(value);
+                }
+                p.clipRects.push_back(p.currentClipRect);
+            }
+
+            void Rasterizer::popClipRect()
+            {
+                DJV_PRIVATE_PTR();
+                if (p.clipRects.size())
+                {
+                    p.clipRects.pop_back();
+                }
+                if (p.clipRects.size())
+                {
+                    p.currentClipRect = p.clipRects.back();
+                }
+                else
+                {
+                    p.currentClipRect = BBox2f(0.F, 0.F, static_cast<float>(p.size.w), static_cast<float>(p.size.h));
+                }
+            }
+
+            void Rasterizer::setFillColor(const Image::Color& value)
+            {
+                DJV_PRIVATE_PTR();
+                const Image::Color tmp = Image::Type::RGBA_F32 == value.getType() ? value : value.convert(Image::Type::RGBA_F32);
+                const float* d = reinterpret_cast<const float*>(tmp.getData());
+                p.fillColor = glm::vec4(d[0], d[1], d[2], d[3]);
+                p.updateFinalColor();
+            }
+
+            void Rasterizer::setColorMult(float value)
+            {
+                DJV_PRIVATE_PTR();
+                p.colorMult = value;
+                p.updateFinalColor();
+            }
+
+            void Rasterizer::setAlphaMult(float value)
+            {
+                DJV_PRIVATE_PTR();
+                p.alphaMult = value;
+                p.updateFinalColor();
+            }
+
+            void Rasterizer::setLineWidth(float value)
+            {
+                _p->lineWidth = value;
+            }
+
+            void Rasterizer::drawPolyline(const std::vector<glm::vec2>& value)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Remove repeated points, they do not have a direction.
+                std::vector<glm::vec2> pts;
+                for (const auto& i : value)
+                {
+                    if (!pts.size() || i != pts.back())
+                    {
+                        pts.push_back(i);
+                    }
+                }
+                const size_t size = pts.size();
+                if (size > 1)
+                {
+                    // Build a triangle strip along the line.
+                    const glm::mat3x3& transform = p.getCurrentTransform();
+                    std::vector<glm::vec2> strip;
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        const glm::vec2 v = i > 0 ? pts[i] - pts[i - 1] : pts[1] - pts[0];
+                        const glm::vec2 perp = glm::normalize(glm::vec2(-v.y, v.x)) * p.lineWidth;
+                        for (const auto& j : { pts[i] - perp, pts[i] + perp })
+                        {
+                            const glm::vec3 tmp = transform * glm::vec3(j.x, j.y, 1.F);
+                            strip.push_back(glm::vec2(tmp.x, tmp.y));
+                        }
+                    }
+                    std::vector<Vertex> vertices;
+                    for (size_t i = 0; i + 3 < strip.size(); i += 2)
+                    {
+                        vertices.push_back(Vertex(strip[i].x, strip[i].y));
+                        vertices.push_back(Vertex(strip[i + 1].x, strip[i + 1].y));
+                        vertices.push_back(Vertex(strip[i + 2].x, strip[i + 2].y));
+                        vertices.push_back(Vertex(strip[i + 2].x, strip[i + 2].y));
+                        vertices.push_back(Vertex(strip[i + 1].x, strip[i + 1].y));
+                        vertices.push_back(Vertex(strip[i + 3].x, strip[i + 3].y));
+                    }
+                    p.addTriangles(vertices, false);
+                }
+            }
+
+            void Rasterizer::drawRect(const BBox2f& value)
+            {
+                drawRects({ value });
+            }
+
+            void Rasterizer::drawRects(const std::vector<BBox2f>& value)
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<Vertex> vertices;
+                for (const auto& i : value)
+                {
+                    if (i.intersects(p.currentClipRect))
+                    {
+                        addQuad(
+                            vertices,
+                            Vertex(i.min.x, i.min.y),
+                            Vertex(i.max.x, i.min.y),
+                            Vertex(i.max.x, i.max.y),
+                            Vertex(i.min.x, i.max.y));
+                    }
+                }
+                p.addTriangles(vertices, false);
+            }
+
+            void Rasterizer::drawPill(const BBox2f& rect, size_t facets)
+            {
+                DJV_PRIVATE_PTR();
+                if (rect.intersects(p.currentClipRect))
+                {
+                    std::vector<Vertex> vertices;
+                    const float radius = rect.h() / 2.F;
+                    addQuad(
+                        vertices,
+                        Vertex(rect.min.x + radius, rect.min.y),
+                        Vertex(rect.max.x - radius, rect.min.y),
+                        Vertex(rect.max.x - radius, rect.max.y),
+                        Vertex(rect.min.x + radius, rect.max.y));
+                    addArc(vertices, glm::vec2(rect.min.x + radius, rect.min.y + radius), radius, 90.F, 180.F, facets);
+                    addArc(vertices, glm::vec2(rect.max.x - radius, rect.min.y + radius), radius, 270.F, 180.F, facets);
+                    p.addTriangles(vertices, false);
+                }
+            }
+
+            void Rasterizer::drawCircle(const glm::vec2& pos, float radius, size_t facets)
+            {
+                DJV_PRIVATE_PTR();
+                const BBox2f rect(pos.x - radius, pos.y - radius, radius * 2.F, radius * 2.F);
+                if (rect.intersects(p.currentClipRect))
+                {
+                    std::vector<Vertex> vertices;
+                    addArc(vertices, pos, radius, 0.F, 360.F, facets);
+                    p.addTriangles(vertices, false);
+                }
+            }
+
+            void Rasterizer::drawImage(
+                const std::shared_ptr<Image::Image>& image,
+                const glm::vec2& pos,
+                const ImageOptions& options)
+            {
+                _p->drawImage(image, pos, options, TextureMode::Color);
+            }
+
+            void Rasterizer::drawFilledImage(
+                const std::shared_ptr<Image::Image>& image,
+                const glm::vec2& pos,
+                const ImageOptions& options)
+            {
+                _p->drawImage(image, pos, options, TextureMode::Alpha);
+            }
+
+            void Rasterizer::drawText(const std::vector<std::shared_ptr<Font::Glyph> >& glyphs, const glm::vec2& pos)
+            {
+                DJV_PRIVATE_PTR();
+                float x = 0.F;
+                int32_t rsbDeltaPrev = 0;
+                for (const auto& glyph : glyphs)
+                {
+                    if (rsbDeltaPrev - glyph->lsbDelta > 32)
+                    {
+                        x -= 1.F;
+                    }
+                    else if (rsbDeltaPrev - glyph->lsbDelta < -31)
+                    {
+                        x += 1.F;
+                    }
+                    rsbDeltaPrev = glyph->rsbDelta;
+
+                    std::shared_ptr<Image::Data> data;
+                    BBox2f bbox;
+                    float scale = 1.F;
+                    bool sdf = false;
+                    if (glyph->sdfData && glyph->sdfData->isValid())
+                    {
+                        data = glyph->sdfData;
+                        sdf = true;
+                        scale = glyph->sdfScale;
+                        const glm::vec2& offset = glyph->sdfOffset;
+                        bbox = BBox2f(
+                            pos.x + x + offset.x,
+                            pos.y - offset.y,
+                            data->getWidth() * scale,
+                            data->getHeight() * scale);
+                    }
+                    else if (glyph->imageData && glyph->imageData->isValid())
+                    {
+                        data = glyph->imageData;
+                        const glm::vec2& offset = glyph->offset;
+                        bbox = BBox2f(pos.x + x + offset.x, pos.y - offset.y, data->getWidth(), data->getHeight());
+                    }
+                    if (data && scale > 0.F && bbox.intersects(p.currentClipRect))
+                    {
+                        std::shared_ptr<Image::Data> texture;
+                        const UID uid = data->getUID();
+                        if (!p.glyphCache.get(uid, texture))
+                        {
+                            texture = p.textureProcessor->process(*data);
+                            p.glyphCache.add(uid, texture);
+                        }
+                        glm::mat3x3 toTexture(1.F);
+                        toTexture[0][0] = 1.F / scale;
+                        toTexture[1][1] = 1.F / scale;
+                        toTexture[2][0] = -bbox.min.x / scale;
+                        toTexture[2][1] = -bbox.min.y / scale;
+                        p.addTexture(
+                            texture,
+                            bbox,
+                            toTexture,
+                            sdf ? TextureMode::SDF : TextureMode::Alpha,
+                            AlphaBlend::Straight,
+                            // Blend over about one pixel at the current size.
+                            sdf ? 1.F / (4.F * Font::sdfSpread * scale) : 0.F);
+                    }
+
+                    x += glyph->advance;
+                }
+            }
+
+            void Rasterizer::drawShadow(const BBox2f& value, Side side)
+            {
+                DJV_PRIVATE_PTR();
+                if (value.intersects(p.currentClipRect))
+                {
+                    static const float u[][4] =
+                    {
+                        { 0.F, 0.F, 0.F, 0.F },
+                        { 0.F, 1.F, 0.F, 1.F },
+                        { 0.F, 0.F, 1.F, 1.F },
+                        { 1.F, 0.F, 1.F, 0.F },
+                        { 1.F, 1.F, 0.F, 0.F }
+                    };
+                    const float* v = u[static_cast<size_t>(side)];
+                    std::vector<Vertex> vertices;
+                    addQuad(
+                        vertices,
+                        Vertex(value.min.x, value.min.y, v[0]),
+                        Vertex(value.max.x, value.min.y, v[1]),
+                        Vertex(value.max.x, value.max.y, v[3]),
+                        Vertex(value.min.x, value.max.y, v[2]));
+                    p.addTriangles(vertices, true);
+                }
+            }
+
+            void Rasterizer::drawShadow(const BBox2f& value, float radius, size_t facets)
+            {
+                DJV_PRIVATE_PTR();
+                if (value.intersects(p.currentClipRect))
+                {
+                    const float x0 = value.min.x;
+                    const float x1 = value.min.x + radius;
+                    const float x2 = value.max.x - radius;
+                    const float x3 = value.max.x;
+                    const float y0 = value.min.y;
+                    const float y1 = value.min.y + radius;
+                    const float y2 = value.max.y - radius;
+                    const float y3 = value.max.y;
+                    std::vector<Vertex> vertices;
+
+                    // Center.
+                    addQuad(vertices, Vertex(x1, y1), Vertex(x2, y1), Vertex(x2, y2), Vertex(x1, y2));
+
+                    // Edges.
+                    addQuad(vertices, Vertex(x2, y1), Vertex(x3, y1, 0.F), Vertex(x3, y2, 0.F), Vertex(x2, y2));
+                    addQuad(vertices, Vertex(x0, y1, 0.F), Vertex(x1, y1), Vertex(x1, y2), Vertex(x0, y2, 0.F));
+                    addQuad(vertices, Vertex(x1, y0, 0.F), Vertex(x2, y0, 0.F), Vertex(x2, y1), Vertex(x1, y1));
+                    addQuad(vertices, Vertex(x1, y2), Vertex(x2, y2), Vertex(x2, y3, 0.F), Vertex(x1, y3, 0.F));
+
+                    // Corners.
+                    addArc(vertices, glm::vec2(x1, y1), radius, 180.F, 90.F, facets, 1.F, 0.F);
+                    addArc(vertices, glm::vec2(x2, y1), radius, 270.F, 90.F, facets, 1.F, 0.F);
+                    addArc(vertices, glm::vec2(x2, y2), radius, 0.F, 90.F, facets, 1.F, 0.F);
+                    addArc(vertices, glm::vec2(x1, y2), radius, 90.F, 90.F, facets, 1.F, 0.F);
+
+                    p.addTriangles(vertices, true);
+                }
+            }
+
+            size_t Rasterizer::Private::getThreadCount() const
+            {
+                return threadCount ?
+                    threadCount :
+                    std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+            }
+
+            const glm::mat3x3& Rasterizer::Private::getCurrentTransform() const
+            {
+                static const glm::mat3x3 identity(1.F);
+                return transforms.size() ? transforms.back() : identity;
+            }
+
+            Bounds Rasterizer::Private::getClipBounds() const
+            {
+                return toBounds(currentClipRect).intersect(Bounds(0, 0, size.w, size.h));
+            }
+
+            void Rasterizer::Private::updateFinalColor()
+            {
+                finalColor.x = fillColor.x * colorMult;
+                finalColor.y = fillColor.y * colorMult;
+                finalColor.z = fillColor.z * colorMult;
+                finalColor.w = fillColor.w * alphaMult;
+            }
+
+            void Rasterizer::Private::addTriangles(const std::vector<Vertex>& value, bool shade)
+            {
+                if (value.size())
+                {
+                    BBox2f bbox(glm::vec2(value[0].x, value[0].y), glm::vec2(value[0].x, value[0].y));
+                    for (const auto& i : value)
+                    {
+                        bbox.expand(glm::vec2(i.x, i.y));
+                    }
+                    Primitive primitive;
+                    primitive.bounds = toBounds(bbox).intersect(getClipBounds());
+                    if (primitive.bounds.isValid())
+                    {
+                        primitive.color = finalColor;
+                        primitive.vertexOffset = vertices.size();
+                        primitive.vertexCount = value.size();
+                        primitive.shade = shade;
+                        vertices.insert(vertices.end(), value.begin(), value.end());
+                        primitives.push_back(primitive);
+                    }
+                }
+            }
+
+            void Rasterizer::Private::addTexture(
+                const std::shared_ptr<Image::Data>& texture,
+                const BBox2f& bbox,
+                const glm::mat3x3& toTexture,
+                TextureMode textureMode,
+                AlphaBlend alphaBlend,
+                float sdfSmoothing)
+            {
+                Primitive primitive;
+                primitive.bounds = toBounds(bbox).intersect(getClipBounds());
+                if (primitive.bounds.isValid() && texture->isValid())
+                {
+                    primitive.color = finalColor;
+                    primitive.alphaBlend = alphaBlend;
+                    primitive.texture = texture;
+                    primitive.toTexture = toTexture;
+                    primitive.textureMode = textureMode;
+                    primitive.sdfSmoothing = sdfSmoothing;
+                    primitives.push_back(primitive);
+                }
+            }
+
+            void Rasterizer::Private::drawImage(
+                const std::shared_ptr<Image::Image>& image,
+                const glm::vec2& pos,
+                const ImageOptions& options,
+                TextureMode textureMode)
+            {
+                const auto& info = image->getInfo();
+                const glm::mat3x3& transform = getCurrentTransform();
+                if (!info.isValid() || 0.F == glm::determinant(transform))
+                {
+                    return;
+                }
+
+                const glm::vec3 pts[] =
+                {
+                    transform * glm::vec3(pos.x, pos.y, 1.F),
+                    transform * glm::vec3(pos.x + info.size.w, pos.y, 1.F),
+                    transform * glm::vec3(pos.x + info.size.w, pos.y + info.size.h, 1.F),
+                    transform * glm::vec3(pos.x, pos.y + info.size.h, 1.F)
+                };
+                BBox2f bbox(glm::vec2(pts[0].x, pts[0].y), glm::vec2(pts[0].x, pts[0].y));
+                for (size_t i = 1; i < 4; ++i)
+                {
+                    bbox.expand(glm::vec2(pts[i].x, pts[i].y));
+                }
+                if (!toBounds(bbox).intersect(getClipBounds()).isValid())
+                {
+                    return;
+                }
+
+                // Map the frame coordinates back to the image pixels.
+                glm::mat3x3 toTexture = glm::inverse(transform);
+                toTexture[2][0] -= pos.x;
+                toTexture[2][1] -= pos.y;
+
+                std::shared_ptr<Image::Data> texture;
+                switch (textureMode)
+                {
+                case TextureMode::Color:
+                    imageProcessor->setOptions(options);
+                    texture = imageProcessor->process(*image);
+                    break;
+                default:
+                    texture = textureProcessor->process(*image);
+                    break;
+                }
+                addTexture(texture, bbox, toTexture, textureMode, options.alphaBlend);
+            }
+
+        } // namespace Render2D
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/Render2D.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Render2D
+        {
+            //! This class provides a CPU implementation of the 2D renderer. The
+            //! drawing functions match Render so the same drawing code can be
+            //! used without an OpenGL context, for example on machines without
+            //! a GPU.
+            //!
+            //! The primitives are recorded between beginFrame() and endFrame().
+            //! When the frame ends they are binned into bands of scanlines and
+            //! the bands are rasterized in parallel. Pixels are sampled at their
+            //! centers, the same as OpenGL without multisampling, so the results
+            //! do not depend on the number of threads.
+            //!
+            //! Images are processed with ImageProcessor and sampled with nearest
+            //! filtering. LCD text is drawn as grayscale text.
+            class Rasterizer
+            {
+                DJV_NON_COPYABLE(Rasterizer);
+
+            protected:
+                void _init(size_t threadCount);
+                Rasterizer();
+
+            public:
+                ~Rasterizer();
+
+                //! Create a new rasterizer. A thread count of zero uses the
+                //! hardware concurrency.
+                static std::shared_ptr<Rasterizer> create(size_t threadCount = 0);
+
+                size_t getThreadCount() const;
+
+                void setThreadCount(size_t);
+
+                //! \name Begin and End
+                ///@{
+
+                void beginFrame(const Image::Size&);
+
+                //! Rasterize the primitives drawn since beginFrame(). The frame
+                //! starts out transparent black and the first scanline is the
+                //! top of the image, so the layout is mirrored vertically.
+                std::shared_ptr<Image::Image> endFrame(Image::Type = Image::Type::RGBA_U8);
+
+                ///@}
+
+                //! \name Transform
+                ///@{
+
+                void pushTransform(const glm::mat3x3&);
+                void popTransform();
+
+                ///@}
+
+                //! \name Clipping Rectangle
+                ///@{
+
+                void pushClipRect(const Core::BBox2f&);
+                void popClipRect();
+
+                ///@}
+
+                //! \name Color
+                ///@{
+
+                void setFillColor(const Image::Color&);
+                void setColorMult(float);
+                void setAlphaMult(float);
+
+                ///@}
+
+                //! \name Line Width
+                ///@{
+
+                void setLineWidth(float);
+
+                ///@}
+
+                //! \name Primitives
+                ///@{
+
+                void drawPolyline(const std::vector<glm::vec2>&);
+                void drawRect(const Core::BBox2f&);
+                void drawRects(const std::vector<Core::BBox2f>&);
+                void drawPill(const Core::BBox2f&, size_t facets = 32);
+                void drawCircle(const glm::vec2& pos, float radius, size_t facets = 64);
+
+                ///@}
+
+                //! \name Images
+                ///@{
+
+                void drawImage(
+                    const std::shared_ptr<Image::Image>&,
+                    const glm::vec2& pos,
+                    const ImageOptions& = ImageOptions());
+
+                void drawFilledImage(
+                    const std::shared_ptr<Image::Image>&,
+                    const glm::vec2& pos,
+                    const ImageOptions& = ImageOptions());
+
+                ///@}
+
+                //! \name Text
+                ///@{
+
+                void drawText(const std::vector<std::shared_ptr<Font::Glyph> >& glyphs, const glm::vec2& position);
+
+                ///@}
+
+                //! \name Shadows
+                ///@{
+
+                void drawShadow(const Core::BBox2f&, Side);
+                void drawShadow(const Core::BBox2f&, float radius, size_t facets = 16);
+
+                ///@}
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace Render2D
+    } // namespace AV
+} // namespace djv
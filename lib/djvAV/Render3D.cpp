@@ -30,7 +30,8 @@ namespace djv
                 //! \todo Should this be configurable?
                 const uint8_t  textureAtlasCount        = 4;
                 const uint16_t textureAtlasSize         = 8192;
-                const size_t   shadedMeshCacheSize      = 50000000;
+                const size_t   shadedMeshCacheSize      = 20000000;
+                const size_t   shadedMeshIndexCacheSize = 50000000;
                 const size_t   solidColorMeshCacheSize  = 10000000;
 
                 struct Primitive
@@ -38,6 +39,7 @@ namespace djv
                     glm::mat4x4                 xform;
                     GLenum                      type     = GL_TRIANGLES;
                     std::vector<SizeTRange>     vaoRange;
+                    std::vector<SizeTRange>     eboRange;
                     AV::Image::Color            color;
                     std::shared_ptr<IMaterial>  material;
                 };
@@ -61,6 +63,8 @@ namespace djv
                 std::map<AV::OpenGL::VBOType, std::map<std::shared_ptr<IMaterial>, std::vector<std::shared_ptr<Primitive> > > > primitives;
 
                 std::shared_ptr<Time::Timer>            statsTimer;
+
+                void addShadedMesh(const Geom::TriangleMesh&, Primitive&);
             };
 
             void Render::_init(const std::shared_ptr<Context>& context)
@@ -99,7 +103,8 @@ namespace djv
 
                 p.meshCache[OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10].reset(new OpenGL::MeshCache(
                     shadedMeshCacheSize,
-                    OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10));
+                    OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10,
+                    shadedMeshIndexCacheSize));
                 p.meshCache[OpenGL::VBOType::Pos3_F32].reset(new OpenGL::MeshCache(
                     solidColorMeshCacheSize,
                     OpenGL::VBOType::Pos3_F32));
@@ -132,6 +137,7 @@ namespace djv
             {
                 auto out = std::shared_ptr<Render>(new Render);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
 
@@ -182,6 +188,7 @@ namespace djv
                 glClearColor(0.F, 0.F, 0.F, 0.F);
                 glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+                p.textureAtlas->flush();
                 const auto& atlasTextures = p.textureAtlas->getTextures();
                 for (GLuint i = 0; i < static_cast<GLuint>(atlasTextures.size()); ++i)
                 {
@@ -210,6 +217,10 @@ namespace djv
                             {
                                 vao->draw(k->type, vaoIt.min, vaoIt.max - vaoIt.min + 1);
                             }
+                            for (const auto& eboIt : k->eboRange)
+                            {
+                                vao->drawElements(k->type, eboIt.min, eboIt.max - eboIt.min + 1);
+                            }
                         }
                     }
                 }
@@ -387,21 +398,7 @@ namespace djv
                     primitive->color = p.currentColor;
                     primitive->material = p.currentMaterial;
 
-                    auto& meshCache = p.meshCache[OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10];
-                    auto& meshCacheUIDs = p.meshCacheUIDs[OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10];
-                    SizeTRange range;
-                    const UID uid = value.getUID();
-                    const auto i = meshCacheUIDs.find(uid);
-                    if (i != meshCacheUIDs.end())
-                    {
-                        meshCache->getItem(i->second, range);
-                    }
-                    if (range.min == range.max)
-                    {
-                        const auto data = OpenGL::VBO::convert(value, OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10);
-                        meshCacheUIDs[uid] = meshCache->addItem(data, range);
-                    }
-                    primitive->vaoRange.push_back(range);
+                    p.addShadedMesh(value, *primitive);
 
                     p.primitives[OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10][primitive->material].push_back(primitive);
                 }
@@ -417,25 +414,11 @@ namespace djv
                     primitive->color = p.currentColor;
                     primitive->material = p.currentMaterial;
 
-                    auto& meshCache = p.meshCache[OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10];
-                    auto& meshCacheUIDs = p.meshCacheUIDs[OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10];
                     for (const auto& i : value)
                     {
                         if (i.triangles.size())
                         {
-                            SizeTRange range;
-                            const UID uid = i.getUID();
-                            const auto j = meshCacheUIDs.find(uid);
-                            if (j != meshCacheUIDs.end())
-                            {
-                                meshCache->getItem(j->second, range);
-                            }
-                            if (range.min == range.max)
-                            {
-                                const auto data = OpenGL::VBO::convert(i, OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10);
-                                meshCacheUIDs[uid] = meshCache->addItem(data, range);
-                            }
-                            primitive->vaoRange.push_back(range);
+                            p.addShadedMesh(i, *primitive);
                         }
                     }
 
@@ -453,25 +436,11 @@ namespace djv
                     primitive->color = p.currentColor;
                     primitive->material = p.currentMaterial;
 
-                    auto& meshCache = p.meshCache[OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10];
-                    auto& meshCacheUIDs = p.meshCacheUIDs[OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10];
                     for (const auto& i : value)
                     {
                         if (i->triangles.size())
                         {
-                            SizeTRange range;
-                            const UID uid = i->getUID();
-                            const auto j = meshCacheUIDs.find(uid);
-                            if (j != meshCacheUIDs.end())
-                            {
-                                meshCache->getItem(j->second, range);
-                            }
-                            if (range.min == range.max)
-                            {
-                                const auto data = OpenGL::VBO::convert(*i, OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10);
-                                meshCacheUIDs[uid] = meshCache->addItem(data, range);
-                            }
-                            primitive->vaoRange.push_back(range);
+                            p.addShadedMesh(*i, *primitive);
                         }
                     }
 
@@ -479,6 +448,38 @@ namespace djv
                 }
             }
 
+            void Render::Private::addShadedMesh(const Geom::TriangleMesh& mesh, Primitive& primitive)
+            {
+                // Shaded meshes are welded and drawn with indices so that
+                // shared vertices are only stored and transformed once.
+                const OpenGL::VBOType type = OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10;
+                auto& cache = meshCache[type];
+                auto& cacheUIDs = meshCacheUIDs[type];
+                SizeTRange vboRange;
+                SizeTRange eboRange;
+                bool cached = false;
+                const UID uid = mesh.getUID();
+                const auto i = cacheUIDs.find(uid);
+                if (i != cacheUIDs.end())
+                {
+                    cached = cache->getItem(i->second, vboRange, eboRange);
+                }
+                if (!cached)
+                {
+                    std::vector<Geom::TriangleMesh::Vertex> vertices;
+                    std::vector<uint32_t> indices;
+                    Geom::TriangleMesh::weld(mesh, vertices, indices);
+                    const auto data = OpenGL::VBO::convert(mesh, vertices, type);
+                    const UID cacheUID = cache->addItem(data, indices, vboRange, eboRange);
+                    cacheUIDs[uid] = cacheUID;
+                    cached = cacheUID != 0;
+                }
+                if (cached)
+                {
+                    primitive.eboRange.push_back(eboRange);
+                }
+            }
+
         } // namespace Render3D
     } // namespace AV
 
@@ -44,11 +44,12 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
 
                 private:
-                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&);
-
-                    bool _compression = false;
-                    std::vector<uint32_t> _rleOffset;
-                    std::vector<uint32_t> _rleSize;
+                    Info _open(
+                        const std::string &,
+                        const std::shared_ptr<Core::FileSystem::FileIO>&,
+                        bool& compression,
+                        std::vector<uint32_t>& rleOffset,
+                        std::vector<uint32_t>& rleSize);
                 };
                 
                 //! This class provides the SGI file I/O plugin.
@@ -62,6 +63,7 @@ namespace djv
                 public:
                     static std::shared_ptr<Plugin> create(const std::shared_ptr<Core::Context>&);
 
+                    bool hasDecodeThreads() const override;
                     std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const override;
                 };
 
@@ -9,6 +9,8 @@
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -42,101 +44,80 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    bool compression = false;
+                    std::vector<uint32_t> rleOffset;
+                    std::vector<uint32_t> rleSize;
+                    return _open(fileName, io, compression, rleOffset, rleSize);
                 }
 
                 namespace
                 {
-                    template<typename T>
-                    bool read(
-                        const void* in,
-                        const void* end,
-                        void*       out,
-                        size_t      size,
-                        bool        endian)
+                    // Decompress a RLE scanline. The data is big endian and
+                    // is copied without conversion to match the image layout.
+                    // The output stride is the number of bytes between pixels.
+                    template<size_t bytes>
+                    bool readRle(
+                        const uint8_t* in,
+                        const uint8_t* end,
+                        uint8_t*       out,
+                        size_t         size,
+                        size_t         stride)
                     {
-                        const size_t bytes = sizeof(T);
-                        const T* inP = reinterpret_cast<const T*>(in);
-                        T* outP = reinterpret_cast<T*>(out);
-                        const T* const outEnd = outP + size;
-                        while (outP < outEnd)
+                        const uint8_t* const outEnd = out + size * stride;
+                        while (out < outEnd)
                         {
                             // Information.
-                            if (inP > end)
+                            if (in + bytes > end)
                             {
                                 return false;
                             }
-                            const size_t count = *inP & 0x7f;
-                            const bool   run = !(*inP & 0x80);
-                            const size_t length = run ? 1 : count;
-                            ++inP;
+                            const uint8_t value  = in[bytes - 1];
+                            const size_t  count  = value & 0x7f;
+                            const bool    run    = !(value & 0x80);
+                            const size_t  length = run ? 1 : count;
+                            in += bytes;
 
                             // Unpack.
-                            if (inP + length > end)
+                            if (0 == count ||
+                                in + length * bytes > end ||
+                                out + count * stride > outEnd)
                             {
                                 return false;
                             }
                             if (run)
                             {
-                                if (!endian)
+                                if (1 == bytes && 1 == stride)
                                 {
-                                    for (size_t j = 0; j < count; ++j, ++outP)
-                                    {
-                                        *outP = *inP;
-                                    }
+                                    memset(out, in[0], count);
                                 }
                                 else
                                 {
-                                    Memory::endian(inP, outP, 1, bytes);
-                                    Memory::endian(inP, outP, 1, bytes);
-                                    if (count > 1)
+                                    for (size_t j = 0; j < count; ++j)
                                     {
-                                        for (size_t j = 0; j < count - 1; ++j)
-                                        {
-                                            outP[1 + j] = outP[0];
-                                        }
+                                        memcpy(out + j * stride, in, bytes);
                                     }
-                                    outP += count;
                                 }
-                                ++inP;
                             }
                             else
                             {
-                                if (!endian)
+                                if (bytes == stride)
                                 {
-                                    for (size_t j = 0; j < length; ++j, ++inP, ++outP)
-                                    {
-                                        *outP = *inP;
-                                    }
+                                    memcpy(out, in, count * bytes);
                                 }
                                 else
                                 {
-                                    Memory::endian(inP, outP, length, bytes);
-                                    inP += length;
-                                    outP += length;
+                                    for (size_t j = 0; j < count; ++j)
+                                    {
+                                        memcpy(out + j * stride, in + j * bytes, bytes);
+                                    }
                                 }
                             }
+                            in += length * bytes;
+                            out += count * stride;
                         }
                         return true;
                     }
 
-                    bool readRle(
-                        const void* in,
-                        const void* end,
-                        void*       out,
-                        size_t      size,
-                        size_t      bytes,
-                        bool        endian)
-                    {
-                        switch (bytes)
-                        {
-                        case 1: return read<uint8_t>(in, end, out, size, false);
-                        case 2: return read<uint16_t>(in, end, out, size, endian);
-                        default: break;
-                        }
-                        return false;
-                    }
-
                     void planarInterleave(
                         const std::shared_ptr<Image::Data>& in,
                         std::shared_ptr<Image::Image>& out)
@@ -191,58 +172,84 @@ namespace djv
                 {
                     std::shared_ptr<Image::Image> out;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
+                    bool compression = false;
+                    std::vector<uint32_t> rleOffset;
+                    std::vector<uint32_t> rleSize;
+                    const auto info = _open(fileName, io, compression, rleOffset, rleSize);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
+                    // The data is read without endian conversion since the
+                    // image layout is big endian.
                     const size_t pos = io->getPos();
                     const size_t size = io->getSize() - pos;
                     const Image::Info& imageInfo = info.video[0].info;
+                    const size_t w = imageInfo.size.w;
+                    const size_t h = imageInfo.size.h;
                     const size_t channels = Image::getChannelCount(imageInfo.type);
                     const size_t bytes = Image::getByteCount(Image::getDataType(imageInfo.type));
-                    const size_t dataByteCount = out->getDataByteCount();
-                    std::shared_ptr<Image::Data> tmp = Image::Data::create(imageInfo);
-                    if (!_compression)
+                    if (!compression)
                     {
-                        if (1 == bytes)
-                        {
-                            io->readU8(tmp->getData(), dataByteCount);
-                        }
-                        else
-                        {
-                            io->read(tmp->getData(), size / bytes, bytes);
-                        }
+                        // Interleave the image channels.
+                        std::shared_ptr<Image::Data> tmp = Image::Data::create(imageInfo);
+                        io->read(tmp->getData(), tmp->getDataByteCount());
+                        planarInterleave(tmp, out);
                     }
                     else
                     {
+                        // Decompress the scanlines in parallel, each channel
+                        // is written directly to the interleaved image.
                         std::vector<uint8_t> rleData(size);
-                        io->read(rleData.data(), size / bytes, bytes);
-                        const uint8_t* inP = rleData.data();
-                        const uint8_t* end = inP + size;
-                        uint8_t* outP = tmp->getData();
-                        for (size_t c = 0; c < channels; ++c)
+                        io->read(rleData.data(), size);
+                        const uint8_t* rleP = rleData.data();
+                        const size_t pixelByteCount = out->getPixelByteCount();
+                        const size_t threadCount = std::min(getDecodeThreadCount(), std::max(h, static_cast<size_t>(1)));
+                        std::vector<std::future<bool> > futures;
+                        for (size_t i = 0; i < threadCount; ++i)
                         {
-                            for (size_t y = 0; y < imageInfo.size.h; ++y, outP += imageInfo.size.w * bytes)
-                            {
-                                if (!readRle(
-                                    inP + _rleOffset[y + imageInfo.size.h * c] - pos,
-                                    end,
-                                    outP,
-                                    imageInfo.size.w,
-                                    bytes,
-                                    io->hasEndianConversion()))
+                            futures.push_back(std::async(
+                                threadCount > 1 ? std::launch::async : std::launch::deferred,
+                                [&out, &rleOffset, &rleSize, rleP, pos, size, w, h, channels, bytes, pixelByteCount, threadCount, i]
                                 {
-                                    throw FileSystem::Error(String::Format("{0}: {1}").
-                                        arg(fileName).
-                                        arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
-                                }
-                            }
+                                    const size_t y0 = h * i / threadCount;
+                                    const size_t y1 = h * (i + 1) / threadCount;
+                                    for (size_t y = y0; y < y1; ++y)
+                                    {
+                                        for (size_t c = 0; c < channels; ++c)
+                                        {
+                                            const size_t offset = rleOffset[y + h * c];
+                                            if (offset < pos || offset - pos > size)
+                                            {
+                                                return false;
+                                            }
+                                            const uint8_t* inP = rleP + offset - pos;
+                                            const uint8_t* end = inP + std::min(static_cast<size_t>(rleSize[y + h * c]), size - (offset - pos));
+                                            uint8_t* outP = out->getData(0, y) + c * bytes;
+                                            const bool valid = 1 == bytes ?
+                                                readRle<1>(inP, end, outP, w, pixelByteCount) :
+                                                readRle<2>(inP, end, outP, w, pixelByteCount);
+                                            if (!valid)
+                                            {
+                                                return false;
+                                            }
+                                        }
+                                    }
+                                    return true;
+                                }));
+                        }
+                        bool valid = true;
+                        for (auto& i : futures)
+                        {
+                            valid &= i.get();
+                        }
+                        if (!valid)
+                        {
+                            throw FileSystem::Error(String::Format("{0}: {1}").
+                                arg(fileName).
+                                arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
                         }
                     }
 
-                    // Interleave the image channels.
-                    planarInterleave(tmp, out);
-
                     return out;
                 }
 
@@ -330,12 +337,26 @@ namespace djv
                 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                Info Read::_open(
+                    const std::string & fileName,
+                    const std::shared_ptr<FileSystem::FileIO>& io,
+                    bool& compression,
+                    std::vector<uint32_t>& rleOffset,
+                    std::vector<uint32_t>& rleSize)
                 {
                     io->setEndianConversion(Memory::getEndian() != Memory::Endian::MSB);
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    _openFile(fileName, io);
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _compression, _textSystem);
+                    Header().read(io, imageInfo, compression, _textSystem);
+                    if (compression)
+                    {
+                        // Read the scanline offset and size tables.
+                        const size_t size = imageInfo.size.h * Image::getChannelCount(imageInfo.type);
+                        rleOffset.resize(size);
+                        rleSize.resize(size);
+                        io->readU32(rleOffset.data(), size);
+                        io->readU32(rleSize.data(), size);
+                    }
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
@@ -5,11 +5,14 @@
 #include <djvAV/SequenceIO.h>
 
 #include <djvAV/ImageConvert.h>
+#include <djvAV/ImageStats.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/FileSystem.h>
+#include <djvCore/FileIO.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/OS.h>
 #include <djvCore/Path.h>
 #include <djvCore/String.h>
@@ -35,12 +38,70 @@ namespace djv
                 //! \todo Should this be configurable?
                 const double infoTimeout = 0.5;
 
+                void detach(const VideoFrame& value)
+                {
+                    if (value.layers.size())
+                    {
+                        for (const auto& i : value.layers)
+                        {
+                            if (i)
+                            {
+                                i->detach();
+                            }
+                        }
+                    }
+                    else if (value.image)
+                    {
+                        value.image->detach();
+                    }
+                }
+
+                //! Convert an image without an OpenGL context. The pixel type,
+                //! alignment, endian and vertical mirroring can be converted.
+                bool convertCPU(const Image::Image& in, Image::Image& out)
+                {
+                    const auto& inLayout = in.getLayout();
+                    const auto& outLayout = out.getLayout();
+                    if (inLayout.mirror.x != outLayout.mirror.x ||
+                        inLayout.endian != Memory::getEndian())
+                    {
+                        return false;
+                    }
+                    size_t wordSize = 1;
+                    switch (Image::getDataType(out.getType()))
+                    {
+                    case Image::DataType::U10:
+                    case Image::DataType::U32:
+                    case Image::DataType::F32: wordSize = 4; break;
+                    case Image::DataType::U16:
+                    case Image::DataType::F16: wordSize = 2; break;
+                    default: break;
+                    }
+                    const bool convertEndian = wordSize > 1 && outLayout.endian != Memory::getEndian();
+                    const uint16_t w = in.getWidth();
+                    const uint16_t h = in.getHeight();
+                    const size_t scanlineByteCount = w * Image::getByteCount(out.getType());
+                    for (uint16_t y = 0; y < h; ++y)
+                    {
+                        const uint8_t* inP = in.getData(inLayout.mirror.y != outLayout.mirror.y ? (h - 1 - y) : y);
+                        uint8_t* outP = out.getData(y);
+                        Image::convert(inP, in.getType(), outP, out.getType(), w);
+                        if (convertEndian)
+                        {
+                            Memory::endian(outP, scanlineByteCount / wordSize, wordSize);
+                        }
+                    }
+                    return true;
+                }
+
             } // namespace
 
             struct ISequenceRead::Future
             {
                 Frame::Number frame = Frame::invalid;
                 std::shared_ptr<Image::Image> image;
+                std::vector<std::shared_ptr<Image::Image> > layers;
+                std::shared_ptr<Image::Image> proxy;
             };
 
             struct ISequenceRead::Private
@@ -48,6 +109,13 @@ namespace djv
                 Frame::Number frame = Frame::invalid;
                 std::promise<Info> infoPromise;
                 std::vector<std::future<Future> > cacheFutures;
+                std::set<Frame::Index> cacheFrames;
+                std::atomic<bool> proxyEnabled;
+                Range::Range<Frame::Index> proxyRange = Range::Range<Frame::Index>(0, -1);
+                std::vector<Frame::Index> proxyOrder;
+                size_t proxyIndex = 0;
+                std::vector<std::future<Future> > proxyFutures;
+                std::shared_ptr<FileSystem::ReadAhead> readAhead;
                 std::condition_variable queueCV;
                 Direction direction = Direction::Forward;
                 Frame::Number seek = Frame::invalid;
@@ -65,6 +133,8 @@ namespace djv
             {
                 IRead::_init(fileInfo, options, textSystem, resourceSystem, logSystem);
                 _speed = Time::Speed();
+                _p->readAhead = FileSystem::ReadAhead::create(_threadCount);
+                _p->proxyEnabled = false;
                 _p->running = true;
                 _p->thread = std::thread(
                     [this]
@@ -117,6 +187,7 @@ namespace djv
                     }
 
                     // Start looping...
+                    size_t readAheadThreadCount = _threadCount;
                     p.infoTimer = std::chrono::steady_clock::now();
                     const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
                     while (p.running)
@@ -125,27 +196,58 @@ namespace djv
                         size_t threadCount = 4;
                         bool playback = false;
                         bool loop = false;
+                        Playhead playhead;
                         InOutPoints inOutPoints;
                         bool cacheEnabled = false;
                         size_t cacheMaxByteCount = 0;
+                        bool proxyEnabled = false;
                         {
                             std::lock_guard<std::mutex> lock(_mutex);
                             threadCount = _threadCount;
                             playback = _playback;
                             loop = _loop;
+                            playhead.playback = _playback;
+                            playhead.speed = _playbackSpeed;
+                            playhead.everyFrame = _playEveryFrame;
+                            playhead.loop = _loop;
+                            playhead.pingPong = _pingPong;
                             inOutPoints = _inOutPoints;
                             cacheEnabled = _cacheEnabled;
                             cacheMaxByteCount = _cacheMaxByteCount;
+                            proxyEnabled = _proxyEnabled;
+                            _proxyCache.setMaxByteCount(_proxyMaxByteCount);
+                            if (!proxyEnabled)
+                            {
+                                _proxyCache.clear();
+                            }
                         }
+                        p.proxyEnabled = proxyEnabled;
                         if (!cacheEnabled)
                         {
                             _cache.clear();
                         }
+                        if (threadCount != readAheadThreadCount)
+                        {
+                            readAheadThreadCount = threadCount;
+                            p.readAhead->setThreadCount(threadCount);
+                        }
                         if (info.video.size() && _options.layer < info.video.size())
                         {
-                            const size_t dataByteCount = info.video[_options.layer].info.getDataByteCount();
+                            size_t dataByteCount = 0;
+                            if (_options.allLayers)
+                            {
+                                for (const auto& i : info.video)
+                                {
+                                    dataByteCount += i.info.getDataByteCount();
+                                }
+                            }
+                            else
+                            {
+                                dataByteCount = info.video[_options.layer].info.getDataByteCount();
+                            }
                             _cache.setMax(dataByteCount ? (cacheMaxByteCount / dataByteCount) : 0);
                             _cache.setSequenceSize(info.video[_options.layer].sequence.getSize());
+                            _cache.setSpeed(info.video[_options.layer].speed);
                             _cache.setInOutPoints(inOutPoints);
                         }
                         else
@@ -192,6 +294,14 @@ namespace djv
                             }*/
                         }
 
+                        // Start reading the upcoming files in the background
+                        // so the decoders do not wait on the disk.
+                        if (FileSystem::ReadType::Normal == _readType &&
+                            (queueCount > 0 || seek != Frame::invalid))
+                        {
+                            _readAhead(threadCount * 2, loop, cacheEnabled);
+                        }
+
                         // Fill the queue.
                         size_t read = 0;
                         if (queueCount > 0)
@@ -202,7 +312,17 @@ namespace djv
                         // Fill the cache.
                         if (cacheEnabled)
                         {
-                            _readCache(playback ? (threadCount / 2) : threadCount, inOutPoints);
+                            _readCache(playback ? (threadCount / 2) : threadCount, playhead);
+                        }
+
+                        // Fill the proxies with the threads that are not
+                        // being used for the cache.
+                        if (proxyEnabled)
+                        {
+                            const size_t cacheCount = p.cacheFutures.size();
+                            _readProxies(
+                                !playback && queueCount == 0 && cacheCount < threadCount ? (threadCount - cacheCount) : 0,
+                                inOutPoints);
                         }
 
                         // Update information.
@@ -211,18 +331,29 @@ namespace djv
                         if (delta.count() > infoTimeout)
                         {
                             p.infoTimer = now;
+                            DecodeStats decodeStats;
+                            {
+                                std::lock_guard<std::mutex> lock(_mutex);
+                                decodeStats = _decodeStats;
+                            }
+                            _cache.setReadTime(decodeStats.frames > 0 && threadCount > 0 ?
+                                (decodeStats.seconds / decodeStats.frames / threadCount) :
+                                0.F);
                             size_t cacheByteCount = _cache.getTotalByteCount();
                             auto cacheSequence = _cache.getSequence();
                             auto cachedFrames = _cache.getFrames();
+                            const auto readAheadStats = p.readAhead->getStats();
                             {
                                 std::lock_guard<std::mutex> lock(_mutex);
                                 _cacheByteCount = cacheByteCount;
                                 _cacheSequence = cacheSequence;
                                 _cachedFrames = std::move(cachedFrames);
+                                _readAheadStats = readAheadStats;
                             }
                         }
                     }
 
+                    p.readAhead->clear();
                     p.running = false;
                 });
             }
@@ -255,6 +386,16 @@ namespace djv
                 p.queueCV.notify_one();
             }
 
+            std::vector<std::shared_ptr<Image::Image> > ISequenceRead::_readLayers(const std::string& fileName)
+            {
+                return { _readImage(fileName) };
+            }
+
+            std::shared_ptr<Image::Image> ISequenceRead::_readProxy(const std::string& fileName, float)
+            {
+                return _readImage(fileName);
+            }
+
             void ISequenceRead::_finish()
             {
                 DJV_PRIVATE_PTR();
@@ -266,6 +407,20 @@ namespace djv
                 }
             }
 
+            void ISequenceRead::_openFile(const std::string& fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+            {
+                DJV_PRIVATE_PTR();
+                io->setReadType(_readType);
+                if (FileSystem::ReadType::Normal == _readType)
+                {
+                    p.readAhead->open(fileName, io);
+                }
+                else
+                {
+                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                }
+            }
+
             bool ISequenceRead::_hasWork() const
             {
                 const bool queue = (_videoQueue.getCount() < _videoQueue.getMax()) && !_videoQueue.isFinished();
@@ -280,7 +435,71 @@ namespace djv
                 return std::min(queueMax, threadCount);
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Frame::Number i, std::string fileName)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Frame::Number i, std::string fileName, bool proxyReplace)
+            {
+                return std::async(
+                    std::launch::async,
+                    [this, i, fileName, proxyReplace]
+                    {
+                        Future out;
+                        out.frame = i;
+                        try
+                        {
+                            const auto start = std::chrono::steady_clock::now();
+                            if (_options.allLayers)
+                            {
+                                out.layers = _readLayers(fileName);
+                                if (out.layers.size())
+                                {
+                                    out.image = out.layers[std::min(_options.layer, out.layers.size() - 1)];
+                                }
+                            }
+                            else
+                            {
+                                out.image = _readImage(fileName);
+                            }
+                            if (_options.stats && out.image)
+                            {
+                                // Compute the statistics while the image data
+                                // is still in this thread's cache. The frames
+                                // are already read in parallel so only use
+                                // this thread.
+                                Image::StatsOptions statsOptions;
+                                statsOptions.threadCount = 1;
+                                out.image->setStats(std::make_shared<Image::Stats>(
+                                    Image::getStats(*out.image, statsOptions)));
+                            }
+                            if (_p->proxyEnabled && out.image)
+                            {
+                                bool proxy = false;
+                                {
+                                    std::lock_guard<std::mutex> lock(_mutex);
+                                    // The frames that are displayed replace the
+                                    // least recently used proxies.
+                                    proxy = !_proxyCache.contains(i) && (proxyReplace || !_proxyCache.isFull());
+                                }
+                                if (proxy)
+                                {
+                                    out.proxy = ProxyCache::create(*out.image);
+                                }
+                            }
+                            const std::chrono::duration<float> delta = std::chrono::steady_clock::now() - start;
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            ++_decodeStats.frames;
+                            _decodeStats.seconds += delta.count();
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _logSystem->log(
+                                "djv::AV::ISequenceRead",
+                                String::Format("{0}: {1}").arg(fileName).arg(e.what()),
+                                LogLevel::Error);
+                        }
+                        return out;
+                    });
+            }
+
+            std::future<ISequenceRead::Future> ISequenceRead::_getProxyFuture(Frame::Number i, std::string fileName)
             {
                 return std::async(
                     std::launch::async,
@@ -290,7 +509,10 @@ namespace djv
                         out.frame = i;
                         try
                         {
-                            out.image = _readImage(fileName);
+                            if (auto image = _readProxy(fileName, ProxyCache::getScale()))
+                            {
+                                out.proxy = ProxyCache::create(*image);
+                            }
                         }
                         catch (const std::exception& e)
                         {
@@ -309,14 +531,14 @@ namespace djv
 
                 // Get frames to be added to the queue.
                 const size_t sequenceSize = _sequence.getSize();
-                std::vector<std::pair<Frame::Number, std::shared_ptr<Image::Image> > > images;
+                std::vector<VideoFrame> frames;
                 std::vector<std::future<Future> > futures;
                 for (size_t i = 0; i < count; ++i)
                 {
-                    std::shared_ptr<Image::Image> cachedImage;
-                    if (cacheEnabled && _cache.get(p.frame, cachedImage))
+                    VideoFrame cachedFrame;
+                    if (cacheEnabled && _cache.get(p.frame, cachedFrame))
                     {
-                        images.push_back(std::make_pair(p.frame, cachedImage));
+                        frames.push_back(cachedFrame);
                     }
                     else
                     {
@@ -326,13 +548,13 @@ namespace djv
                             {
                                 const Frame::Number frameNumber = _sequence.getFrame(p.frame);
                                 const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
+                                futures.push_back(_getFuture(p.frame, fileName, true));
                             }
                         }
                         else
                         {
                             const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
+                            futures.push_back(_getFuture(p.frame, fileName, true));
                         }
                     }
 
@@ -363,26 +585,26 @@ namespace djv
                 for (auto& future : futures)
                 {
                     const auto result = future.get();
-                    images.push_back(std::make_pair(result.frame, result.image));
-                    if (cacheEnabled)
+                    const VideoFrame frame(result.frame, result.image, result.layers);
+                    frames.push_back(frame);
+                    if (cacheEnabled && result.image && _cache.getTime(result.frame) >= 0.F)
                     {
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
+                        detach(frame);
+                        _cache.add(frame);
                     }
+                    _addProxy(result);
                 }
 
                 // Add the frames to the queue.
                 {
                     std::lock_guard<std::mutex> lock(_mutex);
-                    for (const auto& i : images)
+                    for (const auto& i : frames)
                     {
                         if (_videoQueue.getCount() >= _videoQueue.getMax())
                         {
                             break;
                         }
-                        _videoQueue.addFrame(VideoFrame(i.first, i.second));
+                        _videoQueue.addFrame(i);
                     }
                 }
 
@@ -395,11 +617,50 @@ namespace djv
                 return futures.size();
             }
 
-            void ISequenceRead::_readCache(size_t count, const AV::IO::InOutPoints& inOutPoints)
+            void ISequenceRead::_readAhead(size_t count, bool loop, bool cacheEnabled)
+            {
+                DJV_PRIVATE_PTR();
+                std::vector<std::string> fileNames;
+                const Frame::Number sequenceSize = static_cast<Frame::Number>(_sequence.getSize());
+                Frame::Number frame = p.frame;
+                for (size_t i = 0; i < count && frame >= 0 && frame < sequenceSize; ++i)
+                {
+                    if (!cacheEnabled || !_cache.contains(frame))
+                    {
+                        fileNames.push_back(_fileInfo.getFileName(_sequence.getFrame(frame)));
+                    }
+                    switch (p.direction)
+                    {
+                    case Direction::Forward:
+                        ++frame;
+                        if (loop && frame >= sequenceSize)
+                        {
+                            frame = 0;
+                        }
+                        break;
+                    case Direction::Reverse:
+                        --frame;
+                        if (loop && frame < 0)
+                        {
+                            frame = sequenceSize - 1;
+                        }
+                        break;
+                    default: break;
+                    }
+                    if (frame == p.frame)
+                    {
+                        break;
+                    }
+                }
+                p.readAhead->request(fileNames);
+            }
+
+            void ISequenceRead::_readCache(size_t count, const Playhead& value)
             {
                 DJV_PRIVATE_PTR();
 
-                // Get frames to be added to the cache.
+                // Get frames to be added to the cache, the cache plans which
+                // frames are needed first.
                 Frame::Number frame = Frame::invalid;
                 {
                     std::lock_guard<std::mutex> lock(_mutex);
@@ -410,82 +671,94 @@ namespace djv
                 }
                 if (count > 0 && frame != Frame::invalid)
                 {
-                    const size_t sequenceSize = _sequence.getSize();
-                    const auto range = inOutPoints.getRange(_sequence.getSize());
-                    _cache.setDirection(p.direction);
+                    Playhead playhead = value;
+                    playhead.direction = p.direction;
+                    _cache.setPlayhead(playhead);
                     _cache.setCurrentFrame(frame);
-                    const size_t readBehind = _cache.getReadBehind();
-                    switch (p.direction)
-                    {
-                    case Direction::Forward:
+                    for (const auto i : _cache.getReadOrder())
                     {
-                        for (size_t i = 0; i < readBehind; ++i)
+                        if (p.cacheFutures.size() >= count)
                         {
-                            --frame;
-                            if (frame < range.min)
-                            {
-                                frame = range.max;
-                            }
+                            break;
                         }
-                        const size_t max = std::min(_cache.getMax(), sequenceSize);
-                        for (size_t i = 0; i < max && p.cacheFutures.size() < count; ++i)
+                        if (!_cache.contains(i) && p.cacheFrames.find(i) == p.cacheFrames.end())
                         {
-                            if (!_cache.contains(frame))
-                            {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
-                            }
-                            ++frame;
-                            if (frame > range.max)
-                            {
-                                frame = range.min;
-                            }
+                            const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(i));
+                            p.cacheFutures.push_back(_getFuture(i, fileName));
+                            p.cacheFrames.insert(i);
                         }
-                        break;
                     }
-                    case Direction::Reverse:
+                }
+
+                // Get the results.
+                auto i = p.cacheFutures.begin();
+                while (i != p.cacheFutures.end())
+                {
+                    if (i->valid() &&
+                        i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        for (size_t i = 0; i < readBehind; ++i)
-                        {
-                            ++frame;
-                            if (frame > range.max)
-                            {
-                                frame = range.min;
-                            }
-                        }
-                        const size_t max = std::min(_cache.getMax(), sequenceSize);
-                        for (Frame::Number i = 0; i < max && p.cacheFutures.size() < count; ++i)
+                        const auto result = i->get();
+                        p.cacheFrames.erase(result.frame);
+                        // Frames that are no longer planned are not detached
+                        // since they will not be added.
+                        if (result.image && _cache.getTime(result.frame) >= 0.F)
                         {
-                            if (!_cache.contains(frame))
-                            {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
-                            }
-                            --frame;
-                            if (frame < range.min)
-                            {
-                                frame = range.max;
-                            }
+                            const VideoFrame frame(result.frame, result.image, result.layers);
+                            detach(frame);
+                            _cache.add(frame);
                         }
-                        break;
+                        _addProxy(result);
+                        i = p.cacheFutures.erase(i);
                     }
-                    default: break;
+                    else
+                    {
+                        ++i;
                     }
                 }
+            }
+
+            void ISequenceRead::_readProxies(size_t count, const AV::IO::InOutPoints& inOutPoints)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Start over when the in/out points change.
+                const size_t sequenceSize = _sequence.getSize();
+                const auto range = inOutPoints.getRange(sequenceSize);
+                if (range != p.proxyRange)
+                {
+                    p.proxyRange = range;
+                    p.proxyOrder = sequenceSize ? ProxyCache::getOrder(range) : std::vector<Frame::Index>();
+                    p.proxyIndex = 0;
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _proxyCache.crop(range);
+                }
+
+                // Get frames to be added to the proxies.
+                bool full = false;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    full = _proxyCache.isFull();
+                    while (p.proxyIndex < p.proxyOrder.size() && _proxyCache.contains(p.proxyOrder[p.proxyIndex]))
+                    {
+                        ++p.proxyIndex;
+                    }
+                }
+                while (!full && p.proxyFutures.size() < count && p.proxyIndex < p.proxyOrder.size())
+                {
+                    const Frame::Index frame = p.proxyOrder[p.proxyIndex++];
+                    const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
+                    p.proxyFutures.push_back(_getProxyFuture(frame, fileName));
+                }
 
                 // Get the results.
-                auto i = p.cacheFutures.begin();
-                while (i != p.cacheFutures.end())
+                auto i = p.proxyFutures.begin();
+                while (i != p.proxyFutures.end())
                 {
                     if (i->valid() &&
                         i->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        const auto result = i->get();
-#if defined(DJV_MMAP)
-                        result.image->detach();
-#endif // DJV_MMAP
-                        _cache.add(result.frame, result.image);
-                        i = p.cacheFutures.erase(i);
+                        _addProxy(i->get());
+                        i = p.proxyFutures.erase(i);
                     }
                     else
                     {
@@ -494,6 +767,15 @@ namespace djv
                 }
             }
 
+            void ISequenceRead::_addProxy(const Future& value)
+            {
+                if (value.proxy)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _proxyCache.add(value.frame, value.proxy);
+                }
+            }
+
             struct ISequenceWrite::Private
             {
                 FileSystem::FileInfo fileInfo;
@@ -533,25 +815,31 @@ namespace djv
                     }
                 }
 
+                // The OpenGL context used to convert images is only available
+                // when there is a display, otherwise images are converted on
+                // the CPU.
+                if (glfwGetCurrentContext())
+                {
 #if defined(DJV_OPENGL_ES2)
-                glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+                    glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
 #else // DJV_OPENGL_ES2
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-                glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-                glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+                    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+                    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+                    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif // DJV_OPENGL_ES2
-                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-                if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
-                {
-                    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
-                }
-                p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
-                if (!p.glfwWindow)
-                {
-                    throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                    if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
+                    {
+                        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+                    }
+                    p.glfwWindow = glfwCreateWindow(100, 100, "djv::IO::ISequenceWrite", NULL, NULL);
+                    if (!p.glfwWindow)
+                    {
+                        throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
+                    }
                 }
 
                 p.running = true;
@@ -561,17 +849,20 @@ namespace djv
                     DJV_PRIVATE_PTR();
                     try
                     {
-                        glfwMakeContextCurrent(p.glfwWindow);
+                        if (p.glfwWindow)
+                        {
+                            glfwMakeContextCurrent(p.glfwWindow);
 #if defined(DJV_OPENGL_ES2)
-                        if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
+                            if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
 #else
-                        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                            if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 #endif
-                        {
-                            throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
-                        }
+                            {
+                                throw FileSystem::Error(_textSystem->getText(DJV_TEXT("error_glad_init")));
+                            }
 
-                        p.convert = Image::Convert::create(_resourceSystem);
+                            p.convert = Image::Convert::create(_resourceSystem);
+                        }
 
                         const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
                         while (p.running)
@@ -627,7 +918,16 @@ namespace djv
                                         const Image::Info imageInfo(image->getSize(), imageType, imageLayout);
                                         auto tmp = Image::Image::create(imageInfo);
                                         tmp->setTags(image->getTags());
-                                        p.convert->process(*image, imageInfo, *tmp);
+                                        if (p.convert)
+                                        {
+                                            p.convert->process(*image, imageInfo, *tmp);
+                                        }
+                                        else if (!convertCPU(*image, *tmp))
+                                        {
+                                            throw FileSystem::Error(String::Format("{0}: {1}").
+                                                arg(fileName).
+                                                arg(_textSystem->getText(DJV_TEXT("error_unsupported_image_type"))));
+                                        }
                                         image = tmp;
                                     }
                                     futures.push_back(std::async(
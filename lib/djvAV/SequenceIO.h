@@ -6,6 +6,7 @@
 
 #include <djvAV/IO.h>
 
+#include <djvCore/FileIO.h>
 #include <djvCore/Frame.h>
 
 namespace djv
@@ -39,18 +40,42 @@ namespace djv
             protected:
                 virtual Info _readInfo(const std::string & fileName) = 0;
                 virtual std::shared_ptr<Image::Image> _readImage(const std::string & fileName) = 0;
+
+                //! Read all of the layers in a single pass. The default
+                //! implementation only reads the current layer.
+                virtual std::vector<std::shared_ptr<Image::Image> > _readLayers(const std::string & fileName);
+
+                //! Read an image for a proxy. Readers that support
+                //! multi-resolution files can read a level close to the given
+                //! scale. The default implementation reads the current layer
+                //! at full resolution.
+                virtual std::shared_ptr<Image::Image> _readProxy(const std::string & fileName, float scale);
+
                 void _finish();
 
+                //! Open a file for reading with the read type. Normal reads use
+                //! the read-ahead data if it is available.
+                //! Throws:
+                //! - Core::FileSystem::Error
+                void _openFile(const std::string & fileName, const std::shared_ptr<Core::FileSystem::FileIO>&);
+
                 Core::Time::Speed _speed;
                 Core::Frame::Sequence _sequence;
 
+                //! How files are read, this should be set before _init() is called.
+                Core::FileSystem::ReadType _readType = Core::FileSystem::ReadType::First;
+
             private:
                 bool _hasWork() const;
                 size_t _getQueueCount(size_t threadCount) const;
                 struct Future;
-                std::future<Future> _getFuture(Core::Frame::Number, std::string fileName);
+                std::future<Future> _getFuture(Core::Frame::Number, std::string fileName, bool proxyReplace = false);
+                std::future<Future> _getProxyFuture(Core::Frame::Number, std::string fileName);
                 size_t _readQueue(size_t count, bool loop, bool cacheEnabled);
-                void _readCache(size_t count, const AV::IO::InOutPoints&);
+                void _readCache(size_t count, const Playhead&);
+                void _readAhead(size_t count, bool loop, bool cacheEnabled);
+                void _readProxies(size_t count, const AV::IO::InOutPoints&);
+                void _addProxy(const Future&);
 
                 DJV_PRIVATE();
             };
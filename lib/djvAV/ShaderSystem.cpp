@@ -43,6 +43,7 @@ namespace djv
             {
                 auto out = std::shared_ptr<ShaderSystem>(new ShaderSystem);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
 
@@ -4,57 +4,168 @@
 
 #include <djvAV/Tags.h>
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
 namespace djv
 {
     namespace AV
     {
+        namespace
+        {
+            typedef std::map<std::string, std::string> Map;
+
+            const Map    emptyTags;
+            const size_t sweepSizeMin = 64;
+
+            size_t getHash(const Map& value)
+            {
+                size_t out = 0;
+                const std::hash<std::string> hash;
+                for (const auto& i : value)
+                {
+                    out ^= hash(i.first) + 0x9e3779b9 + (out << 6) + (out >> 2);
+                    out ^= hash(i.second) + 0x9e3779b9 + (out << 6) + (out >> 2);
+                }
+                return out;
+            }
+
+            //! This class provides the maps that are shared between tags. The
+            //! maps are only weakly referenced so they are released when the
+            //! last tags using them are destroyed.
+            class SharedTags
+            {
+            public:
+                std::shared_ptr<Map> get(const std::shared_ptr<Map>& value)
+                {
+                    std::shared_ptr<Map> out;
+                    const size_t hash = getHash(*value);
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    auto range = _maps.equal_range(hash);
+                    auto i = range.first;
+                    while (i != range.second)
+                    {
+                        if (auto map = i->second.lock())
+                        {
+                            if (*map == *value)
+                            {
+                                out = map;
+                                break;
+                            }
+                            ++i;
+                        }
+                        else
+                        {
+                            i = _maps.erase(i);
+                        }
+                    }
+                    if (!out)
+                    {
+                        // The shared maps are never modified, so the map is
+                        // copied if other tags that can modify it refer to it.
+                        out = value.use_count() > 1 ? std::make_shared<Map>(*value) : value;
+                        _maps.insert(std::make_pair(hash, std::weak_ptr<Map>(out)));
+                        if (_maps.size() > _sweepSize)
+                        {
+                            for (auto j = _maps.begin(); j != _maps.end();)
+                            {
+                                j = j->second.expired() ? _maps.erase(j) : std::next(j);
+                            }
+                            _sweepSize = std::max(_maps.size() * 2, sweepSizeMin);
+                        }
+                    }
+                    return out;
+                }
+
+            private:
+                std::unordered_multimap<size_t, std::weak_ptr<Map> > _maps;
+                size_t _sweepSize = sweepSizeMin;
+                std::mutex _mutex;
+            };
+
+            SharedTags& getSharedTags()
+            {
+                static SharedTags sharedTags;
+                return sharedTags;
+            }
+
+        } // namespace
+
         const std::string Tags::_empty;
 
         Tags::Tags()
         {}
-        
+
         bool Tags::isEmpty() const
         {
-            return 0 == _tags.size();
+            return !_tags || 0 == _tags->size();
         }
 
         size_t Tags::getCount() const
         {
-            return _tags.size();
+            return _tags ? _tags->size() : 0;
         }
 
         const std::map<std::string, std::string> & Tags::getTags() const
         {
-            return _tags;
+            return _tags ? *_tags : emptyTags;
         }
 
         bool Tags::hasTag(const std::string& key) const
         {
-            return _tags.find(key) != _tags.end();
+            return _tags && _tags->find(key) != _tags->end();
         }
 
         const std::string & Tags::getTag(const std::string & key) const
         {
-            static const std::string empty;
-            const auto i = _tags.find(key);
-            return i != _tags.end() ? i->second : _empty;
+            if (_tags)
+            {
+                const auto i = _tags->find(key);
+                if (i != _tags->end())
+                {
+                    return i->second;
+                }
+            }
+            return _empty;
         }
 
         void Tags::setTags(const std::map<std::string, std::string> & tags)
         {
-            _tags = tags;
+            _tags = tags.size() ? std::make_shared<Map>(tags) : nullptr;
+            _shared = false;
         }
 
         void Tags::setTag(const std::string & key, const std::string & value)
         {
-            _tags[key] = value;
+            // Copy the map if anything else can see it.
+            if (!_tags)
+            {
+                _tags = std::make_shared<Map>();
+            }
+            else if (_shared || _tags.use_count() > 1)
+            {
+                _tags = std::make_shared<Map>(*_tags);
+            }
+            _shared = false;
+            (*_tags)[key] = value;
+        }
+
+        void Tags::share()
+        {
+            if (_tags && !_shared)
+            {
+                _tags = getSharedTags().get(_tags);
+                _shared = true;
+            }
         }
 
         bool Tags::operator == (const Tags & other) const
         {
-            return _tags == other._tags;
+            return _tags == other._tags || getTags() == other.getTags();
         }
 
     } // namespace AV
 } // namespace djv
-
@@ -7,6 +7,7 @@
 #include <djvAV/AV.h>
 
 #include <map>
+#include <memory>
 #include <string>
 
 namespace djv
@@ -14,11 +15,14 @@ namespace djv
     namespace AV
     {
         //! This class provides string tags.
+        //!
+        //! The tags are stored in a reference counted map that is copied on
+        //! write, so copying tags only increments a reference count.
         class Tags
         {
         public:
             Tags();
-            
+
             bool isEmpty() const;
             size_t getCount() const;
             const std::map<std::string, std::string>& getTags() const;
@@ -28,10 +32,16 @@ namespace djv
             void setTags(const std::map<std::string, std::string>&);
             void setTag(const std::string& key, const std::string& value);
 
+            //! Share the map with any other tags that have the same values.
+            //! This is used so the frames of a sequence with identical
+            //! headers use a single copy of the tags.
+            void share();
+
             bool operator == (const Tags&) const;
 
         private:
-            std::map<std::string, std::string> _tags;
+            std::shared_ptr<std::map<std::string, std::string> > _tags;
+            bool _shared = false;
             static const std::string _empty;
         };
 
@@ -28,6 +28,11 @@ namespace djv
                     return out;
                 }
 
+                bool Plugin::hasDecodeThreads() const
+                {
+                    return true;
+                }
+
                 std::shared_ptr<IRead> Plugin::read(const FileSystem::FileInfo& fileInfo, const ReadOptions& options) const
                 {
                     return Read::create(fileInfo, options, _textSystem, _resourceSystem, _logSystem);
@@ -45,10 +45,11 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string & fileName) override;
 
                 private:
-                    Info _open(const std::string &, const std::shared_ptr<Core::FileSystem::FileIO>&);
-
-                    bool _bgr = false;
-                    bool _compression = false;
+                    Info _open(
+                        const std::string &,
+                        const std::shared_ptr<Core::FileSystem::FileIO>&,
+                        bool& bgr,
+                        bool& compression);
                 };
                 
                 //! This class provides the Targa file I/O plugin.
@@ -62,6 +63,7 @@ namespace djv
                 public:
                     static std::shared_ptr<Plugin> create(const std::shared_ptr<Core::Context>&);
 
+                    bool hasDecodeThreads() const override;
                     std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&, const ReadOptions&) const override;
                 };
 
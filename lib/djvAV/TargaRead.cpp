@@ -9,6 +9,8 @@
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -42,11 +44,15 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     auto io = FileSystem::FileIO::create();
-                    return _open(fileName, io);
+                    bool bgr = false;
+                    bool compression = false;
+                    return _open(fileName, io, bgr, compression);
                 }
 
                 namespace
                 {
+                    // Decompress RLE data. Returns the end of the data that was
+                    // read or null if the data is not valid.
                     const uint8_t* readRle(
                         const uint8_t* in,
                         const uint8_t* end,
@@ -58,79 +64,78 @@ namespace djv
                         while (out < outEnd)
                         {
                             // Information.
-                            if (in > end)
+                            if (in >= end)
                             {
-                                return 0;
+                                return nullptr;
                             }
-                            const uint8_t count  = (*in & 0x7f) + 1;
-                            const bool    run    = (*in & 0x80) ? true : false;
-                            const size_t  length = run ? 1 : count;
+                            const size_t count  = (*in & 0x7f) + 1;
+                            const bool   run    = (*in & 0x80) ? true : false;
+                            const size_t length = run ? 1 : count;
                             ++in;
 
                             // Unpack.
-                            if (in + length * channels > end)
+                            if (in + length * channels > end ||
+                                out + count * channels > outEnd)
                             {
-                                return 0;
+                                return nullptr;
                             }
                             if (run)
                             {
-                                for (size_t j = 0; j < count; ++j, out += channels)
+                                if (1 == channels)
+                                {
+                                    memset(out, *in, count);
+                                }
+                                else
                                 {
-                                    switch (channels)
+                                    for (size_t j = 0; j < count; ++j)
                                     {
-                                    case 4:
-                                        out[3] = in[3];
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 3:
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 2:
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 1:
-                                        out[0] = in[0];
-                                        break;
-                                    default: break;
+                                        memcpy(out + j * channels, in, channels);
                                     }
                                 }
-                                in += channels;
                             }
                             else
                             {
-                                for (size_t j = 0; j < count; ++j, in += channels, out += channels)
+                                memcpy(out, in, count * channels);
+                            }
+                            in += length * channels;
+                            out += count * channels;
+                        }
+                        return in;
+                    }
+
+                    // Find the start of each scanline in the RLE data so they
+                    // can be decompressed in parallel. Returns false if a
+                    // packet crosses a scanline boundary, which the
+                    // specification discourages but does not forbid.
+                    bool getScanlines(
+                        const uint8_t*               in,
+                        const uint8_t*               end,
+                        size_t                       w,
+                        size_t                       h,
+                        size_t                       channels,
+                        std::vector<const uint8_t*>& out)
+                    {
+                        out.resize(h);
+                        for (size_t y = 0; y < h; ++y)
+                        {
+                            out[y] = in;
+                            size_t x = 0;
+                            while (x < w)
+                            {
+                                if (in >= end)
                                 {
-                                    switch (channels)
-                                    {
-                                    case 4:
-                                        out[3] = in[3];
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 3:
-                                        out[2] = in[2];
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 2:
-                                        out[1] = in[1];
-                                        out[0] = in[0];
-                                        break;
-                                    case 1:
-                                        out[0] = in[0];
-                                        break;
-                                    default: break;
-                                    }
+                                    return false;
                                 }
+                                const size_t count = (*in & 0x7f) + 1;
+                                in += 1 + ((*in & 0x80) ? 1 : count) * channels;
+                                x += count;
+                            }
+                            if (x != w)
+                            {
+                                return false;
                             }
                         }
-                        return in;
+                        return true;
                     }
 
                 } // namespace
@@ -139,52 +144,85 @@ namespace djv
                 {
                     std::shared_ptr<Image::Image> out;
                     auto io = FileSystem::FileIO::create();
-                    const auto info = _open(fileName, io);
+                    bool bgr = false;
+                    bool compression = false;
+                    const auto info = _open(fileName, io, bgr, compression);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
 
                     const Image::Info& imageInfo = info.video[0].info;
+                    const size_t w = imageInfo.size.w;
+                    const size_t h = imageInfo.size.h;
                     const size_t channels = Image::getChannelCount(imageInfo.type);
-                    if (!_compression)
+                    const size_t scanlineByteCount = out->getScanlineByteCount();
+                    uint8_t* outData = out->getData();
+                    std::vector<uint8_t> tmp;
+                    std::vector<const uint8_t*> scanlines;
+                    if (!compression)
                     {
-                        io->read(out->getData(), out->getDataByteCount());
+                        io->read(outData, out->getDataByteCount());
                     }
                     else
                     {
-                        const size_t tmpSize = out->getDataByteCount();
-                        std::vector<uint8_t> tmp(tmpSize);
-                        io->read(tmp.data(), tmpSize);
-                        const uint8_t* p = tmp.data();
-                        const uint8_t* const end = p + tmpSize;
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        tmp.resize(io->getSize() - io->getPos());
+                        io->read(tmp.data(), tmp.size());
+                        if (!getScanlines(tmp.data(), tmp.data() + tmp.size(), w, h, channels, scanlines))
                         {
-                            p = readRle(
-                                p,
-                                end,
-                                out->getData(0, y),
-                                imageInfo.size.w,
-                                channels);
-                            if (!p)
-                            {
-                                throw FileSystem::Error(String::Format("{0}: {1}").
-                                    arg(fileName).
-                                    arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
-                            }
+                            // Decompress the image as a single block.
+                            scanlines.clear();
                         }
                     }
 
-                    if (_bgr)
+                    // Decompress the scanlines and convert from BGR in
+                    // parallel.
+                    const uint8_t* const tmpEnd = tmp.data() + tmp.size();
+                    const size_t threadCount = (compression && scanlines.empty()) || (!compression && !bgr) ?
+                        1 :
+                        std::min(getDecodeThreadCount(), std::max(h, static_cast<size_t>(1)));
+                    std::vector<std::future<bool> > futures;
+                    for (size_t i = 0; i < threadCount; ++i)
                     {
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
-                        {
-                            uint8_t* p = out->getData(0, y);
-                            for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += channels)
+                        futures.push_back(std::async(
+                            threadCount > 1 ? std::launch::async : std::launch::deferred,
+                            [&tmp, &scanlines, outData, tmpEnd, w, h, channels, scanlineByteCount, compression, bgr, threadCount, i]
                             {
-                                const uint8_t tmp = p[0];
-                                p[0] = p[2];
-                                p[2] = tmp;
-                            }
-                        }
+                                const size_t y0 = h * i / threadCount;
+                                const size_t y1 = h * (i + 1) / threadCount;
+                                if (compression && !readRle(
+                                    scanlines.size() ? scanlines[y0] : tmp.data(),
+                                    tmpEnd,
+                                    outData + y0 * scanlineByteCount,
+                                    (y1 - y0) * w,
+                                    channels))
+                                {
+                                    return false;
+                                }
+                                if (bgr)
+                                {
+                                    for (size_t y = y0; y < y1; ++y)
+                                    {
+                                        uint8_t* p = outData + y * scanlineByteCount;
+                                        for (size_t x = 0; x < w; ++x, p += channels)
+                                        {
+                                            const uint8_t t = p[0];
+                                            p[0] = p[2];
+                                            p[2] = t;
+                                        }
+                                    }
+                                }
+                                return true;
+                            }));
+                    }
+                    bool valid = true;
+                    for (auto& i : futures)
+                    {
+                        valid &= i.get();
+                    }
+                    if (!valid)
+                    {
+                        throw FileSystem::Error(String::Format("{0}: {1}").
+                            arg(fileName).
+                            arg(_textSystem->getText(DJV_TEXT("error_read_scanline"))));
                     }
 
                     return out;
@@ -322,11 +360,12 @@ namespace djv
                             11 == _data.imageType;
                         info.layout.endian = Memory::Endian::LSB;
 
+                        // Compressed data may be smaller than the image.
                         const size_t ioSize = io->getSize();
                         const size_t ioPos = io->getPos();
                         const size_t fileDataByteCount = ioSize > 0 ? (ioSize - ioPos) : 0;
                         const size_t dataByteCount = info.getDataByteCount();
-                        if (dataByteCount > fileDataByteCount)
+                        if (!compression && dataByteCount > fileDataByteCount)
                         {
                             throw FileSystem::Error(String::Format("{0}: {1}").
                                 arg(io->getFileName()).
@@ -336,12 +375,16 @@ namespace djv
 
                 } // namespace
 
-                Info Read::_open(const std::string & fileName, const std::shared_ptr<FileSystem::FileIO>& io)
+                Info Read::_open(
+                    const std::string & fileName,
+                    const std::shared_ptr<FileSystem::FileIO>& io,
+                    bool& bgr,
+                    bool& compression)
                 {
                     io->setEndianConversion(Memory::getEndian() != Memory::Endian::LSB);
-                    io->open(fileName, FileSystem::FileIO::Mode::Read);
+                    _openFile(fileName, io);
                     Image::Info imageInfo;
-                    Header().read(io, imageInfo, _bgr, _compression, _textSystem);
+                    Header().read(io, imageInfo, bgr, compression, _textSystem);
                     auto info = Info(fileName, VideoInfo(imageInfo, _speed, _sequence));
                     return info;
                 }
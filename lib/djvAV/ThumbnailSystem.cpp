@@ -5,22 +5,20 @@
 #include <djvAV/ThumbnailSystem.h>
 
 #include <djvAV/Image.h>
-#include <djvAV/ImageConvert.h>
+#include <djvAV/ImageUtil.h>
 #include <djvAV/IO.h>
 
 #include <djvCore/Cache.h>
 #include <djvCore/Context.h>
 #include <djvCore/LogSystem.h>
-#include <djvCore/OS.h>
-#include <djvCore/ResourceSystem.h>
-#include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
 
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
-
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <list>
 #include <mutex>
+#include <set>
 #include <thread>
 
 using namespace djv::Core;
@@ -32,22 +30,23 @@ namespace djv
         namespace
         {
             //! \todo Should this be configurable?
-            const size_t infoProcessMax  = 4;
-            const size_t imageProcessMax = 4;
+            const size_t workerCountMax  = 4;
             const size_t infoCacheMax    = 1000;
             const size_t imageCacheMax   = 1000;
+            const size_t latencySamples  = 100;
 
             struct InfoRequest
             {
                 InfoRequest() :
-                    uid(createUID())
+                    uid(createUID()),
+                    time(std::chrono::steady_clock::now())
                 {}
 
                 InfoRequest(InfoRequest&& other) noexcept :
                     uid(other.uid),
+                    priority(other.priority),
+                    time(other.time),
                     fileInfo(other.fileInfo),
-                    read(std::move(other.read)),
-                    infoFuture(std::move(other.infoFuture)),
                     promise(std::move(other.promise))
                 {}
 
@@ -59,33 +58,35 @@ namespace djv
                     if (this != &other)
                     {
                         uid = other.uid;
+                        priority = other.priority;
+                        time = other.time;
                         fileInfo = other.fileInfo;
-                        read = std::move(other.read);
-                        infoFuture = std::move(other.infoFuture);
                         promise = std::move(other.promise);
                     }
                     return *this;
                 }
 
                 UID uid = 0;
+                ThumbnailSystem::Priority priority = ThumbnailSystem::Priority::Normal;
+                std::chrono::steady_clock::time_point time;
                 FileSystem::FileInfo fileInfo;
-                std::shared_ptr<IO::IRead> read;
-                std::future<IO::Info> infoFuture;
                 std::promise<IO::Info> promise;
             };
 
             struct ImageRequest
             {
                 ImageRequest() :
-                    uid(createUID())
+                    uid(createUID()),
+                    time(std::chrono::steady_clock::now())
                 {}
 
                 ImageRequest(ImageRequest && other) noexcept :
                     uid(other.uid),
+                    priority(other.priority),
+                    time(other.time),
                     fileInfo(other.fileInfo),
                     size(std::move(other.size)),
                     type(std::move(other.type)),
-                    read(std::move(other.read)),
                     promise(std::move(other.promise))
                 {}
 
@@ -97,23 +98,57 @@ namespace djv
                     if (this != &other)
                     {
                         uid = other.uid;
+                        priority = other.priority;
+                        time = other.time;
                         fileInfo = other.fileInfo;
                         size = std::move(other.size);
                         type = std::move(other.type);
-                        read = std::move(other.read);
                         promise = std::move(other.promise);
                     }
                     return *this;
                 }
 
                 UID uid = 0;
+                ThumbnailSystem::Priority priority = ThumbnailSystem::Priority::Normal;
+                std::chrono::steady_clock::time_point time;
                 FileSystem::FileInfo fileInfo;
                 Image::Size size;
                 Image::Type type = Image::Type::None;
-                std::shared_ptr<IO::IRead> read;
                 std::promise<std::shared_ptr<Image::Image> > promise;
             };
 
+            //! Get the request with the highest priority, the oldest request is
+            //! used if there are several.
+            template<typename T>
+            typename std::list<T>::iterator getNextRequest(std::list<T>& list)
+            {
+                auto out = list.begin();
+                for (auto i = list.begin(); i != list.end(); ++i)
+                {
+                    if (i->priority > out->priority)
+                    {
+                        out = i;
+                    }
+                }
+                return out;
+            }
+
+            template<typename T>
+            void setRequestPriority(std::list<T>& list, UID uid, ThumbnailSystem::Priority priority)
+            {
+                const auto i = std::find_if(
+                    list.begin(),
+                    list.end(),
+                    [uid](const T& value)
+                    {
+                        return value.uid == uid;
+                    });
+                if (i != list.end())
+                {
+                    i->priority = priority;
+                }
+            }
+
             size_t getInfoCacheKey(const FileSystem::FileInfo & fileInfo)
             {
                 size_t out = 0;
@@ -149,32 +184,29 @@ namespace djv
             uid(uid)
         {}
 
-        ThumbnailError::ThumbnailError(const std::string& what) :
-            std::runtime_error(what)
-        {}
-        
         struct ThumbnailSystem::Private
         {
-            std::shared_ptr<TextSystem> textSystem;
             std::shared_ptr<IO::System> io;
 
             std::list<InfoRequest> infoRequests;
             std::list<ImageRequest> imageRequests;
+            std::set<UID> working;
+            std::set<UID> canceled;
+            std::list<float> latency;
             std::condition_variable requestCV;
-            std::mutex requestMutex;
-            std::list<InfoRequest> pendingInfoRequests;
-            std::list<ImageRequest> pendingImageRequests;
+            mutable std::mutex requestMutex;
 
             Memory::Cache<size_t, IO::Info> infoCache;
             std::atomic<float> infoCachePercentage;
             Memory::Cache<size_t, std::shared_ptr<Image::Image> > imageCache;
             std::atomic<float> imageCachePercentage;
-            std::atomic<bool> clearCache;
+            std::mutex cacheMutex;
             std::shared_ptr<ValueObserver<bool> > ioOptionsObserver;
 
-            GLFWwindow * glfwWindow = nullptr;
             std::shared_ptr<Time::Timer> statsTimer;
-            std::thread thread;
+            size_t workerCount = 0;
+            std::once_flag workersFlag;
+            std::vector<std::thread> threads;
             std::atomic<bool> running;
         };
 
@@ -184,7 +216,6 @@ namespace djv
 
             DJV_PRIVATE_PTR();
 
-            p.textSystem = context->getSystemT<TextSystem>();
             p.io = context->getSystemT<IO::System>();
             addDependency(p.io);
 
@@ -192,111 +223,36 @@ namespace djv
             p.infoCachePercentage = 0.F;
             p.imageCache.setMax(imageCacheMax);
             p.imageCachePercentage = 0.F;
-            p.clearCache = false;
-
-#if defined(DJV_OPENGL_ES2)
-            glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
-#else // DJV_OPENGL_ES2
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
-            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif // DJV_OPENGL_ES2
-            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-            if (OS::getIntEnv("DJV_OPENGL_DEBUG") != 0)
-            {
-                glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
-            }
-            p.glfwWindow = glfwCreateWindow(100, 100, context->getName().c_str(), NULL, NULL);
-            if (!p.glfwWindow)
-            {
-                throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glfw_window_creation")));
-            }
 
+            auto weak = std::weak_ptr<ThumbnailSystem>(std::dynamic_pointer_cast<ThumbnailSystem>(shared_from_this()));
             p.statsTimer = Time::Timer::create(context);
             p.statsTimer->setRepeating(true);
             p.statsTimer->start(
                 Time::getTime(Time::TimerValue::VerySlow),
-                [this](const std::chrono::steady_clock::time_point&, const Time::Duration&)
-            {
-                DJV_PRIVATE_PTR();
-                std::stringstream ss;
-                {
-                    ss << "Info cache: " << p.infoCachePercentage << "%\n";
-                    ss << "Image cache: " << p.imageCachePercentage << '%';
-                }
-                _log(ss.str());
-            });
-
-            auto logSystem = context->getSystemT<LogSystem>();
-            auto resourceSystem = context->getSystemT<ResourceSystem>();
-            p.running = true;
-            p.thread = std::thread(
-                [this, resourceSystem, logSystem]
+                [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
             {
-                DJV_PRIVATE_PTR();
-                try
+                if (auto system = weak.lock())
                 {
-                    glfwMakeContextCurrent(p.glfwWindow);
-#if defined(DJV_OPENGL_ES2)
-                    if (!gladLoadGLES2Loader((GLADloadproc)glfwGetProcAddress))
-#else // DJV_OPENGL_ES2
-                    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-#endif // DJV_OPENGL_ES2
-                    {
-                        throw ThumbnailError(p.textSystem->getText(DJV_TEXT("error_glad_init")));
-                    }
-
-                    auto convert = Image::Convert::create(resourceSystem);
-
-                    const auto timeout = Time::getValue(Time::TimerValue::Medium);
-                    while (p.running)
+                    const auto stats = system->getStats();
+                    std::stringstream ss;
                     {
-                        if (p.clearCache)
-                        {
-                            p.clearCache = false;
-                            p.infoCache.clear();
-                            p.infoCachePercentage = 0.F;
-                            p.imageCache.clear();
-                            p.imageCachePercentage = 0.F;
-                        }
-
-                        bool infoRequests  = p.pendingInfoRequests.size();
-                        bool imageRequests = p.pendingImageRequests.size();
-                        {
-                            std::unique_lock<std::mutex> lock(p.requestMutex);
-                            if (p.requestCV.wait_for(
-                                lock,
-                                std::chrono::milliseconds(timeout),
-                                [this]
-                            {
-                                DJV_PRIVATE_PTR();
-                                return p.infoRequests.size() || p.imageRequests.size();
-                            }))
-                            {
-                                infoRequests  |= p.infoRequests.size () > 0;
-                                imageRequests |= p.imageRequests.size() > 0;
-                            }
-                        }
-                        if (infoRequests)
-                        {
-                            _handleInfoRequests();
-                        }
-                        if (imageRequests)
-                        {
-                            _handleImageRequests(convert);
-                        }
+                        ss << "Info cache: " << system->_p->infoCachePercentage << "%\n";
+                        ss << "Image cache: " << system->_p->imageCachePercentage << "%\n";
+                        ss << "Queue: " << stats.infoQueue << " info, " << stats.imageQueue << " image, " <<
+                            stats.working << " working\n";
+                        ss << "Latency (50/90/99%): " << stats.latency50 << "/" << stats.latency90 << "/" <<
+                            stats.latency99 << " seconds";
                     }
-                }
-                catch (const std::exception & e)
-                {
-                    logSystem->log("djv::AV::ThumbnailSystem", e.what(), LogLevel::Error);
+                    system->_log(ss.str());
                 }
             });
 
-            auto weak = std::weak_ptr<ThumbnailSystem>(std::dynamic_pointer_cast<ThumbnailSystem>(shared_from_this()));
+            // The worker threads are started by the first request.
+            p.running = true;
+            p.workerCount = std::max(
+                std::min(static_cast<size_t>(std::thread::hardware_concurrency()), workerCountMax),
+                static_cast<size_t>(1));
+
             p.ioOptionsObserver = ValueObserver<bool>::create(
                 p.io->observeOptionsChanged(),
                 [weak](bool value)
@@ -319,13 +275,13 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             p.running = false;
-            if (p.thread.joinable())
+            p.requestCV.notify_all();
+            for (auto& i : p.threads)
             {
-                p.thread.join();
-            }
-            if (p.glfwWindow)
-            {
-                glfwDestroyWindow(p.glfwWindow);
+                if (i.joinable())
+                {
+                    i.join();
+                }
             }
         }
 
@@ -333,21 +289,32 @@ namespace djv
         {
             auto out = std::shared_ptr<ThumbnailSystem>(new ThumbnailSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
-        ThumbnailSystem::InfoFuture ThumbnailSystem::getInfo(const FileSystem::FileInfo & fileInfo)
+        ThumbnailSystem::InfoFuture ThumbnailSystem::getInfo(const FileSystem::FileInfo & fileInfo, Priority priority)
         {
             DJV_PRIVATE_PTR();
             InfoRequest request;
+            request.priority = priority;
             request.fileInfo = fileInfo;
             auto future = request.promise.get_future();
+            const UID uid = request.uid;
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
                 p.infoRequests.push_back(std::move(request));
             }
+            _startWorkers();
             p.requestCV.notify_one();
-            return InfoFuture(future, request.uid);
+            return InfoFuture(future, uid);
+        }
+
+        void ThumbnailSystem::setInfoPriority(UID uid, Priority priority)
+        {
+            DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            setRequestPriority(p.infoRequests, uid, priority);
         }
         
         void ThumbnailSystem::cancelInfo(UID uid)
@@ -372,20 +339,31 @@ namespace djv
         ThumbnailSystem::ImageFuture ThumbnailSystem::getImage(
             const FileSystem::FileInfo& fileInfo,
             const Image::Size&          size,
-            Image::Type                 type)
+            Image::Type                 type,
+            Priority                    priority)
         {
             DJV_PRIVATE_PTR();
             ImageRequest request;
+            request.priority = priority;
             request.fileInfo = fileInfo;
             request.size = size;
             request.type = type;
             auto future = request.promise.get_future();
+            const UID uid = request.uid;
             {
                 std::unique_lock<std::mutex> lock(p.requestMutex);
                 p.imageRequests.push_back(std::move(request));
             }
+            _startWorkers();
             p.requestCV.notify_one();
-            return ImageFuture(future, request.uid);
+            return ImageFuture(future, uid);
+        }
+
+        void ThumbnailSystem::setImagePriority(UID uid, Priority priority)
+        {
+            DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            setRequestPriority(p.imageRequests, uid, priority);
         }
         
         void ThumbnailSystem::cancelImage(UID uid)
@@ -404,7 +382,39 @@ namespace djv
                 {
                     p.imageRequests.erase(--(i.base()));
                 }
+                else if (p.working.find(uid) != p.working.end())
+                {
+                    p.canceled.insert(uid);
+                }
+            }
+        }
+
+        ThumbnailSystem::Stats ThumbnailSystem::getStats() const
+        {
+            DJV_PRIVATE_PTR();
+            Stats out;
+            std::vector<float> latency;
+            {
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                out.infoQueue = p.infoRequests.size();
+                out.imageQueue = p.imageRequests.size();
+                out.working = p.working.size();
+                latency = std::vector<float>(p.latency.begin(), p.latency.end());
+            }
+            if (latency.size())
+            {
+                std::sort(latency.begin(), latency.end());
+                const size_t last = latency.size() - 1;
+                out.latency50 = latency[last * 50 / 100];
+                out.latency90 = latency[last * 90 / 100];
+                out.latency99 = latency[last * 99 / 100];
             }
+            return out;
+        }
+
+        size_t ThumbnailSystem::getWorkerCount() const
+        {
+            return _p->workerCount;
         }
 
         float ThumbnailSystem::getInfoCachePercentage() const
@@ -419,223 +429,216 @@ namespace djv
 
         void ThumbnailSystem::clearCache()
         {
-            _p->clearCache = true;
+            DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.cacheMutex);
+            p.infoCache.clear();
+            p.infoCachePercentage = 0.F;
+            p.imageCache.clear();
+            p.imageCachePercentage = 0.F;
         }
 
-        void ThumbnailSystem::_handleInfoRequests()
+        void ThumbnailSystem::_startWorkers()
         {
             DJV_PRIVATE_PTR();
-
-            // Process new requests.
-            while (p.pendingInfoRequests.size() < infoProcessMax)
-            {
-                InfoRequest i;
-                {
-                    std::unique_lock<std::mutex> lock(p.requestMutex);
-                    if (p.infoRequests.size())
-                    {
-                        i = std::move(p.infoRequests.front());
-                        p.infoRequests.pop_front();
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-                const auto key = getInfoCacheKey(i.fileInfo);
-                IO::Info info;
-                const bool cached = p.infoCache.get(key, info);
-                if (cached)
-                {
-                    i.promise.set_value(info);
-                }
-                else
+            std::call_once(
+                p.workersFlag,
+                [this]
                 {
-                    try
+                    DJV_PRIVATE_PTR();
+                    for (size_t i = 0; i < p.workerCount; ++i)
                     {
-                        i.read = p.io->read(i.fileInfo);
-                        i.infoFuture = i.read->getInfo();
-                        p.pendingInfoRequests.push_back(std::move(i));
-                    }
-                    catch (const std::exception &)
-                    {
-                        try
-                        {
-                            i.promise.set_exception(std::current_exception());
-                        }
-                        catch (const std::exception & e)
-                        {
-                            _log(e.what(), LogLevel::Error);
-                        }
+                        p.threads.push_back(std::thread(
+                            [this]
+                            {
+                                _work();
+                            }));
                     }
-                }
-            }
+                });
+        }
 
-            // Process pending requests.
-            auto i = p.pendingInfoRequests.begin();
-            while (i != p.pendingInfoRequests.end())
+        void ThumbnailSystem::_work()
+        {
+            DJV_PRIVATE_PTR();
+            const auto timeout = Time::getValue(Time::TimerValue::Medium);
+            const auto queueTimeout = Time::getValue(Time::TimerValue::VeryFast);
+            while (p.running)
             {
-                if (i->infoFuture.valid() &&
-                    i->infoFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                // Get the next request, information requests are serviced before
+                // image requests of the same priority since they are cheaper.
+                bool infoRequest = false;
+                bool imageRequest = false;
+                InfoRequest info;
+                ImageRequest image;
                 {
-                    try
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    if (p.requestCV.wait_for(
+                        lock,
+                        std::chrono::milliseconds(timeout),
+                        [this]
                     {
-                        const auto info = i->infoFuture.get();
-                        p.infoCache.add(getInfoCacheKey(i->fileInfo), info);
-                        p.infoCachePercentage = p.infoCache.getPercentageUsed();
-                        i->promise.set_value(info);
-                    }
-                    catch (const std::exception &)
+                        DJV_PRIVATE_PTR();
+                        return p.infoRequests.size() || p.imageRequests.size() || !p.running;
+                    }))
                     {
-                        try
+                        const auto i = getNextRequest(p.infoRequests);
+                        const auto j = getNextRequest(p.imageRequests);
+                        if (i != p.infoRequests.end() &&
+                            (j == p.imageRequests.end() || i->priority >= j->priority))
                         {
-                            i->promise.set_exception(std::current_exception());
+                            info = std::move(*i);
+                            p.infoRequests.erase(i);
+                            infoRequest = true;
                         }
-                        catch (const std::exception & e)
+                        else if (j != p.imageRequests.end())
                         {
-                            _log(e.what(), LogLevel::Error);
+                            image = std::move(*j);
+                            p.imageRequests.erase(j);
+                            p.working.insert(image.uid);
+                            imageRequest = true;
                         }
                     }
-                    i = p.pendingInfoRequests.erase(i);
                 }
-                else
-                {
-                    ++i;
-                }
-            }
-        }
 
-        void ThumbnailSystem::_handleImageRequests(const std::shared_ptr<Image::Convert> & convert)
-        {
-            DJV_PRIVATE_PTR();
-
-            // Process new requests.
-            while (p.pendingImageRequests.size() < imageProcessMax)
-            {
-                ImageRequest i;
-                {
-                    std::unique_lock<std::mutex> lock(p.requestMutex);
-                    if (p.imageRequests.size())
-                    {
-                        i = std::move(p.imageRequests.front());
-                        p.imageRequests.pop_front();
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-                const auto key = getImageCacheKey(i.fileInfo, i.size, i.type);
-                std::shared_ptr<Image::Image> image;
-                p.imageCache.get(key, image);
-                if (image)
-                {
-                    i.promise.set_value(image);
-                }
-                else
+                if (infoRequest)
                 {
                     try
                     {
-                        i.read = p.io->read(i.fileInfo);
-                        const auto info = i.read->getInfo().get();
-                        if (info.video.size() > 0)
+                        const auto key = getInfoCacheKey(info.fileInfo);
+                        IO::Info ioInfo;
+                        bool cached = false;
                         {
-                            p.pendingImageRequests.push_back(std::move(i));
+                            std::unique_lock<std::mutex> lock(p.cacheMutex);
+                            cached = p.infoCache.get(key, ioInfo);
                         }
-                        else
+                        if (!cached)
                         {
-                            i.promise.set_value(nullptr);
+                            ioInfo = p.io->read(info.fileInfo)->getInfo().get();
+                            std::unique_lock<std::mutex> lock(p.cacheMutex);
+                            p.infoCache.add(key, ioInfo);
+                            p.infoCachePercentage = p.infoCache.getPercentageUsed();
                         }
+                        info.promise.set_value(ioInfo);
                     }
                     catch (const std::exception&)
                     {
                         try
                         {
-                            i.promise.set_exception(std::current_exception());
+                            info.promise.set_exception(std::current_exception());
                         }
-                        catch (const std::exception &e)
+                        catch (const std::exception& e)
                         {
                             _log(e.what(), LogLevel::Error);
                         }
                     }
                 }
-            }
-
-            // Process pending requests.
-            auto i = p.pendingImageRequests.begin();
-            while (i != p.pendingImageRequests.end())
-            {
-                std::shared_ptr<Image::Image> image;
-                bool finished = false;
-                {
-                    std::lock_guard<std::mutex> lock(i->read->getMutex());
-                    auto& queue = i->read->getVideoQueue();
-                    if (!queue.isEmpty())
-                    {
-                        image = queue.getFrame().image;
-                    }
-                    if (queue.isFinished())
-                    {
-                        finished = true;
-                    }
-                }
-                if (image)
+                else if (imageRequest)
                 {
+                    bool canceled = false;
                     try
                     {
-                        Image::Size imageSize = image->getSize();
-                        imageSize.w *= image->getInfo().pixelAspectRatio;
-                        if (i->size != imageSize || i->type != Image::Type::None)
+                        const auto key = getImageCacheKey(image.fileInfo, image.size, image.type);
+                        std::shared_ptr<Image::Image> out;
                         {
-                            Image::Size size = i->size;
-                            const float aspect = size.h != 0 ? (size.w / static_cast<float>(size.h)) : 1.F;
-                            const float imageAspect = imageSize.h != 0 ? (imageSize.w / static_cast<float>(imageSize.h)) : 1.F;
-                            if (imageAspect < aspect)
+                            std::unique_lock<std::mutex> lock(p.cacheMutex);
+                            p.imageCache.get(key, out);
+                        }
+                        if (!out)
+                        {
+                            auto read = p.io->read(image.fileInfo);
+                            const auto ioInfo = read->getInfo().get();
+                            if (ioInfo.video.size() > 0)
                             {
-                                size.w = static_cast<uint16_t>(size.h * imageAspect);
+                                // Wait for the first frame.
+                                bool finished = false;
+                                while (!out && !finished && !canceled && p.running)
+                                {
+                                    {
+                                        std::lock_guard<std::mutex> lock(read->getMutex());
+                                        auto& queue = read->getVideoQueue();
+                                        if (!queue.isEmpty())
+                                        {
+                                            out = queue.getFrame().image;
+                                        }
+                                        finished = queue.isFinished();
+                                    }
+                                    canceled = _isCanceled(image.uid);
+                                    if (!out && !finished && !canceled)
+                                    {
+                                        std::this_thread::sleep_for(std::chrono::milliseconds(queueTimeout));
+                                    }
+                                }
                             }
-                            else
+                            if (out && !canceled)
                             {
-                                size.h = static_cast<int>(size.w / imageAspect);
+                                Image::Size imageSize = out->getSize();
+                                imageSize.w *= out->getInfo().pixelAspectRatio;
+                                if (image.size != imageSize || image.type != Image::Type::None)
+                                {
+                                    Image::Size size = image.size;
+                                    const float aspect = size.h != 0 ? (size.w / static_cast<float>(size.h)) : 1.F;
+                                    const float imageAspect = imageSize.h != 0 ? (imageSize.w / static_cast<float>(imageSize.h)) : 1.F;
+                                    if (imageAspect < aspect)
+                                    {
+                                        size.w = static_cast<uint16_t>(size.h * imageAspect);
+                                    }
+                                    else
+                                    {
+                                        size.h = static_cast<int>(size.w / imageAspect);
+                                    }
+                                    const auto type = image.type != Image::Type::None ? image.type : out->getType();
+                                    auto tmp = Image::Image::create(Image::Info(size, type));
+                                    tmp->setPluginName(out->getPluginName());
+                                    tmp->setTags(out->getTags());
+                                    Image::resize(*out, *tmp);
+                                    out = tmp;
+                                }
+                                std::unique_lock<std::mutex> lock(p.cacheMutex);
+                                p.imageCache.add(key, out);
+                                p.imageCachePercentage = p.imageCache.getPercentageUsed();
                             }
-                            const auto type = i->type != Image::Type::None ? i->type : image->getType();
-                            const auto info = Image::Info(size, type);
-                            auto tmp = Image::Image::create(info);
-                            tmp->setPluginName(image->getPluginName());
-                            tmp->setTags(image->getTags());
-                            convert->process(*image, info, *tmp);
-                            image = tmp;
                         }
-                        p.imageCache.add(getImageCacheKey(i->fileInfo, i->size, i->type), image);
-                        p.imageCachePercentage = p.imageCache.getPercentageUsed();
-                        i->promise.set_value(image);
+                        if (canceled)
+                        {
+                            // Canceled requests get an empty image so that anyone
+                            // waiting on the future is released.
+                            out.reset();
+                        }
+                        image.promise.set_value(out);
                     }
                     catch (const std::exception&)
                     {
                         try
                         {
-                            i->promise.set_exception(std::current_exception());
+                            image.promise.set_exception(std::current_exception());
                         }
                         catch (const std::exception& e)
                         {
                             _log(e.what(), LogLevel::Error);
                         }
                     }
-                }
-                else if (finished)
-                {
-                    i->promise.set_value(nullptr);
-                }
-                if (image || finished)
-                {
-                    i = p.pendingImageRequests.erase(i);
-                }
-                else
-                {
-                    ++i;
+
+                    const std::chrono::duration<float> latency = std::chrono::steady_clock::now() - image.time;
+                    std::unique_lock<std::mutex> lock(p.requestMutex);
+                    p.working.erase(image.uid);
+                    p.canceled.erase(image.uid);
+                    if (!canceled)
+                    {
+                        p.latency.push_back(latency.count());
+                        while (p.latency.size() > latencySamples)
+                        {
+                            p.latency.pop_front();
+                        }
+                    }
                 }
             }
         }
 
+        bool ThumbnailSystem::_isCanceled(UID uid) const
+        {
+            DJV_PRIVATE_PTR();
+            std::unique_lock<std::mutex> lock(p.requestMutex);
+            return p.canceled.find(uid) != p.canceled.end();
+        }
+
     } // namespace AV
 } // namespace djv
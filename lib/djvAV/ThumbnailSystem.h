@@ -35,19 +35,14 @@ namespace djv
         {
             class Size;
             class Info;
-            class Convert;
             class Image;
             
         } // namespace Image
             
-        //! This class provides a thumbnail error.
-        class ThumbnailError : public std::runtime_error
-        {
-        public:
-            explicit ThumbnailError(const std::string&);
-        };
-        
         //! This class provides a system for generating thumbnail images from files.
+        //!
+        //! Requests are serviced by a pool of worker threads in priority order,
+        //! and the images are resized on the CPU.
         class ThumbnailSystem : public Core::ISystem
         {
             DJV_NON_COPYABLE(ThumbnailSystem);
@@ -60,10 +55,17 @@ namespace djv
             virtual ~ThumbnailSystem();
 
             //! Create a new thumbnail system.
-            //! Throws:
-            //! - ThumbnailError
             static std::shared_ptr<ThumbnailSystem> create(const std::shared_ptr<Core::Context>&);
 
+            //! This enumeration provides request priorities. Requests with a
+            //! higher priority are serviced first.
+            enum class Priority
+            {
+                Low,
+                Normal,
+                High
+            };
+
             //! This structure provides information about a file.
             struct InfoFuture
             {
@@ -74,7 +76,10 @@ namespace djv
             };
             
             //! Get information about a file.
-            InfoFuture getInfo(const Core::FileSystem::FileInfo&);
+            InfoFuture getInfo(const Core::FileSystem::FileInfo&, Priority = Priority::Normal);
+
+            //! Change the priority of a file information request.
+            void setInfoPriority(Core::UID, Priority);
 
             //! Cancel information about a file.
             void cancelInfo(Core::UID);
@@ -92,11 +97,36 @@ namespace djv
             ImageFuture getImage(
                 const Core::FileSystem::FileInfo& path,
                 const Image::Size&                size,
-                Image::Type                       type = Image::Type::None);
+                Image::Type                       type     = Image::Type::None,
+                Priority                          priority = Priority::Normal);
 
-            //! Cancel a thumbnail image.
+            //! Change the priority of a thumbnail image request.
+            void setImagePriority(Core::UID, Priority);
+
+            //! Cancel a thumbnail image. Requests that are already being
+            //! processed are abandoned and their future is set to a null image.
             void cancelImage(Core::UID);
 
+            //! This struct provides request statistics.
+            struct Stats
+            {
+                size_t infoQueue  = 0;
+                size_t imageQueue = 0;
+                size_t working    = 0;
+
+                //! The percentiles of the image request latency in seconds,
+                //! measured from the request to the image being available.
+                float latency50 = 0.F;
+                float latency90 = 0.F;
+                float latency99 = 0.F;
+            };
+
+            //! Get the request statistics.
+            Stats getStats() const;
+
+            //! Get the number of worker threads.
+            size_t getWorkerCount() const;
+
             //! Get the infromation cache percentage used.
             float getInfoCachePercentage() const;
 
@@ -107,8 +137,9 @@ namespace djv
             void clearCache();
 
         private:
-            void _handleInfoRequests();
-            void _handleImageRequests(const std::shared_ptr<Image::Convert> &);
+            void _startWorkers();
+            void _work();
+            bool _isCanceled(Core::UID) const;
 
             DJV_PRIVATE();
         };
@@ -4,8 +4,14 @@
 
 #include <djvAV/TriangleMesh.h>
 
+#include <djvAV/TriangleMeshBVH.h>
+
 #include <glm/geometric.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace djv::Core;
 
 namespace djv
@@ -14,6 +20,212 @@ namespace djv
     {
         namespace Geom
         {
+            namespace
+            {
+                //! \todo Should these be configurable?
+                const size_t bvhTrianglesMin = 256;
+                const size_t vertexCacheSize = 32;
+                const float  vertexCacheDecayPower = 1.5F;
+                const float  vertexLastTriangleScore = .75F;
+                const float  vertexValenceBoostScale = 2.F;
+                const float  vertexValenceBoostPower = .5F;
+
+                inline size_t hashVertex(const TriangleMesh::Vertex& value)
+                {
+                    return
+                        static_cast<size_t>(value.v) * 73856093U ^
+                        static_cast<size_t>(value.t) * 19349663U ^
+                        static_cast<size_t>(value.n) * 83492791U;
+                }
+
+                inline bool compare(const glm::vec2& a, const glm::vec2& b)
+                {
+                    return a.x < b.x || (a.x == b.x && a.y < b.y);
+                }
+
+                inline bool compare(const glm::vec3& a, const glm::vec3& b)
+                {
+                    return a.x < b.x || (a.x == b.x && (a.y < b.y || (a.y == b.y && a.z < b.z)));
+                }
+
+                //! Find the unique values of a list. The remap maps each item to
+                //! its unique value, and the unique list contains the item that
+                //! represents each unique value.
+                template<typename T>
+                void getUniqueValues(size_t size, T compare, std::vector<uint32_t>& remap, std::vector<uint32_t>& unique)
+                {
+                    std::vector<uint32_t> order(size);
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        order[i] = static_cast<uint32_t>(i);
+                    }
+                    std::stable_sort(order.begin(), order.end(), compare);
+                    remap.resize(size);
+                    unique.clear();
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        if (0 == i || compare(unique.back(), order[i]))
+                        {
+                            unique.push_back(order[i]);
+                        }
+                        remap[order[i]] = static_cast<uint32_t>(unique.size() - 1);
+                    }
+                }
+
+                template<typename T>
+                std::vector<T> getValues(const std::vector<T>& values, const std::vector<uint32_t>& unique)
+                {
+                    std::vector<T> out;
+                    out.reserve(unique.size());
+                    for (const auto i : unique)
+                    {
+                        out.push_back(values[i]);
+                    }
+                    return out;
+                }
+
+                inline void remapIndex(uint32_t& index, const std::vector<uint32_t>& remap)
+                {
+                    if (index > 0 && index <= remap.size())
+                    {
+                        index = remap[index - 1] + 1;
+                    }
+                }
+
+                float getVertexScore(int cachePos, uint32_t activeTriangles)
+                {
+                    if (0 == activeTriangles)
+                    {
+                        return -1.F;
+                    }
+                    float out = 0.F;
+                    if (cachePos >= 0)
+                    {
+                        if (cachePos < 3)
+                        {
+                            // The vertices of the last triangle get a fixed score so
+                            // that strips are not favored over fans.
+                            out = vertexLastTriangleScore;
+                        }
+                        else
+                        {
+                            const float scale = 1.F / static_cast<float>(vertexCacheSize - 3);
+                            out = powf(1.F - (cachePos - 3) * scale, vertexCacheDecayPower);
+                        }
+                    }
+                    // Boost vertices with few remaining triangles so they are
+                    // finished off instead of being left behind.
+                    out += vertexValenceBoostScale * powf(static_cast<float>(activeTriangles), -vertexValenceBoostPower);
+                    return out;
+                }
+
+                bool intersectNearest(
+                    const glm::vec3 &    pos,
+                    const glm::vec3 &    dir,
+                    const TriangleMesh & mesh,
+                    glm::vec3 &          hit,
+                    size_t &             index,
+                    glm::vec3 &          barycentric)
+                {
+                    if (mesh.triangles.size() >= bvhTrianglesMin)
+                    {
+                        RayHit rayHit;
+                        if (mesh.getBVH()->intersect(Ray(pos, dir), rayHit))
+                        {
+                            hit = rayHit.pos;
+                            index = rayHit.triangle;
+                            barycentric = rayHit.barycentric;
+                            return true;
+                        }
+                        return false;
+                    }
+
+                    bool out = false;
+                    float closest = 0.F;
+                    bool first = true;
+                    size_t i = 0;
+                    for (const auto & triangle : mesh.triangles)
+                    {
+                        const glm::vec3 & v0 = mesh.v[triangle.v0.v - 1];
+                        const glm::vec3 & v1 = mesh.v[triangle.v1.v - 1];
+                        const glm::vec3 & v2 = mesh.v[triangle.v2.v - 1];
+                        glm::vec3 hitTemp;
+                        glm::vec3 barycentricTemp;
+                        if (TriangleMesh::intersectTriangle(pos, dir, v0, v1, v2, hitTemp, barycentricTemp))
+                        {
+                            const float distance = glm::distance(pos, hitTemp);
+                            if (distance < closest || first)
+                            {
+                                hit = hitTemp;
+                                out = true;
+                                closest = distance;
+                                barycentric = barycentricTemp;
+                                index = i;
+                                first = false;
+                            }
+                        }
+                        ++i;
+                    }
+                    return out;
+                }
+
+            } // namespace
+
+            TriangleMesh::TriangleMesh(const TriangleMesh& other) :
+                v(other.v),
+                c(other.c),
+                t(other.t),
+                n(other.n),
+                triangles(other.triangles),
+                bbox(other.bbox),
+                _uid(other._uid)
+            {}
+
+            TriangleMesh::TriangleMesh(TriangleMesh&& other) :
+                v(std::move(other.v)),
+                c(std::move(other.c)),
+                t(std::move(other.t)),
+                n(std::move(other.n)),
+                triangles(std::move(other.triangles)),
+                bbox(other.bbox),
+                _uid(other._uid)
+            {
+                other.bvhReset();
+            }
+
+            TriangleMesh& TriangleMesh::operator = (const TriangleMesh& other)
+            {
+                if (&other != this)
+                {
+                    v = other.v;
+                    c = other.c;
+                    t = other.t;
+                    n = other.n;
+                    triangles = other.triangles;
+                    bbox = other.bbox;
+                    _uid = other._uid;
+                    bvhReset();
+                }
+                return *this;
+            }
+
+            TriangleMesh& TriangleMesh::operator = (TriangleMesh&& other)
+            {
+                if (&other != this)
+                {
+                    v = std::move(other.v);
+                    c = std::move(other.c);
+                    t = std::move(other.t);
+                    n = std::move(other.n);
+                    triangles = std::move(other.triangles);
+                    bbox = other.bbox;
+                    _uid = other._uid;
+                    bvhReset();
+                    other.bvhReset();
+                }
+                return *this;
+            }
+
             void TriangleMesh::clear()
             {
                 v.clear();
@@ -21,6 +233,7 @@ namespace djv
                 t.clear();
                 n.clear();
                 triangles.clear();
+                bvhReset();
             }
 
             void TriangleMesh::bboxUpdate()
@@ -36,6 +249,22 @@ namespace djv
                 }
             }
 
+            std::shared_ptr<TriangleMeshBVH> TriangleMesh::getBVH() const
+            {
+                std::unique_lock<std::mutex> lock(_bvhMutex);
+                if (!_bvh)
+                {
+                    _bvh = TriangleMeshBVH::create(*this);
+                }
+                return _bvh;
+            }
+
+            void TriangleMesh::bvhReset()
+            {
+                std::unique_lock<std::mutex> lock(_bvhMutex);
+                _bvh.reset();
+            }
+
             void TriangleMesh::faceToTriangles(const Face & face, std::vector<Triangle> & triangles)
             {
                 const size_t size = face.v.size();
@@ -55,6 +284,272 @@ namespace djv
                 }
             }
 
+            void TriangleMesh::weld(const TriangleMesh & mesh, std::vector<Vertex> & vertices, std::vector<uint32_t> & indices)
+            {
+                vertices.clear();
+                indices.clear();
+                const size_t trianglesSize = mesh.triangles.size();
+                indices.reserve(trianglesSize * 3);
+
+                // Open addressing hash table of vertex list indices, sized for a
+                // load factor below one half.
+                size_t tableSize = 1;
+                while (tableSize < trianglesSize * 3 * 2)
+                {
+                    tableSize <<= 1;
+                }
+                const size_t tableMask = tableSize - 1;
+                const uint32_t empty = std::numeric_limits<uint32_t>::max();
+                std::vector<uint32_t> table(tableSize, empty);
+
+                for (const auto & triangle : mesh.triangles)
+                {
+                    for (const auto & vertex : { triangle.v0, triangle.v1, triangle.v2 })
+                    {
+                        size_t slot = hashVertex(vertex) & tableMask;
+                        while (table[slot] != empty && !(vertices[table[slot]] == vertex))
+                        {
+                            slot = (slot + 1) & tableMask;
+                        }
+                        if (empty == table[slot])
+                        {
+                            table[slot] = static_cast<uint32_t>(vertices.size());
+                            vertices.push_back(vertex);
+                        }
+                        indices.push_back(table[slot]);
+                    }
+                }
+            }
+
+            void TriangleMesh::weld(TriangleMesh & mesh)
+            {
+                std::vector<uint32_t> vRemap;
+                std::vector<uint32_t> tRemap;
+                std::vector<uint32_t> nRemap;
+                std::vector<uint32_t> unique;
+                const bool hasColors = mesh.c.size() > 0;
+                if (!hasColors || mesh.c.size() == mesh.v.size())
+                {
+                    const auto& v = mesh.v;
+                    const auto& c = mesh.c;
+                    getUniqueValues(
+                        v.size(),
+                        [&v, &c, hasColors](uint32_t a, uint32_t b)
+                        {
+                            return
+                                compare(v[a], v[b]) ||
+                                (hasColors && !compare(v[b], v[a]) && compare(c[a], c[b]));
+                        },
+                        vRemap,
+                        unique);
+                    mesh.v = getValues(mesh.v, unique);
+                    if (hasColors)
+                    {
+                        mesh.c = getValues(mesh.c, unique);
+                    }
+                }
+                {
+                    const auto& t = mesh.t;
+                    getUniqueValues(t.size(), [&t](uint32_t a, uint32_t b) { return compare(t[a], t[b]); }, tRemap, unique);
+                    mesh.t = getValues(mesh.t, unique);
+                }
+                {
+                    const auto& n = mesh.n;
+                    getUniqueValues(n.size(), [&n](uint32_t a, uint32_t b) { return compare(n[a], n[b]); }, nRemap, unique);
+                    mesh.n = getValues(mesh.n, unique);
+                }
+                for (auto& triangle : mesh.triangles)
+                {
+                    for (auto vertex : { &triangle.v0, &triangle.v1, &triangle.v2 })
+                    {
+                        remapIndex(vertex->v, vRemap);
+                        remapIndex(vertex->t, tRemap);
+                        remapIndex(vertex->n, nRemap);
+                    }
+                }
+
+                // Re-order the triangles for the vertex cache.
+                std::vector<Vertex> vertices;
+                std::vector<uint32_t> indices;
+                weld(mesh, vertices, indices);
+                optimizeVertexCache(indices, vertices.size());
+                for (size_t i = 0; i < mesh.triangles.size(); ++i)
+                {
+                    auto& triangle = mesh.triangles[i];
+                    triangle.v0 = vertices[indices[i * 3 + 0]];
+                    triangle.v1 = vertices[indices[i * 3 + 1]];
+                    triangle.v2 = vertices[indices[i * 3 + 2]];
+                }
+
+                mesh.bvhReset();
+            }
+
+            void TriangleMesh::optimizeVertexCache(std::vector<uint32_t> & indices, size_t vertexCount)
+            {
+                const size_t indicesSize = indices.size();
+                const size_t trianglesSize = indicesSize / 3;
+                if (trianglesSize < 2)
+                {
+                    return;
+                }
+
+                // Build the list of triangles that use each vertex.
+                std::vector<uint32_t> activeTriangles(vertexCount, 0);
+                for (size_t i = 0; i < trianglesSize * 3; ++i)
+                {
+                    ++activeTriangles[indices[i]];
+                }
+                std::vector<uint32_t> offsets(vertexCount + 1, 0);
+                for (size_t i = 0; i < vertexCount; ++i)
+                {
+                    offsets[i + 1] = offsets[i] + activeTriangles[i];
+                }
+                std::vector<uint32_t> vertexTriangles(trianglesSize * 3);
+                {
+                    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+                    for (size_t i = 0; i < trianglesSize * 3; ++i)
+                    {
+                        vertexTriangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+                    }
+                }
+
+                std::vector<int> cachePos(vertexCount, -1);
+                std::vector<float> vertexScores(vertexCount);
+                for (size_t i = 0; i < vertexCount; ++i)
+                {
+                    vertexScores[i] = getVertexScore(-1, activeTriangles[i]);
+                }
+                std::vector<float> triangleScores(trianglesSize);
+                std::vector<bool> triangleAdded(trianglesSize, false);
+                size_t best = 0;
+                for (size_t i = 0; i < trianglesSize; ++i)
+                {
+                    triangleScores[i] =
+                        vertexScores[indices[i * 3 + 0]] +
+                        vertexScores[indices[i * 3 + 1]] +
+                        vertexScores[indices[i * 3 + 2]];
+                    if (triangleScores[i] > triangleScores[best])
+                    {
+                        best = i;
+                    }
+                }
+
+                std::vector<uint32_t> out;
+                out.reserve(trianglesSize * 3);
+                std::vector<uint32_t> cache;
+                std::vector<uint32_t> cacheNew;
+                cache.reserve(vertexCacheSize + 3);
+                cacheNew.reserve(vertexCacheSize + 3);
+                size_t cursor = 0;
+                for (size_t i = 0; i < trianglesSize; ++i)
+                {
+                    if (best >= trianglesSize)
+                    {
+                        // None of the triangles touching the cache are left, fall
+                        // back to the next triangle that has not been added.
+                        while (triangleAdded[cursor])
+                        {
+                            ++cursor;
+                        }
+                        best = cursor;
+                    }
+
+                    // Add the triangle and push its vertices to the front of the
+                    // cache.
+                    triangleAdded[best] = true;
+                    cacheNew.clear();
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        const uint32_t v = indices[best * 3 + j];
+                        out.push_back(v);
+                        const uint32_t begin = offsets[v];
+                        const uint32_t end = begin + activeTriangles[v];
+                        for (uint32_t k = begin; k < end; ++k)
+                        {
+                            if (vertexTriangles[k] == best)
+                            {
+                                std::swap(vertexTriangles[k], vertexTriangles[end - 1]);
+                                break;
+                            }
+                        }
+                        --activeTriangles[v];
+                        if (std::find(cacheNew.begin(), cacheNew.end(), v) == cacheNew.end())
+                        {
+                            cacheNew.push_back(v);
+                        }
+                    }
+                    const size_t triangleVertices = cacheNew.size();
+                    for (const auto & v : cache)
+                    {
+                        if (std::find(cacheNew.begin(), cacheNew.begin() + triangleVertices, v) == cacheNew.begin() + triangleVertices)
+                        {
+                            cacheNew.push_back(v);
+                        }
+                    }
+
+                    // Update the scores of the vertices in the cache and the ones
+                    // that were pushed out, and find the best next triangle.
+                    const size_t cacheNewSize = cacheNew.size();
+                    for (size_t j = 0; j < cacheNewSize; ++j)
+                    {
+                        const uint32_t v = cacheNew[j];
+                        cachePos[v] = j < vertexCacheSize ? static_cast<int>(j) : -1;
+                        vertexScores[v] = getVertexScore(cachePos[v], activeTriangles[v]);
+                    }
+                    best = trianglesSize;
+                    float bestScore = -1.F;
+                    for (size_t j = 0; j < cacheNewSize; ++j)
+                    {
+                        const uint32_t v = cacheNew[j];
+                        const uint32_t begin = offsets[v];
+                        const uint32_t end = begin + activeTriangles[v];
+                        for (uint32_t k = begin; k < end; ++k)
+                        {
+                            const uint32_t t = vertexTriangles[k];
+                            triangleScores[t] =
+                                vertexScores[indices[t * 3 + 0]] +
+                                vertexScores[indices[t * 3 + 1]] +
+                                vertexScores[indices[t * 3 + 2]];
+                            if (triangleScores[t] > bestScore)
+                            {
+                                best = t;
+                                bestScore = triangleScores[t];
+                            }
+                        }
+                    }
+                    cacheNew.resize(std::min(cacheNewSize, vertexCacheSize));
+                    cache.swap(cacheNew);
+                }
+                for (size_t i = trianglesSize * 3; i < indicesSize; ++i)
+                {
+                    out.push_back(indices[i]);
+                }
+                indices = std::move(out);
+            }
+
+            float TriangleMesh::getACMR(const std::vector<uint32_t> & indices, size_t cacheSize)
+            {
+                const size_t trianglesSize = indices.size() / 3;
+                if (0 == trianglesSize || 0 == cacheSize)
+                {
+                    return 0.F;
+                }
+                std::vector<uint32_t> cache(cacheSize, std::numeric_limits<uint32_t>::max());
+                size_t cacheIndex = 0;
+                size_t misses = 0;
+                for (size_t i = 0; i < trianglesSize * 3; ++i)
+                {
+                    const uint32_t v = indices[i];
+                    if (std::find(cache.begin(), cache.end(), v) == cache.end())
+                    {
+                        cache[cacheIndex] = v;
+                        cacheIndex = (cacheIndex + 1) % cacheSize;
+                        ++misses;
+                    }
+                }
+                return misses / static_cast<float>(trianglesSize);
+            }
+
             void TriangleMesh::calcNormals(TriangleMesh & mesh)
             {
                 const size_t trianglesSize = mesh.triangles.size();
@@ -71,9 +566,9 @@ namespace djv
                         const auto & v1 = mesh.v[p1 - 1];
                         const auto & v2 = mesh.v[p2 - 1];
                         mesh.n[i] = glm::normalize(glm::cross(v1 - v0, v2 - v0));
-                        tri.v0.n = i + 1;
-                        tri.v1.n = i + 1;
-                        tri.v2.n = i + 1;
+                        tri.v0.n = static_cast<uint32_t>(i + 1);
+                        tri.v1.n = static_cast<uint32_t>(i + 1);
+                        tri.v2.n = static_cast<uint32_t>(i + 1);
                     }
                 }
             }
@@ -126,39 +621,9 @@ namespace djv
                 const TriangleMesh & mesh,
                 glm::vec3 &          hit)
             {
-                bool out = false;
-                float closest = 0.F;
+                size_t index = 0;
                 glm::vec3 barycentric;
-                bool first = true;
-                size_t i = 0;
-                for (const auto & triangle : mesh.triangles)
-                {
-                    const Vertex & vert0 = triangle.v0;
-                    const Vertex & vert1 = triangle.v1;
-                    const Vertex & vert2 = triangle.v2;
-
-                    const glm::vec3 & v0 = mesh.v[vert0.v - 1];
-                    const glm::vec3 & v1 = mesh.v[vert1.v - 1];
-                    const glm::vec3 & v2 = mesh.v[vert2.v - 1];
-                    glm::vec3 hitTemp;
-                    glm::vec3 barycentricTemp;
-                    if (intersectTriangle(pos, dir, v0, v1, v2, hitTemp, barycentricTemp))
-                    {
-                        const float distance = glm::distance(pos, hitTemp);
-                        if (distance < closest || first)
-                        {
-                            hit = hitTemp;
-                            out = true;
-                            closest = distance;
-                            barycentric = barycentricTemp;
-                            first = false;
-                        }
-                    }
-
-                    ++i;
-                }
-
-                return out;
+                return intersectNearest(pos, dir, mesh, hit, index, barycentric);
             }
 
             bool TriangleMesh::intersect(
@@ -170,39 +635,9 @@ namespace djv
                 glm::vec2 &          hitTexture,
                 glm::vec3 &          hitNormal)
             {
-                bool out = false;
-                float closest = 0.F;
-                glm::vec3 barycentric;
                 size_t index = 0;
-                bool first = true;
-                size_t i = 0;
-                for (const auto & triangle : mesh.triangles)
-                {
-                    const Vertex & vert0 = triangle.v0;
-                    const Vertex & vert1 = triangle.v1;
-                    const Vertex & vert2 = triangle.v2;
-
-                    const glm::vec3 & v0 = mesh.v[vert0.v - 1];
-                    const glm::vec3 & v1 = mesh.v[vert1.v - 1];
-                    const glm::vec3 & v2 = mesh.v[vert2.v - 1];
-                    glm::vec3 hitTemp;
-                    glm::vec3 barycentricTemp;
-                    if (intersectTriangle(pos, dir, v0, v1, v2, hitTemp, barycentricTemp))
-                    {
-                        const float distance = glm::distance(pos, hitTemp);
-                        if (distance < closest || first)
-                        {
-                            hit = hitTemp;
-                            out = true;
-                            closest = distance;
-                            barycentric = barycentricTemp;
-                            index = i;
-                            first = false;
-                        }
-                    }
-
-                    ++i;
-                }
+                glm::vec3 barycentric;
+                const bool out = intersectNearest(pos, dir, mesh, hit, index, barycentric);
 
                 if (out)
                 {
@@ -262,7 +697,7 @@ namespace djv
                 mesh.t.push_back(glm::vec3(0.F, 0.F, 0.F));
 
                 // Back
-                const size_t offset = 1;
+                const uint32_t offset = 1;
                 TriangleMesh::Triangle a;
                 TriangleMesh::Triangle b;
                 a.v0.v = 0 + offset;
@@ -9,6 +9,9 @@
 #include <djvCore/BBox.h>
 #include <djvCore/UID.h>
 
+#include <memory>
+#include <mutex>
+
 namespace djv
 {
     namespace AV
@@ -16,28 +19,40 @@ namespace djv
         //! This namespace provides geometry functionality.
         namespace Geom
         {
+            class TriangleMeshBVH;
+
             //! This struct provides a triangle mesh.
+            //!
+            //! Copies do not share the bounding volume hierarchy, it is built
+            //! again for the copy when it is requested.
             class TriangleMesh
             {
             public:
                 TriangleMesh();
+                TriangleMesh(const TriangleMesh&);
+                TriangleMesh(TriangleMesh&&);
+
+                TriangleMesh& operator = (const TriangleMesh&);
+                TriangleMesh& operator = (TriangleMesh&&);
 
                 Core::UID getUID() const;
 
-                //! This struct provides a vertex.
+                //! This struct provides a vertex. The indices are one-based,
+                //! zero means the component is not used. The indices are 32-bit
+                //! to keep the triangles compact (36 bytes instead of 72).
                 struct Vertex
                 {
                     Vertex() {}
 
                     explicit constexpr Vertex(size_t v, size_t t = 0, size_t n = 0) :
-                        v(v),
-                        t(t),
-                        n(n)
+                        v(static_cast<uint32_t>(v)),
+                        t(static_cast<uint32_t>(t)),
+                        n(static_cast<uint32_t>(n))
                     {}
 
-                    size_t v = 0;
-                    size_t t = 0;
-                    size_t n = 0;
+                    uint32_t v = 0;
+                    uint32_t t = 0;
+                    uint32_t n = 0;
 
                     bool operator == (const Vertex &) const;
                 };
@@ -83,9 +98,42 @@ namespace djv
                 //! Compute the bounding-box of the mesh.
                 void bboxUpdate();
 
+                //! Get the bounding volume hierarchy used for intersections,
+                //! building it the first time it is requested. Call
+                //! bvhReset() after changing the mesh.
+                std::shared_ptr<TriangleMeshBVH> getBVH() const;
+
+                void bvhReset();
+
                 //! Convert a face into triangles.
                 static void faceToTriangles(const Face &, std::vector<Triangle> &);
 
+                //! Weld the triangle vertices so that each unique combination
+                //! of position, texture coordinate, and normal is stored once.
+                //! The output is suitable for indexed drawing, with three
+                //! zero-based indices into the vertex list per triangle.
+                static void weld(
+                    const TriangleMesh &    mesh,
+                    std::vector<Vertex> &   vertices,
+                    std::vector<uint32_t> & indices);
+
+                //! Weld the mesh in place, merging identical positions, texture
+                //! coordinates, and normals and re-ordering the triangles to
+                //! improve the vertex cache hit rate. Positions are only merged
+                //! when they also have the same color.
+                static void weld(TriangleMesh &);
+
+                //! Re-order the triangles of an index list to improve the
+                //! post-transform vertex cache hit rate.
+                //!
+                //! References:
+                //! - Tom Forsyth, "Linear-Speed Vertex Cache Optimisation"
+                static void optimizeVertexCache(std::vector<uint32_t> & indices, size_t vertexCount);
+
+                //! Get the average number of vertices transformed per triangle
+                //! (the ACMR) for an index list with a FIFO vertex cache.
+                static float getACMR(const std::vector<uint32_t> & indices, size_t cacheSize);
+
                 //! Calculate the mesh normals.
                 //! \todo Implement smoothing.
                 //! \todo Add an option for CW and CCW.
@@ -101,7 +149,8 @@ namespace djv
                     glm::vec3 &       hit,
                     glm::vec3 &       barycentric);
 
-                //! Intersect a line with a mesh.
+                //! Intersect a line with a mesh. Larger meshes use the bounding
+                //! volume hierarchy.
                 static bool intersect(
                     const glm::vec3 &    pos,
                     const glm::vec3 &    dir,
@@ -123,6 +172,8 @@ namespace djv
 
             private:
                 Core::UID _uid = 0;
+                mutable std::shared_ptr<TriangleMeshBVH> _bvh;
+                mutable std::mutex _bvhMutex;
             };
 
         } // namespace Geom
@@ -0,0 +1,514 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAV/TriangleMeshBVH.h>
+
+#include <djvAV/TriangleMesh.h>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <future>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Geom
+        {
+            namespace
+            {
+                //! \todo Should these be configurable?
+                const size_t binCount           = 16;
+                const size_t leafSizeMin        = 4;
+                const size_t leafSizeMax        = 64;
+                const size_t sahDepthMax        = 48;
+                const size_t parallelBuildMin   = 16384;
+                const size_t parallelBuildDepth = 4;
+                const size_t parallelRaysMin    = 256;
+                const float  traversalCost      = 1.F;
+                const size_t stackSize          = 128;
+
+                struct Node
+                {
+                    glm::vec3 min;
+                    uint32_t  offset = 0;
+                    glm::vec3 max;
+                    uint16_t  count = 0;
+                    uint16_t  axis = 0;
+                };
+
+                struct Triangle
+                {
+                    glm::vec3 v0;
+                    glm::vec3 e1;
+                    glm::vec3 e2;
+                };
+
+                struct Bounds
+                {
+                    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+                    glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+
+                    void expand(const glm::vec3& value)
+                    {
+                        min = glm::min(min, value);
+                        max = glm::max(max, value);
+                    }
+
+                    void expand(const Bounds& value)
+                    {
+                        min = glm::min(min, value.min);
+                        max = glm::max(max, value.max);
+                    }
+
+                    float getArea() const
+                    {
+                        const glm::vec3 size = max - min;
+                        return size.x < 0.F ? 0.F : (2.F * (size.x * size.y + size.y * size.z + size.z * size.x));
+                    }
+                };
+
+                struct BuildData
+                {
+                    std::vector<Bounds> bounds;
+                    std::vector<glm::vec3> centroids;
+                    std::vector<uint32_t> indices;
+                };
+
+                void build(BuildData& data, std::vector<Node>& nodes, size_t begin, size_t end, size_t depth)
+                {
+                    const size_t index = nodes.size();
+                    nodes.push_back(Node());
+
+                    Bounds bounds;
+                    Bounds centroidBounds;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        const uint32_t j = data.indices[i];
+                        bounds.expand(data.bounds[j]);
+                        centroidBounds.expand(data.centroids[j]);
+                    }
+                    Node node;
+                    node.min = bounds.min;
+                    node.max = bounds.max;
+
+                    const size_t count = end - begin;
+                    size_t mid = begin;
+                    bool leaf = count <= leafSizeMin;
+                    if (!leaf)
+                    {
+                        const glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+                        if (depth < sahDepthMax && (extent.x > 0.F || extent.y > 0.F || extent.z > 0.F))
+                        {
+                            // Find the lowest cost split with binning.
+                            float bestCost = std::numeric_limits<float>::max();
+                            size_t bestAxis = 0;
+                            size_t bestBin = 0;
+                            for (size_t axis = 0; axis < 3; ++axis)
+                            {
+                                if (extent[axis] <= 0.F)
+                                {
+                                    continue;
+                                }
+                                Bounds binBounds[binCount];
+                                size_t binCounts[binCount] = {};
+                                const float scale = binCount / extent[axis];
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    const uint32_t j = data.indices[i];
+                                    const size_t bin = std::min(
+                                        static_cast<size_t>((data.centroids[j][axis] - centroidBounds.min[axis]) * scale),
+                                        binCount - 1);
+                                    binBounds[bin].expand(data.bounds[j]);
+                                    ++binCounts[bin];
+                                }
+                                float rightAreas[binCount];
+                                size_t rightCounts[binCount];
+                                Bounds right;
+                                size_t rightCount = 0;
+                                for (size_t i = binCount - 1; i > 0; --i)
+                                {
+                                    right.expand(binBounds[i]);
+                                    rightCount += binCounts[i];
+                                    rightAreas[i] = right.getArea();
+                                    rightCounts[i] = rightCount;
+                                }
+                                Bounds left;
+                                size_t leftCount = 0;
+                                for (size_t i = 0; i < binCount - 1; ++i)
+                                {
+                                    left.expand(binBounds[i]);
+                                    leftCount += binCounts[i];
+                                    if (leftCount > 0 && rightCounts[i + 1] > 0)
+                                    {
+                                        const float cost = left.getArea() * leftCount + rightAreas[i + 1] * rightCounts[i + 1];
+                                        if (cost < bestCost)
+                                        {
+                                            bestCost = cost;
+                                            bestAxis = axis;
+                                            bestBin = i;
+                                        }
+                                    }
+                                }
+                            }
+                            const float area = bounds.getArea();
+                            const float splitCost = traversalCost + (area > 0.F ? bestCost / area : 0.F);
+                            if (splitCost >= static_cast<float>(count) && count <= leafSizeMax)
+                            {
+                                leaf = true;
+                            }
+                            else
+                            {
+                                const float scale = binCount / extent[bestAxis];
+                                const float min = centroidBounds.min[bestAxis];
+                                mid = std::partition(
+                                    data.indices.begin() + begin,
+                                    data.indices.begin() + end,
+                                    [&data, bestAxis, bestBin, scale, min](uint32_t value)
+                                    {
+                                        const size_t bin = std::min(
+                                            static_cast<size_t>((data.centroids[value][bestAxis] - min) * scale),
+                                            binCount - 1);
+                                        return bin <= bestBin;
+                                    }) - data.indices.begin();
+                                node.axis = static_cast<uint16_t>(bestAxis);
+                            }
+                        }
+                        else if (count <= leafSizeMax)
+                        {
+                            leaf = true;
+                        }
+                        if (!leaf && (mid == begin || mid == end))
+                        {
+                            // Fall back to a median split along the largest axis.
+                            const size_t axis =
+                                extent.x >= extent.y && extent.x >= extent.z ? 0 :
+                                (extent.y >= extent.z ? 1 : 2);
+                            mid = begin + count / 2;
+                            std::nth_element(
+                                data.indices.begin() + begin,
+                                data.indices.begin() + mid,
+                                data.indices.begin() + end,
+                                [&data, axis](uint32_t a, uint32_t b)
+                                {
+                                    return data.centroids[a][axis] < data.centroids[b][axis];
+                                });
+                            node.axis = static_cast<uint16_t>(axis);
+                        }
+                    }
+
+                    if (leaf)
+                    {
+                        node.offset = static_cast<uint32_t>(begin);
+                        node.count = static_cast<uint16_t>(count);
+                    }
+                    else if (count >= parallelBuildMin && depth < parallelBuildDepth)
+                    {
+                        // Build the right sub-tree on another thread and append it.
+                        auto future = std::async(
+                            std::launch::async,
+                            [&data, mid, end, depth]
+                            {
+                                std::vector<Node> out;
+                                build(data, out, mid, end, depth + 1);
+                                return out;
+                            });
+                        build(data, nodes, begin, mid, depth + 1);
+                        auto right = future.get();
+                        const uint32_t base = static_cast<uint32_t>(nodes.size());
+                        for (auto& i : right)
+                        {
+                            if (0 == i.count)
+                            {
+                                i.offset += base;
+                            }
+                        }
+                        nodes.insert(nodes.end(), right.begin(), right.end());
+                        node.offset = base;
+                    }
+                    else
+                    {
+                        build(data, nodes, begin, mid, depth + 1);
+                        node.offset = static_cast<uint32_t>(nodes.size());
+                        build(data, nodes, mid, end, depth + 1);
+                    }
+                    nodes[index] = node;
+                }
+
+                inline bool intersectBounds(
+                    const Node& node,
+                    const glm::vec3& pos,
+                    const glm::vec3& invDir,
+                    float tMax)
+                {
+                    const glm::vec3 t0 = (node.min - pos) * invDir;
+                    const glm::vec3 t1 = (node.max - pos) * invDir;
+                    const glm::vec3 tNear = glm::min(t0, t1);
+                    const glm::vec3 tFar = glm::max(t0, t1);
+                    const float tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.F));
+                    const float tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tMax));
+                    return tEnter <= tExit;
+                }
+
+                inline bool intersectTriangle(
+                    const glm::vec3& pos,
+                    const glm::vec3& dir,
+                    const Triangle& triangle,
+                    float& t,
+                    float& u,
+                    float& v)
+                {
+                    const float epsilon = .1e-6F;
+                    const glm::vec3 h = glm::cross(dir, triangle.e2);
+                    const float a = glm::dot(triangle.e1, h);
+                    if (a > -epsilon && a < epsilon)
+                        return false;
+                    const float f = 1.F / a;
+                    const glm::vec3 s = pos - triangle.v0;
+                    u = f * glm::dot(s, h);
+                    if (u < 0.F || u > 1.F)
+                        return false;
+                    const glm::vec3 q = glm::cross(s, triangle.e1);
+                    v = f * glm::dot(dir, q);
+                    if (v < 0.F || u + v > 1.F)
+                        return false;
+                    t = f * glm::dot(triangle.e2, q);
+                    return t > epsilon;
+                }
+
+            } // namespace
+
+            struct TriangleMeshBVH::Private
+            {
+                std::vector<Node> nodes;
+                std::vector<Triangle> triangles;
+                std::vector<uint32_t> triangleIndices;
+                BBox3f bbox = BBox3f(0.F, 0.F, 0.F, 0.F, 0.F, 0.F);
+
+                template<bool any>
+                bool intersect(const Ray&, RayHit&) const;
+            };
+
+            void TriangleMeshBVH::_init(const TriangleMesh& mesh)
+            {
+                DJV_PRIVATE_PTR();
+
+                // Compute the triangle bounds in parallel.
+                std::vector<uint32_t> valid;
+                const size_t vSize = mesh.v.size();
+                for (size_t i = 0; i < mesh.triangles.size(); ++i)
+                {
+                    const auto& triangle = mesh.triangles[i];
+                    if (triangle.v0.v && triangle.v1.v && triangle.v2.v &&
+                        triangle.v0.v <= vSize && triangle.v1.v <= vSize && triangle.v2.v <= vSize)
+                    {
+                        valid.push_back(static_cast<uint32_t>(i));
+                    }
+                }
+                const size_t count = valid.size();
+                BuildData data;
+                data.bounds.resize(count);
+                data.centroids.resize(count);
+                data.indices.resize(count);
+                const size_t threadCount = count >= parallelBuildMin ?
+                    std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1)) :
+                    1;
+                std::vector<std::future<void> > futures;
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    futures.push_back(std::async(
+                        threadCount > 1 ? std::launch::async : std::launch::deferred,
+                        [&mesh, &valid, &data, i, threadCount, count]
+                        {
+                            for (size_t j = count * i / threadCount; j < count * (i + 1) / threadCount; ++j)
+                            {
+                                const auto& triangle = mesh.triangles[valid[j]];
+                                const glm::vec3& v0 = mesh.v[triangle.v0.v - 1];
+                                const glm::vec3& v1 = mesh.v[triangle.v1.v - 1];
+                                const glm::vec3& v2 = mesh.v[triangle.v2.v - 1];
+                                Bounds bounds;
+                                bounds.expand(v0);
+                                bounds.expand(v1);
+                                bounds.expand(v2);
+                                data.bounds[j] = bounds;
+                                data.centroids[j] = (bounds.min + bounds.max) * .5F;
+                                data.indices[j] = static_cast<uint32_t>(j);
+                            }
+                        }));
+                }
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+
+                if (count > 0)
+                {
+                    p.nodes.reserve(count / leafSizeMin * 2);
+                    build(data, p.nodes, 0, count, 0);
+                    p.bbox = BBox3f(p.nodes[0].min, p.nodes[0].max);
+                }
+
+                // Store the triangles in the order of the leaves.
+                p.triangles.resize(count);
+                p.triangleIndices.resize(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const uint32_t index = valid[data.indices[i]];
+                    const auto& triangle = mesh.triangles[index];
+                    const glm::vec3& v0 = mesh.v[triangle.v0.v - 1];
+                    p.triangles[i].v0 = v0;
+                    p.triangles[i].e1 = mesh.v[triangle.v1.v - 1] - v0;
+                    p.triangles[i].e2 = mesh.v[triangle.v2.v - 1] - v0;
+                    p.triangleIndices[i] = index;
+                }
+            }
+
+            TriangleMeshBVH::TriangleMeshBVH() :
+                _p(new Private)
+            {}
+
+            TriangleMeshBVH::~TriangleMeshBVH()
+            {}
+
+            std::shared_ptr<TriangleMeshBVH> TriangleMeshBVH::create(const TriangleMesh& mesh)
+            {
+                auto out = std::shared_ptr<TriangleMeshBVH>(new TriangleMeshBVH);
+                out->_init(mesh);
+                return out;
+            }
+
+            size_t TriangleMeshBVH::getTriangleCount() const
+            {
+                return _p->triangles.size();
+            }
+
+            size_t TriangleMeshBVH::getNodeCount() const
+            {
+                return _p->nodes.size();
+            }
+
+            const BBox3f& TriangleMeshBVH::getBBox() const
+            {
+                return _p->bbox;
+            }
+
+            bool TriangleMeshBVH::intersect(const Ray& ray, RayHit& hit) const
+            {
+                return _p->intersect<false>(ray, hit);
+            }
+
+            bool TriangleMeshBVH::intersectAny(const Ray& ray) const
+            {
+                RayHit hit;
+                return _p->intersect<true>(ray, hit);
+            }
+
+            void TriangleMeshBVH::intersect(const std::vector<Ray>& rays, std::vector<RayHit>& hits) const
+            {
+                DJV_PRIVATE_PTR();
+                const size_t count = rays.size();
+                hits.resize(count);
+                const size_t threadCount = count >= parallelRaysMin ?
+                    std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1)) :
+                    1;
+                std::vector<std::future<void> > futures;
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    futures.push_back(std::async(
+                        threadCount > 1 ? std::launch::async : std::launch::deferred,
+                        [&p, &rays, &hits, i, threadCount, count]
+                        {
+                            for (size_t j = count * i / threadCount; j < count * (i + 1) / threadCount; ++j)
+                            {
+                                hits[j] = RayHit();
+                                p.intersect<false>(rays[j], hits[j]);
+                            }
+                        }));
+                }
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+            }
+
+            template<bool any>
+            bool TriangleMeshBVH::Private::intersect(const Ray& ray, RayHit& hit) const
+            {
+                if (nodes.empty())
+                {
+                    return false;
+                }
+                const glm::vec3 invDir = getInvDir(ray.dir);
+                const bool dirNeg[3] = { ray.dir.x < 0.F, ray.dir.y < 0.F, ray.dir.z < 0.F };
+                float tBest = ray.tMax;
+                size_t best = 0;
+                float bestU = 0.F;
+                float bestV = 0.F;
+                bool out = false;
+                uint32_t stack[stackSize];
+                size_t stackCount = 0;
+                stack[stackCount++] = 0;
+                while (stackCount > 0)
+                {
+                    const uint32_t index = stack[--stackCount];
+                    const Node& node = nodes[index];
+                    if (!intersectBounds(node, ray.pos, invDir, tBest))
+                    {
+                        continue;
+                    }
+                    if (node.count > 0)
+                    {
+                        for (size_t i = node.offset; i < node.offset + node.count; ++i)
+                        {
+                            float t = 0.F;
+                            float u = 0.F;
+                            float v = 0.F;
+                            if (intersectTriangle(ray.pos, ray.dir, triangles[i], t, u, v) && t < tBest)
+                            {
+                                tBest = t;
+                                best = i;
+                                bestU = u;
+                                bestV = v;
+                                out = true;
+                                if (any)
+                                {
+                                    break;
+                                }
+                            }
+                        }
+                        if (any && out)
+                        {
+                            break;
+                        }
+                    }
+                    else if (dirNeg[node.axis])
+                    {
+                        // Visit the nearest child first.
+                        stack[stackCount++] = index + 1;
+                        stack[stackCount++] = node.offset;
+                    }
+                    else
+                    {
+                        stack[stackCount++] = node.offset;
+                        stack[stackCount++] = index + 1;
+                    }
+                }
+                if (out)
+                {
+                    hit.t = tBest;
+                    hit.triangle = triangleIndices[best];
+                    hit.pos = ray.pos + ray.dir * tBest;
+                    hit.barycentric = glm::vec3(1.F - bestU - bestV, bestU, bestV);
+                }
+                return out;
+            }
+
+        } // namespace Geom
+    } // namespace AV
+} // namespace djv
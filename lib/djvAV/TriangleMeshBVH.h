@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/AV.h>
+
+#include <djvCore/BBox.h>
+
+#include <limits>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Geom
+        {
+            class TriangleMesh;
+
+            //! This struct provides a ray.
+            struct Ray
+            {
+                Ray();
+                Ray(const glm::vec3& pos, const glm::vec3& dir, float tMax = std::numeric_limits<float>::max());
+
+                glm::vec3 pos = glm::vec3(0.F, 0.F, 0.F);
+                glm::vec3 dir = glm::vec3(0.F, 0.F, 1.F);
+
+                //! Hits further away than this distance along the ray (in
+                //! multiples of the direction) are ignored.
+                float tMax = std::numeric_limits<float>::max();
+            };
+
+            //! This struct provides a ray hit.
+            struct RayHit
+            {
+                //! The distance along the ray in multiples of the direction.
+                float t = std::numeric_limits<float>::max();
+
+                //! The index of the triangle in the mesh.
+                size_t triangle = 0;
+
+                glm::vec3 pos = glm::vec3(0.F, 0.F, 0.F);
+                glm::vec3 barycentric = glm::vec3(0.F, 0.F, 0.F);
+
+                bool isValid() const;
+            };
+
+            //! Get the inverse of a ray direction for intersecting bounding boxes.
+            //! Zero components are replaced with a large value instead of
+            //! infinity so that rays in the plane of a box do not produce NaNs.
+            glm::vec3 getInvDir(const glm::vec3&);
+
+            //! This class provides a bounding volume hierarchy for accelerating
+            //! ray intersections with a triangle mesh.
+            //!
+            //! The hierarchy is built with the surface area heuristic using
+            //! binning, and large sub-trees are built in parallel. The triangle
+            //! positions are copied so the hierarchy does not reference the
+            //! mesh, but it must be rebuilt if the mesh changes.
+            //!
+            //! References:
+            //! - Ingo Wald, "On fast Construction of SAH-based Bounding Volume Hierarchies"
+            class TriangleMeshBVH
+            {
+                DJV_NON_COPYABLE(TriangleMeshBVH);
+                void _init(const TriangleMesh&);
+                TriangleMeshBVH();
+
+            public:
+                ~TriangleMeshBVH();
+
+                static std::shared_ptr<TriangleMeshBVH> create(const TriangleMesh&);
+
+                size_t getTriangleCount() const;
+                size_t getNodeCount() const;
+                const Core::BBox3f& getBBox() const;
+
+                //! Find the nearest hit.
+                bool intersect(const Ray&, RayHit&) const;
+
+                //! Find whether the ray hits anything, stopping at the first hit.
+                bool intersectAny(const Ray&) const;
+
+                //! Find the nearest hits for a batch of rays in parallel.
+                void intersect(const std::vector<Ray>&, std::vector<RayHit>&) const;
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace Geom
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/TriangleMeshBVHInline.h>
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Geom
+        {
+            inline Ray::Ray()
+            {}
+
+            inline Ray::Ray(const glm::vec3& pos, const glm::vec3& dir, float tMax) :
+                pos(pos),
+                dir(dir),
+                tMax(tMax)
+            {}
+
+            inline bool RayHit::isValid() const
+            {
+                return t < std::numeric_limits<float>::max();
+            }
+
+            inline glm::vec3 getInvDir(const glm::vec3& value)
+            {
+                const float large = std::numeric_limits<float>::max();
+                return glm::vec3(
+                    value.x != 0.F ? (1.F / value.x) : large,
+                    value.y != 0.F ? (1.F / value.y) : large,
+                    value.z != 0.F ? (1.F / value.z) : large);
+            }
+
+        } // namespace Geom
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVPy/AVPy.h>
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(djvAVPy, m)
+{
+    // The Core types (FileInfo, Frame, BBox, etc.) are used as arguments.
+    py::module::import("djvCorePy");
+
+    auto mImage = m.def_submodule("Image");
+    wrapImage(mImage);
+
+    auto mIO = m.def_submodule("IO");
+    wrapIO(mIO);
+}
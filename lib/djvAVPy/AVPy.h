@@ -0,0 +1,12 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+namespace pybind11
+{
+    class module;
+
+} // pybind11
+
+void wrapImage(pybind11::module&);
+void wrapIO(pybind11::module&);
@@ -0,0 +1,301 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVPy/AVPy.h>
+
+#include <djvAV/IO.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Timer.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <thread>
+
+using namespace djv;
+using namespace djv::Core;
+
+namespace py = pybind11;
+
+namespace
+{
+    //! This class wraps a reader. It can be used as a Python iterator that
+    //! returns the video frames while the reader threads and the cache keep
+    //! working in the background. The GIL is released while waiting.
+    class Read
+    {
+    public:
+        explicit Read(const std::shared_ptr<AV::IO::IRead>& read) :
+            _read(read),
+            _info(read->getInfo().share())
+        {}
+
+        AV::IO::Info getInfo() const
+        {
+            auto info = _info;
+            py::gil_scoped_release release;
+            return info.get();
+        }
+
+        bool isRunning() const
+        {
+            return _read->isRunning();
+        }
+
+        size_t getThreadCount() const
+        {
+            return _read->getThreadCount();
+        }
+
+        void setThreadCount(size_t value)
+        {
+            _read->setThreadCount(value);
+        }
+
+        bool isCacheEnabled() const
+        {
+            return _read->isCacheEnabled();
+        }
+
+        size_t getCacheMaxByteCount() const
+        {
+            return _read->getCacheMaxByteCount();
+        }
+
+        Frame::Sequence getCachedFrames()
+        {
+            return _read->getCachedFrames();
+        }
+
+        void setCacheEnabled(bool value)
+        {
+            _read->setCacheEnabled(value);
+        }
+
+        void setCacheMaxByteCount(size_t value)
+        {
+            _read->setCacheMaxByteCount(value);
+        }
+
+        void seek(Frame::Index value)
+        {
+            _read->seek(value, AV::IO::Direction::Forward);
+        }
+
+        void start()
+        {
+            // Playback lets the reader decode several frames in parallel and
+            // plan the cache ahead of the frames being iterated.
+            _read->setPlayback(true);
+        }
+
+        AV::IO::VideoFrame next()
+        {
+            AV::IO::VideoFrame out;
+            bool frame = false;
+            {
+                py::gil_scoped_release release;
+                bool finished = false;
+                while (!frame && !finished)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_read->getMutex());
+                        auto& queue = _read->getVideoQueue();
+                        if (!queue.isEmpty())
+                        {
+                            out = queue.popFrame();
+                            frame = true;
+                        }
+                        else
+                        {
+                            finished = queue.isFinished();
+                        }
+                    }
+                    if (!frame && !finished)
+                    {
+                        finished = !_read->isRunning();
+                        if (!finished)
+                        {
+                            std::this_thread::sleep_for(Time::getTime(Time::TimerValue::VeryFast));
+                        }
+                    }
+                }
+            }
+            if (!frame)
+            {
+                throw py::stop_iteration();
+            }
+            return out;
+        }
+
+    private:
+        std::shared_ptr<AV::IO::IRead> _read;
+        std::shared_future<AV::IO::Info> _info;
+    };
+
+    //! This class wraps a writer. The GIL is released while waiting for
+    //! space in the queue and for the writer to finish.
+    class Write
+    {
+    public:
+        explicit Write(const std::shared_ptr<AV::IO::IWrite>& write) :
+            _write(write)
+        {}
+
+        bool isRunning() const
+        {
+            return _write->isRunning();
+        }
+
+        void addFrame(const AV::IO::VideoFrame& frame)
+        {
+            py::gil_scoped_release release;
+            bool added = false;
+            while (!added)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_write->getMutex());
+                    auto& queue = _write->getVideoQueue();
+                    if (queue.getCount() < queue.getMax())
+                    {
+                        queue.addFrame(frame);
+                        added = true;
+                    }
+                }
+                if (!added)
+                {
+                    if (!_write->isRunning())
+                    {
+                        throw std::runtime_error("The writer is not running.");
+                    }
+                    std::this_thread::sleep_for(Time::getTime(Time::TimerValue::VeryFast));
+                }
+            }
+        }
+
+        void finish()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_write->getMutex());
+                _write->getVideoQueue().setFinished(true);
+            }
+            py::gil_scoped_release release;
+            while (_write->isRunning())
+            {
+                std::this_thread::sleep_for(Time::getTime(Time::TimerValue::VeryFast));
+            }
+        }
+
+    private:
+        std::shared_ptr<AV::IO::IWrite> _write;
+    };
+
+} // namespace
+
+void wrapIO(pybind11::module& m)
+{
+    py::class_<AV::IO::VideoInfo>(m, "VideoInfo")
+        .def(py::init<>())
+        .def(py::init<const AV::Image::Info&>())
+        .def_readwrite("info", &AV::IO::VideoInfo::info)
+        .def_property(
+            "speed",
+            [](const AV::IO::VideoInfo& value)
+            {
+                return value.speed.toFloat();
+            },
+            [](AV::IO::VideoInfo& value, float speed)
+            {
+                value.speed = Time::Speed(Math::Rational::fromFloat(speed));
+            })
+        .def_readwrite("sequence", &AV::IO::VideoInfo::sequence)
+        .def_readwrite("codec", &AV::IO::VideoInfo::codec);
+
+    py::class_<AV::IO::Info>(m, "Info")
+        .def(py::init<>())
+        .def(py::init<const std::string&, const AV::IO::VideoInfo&>())
+        .def_readwrite("fileName", &AV::IO::Info::fileName)
+        .def_readwrite("video", &AV::IO::Info::video);
+
+    py::class_<AV::IO::VideoFrame>(m, "VideoFrame")
+        .def(py::init<>())
+        .def(py::init<Frame::Number, const std::shared_ptr<AV::Image::Image>&>())
+        .def_readwrite("frame", &AV::IO::VideoFrame::frame)
+        .def_readwrite("image", &AV::IO::VideoFrame::image)
+        .def_readwrite("layers", &AV::IO::VideoFrame::layers);
+
+    py::class_<AV::IO::ReadOptions>(m, "ReadOptions")
+        .def(py::init<>())
+        .def_readwrite("videoQueueSize", &AV::IO::ReadOptions::videoQueueSize)
+        .def_readwrite("layer", &AV::IO::ReadOptions::layer)
+        .def_readwrite("colorSpace", &AV::IO::ReadOptions::colorSpace)
+        .def_readwrite("roi", &AV::IO::ReadOptions::roi)
+        .def_readwrite("scale", &AV::IO::ReadOptions::scale)
+        .def_readwrite("allLayers", &AV::IO::ReadOptions::allLayers)
+        .def_readwrite("stats", &AV::IO::ReadOptions::stats);
+
+    py::class_<AV::IO::WriteOptions>(m, "WriteOptions")
+        .def(py::init<>())
+        .def_readwrite("videoQueueSize", &AV::IO::WriteOptions::videoQueueSize)
+        .def_readwrite("colorSpace", &AV::IO::WriteOptions::colorSpace);
+
+    py::class_<Read, std::shared_ptr<Read> >(m, "Read")
+        .def("getInfo", &Read::getInfo)
+        .def("isRunning", &Read::isRunning)
+        .def("getThreadCount", &Read::getThreadCount)
+        .def("setThreadCount", &Read::setThreadCount)
+        .def("isCacheEnabled", &Read::isCacheEnabled)
+        .def("getCacheMaxByteCount", &Read::getCacheMaxByteCount)
+        .def("getCachedFrames", &Read::getCachedFrames)
+        .def("setCacheEnabled", &Read::setCacheEnabled)
+        .def("setCacheMaxByteCount", &Read::setCacheMaxByteCount)
+        .def("seek", &Read::seek)
+        .def("__iter__", [](const std::shared_ptr<Read>& value)
+            {
+                value->start();
+                return value;
+            })
+        .def("__next__", &Read::next);
+
+    py::class_<Write, std::shared_ptr<Write> >(m, "Write")
+        .def("isRunning", &Write::isRunning)
+        .def("addFrame", &Write::addFrame)
+        .def("finish", &Write::finish);
+
+    py::class_<AV::IO::System, std::shared_ptr<AV::IO::System> >(m, "System")
+        .def_static("get", [](const std::shared_ptr<Context>& context)
+            {
+                auto out = context->getSystemT<AV::IO::System>();
+                if (!out)
+                {
+                    throw std::runtime_error("The I/O system is not available.");
+                }
+                return out;
+            })
+        .def("getPluginNames", &AV::IO::System::getPluginNames)
+        .def("getFileExtensions", &AV::IO::System::getFileExtensions)
+        .def("getThreadCount", &AV::IO::System::getThreadCount)
+        .def("setThreadCount", &AV::IO::System::setThreadCount)
+        .def("canSequence", &AV::IO::System::canSequence)
+        .def("canRead", &AV::IO::System::canRead)
+        .def("canWrite", &AV::IO::System::canWrite)
+        .def(
+            "read",
+            [](AV::IO::System& system, const FileSystem::FileInfo& fileInfo, const AV::IO::ReadOptions& options)
+            {
+                return std::make_shared<Read>(system.read(fileInfo, options));
+            },
+            py::arg("fileInfo"),
+            py::arg("options") = AV::IO::ReadOptions())
+        .def(
+            "write",
+            [](AV::IO::System& system, const FileSystem::FileInfo& fileInfo, const AV::IO::Info& info, const AV::IO::WriteOptions& options)
+            {
+                return std::make_shared<Write>(system.write(fileInfo, info, options));
+            },
+            py::arg("fileInfo"),
+            py::arg("info"),
+            py::arg("options") = AV::IO::WriteOptions());
+}
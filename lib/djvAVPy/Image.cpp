@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVPy/AVPy.h>
+
+#include <djvAV/Image.h>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/operators.h>
+#include <pybind11/stl.h>
+
+using namespace djv;
+using namespace djv::Core;
+
+namespace py = pybind11;
+
+namespace
+{
+    std::string getFormat(AV::Image::DataType type, Memory::Endian endian)
+    {
+        std::string out;
+        if (endian != Memory::getEndian())
+        {
+            out = Memory::Endian::MSB == endian ? ">" : "<";
+        }
+        switch (type)
+        {
+        case AV::Image::DataType::U8:  out += py::format_descriptor<uint8_t>::format(); break;
+        case AV::Image::DataType::U10: out += py::format_descriptor<uint32_t>::format(); break;
+        case AV::Image::DataType::U16: out += py::format_descriptor<uint16_t>::format(); break;
+        case AV::Image::DataType::U32: out += py::format_descriptor<uint32_t>::format(); break;
+        case AV::Image::DataType::F16: out += "e"; break;
+        case AV::Image::DataType::F32: out += py::format_descriptor<float>::format(); break;
+        default: break;
+        }
+        return out;
+    }
+
+    // The buffer references the image memory directly. The rows and columns
+    // are in display order, the mirroring is handled with negative strides.
+    // Images that reference a memory mapped file are read-only.
+    py::buffer_info getBuffer(const AV::Image::Data& data)
+    {
+        const auto& info = data.getInfo();
+        const auto dataType = AV::Image::getDataType(info.type);
+        const py::ssize_t w = info.size.w;
+        const py::ssize_t h = info.size.h;
+        const py::ssize_t scanlineByteCount = static_cast<py::ssize_t>(data.getScanlineByteCount());
+        const py::ssize_t pixelByteCount = static_cast<py::ssize_t>(data.getPixelByteCount());
+        const uint8_t* p = data.getData();
+        py::ssize_t rowStride = scanlineByteCount;
+        py::ssize_t pixelStride = pixelByteCount;
+        if (info.layout.mirror.y && h > 0)
+        {
+            p += (h - 1) * scanlineByteCount;
+            rowStride = -rowStride;
+        }
+        if (info.layout.mirror.x && w > 0)
+        {
+            p += (w - 1) * pixelByteCount;
+            pixelStride = -pixelStride;
+        }
+        std::vector<py::ssize_t> shape = { h, w };
+        std::vector<py::ssize_t> strides = { rowStride, pixelStride };
+        py::ssize_t itemSize = pixelByteCount;
+
+        // The 10-bit data is packed into a single 32-bit word per pixel so
+        // it does not have a channel dimension.
+        if (dataType != AV::Image::DataType::U10)
+        {
+            const py::ssize_t channelCount = AV::Image::getChannelCount(info.type);
+            itemSize = static_cast<py::ssize_t>(AV::Image::getByteCount(dataType));
+            shape.push_back(channelCount);
+            strides.push_back(itemSize);
+        }
+        return py::buffer_info(
+            const_cast<uint8_t*>(p),
+            itemSize,
+            getFormat(dataType, info.layout.endian),
+            static_cast<py::ssize_t>(shape.size()),
+            shape,
+            strides,
+            data.hasFileIO());
+    }
+
+} // namespace
+
+void wrapImage(pybind11::module& m)
+{
+    py::enum_<AV::Image::Type>(m, "Type")
+        .value("None_", AV::Image::Type::None)
+        .value("L_U8", AV::Image::Type::L_U8)
+        .value("L_U16", AV::Image::Type::L_U16)
+        .value("L_U32", AV::Image::Type::L_U32)
+        .value("L_F16", AV::Image::Type::L_F16)
+        .value("L_F32", AV::Image::Type::L_F32)
+        .value("LA_U8", AV::Image::Type::LA_U8)
+        .value("LA_U16", AV::Image::Type::LA_U16)
+        .value("LA_U32", AV::Image::Type::LA_U32)
+        .value("LA_F16", AV::Image::Type::LA_F16)
+        .value("LA_F32", AV::Image::Type::LA_F32)
+        .value("RGB_U8", AV::Image::Type::RGB_U8)
+        .value("RGB_U10", AV::Image::Type::RGB_U10)
+        .value("RGB_U16", AV::Image::Type::RGB_U16)
+        .value("RGB_U32", AV::Image::Type::RGB_U32)
+        .value("RGB_F16", AV::Image::Type::RGB_F16)
+        .value("RGB_F32", AV::Image::Type::RGB_F32)
+        .value("RGBA_U8", AV::Image::Type::RGBA_U8)
+        .value("RGBA_U16", AV::Image::Type::RGBA_U16)
+        .value("RGBA_U32", AV::Image::Type::RGBA_U32)
+        .value("RGBA_F16", AV::Image::Type::RGBA_F16)
+        .value("RGBA_F32", AV::Image::Type::RGBA_F32);
+
+    m.def("getChannelCount", &AV::Image::getChannelCount);
+    m.def("getByteCount", (size_t(*)(AV::Image::Type))&AV::Image::getByteCount);
+
+    py::class_<AV::Image::Mirror>(m, "Mirror")
+        .def(py::init<>())
+        .def(py::init<bool, bool>())
+        .def_readwrite("x", &AV::Image::Mirror::x)
+        .def_readwrite("y", &AV::Image::Mirror::y)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<AV::Image::Layout>(m, "Layout")
+        .def(py::init<>())
+        .def(py::init<const AV::Image::Mirror&>())
+        .def_readwrite("mirror", &AV::Image::Layout::mirror)
+        .def_readwrite("alignment", &AV::Image::Layout::alignment)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<AV::Image::Size>(m, "Size")
+        .def(py::init<>())
+        .def(py::init<uint16_t, uint16_t>())
+        .def_readwrite("w", &AV::Image::Size::w)
+        .def_readwrite("h", &AV::Image::Size::h)
+        .def("isValid", &AV::Image::Size::isValid)
+        .def("getAspectRatio", &AV::Image::Size::getAspectRatio)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<AV::Image::Info>(m, "Info")
+        .def(py::init<>())
+        .def(py::init<const AV::Image::Size&, AV::Image::Type>())
+        .def(py::init<const AV::Image::Size&, AV::Image::Type, const AV::Image::Layout&>())
+        .def(py::init<uint16_t, uint16_t, AV::Image::Type>())
+        .def(py::init<uint16_t, uint16_t, AV::Image::Type, const AV::Image::Layout&>())
+        .def_readwrite("name", &AV::Image::Info::name)
+        .def_readwrite("size", &AV::Image::Info::size)
+        .def_readwrite("pixelAspectRatio", &AV::Image::Info::pixelAspectRatio)
+        .def_readwrite("type", &AV::Image::Info::type)
+        .def_readwrite("layout", &AV::Image::Info::layout)
+        .def("getAspectRatio", &AV::Image::Info::getAspectRatio)
+        .def("isValid", &AV::Image::Info::isValid)
+        .def("getPixelByteCount", &AV::Image::Info::getPixelByteCount)
+        .def("getScanlineByteCount", &AV::Image::Info::getScanlineByteCount)
+        .def("getDataByteCount", &AV::Image::Info::getDataByteCount)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<AV::Image::Data, std::shared_ptr<AV::Image::Data> >(m, "Data", py::buffer_protocol())
+        .def_static("create", [](const AV::Image::Info& info) { return AV::Image::Data::create(info); })
+        .def("getInfo", &AV::Image::Data::getInfo)
+        .def("getSize", &AV::Image::Data::getSize)
+        .def("getWidth", &AV::Image::Data::getWidth)
+        .def("getHeight", &AV::Image::Data::getHeight)
+        .def("getAspectRatio", &AV::Image::Data::getAspectRatio)
+        .def("getType", &AV::Image::Data::getType)
+        .def("getLayout", &AV::Image::Data::getLayout)
+        .def("isValid", &AV::Image::Data::isValid)
+        .def("getPixelByteCount", &AV::Image::Data::getPixelByteCount)
+        .def("getScanlineByteCount", &AV::Image::Data::getScanlineByteCount)
+        .def("getDataByteCount", &AV::Image::Data::getDataByteCount)
+        .def("zero", &AV::Image::Data::zero)
+        .def("hasFileIO", &AV::Image::Data::hasFileIO)
+        .def("detach", &AV::Image::Data::detach)
+        .def_buffer(&getBuffer)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<AV::Image::Image, std::shared_ptr<AV::Image::Image>, AV::Image::Data>(m, "Image", py::buffer_protocol())
+        .def_static("create", [](const AV::Image::Info& info) { return AV::Image::Image::create(info); })
+        .def("getPluginName", &AV::Image::Image::getPluginName)
+        .def_buffer(&getBuffer);
+}
@@ -78,6 +78,8 @@ namespace djv
             // Create the systems.
             auto avSystem = AV::AVSystem::create(shared_from_this());
             auto sceneSystem = Scene::SceneSystem::create(shared_from_this());
+
+            _setStartupEnd();
         }
 
         Application::Application() :
@@ -79,6 +79,8 @@ namespace djv
                     context->_logSystem->log("djv::Core::Context", ss.str());
                 }
             });
+
+            _setStartupEnd();
         }
 
         Context::~Context()
@@ -150,6 +152,42 @@ namespace djv
                 }
                 dot.push_back("}");
                 //FileSystem::FileIO::writeLines("systems.dot", dot);
+
+                // Log the startup timeline.
+                std::vector<std::string> timeline;
+                timeline.push_back("System,Start (ms),Duration (ms)");
+                _startupTimelineIndexes.clear();
+                for (const auto& startupTime : _startupTimeline)
+                {
+                    std::stringstream ss;
+                    ss << startupTime.name << "," <<
+                        std::chrono::duration_cast<std::chrono::milliseconds>(startupTime.start).count() << "," <<
+                        std::chrono::duration_cast<std::chrono::milliseconds>(startupTime.duration).count();
+                    timeline.push_back(ss.str());
+                    {
+                        std::stringstream ss2;
+                        ss2 << "Startup system: " << startupTime.name << ", " <<
+                            std::chrono::duration_cast<std::chrono::milliseconds>(startupTime.duration).count() << "ms";
+                        _logSystem->log("djv::Core::Context", ss2.str());
+                    }
+                }
+                {
+                    std::stringstream ss;
+                    ss << "Startup time: " << std::chrono::duration_cast<std::chrono::milliseconds>(_startupEnd).count() << "ms";
+                    _logSystem->log("djv::Core::Context", ss.str());
+                }
+                const std::string startupTimelineFileName = OS::getEnv("DJV_STARTUP_TIMELINE");
+                if (!startupTimelineFileName.empty())
+                {
+                    try
+                    {
+                        FileSystem::FileIO::writeLines(startupTimelineFileName, timeline);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _logSystem->log("djv::Core::Context", e.what(), LogLevel::Error);
+                    }
+                }
             }
 
             Time::Duration total = Time::Duration::zero();
@@ -197,6 +235,26 @@ namespace djv
         void Context::_addSystem(const std::shared_ptr<ISystemBase> & system)
         {
             _systems.push_back(system);
+            SystemStartupTime startupTime;
+            startupTime.name = system->getSystemName();
+            startupTime.start = std::chrono::duration_cast<Time::Duration>(std::chrono::steady_clock::now() - _startupTime);
+            _startupTimelineIndexes[system.get()] = _startupTimeline.size();
+            _startupTimeline.push_back(startupTime);
+        }
+
+        void Context::_setSystemStartupEnd(const ISystemBase* system)
+        {
+            const auto i = _startupTimelineIndexes.find(system);
+            if (i != _startupTimelineIndexes.end())
+            {
+                auto& startupTime = _startupTimeline[i->second];
+                startupTime.duration = std::chrono::duration_cast<Time::Duration>(std::chrono::steady_clock::now() - _startupTime) - startupTime.start;
+            }
+        }
+
+        void Context::_setStartupEnd()
+        {
+            _startupEnd = std::chrono::duration_cast<Time::Duration>(std::chrono::steady_clock::now() - _startupTime);
         }
 
     } // namespace ViewExperiment
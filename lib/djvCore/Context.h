@@ -9,6 +9,7 @@
 
 #include <chrono>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -30,6 +31,14 @@ namespace djv
 
         } // namespace Time
 
+        //! This struct provides the startup time of a system.
+        struct SystemStartupTime
+        {
+            std::string    name;
+            Time::Duration start    = Time::Duration::zero();
+            Time::Duration duration = Time::Duration::zero();
+        };
+
         //! This class provides core functionality.
         class Context : public std::enable_shared_from_this<Context>
         {
@@ -83,10 +92,26 @@ namespace djv
             //! Get the system tick times.
             const std::vector<std::pair<std::string, Time::Duration> >& getSystemTickTimes() const;
 
+            //! Get the startup timeline. The start times are relative to the
+            //! creation of the context, and the durations are the time taken by
+            //! each system's create(), including any systems that it creates.
+            //! The timeline is available after the first tick.
+            //!
+            //! If the DJV_STARTUP_TIMELINE environment variable is set the
+            //! timeline is also written to that file as CSV.
+            const std::vector<SystemStartupTime>& getStartupTimeline() const;
+
         protected:
             void _addSystem(const std::shared_ptr<ISystemBase> &);
 
+            //! Record the end of the startup. This should be called when
+            //! _init() returns; derived classes that create more systems
+            //! call it again.
+            void _setStartupEnd();
+
         private:
+            void _setSystemStartupEnd(const ISystemBase*);
+
             std::string _name;
             std::shared_ptr<Time::TimerSystem> _timerSystem;
             std::shared_ptr<ResourceSystem> _resourceSystem;
@@ -99,6 +124,10 @@ namespace djv
             std::list<float> _fpsSamples;
             float _fpsAverage = 0.F;
             std::shared_ptr<Time::Timer> _fpsTimer;
+            std::chrono::time_point<std::chrono::steady_clock> _startupTime = std::chrono::steady_clock::now();
+            std::vector<SystemStartupTime> _startupTimeline;
+            std::map<const ISystemBase*, size_t> _startupTimelineIndexes;
+            Time::Duration _startupEnd = Time::Duration::zero();
 
             friend class ISystemBase;
         };
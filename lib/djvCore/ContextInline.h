@@ -58,6 +58,11 @@ namespace djv
             return _systemTickTimes;
         }
 
+        inline const std::vector<SystemStartupTime>& Context::getStartupTimeline() const
+        {
+            return _startupTimeline;
+        }
+
     } // namespace Core
 } // namespace djv
 
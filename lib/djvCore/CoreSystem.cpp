@@ -38,6 +38,7 @@ namespace djv
         {
             auto out = std::shared_ptr<CoreSystem>(new CoreSystem);
             out->_init(argv0, context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -4,6 +4,11 @@
 
 #include <djvCore/FileIO.h>
 
+#include <djvCore/FileSystem.h>
+#include <djvCore/Memory.h>
+#include <djvCore/StringFormat.h>
+
+#include <algorithm>
 #include <sstream>
 
 namespace djv
@@ -22,6 +27,21 @@ namespace djv
                 return std::shared_ptr<FileIO>(new FileIO);
             }
 
+            void FileIO::open(const std::string& fileName, const std::shared_ptr<std::vector<uint8_t> >& buffer)
+            {
+                close();
+                _fileName = fileName;
+                _mode     = Mode::Read;
+                _pos      = 0;
+                _size     = buffer ? buffer->size() : 0;
+                _buffer   = buffer ? buffer : std::shared_ptr<std::vector<uint8_t> >(new std::vector<uint8_t>);
+                if (_size > 0)
+                {
+                    _memoryStart = _buffer->data();
+                    _memoryEnd   = _memoryStart + _size;
+                }
+            }
+
             void FileIO::setPos(size_t in)
             {
                 _setPos(in, false);
@@ -32,24 +52,63 @@ namespace djv
                 _setPos(in, true);
             }
 
+            void FileIO::setReadType(ReadType value)
+            {
+                _readType = value;
+            }
+
             void FileIO::setEndianConversion(bool in)
             {
                 _endianConversion = in;
             }
 
+            void FileIO::_readMemory(void* out, size_t size, size_t wordSize)
+            {
+                const size_t byteCount = size * wordSize;
+                if (_pos + byteCount > _size)
+                {
+                    //! \todo How can we translate this?
+                    throw Error(String::Format("{0}: Cannot read.").arg(_fileName));
+                }
+                const uint8_t* p = _memoryStart + _pos;
+                if (_endianConversion && wordSize > 1)
+                {
+                    Memory::endian(p, out, size, wordSize);
+                }
+                else
+                {
+                    memcpy(out, p, byteCount);
+                }
+                _pos += byteCount;
+            }
+
+            void FileIO::_setMemoryPos(size_t in, bool seek)
+            {
+                const size_t pos = !seek ? in : (_pos + in);
+                if (pos > _size)
+                {
+                    //! \todo How can we translate this?
+                    throw Error(String::Format("{0}: Cannot seek.").arg(_fileName));
+                }
+                _pos = pos;
+            }
+
             std::string FileIO::readContents(const std::shared_ptr<FileIO>& io)
             {
-#ifdef DJV_MMAP
-                const uint8_t * p = io->mmapP();
-                const uint8_t * end = io->mmapEnd();
-                return std::string(reinterpret_cast<const char *>(p), end - p);
-#else // DJV_MMAP
+                if (const uint8_t* p = io->mmapP())
+                {
+                    std::string out(reinterpret_cast<const char*>(p), io->mmapEnd() - p);
+                    io->_pos = io->_size;
+                    return out;
+                }
                 const size_t fileSize = io->getSize();
                 std::string out;
                 out.resize(fileSize);
-                io->read(reinterpret_cast<void*>(&out[0]), fileSize);
+                if (fileSize > 0)
+                {
+                    io->read(reinterpret_cast<void*>(&out[0]), fileSize);
+                }
                 return out;
-#endif // DJV_MMAP
             }
 
             void FileIO::readWord(const std::shared_ptr<FileIO>& io, char * out, size_t maxLen)
@@ -152,4 +211,12 @@ namespace djv
 
         } // namespace FileSystem
     } // namespace Core
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        Core::FileSystem,
+        ReadType,
+        DJV_TEXT("file_io_read_type_normal"),
+        DJV_TEXT("file_io_read_type_memory_map"),
+        DJV_TEXT("file_io_read_type_direct_io"));
+
 } // namespace djv
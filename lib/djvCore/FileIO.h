@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <djvCore/Enum.h>
 #include <djvCore/String.h>
 
 #include <memory>
@@ -24,6 +25,18 @@ namespace djv
     {
         namespace FileSystem
         {
+            //! This enumeration provides the ways a file can be read.
+            enum class ReadType
+            {
+                Normal,    //!< Read through the operating system's page cache
+                MemoryMap, //!< Memory map the file
+                DirectIO,  //!< Read the whole file with direct I/O, bypassing the page cache
+
+                Count,
+                First = Normal
+            };
+            DJV_ENUM_HELPERS(ReadType);
+
             //! This class provides file I/O.
             class FileIO
             {
@@ -48,11 +61,16 @@ namespace djv
                     First = Read
                 };
 
-                //! Open the file.
+                //! Open the file. Files opened for reading use the current
+                //! read type.
                 //! Throws:
                 //! - Error
                 void open(const std::string & fileName, Mode);
 
+                //! Open the file using data that has already been read into
+                //! memory (for example by a ReadAhead queue).
+                void open(const std::string & fileName, const std::shared_ptr<std::vector<uint8_t> > &);
+
                 //! Open a temporary file.
                 //! Throws:
                 //! - Error
@@ -128,16 +146,33 @@ namespace djv
 
                 ///@}
 
-                //! \name Memory Mapping
+                //! \name Read Type
                 ///@{
 
-#if defined(DJV_MMAP)
-                //! Get the current memory-map position.
+                ReadType getReadType() const;
+
+                //! Set how files opened for reading are read. Memory mapping and
+                //! direct I/O fall back to normal reads for empty files, and
+                //! direct I/O falls back to dropping the file from the page cache
+                //! after reading when the file system does not support it.
+                void setReadType(ReadType);
+
+                ///@}
+
+                //! \name Memory Access
+                ///@{
+
+                //! Get whether the file is memory mapped.
+                bool isMemoryMapped() const;
+
+                //! Get a pointer to the current position when the file data is
+                //! in memory (memory mapped, read with direct I/O, or opened from
+                //! a buffer), otherwise null.
                 const uint8_t * mmapP() const;
 
-                //! Get a pointer to the end of the memory-map.
+                //! Get a pointer to the end of the file data when it is in
+                //! memory, otherwise null.
                 const uint8_t * mmapEnd() const;
-#endif // DJV_MMAP
 
                 ///@}
 
@@ -181,41 +216,43 @@ namespace djv
                 //! - Error
                 static void writeLines(const std::string & fileName, const std::vector<std::string> &);
 
+                //! Replace the contents of a file. The data is written to a
+                //! uniquely named temporary file in the same directory which
+                //! then replaces the file, so it is never partially written.
+                //! Throws:
+                //! - Error
+                static void writeAtomic(const std::string & fileName, const void *, size_t);
+
                 ///@}
 
             private:
                 void _setPos(size_t, bool seek);
+                void _readMemory(void *, size_t, size_t wordSize);
+                void _setMemoryPos(size_t, bool seek);
 
                 std::string     _fileName;
                 Mode            _mode               = Mode::First;
+                ReadType        _readType           = ReadType::First;
                 size_t          _pos                = 0;
                 size_t          _size               = 0;
                 bool            _endianConversion   = false;
+                std::shared_ptr<std::vector<uint8_t> > _buffer;
+                void *          _mmap               = nullptr;
+                void *          _direct             = nullptr;
+                const uint8_t * _memoryStart        = nullptr;
+                const uint8_t * _memoryEnd          = nullptr;
 #if defined(DJV_PLATFORM_WINDOWS)
-#if defined(DJV_MMAP)
-                HANDLE          _f                  = INVALID_HANDLE_VALUE;
-#else // DJV_MMAP
                 FILE*           _f                  = nullptr;
-#endif // DJV_MMAP
-#if defined(DJV_MMAP)
-                void *          _mmap               = nullptr;
-                const uint8_t * _mmapStart          = nullptr;
-                const uint8_t * _mmapEnd            = nullptr;
-                const uint8_t * _mmapP              = nullptr;
-#endif // DJV_MMAP
 #else // DJV_PLATFORM_WINDOWS
                 int             _f                  = -1;
-#if defined(DJV_MMAP)
-                void *          _mmap               = reinterpret_cast<void *>(-1);
-                const uint8_t * _mmapStart          = nullptr;
-                const uint8_t * _mmapEnd            = nullptr;
-                const uint8_t * _mmapP              = nullptr;
-#endif // DJV_MMAP
 #endif //DJV_PLATFORM_WINDOWS
             };
 
         } // namespace FileSystem
     } // namespace Core
+
+    DJV_ENUM_SERIALIZE_HELPERS(Core::FileSystem::ReadType);
+
 } // namespace djv
 
 #include <djvCore/FileIOInline.h>
@@ -14,13 +14,9 @@ namespace djv
             inline bool FileIO::isOpen() const
             {
 #if defined(DJV_PLATFORM_WINDOWS)
-#if defined(DJV_MMAP)
-                return _f != INVALID_HANDLE_VALUE;
-#else // DJV_MMAP
-                return _f != nullptr;
-#endif // DJV_MMAP
+                return _f != nullptr || _memoryStart || _buffer;
 #else // DJV_PLATFORM_WINDOWS
-                return _f != -1;
+                return _f != -1 || _memoryStart || _buffer;
 #endif //DJV_PLATFORM_WINDOWS
             }
 
@@ -41,9 +37,13 @@ namespace djv
 
             inline bool FileIO::isEOF() const
             {
+                if (_memoryStart || _buffer)
+                {
+                    return _pos >= _size;
+                }
 #if defined(DJV_PLATFORM_WINDOWS)
                 return
-                    _f == INVALID_HANDLE_VALUE ||
+                    !_f ||
                     (_size ? _pos >= _size : true);
 #else // DJV_PLATFORM_WINDOWS
                 return
@@ -53,17 +53,25 @@ namespace djv
 #endif //DJV_PLATFORM_WINDOWS
             }
 
-#if defined(DJV_MMAP)
+            inline ReadType FileIO::getReadType() const
+            {
+                return _readType;
+            }
+
+            inline bool FileIO::isMemoryMapped() const
+            {
+                return _mmap != nullptr;
+            }
+
             inline const uint8_t * FileIO::mmapP() const
             {
-                return _mmapP;
+                return _memoryStart ? (_memoryStart + _pos) : nullptr;
             }
 
             inline const uint8_t * FileIO::mmapEnd() const
             {
-                return _mmapEnd;
+                return _memoryEnd;
             }
-#endif // DJV_MMAP
 
             inline bool FileIO::hasEndianConversion() const
             {
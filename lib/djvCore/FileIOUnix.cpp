@@ -43,10 +43,8 @@ namespace djv
                     Close,
                     CloseMemoryMap,
                     Read,
-                    ReadMemoryMap,
                     Write,
-                    Seek,
-                    SeekMemoryMap
+                    Seek
                 };
 
                 std::string getErrorString()
@@ -92,10 +90,6 @@ namespace djv
                         out.push_back(String::Format("{0}: Cannot read.").arg(fileName));
                         out.push_back(getErrorString());
                         break;
-                    case ErrorType::ReadMemoryMap:
-                        out.push_back(String::Format("{0}: Cannot read memory map.").arg(fileName));
-                        out.push_back(getErrorString());
-                        break;
                     case ErrorType::Write:
                         out.push_back(String::Format("{0}: Cannot write.").arg(fileName));
                         out.push_back(getErrorString());
@@ -104,10 +98,6 @@ namespace djv
                         out.push_back(String::Format("{0}: Cannot seek.").arg(fileName));
                         out.push_back(getErrorString());
                         break;
-                    case ErrorType::SeekMemoryMap:
-                        out.push_back(String::Format("{0}: Cannot seek memory map.").arg(fileName));
-                        out.push_back(getErrorString());
-                        break;
                     default: break;
                     }
                     return String::join(out, ' ');
@@ -141,7 +131,19 @@ namespace djv
                     break;
                 default: break;
                 }
-                _f = ::open(fileName.c_str(), openFlags, openMode);
+                const bool read = Mode::Read == mode;
+                bool directIO = false;
+#if defined(O_DIRECT)
+                if (read && ReadType::DirectIO == _readType)
+                {
+                    _f = ::open(fileName.c_str(), openFlags | O_DIRECT, openMode);
+                    directIO = _f != -1;
+                }
+#endif // O_DIRECT
+                if (-1 == _f)
+                {
+                    _f = ::open(fileName.c_str(), openFlags, openMode);
+                }
                 if (-1 == _f)
                 {
                     throw Error(getErrorMessage(ErrorType::Open, fileName));
@@ -159,21 +161,71 @@ namespace djv
                 _pos      = 0;
                 _size     = info.st_size;
 
-#if defined(DJV_MMAP)
-                // Memory mapping.
-                if (Mode::Read == _mode && _size > 0)
+                if (read && _size > 0)
                 {
-                    _mmap = mmap(0, _size, PROT_READ, MAP_SHARED, _f, 0);
-                    madvise(_mmap, _size, MADV_SEQUENTIAL | MADV_SEQUENTIAL);
-                    if (_mmap == (void *) - 1)
+                    switch (_readType)
                     {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                    case ReadType::MemoryMap:
+                    {
+                        void* mmapP = mmap(0, _size, PROT_READ, MAP_PRIVATE, _f, 0);
+                        if (MAP_FAILED == mmapP)
+                        {
+                            throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                        }
+                        // The decoders read the entire file, so start paging it
+                        // in now rather than faulting it in page by page.
+                        madvise(mmapP, _size, MADV_WILLNEED);
+                        _mmap        = mmapP;
+                        _memoryStart = reinterpret_cast<const uint8_t*>(_mmap);
+                        _memoryEnd   = _memoryStart + _size;
+                        break;
+                    }
+                    case ReadType::DirectIO:
+                    {
+#if defined(DJV_PLATFORM_OSX)
+                        fcntl(_f, F_NOCACHE, 1);
+                        directIO = true;
+#endif // DJV_PLATFORM_OSX
+                        // Direct I/O requires the buffer, offsets, and sizes to
+                        // be aligned to the file system block size.
+                        const size_t alignment = std::max(static_cast<size_t>(info.st_blksize), static_cast<size_t>(4096));
+                        const size_t alignedSize = (_size + alignment - 1) / alignment * alignment;
+                        if (posix_memalign(&_direct, alignment, alignedSize) != 0)
+                        {
+                            _direct = nullptr;
+                            throw Error(getErrorMessage(ErrorType::Read, fileName));
+                        }
+                        uint8_t* p = reinterpret_cast<uint8_t*>(_direct);
+                        const size_t chunkSize = 64 * Memory::megabyte;
+                        size_t pos = 0;
+                        while (pos < _size)
+                        {
+                            const ssize_t r = ::read(_f, p + pos, std::min(alignedSize - pos, chunkSize));
+                            if (r <= 0)
+                            {
+                                throw Error(getErrorMessage(ErrorType::Read, fileName));
+                            }
+                            pos += r;
+                        }
+#if defined(POSIX_FADV_DONTNEED)
+                        if (!directIO)
+                        {
+                            posix_fadvise(_f, 0, 0, POSIX_FADV_DONTNEED);
+                        }
+#endif // POSIX_FADV_DONTNEED
+                        _memoryStart = p;
+                        _memoryEnd   = _memoryStart + _size;
+                        break;
+                    }
+                    default: break;
+                    }
+                    if (_memoryStart)
+                    {
+                        // The data is in memory so the file is no longer needed.
+                        ::close(_f);
+                        _f = -1;
                     }
-                    _mmapStart = reinterpret_cast<const uint8_t *>(_mmap);
-                    _mmapEnd   = _mmapStart + _size;
-                    _mmapP     = _mmapStart;
                 }
-#endif // DJV_MMAP
             }
             
             void FileIO::openTemp()
@@ -209,9 +261,7 @@ namespace djv
             {
                 bool out = true;
                 
-                _fileName = std::string();
-#if defined(DJV_MMAP)
-                if (_mmap != (void *) - 1)
+                if (_mmap)
                 {
                     int r = munmap(_mmap, _size);
                     if (-1 == r)
@@ -222,11 +272,16 @@ namespace djv
                             *error = getErrorMessage(ErrorType::CloseMemoryMap, _fileName);
                         }
                     }
-                    _mmap = (void *)-1;
+                    _mmap = nullptr;
+                }
+                if (_direct)
+                {
+                    free(_direct);
+                    _direct = nullptr;
                 }
-                _mmapStart = 0;
-                _mmapEnd   = 0;
-#endif // DJV_MMAP
+                _memoryStart = nullptr;
+                _memoryEnd   = nullptr;
+                _buffer.reset();
                 if (_f != -1)
                 {
                     int r = ::close(_f);
@@ -241,6 +296,7 @@ namespace djv
                     _f = -1;
                 }
 
+                _fileName = std::string();
                 _mode = static_cast<Mode>(0);
                 _pos  = 0;
                 _size = 0;
@@ -250,26 +306,15 @@ namespace djv
             
             void FileIO::read(void* in, size_t size, size_t wordSize)
             {
+                if (_memoryStart || _buffer)
+                {
+                    _readMemory(in, size, wordSize);
+                    return;
+                }
                 switch (_mode)
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    const uint8_t* mmapP = _mmapP + size * wordSize;
-                    if (mmapP > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(_mmapP, in, size, wordSize);
-                    }
-                    else
-                    {
-                        memcpy(in, _mmapP, size * wordSize);
-                    }
-                    _mmapP = mmapP;
-#else // DJV_MMAP
                     const size_t r = ::read(_f, in, size * wordSize);
                     if (r != size * wordSize)
                     {
@@ -279,7 +324,6 @@ namespace djv
                     {
                         Memory::endian(in, size, wordSize);
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::ReadWrite:
@@ -318,33 +362,48 @@ namespace djv
                 _size = std::max(_pos, _size);
             }
 
+            void FileIO::writeAtomic(const std::string& fileName, const void* data, size_t size)
+            {
+                const std::string tmp = fileName + ".XXXXXX";
+                std::vector<char> buf(tmp.size() + 1);
+                memcpy(buf.data(), tmp.c_str(), tmp.size() + 1);
+                const int f = mkstemp(buf.data());
+                if (-1 == f)
+                {
+                    throw Error(getErrorMessage(ErrorType::Open, tmp));
+                }
+                ::close(f);
+                const std::string tempFileName(buf.data());
+                try
+                {
+                    auto io = FileIO::create();
+                    io->open(tempFileName, Mode::Write);
+                    io->write(data, size);
+                    io->close();
+                }
+                catch (const std::exception&)
+                {
+                    unlink(tempFileName.c_str());
+                    throw;
+                }
+                if (rename(tempFileName.c_str(), fileName.c_str()) != 0)
+                {
+                    const std::string error = getErrorMessage(ErrorType::Write, fileName);
+                    unlink(tempFileName.c_str());
+                    throw Error(error);
+                }
+            }
+
             void FileIO::_setPos(size_t in, bool seek)
             {
+                if (_memoryStart || _buffer)
+                {
+                    _setMemoryPos(in, seek);
+                    return;
+                }
                 switch (_mode)
                 {
                 case Mode::Read:
-                {
-#if defined(DJV_MMAP)
-                    if (!seek)
-                    {
-                        _mmapP = reinterpret_cast<const uint8_t*>(_mmapStart) + in;
-                    }
-                    else
-                    {
-                        _mmapP += in;
-                    }
-                    if (_mmapP > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
-                    }
-#else // DJV_MMAP
-                    if (::lseek(_f, in, ! seek ? SEEK_SET : SEEK_CUR) == (off_t) - 1)
-                    {
-                        throw Error(getErrorMessage(ErrorType::Seek, _fileName));
-                    }
-#endif // DJV_MMAP
-                    break;
-                }
                 case Mode::Write:
                 case Mode::ReadWrite:
                 {
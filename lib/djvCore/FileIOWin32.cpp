@@ -11,8 +11,10 @@
 #include <djvCore/Path.h>
 #include <djvCore/StringFormat.h>
 
+#include <algorithm>
 #include <codecvt>
 #include <locale>
+#include <sstream>
 
 #include <io.h>
 #include <errno.h>
@@ -34,10 +36,8 @@ namespace djv
                     Close,
                     CloseMemoryMap,
                     Read,
-                    ReadMemoryMap,
                     Write,
-                    Seek,
-                    SeekMemoryMap
+                    Seek
                 };
                 
                 std::string getErrorMessage(ErrorType type, const std::string& fileName)
@@ -70,10 +70,6 @@ namespace djv
                         out.push_back(String::Format("{0}: Cannot read.").arg(fileName));
                         out.push_back(Core::Error::getLastError());
                         break;
-                    case ErrorType::ReadMemoryMap:
-                        out.push_back(String::Format("{0}: Cannot read memory map.").arg(fileName));
-                        out.push_back(Core::Error::getLastError());
-                        break;
                     case ErrorType::Write:
                         out.push_back(String::Format("{0}: Cannot write.").arg(fileName));
                         out.push_back(Core::Error::getLastError());
@@ -82,10 +78,6 @@ namespace djv
                         out.push_back(String::Format("{0}: Cannot seek.").arg(fileName));
                         out.push_back(Core::Error::getLastError());
                         break;
-                    case ErrorType::SeekMemoryMap:
-                        out.push_back(String::Format("{0}: Cannot seek memory map.").arg(fileName));
-                        out.push_back(Core::Error::getLastError());
-                        break;
                     default: break;
                     }
                     return String::join(out, ' ');
@@ -97,73 +89,101 @@ namespace djv
             {
                 close();
 
-#if defined(DJV_MMAP)
-                // Open the file.
-                DWORD desiredAccess = 0;
-                DWORD shareMode = 0;
-                DWORD disposition = 0;
-                DWORD flags =
-                    //FILE_ATTRIBUTE_NORMAL;
-                    FILE_FLAG_SEQUENTIAL_SCAN;
-                switch (mode)
-                {
-                case Mode::Read:
-                    desiredAccess = GENERIC_READ;
-                    shareMode     = FILE_SHARE_READ;
-                    disposition   = OPEN_EXISTING;
-                    break;
-                case Mode::Write:
-                    desiredAccess = GENERIC_WRITE;
-                    disposition   = CREATE_ALWAYS;
-                    break;
-                case Mode::ReadWrite:
-                    desiredAccess = GENERIC_READ | GENERIC_WRITE;
-                    shareMode     = FILE_SHARE_READ;
-                    disposition   = CREATE_ALWAYS;
-                    break;
-                case Mode::Append:
-                    desiredAccess = GENERIC_WRITE;
-                    disposition   = OPEN_EXISTING;
-                    break;
-                default: break;
-                }
-                try
-                {
-                    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
-                    _f = CreateFileW(utf16.from_bytes(fileName).c_str(), desiredAccess, shareMode, 0, disposition, flags, 0);
-                }
-                catch (const std::exception&)
-                {
-                    _f = INVALID_HANDLE_VALUE;
-                }
-                if (INVALID_HANDLE_VALUE == _f)
-                {
-                    throw Error(getErrorMessage(ErrorType::Open, fileName));
-                }
-                _fileName = fileName;
-                _mode = mode;
-                _pos = 0;
-                _size = GetFileSize(_f, 0);
-
-                // Memory mapping.
-                if (Mode::Read == _mode && _size > 0)
+                if (Mode::Read == mode && _readType != ReadType::Normal)
                 {
-                    _mmap = CreateFileMapping(_f, 0, PAGE_READONLY, 0, 0, 0);
-                    if (!_mmap)
+                    // Open the file.
+                    const bool directIO = ReadType::DirectIO == _readType;
+                    HANDLE f = INVALID_HANDLE_VALUE;
+                    try
                     {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                        std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
+                        f = CreateFileW(
+                            utf16.from_bytes(fileName).c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            0,
+                            OPEN_EXISTING,
+                            directIO ? FILE_FLAG_NO_BUFFERING : FILE_FLAG_SEQUENTIAL_SCAN,
+                            0);
                     }
+                    catch (const std::exception&)
+                    {
+                        f = INVALID_HANDLE_VALUE;
+                    }
+                    if (INVALID_HANDLE_VALUE == f)
+                    {
+                        throw Error(getErrorMessage(ErrorType::Open, fileName));
+                    }
+                    LARGE_INTEGER size;
+                    if (!GetFileSizeEx(f, &size))
+                    {
+                        CloseHandle(f);
+                        throw Error(getErrorMessage(ErrorType::Open, fileName));
+                    }
+                    _fileName = fileName;
+                    _mode     = mode;
+                    _pos      = 0;
+                    _size     = static_cast<size_t>(size.QuadPart);
 
-                    _mmapStart = reinterpret_cast<const uint8_t *>(MapViewOfFile(_mmap, FILE_MAP_READ, 0, 0, 0));
-                    if (!_mmapStart)
+                    if (_size > 0)
                     {
-                        throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                        if (directIO)
+                        {
+                            // Unbuffered reads require the buffer and sizes to be
+                            // aligned to the sector size.
+                            const size_t alignment = 4096;
+                            const size_t alignedSize = (_size + alignment - 1) / alignment * alignment;
+                            _direct = _aligned_malloc(alignedSize, alignment);
+                            if (!_direct)
+                            {
+                                CloseHandle(f);
+                                throw Error(getErrorMessage(ErrorType::Read, fileName));
+                            }
+                            uint8_t* p = reinterpret_cast<uint8_t*>(_direct);
+                            const size_t chunkSize = 64 * Memory::megabyte;
+                            size_t pos = 0;
+                            while (pos < _size)
+                            {
+                                DWORD n = 0;
+                                if (!::ReadFile(f, p + pos, static_cast<DWORD>(std::min(alignedSize - pos, chunkSize)), &n, 0) || !n)
+                                {
+                                    CloseHandle(f);
+                                    throw Error(getErrorMessage(ErrorType::Read, fileName));
+                                }
+                                pos += n;
+                            }
+                            _memoryStart = p;
+                        }
+                        else
+                        {
+                            HANDLE mapping = CreateFileMapping(f, 0, PAGE_READONLY, 0, 0, 0);
+                            if (!mapping)
+                            {
+                                CloseHandle(f);
+                                throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                            }
+                            _mmap = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                            CloseHandle(mapping);
+                            if (!_mmap)
+                            {
+                                CloseHandle(f);
+                                throw Error(getErrorMessage(ErrorType::MemoryMap, fileName));
+                            }
+                            _memoryStart = reinterpret_cast<const uint8_t*>(_mmap);
+                        }
+                        _memoryEnd = _memoryStart + _size;
                     }
 
-                    _mmapEnd = _mmapStart + _size;
-                    _mmapP = _mmapStart;
+                    // The view keeps the file open, and the direct I/O data has
+                    // already been read, so the handle is no longer needed.
+                    CloseHandle(f);
+                    if (_memoryStart)
+                    {
+                        return;
+                    }
+                    _fileName = std::string();
                 }
-#else // DJV_MMAP
+
                 std::string modeStr;
                 switch (mode)
                 {
@@ -198,7 +218,6 @@ namespace djv
                 {
                     throw Error(getErrorMessage(ErrorType::Open, fileName));
                 }
-#endif // DJV_MMAP
             }
 
             void FileIO::openTemp()
@@ -234,49 +253,34 @@ namespace djv
             {
                 bool out = true;
 
-                _fileName = std::string();
-                
-#if defined(DJV_MMAP)
-                if (_mmapStart != 0)
+                if (_mmap)
                 {
-                    if (!::UnmapViewOfFile((void *)_mmapStart))
+                    if (!::UnmapViewOfFile(_mmap))
                     {
                         out = false;
                         if (error)
                         {
-                            *error = getErrorMessage(Error::CloseMemoryMap, _fileName);
+                            *error = getErrorMessage(ErrorType::CloseMemoryMap, _fileName);
                         }
                     }
-                    _mmapStart = 0;
+                    _mmap = nullptr;
                 }
-                if (_mmap != 0)
+                if (_direct)
                 {
-                    if (!::CloseHandle(_mmap))
-                    {
-                        out = false;
-                        if (error)
-                        {
-                            *error = getErrorMessage(Error::Close, _fileName);
-                        }
-                    }
-                    _mmap = 0;
+                    _aligned_free(_direct);
+                    _direct = nullptr;
                 }
-                _mmapEnd = 0;
-                _mmapP   = 0;
+                _memoryStart = nullptr;
+                _memoryEnd   = nullptr;
+                _buffer.reset();
 
-                if (_f != INVALID_HANDLE_VALUE)
-                {
-                    CloseHandle(_f);
-                    _f = INVALID_HANDLE_VALUE;
-                }
-#else // DJV_MMAP
                 if (_f)
                 {
                     fclose(_f);
                     _f = nullptr;
                 }
-#endif // DJV_MMAP
 
+                _fileName = std::string();
                 _mode = Mode::First;
                 _pos  = 0;
                 _size = 0;
@@ -286,26 +290,15 @@ namespace djv
 
             void FileIO::read(void * in, size_t size, size_t wordSize)
             {
+                if (_memoryStart || _buffer)
+                {
+                    _readMemory(in, size, wordSize);
+                    return;
+                }
                 switch (_mode)
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    const uint8_t * p = _mmapP + size * wordSize;
-                    if (p > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::ReadMemoryMap, _fileName));
-                    }
-                    if (_endianConversion && wordSize > 1)
-                    {
-                        Memory::endian(_mmapP, in, size, wordSize);
-                    }
-                    else
-                    {
-                        memcpy(in, _mmapP, size * wordSize);
-                    }
-                    _mmapP = p;
-#else // DJV_MMAP
                     /*DWORD n;
                     if (!::ReadFile(_f, in, static_cast<DWORD>(size * wordSize), &n, 0))
                     {
@@ -320,7 +313,6 @@ namespace djv
                     {
                         Memory::endian(in, size, wordSize);
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::ReadWrite:
@@ -373,26 +365,46 @@ namespace djv
                 _size = std::max(_pos, _size);
             }
 
+            void FileIO::writeAtomic(const std::string& fileName, const void* data, size_t size)
+            {
+                std::stringstream ss;
+                ss << fileName << "." << GetCurrentProcessId() << "." << GetCurrentThreadId() << ".tmp";
+                const std::string tempFileName = ss.str();
+                std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
+                try
+                {
+                    auto io = FileIO::create();
+                    io->open(tempFileName, Mode::Write);
+                    io->write(data, size);
+                    io->close();
+                }
+                catch (const std::exception&)
+                {
+                    DeleteFileW(utf16.from_bytes(tempFileName).c_str());
+                    throw;
+                }
+                if (!MoveFileExW(
+                    utf16.from_bytes(tempFileName).c_str(),
+                    utf16.from_bytes(fileName).c_str(),
+                    MOVEFILE_REPLACE_EXISTING))
+                {
+                    const std::string error = getErrorMessage(ErrorType::Write, fileName);
+                    DeleteFileW(utf16.from_bytes(tempFileName).c_str());
+                    throw Error(error);
+                }
+            }
+
             void FileIO::_setPos(size_t value, bool seek)
             {
+                if (_memoryStart || _buffer)
+                {
+                    _setMemoryPos(value, seek);
+                    return;
+                }
                 switch (_mode)
                 {
                 case Mode::Read:
                 {
-#if defined(DJV_MMAP)
-                    if (!seek)
-                    {
-                        _mmapP = reinterpret_cast<const uint8_t*>(_mmapStart) + value;
-                    }
-                    else
-                    {
-                        _mmapP += value;
-                    }
-                    if (_mmapP > _mmapEnd)
-                    {
-                        throw Error(getErrorMessage(ErrorType::SeekMemoryMap, _fileName));
-                    }
-#else // DJV_MMAP
                     /*LARGE_INTEGER v;
                     v.QuadPart = value;
                     if (!::SetFilePointerEx(
@@ -407,7 +419,6 @@ namespace djv
                     {
                         throw Error(getErrorMessage(ErrorType::Seek, _fileName));
                     }
-#endif // DJV_MMAP
                     break;
                 }
                 case Mode::Write:
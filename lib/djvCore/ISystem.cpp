@@ -27,6 +27,14 @@ namespace djv
             context->_addSystem(std::dynamic_pointer_cast<ISystemBase>(shared_from_this()));
         }
 
+        void ISystemBase::_setStartupEnd()
+        {
+            if (auto context = _context.lock())
+            {
+                context->_setSystemStartupEnd(this);
+            }
+        }
+
         ISystemBase::~ISystemBase()
         {
             while (_dependencies.size())
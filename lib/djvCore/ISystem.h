@@ -29,6 +29,10 @@ namespace djv
             void _init(const std::string& name, const std::shared_ptr<Context>&);
             ISystemBase();
 
+            //! Record the end of the system startup in the context startup
+            //! timeline. This should be called by create() after _init().
+            void _setStartupEnd();
+
         public:
             virtual ~ISystemBase() = 0;
 
@@ -167,6 +167,7 @@ namespace djv
         {
             auto out = std::shared_ptr<LogSystem>(new LogSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
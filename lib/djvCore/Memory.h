@@ -56,6 +56,11 @@ namespace djv
             //! Get the opposite of the given endian.
             Endian opposite(Endian);
 
+            //! Reverse the bytes of a word.
+            uint16_t byteSwap(uint16_t);
+            uint32_t byteSwap(uint32_t);
+            uint64_t byteSwap(uint64_t);
+
             //! Convert the endianness of a block of memory in place.
             void endian(
                 void*  in,
@@ -25,56 +25,33 @@ namespace djv
                 return Endian::MSB == in ? Endian::LSB : Endian::MSB;
             }
 
+            inline uint16_t byteSwap(uint16_t value)
+            {
+                return static_cast<uint16_t>((value >> 8) | (value << 8));
+            }
+
+            inline uint32_t byteSwap(uint32_t value)
+            {
+                return
+                    (value >> 24) |
+                    ((value >> 8) & 0x0000ff00) |
+                    ((value << 8) & 0x00ff0000) |
+                    (value << 24);
+            }
+
+            inline uint64_t byteSwap(uint64_t value)
+            {
+                return
+                    static_cast<uint64_t>(byteSwap(static_cast<uint32_t>(value))) << 32 |
+                    byteSwap(static_cast<uint32_t>(value >> 32));
+            }
+
             inline void endian(
                 void*  in,
                 size_t size,
                 size_t wordSize)
             {
-                uint8_t* p = reinterpret_cast<uint8_t*>(in);
-                uint8_t tmp;
-                switch (wordSize)
-                {
-                case 2:
-                    while (size--)
-                    {
-                        tmp  = p[0];
-                        p[0] = p[1];
-                        p[1] = tmp;
-                        p += 2;
-                    }
-                    break;
-                case 4:
-                    while (size--)
-                    {
-                        tmp  = p[0];
-                        p[0] = p[3];
-                        p[3] = tmp;
-                        tmp  = p[1];
-                        p[1] = p[2];
-                        p[2] = tmp;
-                        p += 4;
-                    }
-                    break;
-                case 8:
-                    while (size--)
-                    {
-                        tmp  = p[0];
-                        p[0] = p[7];
-                        p[7] = tmp;
-                        tmp  = p[1];
-                        p[1] = p[6];
-                        p[6] = tmp;
-                        tmp  = p[2];
-                        p[2] = p[5];
-                        p[5] = tmp;
-                        tmp  = p[3];
-                        p[3] = p[4];
-                        p[4] = tmp;
-                        p += 8;
-                    }
-                    break;
-                default: break;
-                }
+                endian(in, in, size, wordSize);
             }
 
             inline void endian(
@@ -83,50 +60,45 @@ namespace djv
                 size_t      size,
                 size_t      wordSize)
             {
+                // The words are loaded and stored with memcpy() so the data
+                // does not need to be aligned, compilers turn these loops into
+                // vector byte shuffles.
                 const uint8_t* inP = reinterpret_cast<const uint8_t*>(in);
                 uint8_t* outP = reinterpret_cast<uint8_t*>(out);
                 switch (wordSize)
                 {
                 case 2:
-                    while (size--)
+                    for (size_t i = 0; i < size; ++i, inP += 2, outP += 2)
                     {
-                        outP[0] = inP[1];
-                        outP[1] = inP[0];
-                        
-                        inP  += 2;
-                        outP += 2;
+                        uint16_t value;
+                        memcpy(&value, inP, 2);
+                        value = byteSwap(value);
+                        memcpy(outP, &value, 2);
                     }
                     break;
                 case 4:
-                    while (size--)
+                    for (size_t i = 0; i < size; ++i, inP += 4, outP += 4)
                     {
-                        outP[0] = inP[3];
-                        outP[1] = inP[2];
-                        outP[2] = inP[1];
-                        outP[3] = inP[0];
-                        
-                        inP  += 4;
-                        outP += 4;
+                        uint32_t value;
+                        memcpy(&value, inP, 4);
+                        value = byteSwap(value);
+                        memcpy(outP, &value, 4);
                     }
                     break;
                 case 8:
-                    while (size--)
+                    for (size_t i = 0; i < size; ++i, inP += 8, outP += 8)
                     {
-                        outP[0] = inP[7];
-                        outP[1] = inP[6];
-                        outP[2] = inP[5];
-                        outP[3] = inP[4];
-                        outP[4] = inP[3];
-                        outP[5] = inP[2];
-                        outP[6] = inP[1];
-                        outP[7] = inP[0];
-                        
-                        inP  += 8;
-                        outP += 8;
+                        uint64_t value;
+                        memcpy(&value, inP, 8);
+                        value = byteSwap(value);
+                        memcpy(outP, &value, 8);
                     }
                     break;
                 default:
-                    memcpy(out, in, size * wordSize);
+                    if (in != out)
+                    {
+                        memcpy(out, in, size * wordSize);
+                    }
                     break;
                 }
             }
@@ -17,83 +17,95 @@ namespace djv
         {
             void write(
                 const picojson::value& value,
-                const std::shared_ptr<FileSystem::FileIO>& fileIO,
+                std::string& out,
                 size_t indent,
                 bool continueLine)
             {
                 if (value.is<picojson::object>())
                 {
-                    std::string s = "{\n";
                     if (!continueLine)
                     {
-                        s = String::indent(indent) + s;
+                        out += String::indent(indent);
                     }
-                    fileIO->write(s);
+                    out += "{\n";
                     ++indent;
                     const auto & object = value.get<picojson::object>();
                     size_t i = 0;
                     for (const auto & key : object)
                     {
-                        std::stringstream ss;
-                        ss << "\"" << key.first << "\": ";
-                        fileIO->write(String::indent(indent) + ss.str());
-                        write(key.second, fileIO, indent, true);
+                        out += String::indent(indent);
+                        out += "\"";
+                        out += key.first;
+                        out += "\": ";
+                        write(key.second, out, indent, true);
                         if (i < object.size() - 1)
                         {
-                            fileIO->write(", ");
+                            out += ", ";
                         }
-                        fileIO->write("\n");
+                        out += "\n";
                         ++i;
                     }
                     --indent;
-                    fileIO->write(String::indent(indent) + "}");
+                    out += String::indent(indent);
+                    out += "}";
                 }
                 else if (value.is<picojson::array>())
                 {
-                    std::string s = "[\n";
                     if (!continueLine)
                     {
-                        s = String::indent(indent) + s;
+                        out += String::indent(indent);
                     }
-                    fileIO->write(s);
+                    out += "[\n";
                     ++indent;
                     const auto & array = value.get<picojson::array>();
                     for (size_t i = 0; i < array.size(); ++i)
                     {
-                        write(array[i], fileIO, indent);
+                        write(array[i], out, indent);
                         if (i < array.size() - 1)
                         {
-                            fileIO->write(", ");
+                            out += ", ";
                         }
-                        fileIO->write("\n");
+                        out += "\n";
                     }
                     --indent;
-                    fileIO->write(String::indent(indent) + "]");
+                    out += String::indent(indent);
+                    out += "]";
                 }
                 else if (value.is<double>())
                 {
                     std::stringstream ss;
                     ss << "\"" << value.get<double>() << "\"";
-                    std::string tmp = ss.str();
                     if (!continueLine)
                     {
-                        tmp = String::indent(indent) + tmp;
+                        out += String::indent(indent);
                     }
-                    fileIO->write(tmp);
+                    out += ss.str();
                 }
                 else if (value.is<std::string>())
                 {
-                    std::stringstream ss;
-                    ss << "\"" << value.get<std::string>() << "\"";
-                    std::string tmp = ss.str();
                     if (!continueLine)
                     {
-                        tmp = String::indent(indent) + tmp;
+                        out += String::indent(indent);
                     }
-                    fileIO->write(tmp);
+                    out += "\"";
+                    out += value.get<std::string>();
+                    out += "\"";
                 }
             }
 
+            void write(
+                const picojson::value& value,
+                const std::shared_ptr<FileSystem::FileIO>& fileIO,
+                size_t indent,
+                bool continueLine)
+            {
+                // Serialize to a string first so the file is written with a
+                // single call instead of one per token.
+                std::string s;
+                write(value, s, indent, continueLine);
+                fileIO->write(s);
+            }
+
         } // namespace PicoJSON
     } // namespace Core
 
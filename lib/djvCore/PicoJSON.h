@@ -24,6 +24,13 @@ namespace djv
         //! This namespace provides JSON functionality.
         namespace PicoJSON
         {
+            //! Append the JSON text to a string.
+            void write(
+                const picojson::value&,
+                std::string&,
+                size_t indent = 0,
+                bool continueLine = false);
+
             void write(
                 const picojson::value&,
                 const std::shared_ptr<FileSystem::FileIO>&,
@@ -0,0 +1,784 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/ReadAhead.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/Memory.h>
+
+#if defined(URing_FOUND)
+#include <liburing.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // URing_FOUND
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t maxByteCountDefault = 512 * Memory::megabyte;
+                const std::chrono::milliseconds throughputWindow(1000);
+#if defined(URing_FOUND)
+                const size_t ringSize = 64;
+
+                //! The length of an io_uring read is 32-bit, so larger files are
+                //! read in chunks.
+                const size_t ringReadMax = 1024 * Memory::megabyte;
+#endif // URing_FOUND
+
+                enum class RequestState
+                {
+                    Pending,
+                    InFlight,
+                    Ready,
+                    Failed
+                };
+
+                struct Request
+                {
+                    RequestState state = RequestState::Pending;
+                    bool wanted = true;
+                    std::shared_ptr<std::vector<uint8_t> > data;
+                };
+
+                //! This struct provides the requests of a read-ahead queue. The
+                //! members are guarded by the pool mutex.
+                struct Queue
+                {
+                    size_t threadCount = 1;
+                    size_t maxByteCount = maxByteCountDefault;
+                    bool closed = false;
+
+                    std::list<std::string> pending;
+                    std::map<std::string, std::shared_ptr<Request> > requests;
+                    size_t inFlight = 0;
+                    size_t byteCount = 0;
+                    std::deque<std::pair<std::chrono::steady_clock::time_point, size_t> > throughput;
+                    size_t hits = 0;
+                    size_t misses = 0;
+
+                    bool canStart() const
+                    {
+                        return !closed && pending.size() && inFlight < threadCount && byteCount < maxByteCount;
+                    }
+
+                    std::string start()
+                    {
+                        const std::string out = pending.front();
+                        pending.pop_front();
+                        requests[out]->state = RequestState::InFlight;
+                        ++inFlight;
+                        return out;
+                    }
+
+                    void finish(const std::string& fileName, const std::shared_ptr<std::vector<uint8_t> >& data)
+                    {
+                        --inFlight;
+                        const auto i = requests.find(fileName);
+                        if (i != requests.end())
+                        {
+                            if (!i->second->wanted || closed)
+                            {
+                                // Anyone waiting on the request is woken by
+                                // the caller.
+                                i->second->state = RequestState::Failed;
+                                requests.erase(i);
+                            }
+                            else if (data)
+                            {
+                                i->second->state = RequestState::Ready;
+                                i->second->data = data;
+                                byteCount += data->size();
+                            }
+                            else
+                            {
+                                i->second->state = RequestState::Failed;
+                            }
+                        }
+                        const auto now = std::chrono::steady_clock::now();
+                        if (data)
+                        {
+                            throughput.push_back(std::make_pair(now, data->size()));
+                        }
+                        while (throughput.size() && now - throughput.front().first > throughputWindow)
+                        {
+                            throughput.pop_front();
+                        }
+                    }
+                };
+
+                //! This class provides the threads that service every
+                //! read-ahead queue, so opening more files does not add more
+                //! threads.
+                class Pool
+                {
+                public:
+                    Pool()
+                    {
+#if defined(URing_FOUND)
+                        // Fall back to threads if io_uring is not available at
+                        // runtime, for example with older kernels or in
+                        // restricted containers.
+                        _eventFD = eventfd(0, 0);
+                        if (-1 == _eventFD)
+                        {
+                            return;
+                        }
+                        if (0 == io_uring_queue_init(static_cast<unsigned>(ringSize), &_ring, 0))
+                        {
+                            backend = ReadAheadBackend::IOUring;
+                            _threads.push_back(std::thread(
+                                [this]
+                                {
+                                    _ioUringRun();
+                                }));
+                        }
+                        else
+                        {
+                            ::close(_eventFD);
+                            _eventFD = -1;
+                        }
+#endif // URing_FOUND
+                    }
+
+                    ~Pool()
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            _running = false;
+                        }
+                        notify();
+                        for (auto& i : _threads)
+                        {
+                            if (i.joinable())
+                            {
+                                i.join();
+                            }
+                        }
+#if defined(URing_FOUND)
+                        if (ReadAheadBackend::IOUring == backend)
+                        {
+                            io_uring_queue_exit(&_ring);
+                        }
+                        if (_eventFD != -1)
+                        {
+                            ::close(_eventFD);
+                        }
+#endif // URing_FOUND
+                    }
+
+                    ReadAheadBackend backend = ReadAheadBackend::Threads;
+                    std::mutex mutex;
+                    std::condition_variable requestCV;
+                    std::condition_variable readyCV;
+
+                    //! Wake the threads when there are new requests.
+                    void notify()
+                    {
+                        requestCV.notify_all();
+#if defined(URing_FOUND)
+                        // The io_uring thread may be blocked waiting for
+                        // completions, wake it through the event.
+                        if (ReadAheadBackend::IOUring == backend)
+                        {
+                            const uint64_t value = 1;
+                            const ssize_t r = ::write(_eventFD, &value, sizeof(value));
+                            (void)r;
+                        }
+#endif // URing_FOUND
+                    }
+
+                    void addQueue(const std::shared_ptr<Queue>& value)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        _queues.push_back(value);
+                    }
+
+                    void removeQueue(const std::shared_ptr<Queue>& value)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            value->closed = true;
+                            _queues.remove(value);
+                        }
+                        readyCV.notify_all();
+                    }
+
+                    //! Add threads until there are at least the given number.
+                    void setThreadCount(size_t value)
+                    {
+                        if (ReadAheadBackend::Threads == backend)
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            while (_threads.size() < value)
+                            {
+                                _threads.push_back(std::thread(
+                                    [this]
+                                    {
+                                        _threadsRun();
+                                    }));
+                            }
+                        }
+                    }
+
+                private:
+                    //! Start the next request, taking the queues in turn. The
+                    //! mutex must be locked.
+                    bool _start(std::shared_ptr<Queue>& queue, std::string& fileName)
+                    {
+                        for (size_t i = 0; i < _queues.size(); ++i)
+                        {
+                            queue = _queues.front();
+                            _queues.splice(_queues.end(), _queues, _queues.begin());
+                            if (queue->canStart())
+                            {
+                                fileName = queue->start();
+                                return true;
+                            }
+                        }
+                        return false;
+                    }
+
+                    bool _canStart() const
+                    {
+                        for (const auto& i : _queues)
+                        {
+                            if (i->canStart())
+                            {
+                                return true;
+                            }
+                        }
+                        return false;
+                    }
+
+                    void _finish(
+                        const std::shared_ptr<Queue>& queue,
+                        const std::string& fileName,
+                        const std::shared_ptr<std::vector<uint8_t> >& data)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            queue->finish(fileName, data);
+                        }
+                        readyCV.notify_all();
+                        requestCV.notify_all();
+                    }
+
+                    void _threadsRun()
+                    {
+                        while (true)
+                        {
+                            std::shared_ptr<Queue> queue;
+                            std::string fileName;
+                            {
+                                std::unique_lock<std::mutex> lock(mutex);
+                                requestCV.wait(
+                                    lock,
+                                    [this]
+                                    {
+                                        return _canStart() || !_running;
+                                    });
+                                if (!_running)
+                                {
+                                    break;
+                                }
+                                _start(queue, fileName);
+                            }
+                            if (!queue)
+                                continue;
+
+                            std::shared_ptr<std::vector<uint8_t> > data;
+                            try
+                            {
+                                auto io = FileIO::create();
+                                io->open(fileName, FileIO::Mode::Read);
+                                const size_t size = io->getSize();
+                                data = std::shared_ptr<std::vector<uint8_t> >(new std::vector<uint8_t>(size));
+                                if (size)
+                                {
+                                    io->read(data->data(), size);
+                                }
+                            }
+                            catch (const std::exception&)
+                            {
+                                // The decoder will report the error when it reads the file.
+                                data.reset();
+                            }
+                            _finish(queue, fileName, data);
+                        }
+                    }
+
+#if defined(URing_FOUND)
+                    void _ioUringRun();
+
+                    struct io_uring _ring;
+                    int _eventFD = -1;
+                    uint64_t _eventValue = 0;
+#endif // URing_FOUND
+
+                    std::list<std::shared_ptr<Queue> > _queues;
+                    std::vector<std::thread> _threads;
+                    bool _running = true;
+                };
+
+                std::shared_ptr<Pool> getPool()
+                {
+                    static std::mutex mutex;
+                    static std::weak_ptr<Pool> pool;
+                    std::lock_guard<std::mutex> lock(mutex);
+                    auto out = pool.lock();
+                    if (!out)
+                    {
+                        out = std::shared_ptr<Pool>(new Pool);
+                        pool = out;
+                    }
+                    return out;
+                }
+
+#if defined(URing_FOUND)
+                void Pool::_ioUringRun()
+                {
+                    struct Slot
+                    {
+                        std::shared_ptr<Queue> queue;
+                        std::string fileName;
+                        int fd = -1;
+                        size_t offset = 0;
+                        std::shared_ptr<std::vector<uint8_t> > data;
+                    };
+                    auto submit = [this](Slot* slot)
+                    {
+                        // The number of reads in flight is limited to the size of
+                        // the ring, but flush the queue if it is full anyway.
+                        struct io_uring_sqe* sqe = io_uring_get_sqe(&_ring);
+                        if (!sqe)
+                        {
+                            io_uring_submit(&_ring);
+                            sqe = io_uring_get_sqe(&_ring);
+                        }
+                        if (!sqe)
+                        {
+                            return false;
+                        }
+                        io_uring_prep_read(
+                            sqe,
+                            slot->fd,
+                            slot->data->data() + slot->offset,
+                            static_cast<unsigned>(std::min(slot->data->size() - slot->offset, ringReadMax)),
+                            slot->offset);
+                        io_uring_sqe_set_data(sqe, slot);
+                        return true;
+                    };
+                    // Read the event so notify() can wake the thread, the
+                    // completion has no slot.
+                    auto submitEvent = [this]
+                    {
+                        struct io_uring_sqe* sqe = io_uring_get_sqe(&_ring);
+                        if (!sqe)
+                        {
+                            io_uring_submit(&_ring);
+                            sqe = io_uring_get_sqe(&_ring);
+                        }
+                        if (sqe)
+                        {
+                            io_uring_prep_read(sqe, _eventFD, &_eventValue, sizeof(_eventValue), 0);
+                            io_uring_sqe_set_data(sqe, nullptr);
+                        }
+                    };
+                    auto complete = [this](Slot* slot, bool ok)
+                    {
+                        if (slot->fd != -1)
+                        {
+                            ::close(slot->fd);
+                        }
+                        _finish(slot->queue, slot->fileName, ok ? slot->data : nullptr);
+                        delete slot;
+                    };
+
+                    submitEvent();
+                    io_uring_submit(&_ring);
+                    size_t slotCount = 0;
+                    bool running = true;
+                    while (running)
+                    {
+                        // Batch the requests that can be started, up to the size
+                        // of the ring.
+                        std::vector<std::pair<std::shared_ptr<Queue>, std::string> > requests;
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            if (0 == slotCount)
+                            {
+                                requestCV.wait(
+                                    lock,
+                                    [this]
+                                    {
+                                        return _canStart() || !_running;
+                                    });
+                            }
+                            running = _running;
+                            std::shared_ptr<Queue> queue;
+                            std::string fileName;
+                            while (running && slotCount + requests.size() < ringSize - 1 && _start(queue, fileName))
+                            {
+                                requests.push_back(std::make_pair(queue, fileName));
+                            }
+                        }
+                        if (!running)
+                        {
+                            for (const auto& i : requests)
+                            {
+                                _finish(i.first, i.second, nullptr);
+                            }
+                            break;
+                        }
+
+                        // Open the files and submit the reads together.
+                        size_t submitCount = 0;
+                        for (const auto& request : requests)
+                        {
+                            const std::string& fileName = request.second;
+                            Slot* slot = new Slot;
+                            slot->queue = request.first;
+                            slot->fileName = fileName;
+                            slot->fd = ::open(fileName.c_str(), O_RDONLY);
+                            struct stat info;
+                            if (-1 == slot->fd || fstat(slot->fd, &info) != 0)
+                            {
+                                complete(slot, false);
+                                continue;
+                            }
+                            slot->data = std::shared_ptr<std::vector<uint8_t> >(new std::vector<uint8_t>(info.st_size));
+                            if (0 == info.st_size)
+                            {
+                                complete(slot, true);
+                                continue;
+                            }
+                            if (!submit(slot))
+                            {
+                                complete(slot, false);
+                                continue;
+                            }
+                            ++slotCount;
+                            ++submitCount;
+                        }
+                        if (submitCount)
+                        {
+                            io_uring_submit(&_ring);
+                        }
+
+                        // Reap the completions, re-submitting short reads and
+                        // the remaining chunks of large files.
+                        struct io_uring_cqe* cqe = nullptr;
+                        if (slotCount && 0 == io_uring_wait_cqe(&_ring, &cqe))
+                        {
+                            bool resubmit = false;
+                            unsigned head = 0;
+                            unsigned count = 0;
+                            io_uring_for_each_cqe(&_ring, head, cqe)
+                            {
+                                ++count;
+                                Slot* slot = reinterpret_cast<Slot*>(io_uring_cqe_get_data(cqe));
+                                if (!slot)
+                                {
+                                    submitEvent();
+                                    resubmit = true;
+                                    continue;
+                                }
+                                if (cqe->res > 0)
+                                {
+                                    slot->offset += cqe->res;
+                                    if (slot->offset < slot->data->size() && submit(slot))
+                                    {
+                                        resubmit = true;
+                                        continue;
+                                    }
+                                }
+                                --slotCount;
+                                complete(slot, slot->offset == slot->data->size());
+                            }
+                            io_uring_cq_advance(&_ring, count);
+                            if (resubmit)
+                            {
+                                io_uring_submit(&_ring);
+                            }
+                        }
+                    }
+
+                    // Drain the reads that are still in flight.
+                    while (slotCount)
+                    {
+                        struct io_uring_cqe* cqe = nullptr;
+                        if (io_uring_wait_cqe(&_ring, &cqe) != 0)
+                        {
+                            break;
+                        }
+                        Slot* slot = reinterpret_cast<Slot*>(io_uring_cqe_get_data(cqe));
+                        io_uring_cqe_seen(&_ring, cqe);
+                        if (slot)
+                        {
+                            --slotCount;
+                            complete(slot, false);
+                        }
+                    }
+                }
+#endif // URing_FOUND
+
+            } // namespace
+
+            bool ReadAheadStats::operator == (const ReadAheadStats& other) const
+            {
+                return backend == other.backend &&
+                    queueDepth == other.queueDepth &&
+                    inFlight == other.inFlight &&
+                    readyCount == other.readyCount &&
+                    readyByteCount == other.readyByteCount &&
+                    mbPerSecond == other.mbPerSecond &&
+                    hits == other.hits &&
+                    misses == other.misses;
+            }
+
+            struct ReadAhead::Private
+            {
+                std::shared_ptr<Pool> pool;
+                std::shared_ptr<Queue> queue;
+            };
+
+            void ReadAhead::_init(size_t threadCount)
+            {
+                DJV_PRIVATE_PTR();
+                p.pool = getPool();
+                p.queue = std::shared_ptr<Queue>(new Queue);
+                p.queue->threadCount = std::max(threadCount, static_cast<size_t>(1));
+                p.pool->addQueue(p.queue);
+                p.pool->setThreadCount(p.queue->threadCount);
+            }
+
+            ReadAhead::ReadAhead() :
+                _p(new Private)
+            {}
+
+            ReadAhead::~ReadAhead()
+            {
+                DJV_PRIVATE_PTR();
+                p.pool->removeQueue(p.queue);
+            }
+
+            std::shared_ptr<ReadAhead> ReadAhead::create(size_t threadCount)
+            {
+                auto out = std::shared_ptr<ReadAhead>(new ReadAhead);
+                out->_init(threadCount);
+                return out;
+            }
+
+            ReadAheadBackend ReadAhead::getBackend() const
+            {
+                return _p->pool->backend;
+            }
+
+            size_t ReadAhead::getMaxByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::lock_guard<std::mutex> lock(p.pool->mutex);
+                return p.queue->maxByteCount;
+            }
+
+            void ReadAhead::setMaxByteCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.pool->mutex);
+                    p.queue->maxByteCount = value;
+                }
+                p.pool->notify();
+            }
+
+            void ReadAhead::setThreadCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                value = std::max(value, static_cast<size_t>(1));
+                {
+                    std::lock_guard<std::mutex> lock(p.pool->mutex);
+                    p.queue->threadCount = value;
+                }
+                p.pool->setThreadCount(value);
+                p.pool->notify();
+            }
+
+            void ReadAhead::request(const std::vector<std::string>& fileNames)
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.pool->mutex);
+                    auto& queue = *p.queue;
+                    for (auto& i : queue.requests)
+                    {
+                        i.second->wanted = false;
+                    }
+                    queue.pending.clear();
+                    for (const auto& i : fileNames)
+                    {
+                        const auto j = queue.requests.find(i);
+                        if (j != queue.requests.end())
+                        {
+                            j->second->wanted = true;
+                            if (RequestState::Pending == j->second->state)
+                            {
+                                queue.pending.push_back(i);
+                            }
+                        }
+                        else
+                        {
+                            queue.requests[i] = std::shared_ptr<Request>(new Request);
+                            queue.pending.push_back(i);
+                        }
+                    }
+                    auto i = queue.requests.begin();
+                    while (i != queue.requests.end())
+                    {
+                        if (!i->second->wanted && i->second->state != RequestState::InFlight)
+                        {
+                            if (i->second->data)
+                            {
+                                queue.byteCount -= i->second->data->size();
+                            }
+                            i = queue.requests.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                }
+                p.pool->notify();
+            }
+
+            std::shared_ptr<std::vector<uint8_t> > ReadAhead::take(const std::string& fileName)
+            {
+                DJV_PRIVATE_PTR();
+                std::shared_ptr<std::vector<uint8_t> > out;
+                {
+                    std::unique_lock<std::mutex> lock(p.pool->mutex);
+                    auto& queue = *p.queue;
+                    auto i = queue.requests.find(fileName);
+                    if (i != queue.requests.end())
+                    {
+                        auto request = i->second;
+                        switch (request->state)
+                        {
+                        case RequestState::Pending:
+                            // The read has not started yet, it is faster for
+                            // the caller to read the file directly.
+                            queue.pending.remove(fileName);
+                            queue.requests.erase(i);
+                            break;
+                        case RequestState::InFlight:
+                            p.pool->readyCV.wait(
+                                lock,
+                                [request, &queue]
+                                {
+                                    return request->state != RequestState::InFlight || queue.closed;
+                                });
+                            break;
+                        default: break;
+                        }
+                        if (request->data)
+                        {
+                            out = request->data;
+                            queue.byteCount -= out->size();
+                        }
+                        i = queue.requests.find(fileName);
+                        if (i != queue.requests.end() && i->second == request)
+                        {
+                            queue.requests.erase(i);
+                        }
+                    }
+                    if (out)
+                    {
+                        ++queue.hits;
+                    }
+                    else
+                    {
+                        ++queue.misses;
+                    }
+                }
+                p.pool->notify();
+                return out;
+            }
+
+            void ReadAhead::open(const std::string& fileName, const std::shared_ptr<FileIO>& io)
+            {
+                if (auto data = take(fileName))
+                {
+                    io->open(fileName, data);
+                }
+                else
+                {
+                    io->open(fileName, FileIO::Mode::Read);
+                }
+            }
+
+            void ReadAhead::clear()
+            {
+                request(std::vector<std::string>());
+            }
+
+            ReadAheadStats ReadAhead::getStats() const
+            {
+                DJV_PRIVATE_PTR();
+                ReadAheadStats out;
+                out.backend = p.pool->backend;
+                std::lock_guard<std::mutex> lock(p.pool->mutex);
+                const auto& queue = *p.queue;
+                out.queueDepth = queue.pending.size();
+                out.inFlight = queue.inFlight;
+                for (const auto& i : queue.requests)
+                {
+                    if (RequestState::Ready == i.second->state)
+                    {
+                        ++out.readyCount;
+                    }
+                }
+                out.readyByteCount = queue.byteCount;
+                const auto now = std::chrono::steady_clock::now();
+                size_t byteCount = 0;
+                for (const auto& i : queue.throughput)
+                {
+                    if (now - i.first < throughputWindow)
+                    {
+                        byteCount += i.second;
+                    }
+                }
+                out.mbPerSecond = byteCount / static_cast<float>(Memory::megabyte) *
+                    (1000.F / static_cast<float>(throughputWindow.count()));
+                out.hits = queue.hits;
+                out.misses = queue.misses;
+                return out;
+            }
+
+        } // namespace FileSystem
+    } // namespace Core
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        Core::FileSystem,
+        ReadAheadBackend,
+        DJV_TEXT("read_ahead_backend_threads"),
+        DJV_TEXT("read_ahead_backend_io_uring"));
+
+} // namespace djv
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Enum.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            class FileIO;
+
+            //! This enumeration provides the read-ahead backends.
+            enum class ReadAheadBackend
+            {
+                Threads, //!< A pool of threads using blocking reads
+                IOUring, //!< Linux io_uring batched submission
+
+                Count,
+                First = Threads
+            };
+            DJV_ENUM_HELPERS(ReadAheadBackend);
+
+            //! This struct provides read-ahead statistics.
+            struct ReadAheadStats
+            {
+                ReadAheadBackend backend        = ReadAheadBackend::First;
+                size_t           queueDepth     = 0;  //!< Requests waiting to be started
+                size_t           inFlight       = 0;  //!< Requests currently being read
+                size_t           readyCount     = 0;  //!< Buffers waiting to be taken
+                size_t           readyByteCount = 0;
+                float            mbPerSecond    = 0.F; //!< Read throughput over the last second
+                size_t           hits           = 0;  //!< Files that were taken from read-ahead
+                size_t           misses         = 0;  //!< Files that had to be read directly
+
+                bool operator == (const ReadAheadStats&) const;
+            };
+
+            //! This class provides asynchronous read-ahead of whole files.
+            //!
+            //! Files are read in the order they are requested, either by a pool
+            //! of threads or, on Linux when liburing is available, by batching
+            //! the reads through io_uring. The data is handed to decoders
+            //! through FileIO so they do not need to know whether it came
+            //! from the read-ahead queue or from the disk.
+            //!
+            //! The threads and the io_uring ring are shared by all of the
+            //! read-ahead queues in the process.
+            class ReadAhead
+            {
+                DJV_NON_COPYABLE(ReadAhead);
+
+            protected:
+                void _init(size_t threadCount);
+                ReadAhead();
+
+            public:
+                ~ReadAhead();
+
+                //! Create a new read-ahead queue.
+                static std::shared_ptr<ReadAhead> create(size_t threadCount = 4);
+
+                //! Get the backend in use.
+                ReadAheadBackend getBackend() const;
+
+                //! \name Options
+                ///@{
+
+                //! Get the maximum number of bytes that may be read ahead.
+                size_t getMaxByteCount() const;
+
+                //! Set the maximum number of bytes that may be read ahead.
+                void setMaxByteCount(size_t);
+
+                //! Set the number of reads from this queue that may be in flight
+                //! at once.
+                void setThreadCount(size_t);
+
+                ///@}
+
+                //! \name Requests
+                ///@{
+
+                //! Set the files to read ahead, in priority order. Pending
+                //! requests and finished reads that are no longer wanted are
+                //! discarded, reads that are in flight are discarded when
+                //! they finish.
+                void request(const std::vector<std::string>&);
+
+                //! Take the data for a file. If the read is in flight this
+                //! waits for it to finish. Returns null if the file was not
+                //! requested or the read failed.
+                std::shared_ptr<std::vector<uint8_t> > take(const std::string&);
+
+                //! Open a file, using the read-ahead data if it is available.
+                //! Throws:
+                //! - Error
+                void open(const std::string&, const std::shared_ptr<FileIO>&);
+
+                //! Discard all requests and data.
+                void clear();
+
+                ///@}
+
+                //! Get the statistics.
+                ReadAheadStats getStats() const;
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace FileSystem
+    } // namespace Core
+
+    DJV_ENUM_SERIALIZE_HELPERS(Core::FileSystem::ReadAheadBackend);
+
+} // namespace djv
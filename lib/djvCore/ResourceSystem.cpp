@@ -193,6 +193,7 @@ namespace djv
         {
             auto out = std::shared_ptr<ResourceSystem>(new ResourceSystem);
             out->_init(argv0, context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -0,0 +1,306 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCore/TextCatalog.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/StringFormat.h>
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            // Increment the version when the catalog format changes.
+            const uint32_t catalogVersion = 1;
+            const char     catalogMagic[] = { 'D', 'J', 'V', 'T' };
+            const size_t   headerSize     = 24;
+            const size_t   entrySize      = 20;
+
+            //! This struct provides a catalog entry.
+            struct Entry
+            {
+                uint32_t hash       = 0;
+                uint32_t idOffset   = 0;
+                uint32_t idSize     = 0;
+                uint32_t textOffset = 0;
+                uint32_t textSize   = 0;
+            };
+
+            uint32_t readU32(const uint8_t* p)
+            {
+                uint32_t out = 0;
+                memcpy(&out, p, sizeof(uint32_t));
+                return out;
+            }
+
+            void writeU32(uint8_t* p, uint32_t value)
+            {
+                memcpy(p, &value, sizeof(uint32_t));
+            }
+
+        } // namespace
+
+        struct TextCatalog::Private
+        {
+            std::shared_ptr<FileSystem::FileIO> io;
+            std::vector<uint8_t> data;
+
+            uint64_t key = 0;
+            uint32_t entryCount = 0;
+            uint32_t slotCount = 0;
+            const uint8_t* slots = nullptr;
+            const uint8_t* entries = nullptr;
+            const uint8_t* strings = nullptr;
+            size_t stringsSize = 0;
+
+            std::mutex mutex;
+            std::vector<std::unique_ptr<std::string> > text;
+            std::vector<std::unique_ptr<std::string> > ids;
+
+            bool getEntry(uint32_t index, Entry&) const;
+        };
+
+        bool TextCatalog::Private::getEntry(uint32_t index, Entry& out) const
+        {
+            if (index >= entryCount)
+                return false;
+            const uint8_t* p = entries + index * entrySize;
+            out.hash       = readU32(p);
+            out.idOffset   = readU32(p + 4);
+            out.idSize     = readU32(p + 8);
+            out.textOffset = readU32(p + 12);
+            out.textSize   = readU32(p + 16);
+            return
+                static_cast<size_t>(out.idOffset) + out.idSize <= stringsSize &&
+                static_cast<size_t>(out.textOffset) + out.textSize <= stringsSize;
+        }
+
+        void TextCatalog::_init(const uint8_t* data, size_t size)
+        {
+            DJV_PRIVATE_PTR();
+            if (size < headerSize || memcmp(data, catalogMagic, sizeof(catalogMagic)) != 0)
+            {
+                throw FileSystem::Error(DJV_TEXT("error_file_read"));
+            }
+            const uint32_t version = readU32(data + 4);
+            memcpy(&p.key, data + 8, sizeof(uint64_t));
+            p.entryCount = readU32(data + 16);
+            p.slotCount = readU32(data + 20);
+            const size_t tablesSize =
+                static_cast<size_t>(p.slotCount) * sizeof(uint32_t) +
+                static_cast<size_t>(p.entryCount) * entrySize;
+            if (version != catalogVersion ||
+                0 == p.slotCount ||
+                (p.slotCount & (p.slotCount - 1)) != 0 ||
+                p.entryCount > p.slotCount ||
+                headerSize + tablesSize > size)
+            {
+                throw FileSystem::Error(DJV_TEXT("error_file_read"));
+            }
+            p.slots = data + headerSize;
+            p.entries = p.slots + p.slotCount * sizeof(uint32_t);
+            p.strings = p.entries + p.entryCount * entrySize;
+            p.stringsSize = size - headerSize - tablesSize;
+            p.text.resize(p.entryCount);
+            p.ids.resize(p.entryCount);
+        }
+
+        TextCatalog::TextCatalog() :
+            _p(new Private)
+        {}
+
+        TextCatalog::~TextCatalog()
+        {}
+
+        std::shared_ptr<TextCatalog> TextCatalog::create(const std::map<std::string, std::string>& value, uint64_t key)
+        {
+            auto out = std::shared_ptr<TextCatalog>(new TextCatalog);
+
+            // Use a table with at least twice as many slots as entries to keep
+            // the probe sequences short.
+            const uint32_t entryCount = static_cast<uint32_t>(value.size());
+            uint32_t slotCount = 1;
+            while (slotCount < entryCount * 2)
+            {
+                slotCount <<= 1;
+            }
+            size_t stringsSize = 0;
+            for (const auto& i : value)
+            {
+                stringsSize += i.first.size() + i.second.size();
+            }
+
+            auto& data = out->_p->data;
+            data.resize(headerSize + slotCount * sizeof(uint32_t) + entryCount * entrySize + stringsSize, 0);
+            memcpy(data.data(), catalogMagic, sizeof(catalogMagic));
+            writeU32(data.data() + 4, catalogVersion);
+            memcpy(data.data() + 8, &key, sizeof(uint64_t));
+            writeU32(data.data() + 16, entryCount);
+            writeU32(data.data() + 20, slotCount);
+
+            uint8_t* slots = data.data() + headerSize;
+            uint8_t* entries = slots + slotCount * sizeof(uint32_t);
+            uint8_t* strings = entries + entryCount * entrySize;
+            uint32_t index = 0;
+            uint32_t offset = 0;
+            for (const auto& i : value)
+            {
+                const uint64_t hash = getHash(i.first);
+                uint8_t* entry = entries + index * entrySize;
+                writeU32(entry, static_cast<uint32_t>(hash));
+                writeU32(entry + 4, offset);
+                writeU32(entry + 8, static_cast<uint32_t>(i.first.size()));
+                memcpy(strings + offset, i.first.data(), i.first.size());
+                offset += static_cast<uint32_t>(i.first.size());
+                writeU32(entry + 12, offset);
+                writeU32(entry + 16, static_cast<uint32_t>(i.second.size()));
+                memcpy(strings + offset, i.second.data(), i.second.size());
+                offset += static_cast<uint32_t>(i.second.size());
+
+                uint32_t slot = static_cast<uint32_t>(hash) & (slotCount - 1);
+                while (readU32(slots + slot * sizeof(uint32_t)) != 0)
+                {
+                    slot = (slot + 1) & (slotCount - 1);
+                }
+                writeU32(slots + slot * sizeof(uint32_t), index + 1);
+                ++index;
+            }
+
+            out->_init(data.data(), data.size());
+            return out;
+        }
+
+        std::shared_ptr<TextCatalog> TextCatalog::read(const std::string& fileName)
+        {
+            auto out = std::shared_ptr<TextCatalog>(new TextCatalog);
+
+            // Memory map the file, falling back to reading it into memory when
+            // mapping is not available.
+            auto io = FileSystem::FileIO::create();
+            io->setReadType(FileSystem::ReadType::MemoryMap);
+            io->open(fileName, FileSystem::FileIO::Mode::Read);
+            const uint8_t* start = io->mmapP();
+            const uint8_t* end = io->mmapEnd();
+            if (start)
+            {
+                out->_p->io = io;
+            }
+            else
+            {
+                auto& data = out->_p->data;
+                data.resize(io->getSize());
+                io->read(data.data(), data.size());
+                start = data.data();
+                end = start + data.size();
+            }
+            try
+            {
+                out->_init(start, end - start);
+            }
+            catch (const std::exception&)
+            {
+                throw FileSystem::Error(String::Format("{0}: {1}").
+                    arg(fileName).
+                    arg(DJV_TEXT("error_file_read")));
+            }
+            return out;
+        }
+
+        void TextCatalog::write(const std::string& fileName) const
+        {
+            DJV_PRIVATE_PTR();
+            const uint8_t* data = p.slots - headerSize;
+            const size_t size = headerSize +
+                p.slotCount * sizeof(uint32_t) +
+                p.entryCount * entrySize +
+                p.stringsSize;
+            FileSystem::FileIO::writeAtomic(fileName, data, size);
+        }
+
+        uint64_t TextCatalog::getKey() const
+        {
+            return _p->key;
+        }
+
+        size_t TextCatalog::getCount() const
+        {
+            return _p->entryCount;
+        }
+
+        const std::string* TextCatalog::getText(const std::string& id) const
+        {
+            DJV_PRIVATE_PTR();
+            const uint32_t hash = static_cast<uint32_t>(getHash(id));
+            uint32_t slot = hash & (p.slotCount - 1);
+            for (uint32_t i = 0; i < p.slotCount; ++i)
+            {
+                const uint32_t index = readU32(p.slots + slot * sizeof(uint32_t));
+                if (0 == index)
+                    break;
+                Entry entry;
+                if (p.getEntry(index - 1, entry) &&
+                    entry.hash == hash &&
+                    entry.idSize == id.size() &&
+                    0 == memcmp(p.strings + entry.idOffset, id.data(), id.size()))
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    auto& text = p.text[index - 1];
+                    if (!text)
+                    {
+                        text.reset(new std::string(
+                            reinterpret_cast<const char*>(p.strings + entry.textOffset),
+                            entry.textSize));
+                    }
+                    return text.get();
+                }
+                slot = (slot + 1) & (p.slotCount - 1);
+            }
+            return nullptr;
+        }
+
+        const std::string* TextCatalog::getID(const std::string& text) const
+        {
+            DJV_PRIVATE_PTR();
+            for (uint32_t i = 0; i < p.entryCount; ++i)
+            {
+                Entry entry;
+                if (p.getEntry(i, entry) &&
+                    entry.textSize == text.size() &&
+                    0 == memcmp(p.strings + entry.textOffset, text.data(), text.size()))
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    auto& id = p.ids[i];
+                    if (!id)
+                    {
+                        id.reset(new std::string(
+                            reinterpret_cast<const char*>(p.strings + entry.idOffset),
+                            entry.idSize));
+                    }
+                    return id.get();
+                }
+            }
+            return nullptr;
+        }
+
+        uint64_t TextCatalog::getHash(const std::string& value, uint64_t seed)
+        {
+            // FNV-1a
+            uint64_t out = 14695981039346656037ULL ^ seed;
+            for (const auto i : value)
+            {
+                out ^= static_cast<uint8_t>(i);
+                out *= 1099511628211ULL;
+            }
+            return out;
+        }
+
+    } // namespace Core
+} // namespace djv
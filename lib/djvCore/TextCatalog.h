@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides a compiled catalog of the text for a locale.
+        //!
+        //! The catalog is a hash table of the text IDs that is stored in a
+        //! single block of memory, either built from the text or memory mapped
+        //! from a catalog file, so lookups do not need to parse or copy the
+        //! whole catalog. The strings are only copied the first time they are
+        //! looked up, and the references stay valid for the life of the
+        //! catalog.
+        class TextCatalog
+        {
+            DJV_NON_COPYABLE(TextCatalog);
+
+        protected:
+            TextCatalog();
+
+        public:
+            ~TextCatalog();
+
+            //! Create a new catalog from the given text. The key identifies the
+            //! source of the text so stale catalog files can be detected.
+            static std::shared_ptr<TextCatalog> create(
+                const std::map<std::string, std::string>&,
+                uint64_t key = 0);
+
+            //! Read a catalog file.
+            //! Throws:
+            //! - FileSystem::Error
+            static std::shared_ptr<TextCatalog> read(const std::string& fileName);
+
+            //! Write the catalog to a file. The file is replaced atomically.
+            //! Throws:
+            //! - FileSystem::Error
+            void write(const std::string& fileName) const;
+
+            //! Get the key.
+            uint64_t getKey() const;
+
+            //! Get the number of strings.
+            size_t getCount() const;
+
+            //! Get the text for the given ID, or null if the ID is not found.
+            const std::string* getText(const std::string& id) const;
+
+            //! Get the ID for the given text, or null if the text is not found.
+            //! This searches every entry.
+            const std::string* getID(const std::string& text) const;
+
+            //! Get a hash of the given string that is the same across platforms
+            //! and runs.
+            static uint64_t getHash(const std::string&, uint64_t seed = 0);
+
+        private:
+            void _init(const uint8_t*, size_t);
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace Core
+} // namespace djv
@@ -14,8 +14,10 @@
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/String.h>
 #include <djvCore/StringFormat.h>
+#include <djvCore/TextCatalog.h>
 #include <djvCore/Timer.h>
 
+#include <chrono>
 #include <future>
 #include <locale>
 #include <mutex>
@@ -33,16 +35,19 @@ namespace djv
             std::shared_ptr<LogSystem> logSystem;
 
             std::vector<FileSystem::FileInfo> textFiles;
+            FileSystem::Path catalogPath;
+            std::string catalogPrefix;
 
             std::vector<std::string> locales;
             std::string systemLocale;
             std::shared_ptr<ValueSubject<std::string> > currentLocale;
 
-            TextMap text;
+            std::map<std::string, std::shared_ptr<TextCatalog> > catalogs;
+            std::vector<std::shared_ptr<TextCatalog> > replacedCatalogs;
             std::shared_ptr<ValueSubject<bool> > textChanged;
 
             mutable std::mutex mutex;
-            std::vector<std::future<TextMap> > readFutures;
+            std::map<std::string, std::future<std::shared_ptr<TextCatalog> > > catalogFutures;
             std::future<std::vector<FileSystem::FileInfo> > statFuture;
             std::shared_ptr<Time::Timer> timer;
         };
@@ -113,6 +118,23 @@ namespace djv
 #endif // DJV_PLATFORM_WINDOWS
                 return out;
             }
+
+            std::string getLocale(const FileSystem::FileInfo& textFile)
+            {
+                std::string out = FileSystem::Path(textFile.getPath().getBaseName()).getExtension();
+                if (out.size() && '.' == out[0])
+                {
+                    out.erase(out.begin());
+                }
+                return out;
+            }
+
+            size_t getMilliseconds(const std::chrono::steady_clock::time_point& start)
+            {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+            }
+
         } // namespace
 
         void TextSystem::_init(const std::shared_ptr<Context>& context)
@@ -138,14 +160,10 @@ namespace djv
             std::set<std::string> localeSet;
             for (const auto& textFile : p.textFiles)
             {
-                std::string temp = FileSystem::Path(textFile.getPath().getBaseName()).getExtension();
-                if (temp.size() && '.' == temp[0])
-                {
-                    temp.erase(temp.begin());
-                }
-                if (temp != "all")
+                const std::string locale = getLocale(textFile);
+                if (locale != "all")
                 {
-                    localeSet.insert(temp);
+                    localeSet.insert(locale);
                 }
             }
             for (const auto& locale : localeSet)
@@ -204,11 +222,25 @@ namespace djv
             ss << "System locale: " << p.systemLocale;
             p.logSystem->log(getSystemName(), ss.str());
 
-            // Load the text.
-            for (const auto& j : p.textFiles)
+            // Load the text for the default and system locales, other locales
+            // are loaded when they are used.
+            p.catalogPath = FileSystem::Path(
+                resourceSystem->getPath(FileSystem::ResourcePath::Documents),
+                "TextCatalog");
+            p.catalogPrefix = context->getName();
+            try
             {
-                _reload(j);
+                if (!FileSystem::FileInfo(p.catalogPath).doesExist())
+                {
+                    FileSystem::Path::mkdir(p.catalogPath);
+                }
             }
+            catch (const std::exception& e)
+            {
+                p.logSystem->log(getSystemName(), e.what(), LogLevel::Error);
+            }
+            _load(p.currentLocale->get());
+            _load(p.systemLocale);
 
             p.timer = Time::Timer::create(context);
             p.timer->setRepeating(true);
@@ -219,33 +251,13 @@ namespace djv
                 {
                     if (auto system = weak.lock())
                     {
-                        bool textChanged = false;
-                        auto j = system->_p->readFutures.begin();
-                        while (j != system->_p->readFutures.end())
+                        // The text changed observers have been notified since
+                        // the catalogs were replaced so they can be released.
                         {
-                            if (j->valid() &&
-                                j->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
-                            {
-                                for (const auto& k : j->get())
-                                {
-                                    std::unique_lock<std::mutex> lock(system->_p->mutex);
-                                    for (const auto& l : k.second)
-                                    {
-                                        system->_p->text[k.first][l.first] = l.second;
-                                        textChanged = true;
-                                    }
-                                }
-                                j = system->_p->readFutures.erase(j);
-                            }
-                            else
-                            {
-                                ++j;
-                            }
-                        }
-                        if (textChanged)
-                        {
-                            system->_p->textChanged->setAlways(true);
+                            std::unique_lock<std::mutex> lock(system->_p->mutex);
+                            system->_p->replacedCatalogs.clear();
                         }
+                        system->_readAllFutures();
 
                         bool stat = false;
                         if (system->_p->statFuture.valid())
@@ -253,16 +265,25 @@ namespace djv
                             if (system->_p->statFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                             {
                                 auto textFiles = system->_p->statFuture.get();
+                                std::set<std::string> locales;
                                 for (auto k = system->_p->textFiles.begin(), l = textFiles.begin();
                                     k != system->_p->textFiles.end() && l != textFiles.end();
                                     ++k, ++l)
                                 {
                                     if (l->getTime() > k->getTime())
                                     {
-                                        system->_reload(*l);
+                                        locales.insert(getLocale(*l));
                                         *k = *l;
                                     }
                                 }
+                                for (const auto& locale : locales)
+                                {
+                                    // Only reload the locales that are in use.
+                                    if (system->_p->catalogs.find(locale) != system->_p->catalogs.end())
+                                    {
+                                        system->_load(locale);
+                                    }
+                                }
                                 stat = true;
                             }
                         }
@@ -300,6 +321,7 @@ namespace djv
         {
             auto out = std::shared_ptr<TextSystem>(new TextSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -323,6 +345,10 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.currentLocale->setIfChanged(value))
             {
+                if (p.catalogs.find(value) == p.catalogs.end())
+                {
+                    _load(value);
+                }
                 p.textChanged->setAlways(true);
             }
         }
@@ -333,13 +359,12 @@ namespace djv
             _readAllFutures();
             {
                 std::unique_lock<std::mutex> lock(p.mutex);
-                const auto i = p.text.find(p.currentLocale->get());
-                if (i != p.text.end())
+                const auto i = p.catalogs.find(p.currentLocale->get());
+                if (i != p.catalogs.end())
                 {
-                    const auto j = i->second.find(id);
-                    if (j != i->second.end())
+                    if (auto text = i->second->getText(id))
                     {
-                        return j->second;
+                        return *text;
                     }
                 }
             }
@@ -352,15 +377,12 @@ namespace djv
             _readAllFutures();
             {
                 std::unique_lock<std::mutex> lock(p.mutex);
-                const auto i = p.text.find(p.currentLocale->get());
-                if (i != p.text.end())
+                const auto i = p.catalogs.find(p.currentLocale->get());
+                if (i != p.catalogs.end())
                 {
-                    for (const auto& j : i->second)
+                    if (auto id = i->second->getID(text))
                     {
-                        if (text == j.second)
-                        {
-                            return j.first;
-                        }
+                        return *id;
                     }
                 }
             }
@@ -406,28 +428,105 @@ namespace djv
             return out;
         }
         
-        void TextSystem::_reload(const FileSystem::FileInfo& value)
+        void TextSystem::_load(const std::string& locale)
         {
             DJV_PRIVATE_PTR();
+            if (locale.empty() || p.catalogFutures.find(locale) != p.catalogFutures.end())
+                return;
+            std::vector<FileSystem::FileInfo> textFiles;
+            for (const auto& i : p.textFiles)
+            {
+                if (getLocale(i) == locale)
+                {
+                    textFiles.push_back(i);
+                }
+            }
+            if (textFiles.empty())
+                return;
+            const std::string catalogFileName = std::string(
+                FileSystem::Path(p.catalogPath, p.catalogPrefix + "." + locale + ".catalog"));
             auto weak = std::weak_ptr<TextSystem>(std::dynamic_pointer_cast<TextSystem>(shared_from_this()));
-            auto fileInfo = value;
-            p.readFutures.push_back(std::async(
+            p.catalogFutures[locale] = std::async(
                 std::launch::async,
-                [weak, fileInfo]
+                [weak, locale, textFiles, catalogFileName]
                 {
-                    TextMap out;
+                    std::shared_ptr<TextCatalog> out;
                     if (auto system = weak.lock())
                     {
-                        out = system->_readText(fileInfo);
+                        out = system->_readCatalog(locale, textFiles, catalogFileName);
                     }
                     return out;
-                }));
+                });
         }
 
-        TextSystem::TextMap TextSystem::_readText(const FileSystem::FileInfo& textFile)
+        std::shared_ptr<TextCatalog> TextSystem::_readCatalog(
+            const std::string& locale,
+            const std::vector<FileSystem::FileInfo>& textFiles,
+            const std::string& catalogFileName)
+        {
+            DJV_PRIVATE_PTR();
+            const auto start = std::chrono::steady_clock::now();
+
+            // The key identifies the text files the catalog was compiled from.
+            uint64_t key = 0;
+            for (const auto& i : textFiles)
+            {
+                key = TextCatalog::getHash(i.getPath().get(), key);
+                key = TextCatalog::getHash(std::to_string(i.getSize()), key);
+                key = TextCatalog::getHash(std::to_string(i.getTime()), key);
+            }
+
+            // Use the compiled catalog if it is up to date.
+            std::shared_ptr<TextCatalog> out;
+            if (FileSystem::FileInfo(catalogFileName).doesExist())
+            {
+                try
+                {
+                    out = TextCatalog::read(catalogFileName);
+                    if (out->getKey() != key)
+                    {
+                        out.reset();
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    p.logSystem->log(getSystemName(), e.what(), LogLevel::Warning);
+                }
+            }
+            if (out)
+            {
+                std::stringstream ss;
+                ss << "Reading text catalog: " << catalogFileName << " (" << getMilliseconds(start) << "ms)";
+                p.logSystem->log(getSystemName(), ss.str());
+                return out;
+            }
+
+            // Compile the catalog from the text files.
+            std::map<std::string, std::string> text;
+            for (const auto& i : textFiles)
+            {
+                _readText(i, text);
+            }
+            out = TextCatalog::create(text, key);
+            {
+                std::stringstream ss;
+                ss << "Compiled text catalog: " << locale << " (" << getMilliseconds(start) << "ms)";
+                p.logSystem->log(getSystemName(), ss.str());
+            }
+            try
+            {
+                out->write(catalogFileName);
+            }
+            catch (const std::exception& e)
+            {
+                p.logSystem->log(getSystemName(), e.what(), LogLevel::Error);
+            }
+            return out;
+        }
+
+        void TextSystem::_readText(const FileSystem::FileInfo& textFile, std::map<std::string, std::string>& out)
         {
             DJV_PRIVATE_PTR();
-            TextMap out;
             {
                 std::stringstream ss;
                 ss << "Reading text file: " << textFile.getPath().get();
@@ -436,26 +535,14 @@ namespace djv
             try
             {
                 const auto& path = textFile.getPath();
-                const auto& baseName = path.getBaseName();
-                std::string locale;
-                for (auto j = baseName.rbegin(); j != baseName.rend() && *j != '.'; ++j)
-                {
-                    locale.insert(locale.begin(), *j);
-                }
-                
                 auto fileIO = FileSystem::FileIO::create();
                 fileIO->open(std::string(path), FileSystem::FileIO::Mode::Read);
-#if defined(DJV_MMAP)
-                const char* bufP = reinterpret_cast<const char*>(fileIO->mmapP());
-                const char* bufEnd = reinterpret_cast<const char*>(fileIO->mmapEnd());
-#else // DJV_MMAP
                 std::vector<char> buf;
                 const size_t fileSize = fileIO->getSize();
                 buf.resize(fileSize);
                 fileIO->read(buf.data(), fileSize);
                 const char* bufP = buf.data();
                 const char* bufEnd = bufP + fileSize;
-#endif // DJV_MMAP
 
                 // Parse the JSON.
                 picojson::value v;
@@ -468,16 +555,12 @@ namespace djv
                     
                 if (v.is<picojson::object>())
                 {
-                    std::string id;
-                    std::string text;
                     const auto& obj = v.get<picojson::object>();
                     for (auto i = obj.begin(); i != obj.end(); ++i)
                     {
-                        id = i->first;
-                        text = i->second.to_str();
-                        if (!id.empty())
+                        if (!i->first.empty())
                         {
-                            out[locale][id] = text;
+                            out[i->first] = i->second.to_str();
                         }
                     }
                 }
@@ -486,33 +569,36 @@ namespace djv
             {
                 p.logSystem->log(getSystemName(), e.what(), LogLevel::Error);
             }
-            return out;
         }
         
         void TextSystem::_readAllFutures()
         {
             DJV_PRIVATE_PTR();
             bool textChanged = false;
-            auto j = p.readFutures.begin();
-            while (j != p.readFutures.end())
+            auto i = p.catalogFutures.begin();
+            while (i != p.catalogFutures.end())
             {
-                if (j->valid() &&
-                    j->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                if (i->second.valid() &&
+                    i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                 {
-                    for (const auto& k : j->get())
+                    if (auto catalog = i->second.get())
                     {
                         std::unique_lock<std::mutex> lock(p.mutex);
-                        for (const auto& l : k.second)
+                        auto& current = p.catalogs[i->first];
+                        if (current)
                         {
-                            p.text[k.first][l.first] = l.second;
-                            textChanged = true;
+                            // Keep the replaced catalog until the next timer
+                            // tick so references to its text stay valid.
+                            p.replacedCatalogs.push_back(current);
                         }
+                        current = catalog;
+                        textChanged = true;
                     }
-                    j = p.readFutures.erase(j);
+                    i = p.catalogFutures.erase(i);
                 }
                 else
                 {
-                    ++j;
+                    ++i;
                 }
             }
             if (textChanged)
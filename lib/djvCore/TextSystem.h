@@ -13,6 +13,8 @@ namespace djv
 {
     namespace Core
     {
+        class TextCatalog;
+
         namespace FileSystem
         {
             class FileInfo;
@@ -26,6 +28,11 @@ namespace djv
         //! - FileSystem::ResourcePath::Documents
         //! - DJV_TEXT environment variable, a list of colon (Linux/OSX)
         //!   or semicolon (Windows) separated paths to search
+        //!
+        //! The text for a locale is loaded in the background the first time
+        //! the locale is used. The text files are compiled into a catalog that
+        //! is saved in FileSystem::ResourcePath::Documents, so later runs can
+        //! memory map the catalog instead of parsing the text files.
         class TextSystem : public ISystemBase
         {
             DJV_NON_COPYABLE(TextSystem);
@@ -75,9 +82,12 @@ namespace djv
 
         private:
             std::vector<FileSystem::FileInfo> _getTextFiles() const;
-            void _reload(const FileSystem::FileInfo&);
-            typedef std::map<std::string, std::map<std::string, std::string> > TextMap;
-            TextMap _readText(const FileSystem::FileInfo&);
+            void _load(const std::string& locale);
+            std::shared_ptr<TextCatalog> _readCatalog(
+                const std::string& locale,
+                const std::vector<FileSystem::FileInfo>&,
+                const std::string& catalogFileName);
+            void _readText(const FileSystem::FileInfo&, std::map<std::string, std::string>&);
             void _readAllFutures();
 
             DJV_PRIVATE();
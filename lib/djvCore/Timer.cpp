@@ -114,6 +114,7 @@ namespace djv
             {
                 auto out = std::shared_ptr<TimerSystem>(new TimerSystem);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
 
@@ -58,12 +58,20 @@ namespace djv
                 }
             }
 
-            // Create the systems.
+            // Create the systems. The OpenGL systems are optional for command
+            // line applications but required here, so try to create them
+            // again to report the error.
+            if (!getSystemT<AV::GLFW::System>())
+            {
+                AV::GLFW::System::create(shared_from_this());
+            }
             auto glfwSystem = GLFWSystem::create(shared_from_this());
             auto uiSystem = UI::UISystem::create(resetSettings, shared_from_this());
             auto avGLFWSystem = getSystemT<AV::GLFW::System>();
             auto glfwWindow = avGLFWSystem->getGLFWWindow();
             auto eventSystem = EventSystem::create(glfwWindow, shared_from_this());
+
+            _setStartupEnd();
         }
         
         Application::Application() :
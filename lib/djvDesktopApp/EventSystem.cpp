@@ -154,6 +154,7 @@ namespace djv
         {
             auto out = std::shared_ptr<EventSystem>(new EventSystem);
             out->_init(glfwWindow, context);
+            out->_setStartupEnd();
             return out;
         }
 
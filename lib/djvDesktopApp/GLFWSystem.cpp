@@ -133,6 +133,7 @@ namespace djv
         {
             auto out = std::shared_ptr<GLFWSystem>(new GLFWSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
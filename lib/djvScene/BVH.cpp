@@ -0,0 +1,363 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2019-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvScene/BVH.h>
+
+#include <djvScene/IPrimitive.h>
+#include <djvScene/Scene.h>
+
+#include <djvAV/TriangleMesh.h>
+
+#include <djvCore/Math.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+
+#include <algorithm>
+#include <future>
+#include <set>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Scene
+    {
+        namespace
+        {
+            //! \todo Should these be configurable?
+            const size_t leafSize        = 2;
+            const size_t parallelRaysMin = 256;
+            const size_t stackSize       = 64;
+
+            struct Instance
+            {
+                std::shared_ptr<IPrimitive> primitive;
+                std::shared_ptr<AV::Geom::TriangleMesh> mesh;
+                std::shared_ptr<AV::Geom::TriangleMeshBVH> meshBVH;
+                glm::mat4x4 xform = glm::mat4x4(1.F);
+                glm::mat4x4 inverse = glm::mat4x4(1.F);
+                BBox3f bbox;
+                glm::vec3 centroid = glm::vec3(0.F, 0.F, 0.F);
+            };
+
+            struct Node
+            {
+                BBox3f bbox;
+                uint32_t offset = 0;
+                uint32_t count = 0;
+            };
+
+            void build(std::vector<Instance>& instances, std::vector<Node>& nodes, size_t begin, size_t end)
+            {
+                const size_t index = nodes.size();
+                nodes.push_back(Node());
+                Node node;
+                node.bbox = instances[begin].bbox;
+                BBox3f centroidBBox(instances[begin].centroid);
+                for (size_t i = begin + 1; i < end; ++i)
+                {
+                    node.bbox.expand(instances[i].bbox);
+                    centroidBBox.expand(instances[i].centroid);
+                }
+                const size_t count = end - begin;
+                if (count <= leafSize)
+                {
+                    node.offset = static_cast<uint32_t>(begin);
+                    node.count = static_cast<uint32_t>(count);
+                }
+                else
+                {
+                    // Split at the median of the largest axis.
+                    const glm::vec3 size = centroidBBox.getSize();
+                    const size_t axis = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+                    const size_t mid = begin + count / 2;
+                    std::nth_element(
+                        instances.begin() + begin,
+                        instances.begin() + mid,
+                        instances.begin() + end,
+                        [axis](const Instance& a, const Instance& b)
+                        {
+                            return a.centroid[axis] < b.centroid[axis];
+                        });
+                    build(instances, nodes, begin, mid);
+                    node.offset = static_cast<uint32_t>(nodes.size());
+                    build(instances, nodes, mid, end);
+                }
+                nodes[index] = node;
+            }
+
+            bool intersectBBox(const BBox3f& bbox, const glm::vec3& pos, const glm::vec3& invDir, float tMax)
+            {
+                float tEnter = 0.F;
+                float tExit = tMax;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    float t0 = (bbox.min[i] - pos[i]) * invDir[i];
+                    float t1 = (bbox.max[i] - pos[i]) * invDir[i];
+                    if (t0 > t1)
+                    {
+                        std::swap(t0, t1);
+                    }
+                    tEnter = std::max(tEnter, t0);
+                    tExit = std::min(tExit, t1);
+                }
+                return tEnter <= tExit;
+            }
+
+        } // namespace
+
+        struct BVH::Private
+        {
+            std::vector<Instance> instances;
+            std::vector<Node> nodes;
+
+            template<bool any>
+            bool intersect(const AV::Geom::Ray&, BVHHit&) const;
+        };
+
+        void BVH::_init(const std::shared_ptr<Scene>& scene)
+        {
+            DJV_PRIVATE_PTR();
+
+            // Collect the mesh instances with the same transforms that are
+            // used for rendering.
+            glm::mat4x4 m(1.F);
+            switch (scene->getSceneOrient())
+            {
+            case SceneOrient::ZUp:
+            {
+                m = glm::rotate(m, Math::deg2rad(-90.F), glm::vec3(1.F, 0.F, 0.F));
+                break;
+            }
+            default: break;
+            }
+            m *= scene->getSceneXForm();
+            for (const auto& i : scene->getPrimitives())
+            {
+                _addInstances(i, m);
+            }
+
+            // Build the mesh hierarchies in parallel.
+            std::set<std::shared_ptr<AV::Geom::TriangleMesh> > meshSet;
+            for (const auto& i : p.instances)
+            {
+                meshSet.insert(i.mesh);
+            }
+            const std::vector<std::shared_ptr<AV::Geom::TriangleMesh> > meshes(meshSet.begin(), meshSet.end());
+            const size_t threadCount = std::min(
+                std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1)),
+                std::max(meshes.size(), static_cast<size_t>(1)));
+            std::vector<std::future<void> > futures;
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                futures.push_back(std::async(
+                    std::launch::async,
+                    [&meshes, i, threadCount]
+                    {
+                        for (size_t j = i; j < meshes.size(); j += threadCount)
+                        {
+                            meshes[j]->getBVH();
+                        }
+                    }));
+            }
+            for (auto& i : futures)
+            {
+                i.get();
+            }
+
+            for (auto& i : p.instances)
+            {
+                i.meshBVH = i.mesh->getBVH();
+                i.bbox = i.meshBVH->getBBox() * i.xform;
+                i.centroid = i.bbox.getCenter();
+            }
+            p.instances.erase(
+                std::remove_if(
+                    p.instances.begin(),
+                    p.instances.end(),
+                    [](const Instance& value)
+                    {
+                        return 0 == value.meshBVH->getTriangleCount();
+                    }),
+                p.instances.end());
+            if (p.instances.size())
+            {
+                build(p.instances, p.nodes, 0, p.instances.size());
+            }
+        }
+
+        BVH::BVH() :
+            _p(new Private)
+        {}
+
+        BVH::~BVH()
+        {}
+
+        std::shared_ptr<BVH> BVH::create(const std::shared_ptr<Scene>& scene)
+        {
+            auto out = std::shared_ptr<BVH>(new BVH);
+            out->_init(scene);
+            return out;
+        }
+
+        size_t BVH::getInstanceCount() const
+        {
+            return _p->instances.size();
+        }
+
+        const BBox3f& BVH::getBBox() const
+        {
+            static const BBox3f empty(0.F, 0.F, 0.F, 0.F, 0.F, 0.F);
+            return _p->nodes.size() ? _p->nodes[0].bbox : empty;
+        }
+
+        bool BVH::intersect(const AV::Geom::Ray& ray, BVHHit& hit) const
+        {
+            return _p->intersect<false>(ray, hit);
+        }
+
+        bool BVH::intersectAny(const AV::Geom::Ray& ray) const
+        {
+            BVHHit hit;
+            return _p->intersect<true>(ray, hit);
+        }
+
+        void BVH::intersect(const std::vector<AV::Geom::Ray>& rays, std::vector<BVHHit>& hits) const
+        {
+            DJV_PRIVATE_PTR();
+            const size_t count = rays.size();
+            hits.resize(count);
+            const size_t threadCount = count >= parallelRaysMin ?
+                std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1)) :
+                1;
+            std::vector<std::future<void> > futures;
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                futures.push_back(std::async(
+                    threadCount > 1 ? std::launch::async : std::launch::deferred,
+                    [&p, &rays, &hits, i, threadCount, count]
+                    {
+                        for (size_t j = count * i / threadCount; j < count * (i + 1) / threadCount; ++j)
+                        {
+                            hits[j] = BVHHit();
+                            p.intersect<false>(rays[j], hits[j]);
+                        }
+                    }));
+            }
+            for (auto& i : futures)
+            {
+                i.get();
+            }
+        }
+
+        void BVH::_addInstances(const std::shared_ptr<IPrimitive>& primitive, const glm::mat4x4& xform)
+        {
+            DJV_PRIVATE_PTR();
+            if (bool visible = primitive->isVisible())
+            {
+                auto layer = primitive->getLayer().lock();
+                while (layer)
+                {
+                    visible &= layer->isVisible();
+                    if (visible)
+                    {
+                        layer = layer->getLayer().lock();
+                    }
+                    else
+                    {
+                        layer.reset();
+                    }
+                }
+                if (visible)
+                {
+                    const glm::mat4x4 m = primitive->isXFormIdentity() ? xform : (xform * primitive->getXForm());
+                    const glm::mat4x4 inverse = glm::inverse(m);
+                    for (const auto& i : primitive->getMeshes())
+                    {
+                        Instance instance;
+                        instance.primitive = primitive;
+                        instance.mesh = i;
+                        instance.xform = m;
+                        instance.inverse = inverse;
+                        p.instances.push_back(instance);
+                    }
+                    for (const auto& i : primitive->getPrimitives())
+                    {
+                        _addInstances(i, m);
+                    }
+                }
+            }
+        }
+
+        template<bool any>
+        bool BVH::Private::intersect(const AV::Geom::Ray& ray, BVHHit& hit) const
+        {
+            if (nodes.empty())
+            {
+                return false;
+            }
+            const glm::vec3 invDir = AV::Geom::getInvDir(ray.dir);
+            float tBest = ray.tMax;
+            const Instance* best = nullptr;
+            AV::Geom::RayHit bestHit;
+            uint32_t stack[stackSize];
+            size_t stackCount = 0;
+            stack[stackCount++] = 0;
+            while (stackCount > 0)
+            {
+                const Node& node = nodes[stack[--stackCount]];
+                if (!intersectBBox(node.bbox, ray.pos, invDir, tBest))
+                {
+                    continue;
+                }
+                if (node.count > 0)
+                {
+                    for (size_t i = node.offset; i < node.offset + node.count; ++i)
+                    {
+                        // Transforming the ray into object space keeps the
+                        // distance along it the same.
+                        const auto& instance = instances[i];
+                        const AV::Geom::Ray objectRay(
+                            glm::vec3(instance.inverse * glm::vec4(ray.pos, 1.F)),
+                            glm::vec3(instance.inverse * glm::vec4(ray.dir, 0.F)),
+                            tBest);
+                        if (any)
+                        {
+                            if (instance.meshBVH->intersectAny(objectRay))
+                            {
+                                return true;
+                            }
+                        }
+                        else
+                        {
+                            AV::Geom::RayHit rayHit;
+                            if (instance.meshBVH->intersect(objectRay, rayHit) && rayHit.t < tBest)
+                            {
+                                tBest = rayHit.t;
+                                best = &instance;
+                                bestHit = rayHit;
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    stack[stackCount++] = node.offset;
+                    stack[stackCount++] = static_cast<uint32_t>(&node - nodes.data() + 1);
+                }
+            }
+            if (best)
+            {
+                hit.primitive = best->primitive;
+                hit.mesh = best->mesh;
+                hit.hit = bestHit;
+                hit.hit.pos = ray.pos + ray.dir * bestHit.t;
+            }
+            return best != nullptr;
+        }
+
+    } // namespace Scene
+} // namespace djv
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2019-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvAV/TriangleMeshBVH.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Geom
+        {
+            class TriangleMesh;
+
+        } // namespace Geom
+    } // namespace AV
+
+    namespace Scene
+    {
+        class IPrimitive;
+        class Scene;
+
+        //! This struct provides a scene ray hit.
+        struct BVHHit
+        {
+            std::shared_ptr<IPrimitive> primitive;
+            std::shared_ptr<AV::Geom::TriangleMesh> mesh;
+
+            //! The hit position is in world space, and the triangle and
+            //! barycentric coordinates refer to the mesh.
+            AV::Geom::RayHit hit;
+        };
+
+        //! This class provides a top-level bounding volume hierarchy for
+        //! accelerating ray intersections with a scene.
+        //!
+        //! Each visible mesh is added as an instance with its world transform,
+        //! and the meshes use their own hierarchies, which are built in
+        //! parallel when the scene hierarchy is created. The scene hierarchy
+        //! must be re-created when the scene changes.
+        class BVH
+        {
+            DJV_NON_COPYABLE(BVH);
+            void _init(const std::shared_ptr<Scene>&);
+            BVH();
+
+        public:
+            ~BVH();
+
+            static std::shared_ptr<BVH> create(const std::shared_ptr<Scene>&);
+
+            size_t getInstanceCount() const;
+            const Core::BBox3f& getBBox() const;
+
+            //! Find the nearest hit.
+            bool intersect(const AV::Geom::Ray&, BVHHit&) const;
+
+            //! Find whether the ray hits anything, stopping at the first hit.
+            bool intersectAny(const AV::Geom::Ray&) const;
+
+            //! Find the nearest hits for a batch of rays in parallel.
+            void intersect(const std::vector<AV::Geom::Ray>&, std::vector<BVHHit>&) const;
+
+        private:
+            void _addInstances(const std::shared_ptr<IPrimitive>&, const glm::mat4x4&);
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace Scene
+} // namespace djv
@@ -0,0 +1,1085 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2019-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvScene/Cache.h>
+
+#include <djvScene/InstancePrimitive.h>
+#include <djvScene/Layer.h>
+#include <djvScene/Light.h>
+#include <djvScene/Material.h>
+#include <djvScene/MeshPrimitive.h>
+#include <djvScene/NullPrimitive.h>
+#include <djvScene/Group.h>
+#include <djvScene/PointListPrimitive.h>
+#include <djvScene/PolyLinePrimitive.h>
+#include <djvScene/Scene.h>
+
+#include <djvAV/PointList.h>
+#include <djvAV/TriangleMesh.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/LogSystem.h>
+#include <djvCore/StringFormat.h>
+#include <djvCore/TextSystem.h>
+
+#if defined(DJV_PLATFORM_WINDOWS)
+#include <sys/utime.h>
+#else // DJV_PLATFORM_WINDOWS
+#include <utime.h>
+#endif // DJV_PLATFORM_WINDOWS
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <sstream>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace Scene
+    {
+        namespace IO
+        {
+            namespace Cache
+            {
+                namespace
+                {
+                    const char     magic[]       = "DJVSCENE";
+                    const uint32_t version       = 1;
+                    const uint32_t endianMarker  = 0x01020304;
+                    const size_t   alignment     = 8;
+                    const size_t   headerSize    = 8 + 4 + 4 + 8 + 8;
+
+                    static_assert(sizeof(AV::Geom::TriangleMesh::Triangle) == 9 * sizeof(uint32_t), "unexpected triangle layout");
+                    static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "unexpected vector layout");
+                    static_assert(sizeof(glm::vec2) == 2 * sizeof(float), "unexpected vector layout");
+
+                    enum class PrimitiveType : uint32_t
+                    {
+                        Null,
+                        Group,
+                        Mesh,
+                        PointList,
+                        PolyLine,
+                        Instance,
+                        HemisphereLight,
+                        DirectionalLight,
+                        PointLight,
+                        SpotLight
+                    };
+
+                    PrimitiveType getPrimitiveType(const std::shared_ptr<IPrimitive>& value)
+                    {
+                        static const std::map<std::string, PrimitiveType> data =
+                        {
+                            { "NullPrimitive",      PrimitiveType::Null },
+                            { "Group",              PrimitiveType::Group },
+                            { "MeshPrimitive",      PrimitiveType::Mesh },
+                            { "PointListPrimitive", PrimitiveType::PointList },
+                            { "PolyLinePrimitive",  PrimitiveType::PolyLine },
+                            { "InstancePrimitive",  PrimitiveType::Instance },
+                            { "HemisphereLight",    PrimitiveType::HemisphereLight },
+                            { "DirectionalLight",   PrimitiveType::DirectionalLight },
+                            { "PointLight",         PrimitiveType::PointLight },
+                            { "SpotLight",          PrimitiveType::SpotLight }
+                        };
+                        const auto i = data.find(value->getClassName());
+                        if (i == data.end())
+                        {
+                            throw std::runtime_error(String::Format("{0}: {1}").
+                                arg(value->getClassName()).
+                                arg(DJV_TEXT("error_scene_cache_unsupported")));
+                        }
+                        return i->second;
+                    }
+
+                    //! This class provides a buffer for writing cache data.
+                    class Writer
+                    {
+                    public:
+                        void write(const void* value, size_t size)
+                        {
+                            const uint8_t* p = reinterpret_cast<const uint8_t*>(value);
+                            data.insert(data.end(), p, p + size);
+                        }
+
+                        template<typename T>
+                        void writeT(const T& value)
+                        {
+                            write(&value, sizeof(T));
+                        }
+
+                        template<typename T>
+                        void writeVector(const std::vector<T>& value)
+                        {
+                            align();
+                            write(value.data(), value.size() * sizeof(T));
+                        }
+
+                        void writeString(const std::string& value)
+                        {
+                            writeT(static_cast<uint32_t>(value.size()));
+                            write(value.data(), value.size());
+                            align();
+                        }
+
+                        void writeColor(const AV::Image::Color& value)
+                        {
+                            const AV::Image::Type type = value.getType();
+                            writeT(static_cast<uint32_t>(type));
+                            uint8_t buf[16] = {};
+                            memcpy(buf, value.getData(), std::min(AV::Image::getByteCount(type), sizeof(buf)));
+                            write(buf, sizeof(buf));
+                        }
+
+                        void writeBBox(const BBox3f& value)
+                        {
+                            writeT(value.min);
+                            writeT(value.max);
+                        }
+
+                        void writeIndices(const std::vector<int32_t>& value)
+                        {
+                            writeT(static_cast<uint32_t>(value.size()));
+                            write(value.data(), value.size() * sizeof(int32_t));
+                        }
+
+                        void align()
+                        {
+                            data.resize((data.size() + alignment - 1) / alignment * alignment, 0);
+                        }
+
+                        std::vector<uint8_t> data;
+                    };
+
+                    //! This class provides reading cache data from memory with
+                    //! bounds checking.
+                    class Reader
+                    {
+                    public:
+                        Reader(const uint8_t* start, const uint8_t* end) :
+                            _start(start),
+                            _p(start),
+                            _end(end)
+                        {}
+
+                        const uint8_t* get(size_t size)
+                        {
+                            if (size > static_cast<size_t>(_end - _p))
+                            {
+                                throw std::runtime_error(DJV_TEXT("error_scene_cache_truncated"));
+                            }
+                            const uint8_t* out = _p;
+                            _p += size;
+                            return out;
+                        }
+
+                        template<typename T>
+                        T readT()
+                        {
+                            T out;
+                            memcpy(&out, get(sizeof(T)), sizeof(T));
+                            return out;
+                        }
+
+                        template<typename T>
+                        void readVector(std::vector<T>& value, size_t count)
+                        {
+                            align();
+                            const size_t size = count * sizeof(T);
+                            if (count > static_cast<size_t>(_end - _p) / sizeof(T))
+                            {
+                                throw std::runtime_error(DJV_TEXT("error_scene_cache_truncated"));
+                            }
+                            value.resize(count);
+                            memcpy(value.data(), get(size), size);
+                        }
+
+                        std::string readString()
+                        {
+                            const uint32_t size = readT<uint32_t>();
+                            const char* p = reinterpret_cast<const char*>(get(size));
+                            std::string out(p, p + size);
+                            align();
+                            return out;
+                        }
+
+                        AV::Image::Color readColor()
+                        {
+                            const auto type = static_cast<AV::Image::Type>(readT<uint32_t>());
+                            const uint8_t* p = get(16);
+                            if (type >= AV::Image::Type::Count)
+                            {
+                                throw std::runtime_error(DJV_TEXT("error_scene_cache_corrupt"));
+                            }
+                            AV::Image::Color out(type);
+                            memcpy(out.getData(), p, std::min(AV::Image::getByteCount(type), static_cast<size_t>(16)));
+                            return out;
+                        }
+
+                        BBox3f readBBox()
+                        {
+                            BBox3f out;
+                            out.min = readT<glm::vec3>();
+                            out.max = readT<glm::vec3>();
+                            return out;
+                        }
+
+                        std::vector<int32_t> readIndices(size_t max)
+                        {
+                            const uint32_t size = readT<uint32_t>();
+                            std::vector<int32_t> out(size);
+                            for (uint32_t i = 0; i < size; ++i)
+                            {
+                                out[i] = readT<int32_t>();
+                                if (out[i] < 0 || static_cast<size_t>(out[i]) >= max)
+                                {
+                                    throw std::runtime_error(DJV_TEXT("error_scene_cache_corrupt"));
+                                }
+                            }
+                            return out;
+                        }
+
+                        void align()
+                        {
+                            const size_t pos = _p - _start;
+                            get((pos + alignment - 1) / alignment * alignment - pos);
+                        }
+
+                    private:
+                        const uint8_t* _start = nullptr;
+                        const uint8_t* _p = nullptr;
+                        const uint8_t* _end = nullptr;
+                    };
+
+                    //! This struct provides the tables used to convert the
+                    //! scene graph pointers into indices.
+                    struct Tables
+                    {
+                        std::vector<std::shared_ptr<DefaultMaterial> > materials;
+                        std::vector<std::shared_ptr<AV::Geom::TriangleMesh> > meshes;
+                        std::vector<std::shared_ptr<AV::Geom::PointList> > pointLists;
+                        std::vector<std::shared_ptr<IPrimitive> > primitives;
+                        std::vector<std::shared_ptr<Layer> > layers;
+                        std::map<const void*, int32_t> indices;
+
+                        template<typename T>
+                        int32_t add(const std::shared_ptr<T>& value, std::vector<std::shared_ptr<T> >& list)
+                        {
+                            if (!value)
+                            {
+                                return -1;
+                            }
+                            const auto i = indices.find(value.get());
+                            if (i != indices.end())
+                            {
+                                return i->second;
+                            }
+                            const int32_t out = static_cast<int32_t>(list.size());
+                            indices[value.get()] = out;
+                            list.push_back(value);
+                            return out;
+                        }
+
+                        int32_t addMaterial(const std::shared_ptr<IMaterial>& value)
+                        {
+                            if (!value)
+                            {
+                                return -1;
+                            }
+                            auto material = std::dynamic_pointer_cast<DefaultMaterial>(value);
+                            if (!material)
+                            {
+                                throw std::runtime_error(DJV_TEXT("error_scene_cache_unsupported"));
+                            }
+                            return add(material, materials);
+                        }
+
+                        void addPrimitive(const std::shared_ptr<IPrimitive>& value)
+                        {
+                            if (indices.find(value.get()) == indices.end())
+                            {
+                                add(value, primitives);
+                                addMaterial(value->getMaterial());
+                                for (const auto& i : value->getMeshes())
+                                {
+                                    add(i, meshes);
+                                }
+                                add(value->getPointList(), pointLists);
+                                for (const auto& i : value->getPolyLines())
+                                {
+                                    add(i, pointLists);
+                                }
+                                for (const auto& i : value->getChildren())
+                                {
+                                    addPrimitive(i);
+                                }
+                                if (auto instance = std::dynamic_pointer_cast<InstancePrimitive>(value))
+                                {
+                                    for (const auto& i : instance->getInstances())
+                                    {
+                                        addPrimitive(i);
+                                    }
+                                }
+                            }
+                        }
+
+                        void addLayer(const std::shared_ptr<Layer>& value)
+                        {
+                            add(value, layers);
+                            addMaterial(value->getMaterial());
+                            for (const auto& i : value->getItems())
+                            {
+                                if (auto layer = std::dynamic_pointer_cast<Layer>(i))
+                                {
+                                    addLayer(layer);
+                                }
+                            }
+                        }
+
+                        int32_t getIndex(const void* value) const
+                        {
+                            const auto i = indices.find(value);
+                            if (i == indices.end())
+                            {
+                                throw std::runtime_error(DJV_TEXT("error_scene_cache_unsupported"));
+                            }
+                            return i->second;
+                        }
+
+                        std::vector<int32_t> getIndices(const std::vector<std::shared_ptr<IPrimitive> >& value) const
+                        {
+                            std::vector<int32_t> out;
+                            for (const auto& i : value)
+                            {
+                                out.push_back(getIndex(i.get()));
+                            }
+                            return out;
+                        }
+                    };
+
+                    void writeHeader(Writer& writer, const FileSystem::FileInfo& sourceFileInfo)
+                    {
+                        writer.write(magic, 8);
+                        writer.writeT(version);
+                        writer.writeT(endianMarker);
+                        writer.writeT(static_cast<uint64_t>(sourceFileInfo.getSize()));
+                        writer.writeT(static_cast<int64_t>(sourceFileInfo.getTime()));
+                    }
+
+                    bool readHeader(Reader& reader, const FileSystem::FileInfo& sourceFileInfo)
+                    {
+                        const uint8_t* p = reader.get(8);
+                        const uint32_t fileVersion = reader.readT<uint32_t>();
+                        const uint32_t fileEndian = reader.readT<uint32_t>();
+                        const uint64_t sourceSize = reader.readT<uint64_t>();
+                        const int64_t sourceTime = reader.readT<int64_t>();
+                        return
+                            0 == memcmp(p, magic, 8) &&
+                            version == fileVersion &&
+                            endianMarker == fileEndian &&
+                            static_cast<uint64_t>(sourceFileInfo.getSize()) == sourceSize &&
+                            static_cast<int64_t>(sourceFileInfo.getTime()) == sourceTime;
+                    }
+
+                    void writeMesh(Writer& writer, const AV::Geom::TriangleMesh& mesh)
+                    {
+                        writer.writeT(static_cast<uint64_t>(mesh.v.size()));
+                        writer.writeT(static_cast<uint64_t>(mesh.c.size()));
+                        writer.writeT(static_cast<uint64_t>(mesh.t.size()));
+                        writer.writeT(static_cast<uint64_t>(mesh.n.size()));
+                        writer.writeT(static_cast<uint64_t>(mesh.triangles.size()));
+                        writer.writeBBox(mesh.bbox);
+                        writer.writeVector(mesh.v);
+                        writer.writeVector(mesh.c);
+                        writer.writeVector(mesh.t);
+                        writer.writeVector(mesh.n);
+                        writer.writeVector(mesh.triangles);
+                    }
+
+                    std::shared_ptr<AV::Geom::TriangleMesh> readMesh(Reader& reader)
+                    {
+                        auto out = std::shared_ptr<AV::Geom::TriangleMesh>(new AV::Geom::TriangleMesh);
+                        const size_t vSize = static_cast<size_t>(reader.readT<uint64_t>());
+                        const size_t cSize = static_cast<size_t>(reader.readT<uint64_t>());
+                        const size_t tSize = static_cast<size_t>(reader.readT<uint64_t>());
+                        const size_t nSize = static_cast<size_t>(reader.readT<uint64_t>());
+                        const size_t trianglesSize = static_cast<size_t>(reader.readT<uint64_t>());
+                        out->bbox = reader.readBBox();
+                        reader.readVector(out->v, vSize);
+                        reader.readVector(out->c, cSize);
+                        reader.readVector(out->t, tSize);
+                        reader.readVector(out->n, nSize);
+                        reader.readVector(out->triangles, trianglesSize);
+
+                        // The indices are one-based, zero means the component
+                        // is not used.
+                        for (const auto& i : out->triangles)
+                        {
+                            for (const auto& j : { i.v0, i.v1, i.v2 })
+                            {
+                                if (0 == j.v || j.v > vSize || j.t > tSize || j.n > nSize)
+                                {
+                                    throw std::runtime_error(DJV_TEXT("error_scene_cache_corrupt"));
+                                }
+                            }
+                        }
+                        return out;
+                    }
+
+                    void writePointList(Writer& writer, const AV::Geom::PointList& pointList)
+                    {
+                        writer.writeT(static_cast<uint64_t>(pointList.v.size()));
+                        writer.writeT(static_cast<uint64_t>(pointList.c.size()));
+                        writer.writeBBox(pointList.bbox);
+                        writer.writeVector(pointList.v);
+                        writer.writeVector(pointList.c);
+                    }
+
+                    std::shared_ptr<AV::Geom::PointList> readPointList(Reader& reader)
+                    {
+                        auto out = std::shared_ptr<AV::Geom::PointList>(new AV::Geom::PointList);
+                        const size_t vSize = static_cast<size_t>(reader.readT<uint64_t>());
+                        const size_t cSize = static_cast<size_t>(reader.readT<uint64_t>());
+                        out->bbox = reader.readBBox();
+                        reader.readVector(out->v, vSize);
+                        reader.readVector(out->c, cSize);
+                        return out;
+                    }
+
+                    void writeMaterial(Writer& writer, const DefaultMaterial& material)
+                    {
+                        writer.writeColor(material.getAmbient());
+                        writer.writeColor(material.getDiffuse());
+                        writer.writeColor(material.getEmission());
+                        writer.writeColor(material.getSpecular());
+                        writer.writeT(material.getShine());
+                        writer.writeT(material.getTransparency());
+                        writer.writeT(material.getReflectivity());
+                        writer.writeT(static_cast<uint32_t>(material.hasDisableLighting()));
+                    }
+
+                    std::shared_ptr<DefaultMaterial> readMaterial(Reader& reader)
+                    {
+                        auto out = DefaultMaterial::create();
+                        out->setAmbient(reader.readColor());
+                        out->setDiffuse(reader.readColor());
+                        out->setEmission(reader.readColor());
+                        out->setSpecular(reader.readColor());
+                        out->setShine(reader.readT<float>());
+                        out->setTransparency(reader.readT<float>());
+                        out->setReflectivity(reader.readT<float>());
+                        out->setDisableLighting(reader.readT<uint32_t>() != 0);
+                        return out;
+                    }
+
+                    void writePrimitive(Writer& writer, const std::shared_ptr<IPrimitive>& primitive, const Tables& tables)
+                    {
+                        const PrimitiveType type = getPrimitiveType(primitive);
+                        writer.writeT(static_cast<uint32_t>(type));
+                        writer.writeString(primitive->getName());
+                        writer.writeT(static_cast<uint32_t>(primitive->isVisible()));
+                        writer.writeT(primitive->getXForm());
+                        writer.writeBBox(primitive->getBBox());
+                        writer.writeT(static_cast<uint32_t>(primitive->getColorAssignment()));
+                        writer.writeColor(primitive->getColor());
+                        writer.writeT(static_cast<uint32_t>(primitive->getMaterialAssignment()));
+                        const auto& material = primitive->getMaterial();
+                        writer.writeT(material ? tables.getIndex(material.get()) : -1);
+                        writer.writeIndices(tables.getIndices(primitive->getChildren()));
+                        switch (type)
+                        {
+                        case PrimitiveType::Mesh:
+                        {
+                            std::vector<int32_t> indices;
+                            for (const auto& i : primitive->getMeshes())
+                            {
+                                indices.push_back(tables.getIndex(i.get()));
+                            }
+                            writer.writeIndices(indices);
+                            break;
+                        }
+                        case PrimitiveType::PointList:
+                        {
+                            const auto& pointList = primitive->getPointList();
+                            writer.writeT(pointList ? tables.getIndex(pointList.get()) : -1);
+                            break;
+                        }
+                        case PrimitiveType::PolyLine:
+                        {
+                            std::vector<int32_t> indices;
+                            for (const auto& i : primitive->getPolyLines())
+                            {
+                                indices.push_back(tables.getIndex(i.get()));
+                            }
+                            writer.writeIndices(indices);
+                            break;
+                        }
+                        case PrimitiveType::Instance:
+                            writer.writeIndices(tables.getIndices(std::dynamic_pointer_cast<InstancePrimitive>(primitive)->getInstances()));
+                            break;
+                        case PrimitiveType::HemisphereLight:
+                        case PrimitiveType::DirectionalLight:
+                        case PrimitiveType::PointLight:
+                        case PrimitiveType::SpotLight:
+                        {
+                            auto light = std::dynamic_pointer_cast<ILight>(primitive);
+                            writer.writeT(static_cast<uint32_t>(light->isEnabled()));
+                            writer.writeT(light->getIntensity());
+                            if (auto hemisphereLight = std::dynamic_pointer_cast<HemisphereLight>(primitive))
+                            {
+                                writer.writeT(hemisphereLight->getUp());
+                                writer.writeColor(hemisphereLight->getTopColor());
+                                writer.writeColor(hemisphereLight->getBottomColor());
+                            }
+                            else if (auto directionalLight = std::dynamic_pointer_cast<DirectionalLight>(primitive))
+                            {
+                                writer.writeT(directionalLight->getDirection());
+                            }
+                            else if (auto spotLight = std::dynamic_pointer_cast<SpotLight>(primitive))
+                            {
+                                writer.writeT(spotLight->getConeAngle());
+                                writer.writeT(spotLight->getDirection());
+                            }
+                            break;
+                        }
+                        default: break;
+                        }
+                    }
+
+                    //! This struct provides the primitive references that are
+                    //! resolved after all of the primitives have been read.
+                    struct PrimitiveLinks
+                    {
+                        std::vector<int32_t> children;
+                        std::vector<int32_t> instances;
+                    };
+
+                    std::shared_ptr<IPrimitive> readPrimitive(
+                        Reader&                                                      reader,
+                        const std::vector<std::shared_ptr<DefaultMaterial> >&        materials,
+                        const std::vector<std::shared_ptr<AV::Geom::TriangleMesh> >& meshes,
+                        const std::vector<std::shared_ptr<AV::Geom::PointList> >&    pointLists,
+                        size_t                                                       primitivesSize,
+                        PrimitiveLinks&                                              links)
+                    {
+                        const auto type = static_cast<PrimitiveType>(reader.readT<uint32_t>());
+                        const std::string name = reader.readString();
+                        const bool visible = reader.readT<uint32_t>() != 0;
+                        const auto xform = reader.readT<glm::mat4x4>();
+                        const BBox3f bbox = reader.readBBox();
+                        const auto colorAssignment = static_cast<ColorAssignment>(reader.readT<uint32_t>());
+                        const AV::Image::Color color = reader.readColor();
+                        const auto materialAssignment = static_cast<MaterialAssignment>(reader.readT<uint32_t>());
+                        const int32_t material = reader.readT<int32_t>();
+                        links.children = reader.readIndices(primitivesSize);
+
+                        std::shared_ptr<IPrimitive> out;
+                        switch (type)
+                        {
+                        case PrimitiveType::Null:
+                            out = NullPrimitive::create();
+                            break;
+                        case PrimitiveType::Group:
+                            out = Group::create();
+                            break;
+                        case PrimitiveType::Mesh:
+                        {
+                            auto meshPrimitive = MeshPrimitive::create();
+                            for (const auto i : reader.readIndices(meshes.size()))
+                            {
+                                meshPrimitive->addMesh(meshes[i]);
+                            }
+                            out = meshPrimitive;
+                            break;
+                        }
+                        case PrimitiveType::PointList:
+                        {
+                            auto pointListPrimitive = PointListPrimitive::create();
+                            const int32_t pointList = reader.readT<int32_t>();
+                            if (pointList >= static_cast<int32_t>(pointLists.size()))
+                            {
+                                throw std::runtime_error(DJV_TEXT("error_scene_cache_corrupt"));
+                            }
+                            if (pointList >= 0)
+                            {
+                                pointListPrimitive->setPointList(pointLists[pointList]);
+                            }
+                            out = pointListPrimitive;
+                            break;
+                        }
+                        case PrimitiveType::PolyLine:
+                        {
+                            auto polyLinePrimitive = PolyLinePrimitive::create();
+                            for (const auto i : reader.readIndices(pointLists.size()))
+                            {
+                                polyLinePrimitive->addPointList(pointLists[i]);
+                            }
+                            out = polyLinePrimitive;
+                            break;
+                        }
+                        case PrimitiveType::Instance:
+                            out = InstancePrimitive::create();
+                            links.instances = reader.readIndices(primitivesSize);
+                            break;
+                        case PrimitiveType::HemisphereLight:
+                        case PrimitiveType::DirectionalLight:
+                        case PrimitiveType::PointLight:
+                        case PrimitiveType::SpotLight:
+                        {
+                            const bool enabled = reader.readT<uint32_t>() != 0;
+                            const float intensity = reader.readT<float>();
+                            std::shared_ptr<ILight> light;
+                            switch (type)
+                            {
+                            case PrimitiveType::HemisphereLight:
+                            {
+                                auto hemisphereLight = HemisphereLight::create();
+                                hemisphereLight->setUp(reader.readT<glm::vec3>());
+                                hemisphereLight->setTopColor(reader.readColor());
+                                hemisphereLight->setBottomColor(reader.readColor());
+                                light = hemisphereLight;
+                                break;
+                            }
+                            case PrimitiveType::DirectionalLight:
+                            {
+                                auto directionalLight = DirectionalLight::create();
+                                directionalLight->setDirection(reader.readT<glm::vec3>());
+                                light = directionalLight;
+                                break;
+                            }
+                            case PrimitiveType::SpotLight:
+                            {
+                                auto spotLight = SpotLight::create();
+                                spotLight->setConeAngle(reader.readT<float>());
+                                spotLight->setDirection(reader.readT<glm::vec3>());
+                                light = spotLight;
+                                break;
+                            }
+                            default:
+                                light = PointLight::create();
+                                break;
+                            }
+                            light->setEnabled(enabled);
+                            light->setIntensity(intensity);
+                            out = light;
+                            break;
+                        }
+                        default:
+                            throw std::runtime_error(DJV_TEXT("error_scene_cache_corrupt"));
+                        }
+
+                        out->setName(name);
+                        out->setVisible(visible);
+                        out->setXForm(xform);
+                        out->setBBox(bbox);
+                        out->setColorAssignment(colorAssignment);
+                        out->setColor(color);
+                        out->setMaterialAssignment(materialAssignment);
+                        if (material >= static_cast<int32_t>(materials.size()))
+                        {
+                            throw std::runtime_error(DJV_TEXT("error_scene_cache_corrupt"));
+                        }
+                        if (material >= 0)
+                        {
+                            out->setMaterial(materials[material]);
+                        }
+                        return out;
+                    }
+
+                } // namespace
+
+                std::string getFileName(const FileSystem::Path& cachePath, const FileSystem::FileInfo& fileInfo)
+                {
+                    const std::string fileName = FileSystem::Path::getAbsolute(fileInfo.getPath()).get();
+                    std::stringstream ss;
+                    ss << std::hex << std::hash<std::string>()(fileName) << ".djvscene";
+                    return FileSystem::Path(cachePath, ss.str()).get();
+                }
+
+                bool isValid(const std::string& cacheFileName, const FileSystem::FileInfo& sourceFileInfo)
+                {
+                    bool out = false;
+                    if (FileSystem::FileInfo(cacheFileName).doesExist())
+                    {
+                        try
+                        {
+                            auto io = FileSystem::FileIO::create();
+                            io->open(cacheFileName, FileSystem::FileIO::Mode::Read);
+                            if (io->getSize() >= headerSize)
+                            {
+                                std::vector<uint8_t> data(headerSize);
+                                io->read(data.data(), headerSize);
+                                Reader reader(data.data(), data.data() + headerSize);
+                                out = readHeader(reader, sourceFileInfo);
+                            }
+                        }
+                        catch (const std::exception&)
+                        {}
+                    }
+                    return out;
+                }
+
+                void write(
+                    const std::string&            cacheFileName,
+                    const FileSystem::FileInfo&   sourceFileInfo,
+                    const std::shared_ptr<Scene>& scene)
+                {
+                    // Convert the scene graph pointers into indices.
+                    Tables tables;
+                    for (const auto& i : scene->getPrimitives())
+                    {
+                        tables.addPrimitive(i);
+                    }
+                    for (const auto& i : scene->getDefinitions())
+                    {
+                        tables.addPrimitive(i);
+                    }
+                    for (const auto& i : scene->getLayers())
+                    {
+                        tables.addLayer(i);
+                    }
+
+                    Writer writer;
+                    writeHeader(writer, sourceFileInfo);
+
+                    writer.writeT(static_cast<uint32_t>(tables.materials.size()));
+                    for (const auto& i : tables.materials)
+                    {
+                        writeMaterial(writer, *i);
+                    }
+
+                    writer.writeT(static_cast<uint32_t>(tables.meshes.size()));
+                    for (const auto& i : tables.meshes)
+                    {
+                        writeMesh(writer, *i);
+                    }
+                    writer.align();
+
+                    writer.writeT(static_cast<uint32_t>(tables.pointLists.size()));
+                    for (const auto& i : tables.pointLists)
+                    {
+                        writePointList(writer, *i);
+                    }
+                    writer.align();
+
+                    writer.writeT(static_cast<uint32_t>(tables.primitives.size()));
+                    for (const auto& i : tables.primitives)
+                    {
+                        writePrimitive(writer, i, tables);
+                    }
+
+                    writer.writeT(static_cast<uint32_t>(tables.layers.size()));
+                    for (const auto& i : tables.layers)
+                    {
+                        writer.writeString(i->getName());
+                        writer.writeT(static_cast<uint32_t>(i->isVisible()));
+                        writer.writeColor(i->getColor());
+                        const auto& material = i->getMaterial();
+                        writer.writeT(material ? tables.getIndex(material.get()) : -1);
+                        const auto& items = i->getItems();
+                        writer.writeT(static_cast<uint32_t>(items.size()));
+                        for (const auto& j : items)
+                        {
+                            // Layers are stored as negative indices.
+                            const int32_t index = tables.getIndex(j.get());
+                            writer.writeT(std::dynamic_pointer_cast<Layer>(j) ? -(index + 1) : index);
+                        }
+                    }
+
+                    writer.writeT(static_cast<uint32_t>(scene->getSceneOrient()));
+                    writer.writeT(scene->getSceneXForm());
+                    writer.writeIndices(tables.getIndices(scene->getPrimitives()));
+                    writer.writeIndices(tables.getIndices(scene->getDefinitions()));
+                    std::vector<int32_t> layers;
+                    for (const auto& i : scene->getLayers())
+                    {
+                        layers.push_back(tables.getIndex(i.get()));
+                    }
+                    writer.writeIndices(layers);
+
+                    // Replace the file atomically so that readers never see
+                    // a partial cache file.
+                    FileSystem::FileIO::writeAtomic(cacheFileName, writer.data.data(), writer.data.size());
+                }
+
+                std::shared_ptr<Scene> read(const std::string& cacheFileName, const FileSystem::FileInfo& sourceFileInfo)
+                {
+                    if (!FileSystem::FileInfo(cacheFileName).doesExist())
+                    {
+                        return nullptr;
+                    }
+
+                    // Memory map the file, falling back to reading it into
+                    // memory when mapping is not available.
+                    auto io = FileSystem::FileIO::create();
+                    io->setReadType(FileSystem::ReadType::MemoryMap);
+                    io->open(cacheFileName, FileSystem::FileIO::Mode::Read);
+                    const uint8_t* start = io->mmapP();
+                    const uint8_t* end = io->mmapEnd();
+                    std::vector<uint8_t> data;
+                    if (!start)
+                    {
+                        data.resize(io->getSize());
+                        io->read(data.data(), data.size());
+                        start = data.data();
+                        end = start + data.size();
+                    }
+                    Reader reader(start, end);
+                    if (!readHeader(reader, sourceFileInfo))
+                    {
+                        return nullptr;
+                    }
+
+                    std::vector<std::shared_ptr<DefaultMaterial> > materials(reader.readT<uint32_t>());
+                    for (auto& i : materials)
+                    {
+                        i = readMaterial(reader);
+                    }
+
+                    std::vector<std::shared_ptr<AV::Geom::TriangleMesh> > meshes(reader.readT<uint32_t>());
+                    for (auto& i : meshes)
+                    {
+                        i = readMesh(reader);
+                    }
+                    reader.align();
+
+                    std::vector<std::shared_ptr<AV::Geom::PointList> > pointLists(reader.readT<uint32_t>());
+                    for (auto& i : pointLists)
+                    {
+                        i = readPointList(reader);
+                    }
+                    reader.align();
+
+                    const size_t primitivesSize = reader.readT<uint32_t>();
+                    std::vector<std::shared_ptr<IPrimitive> > primitives(primitivesSize);
+                    std::vector<PrimitiveLinks> links(primitivesSize);
+                    for (size_t i = 0; i < primitivesSize; ++i)
+                    {
+                        primitives[i] = readPrimitive(reader, materials, meshes, pointLists, primitivesSize, links[i]);
+                    }
+                    for (size_t i = 0; i < primitivesSize; ++i)
+                    {
+                        for (const auto j : links[i].children)
+                        {
+                            primitives[i]->addChild(primitives[j]);
+                        }
+                        if (auto instance = std::dynamic_pointer_cast<InstancePrimitive>(primitives[i]))
+                        {
+                            for (const auto j : links[i].instances)
+                            {
+                                instance->addInstance(primitives[j]);
+                            }
+                        }
+                    }
+
+                    const size_t layersSize = reader.readT<uint32_t>();
+                    std::vector<std::shared_ptr<Layer> > layers(layersSize);
+                    std::vector<std::vector<int32_t> > layerItems(layersSize);
+                    for (size_t i = 0; i < layersSize; ++i)
+                    {
+                        auto layer = Layer::create();
+                        layer->setName(reader.readString());
+                        layer->setVisible(reader.readT<uint32_t>() != 0);
+                        layer->setColor(reader.readColor());
+                        const int32_t material = reader.readT<int32_t>();
+                        if (material >= static_cast<int32_t>(materials.size()))
+                        {
+                            throw std::runtime_error(DJV_TEXT("error_scene_cache_corrupt"));
+                        }
+                        if (material >= 0)
+                        {
+                            layer->setMaterial(materials[material]);
+                        }
+                        const uint32_t itemsSize = reader.readT<uint32_t>();
+                        for (uint32_t j = 0; j < itemsSize; ++j)
+                        {
+                            layerItems[i].push_back(reader.readT<int32_t>());
+                        }
+                        layers[i] = layer;
+                    }
+                    for (size_t i = 0; i < layersSize; ++i)
+                    {
+                        for (const auto j : layerItems[i])
+                        {
+                            if (j >= 0 && static_cast<size_t>(j) < primitivesSize)
+                            {
+                                layers[i]->addItem(primitives[j]);
+                            }
+                            else if (j < 0 && static_cast<size_t>(-(j + 1)) < layersSize)
+                            {
+                                layers[i]->addItem(layers[-(j + 1)]);
+                            }
+                            else
+                            {
+                                throw std::runtime_error(DJV_TEXT("error_scene_cache_corrupt"));
+                            }
+                        }
+                    }
+
+                    auto out = Scene::create();
+                    out->setSceneOrient(static_cast<SceneOrient>(reader.readT<uint32_t>()));
+                    out->setSceneXForm(reader.readT<glm::mat4x4>());
+                    for (const auto i : reader.readIndices(primitivesSize))
+                    {
+                        out->addPrimitive(primitives[i]);
+                    }
+                    for (const auto i : reader.readIndices(primitivesSize))
+                    {
+                        out->addDefinition(primitives[i]);
+                    }
+                    for (const auto i : reader.readIndices(layersSize))
+                    {
+                        out->addLayer(layers[i]);
+                    }
+                    return out;
+                }
+
+                void touch(const std::string& cacheFileName)
+                {
+#if defined(DJV_PLATFORM_WINDOWS)
+                    _wutime(String::toWide(cacheFileName).c_str(), nullptr);
+#else // DJV_PLATFORM_WINDOWS
+                    utime(cacheFileName.c_str(), nullptr);
+#endif // DJV_PLATFORM_WINDOWS
+                }
+
+                void prune(const FileSystem::Path& cachePath, size_t maxByteCount)
+                {
+                    FileSystem::DirectoryListOptions options;
+                    options.fileExtensions.insert(".djvscene");
+                    auto fileInfos = FileSystem::FileInfo::directoryList(cachePath, options);
+                    std::sort(
+                        fileInfos.begin(),
+                        fileInfos.end(),
+                        [](const FileSystem::FileInfo& a, const FileSystem::FileInfo& b)
+                        {
+                            return a.getTime() > b.getTime();
+                        });
+                    size_t byteCount = 0;
+                    for (const auto& i : fileInfos)
+                    {
+                        byteCount += i.getSize();
+                        if (byteCount > maxByteCount)
+                        {
+                            std::remove(i.getFileName().c_str());
+                        }
+                    }
+                }
+
+                struct Read::Private
+                {
+                    std::shared_ptr<IRead> read;
+                    FileSystem::Path cachePath;
+                    size_t cacheMaxByteCount = 0;
+                };
+
+                Read::Read() :
+                    _p(new Private)
+                {}
+
+                Read::~Read()
+                {}
+
+                std::shared_ptr<Read> Read::create(
+                    const std::shared_ptr<IRead>& read,
+                    const FileSystem::Path& cachePath,
+                    size_t cacheMaxByteCount,
+                    const FileSystem::FileInfo& fileInfo,
+                    const std::shared_ptr<TextSystem>& textSystem,
+                    const std::shared_ptr<ResourceSystem>& resourceSystem,
+                    const std::shared_ptr<LogSystem>& logSystem)
+                {
+                    auto out = std::shared_ptr<Read>(new Read);
+                    out->_init(fileInfo, textSystem, resourceSystem, logSystem);
+                    out->_p->read = read;
+                    out->_p->cachePath = cachePath;
+                    out->_p->cacheMaxByteCount = cacheMaxByteCount;
+                    return out;
+                }
+
+                std::future<Info> Read::getInfo()
+                {
+                    return _p->read->getInfo();
+                }
+
+                std::future<std::shared_ptr<Scene> > Read::getScene()
+                {
+                    auto weak = std::weak_ptr<Read>(std::dynamic_pointer_cast<Read>(shared_from_this()));
+                    return std::async(
+                        std::launch::async,
+                        [weak]
+                        {
+                            std::shared_ptr<Scene> out;
+                            auto read = weak.lock();
+                            if (!read)
+                            {
+                                return out;
+                            }
+                            auto& p = *read->_p;
+                            const auto& logSystem = read->_logSystem;
+                            const FileSystem::FileInfo fileInfo(read->_fileInfo.getFileName());
+                            const std::string cacheFileName = getFileName(p.cachePath, fileInfo);
+                            try
+                            {
+                                const auto t0 = std::chrono::steady_clock::now();
+                                out = Cache::read(cacheFileName, fileInfo);
+                                if (out)
+                                {
+                                    // Update the modification time so the
+                                    // least recently used files are removed
+                                    // first.
+                                    touch(cacheFileName);
+                                    const auto t1 = std::chrono::steady_clock::now();
+                                    std::stringstream ss;
+                                    ss << fileInfo.getFileName() << ": read from the cache in " <<
+                                        std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms";
+                                    logSystem->log("djv::Scene::IO::Cache", ss.str());
+                                }
+                            }
+                            catch (const std::exception& e)
+                            {
+                                logSystem->log("djv::Scene::IO::Cache", e.what(), LogLevel::Warning);
+                            }
+
+                            if (!out)
+                            {
+                                const auto t0 = std::chrono::steady_clock::now();
+                                out = p.read->getScene().get();
+                                const auto t1 = std::chrono::steady_clock::now();
+                                if (out)
+                                {
+                                    try
+                                    {
+                                        if (!FileSystem::FileInfo(p.cachePath).doesExist())
+                                        {
+                                            FileSystem::Path::mkdir(p.cachePath);
+                                        }
+                                        write(cacheFileName, fileInfo, out);
+                                        prune(p.cachePath, p.cacheMaxByteCount);
+                                        const auto t2 = std::chrono::steady_clock::now();
+                                        std::stringstream ss;
+                                        ss << fileInfo.getFileName() << ": imported in " <<
+                                            std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, " <<
+                                            "cache written in " <<
+                                            std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms";
+                                        logSystem->log("djv::Scene::IO::Cache", ss.str());
+                                    }
+                                    catch (const std::exception& e)
+                                    {
+                                        logSystem->log("djv::Scene::IO::Cache", e.what(), LogLevel::Warning);
+                                    }
+                                }
+                            }
+                            return out;
+                        });
+                }
+
+            } // namespace Cache
+        } // namespace IO
+    } // namespace Scene
+} // namespace djv
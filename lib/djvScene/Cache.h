@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2019-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvScene/IO.h>
+
+#include <djvCore/Path.h>
+
+namespace djv
+{
+    namespace Scene
+    {
+        namespace IO
+        {
+            //! This namespace provides a binary cache for imported scenes.
+            //!
+            //! The cache stores the primitives, transforms, layers, materials,
+            //! and the flattened mesh buffers of a scene so that re-opening a
+            //! file does not need to parse text or tessellate surfaces. The
+            //! cache files are memory mapped and the mesh buffers are copied
+            //! directly without any parsing.
+            //!
+            //! A cache file is only used when the size and modification time
+            //! of the source file match the values recorded when it was
+            //! written. Files referenced by the source file (for example
+            //! linked OpenNURBS instance definitions) are not checked.
+            namespace Cache
+            {
+                //! Get the cache file name for a scene file.
+                std::string getFileName(const Core::FileSystem::Path& cachePath, const Core::FileSystem::FileInfo&);
+
+                //! Get whether a cache file is valid for a scene file.
+                bool isValid(const std::string& cacheFileName, const Core::FileSystem::FileInfo&);
+
+                //! Write a scene to a cache file. The file is written to a
+                //! temporary file first and then renamed.
+                //! Throws:
+                //! - Core::FileSystem::Error
+                //! - std::exception
+                void write(
+                    const std::string&                     cacheFileName,
+                    const Core::FileSystem::FileInfo&      sourceFileInfo,
+                    const std::shared_ptr<Scene>&);
+
+                //! Read a scene from a cache file. Returns null if the cache
+                //! file is missing or out of date.
+                //! Throws:
+                //! - Core::FileSystem::Error
+                //! - std::exception
+                std::shared_ptr<Scene> read(
+                    const std::string&                     cacheFileName,
+                    const Core::FileSystem::FileInfo&      sourceFileInfo);
+
+                //! Update the modification time of a cache file to mark it as
+                //! recently used.
+                void touch(const std::string& cacheFileName);
+
+                //! Remove the least recently used cache files until the total
+                //! size is within the given number of bytes.
+                void prune(const Core::FileSystem::Path& cachePath, size_t maxByteCount);
+
+                //! This class provides a reader that loads scenes from the
+                //! cache, falling back to another reader and writing the
+                //! cache when it is missing or out of date. The cache is pruned
+                //! to the maximum size after it is written.
+                class Read : public IRead
+                {
+                    DJV_NON_COPYABLE(Read);
+
+                protected:
+                    Read();
+
+                public:
+                    ~Read() override;
+
+                    static std::shared_ptr<Read> create(
+                        const std::shared_ptr<IRead>&,
+                        const Core::FileSystem::Path& cachePath,
+                        size_t cacheMaxByteCount,
+                        const Core::FileSystem::FileInfo&,
+                        const std::shared_ptr<Core::TextSystem>&,
+                        const std::shared_ptr<Core::ResourceSystem>&,
+                        const std::shared_ptr<Core::LogSystem>&);
+
+                    std::future<Info> getInfo() override;
+                    std::future<std::shared_ptr<Scene> > getScene() override;
+
+                private:
+                    DJV_PRIVATE();
+                };
+
+            } // namespace Cache
+        } // namespace IO
+    } // namespace Scene
+} // namespace djv
@@ -4,6 +4,7 @@
 
 #include <djvScene/IO.h>
 
+#include <djvScene/Cache.h>
 #include <djvScene/OBJ.h>
 #if defined(OpenNURBS_FOUND)
 #include <djvScene/OpenNURBS.h>
@@ -12,6 +13,7 @@
 #include <djvCore/Context.h>
 #include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
@@ -127,6 +129,9 @@ namespace djv
                 std::shared_ptr<ValueSubject<bool> > optionsChanged;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
+                bool cacheEnabled = true;
+                size_t cacheMaxByteCount = Memory::gigabyte;
+                FileSystem::Path cachePath;
             };
 
             void System::_init(const std::shared_ptr<Context>& context)
@@ -137,6 +142,9 @@ namespace djv
 
                 p.optionsChanged = ValueSubject<bool>::create();
 
+                auto resourceSystem = context->getSystemT<ResourceSystem>();
+                p.cachePath = FileSystem::Path(resourceSystem->getPath(FileSystem::ResourcePath::Documents), "SceneCache");
+
                 p.plugins[OBJ::pluginName] = OBJ::Plugin::create(context);
 #if defined(OpenNURBS_FOUND)
                 p.plugins[OpenNURBS::pluginName] = OpenNURBS::Plugin::create(context);
@@ -163,6 +171,7 @@ namespace djv
             {
                 auto out = std::shared_ptr<System>(new System);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
 
@@ -216,6 +225,31 @@ namespace djv
                 return _p->optionsChanged;
             }
 
+            bool System::isCacheEnabled() const
+            {
+                return _p->cacheEnabled;
+            }
+
+            void System::setCacheEnabled(bool value)
+            {
+                _p->cacheEnabled = value;
+            }
+
+            size_t System::getCacheMaxByteCount() const
+            {
+                return _p->cacheMaxByteCount;
+            }
+
+            void System::setCacheMaxByteCount(size_t value)
+            {
+                _p->cacheMaxByteCount = value;
+            }
+
+            const FileSystem::Path& System::getCachePath() const
+            {
+                return _p->cachePath;
+            }
+
             const std::set<std::string>& System::getSequenceExtensions() const
             {
                 return _p->sequenceExtensions;
@@ -259,6 +293,20 @@ namespace djv
                         break;
                     }
                 }
+                if (out && p.cacheEnabled)
+                {
+                    if (auto context = getContext().lock())
+                    {
+                        out = Cache::Read::create(
+                            out,
+                            p.cachePath,
+                            p.cacheMaxByteCount,
+                            fileInfo,
+                            context->getSystemT<TextSystem>(),
+                            context->getSystemT<ResourceSystem>(),
+                            context->getSystemT<LogSystem>());
+                    }
+                }
                 if (!out)
                 {
                     if (auto context = getContext().lock())
@@ -153,10 +153,27 @@ namespace djv
 
                 std::shared_ptr<Core::IValueSubject<bool> > observeOptionsChanged() const;
 
+                //! Get whether imported scenes are cached.
+                //! \sa Cache
+                bool isCacheEnabled() const;
+
+                void setCacheEnabled(bool);
+
+                //! Get the maximum size of the scene cache in bytes. The least
+                //! recently used files are removed when the cache is larger.
+                size_t getCacheMaxByteCount() const;
+
+                void setCacheMaxByteCount(size_t);
+
+                //! Get the directory for the scene cache.
+                const Core::FileSystem::Path& getCachePath() const;
+
                 const std::set<std::string>& getSequenceExtensions() const;
                 bool canRead(const Core::FileSystem::FileInfo&) const;
                 bool canWrite(const Core::FileSystem::FileInfo&, const Info&) const;
 
+                //! Read a scene. When the cache is enabled the scene is read
+                //! from the cache if it is up to date.
                 //! Throws:
                 //! - Core::FileSystem::Error
                 std::shared_ptr<IRead> read(const Core::FileSystem::FileInfo&);
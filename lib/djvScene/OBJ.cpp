@@ -243,9 +243,7 @@ namespace djv
                                                     parseFaceIndex(word, line - word, v, t, n);
                                                     if (index < 3)
                                                     {
-                                                        face.v[index].v = v;
-                                                        face.v[index].t = t;
-                                                        face.v[index++].n = n;
+                                                        face.v[index++] = AV::Geom::TriangleMesh::Vertex(v, t, n);
                                                     }
                                                     else
                                                     {
@@ -309,6 +307,9 @@ namespace djv
                             }
                         }
 
+                        // Merge duplicate vertices so the mesh can be drawn indexed.
+                        AV::Geom::TriangleMesh::weld(mesh);
+
                         mesh.bboxUpdate();
                     }
 
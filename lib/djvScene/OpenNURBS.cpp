@@ -81,76 +81,72 @@ namespace djv
                     {
                         auto out = std::make_shared<AV::Geom::TriangleMesh>();
 
+                        const int vertexCount = onMesh->VertexCount();
                         const int faceCount = onMesh->FaceCount();
                         const bool hasTexCoord = onMesh->HasTextureCoordinates();
                         const bool hasNormals = onMesh->HasVertexNormals();
 
-                        for (int i = 0; i < faceCount; ++i)
+                        // Use the vertex indices of the mesh so that the faces share
+                        // their vertices.
+                        out->v.reserve(vertexCount);
+                        for (int i = 0; i < vertexCount; ++i)
                         {
-                            const ON_MeshFace& f = onMesh->m_F[i];
-                            const size_t v = 1 + out->v.size();
-                            const size_t n = 1 + out->n.size();
-                            const size_t t = 1 + out->t.size();
-                            for (int j = 0; j < 3; ++j)
+                            out->v.push_back(fromON(onMesh->m_V[i]));
+                        }
+                        if (hasTexCoord)
+                        {
+                            out->t.reserve(vertexCount);
+                            for (int i = 0; i < vertexCount; ++i)
                             {
-                                out->v.push_back(fromON(onMesh->m_V[f.vi[j]]));
-                                if (hasTexCoord)
-                                {
-                                    out->t.push_back(fromON(onMesh->m_T[f.vi[j]]));
-                                }
-                                if (hasNormals)
-                                {
-                                    out->n.push_back(fromON(onMesh->m_N[f.vi[j]]));
-                                }
+                                out->t.push_back(fromON(onMesh->m_T[i]));
+                            }
+                        }
+                        if (hasNormals)
+                        {
+                            out->n.reserve(vertexCount);
+                            for (int i = 0; i < vertexCount; ++i)
+                            {
+                                out->n.push_back(fromON(onMesh->m_N[i]));
                             }
+                        }
+
+                        auto vertex = [hasTexCoord, hasNormals](int vi)
+                        {
+                            const size_t index = static_cast<size_t>(vi) + 1;
+                            return AV::Geom::TriangleMesh::Vertex(index, hasTexCoord ? index : 0, hasNormals ? index : 0);
+                        };
+                        for (int i = 0; i < faceCount; ++i)
+                        {
+                            const ON_MeshFace& f = onMesh->m_F[i];
                             if (f.IsQuad())
                             {
-                                out->v.push_back(fromON(onMesh->m_V[f.vi[3]]));
-                                if (hasTexCoord)
-                                {
-                                    out->t.push_back(fromON(onMesh->m_T[f.vi[3]]));
-                                }
-                                if (hasNormals)
-                                {
-                                    out->n.push_back(fromON(onMesh->m_N[f.vi[3]]));
-                                }
-                                if (onMesh->m_V[f.vi[0]].DistanceTo(onMesh->m_V[f.vi[2]]) <=
+                                int a[3] = { f.vi[0], f.vi[1], f.vi[2] };
+                                int b[3] = { f.vi[0], f.vi[2], f.vi[3] };
+                                if (onMesh->m_V[f.vi[0]].DistanceTo(onMesh->m_V[f.vi[2]]) >
                                     onMesh->m_V[f.vi[1]].DistanceTo(onMesh->m_V[f.vi[3]]))
                                 {
-                                    AV::Geom::TriangleMesh::Triangle a;
-                                    a.v0 = AV::Geom::TriangleMesh::Vertex(v + 0, hasTexCoord ? t + 0 : 0, hasNormals ? n + 0 : 0);
-                                    a.v1 = AV::Geom::TriangleMesh::Vertex(v + 1, hasTexCoord ? t + 1 : 0, hasNormals ? n + 1 : 0);
-                                    a.v2 = AV::Geom::TriangleMesh::Vertex(v + 2, hasTexCoord ? t + 2 : 0, hasNormals ? n + 2 : 0);
-                                    out->triangles.push_back(a);
-                                    AV::Geom::TriangleMesh::Triangle b;
-                                    a.v0 = AV::Geom::TriangleMesh::Vertex(v + 0, hasTexCoord ? t + 0 : 0, hasNormals ? n + 0 : 0);
-                                    a.v1 = AV::Geom::TriangleMesh::Vertex(v + 2, hasTexCoord ? t + 2 : 0, hasNormals ? n + 2 : 0);
-                                    a.v2 = AV::Geom::TriangleMesh::Vertex(v + 3, hasTexCoord ? t + 3 : 0, hasNormals ? n + 3 : 0);
-                                    out->triangles.push_back(a);
+                                    a[0] = f.vi[1]; a[1] = f.vi[2]; a[2] = f.vi[3];
+                                    b[0] = f.vi[1]; b[1] = f.vi[3]; b[2] = f.vi[0];
                                 }
-                                else
+                                for (const auto& k : { a, b })
                                 {
-                                    AV::Geom::TriangleMesh::Triangle a;
-                                    a.v0 = AV::Geom::TriangleMesh::Vertex(v + 1, hasTexCoord ? t + 1 : 0, hasNormals ? n + 1 : 0);
-                                    a.v1 = AV::Geom::TriangleMesh::Vertex(v + 2, hasTexCoord ? t + 2 : 0, hasNormals ? n + 2 : 0);
-                                    a.v2 = AV::Geom::TriangleMesh::Vertex(v + 3, hasTexCoord ? t + 3 : 0, hasNormals ? n + 3 : 0);
-                                    out->triangles.push_back(a);
-                                    AV::Geom::TriangleMesh::Triangle b;
-                                    a.v0 = AV::Geom::TriangleMesh::Vertex(v + 1, hasTexCoord ? t + 1 : 0, hasNormals ? n + 1 : 0);
-                                    a.v1 = AV::Geom::TriangleMesh::Vertex(v + 3, hasTexCoord ? t + 3 : 0, hasNormals ? n + 3 : 0);
-                                    a.v2 = AV::Geom::TriangleMesh::Vertex(v + 0, hasTexCoord ? t + 0 : 0, hasNormals ? n + 0 : 0);
-                                    out->triangles.push_back(a);
+                                    AV::Geom::TriangleMesh::Triangle triangle;
+                                    triangle.v0 = vertex(k[0]);
+                                    triangle.v1 = vertex(k[1]);
+                                    triangle.v2 = vertex(k[2]);
+                                    out->triangles.push_back(triangle);
                                 }
                             }
                             else
                             {
-                                AV::Geom::TriangleMesh::Triangle a;
-                                a.v0 = AV::Geom::TriangleMesh::Vertex(v + 0, hasTexCoord ? t + 0 : 0, hasNormals ? n + 0 : 0);
-                                a.v1 = AV::Geom::TriangleMesh::Vertex(v + 1, hasTexCoord ? t + 1 : 0, hasNormals ? n + 1 : 0);
-                                a.v2 = AV::Geom::TriangleMesh::Vertex(v + 2, hasTexCoord ? t + 2 : 0, hasNormals ? n + 2 : 0);
-                                out->triangles.push_back(a);
+                                AV::Geom::TriangleMesh::Triangle triangle;
+                                triangle.v0 = vertex(f.vi[0]);
+                                triangle.v1 = vertex(f.vi[1]);
+                                triangle.v2 = vertex(f.vi[2]);
+                                out->triangles.push_back(triangle);
                             }
                         }
+                        AV::Geom::TriangleMesh::weld(*out);
                         out->bboxUpdate();
                         return out;
                     }
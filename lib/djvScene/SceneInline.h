@@ -11,6 +11,11 @@ namespace djv
             return _primitives;
         }
 
+        inline const std::vector<std::shared_ptr<IPrimitive> >& Scene::getDefinitions() const
+        {
+            return _definitions;
+        }
+
         inline const std::vector<std::shared_ptr<Layer> >& Scene::getLayers() const
         {
             return _layers;
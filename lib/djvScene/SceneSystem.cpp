@@ -38,6 +38,7 @@ namespace djv
         {
             auto out = std::shared_ptr<SceneSystem>(new SceneSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -28,6 +28,14 @@ namespace djv
             {
                 std::shared_ptr<djv::AV::AVSystem> avSystem;
                 std::shared_ptr<djv::AV::IO::System> ioSystem;
+                bool init = true;
+                std::shared_ptr<ValueObserver<Time::Units> > timeUnitsObserver;
+                std::shared_ptr<ValueObserver<djv::AV::AlphaBlend> > alphaBlendObserver;
+                std::shared_ptr<ValueObserver<Time::FPS> > defaultSpeedObserver;
+                std::shared_ptr<ValueObserver<djv::AV::Render2D::ImageFilterOptions> > imageFilterOptionsObserver;
+                std::shared_ptr<ValueObserver<bool> > lcdTextObserver;
+                std::shared_ptr<ValueObserver<bool> > sdfTextObserver;
+                std::shared_ptr<ValueObserver<bool> > ioOptionsObserver;
             };
 
             void AV::_init(const std::shared_ptr<Core::Context>& context)
@@ -37,6 +45,63 @@ namespace djv
                 p.avSystem = context->getSystemT<djv::AV::AVSystem>();
                 p.ioSystem = context->getSystemT<djv::AV::IO::System>();
                 _load();
+
+                // The settings are owned by the other systems, so observe them
+                // to find out when they need to be saved.
+                auto weak = std::weak_ptr<AV>(std::dynamic_pointer_cast<AV>(shared_from_this()));
+                auto changed = [weak]
+                {
+                    if (auto settings = weak.lock())
+                    {
+                        if (!settings->_p->init)
+                        {
+                            settings->_setDirty();
+                        }
+                    }
+                };
+                p.timeUnitsObserver = ValueObserver<Time::Units>::create(
+                    p.avSystem->observeTimeUnits(),
+                    [changed](Time::Units)
+                    {
+                        changed();
+                    });
+                p.alphaBlendObserver = ValueObserver<djv::AV::AlphaBlend>::create(
+                    p.avSystem->observeAlphaBlend(),
+                    [changed](djv::AV::AlphaBlend)
+                    {
+                        changed();
+                    });
+                p.defaultSpeedObserver = ValueObserver<Time::FPS>::create(
+                    p.avSystem->observeDefaultSpeed(),
+                    [changed](Time::FPS)
+                    {
+                        changed();
+                    });
+                p.imageFilterOptionsObserver = ValueObserver<djv::AV::Render2D::ImageFilterOptions>::create(
+                    p.avSystem->observeImageFilterOptions(),
+                    [changed](const djv::AV::Render2D::ImageFilterOptions&)
+                    {
+                        changed();
+                    });
+                p.lcdTextObserver = ValueObserver<bool>::create(
+                    p.avSystem->observeLCDText(),
+                    [changed](bool)
+                    {
+                        changed();
+                    });
+                p.sdfTextObserver = ValueObserver<bool>::create(
+                    p.avSystem->observeSDFText(),
+                    [changed](bool)
+                    {
+                        changed();
+                    });
+                p.ioOptionsObserver = ValueObserver<bool>::create(
+                    p.ioSystem->observeOptionsChanged(),
+                    [changed](bool)
+                    {
+                        changed();
+                    });
+                p.init = false;
             }
 
             AV::AV() :
@@ -64,16 +129,19 @@ namespace djv
                     Time::FPS defaultSpeed = Time::getDefaultSpeed();
                     djv::AV::Render2D::ImageFilterOptions imageFilterOptions;
                     bool lcdText = false;
+                    bool sdfText = false;
                     read("TimeUnits", object, timeUnits);
                     read("AlphaBlend", object, alphaBlend);
                     read("DefaultSpeed", object, defaultSpeed);
                     read("ImageFilterOptions", object, imageFilterOptions);
                     read("LCDText", object, lcdText);
+                    read("SDFText", object, sdfText);
                     p.avSystem->setTimeUnits(timeUnits);
                     p.avSystem->setAlphaBlend(alphaBlend);
                     p.avSystem->setDefaultSpeed(defaultSpeed);
                     p.avSystem->setImageFilterOptions(imageFilterOptions);
                     p.avSystem->setLCDText(lcdText);
+                    p.avSystem->setSDFText(sdfText);
                     for (const auto & i : p.ioSystem->getPluginNames())
                     {
                         const auto j = object.find(i);
@@ -95,6 +163,7 @@ namespace djv
                 write("DefaultSpeed", p.avSystem->observeDefaultSpeed()->get(), object);
                 write("ImageFilterOptions", p.avSystem->observeImageFilterOptions()->get(), object);
                 write("LCDText", p.avSystem->observeLCDText()->get(), object);
+                write("SDFText", p.avSystem->observeSDFText()->get(), object);
                 for (const auto & i : p.ioSystem->getPluginNames())
                 {
                     object[i] = p.ioSystem->getOptions(i);
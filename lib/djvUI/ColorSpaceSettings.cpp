@@ -28,6 +28,7 @@ namespace djv
                 int currentIndex = 0;
                 std::shared_ptr<ListObserver<AV::OCIO::Config> > configsObserver;
                 std::shared_ptr<ValueObserver<int> > currentIndexObserver;
+                bool init = true;
             };
 
             void ColorSpace::_init(const std::shared_ptr<Core::Context>& context)
@@ -95,6 +96,10 @@ namespace djv
                         if (auto settings = weak.lock())
                         {
                             settings->_p->configs = value;
+                            if (!settings->_p->init)
+                            {
+                                settings->_setDirty();
+                            }
                         }
                     });
                 p.currentIndexObserver = ValueObserver<int>::create(
@@ -104,8 +109,13 @@ namespace djv
                         if (auto settings = weak.lock())
                         {
                             settings->_p->currentIndex = value;
+                            if (!settings->_p->init)
+                            {
+                                settings->_setDirty();
+                            }
                         }
                     });
+                p.init = false;
             }
 
             ColorSpace::ColorSpace() :
@@ -223,6 +223,7 @@ namespace djv
         {
             auto out = std::shared_ptr<DialogSystem>(new DialogSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
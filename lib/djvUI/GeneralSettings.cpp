@@ -22,6 +22,8 @@ namespace djv
             struct General::Private
             {
                 std::shared_ptr<TextSystem> textSystem;
+                bool init = true;
+                std::shared_ptr<ValueObserver<std::string> > currentLocaleObserver;
             };
 
             void General::_init(const std::shared_ptr<Core::Context>& context)
@@ -31,6 +33,21 @@ namespace djv
                 p.textSystem = context->getSystemT<TextSystem>();
                 p.textSystem->setCurrentLocale(p.textSystem->getSystemLocale());
                 _load();
+
+                auto weak = std::weak_ptr<General>(std::dynamic_pointer_cast<General>(shared_from_this()));
+                p.currentLocaleObserver = ValueObserver<std::string>::create(
+                    p.textSystem->observeCurrentLocale(),
+                    [weak](const std::string&)
+                    {
+                        if (auto settings = weak.lock())
+                        {
+                            if (!settings->_p->init)
+                            {
+                                settings->_setDirty();
+                            }
+                        }
+                    });
+                p.init = false;
             }
 
             General::General() :
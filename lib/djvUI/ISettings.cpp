@@ -62,6 +62,17 @@ namespace djv
                 }
             }
 
+            void ISettings::_setDirty()
+            {
+                if (auto context = _p->context.lock())
+                {
+                    if (auto system = context->getSystemT<System>())
+                    {
+                        system->_setDirty(shared_from_this());
+                    }
+                }
+            }
+
         } // namespace Settings
     } // namespace UI
 } // namespace djv
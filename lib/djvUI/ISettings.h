@@ -47,6 +47,10 @@ namespace djv
                 //! \todo This function needs to be called by derived classes at the end of their _init() function.
                 void _load();
 
+                //! Mark the settings as changed. This function needs to be called by
+                //! derived classes when a value that is saved changes.
+                void _setDirty();
+
             private:
                 DJV_PRIVATE();
             };
@@ -204,6 +204,7 @@ namespace djv
         {
             auto out = std::shared_ptr<IconSystem>(new IconSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
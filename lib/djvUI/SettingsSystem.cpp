@@ -12,7 +12,17 @@
 #include <djvCore/Error.h>
 #include <djvCore/FileIO.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/LogSystem.h>
 #include <djvCore/ResourceSystem.h>
+#include <djvCore/StringFormat.h>
+#include <djvCore/TextSystem.h>
+#include <djvCore/Timer.h>
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
 
 using namespace djv::Core;
 
@@ -26,43 +36,336 @@ namespace djv
             {
                 const size_t settingsVersion = 25;
 
+                void skipWhitespace(const char*& p, const char* end)
+                {
+                    while (p < end && (' ' == *p || '\t' == *p || '\n' == *p || '\r' == *p))
+                    {
+                        ++p;
+                    }
+                }
+
+                void skipString(const char*& p, const char* end)
+                {
+                    ++p;
+                    while (p < end && *p != '"')
+                    {
+                        if ('\\' == *p)
+                        {
+                            ++p;
+                        }
+                        ++p;
+                    }
+                    if (p >= end)
+                    {
+                        throw std::invalid_argument("Unterminated string");
+                    }
+                    ++p;
+                }
+
+                void skipValue(const char*& p, const char* end)
+                {
+                    size_t depth = 0;
+                    while (p < end)
+                    {
+                        switch (*p)
+                        {
+                        case '"':
+                            skipString(p, end);
+                            if (0 == depth)
+                                return;
+                            continue;
+                        case '{':
+                        case '[':
+                            ++depth;
+                            break;
+                        case '}':
+                        case ']':
+                            if (0 == depth)
+                                return;
+                            --depth;
+                            if (0 == depth)
+                            {
+                                ++p;
+                                return;
+                            }
+                            break;
+                        case ',':
+                            if (0 == depth)
+                                return;
+                            break;
+                        default: break;
+                        }
+                        ++p;
+                    }
+                    if (depth > 0)
+                    {
+                        throw std::invalid_argument("Unterminated value");
+                    }
+                }
+
+                //! Split the top level JSON object into the unparsed text of
+                //! each value, so the values can be parsed when they are needed.
+                void splitObject(const char* p, const char* end, std::map<std::string, std::string>& out)
+                {
+                    skipWhitespace(p, end);
+                    if (p >= end || *p != '{')
+                    {
+                        throw std::invalid_argument("Expected an object");
+                    }
+                    ++p;
+                    while (true)
+                    {
+                        skipWhitespace(p, end);
+                        if (p < end && '}' == *p)
+                            break;
+                        if (p >= end || *p != '"')
+                        {
+                            throw std::invalid_argument("Expected a key");
+                        }
+                        const char* keyStart = p + 1;
+                        skipString(p, end);
+                        const std::string key(keyStart, p - 1);
+                        skipWhitespace(p, end);
+                        if (p >= end || *p != ':')
+                        {
+                            throw std::invalid_argument("Expected a value");
+                        }
+                        ++p;
+                        skipWhitespace(p, end);
+                        const char* valueStart = p;
+                        skipValue(p, end);
+                        const char* valueEnd = p;
+                        while (valueEnd > valueStart &&
+                            (' ' == valueEnd[-1] || '\t' == valueEnd[-1] || '\n' == valueEnd[-1] || '\r' == valueEnd[-1]))
+                        {
+                            --valueEnd;
+                        }
+                        out[key] = std::string(valueStart, valueEnd);
+                        skipWhitespace(p, end);
+                        if (p < end && ',' == *p)
+                        {
+                            ++p;
+                        }
+                        else if (p >= end || *p != '}')
+                        {
+                            throw std::invalid_argument("Expected a separator");
+                        }
+                    }
+                }
+
+                std::string getSettingsText(const std::map<std::string, std::string>& sections)
+                {
+                    std::string out = "{\n";
+                    size_t i = 0;
+                    for (const auto& section : sections)
+                    {
+                        out += String::indent(1);
+                        out += "\"";
+                        out += section.first;
+                        out += "\": ";
+                        out += section.second;
+                        if (i < sections.size() - 1)
+                        {
+                            out += ", ";
+                        }
+                        out += "\n";
+                        ++i;
+                    }
+                    out += "}\n";
+                    return out;
+                }
+
+                size_t getMilliseconds(const std::chrono::steady_clock::time_point& start)
+                {
+                    return std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start).count();
+                }
+
+                //! Read the sections of the settings file. The sections are
+                //! discarded if the file is from a different version.
+                //! Throws:
+                //! - std::exception
+                std::map<std::string, std::string> readSettingsFile(const FileSystem::Path& path)
+                {
+                    std::map<std::string, std::string> out;
+                    if (FileSystem::FileInfo(path).doesExist())
+                    {
+                        auto fileIO = FileSystem::FileIO::create();
+                        fileIO->open(std::string(path), FileSystem::FileIO::Mode::Read);
+                        std::vector<char> buf;
+                        const size_t fileSize = fileIO->getSize();
+                        buf.resize(fileSize);
+                        fileIO->read(buf.data(), fileSize);
+                        const char* bufP = buf.data();
+                        const char* bufEnd = bufP + fileSize;
+
+                        std::map<std::string, std::string> sections;
+                        splitObject(bufP, bufEnd, sections);
+                        size_t readSettingsVersion = 0;
+                        auto i = sections.find("SettingsVersion");
+                        if (i != sections.end())
+                        {
+                            picojson::value v;
+                            std::string error;
+                            picojson::parse(v, i->second.data(), i->second.data() + i->second.size(), &error);
+                            if (!error.empty())
+                            {
+                                throw std::invalid_argument(error);
+                            }
+                            fromJSON(v, readSettingsVersion);
+                        }
+                        if (settingsVersion == readSettingsVersion)
+                        {
+                            out = std::move(sections);
+                        }
+                    }
+                    return out;
+                }
+
+                //! This struct provides the text waiting to be written by the
+                //! write thread.
+                struct WriteQueue
+                {
+                    std::mutex mutex;
+                    std::condition_variable cv;
+                    std::string text;
+                    bool pending = false;
+                    bool running = true;
+                };
+
             } // namespace
 
+            struct System::Private
+            {
+                FileSystem::Path settingsPath;
+                bool settingsIO = true;
+
+                //! The JSON text of each section, either as it was read or as it
+                //! was last saved.
+                std::future<std::map<std::string, std::string> > readFuture;
+                std::map<std::string, std::string> sections;
+
+                std::set<std::shared_ptr<ISettings> > dirty;
+                std::shared_ptr<Time::Timer> saveTimer;
+
+                std::shared_ptr<WriteQueue> writeQueue;
+                std::thread writeThread;
+            };
+
             void System::_init(bool reset, const std::shared_ptr<Core::Context>& context)
             {
                 ISystem::_init("djv::UI::Settings::System", context);
+
+                DJV_PRIVATE_PTR();
                 
                 //! \todo Is there a better way to disable settings for tests?
                 if ("djvTest" == context->getName())
                 {
-                    _settingsIO = false;
+                    p.settingsIO = false;
                 }
 
                 addDependency(context->getSystemT<AV::AVSystem>());
 
                 if (auto resourceSystem = context->getSystemT<ResourceSystem>())
                 {
-                    _settingsPath = resourceSystem->getPath(FileSystem::ResourcePath::SettingsFile);
+                    p.settingsPath = resourceSystem->getPath(FileSystem::ResourcePath::SettingsFile);
                 }
 
+                if (!p.settingsIO)
+                    return;
+
+                // Read the settings file in the background, the sections are
+                // parsed as the settings are loaded.
                 if (!reset)
                 {
-                    _readSettingsFile(_settingsPath, _json);
+                    const auto path = p.settingsPath;
+                    p.readFuture = std::async(
+                        std::launch::async,
+                        [path]
+                        {
+                            return readSettingsFile(path);
+                        });
                 }
+
+                // The settings are saved once they have stopped changing.
+                p.saveTimer = Time::Timer::create(context);
+
+                // The write thread writes the settings file so the user
+                // interface does not wait for the disk.
+                p.writeQueue = std::make_shared<WriteQueue>();
+                auto writeQueue = p.writeQueue;
+                const auto path = p.settingsPath;
+                auto logSystemWeak = std::weak_ptr<LogSystem>(context->getSystemT<LogSystem>());
+                auto textSystemWeak = std::weak_ptr<TextSystem>(context->getSystemT<TextSystem>());
+                p.writeThread = std::thread(
+                    [writeQueue, path, logSystemWeak, textSystemWeak]
+                    {
+                        std::unique_lock<std::mutex> lock(writeQueue->mutex);
+                        while (writeQueue->running || writeQueue->pending)
+                        {
+                            if (!writeQueue->pending)
+                            {
+                                writeQueue->cv.wait(lock);
+                                continue;
+                            }
+                            const std::string text = std::move(writeQueue->text);
+                            writeQueue->text = std::string();
+                            writeQueue->pending = false;
+                            lock.unlock();
+
+                            std::stringstream ss;
+                            LogLevel logLevel = LogLevel::Information;
+                            try
+                            {
+                                const auto start = std::chrono::steady_clock::now();
+                                FileSystem::FileIO::writeAtomic(std::string(path), text.data(), text.size());
+                                ss << "Writing settings: " << path << " (" << getMilliseconds(start) << "ms)";
+                            }
+                            catch (const std::exception& e)
+                            {
+                                if (auto textSystem = textSystemWeak.lock())
+                                {
+                                    ss << std::string(String::Format("{0}: {1}").
+                                        arg(std::string(path)).
+                                        arg(textSystem->getText(DJV_TEXT("error_file_write")))) << ' ';
+                                }
+                                ss << e.what();
+                                logLevel = LogLevel::Error;
+                            }
+                            if (auto logSystem = logSystemWeak.lock())
+                            {
+                                logSystem->log("djv::UI::Settings::System", ss.str(), logLevel);
+                            }
+
+                            lock.lock();
+                        }
+                    });
             }
 
-            System::System()
+            System::System() :
+                _p(new Private)
             {}
 
             System::~System()
             {
-                _saveSettings();
+                DJV_PRIVATE_PTR();
+                _saveSettings(_settings);
+                if (p.writeThread.joinable())
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(p.writeQueue->mutex);
+                        p.writeQueue->running = false;
+                    }
+                    p.writeQueue->cv.notify_one();
+                    p.writeThread.join();
+                }
             }
 
             std::shared_ptr<System> System::create(bool reset, const std::shared_ptr<Core::Context>& context)
             {
                 auto out = std::shared_ptr<System>(new System);
                 out->_init(reset, context);
+                out->_setStartupEnd();
                 return out;
             }
 
@@ -78,25 +381,32 @@ namespace djv
                 {
                     _settings.erase(i);
                 }
+                _p->dirty.erase(value);
             }
 
             void System::_loadSettings(const std::shared_ptr<ISettings> & settings)
             {
-                if (!_settingsIO)
+                DJV_PRIVATE_PTR();
+                if (!p.settingsIO)
                     return;
 
-                std::stringstream ss;
-                ss << "Loading settings: " << settings->getName();
-                _log(ss.str());
+                const auto start = std::chrono::steady_clock::now();
+                _waitForRead();
 
-                picojson::value json;
                 const auto & name = settings->getName();
-                auto i = _json.find(name);
-                if (i != _json.end())
+                auto i = p.sections.find(name);
+                if (i != p.sections.end())
                 {
                     try
                     {
-                        settings->load(i->second);
+                        picojson::value json;
+                        std::string error;
+                        picojson::parse(json, i->second.data(), i->second.data() + i->second.size(), &error);
+                        if (!error.empty())
+                        {
+                            throw std::invalid_argument(error);
+                        }
+                        settings->load(json);
                     }
                     catch (const std::exception & e)
                     {
@@ -105,106 +415,110 @@ namespace djv
                         _log(ss.str(), LogLevel::Error);
                     }
                 }
+
+                std::stringstream ss;
+                ss << "Loading settings: " << name << " (" << getMilliseconds(start) << "ms)";
+                _log(ss.str());
             }
 
-            void System::_saveSettings()
+            void System::_setDirty(const std::shared_ptr<ISettings>& settings)
             {
-                if (!_settingsIO)
+                DJV_PRIVATE_PTR();
+                if (!p.settingsIO)
                     return;
 
-                picojson::value object(picojson::object_type, true);
-                object.get<picojson::object>()["SettingsVersion"] = toJSON(settingsVersion);
-
-                // Serialize the settings.
-                for (const auto & settings : _settings)
-                {
-                    object.get<picojson::object>()[settings->getName()] = settings->save();
-                }
-
-                // Write the JSON to disk.
-                _writeSettingsFile(_settingsPath, object);
+                // Restart the timer on every change so the settings are only
+                // saved once they stop changing.
+                p.dirty.insert(settings);
+                auto weak = std::weak_ptr<System>(std::dynamic_pointer_cast<System>(shared_from_this()));
+                p.saveTimer->start(
+                    Time::getTime(Time::TimerValue::Slow),
+                    [weak](const std::chrono::steady_clock::time_point&, const Time::Duration&)
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            const std::vector<std::shared_ptr<ISettings> > dirty(
+                                system->_p->dirty.begin(),
+                                system->_p->dirty.end());
+                            system->_p->dirty.clear();
+                            system->_saveSettings(dirty);
+                        }
+                    });
             }
 
-            void System::_readSettingsFile(const FileSystem::Path & path, std::map<std::string, picojson::value> & out)
+            void System::_saveSettings(const std::vector<std::shared_ptr<ISettings> >& settingsList)
             {
-                try
-                {
-                    if (FileSystem::FileInfo(path).doesExist())
-                    {
-                        std::stringstream ss;
-                        ss << "Reading settings: " << path;
-                        _log(ss.str());
-
-                        auto fileIO = FileSystem::FileIO::create();
-                        fileIO->open(std::string(path), FileSystem::FileIO::Mode::Read);
-#if defined(DJV_MMAP)
-                        const char * bufP = reinterpret_cast<const char *>(fileIO->mmapP());
-                        const char * bufEnd = reinterpret_cast<const char *>(fileIO->mmapEnd());
-#else // DJV_MMAP
-                        std::vector<char> buf;
-                        const size_t fileSize = fileIO->getSize();
-                        buf.resize(fileSize);
-                        fileIO->read(buf.data(), fileSize);
-                        const char* bufP = buf.data();
-                        const char* bufEnd = bufP + fileSize;
-#endif // DJV_MMAP
+                DJV_PRIVATE_PTR();
+                if (!p.settingsIO)
+                    return;
 
-                        picojson::value v;
-                        std::string error;
-                        picojson::parse(v, bufP, bufEnd, &error);
-                        if (!error.empty())
-                        {
-                            throw std::invalid_argument(error);
-                        }
+                // Make sure the sections have been read, otherwise the sections
+                // of settings that were not loaded would be lost.
+                _waitForRead();
 
-                        if (v.is<picojson::object>())
-                        {
-                            const auto & object = v.get<picojson::object>();
-                            size_t readSettingsVersion = 0;
-                            for (const auto& value : object)
-                            {
-                                if ("SettingsVersion" == value.first)
-                                {
-                                    fromJSON(value.second, readSettingsVersion);
-                                    break;
-                                }
-                            }
-                            if (settingsVersion == readSettingsVersion)
-                            {
-                                for (const auto& value : object)
-                                {
-                                    out[value.first] = value.second;
-                                }
-                            }
-                        }
+                // Serialize the settings, only sections that have changed
+                // cause the file to be written.
+                const auto start = std::chrono::steady_clock::now();
+                bool changed = false;
+                const std::string version = "\"" + std::to_string(settingsVersion) + "\"";
+                auto i = p.sections.find("SettingsVersion");
+                if (i == p.sections.end() || i->second != version)
+                {
+                    p.sections["SettingsVersion"] = version;
+                    changed = true;
+                }
+                for (const auto & settings : settingsList)
+                {
+                    std::string text;
+                    PicoJSON::write(settings->save(), text, 1, true);
+                    auto& section = p.sections[settings->getName()];
+                    if (section != text)
+                    {
+                        section = std::move(text);
+                        changed = true;
                     }
                 }
-                catch (const std::exception & e)
+                if (changed)
                 {
+                    {
+                        std::unique_lock<std::mutex> lock(p.writeQueue->mutex);
+                        p.writeQueue->text = getSettingsText(p.sections);
+                        p.writeQueue->pending = true;
+                    }
+                    p.writeQueue->cv.notify_one();
+
                     std::stringstream ss;
-                    ss << "Cannot read settings" << " '" << path << "'. " << e.what();
-                    _log(ss.str(), LogLevel::Error);
+                    ss << "Saving settings (" << getMilliseconds(start) << "ms)";
+                    _log(ss.str());
                 }
             }
 
-            void System::_writeSettingsFile(const FileSystem::Path & path, const picojson::value & value)
+            void System::_waitForRead()
             {
-                try
+                DJV_PRIVATE_PTR();
+                if (p.readFuture.valid())
                 {
-                    std::stringstream ss;
-                    ss << "Writing settings: " << path;
-                    _log(ss.str());
-
-                    auto fileIO = FileSystem::FileIO::create();
-                    fileIO->open(std::string(path), FileSystem::FileIO::Mode::Write);
-                    PicoJSON::write(value, fileIO);
-                    fileIO->write("\n");
-                }
-                catch (const std::exception & e)
-                {
-                    std::stringstream ss;
-                    ss << "Cannot write settings" << " '" << path << "'. " << e.what();
-                    _log(ss.str(), LogLevel::Error);
+                    const auto start = std::chrono::steady_clock::now();
+                    try
+                    {
+                        p.sections = p.readFuture.get();
+                        std::stringstream ss;
+                        ss << "Reading settings: " << p.settingsPath;
+                        _log(ss.str());
+                    }
+                    catch (const std::exception & e)
+                    {
+                        std::stringstream ss;
+                        ss << "Cannot read settings" << " '" << p.settingsPath << "'. " << e.what();
+                        _log(ss.str(), LogLevel::Error);
+                    }
+                    const size_t ms = getMilliseconds(start);
+                    if (ms > 0)
+                    {
+                        std::stringstream ss;
+                        ss << "Waited for settings: " << ms << "ms";
+                        _log(ss.str());
+                    }
                 }
             }
 
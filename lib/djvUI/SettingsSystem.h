@@ -19,6 +19,12 @@ namespace djv
 
             //! This class provides a system for saving and restoring user settings.
             //!
+            //! The settings file is read in the background and each section is
+            //! only parsed when the settings that use it are loaded. Settings that
+            //! have changed are saved once they stop changing, and the file is
+            //! written by a background thread to a temporary file that replaces
+            //! the settings file once it is complete.
+            //!
             //! \bug How can we merge settings changes from multiple application instances?
             class System : public Core::ISystem
             {
@@ -44,16 +50,13 @@ namespace djv
                 void _removeSettings(const std::shared_ptr<ISettings> &);
 
                 void _loadSettings(const std::shared_ptr<ISettings> &);
-                void _saveSettings();
-
-                void _readSettingsFile(const Core::FileSystem::Path &, std::map<std::string, picojson::value> &);
-                void _writeSettingsFile(const Core::FileSystem::Path &, const picojson::value &);
+                void _setDirty(const std::shared_ptr<ISettings> &);
+                void _saveSettings(const std::vector<std::shared_ptr<ISettings> > &);
+                void _waitForRead();
 
-                bool _reset = false;
-                std::map<std::string, picojson::value> _json;
                 std::vector<std::shared_ptr<ISettings> > _settings;
-                Core::FileSystem::Path _settingsPath;
-                bool _settingsIO = true;
+
+                DJV_PRIVATE();
 
                 friend class ISettings;
             };
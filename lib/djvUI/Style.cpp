@@ -6,6 +6,8 @@
 
 #include <djvUI/IconSystem.h>
 
+#include <djvAV/AVSystem.h>
+
 #include <djvCore/Context.h>
 #include <djvCore/LogSystem.h>
 
@@ -155,6 +157,21 @@ namespace djv
                             style->_dirty = true;
                         }
                     });
+
+                // Signed distance field text is measured differently so the
+                // widgets need to be updated.
+                if (auto avSystem = context->getSystemT<AV::AVSystem>())
+                {
+                    _sdfTextObserver = ValueObserver<bool>::create(
+                        avSystem->observeSDFText(),
+                        [weak](bool)
+                        {
+                            if (auto style = weak.lock())
+                            {
+                                style->_dirty = true;
+                            }
+                        });
+                }
             }
 
             Style::Style()
@@ -12,6 +12,7 @@
 #include <djvCore/BBox.h>
 #include <djvCore/PicoJSON.h>
 #include <djvCore/MapObserver.h>
+#include <djvCore/ValueObserver.h>
 
 #include <glm/vec2.hpp>
 
@@ -118,6 +119,7 @@ namespace djv
                 std::map<std::pair<AV::Font::FamilyID, std::string>, AV::Font::FaceID> _fontFaceToId;
                 std::shared_ptr<Core::MapObserver<AV::Font::FamilyID, std::string> > _fontNamesObserver;
                 std::shared_ptr<Core::MapObserver<AV::Font::FamilyID, std::map<AV::Font::FaceID, std::string> > > _fontFacesObserver;
+                std::shared_ptr<Core::ValueObserver<bool> > _sdfTextObserver;
                 bool _dirty = true;
             };
 
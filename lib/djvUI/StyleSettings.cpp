@@ -164,6 +164,7 @@ namespace djv
                     p.currentPalette->setIfChanged(palette);
                     p.currentPaletteName->setIfChanged(name);
                 }
+                _setDirty();
             }
 
             std::shared_ptr<IMapSubject<std::string, UI::Style::Metrics> > Style::observeMetrics() const
@@ -195,6 +196,7 @@ namespace djv
                     p.currentMetrics->setIfChanged(metrics);
                     p.currentMetricsName->setIfChanged(name);
                 }
+                _setDirty();
             }
 
             void Style::load(const picojson::value & value)
@@ -58,6 +58,7 @@ namespace djv
                 {
                     Widget::setTooltipsEnabled(value);
                 }
+                _setDirty();
             }
 
             void UI::load(const picojson::value & value)
@@ -104,6 +104,7 @@ namespace djv
         {
             auto out = std::shared_ptr<UISystem>(new UISystem);
             out->_init(resetSettings, context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -42,7 +42,10 @@ namespace djv
                 std::vector<FileSystem::FileInfo> items;
                 AV::Font::Metrics nameFontMetrics;
                 std::future<AV::Font::Metrics> nameFontMetricsFuture;
-                std::map<size_t, BBox2f> itemGeometry;
+                glm::vec2 itemPos = glm::vec2(0.F, 0.F);
+                glm::vec2 itemSize = glm::vec2(0.F, 0.F);
+                glm::vec2 itemSpacing = glm::vec2(0.F, 0.F);
+                size_t columns = 1;
                 std::map<size_t, std::string> names;
                 std::map<size_t, std::vector<AV::Font::TextLine> > nameLines;
                 std::map<size_t, std::future<std::vector<AV::Font::TextLine> > > nameLinesFutures;
@@ -52,6 +55,7 @@ namespace djv
                 std::map<size_t, std::shared_ptr<AV::Image::Image> > thumbnails;
                 std::map<size_t, AV::ThumbnailSystem::ImageFuture> thumbnailFutures;
                 std::map<size_t, std::chrono::steady_clock::time_point> thumbnailTimers;
+                std::map<size_t, AV::ThumbnailSystem::Priority> priorities;
                 std::map<FileSystem::FileType, std::shared_ptr<AV::Image::Image> > icons;
                 std::map<FileSystem::FileType, std::future<std::shared_ptr<AV::Image::Image> > > iconsFutures;
                 std::map<size_t, std::vector<std::shared_ptr<AV::Font::Glyph> > > nameGlyphs;
@@ -73,8 +77,65 @@ namespace djv
                 Event::PointerID pressedId = Event::invalidID;
                 glm::vec2 pressedPos = glm::vec2(0.F, 0.F);
                 std::function<void(const FileSystem::FileInfo&)> callback;
+
+                BBox2f getItemGeometry(size_t) const;
+                std::pair<size_t, size_t> getItemRange(const BBox2f&) const;
+                size_t getItem(const glm::vec2&) const;
             };
 
+            //! The items are arranged in a grid of equally sized cells so the
+            //! geometry and the items intersecting a region can be computed
+            //! directly from the index.
+            BBox2f ItemView::Private::getItemGeometry(size_t index) const
+            {
+                const size_t row = index / columns;
+                const size_t column = index % columns;
+                return BBox2f(
+                    itemPos.x + column * (itemSize.x + itemSpacing.x),
+                    itemPos.y + row * (itemSize.y + itemSpacing.y),
+                    itemSize.x,
+                    itemSize.y);
+            }
+
+            std::pair<size_t, size_t> ItemView::Private::getItemRange(const BBox2f& value) const
+            {
+                std::pair<size_t, size_t> out(0, 0);
+                const float rowHeight = itemSize.y + itemSpacing.y;
+                if (items.size() && rowHeight > 0.F)
+                {
+                    const int64_t rows = static_cast<int64_t>((items.size() + columns - 1) / columns);
+                    const int64_t row0 = Math::clamp(
+                        static_cast<int64_t>(floorf((value.min.y - itemPos.y) / rowHeight)),
+                        static_cast<int64_t>(0),
+                        rows);
+                    const int64_t row1 = Math::clamp(
+                        static_cast<int64_t>(floorf((value.max.y - itemPos.y) / rowHeight)) + 1,
+                        static_cast<int64_t>(0),
+                        rows);
+                    out.first = std::min(static_cast<size_t>(row0) * columns, items.size());
+                    out.second = std::min(static_cast<size_t>(row1) * columns, items.size());
+                }
+                return out;
+            }
+
+            size_t ItemView::Private::getItem(const glm::vec2& value) const
+            {
+                size_t out = invalid;
+                const glm::vec2 pos = value - itemPos;
+                const glm::vec2 cellSize = itemSize + itemSpacing;
+                if (pos.x >= 0.F && pos.y >= 0.F && cellSize.x > 0.F && cellSize.y > 0.F)
+                {
+                    const size_t column = static_cast<size_t>(pos.x / cellSize.x);
+                    const size_t row = static_cast<size_t>(pos.y / cellSize.y);
+                    const size_t index = row * columns + column;
+                    if (column < columns && index < items.size() && getItemGeometry(index).contains(value))
+                    {
+                        out = index;
+                    }
+                }
+                return out;
+            }
+
             void ItemView::_init(const std::shared_ptr<Context>& context)
             {
                 Widget::_init(context);
@@ -214,38 +275,30 @@ namespace djv
                 const float m = style->getMetric(MetricsRole::MarginSmall);
                 const float s = style->getMetric(MetricsRole::Spacing);
                 const float sh = style->getMetric(MetricsRole::Shadow);
-                p.itemGeometry.clear();
-                glm::vec2 pos = g.min;
-                auto item = p.items.begin();
-                size_t i = 0;
                 switch (p.viewType)
                 {
                 case ViewType::Tiles:
-                    pos += s;
-                    for (; item != p.items.end(); ++item, ++i)
+                {
+                    p.itemPos = g.min + s;
+                    p.itemSize.x = p.thumbnailSize.w + sh * 2.F;
+                    p.itemSize.y = p.thumbnailSize.h + p.nameFontMetrics.lineHeight * 2.F + m * 2.F + sh * 2.F;
+                    p.itemSpacing = glm::vec2(s, s);
+                    p.columns = 1;
+                    if (p.itemSize.x + s > 0.F)
                     {
-                        const float itemHeight = p.thumbnailSize.h + p.nameFontMetrics.lineHeight * 2.F + m * 2.F + sh * 2.F;
-                        const float itemWidth = p.thumbnailSize.w + sh * 2.F;
-                        p.itemGeometry[i] = BBox2f(pos.x, pos.y, itemWidth, itemHeight);
-                        pos.x += itemWidth;
-                        if (pos.x > g.max.x - itemWidth)
+                        while (p.itemPos.x + p.columns * p.itemSize.x + (p.columns - 1) * s <= g.max.x - p.itemSize.x)
                         {
-                            pos.x = g.min.x + s;
-                            pos.y += itemHeight + s;
-                        }
-                        else
-                        {
-                            pos.x += s;
+                            ++p.columns;
                         }
                     }
                     break;
+                }
                 case ViewType::List:
-                    for (; item != p.items.end(); ++item, ++i)
-                    {
-                        const float itemHeight = std::max(static_cast<float>(p.thumbnailSize.h), p.nameFontMetrics.lineHeight + m * 2.F);
-                        p.itemGeometry[i] = BBox2f(pos.x, pos.y, g.w(), itemHeight);
-                        pos.y += itemHeight;
-                    }
+                    p.itemPos = g.min;
+                    p.itemSize.x = g.w();
+                    p.itemSize.y = std::max(static_cast<float>(p.thumbnailSize.h), p.nameFontMetrics.lineHeight + m * 2.F);
+                    p.itemSpacing = glm::vec2(0.F, 0.F);
+                    p.columns = 1;
                     break;
                 default: break;
                 }
@@ -258,109 +311,163 @@ namespace djv
                     return;
                 if (auto context = getContext().lock())
                 {
+                    // Requests are only made for the visible items and the items
+                    // that are close to the view, at a lower priority, since they
+                    // are likely to be scrolled into view.
                     const auto& style = _getStyle();
                     const auto& clipRect = event.getClipRect();
-                    for (const auto& i : p.itemGeometry)
+                    const auto visibleRange = p.getItemRange(clipRect);
+                    const auto nearRange = p.getItemRange(clipRect.margin(0.F, clipRect.h(), 0.F, clipRect.h()));
+                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
+                    auto ioSystem = context->getSystemT<AV::IO::System>();
+                    for (size_t i = nearRange.first; i < nearRange.second; ++i)
                     {
-                        if (i.first < p.items.size() && i.second.intersects(clipRect))
+                        const auto& fileInfo = p.items[i];
+                        const auto priority = i >= visibleRange.first && i < visibleRange.second ?
+                            AV::ThumbnailSystem::Priority::High :
+                            AV::ThumbnailSystem::Priority::Low;
                         {
-                            const auto& fileInfo = p.items[i.first];
+                            const auto j = p.priorities.find(i);
+                            if (j != p.priorities.end() && j->second != priority && thumbnailSystem)
                             {
-                                const auto j = p.nameLines.find(i.first);
-                                if (j == p.nameLines.end())
+                                const auto k = p.ioInfoFutures.find(i);
+                                if (k != p.ioInfoFutures.end())
                                 {
-                                    const auto k = p.nameLinesFutures.find(i.first);
-                                    if (k == p.nameLinesFutures.end())
-                                    {
-                                        const float m = style->getMetric(MetricsRole::MarginSmall);
-                                        const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                        p.names[i.first] = fileInfo.getFileName(Frame::invalid, false);
-                                        p.nameLinesFutures[i.first] = p.fontSystem->textLines(
-                                            p.names[i.first],
-                                            p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
-                                            fontInfo);
-                                    }
+                                    thumbnailSystem->setInfoPriority(k->second.uid, priority);
+                                }
+                                const auto l = p.thumbnailFutures.find(i);
+                                if (l != p.thumbnailFutures.end())
+                                {
+                                    thumbnailSystem->setImagePriority(l->second.uid, priority);
                                 }
+                                j->second = priority;
                             }
-                            if (p.ioInfo.find(i.first) == p.ioInfo.end())
+                        }
+                        {
+                            const auto j = p.nameLines.find(i);
+                            if (j == p.nameLines.end())
                             {
-                                if (p.ioInfoFutures.find(i.first) == p.ioInfoFutures.end())
+                                const auto k = p.nameLinesFutures.find(i);
+                                if (k == p.nameLinesFutures.end())
                                 {
-                                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                                    auto ioSystem = context->getSystemT<AV::IO::System>();
-                                    if (thumbnailSystem && ioSystem)
-                                    {
-                                        if (ioSystem->canRead(fileInfo))
-                                        {
-                                            p.ioInfoFutures[i.first] = thumbnailSystem->getInfo(fileInfo);
-                                        }
-                                    }
+                                    const float m = style->getMetric(MetricsRole::MarginSmall);
+                                    const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
+                                    p.names[i] = fileInfo.getFileName(Frame::invalid, false);
+                                    p.nameLinesFutures[i] = p.fontSystem->textLines(
+                                        p.names[i],
+                                        p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
+                                        fontInfo);
                                 }
                             }
-                            if (p.thumbnails.find(i.first) == p.thumbnails.end())
+                        }
+                        if (p.ioInfo.find(i) == p.ioInfo.end())
+                        {
+                            if (p.ioInfoFutures.find(i) == p.ioInfoFutures.end())
                             {
-                                if (p.thumbnailFutures.find(i.first) == p.thumbnailFutures.end())
+                                if (thumbnailSystem && ioSystem)
                                 {
-                                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                                    auto ioSystem = context->getSystemT<AV::IO::System>();
-                                    if (thumbnailSystem && ioSystem && ioSystem->canRead(fileInfo))
+                                    if (ioSystem->canRead(fileInfo))
                                     {
-                                        p.thumbnailFutures[i.first] = thumbnailSystem->getImage(fileInfo, p.thumbnailSize);
+                                        p.ioInfoFutures[i] = thumbnailSystem->getInfo(fileInfo, priority);
+                                        p.priorities[i] = priority;
                                     }
                                 }
                             }
-                            if (p.nameGlyphs.find(i.first) == p.nameGlyphs.end())
+                        }
+                        if (p.thumbnails.find(i) == p.thumbnails.end())
+                        {
+                            if (p.thumbnailFutures.find(i) == p.thumbnailFutures.end())
                             {
-                                if (p.nameGlyphsFutures.find(i.first) == p.nameGlyphsFutures.end())
+                                if (thumbnailSystem && ioSystem && ioSystem->canRead(fileInfo))
                                 {
-                                    const std::string& label = fileInfo.getFileName(Frame::invalid, false);
-                                    const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                    p.nameGlyphsFutures[i.first] = p.fontSystem->getGlyphs(label, fontInfo);
+                                    p.thumbnailFutures[i] = thumbnailSystem->getImage(
+                                        fileInfo,
+                                        p.thumbnailSize,
+                                        AV::Image::Type::None,
+                                        priority);
+                                    p.priorities[i] = priority;
                                 }
                             }
-                            if (p.sizeGlyphs.find(i.first) == p.sizeGlyphs.end())
+                        }
+                        if (p.nameGlyphs.find(i) == p.nameGlyphs.end())
+                        {
+                            if (p.nameGlyphsFutures.find(i) == p.nameGlyphsFutures.end())
                             {
-                                if (p.sizeGlyphsFutures.find(i.first) == p.sizeGlyphsFutures.end())
-                                {
-                                    std::stringstream ss;
-                                    const uint64_t size = fileInfo.getSize();
-                                    ss << Memory::getSizeLabel(size);
-                                    std::stringstream ss2;
-                                    ss2 << Memory::getSizeLabel(size);
-                                    ss << _getText(ss2.str());
-                                    const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                    p.sizeGlyphsFutures[i.first] = p.fontSystem->getGlyphs(ss.str(), fontInfo);
-                                }
+                                const std::string& label = fileInfo.getFileName(Frame::invalid, false);
+                                const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
+                                p.nameGlyphsFutures[i] = p.fontSystem->getGlyphs(label, fontInfo);
                             }
-                            if (p.timeGlyphs.find(i.first) == p.timeGlyphs.end())
+                        }
+                        if (p.sizeGlyphs.find(i) == p.sizeGlyphs.end())
+                        {
+                            if (p.sizeGlyphsFutures.find(i) == p.sizeGlyphsFutures.end())
                             {
-                                if (p.timeGlyphsFutures.find(i.first) == p.timeGlyphsFutures.end())
-                                {
-                                    const std::string& label = Time::getLabel(fileInfo.getTime());
-                                    const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                    p.timeGlyphsFutures[i.first] = p.fontSystem->getGlyphs(label, fontInfo);
-                                }
+                                std::stringstream ss;
+                                const uint64_t size = fileInfo.getSize();
+                                ss << Memory::getSizeLabel(size);
+                                std::stringstream ss2;
+                                ss2 << Memory::getSizeLabel(size);
+                                ss << _getText(ss2.str());
+                                const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
+                                p.sizeGlyphsFutures[i] = p.fontSystem->getGlyphs(ss.str(), fontInfo);
                             }
                         }
-                        else if (auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>())
+                        if (p.timeGlyphs.find(i) == p.timeGlyphs.end())
                         {
+                            if (p.timeGlyphsFutures.find(i) == p.timeGlyphsFutures.end())
                             {
-                                const auto j = p.ioInfoFutures.find(i.first);
-                                if (j != p.ioInfoFutures.end())
+                                const std::string& label = Time::getLabel(fileInfo.getTime());
+                                const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
+                                p.timeGlyphsFutures[i] = p.fontSystem->getGlyphs(label, fontInfo);
+                            }
+                        }
+                    }
+
+                    // Cancel the requests for items that are far from the view.
+                    if (thumbnailSystem)
+                    {
+                        {
+                            auto i = p.ioInfoFutures.begin();
+                            while (i != p.ioInfoFutures.end())
+                            {
+                                if (i->first < nearRange.first || i->first >= nearRange.second)
+                                {
+                                    thumbnailSystem->cancelInfo(i->second.uid);
+                                    i = p.ioInfoFutures.erase(i);
+                                }
+                                else
                                 {
-                                    thumbnailSystem->cancelInfo(j->second.uid);
-                                    p.ioInfoFutures.erase(j);
+                                    ++i;
                                 }
                             }
+                        }
+                        {
+                            auto i = p.thumbnailFutures.begin();
+                            while (i != p.thumbnailFutures.end())
                             {
-                                const auto j = p.thumbnailFutures.find(i.first);
-                                if (j != p.thumbnailFutures.end())
+                                if (i->first < nearRange.first || i->first >= nearRange.second)
+                                {
+                                    thumbnailSystem->cancelImage(i->second.uid);
+                                    i = p.thumbnailFutures.erase(i);
+                                }
+                                else
                                 {
-                                    thumbnailSystem->cancelImage(j->second.uid);
-                                    p.thumbnailFutures.erase(j);
+                                    ++i;
                                 }
                             }
                         }
+                        auto i = p.priorities.begin();
+                        while (i != p.priorities.end())
+                        {
+                            if (i->first < nearRange.first || i->first >= nearRange.second)
+                            {
+                                i = p.priorities.erase(i);
+                            }
+                            else
+                            {
+                                ++i;
+                            }
+                        }
                     }
                 }
             }
@@ -375,208 +482,205 @@ namespace djv
 
                 auto render = _getRender();
                 const auto& ut = _getUpdateTime();
-                auto item = p.items.begin();
-                size_t index = 0;
-                for (; item != p.items.end(); ++item, ++index)
+                const auto range = p.getItemRange(event.getClipRect());
+                for (size_t index = range.first; index < range.second; ++index)
                 {
-                    const auto i = p.itemGeometry.find(index);
-                    if (i != p.itemGeometry.end())
-                    {
-                        BBox2f itemGeometry = i->second;
+                    const auto item = p.items.begin() + index;
+                    const BBox2f geometry = p.getItemGeometry(index);
+                    BBox2f itemGeometry = geometry;
 
-                        if (ViewType::Tiles == p.viewType)
-                        {
-                            render->setFillColor(style->getColor(ColorRole::Shadow));
-                            render->drawShadow(itemGeometry.margin(0, -sh, 0, 0), sh);
-                            itemGeometry = itemGeometry.margin(-sh);
-                            render->setFillColor(style->getColor(ColorRole::BackgroundBellows));
-                            render->drawRect(itemGeometry);
-                        }
+                    if (ViewType::Tiles == p.viewType)
+                    {
+                        render->setFillColor(style->getColor(ColorRole::Shadow));
+                        render->drawShadow(itemGeometry.margin(0, -sh, 0, 0), sh);
+                        itemGeometry = itemGeometry.margin(-sh);
+                        render->setFillColor(style->getColor(ColorRole::BackgroundBellows));
+                        render->drawRect(itemGeometry);
+                    }
 
-                        if (ViewType::List == p.viewType)
-                        {
-                            render->pushClipRect(BBox2f(
-                                itemGeometry.min.x,
-                                itemGeometry.min.y,
-                                itemGeometry.w() * p.split[0],
-                                itemGeometry.h()));
-                        }
-                        float opacity = 0.F;
+                    if (ViewType::List == p.viewType)
+                    {
+                        render->pushClipRect(BBox2f(
+                            itemGeometry.min.x,
+                            itemGeometry.min.y,
+                            itemGeometry.w() * p.split[0],
+                            itemGeometry.h()));
+                    }
+                    float opacity = 0.F;
+                    {
+                        const auto j = p.thumbnails.find(index);
+                        if (j != p.thumbnails.end())
                         {
-                            const auto j = p.thumbnails.find(index);
-                            if (j != p.thumbnails.end())
+                            if (j->second)
                             {
-                                if (j->second)
+                                opacity = 1.F;
+                                const auto k = p.thumbnailTimers.find(index);
+                                if (k != p.thumbnailTimers.end())
                                 {
-                                    opacity = 1.F;
-                                    const auto k = p.thumbnailTimers.find(index);
-                                    if (k != p.thumbnailTimers.end())
-                                    {
-                                        const auto t = std::chrono::duration_cast<std::chrono::milliseconds>(ut - k->second);
-                                        opacity = std::min(t.count() / static_cast<float>(thumbnailFadeTime), 1.F);
-                                    }
-                                    const uint16_t w = j->second->getWidth();
-                                    const uint16_t h = j->second->getHeight();
-                                    glm::vec2 pos(0.F, 0.F);
-                                    switch (p.viewType)
-                                    {
-                                    case ViewType::Tiles:
-                                        pos.x = floor(i->second.min.x + sh + p.thumbnailSize.w / 2.F - w / 2.F);
-                                        pos.y = floor(i->second.min.y + sh + p.thumbnailSize.h - h);
-                                        break;
-                                    case ViewType::List:
-                                        pos.x = floor(i->second.min.x);
-                                        pos.y = floor(i->second.min.y + i->second.h() / 2.F - h / 2.F);
-                                        break;
-                                    default: break;
-                                    }
-                                    render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F, opacity));
-                                    AV::Render2D::ImageOptions options;
-                                    options.alphaBlend = p.alphaBlend;
-                                    auto l = p.ocioConfig.fileColorSpaces.find(j->second->getPluginName());
-                                    if (l != p.ocioConfig.fileColorSpaces.end())
-                                    {
-                                        options.colorSpace.input = l->second;
-                                    }
-                                    else
-                                    {
-                                        l = p.ocioConfig.fileColorSpaces.find(std::string());
-                                        if (l != p.ocioConfig.fileColorSpaces.end())
-                                        {
-                                            options.colorSpace.input = l->second;
-                                        }
-                                    }
-                                    options.colorSpace.output = p.outputColorSpace;
-                                    render->drawImage(j->second, pos, options);
+                                    const auto t = std::chrono::duration_cast<std::chrono::milliseconds>(ut - k->second);
+                                    opacity = std::min(t.count() / static_cast<float>(thumbnailFadeTime), 1.F);
                                 }
-                            }
-                        }
-                        if (opacity < 1.F)
-                        {
-                            const auto j = p.icons.find(item->getType());
-                            if (j != p.icons.end())
-                            {
                                 const uint16_t w = j->second->getWidth();
                                 const uint16_t h = j->second->getHeight();
                                 glm::vec2 pos(0.F, 0.F);
                                 switch (p.viewType)
                                 {
                                 case ViewType::Tiles:
-                                    pos.x = floor(i->second.min.x + sh + p.thumbnailSize.w / 2.F - w / 2.F);
-                                    pos.y = floor(i->second.min.y + sh + p.thumbnailSize.h - h);
+                                    pos.x = floor(geometry.min.x + sh + p.thumbnailSize.w / 2.F - w / 2.F);
+                                    pos.y = floor(geometry.min.y + sh + p.thumbnailSize.h - h);
                                     break;
                                 case ViewType::List:
-                                    pos.x = floor(i->second.min.x);
-                                    pos.y = floor(i->second.min.y + i->second.h() / 2.F - h / 2.F);
+                                    pos.x = floor(geometry.min.x);
+                                    pos.y = floor(geometry.min.y + geometry.h() / 2.F - h / 2.F);
                                     break;
                                 default: break;
                                 }
-                                auto c = style->getColor(ColorRole::Button).convert(AV::Image::Type::RGBA_F32);
-                                c.setF32(1.F - opacity, 3);
-                                render->setFillColor(c);
-                                render->drawFilledImage(j->second, pos);
+                                render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F, opacity));
+                                AV::Render2D::ImageOptions options;
+                                options.alphaBlend = p.alphaBlend;
+                                auto l = p.ocioConfig.fileColorSpaces.find(j->second->getPluginName());
+                                if (l != p.ocioConfig.fileColorSpaces.end())
+                                {
+                                    options.colorSpace.input = l->second;
+                                }
+                                else
+                                {
+                                    l = p.ocioConfig.fileColorSpaces.find(std::string());
+                                    if (l != p.ocioConfig.fileColorSpaces.end())
+                                    {
+                                        options.colorSpace.input = l->second;
+                                    }
+                                }
+                                options.colorSpace.output = p.outputColorSpace;
+                                render->drawImage(j->second, pos, options);
                             }
                         }
+                    }
+                    if (opacity < 1.F)
+                    {
+                        const auto j = p.icons.find(item->getType());
+                        if (j != p.icons.end())
                         {
-                            render->setFillColor(style->getColor(ColorRole::Foreground));
+                            const uint16_t w = j->second->getWidth();
+                            const uint16_t h = j->second->getHeight();
+                            glm::vec2 pos(0.F, 0.F);
                             switch (p.viewType)
                             {
                             case ViewType::Tiles:
-                            {
-                                const auto j = p.names.find(index);
-                                const auto k = p.nameLines.find(index);
-                                if (j != p.names.end() && k != p.nameLines.end())
-                                {
-                                    float x = i->second.min.x + m + sh;
-                                    float y = i->second.max.y - p.nameFontMetrics.lineHeight * std::min(k->second.size(), static_cast<size_t>(2)) - m - sh;
-                                    size_t line = 0;
-                                    for (auto l = k->second.begin(); l != k->second.end() && line < 2; ++l, ++line)
-                                    {
-                                        //! \bug Why the extra subtract by one here?
-                                        render->drawText(
-                                            l->glyphs,
-                                            glm::vec2(
-                                                //floorf(x + p.thumbnailSize.x / 2.F - l->size.x / 2.F),
-                                                floor(x),
-                                                floorf(y + p.nameFontMetrics.ascender - 1.F)));
-                                        y += p.nameFontMetrics.lineHeight;
-                                    }
-                                }
+                                pos.x = floor(geometry.min.x + sh + p.thumbnailSize.w / 2.F - w / 2.F);
+                                pos.y = floor(geometry.min.y + sh + p.thumbnailSize.h - h);
                                 break;
-                            }
                             case ViewType::List:
+                                pos.x = floor(geometry.min.x);
+                                pos.y = floor(geometry.min.y + geometry.h() / 2.F - h / 2.F);
+                                break;
+                            default: break;
+                            }
+                            auto c = style->getColor(ColorRole::Button).convert(AV::Image::Type::RGBA_F32);
+                            c.setF32(1.F - opacity, 3);
+                            render->setFillColor(c);
+                            render->drawFilledImage(j->second, pos);
+                        }
+                    }
+                    {
+                        render->setFillColor(style->getColor(ColorRole::Foreground));
+                        switch (p.viewType)
+                        {
+                        case ViewType::Tiles:
+                        {
+                            const auto j = p.names.find(index);
+                            const auto k = p.nameLines.find(index);
+                            if (j != p.names.end() && k != p.nameLines.end())
                             {
-                                float x = i->second.min.x + p.thumbnailSize.w + s;
-                                float y = i->second.min.y + i->second.h() / 2.F - p.nameFontMetrics.lineHeight / 2.F;
-                                auto j = p.nameGlyphs.find(index);
-                                if (j != p.nameGlyphs.end())
+                                float x = geometry.min.x + m + sh;
+                                float y = geometry.max.y - p.nameFontMetrics.lineHeight * std::min(k->second.size(), static_cast<size_t>(2)) - m - sh;
+                                size_t line = 0;
+                                for (auto l = k->second.begin(); l != k->second.end() && line < 2; ++l, ++line)
                                 {
                                     //! \bug Why the extra subtract by one here?
                                     render->drawText(
-                                        j->second,
+                                        l->glyphs,
                                         glm::vec2(
-                                            floorf(x),
+                                            //floorf(x + p.thumbnailSize.x / 2.F - l->size.x / 2.F),
+                                            floor(x),
                                             floorf(y + p.nameFontMetrics.ascender - 1.F)));
+                                    y += p.nameFontMetrics.lineHeight;
                                 }
+                            }
+                            break;
+                        }
+                        case ViewType::List:
+                        {
+                            float x = geometry.min.x + p.thumbnailSize.w + s;
+                            float y = geometry.min.y + geometry.h() / 2.F - p.nameFontMetrics.lineHeight / 2.F;
+                            auto j = p.nameGlyphs.find(index);
+                            if (j != p.nameGlyphs.end())
+                            {
+                                //! \bug Why the extra subtract by one here?
+                                render->drawText(
+                                    j->second,
+                                    glm::vec2(
+                                        floorf(x),
+                                        floorf(y + p.nameFontMetrics.ascender - 1.F)));
+                            }
 
-                                render->popClipRect();
+                            render->popClipRect();
 
-                                x = i->second.min.x + i->second.w() * p.split[0] + m;
-                                j = p.sizeGlyphs.find(index);
-                                if (j != p.sizeGlyphs.end())
-                                {
-                                    render->pushClipRect(BBox2f(
-                                        itemGeometry.min.x + itemGeometry.w() * p.split[0],
-                                        itemGeometry.min.y,
-                                        itemGeometry.w() * (p.split[1] - p.split[0]),
-                                        itemGeometry.h()));
+                            x = geometry.min.x + geometry.w() * p.split[0] + m;
+                            j = p.sizeGlyphs.find(index);
+                            if (j != p.sizeGlyphs.end())
+                            {
+                                render->pushClipRect(BBox2f(
+                                    itemGeometry.min.x + itemGeometry.w() * p.split[0],
+                                    itemGeometry.min.y,
+                                    itemGeometry.w() * (p.split[1] - p.split[0]),
+                                    itemGeometry.h()));
 
-                                    //! \bug Why the extra subtract by one here?
-                                    render->drawText(
-                                        j->second,
-                                        glm::vec2(
-                                            floorf(x),
-                                            floorf(y + p.nameFontMetrics.ascender - 1.F)));
+                                //! \bug Why the extra subtract by one here?
+                                render->drawText(
+                                    j->second,
+                                    glm::vec2(
+                                        floorf(x),
+                                        floorf(y + p.nameFontMetrics.ascender - 1.F)));
 
-                                    render->popClipRect();
-                                }
+                                render->popClipRect();
+                            }
 
-                                x = i->second.min.x + i->second.w() * p.split[1] + m;
-                                j = p.timeGlyphs.find(index);
-                                if (j != p.timeGlyphs.end())
-                                {
-                                    render->pushClipRect(BBox2f(
-                                        itemGeometry.min.x + itemGeometry.w() * p.split[1],
-                                        itemGeometry.min.y,
-                                        itemGeometry.w() * (p.split[2] - p.split[1]),
-                                        itemGeometry.h()));
+                            x = geometry.min.x + geometry.w() * p.split[1] + m;
+                            j = p.timeGlyphs.find(index);
+                            if (j != p.timeGlyphs.end())
+                            {
+                                render->pushClipRect(BBox2f(
+                                    itemGeometry.min.x + itemGeometry.w() * p.split[1],
+                                    itemGeometry.min.y,
+                                    itemGeometry.w() * (p.split[2] - p.split[1]),
+                                    itemGeometry.h()));
 
-                                    //! \bug Why the extra subtract by one here?
-                                    render->drawText(
-                                        j->second,
-                                        glm::vec2(
-                                            floorf(x),
-                                            floorf(y + p.nameFontMetrics.ascender - 1.F)));
+                                //! \bug Why the extra subtract by one here?
+                                render->drawText(
+                                    j->second,
+                                    glm::vec2(
+                                        floorf(x),
+                                        floorf(y + p.nameFontMetrics.ascender - 1.F)));
 
-                                    render->popClipRect();
-                                }
-                                break;
-                            }
-                            default: break;
+                                render->popClipRect();
                             }
+                            break;
                         }
-
-                        if (p.grab == index)
-                        {
-                            render->setFillColor(style->getColor(ColorRole::Pressed));
-                            render->drawRect(itemGeometry);
-                        }
-                        else if (p.hover == index)
-                        {
-                            render->setFillColor(style->getColor(ColorRole::Hovered));
-                            render->drawRect(itemGeometry);
+                        default: break;
                         }
                     }
+
+                    if (p.grab == index)
+                    {
+                        render->setFillColor(style->getColor(ColorRole::Pressed));
+                        render->drawRect(itemGeometry);
+                    }
+                    else if (p.hover == index)
+                    {
+                        render->setFillColor(style->getColor(ColorRole::Hovered));
+                        render->drawRect(itemGeometry);
+                    }
                 }
             }
 
@@ -585,14 +689,11 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 event.accept();
                 const auto& pointerInfo = event.getPointerInfo();
-                for (const auto& i : p.itemGeometry)
+                const size_t hover = p.getItem(pointerInfo.pos);
+                if (hover != invalid)
                 {
-                    if (i.second.contains(pointerInfo.pos))
-                    {
-                        p.hover = i.first;
-                        _redraw();
-                        break;
-                    }
+                    p.hover = hover;
+                    _redraw();
                 }
             }
 
@@ -627,14 +728,11 @@ namespace djv
                 }
                 else
                 {
-                    for (const auto& i : p.itemGeometry)
+                    const size_t hover = p.getItem(pointerInfo.pos);
+                    if (hover != invalid)
                     {
-                        if (i.second.contains(pointerInfo.pos))
-                        {
-                            p.hover = i.first;
-                            _redraw();
-                            break;
-                        }
+                        p.hover = hover;
+                        _redraw();
                     }
                 }
             }
@@ -645,17 +743,14 @@ namespace djv
                 if (p.pressedId)
                     return;
                 const auto& pointerInfo = event.getPointerInfo();
-                for (const auto& i : p.itemGeometry)
+                const size_t grab = p.getItem(pointerInfo.pos);
+                if (grab != invalid)
                 {
-                    if (i.second.contains(pointerInfo.pos))
-                    {
-                        event.accept();
-                        p.grab = i.first;
-                        p.pressedId = pointerInfo.id;
-                        p.pressedPos = pointerInfo.pos;
-                        _redraw();
-                        break;
-                    }
+                    event.accept();
+                    p.grab = grab;
+                    p.pressedId = pointerInfo.id;
+                    p.pressedPos = pointerInfo.pos;
+                    _redraw();
                 }
             }
 
@@ -672,15 +767,10 @@ namespace djv
                     const auto i = hover.find(pointerInfo.id);
                     if (p.callback && i != hover.end())
                     {
-                        for (const auto& j : p.itemGeometry)
+                        const size_t index = p.getItem(i->second);
+                        if (index != invalid)
                         {
-                            if (j.second.contains(i->second))
-                            {
-                                if (j.first < p.items.size())
-                                {
-                                    p.callback(p.items[j.first]);
-                                }
-                            }
+                            p.callback(p.items[index]);
                         }
                     }
                     _redraw();
@@ -692,24 +782,18 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 std::shared_ptr<ITooltipWidget> out;
                 std::string text;
-                for (const auto& i : p.itemGeometry)
+                const size_t index = p.getItem(pos);
+                if (index != invalid)
                 {
-                    if (i.second.contains(pos))
+                    const auto& fileInfo = p.items[index];
+                    const auto i = p.ioInfo.find(index);
+                    if (i != p.ioInfo.end())
                     {
-                        if (i.first < p.items.size())
-                        {
-                            const auto& fileInfo = p.items[i.first];
-                            const auto j = p.ioInfo.find(i.first);
-                            if (j != p.ioInfo.end())
-                            {
-                                text = _getTooltip(fileInfo, j->second);
-                            }
-                            else
-                            {
-                                text = _getTooltip(fileInfo);
-                            }
-                        }
-                        break;
+                        text = _getTooltip(fileInfo, i->second);
+                    }
+                    else
+                    {
+                        text = _getTooltip(fileInfo);
                     }
                 }
                 if (!text.empty())
@@ -1038,49 +1122,46 @@ namespace djv
                     p.names.clear();
                     p.nameLines.clear();
                     p.nameLinesFutures.clear();
-                    for (const auto& i : p.itemGeometry)
+                    for (const auto& i : p.thumbnailFutures)
                     {
-                        const auto j = p.thumbnailFutures.find(i.first);
-                        if (j != p.thumbnailFutures.end())
-                        {
-                            thumbnailSystem->cancelImage(j->second.uid);
-                            p.thumbnailFutures.erase(j);
-                        }
+                        thumbnailSystem->cancelImage(i.second.uid);
                     }
                     p.thumbnailFutures.clear();
 
-                    const auto& clipRect = getClipRect();
-                    for (const auto& i : p.itemGeometry)
+                    const auto range = p.getItemRange(getClipRect());
+                    for (size_t i = range.first; i < range.second; ++i)
                     {
-                        if (i.first < p.items.size() && i.second.intersects(clipRect))
+                        if (p.thumbnails.find(i) == p.thumbnails.end())
                         {
-                            if (p.thumbnails.find(i.first) == p.thumbnails.end())
+                            const auto& fileInfo = p.items[i];
                             {
-                                const auto& fileInfo = p.items[i.first];
+                                const auto j = p.nameLines.find(i);
+                                if (j == p.nameLines.end())
                                 {
-                                    const auto j = p.nameLines.find(i.first);
-                                    if (j == p.nameLines.end())
+                                    const auto k = p.nameLinesFutures.find(i);
+                                    if (k == p.nameLinesFutures.end())
                                     {
-                                        const auto k = p.nameLinesFutures.find(i.first);
-                                        if (k == p.nameLinesFutures.end())
-                                        {
-                                            const float m = style->getMetric(MetricsRole::MarginSmall);
-                                            const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                            p.names[i.first] = fileInfo.getFileName(Frame::invalid, false);
-                                            p.nameLinesFutures[i.first] = p.fontSystem->textLines(
-                                                p.names[i.first],
-                                                p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
-                                                fontInfo);
-                                        }
+                                        const float m = style->getMetric(MetricsRole::MarginSmall);
+                                        const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
+                                        p.names[i] = fileInfo.getFileName(Frame::invalid, false);
+                                        p.nameLinesFutures[i] = p.fontSystem->textLines(
+                                            p.names[i],
+                                            p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
+                                            fontInfo);
                                     }
                                 }
-                                if (p.thumbnailFutures.find(i.first) == p.thumbnailFutures.end())
+                            }
+                            if (p.thumbnailFutures.find(i) == p.thumbnailFutures.end())
+                            {
+                                auto ioSystem = context->getSystemT<AV::IO::System>();
+                                if (ioSystem && ioSystem->canRead(fileInfo))
                                 {
-                                    auto ioSystem = context->getSystemT<AV::IO::System>();
-                                    if (ioSystem && ioSystem->canRead(fileInfo))
-                                    {
-                                        p.thumbnailFutures[i.first] = thumbnailSystem->getImage(fileInfo, p.thumbnailSize);
-                                    }
+                                    p.thumbnailFutures[i] = thumbnailSystem->getImage(
+                                        fileInfo,
+                                        p.thumbnailSize,
+                                        AV::Image::Type::None,
+                                        AV::ThumbnailSystem::Priority::High);
+                                    p.priorities[i] = AV::ThumbnailSystem::Priority::High;
                                 }
                             }
                         }
@@ -1100,20 +1181,20 @@ namespace djv
                     p.nameLines.clear();
                     p.nameLinesFutures.clear();
                     p.ioInfo.clear();
-                    p.ioInfoFutures.clear();
                     p.thumbnails.clear();
                     auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                    for (const auto& i : p.itemGeometry)
+                    for (const auto& i : p.ioInfoFutures)
                     {
-                        const auto j = p.thumbnailFutures.find(i.first);
-                        if (j != p.thumbnailFutures.end())
-                        {
-                            thumbnailSystem->cancelImage(j->second.uid);
-                            p.thumbnailFutures.erase(j);
-                        }
+                        thumbnailSystem->cancelInfo(i.second.uid);
+                    }
+                    p.ioInfoFutures.clear();
+                    for (const auto& i : p.thumbnailFutures)
+                    {
+                        thumbnailSystem->cancelImage(i.second.uid);
                     }
                     p.thumbnailFutures.clear();
                     p.thumbnailTimers.clear();
+                    p.priorities.clear();
                     p.nameGlyphs.clear();
                     p.nameGlyphsFutures.clear();
                     p.sizeGlyphs.clear();
@@ -86,6 +86,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.shortcuts->setIfChanged(value);
+                _setDirty();
             }
 
             std::shared_ptr<IListSubject<FileSystem::Path> > FileBrowser::observeRecentPaths() const
@@ -97,6 +98,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.recentPaths->setIfChanged(value);
+                _setDirty();
             }
 
             std::shared_ptr<IValueSubject<ViewType> > FileBrowser::observeViewType() const
@@ -108,6 +110,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.viewType->setIfChanged(value);
+                _setDirty();
             }
 
             std::shared_ptr<IValueSubject<AV::Image::Size> > FileBrowser::observeThumbnailSize() const
@@ -119,6 +122,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.thumbnailSize->setIfChanged(value);
+                _setDirty();
             }
 
             std::shared_ptr<IListSubject<float> > FileBrowser::observeListViewHeaderSplit() const
@@ -130,6 +134,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.listViewHeaderSplit->setIfChanged(value);
+                _setDirty();
             }
 
             std::shared_ptr<IValueSubject<bool> > FileBrowser::observeFileSequences() const
@@ -141,6 +146,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.fileSequences->setIfChanged(value);
+                _setDirty();
             }
 
             std::shared_ptr<IValueSubject<bool> > FileBrowser::observeShowHidden() const
@@ -152,6 +158,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.showHidden->setIfChanged(value);
+                _setDirty();
             }
 
             std::shared_ptr<IValueSubject<FileSystem::DirectoryListSort> > FileBrowser::observeSort() const
@@ -163,6 +170,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.sort->setIfChanged(value);
+                _setDirty();
             }
 
             std::shared_ptr<IValueSubject<bool> > FileBrowser::observeReverseSort() const
@@ -174,6 +182,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.reverseSort->setIfChanged(value);
+                _setDirty();
             }
 
             std::shared_ptr<IValueSubject<bool> > FileBrowser::observeSortDirectoriesFirst() const
@@ -185,6 +194,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.sortDirectoriesFirst->setIfChanged(value);
+                _setDirty();
             }
 
             void FileBrowser::load(const picojson::value & value)
@@ -4,6 +4,8 @@
 
 #include <djvUIComponents/IOSettings.h>
 
+#include <djvAV/IO.h>
+
 #include <djvCore/Context.h>
 
 // These need to be included last on OSX.
@@ -30,7 +32,8 @@ namespace djv
                 ISettings::_init("djv::UI::Settings::IO", context);
                 
                 DJV_PRIVATE_PTR();
-                p.threadCount = ValueSubject<size_t>::create(4);
+                auto io = context->getSystemT<AV::IO::System>();
+                p.threadCount = ValueSubject<size_t>::create(io->getThreadCount());
 
                 _load();
             }
@@ -58,6 +61,7 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.threadCount->setIfChanged(value);
+                _setDirty();
             }
 
             void IO::load(const picojson::value & value)
@@ -8,10 +8,14 @@
 
 #include <djvUI/FormLayout.h>
 #include <djvUI/IntSlider.h>
+#include <djvUI/Label.h>
 #include <djvUI/SettingsSystem.h>
 
+#include <djvAV/IO.h>
+
 #include <djvCore/Context.h>
 #include <djvCore/NumericValueModels.h>
+#include <djvCore/String.h>
 
 using namespace djv::Core;
 
@@ -21,9 +25,12 @@ namespace djv
     {
         struct IOThreadsSettingsWidget::Private
         {
+            std::map<std::string, AV::IO::ThreadSplit> threadSplits;
             std::shared_ptr<IntSlider> threadCountSlider;
+            std::shared_ptr<Label> threadSplitLabel;
             std::shared_ptr<FormLayout> layout;
             std::shared_ptr<ValueObserver<size_t> > threadCountObserver;
+            std::shared_ptr<MapObserver<std::string, AV::IO::ThreadSplit> > threadSplitsObserver;
         };
 
         void IOThreadsSettingsWidget::_init(const std::shared_ptr<Context>& context)
@@ -36,8 +43,12 @@ namespace djv
             p.threadCountSlider = IntSlider::create(context);
             p.threadCountSlider->setRange(IntRange(2, 64));
 
+            p.threadSplitLabel = Label::create(context);
+            p.threadSplitLabel->setTextHAlign(TextHAlign::Left);
+
             p.layout = FormLayout::create(context);
             p.layout->addChild(p.threadCountSlider);
+            p.layout->addChild(p.threadSplitLabel);
             addChild(p.layout);
 
             auto weak = std::weak_ptr<IOThreadsSettingsWidget>(std::dynamic_pointer_cast<IOThreadsSettingsWidget>(shared_from_this()));
@@ -71,6 +82,18 @@ namespace djv
                         }
                     });
             }
+
+            auto io = context->getSystemT<AV::IO::System>();
+            p.threadSplitsObserver = MapObserver<std::string, AV::IO::ThreadSplit>::create(
+                io->observeThreadSplits(),
+                [weak](const std::map<std::string, AV::IO::ThreadSplit>& value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->threadSplits = value;
+                        widget->_widgetUpdate();
+                    }
+                });
         }
 
         IOThreadsSettingsWidget::IOThreadsSettingsWidget() :
@@ -109,6 +132,20 @@ namespace djv
             ISettingsWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             p.layout->setText(p.threadCountSlider, _getText(DJV_TEXT("settings_io_thread_count")) + ":");
+            p.layout->setText(p.threadSplitLabel, _getText(DJV_TEXT("settings_io_thread_split")) + ":");
+        }
+
+        void IOThreadsSettingsWidget::_widgetUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<std::string> splits;
+            for (const auto& i : p.threadSplits)
+            {
+                std::stringstream ss;
+                ss << i.first << " " << i.second.frameThreads << "x" << i.second.decodeThreads;
+                splits.push_back(ss.str());
+            }
+            p.threadSplitLabel->setText(String::join(splits, ", "));
         }
 
     } // namespace UI
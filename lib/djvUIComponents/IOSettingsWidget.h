@@ -32,6 +32,8 @@ namespace djv
             void _initEvent(Core::Event::Init &) override;
 
         private:
+            void _widgetUpdate();
+
             DJV_PRIVATE();
         };
 
@@ -37,7 +37,7 @@ namespace djv
             setClassName("djv::UI::OpenEXRSettingsWidget");
 
             p.threadCountSlider = IntSlider::create(context);
-            p.threadCountSlider->setRange(IntRange(1, 16));
+            p.threadCountSlider->setRange(IntRange(0, 16));
 
             p.channelsComboBox = ComboBox::create(context);
             
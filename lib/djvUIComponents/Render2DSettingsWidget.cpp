@@ -144,8 +144,10 @@ namespace djv
         struct Render2DTextSettingsWidget::Private
         {
             std::shared_ptr<UI::CheckBox> lcdCheckBox;
+            std::shared_ptr<UI::CheckBox> sdfCheckBox;
             std::shared_ptr<UI::VerticalLayout> layout;
             std::shared_ptr<ValueObserver<bool> > lcdTextObserver;
+            std::shared_ptr<ValueObserver<bool> > sdfTextObserver;
         };
 
         void Render2DTextSettingsWidget::_init(const std::shared_ptr<Context>& context)
@@ -156,9 +158,11 @@ namespace djv
             setClassName("djv::UI::Render2DTextSettingsWidget");
 
             p.lcdCheckBox = UI::CheckBox::create(context);
+            p.sdfCheckBox = UI::CheckBox::create(context);
 
             p.layout = UI::VerticalLayout::create(context);
             p.layout->addChild(p.lcdCheckBox);
+            p.layout->addChild(p.sdfCheckBox);
             addChild(p.layout);
 
             auto contextWeak = std::weak_ptr<Context>(context);
@@ -171,6 +175,15 @@ namespace djv
                         render2D->setLCDText(value);
                     }
                 });
+            p.sdfCheckBox->setCheckedCallback(
+                [contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto avSystem = context->getSystemT<AV::AVSystem>();
+                        avSystem->setSDFText(value);
+                    }
+                });
 
             auto avSystem = context->getSystemT<AV::AVSystem>();
             auto weak = std::weak_ptr<Render2DTextSettingsWidget>(std::dynamic_pointer_cast<Render2DTextSettingsWidget>(shared_from_this()));
@@ -183,6 +196,15 @@ namespace djv
                         widget->_p->lcdCheckBox->setChecked(value);
                     }
                 });
+            p.sdfTextObserver = ValueObserver<bool>::create(
+                avSystem->observeSDFText(),
+                [weak](bool value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->sdfCheckBox->setChecked(value);
+                    }
+                });
         }
 
         Render2DTextSettingsWidget::Render2DTextSettingsWidget() :
@@ -216,6 +238,7 @@ namespace djv
             ISettingsWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             p.lcdCheckBox->setText(_getText(DJV_TEXT("settings_render_2d_text_lcd_rendering")));
+            p.sdfCheckBox->setText(_getText(DJV_TEXT("settings_render_2d_text_sdf_rendering")));
         }
 
     } // namespace UI
@@ -4,6 +4,7 @@
 
 #include <djvUIComponents/SceneWidget.h>
 
+#include <djvScene/BVH.h>
 #include <djvScene/Camera.h>
 #include <djvScene/Render.h>
 #include <djvScene/Scene.h>
@@ -47,6 +48,7 @@ namespace djv
             std::shared_ptr<AV::Render3D::Render> render3D;
             AV::Image::Size size;
             std::shared_ptr<Scene::Scene> scene;
+            std::shared_ptr<Scene::BVH> bvh;
             std::shared_ptr<ValueSubject<SceneRotate> > sceneRotate;
             std::shared_ptr<Scene::PolarCamera> camera;
             std::shared_ptr<ValueSubject<Scene::PolarCameraData> > cameraData;
@@ -57,6 +59,7 @@ namespace djv
             Event::PointerID pressedID = Event::invalidID;
             std::map<int, bool> buttons;
             glm::vec2 pointerPos = glm::vec2(0.F, 0.F);
+            bool pointerMoved = false;
             std::shared_ptr<ValueSubject<BBox3f> > bbox;
             std::shared_ptr<ValueSubject<size_t> > primitivesCount;
             std::shared_ptr<ValueSubject<size_t> > pointCount;
@@ -120,6 +123,7 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             p.scene = value;
+            p.bvh.reset();
             p.render->setScene(p.scene);
             _sceneUpdate();
         }
@@ -194,6 +198,34 @@ namespace djv
             }
         }
 
+        bool SceneWidget::pick(const glm::vec2& pos, Scene::BVHHit& hit)
+        {
+            DJV_PRIVATE_PTR();
+            bool out = false;
+            const BBox2f& g = getGeometry();
+            if (p.scene && g.isValid())
+            {
+                if (!p.bvh)
+                {
+                    p.bvh = Scene::BVH::create(p.scene);
+                }
+                const glm::vec4 viewport(g.min.x, g.min.y, g.w(), g.h());
+                const glm::vec3 win(pos.x, g.min.y + g.max.y - pos.y, 0.F);
+                const glm::vec3 nearPos = glm::unProject(win, p.camera->getV(), p.camera->getP(), viewport);
+                const glm::vec3 farPos = glm::unProject(
+                    glm::vec3(win.x, win.y, 1.F),
+                    p.camera->getV(),
+                    p.camera->getP(),
+                    viewport);
+                const glm::vec3 dir = farPos - nearPos;
+                if (glm::length(dir) > 0.F)
+                {
+                    out = p.bvh->intersect(AV::Geom::Ray(nearPos, glm::normalize(dir)), hit);
+                }
+            }
+            return out;
+        }
+
         std::shared_ptr<Core::IValueSubject<BBox3f> > SceneWidget::observeBBox() const
         {
             return _p->bbox;
@@ -268,6 +300,7 @@ namespace djv
                     setCameraData(cameraData);
                 }
                 p.pointerPos = pointerInfo.projectedPos;
+                p.pointerMoved = true;
                 _redraw();
             }
         }
@@ -282,6 +315,7 @@ namespace djv
             p.pressedID = pointerInfo.id;
             p.buttons = pointerInfo.buttons;
             p.pointerPos = pointerInfo.projectedPos;
+            p.pointerMoved = false;
         }
 
         void SceneWidget::_buttonReleaseEvent(Event::ButtonRelease & event)
@@ -291,6 +325,17 @@ namespace djv
             if (pointerInfo.id == p.pressedID)
             {
                 event.accept();
+                if (!p.pointerMoved && p.buttons.find(1) != p.buttons.end())
+                {
+                    Scene::BVHHit hit;
+                    if (pick(pointerInfo.projectedPos, hit))
+                    {
+                        auto cameraData = p.cameraData->get();
+                        cameraData.target = hit.hit.pos;
+                        setCameraData(cameraData);
+                        _redraw();
+                    }
+                }
                 p.pressedID = Event::invalidID;
                 p.buttons.clear();
             }
@@ -391,6 +436,7 @@ namespace djv
                 }
                 p.scene->setSceneXForm(m);
                 p.scene->bboxUpdate();
+                p.bvh.reset();
                 p.render->setScene(p.scene);
                 const float max = p.scene->getBBoxMax();
                 auto cameraData = p.cameraData->get();
@@ -19,6 +19,7 @@ namespace djv
     namespace Scene
     {
         class Scene;
+        struct BVHHit;
 
     } // namespace Scene
 
@@ -52,6 +53,9 @@ namespace djv
         };
 
         //! This class provides a scene view widget.
+        //!
+        //! Clicking on the scene without dragging moves the camera target to
+        //! the point that was clicked.
         class SceneWidget : public Widget
         {
             DJV_NON_COPYABLE(SceneWidget);
@@ -79,6 +83,12 @@ namespace djv
 
             void frameView();
 
+            //! Find the nearest part of the scene under the given position,
+            //! in window coordinates. The bounding volume hierarchy used for
+            //! picking is built the first time it is needed after the scene
+            //! changes.
+            bool pick(const glm::vec2&, Scene::BVHHit&);
+
             std::shared_ptr<Core::IValueSubject<Core::BBox3f> > observeBBox() const;
             std::shared_ptr<Core::IValueSubject<size_t> > observePrimitivesCount() const;
             std::shared_ptr<Core::IValueSubject<size_t> > observePointCount() const;
@@ -41,6 +41,7 @@ namespace djv
         {
             auto out = std::shared_ptr<UIComponentsSystem>(new UIComponentsSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
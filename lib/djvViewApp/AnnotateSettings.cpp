@@ -47,6 +47,7 @@ namespace djv
         void AnnotateSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _setDirty();
         }
 
         void AnnotateSettings::load(const picojson::value & value)
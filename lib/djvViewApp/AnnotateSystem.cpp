@@ -168,6 +168,7 @@ namespace djv
         {
             auto out = std::shared_ptr<AnnotateSystem>(new AnnotateSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
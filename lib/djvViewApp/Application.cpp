@@ -129,6 +129,8 @@ namespace djv
             auto textSystem = getSystemT<Core::TextSystem>();
             CmdLineLocale cmdLineLocale(textSystem);
             _parseCmdLine(args);
+
+            _setStartupEnd();
         }
 
         Application::Application() :
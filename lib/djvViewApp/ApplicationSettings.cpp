@@ -49,6 +49,7 @@ namespace djv
         void ApplicationSettings::setSettingsBellows(const std::map<std::string, bool>& value)
         {
             _p->settingsBellows->setIfChanged(value);
+            _setDirty();
         }
 
         void ApplicationSettings::load(const picojson::value & value)
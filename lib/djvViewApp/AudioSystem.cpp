@@ -172,6 +172,7 @@ namespace djv
         {
             auto out = std::shared_ptr<AudioSystem>(new AudioSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
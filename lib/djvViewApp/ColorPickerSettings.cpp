@@ -52,6 +52,7 @@ namespace djv
         void ColorPickerSettings::setSampleSize(size_t value)
         {
             _p->sampleSize = value;
+            _setDirty();
         }
 
         AV::Image::Type ColorPickerSettings::getLockType() const
@@ -62,6 +63,7 @@ namespace djv
         void ColorPickerSettings::setLockType(AV::Image::Type value)
         {
             _p->lockType = value;
+            _setDirty();
         }
 
         bool ColorPickerSettings::getApplyColorOperations() const
@@ -72,6 +74,7 @@ namespace djv
         void ColorPickerSettings::setApplyColorOperations(bool value)
         {
             _p->applyColorOperations = value;
+            _setDirty();
         }
 
         bool ColorPickerSettings::getApplyColorSpace() const
@@ -82,6 +85,7 @@ namespace djv
         void ColorPickerSettings::setApplyColorSpace(bool value)
         {
             _p->applyColorSpace = value;
+            _setDirty();
         }
 
         const glm::vec2& ColorPickerSettings::getPickerPos() const
@@ -92,6 +96,7 @@ namespace djv
         void ColorPickerSettings::setPickerPos(const glm::vec2& value)
         {
             _p->pickerPos = value;
+            _setDirty();
         }
 
         const std::map<std::string, BBox2f>& ColorPickerSettings::getWidgetGeom() const
@@ -102,6 +107,7 @@ namespace djv
         void ColorPickerSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _setDirty();
         }
 
         void ColorPickerSettings::load(const picojson::value & value)
@@ -26,18 +26,9 @@
 
 #include <djvAV/OCIOSystem.h>
 #include <djvAV/ImageUtil.h>
-#include <djvAV/OpenGLOffscreenBuffer.h>
-#include <djvAV/Render2D.h>
-#if defined(DJV_OPENGL_ES2)
-#include <djvAV/OpenGLMesh.h>
-#include <djvAV/OpenGLShader.h>
-#include <djvAV/Shader.h>
-#endif // DJV_OPENGL_ES2
+#include <djvAV/Render2DImageProcessor.h>
 
 #include <djvCore/Context.h>
-#if defined(DJV_OPENGL_ES2)
-#include <djvCore/ResourceSystem.h>
-#endif // DJV_OPENGL_ES2
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_transform_2d.hpp>
@@ -54,9 +45,6 @@ namespace djv
         {
             //! \todo Should this be configurable?
             const size_t sampleSizeMax = 100;
-
-            //! \todo What is this really?
-            const size_t bufferSizeMin = 100;
         
         } // namespace
 
@@ -91,10 +79,7 @@ namespace djv
             std::shared_ptr<UI::FormLayout> formLayout;
             std::shared_ptr<UI::VerticalLayout> layout;
 
-            std::shared_ptr<AV::OpenGL::OffscreenBuffer> offscreenBuffer;
-#if defined(DJV_OPENGL_ES2)
-            std::shared_ptr<AV::OpenGL::Shader> shader;
-#endif // DJV_OPENGL_ES2
+            std::shared_ptr<AV::Render2D::ImageProcessor> imageProcessor;
 
             std::map<std::string, std::shared_ptr<ValueObserver<bool> > > actionObservers;
             std::shared_ptr<ValueObserver<std::shared_ptr<MediaWidget> > > activeWidgetObserver;
@@ -172,14 +157,6 @@ namespace djv
             p.layout->addChild(hLayout);
             addChild(p.layout);
 
-#if defined(DJV_OPENGL_ES2)
-            auto resourceSystem = context->getSystemT<ResourceSystem>();
-            const Core::FileSystem::Path shaderPath = resourceSystem->getPath(Core::FileSystem::ResourcePath::Shaders);
-            p.shader = AV::OpenGL::Shader::create(AV::Render::Shader::create(
-                Core::FileSystem::Path(shaderPath, "djvAVRender2DVertex.glsl"),
-                Core::FileSystem::Path(shaderPath, "djvAVRender2DFragment.glsl")));
-#endif // DJV_OPENGL_ES2
-
             _sampleUpdate();
             _widgetUpdate();
 
@@ -531,27 +508,15 @@ namespace djv
                         p.imageAspectRatio);
                     pixelPos = glm::inverse(glm::translate(m, glm::vec2(-.5F, -.5F))) * pixelPos;
 
-                    const size_t sampleSize = std::max(p.sampleSize, bufferSizeMin);
-                    const AV::Image::Size size(sampleSize, sampleSize);
+                    // Find the region of the image under the picker.
+                    const glm::mat3x3 mInverse = glm::inverse(m);
+                    const glm::vec3 pt0 = mInverse * glm::vec3(0.F, 0.F, 1.F);
+                    const glm::vec3 pt1 = mInverse * glm::vec3(p.sampleSize, p.sampleSize, 1.F);
+                    const BBox2i roi(
+                        glm::ivec2(floorf(std::min(pt0.x, pt1.x)), floorf(std::min(pt0.y, pt1.y))),
+                        glm::ivec2(ceilf(std::max(pt0.x, pt1.x)) - 1, ceilf(std::max(pt0.y, pt1.y)) - 1));
                     const AV::Image::Type type = p.lockType != AV::Image::Type::None ? p.lockType : p.image->getType();
-                    
-                    bool create = !p.offscreenBuffer;
-                    create |= p.offscreenBuffer && size != p.offscreenBuffer->getSize();
-                    create |= p.offscreenBuffer && type != p.offscreenBuffer->getColorType();
-                    if (create)
-                    {
-                        p.offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(size, type);
-                    }
 
-                    p.offscreenBuffer->bind();
-                    const auto& render = _getRender();
-                    const auto imageFilterOptions = render->getImageFilterOptions();
-                    render->setImageFilterOptions(AV::Render2D::ImageFilterOptions(AV::Render2D::ImageFilter::Nearest));
-                    render->beginFrame(size);
-                    render->setFillColor(AV::Image::Color(0.F, 0.F, 0.F));
-                    render->drawRect(BBox2f(0.F, 0.F, sampleSize, sampleSize));
-                    render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F));
-                    render->pushTransform(m);
                     auto options = p.imageOptions;
                     if (!p.applyColorOperations)
                     {
@@ -577,26 +542,15 @@ namespace djv
                         }
                         options.colorSpace.output = p.outputColorSpace;
                     }
-                    options.cache = AV::Render2D::ImageCache::Dynamic;
-                    render->drawImage(p.image, glm::vec2(0.F, 0.F), options);
-                    render->popTransform();
-                    render->endFrame();
-                    render->setImageFilterOptions(imageFilterOptions);
-                    auto data = AV::Image::Data::create(AV::Image::Info(p.sampleSize, p.sampleSize, type));
-                    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-#if !defined(DJV_OPENGL_ES2)  // \todo GL_READ_FRAMEBUFFER, glClampColor not in OpenGL ES 2
-                    glBindFramebuffer(GL_READ_FRAMEBUFFER, p.offscreenBuffer->getID());
-                    glClampColor(GL_CLAMP_READ_COLOR, GL_FALSE);
-#endif
-                    glPixelStorei(GL_PACK_ALIGNMENT, 1);
-                    glReadPixels(
-                        0,
-                        static_cast<int>(sampleSize) - static_cast<int>(data->getHeight()),
-                        data->getWidth(),
-                        data->getHeight(),
-                        AV::Image::getGLFormat(type),
-                        AV::Image::getGLType(type),
-                        data->getData());
+                    if (!p.imageProcessor)
+                    {
+                        p.imageProcessor = AV::Render2D::ImageProcessor::create(options);
+                    }
+                    else
+                    {
+                        p.imageProcessor->setOptions(options);
+                    }
+                    const auto data = p.imageProcessor->process(*p.image, roi, type);
                     p.color = AV::Image::getAverageColor(data);
                 }
                 catch (const std::exception& e)
@@ -607,9 +561,9 @@ namespace djv
                     _log(String::join(messages, ' '), LogLevel::Error);
                 }
             }
-            else if (p.offscreenBuffer)
+            else if (p.imageProcessor)
             {
-                p.offscreenBuffer.reset();
+                p.imageProcessor.reset();
             }
             switch (p.imageRotate)
             {
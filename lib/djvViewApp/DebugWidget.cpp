@@ -130,6 +130,9 @@ namespace djv
                 _labels["GlyphCacheValue"] = UI::Label::create(context);
                 _labels["GlyphCacheValue"]->setFont(AV::Font::familyMono);
                 _thermometerWidgets["GlyphCache"] = UI::ThermometerWidget::create(context);
+                _labels["TextRunCache"] = UI::Label::create(context);
+                _labels["TextRunCacheValue"] = UI::Label::create(context);
+                _labels["TextRunCacheValue"]->setFont(AV::Font::familyMono);
 
                 _labels["ThumbnailInfoCache"] = UI::Label::create(context);
                 _labels["ThumbnailInfoCacheValue"] = UI::Label::create(context);
@@ -141,11 +144,19 @@ namespace djv
                 _labels["ThumbnailInfoCacheValue"]->setFont(AV::Font::familyMono);
                 _thermometerWidgets["ThumbnailImageCache"] = UI::ThermometerWidget::create(context);
 
+                _labels["ThumbnailQueue"] = UI::Label::create(context);
+                _labels["ThumbnailQueueValue"] = UI::Label::create(context);
+                _labels["ThumbnailQueueValue"]->setFont(AV::Font::familyMono);
+
                 _labels["IconCache"] = UI::Label::create(context);
                 _labels["IconCacheValue"] = UI::Label::create(context);
                 _labels["IconCacheValue"]->setFont(AV::Font::familyMono);
                 _thermometerWidgets["IconCache"] = UI::ThermometerWidget::create(context);
 
+                _labels["IOThreads"] = UI::Label::create(context);
+                _labels["IOThreadsValue"] = UI::Label::create(context);
+                _labels["IOThreadsValue"]->setFont(AV::Font::familyMono);
+
                 for (auto& i : _labels)
                 {
                     i.second->setTextHAlign(UI::TextHAlign::Left);
@@ -188,6 +199,10 @@ namespace djv
                 _layout->addChild(hLayout);
                 _layout->addChild(_thermometerWidgets["GlyphCache"]);
                 hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["TextRunCache"]);
+                hLayout->addChild(_labels["TextRunCacheValue"]);
+                _layout->addChild(hLayout);
+                hLayout = UI::HorizontalLayout::create(context);
                 hLayout->addChild(_labels["ThumbnailInfoCache"]);
                 hLayout->addChild(_labels["ThumbnailInfoCacheValue"]);
                 _layout->addChild(hLayout);
@@ -198,10 +213,18 @@ namespace djv
                 _layout->addChild(hLayout);
                 _layout->addChild(_thermometerWidgets["ThumbnailImageCache"]);
                 hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["ThumbnailQueue"]);
+                hLayout->addChild(_labels["ThumbnailQueueValue"]);
+                _layout->addChild(hLayout);
+                hLayout = UI::HorizontalLayout::create(context);
                 hLayout->addChild(_labels["IconCache"]);
                 hLayout->addChild(_labels["IconCacheValue"]);
                 _layout->addChild(hLayout);
                 _layout->addChild(_thermometerWidgets["IconCache"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["IOThreads"]);
+                hLayout->addChild(_labels["IOThreadsValue"]);
+                _layout->addChild(hLayout);
                 addChild(_layout);
 
                 _timer = Time::Timer::create(context);
@@ -252,11 +275,16 @@ namespace djv
                     auto eventSystem = context->getSystemT<UI::EventSystem>();
                     auto fontSystem = context->getSystemT<AV::Font::System>();
                     const float glyphCachePercentage = fontSystem->getGlyphCachePercentage();
+                    const float textRunCachePercentage = fontSystem->getTextRunCachePercentage();
+                    const float textRunCacheHitRate = fontSystem->getTextRunCacheHitRate();
                     auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
                     const float thumbnailInfoCachePercentage = thumbnailSystem->getInfoCachePercentage();
                     const float thumbnailImageCachePercentage = thumbnailSystem->getImageCachePercentage();
+                    const auto thumbnailStats = thumbnailSystem->getStats();
                     auto iconSystem = context->getSystemT<UI::IconSystem>();
                     const float iconCachePercentage = iconSystem->getCachePercentage();
+                    auto io = context->getSystemT<AV::IO::System>();
+                    const auto threadSplits = io->observeThreadSplits()->get();
 
                     _lineGraphs["FPS"]->addSample(fps);
                     _lineGraphs["TotalSystemTime"]->addSample(totalSystemTime.count());
@@ -362,6 +390,17 @@ namespace djv
                         ss << std::fixed << glyphCachePercentage << "%";
                         _labels["GlyphCacheValue"]->setText(ss.str());
                     }
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_general_font_system_text_run_cache")) << ":";
+                        _labels["TextRunCache"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss.precision(2);
+                        ss << std::fixed << textRunCachePercentage << "%/" << textRunCacheHitRate << "%";
+                        _labels["TextRunCacheValue"]->setText(ss.str());
+                    }
                     {
                         std::stringstream ss;
                         ss << _getText(DJV_TEXT("debug_general_thumbnail_system_information_cache")) << ":";
@@ -384,6 +423,19 @@ namespace djv
                         ss << std::fixed << thumbnailImageCachePercentage << "%";
                         _labels["ThumbnailImageCacheValue"]->setText(ss.str());
                     }
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_general_thumbnail_system_queue")) << ":";
+                        _labels["ThumbnailQueue"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << thumbnailStats.infoQueue << "/" << thumbnailStats.imageQueue << "/" << thumbnailStats.working;
+                        ss << ", " << static_cast<int>(thumbnailStats.latency50 * 1000.F);
+                        ss << "/" << static_cast<int>(thumbnailStats.latency90 * 1000.F);
+                        ss << "/" << static_cast<int>(thumbnailStats.latency99 * 1000.F) << "ms";
+                        _labels["ThumbnailQueueValue"]->setText(ss.str());
+                    }
                     {
                         std::stringstream ss;
                         ss << _getText(DJV_TEXT("debug_general_icon_system_cache")) << ":";
@@ -395,6 +447,25 @@ namespace djv
                         ss << std::fixed << iconCachePercentage << "%";
                         _labels["IconCacheValue"]->setText(ss.str());
                     }
+                    {
+                        std::stringstream ss;
+                        ss << _getText(DJV_TEXT("debug_general_io_threads")) << ":";
+                        _labels["IOThreads"]->setText(ss.str());
+                    }
+                    {
+                        std::stringstream ss;
+                        ss << io->getThreadCount();
+                        for (const auto& i : threadSplits)
+                        {
+                            ss << ", " << i.first << " " << i.second.frameThreads << "x" << i.second.decodeThreads;
+                            if (i.second.throughput > 0.F)
+                            {
+                                ss.precision(1);
+                                ss << " (" << std::fixed << i.second.throughput << "/s)";
+                            }
+                        }
+                        _labels["IOThreadsValue"]->setText(ss.str());
+                    }
                 }
             }
 
@@ -554,6 +625,7 @@ namespace djv
                 size_t _videoQueueCount = 0;
                 size_t _audioQueueMax = 0;
                 size_t _audioQueueCount = 0;
+                Core::FileSystem::ReadAheadStats _readAheadStats;
                 std::map<std::string, std::shared_ptr<UI::Label> > _labels;
                 std::map<std::string, std::shared_ptr<UI::LineGraphWidget> > _lineGraphs;
                 std::shared_ptr<UI::VerticalLayout> _layout;
@@ -564,6 +636,7 @@ namespace djv
                 std::shared_ptr<ValueObserver<size_t> > _videoQueueCountObserver;
                 std::shared_ptr<ValueObserver<size_t> > _audioQueueMaxObserver;
                 std::shared_ptr<ValueObserver<size_t> > _audioQueueCountObserver;
+                std::shared_ptr<ValueObserver<Core::FileSystem::ReadAheadStats> > _readAheadStatsObserver;
             };
 
             void MediaDebugWidget::_init(const std::shared_ptr<Context>& context)
@@ -584,6 +657,12 @@ namespace djv
                 _lineGraphs["AudioQueue"] = UI::LineGraphWidget::create(context);
                 _lineGraphs["AudioQueue"]->setPrecision(0);
 
+                _labels["ReadAhead"] = UI::Label::create(context);
+                _labels["ReadAheadValue"] = UI::Label::create(context);
+                _labels["ReadAheadValue"]->setFont(AV::Font::familyMono);
+                _lineGraphs["ReadAhead"] = UI::LineGraphWidget::create(context);
+                _lineGraphs["ReadAhead"]->setPrecision(2);
+
                 for (auto& i : _labels)
                 {
                     i.second->setTextHAlign(UI::TextHAlign::Left);
@@ -599,6 +678,11 @@ namespace djv
                 _layout->addChild(_lineGraphs["VideoQueue"]);
                 _layout->addChild(_labels["AudioQueue"]);
                 _layout->addChild(_lineGraphs["AudioQueue"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["ReadAhead"]);
+                hLayout->addChild(_labels["ReadAheadValue"]);
+                _layout->addChild(hLayout);
+                _layout->addChild(_lineGraphs["ReadAhead"]);
                 addChild(_layout);
 
                 auto weak = std::weak_ptr<MediaDebugWidget>(std::dynamic_pointer_cast<MediaDebugWidget>(shared_from_this()));
@@ -679,6 +763,17 @@ namespace djv
                                         widget->_widgetUpdate();
                                     }
                                 });
+                                widget->_readAheadStatsObserver = ValueObserver<Core::FileSystem::ReadAheadStats>::create(
+                                    value->observeReadAheadStats(),
+                                    [weak](const Core::FileSystem::ReadAheadStats& value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_readAheadStats = value;
+                                        widget->_lineGraphs["ReadAhead"]->addSample(value.mbPerSecond);
+                                        widget->_widgetUpdate();
+                                    }
+                                });
                             }
                             else
                             {
@@ -688,12 +783,14 @@ namespace djv
                                 widget->_videoQueueCount = 0;
                                 widget->_audioQueueMax = 0;
                                 widget->_audioQueueCount = 0;
+                                widget->_readAheadStats = Core::FileSystem::ReadAheadStats();
                                 widget->_sequenceObserver.reset();
                                 widget->_currentFrameObserver.reset();
                                 widget->_videoQueueMaxObserver.reset();
                                 widget->_videoQueueCountObserver.reset();
                                 widget->_audioQueueMaxObserver.reset();
                                 widget->_audioQueueCountObserver.reset();
+                                widget->_readAheadStatsObserver.reset();
                                 widget->_widgetUpdate();
                             }
                         }
@@ -749,6 +846,20 @@ namespace djv
                     ss << _currentFrame << " / " << _sequence.getSize();
                     _labels["CurrentFrameValue"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("debug_media_read_ahead")) << ":";
+                    _labels["ReadAhead"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    std::stringstream ss2;
+                    ss2 << _readAheadStats.backend;
+                    ss << _getText(ss2.str()) << " ";
+                    ss << _readAheadStats.inFlight << "/" << _readAheadStats.queueDepth << " ";
+                    ss << _readAheadStats.hits << "/" << (_readAheadStats.hits + _readAheadStats.misses);
+                    _labels["ReadAheadValue"]->setText(ss.str());
+                }
             }
 
         } // namespace
@@ -27,6 +27,7 @@ namespace djv
             std::shared_ptr<ValueSubject<bool> > autoDetectSequences;
             std::shared_ptr<ValueSubject<bool> > cacheEnabled;
             std::shared_ptr<ValueSubject<int> > cacheMaxGB;
+            std::shared_ptr<ValueSubject<int> > proxyCacheMaxMB;
             std::map<std::string, BBox2f> widgetGeom;
         };
 
@@ -40,6 +41,7 @@ namespace djv
             p.autoDetectSequences = ValueSubject<bool>::create(true);
             p.cacheEnabled = ValueSubject<bool>::create(true);
             p.cacheMaxGB = ValueSubject<int>::create(4);
+            p.proxyCacheMaxMB = ValueSubject<int>::create(256);
             _load();
         }
 
@@ -65,6 +67,7 @@ namespace djv
         void FileSettings::setOpenMax(size_t value)
         {
             _p->openMax->setIfChanged(value);
+            _setDirty();
         }
         
         std::shared_ptr<IListSubject<Core::FileSystem::FileInfo> > FileSettings::observeRecentFiles() const
@@ -86,6 +89,7 @@ namespace djv
                 files.push_back(value[i]);
             }
             p.recentFiles->setIfChanged(files);
+            _setDirty();
         }
 
         void FileSettings::setRecentFilesMax(size_t value)
@@ -99,6 +103,7 @@ namespace djv
                 filesMax.push_back(files[i]);
             }
             setRecentFiles(filesMax);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<bool> > FileSettings::observeAutoDetectSequences() const
@@ -109,6 +114,7 @@ namespace djv
         void FileSettings::setAutoDetectSequences(bool value)
         {
             _p->autoDetectSequences->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<bool> > FileSettings::observeCacheEnabled() const
@@ -124,11 +130,24 @@ namespace djv
         void FileSettings::setCacheEnabled(bool value)
         {
             _p->cacheEnabled->setIfChanged(value);
+            _setDirty();
         }
 
         void FileSettings::setCacheMaxGB(int value)
         {
             _p->cacheMaxGB->setIfChanged(value);
+            _setDirty();
+        }
+
+        std::shared_ptr<IValueSubject<int> > FileSettings::observeProxyCacheMaxMB() const
+        {
+            return _p->proxyCacheMaxMB;
+        }
+
+        void FileSettings::setProxyCacheMaxMB(int value)
+        {
+            _p->proxyCacheMaxMB->setIfChanged(value);
+            _setDirty();
         }
 
         const std::map<std::string, BBox2f>& FileSettings::getWidgetGeom() const
@@ -139,6 +158,7 @@ namespace djv
         void FileSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _setDirty();
         }
 
         void FileSettings::load(const picojson::value & value)
@@ -167,6 +187,7 @@ namespace djv
                 UI::Settings::read("AutoDetectSequences", object, p.autoDetectSequences);
                 UI::Settings::read("CacheEnabled", object, p.cacheEnabled);
                 UI::Settings::read("CacheMax", object, p.cacheMaxGB);
+                UI::Settings::read("ProxyCacheMax", object, p.proxyCacheMaxMB);
                 UI::Settings::read("WidgetGeom", object, p.widgetGeom);
             }
         }
@@ -182,6 +203,7 @@ namespace djv
             UI::Settings::write("AutoDetectSequences", p.autoDetectSequences->get(), object);
             UI::Settings::write("CacheEnabled", p.cacheEnabled->get(), object);
             UI::Settings::write("CacheMax", p.cacheMaxGB->get(), object);
+            UI::Settings::write("ProxyCacheMax", p.proxyCacheMaxMB->get(), object);
             UI::Settings::write("WidgetGeom", p.widgetGeom, object);
             return out;
         }
@@ -54,6 +54,11 @@ namespace djv
             void setCacheEnabled(bool);
             void setCacheMaxGB(int);
 
+            //! The memory budget for the proxy images that are shown while
+            //! scrubbing.
+            std::shared_ptr<Core::IValueSubject<int> > observeProxyCacheMaxMB() const;
+            void setProxyCacheMaxMB(int);
+
             const std::map<std::string, Core::BBox2f>& getWidgetGeom() const;
             void setWidgetGeom(const std::map<std::string, Core::BBox2f>&);
 
@@ -20,6 +20,7 @@
 #include <djvUI/Shortcut.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/IO.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/FileInfo.h>
@@ -51,13 +52,13 @@ namespace djv
             std::shared_ptr<UI::FileBrowser::Dialog> fileBrowserDialog;
             Core::FileSystem::Path fileBrowserPath = Core::FileSystem::Path(".");
             std::shared_ptr<RecentFilesDialog> recentFilesDialog;
-            size_t threadCount = 4;
             std::shared_ptr<Core::FileSystem::RecentFilesModel> recentFilesModel;
             std::shared_ptr<ListObserver<Core::FileSystem::FileInfo> > recentFilesObserver;
             std::shared_ptr<ListObserver<Core::FileSystem::FileInfo> > recentFilesObserver2;
             std::shared_ptr<ValueObserver<size_t> > threadCountObserver;
             std::shared_ptr<ValueObserver<bool> > cacheEnabledObserver;
             std::shared_ptr<ValueObserver<int> > cacheMaxGBObserver;
+            std::shared_ptr<ValueObserver<int> > proxyCacheMaxMBObserver;
             std::map<std::string, std::shared_ptr<ValueObserver<bool> > > actionObservers;
             std::shared_ptr<Time::Timer> cacheTimer;
         };
@@ -362,6 +363,16 @@ namespace djv
                     }
                 });
 
+            p.proxyCacheMaxMBObserver = ValueObserver<int>::create(
+                p.settings->observeProxyCacheMaxMB(),
+                [weak](int value)
+                {
+                    if (auto system = weak.lock())
+                    {
+                        system->_cacheUpdate();
+                    }
+                });
+
             p.actionObservers["Exit"] = ValueObserver<bool>::create(
                 p.actions["Exit"]->observeClicked(),
                 [weak, contextWeak](bool value)
@@ -379,16 +390,12 @@ namespace djv
             auto ioSettings = settingsSystem->getSettingsT<UI::Settings::IO>();
             p.threadCountObserver = ValueObserver<size_t>::create(
                 ioSettings->observeThreadCount(),
-                [weak](size_t value)
+                [contextWeak](size_t value)
                 {
-                    if (auto system = weak.lock())
+                    if (auto context = contextWeak.lock())
                     {
-                        system->_p->threadCount = value;
-                        const auto& media = system->_p->media->get();
-                        for (const auto& i : media)
-                        {
-                            i->setThreadCount(value);
-                        }
+                        auto io = context->getSystemT<AV::IO::System>();
+                        io->setThreadCount(value);
                     }
                 });
 
@@ -441,6 +448,7 @@ namespace djv
         {
             auto out = std::shared_ptr<FileSystem>(new FileSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -485,7 +493,6 @@ namespace djv
             if (auto context = getContext().lock())
             {
                 auto media = Media::create(fileInfo, context);
-                media->setThreadCount(p.threadCount);
                 if (options.speed)
                 {
                     media->setPlaybackSpeed(PlaybackSpeed::Custom);
@@ -668,10 +675,13 @@ namespace djv
             const bool cacheEnabled = p.settings->observeCacheEnabled()->get();
             const size_t cacheMaxByteCount = p.settings->observeCacheMaxGB()->get() * Memory::gigabyte;
             const size_t mediaCacheSizeByteCount = cacheCount > 0 ? (cacheMaxByteCount / cacheCount) : 0;
+            const size_t proxyCacheMaxByteCount = std::max(p.settings->observeProxyCacheMaxMB()->get(), 0) * Memory::megabyte;
+            const size_t mediaProxyCacheByteCount = cacheCount > 0 ? (proxyCacheMaxByteCount / cacheCount) : 0;
             for (const auto& i : media)
             {
                 i->setCacheEnabled(cacheEnabled);
                 i->setCacheMaxByteCount(mediaCacheSizeByteCount);
+                i->setProxyCacheMaxByteCount(mediaProxyCacheByteCount);
             }
         }
 
@@ -127,6 +127,7 @@ namespace djv
         {
             auto out = std::shared_ptr<HelpSystem>(new HelpSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
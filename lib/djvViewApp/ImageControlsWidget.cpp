@@ -7,6 +7,7 @@
 #include <djvViewApp/ImageSettings.h>
 #include <djvViewApp/ImageSystem.h>
 #include <djvViewApp/ImageView.h>
+#include <djvViewApp/Media.h>
 #include <djvViewApp/MediaWidget.h>
 #include <djvViewApp/WindowSystem.h>
 
@@ -26,6 +27,7 @@
 #include <djvUI/ToolButton.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/ImageStats.h>
 #include <djvAV/Render2D.h>
 
 #include <djvCore/Context.h>
@@ -43,6 +45,8 @@ namespace djv
             UI::ImageAspectRatio aspectRatio = UI::ImageAspectRatio::First;
             bool frameStoreEnabled = false;
             std::shared_ptr<AV::Image::Image> frameStore;
+            bool levelsAuto = false;
+            std::shared_ptr<AV::Image::Image> currentImage;
 
             std::shared_ptr<MediaWidget> activeWidget;
 
@@ -62,6 +66,7 @@ namespace djv
             std::map<std::string, std::shared_ptr<UI::FloatSlider> > colorSliders;
             std::shared_ptr<UI::CheckBox> colorInvertCheckBox;
             std::shared_ptr<UI::ToolButton> levelsEnabledButton;
+            std::shared_ptr<UI::CheckBox> levelsAutoCheckBox;
             std::map<std::string, std::shared_ptr<UI::FloatSlider> > levelsSliders;
             std::shared_ptr<UI::ToolButton> exposureEnabledButton;
             std::map<std::string, std::shared_ptr<UI::FloatSlider> > exposureSliders;
@@ -81,6 +86,7 @@ namespace djv
 
             std::shared_ptr<ValueObserver<std::shared_ptr<MediaWidget> > > activeWidgetObserver;
             std::shared_ptr<ValueObserver<AV::Render2D::ImageOptions> > imageOptionsObserver;
+            std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > currentImageObserver;
             std::shared_ptr<ValueObserver<UI::ImageRotate> > rotateObserver;
             std::shared_ptr<ValueObserver<UI::ImageAspectRatio> > aspectRatioObserver;
             std::shared_ptr<MapObserver<std::string, bool> > colorControlsBellowsObserver;
@@ -136,6 +142,7 @@ namespace djv
             p.levelsEnabledButton->setIcon("djvIconHiddenSmall");
             p.levelsEnabledButton->setCheckedIcon("djvIconVisibleSmall");
             p.levelsEnabledButton->setInsideMargin(UI::MetricsRole::None);
+            p.levelsAutoCheckBox = UI::CheckBox::create(context);
             p.levelsSliders["InLow"] = UI::FloatSlider::create(context);
             const AV::Render2D::ImageLevels levels;
             p.levelsSliders["InLow"]->setDefault(levels.inLow);
@@ -236,6 +243,7 @@ namespace djv
             p.colorLayouts["Levels"]->setMargin(UI::MetricsRole::MarginSmall);
             p.colorLayouts["Levels"]->setSpacing(UI::MetricsRole::SpacingSmall);
             p.colorLayouts["Levels"]->setSizeGroup(p.colorSizeGroup);
+            p.colorLayouts["Levels"]->addChild(p.levelsAutoCheckBox);
             for (const auto& i : { "InLow", "InHigh", "Gamma", "OutLow", "OutHigh" })
             {
                 p.colorLayouts["Levels"]->addChild(p.levelsSliders[i]);
@@ -477,6 +485,22 @@ namespace djv
                     }
                 }
             });
+            p.levelsAutoCheckBox->setCheckedCallback(
+                [weak](bool value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->levelsAuto = value;
+                        if (widget->_p->activeWidget)
+                        {
+                            // The levels are set from the statistics that are
+                            // computed when the images are read.
+                            widget->_p->activeWidget->getMedia()->setStatsEnabled(value);
+                        }
+                        widget->_levelsAutoUpdate();
+                        widget->_widgetUpdate();
+                    }
+                });
             p.levelsSliders["InLow"]->setValueCallback(
                 [weak](float value)
                 {
@@ -681,9 +705,27 @@ namespace djv
                     {
                         if (auto widget = weak.lock())
                         {
+                            if (widget->_p->activeWidget && widget->_p->levelsAuto)
+                            {
+                                widget->_p->activeWidget->getMedia()->setStatsEnabled(false);
+                            }
                             widget->_p->activeWidget = value;
                             if (widget->_p->activeWidget)
                             {
+                                if (widget->_p->levelsAuto)
+                                {
+                                    widget->_p->activeWidget->getMedia()->setStatsEnabled(true);
+                                }
+                                widget->_p->currentImageObserver = ValueObserver<std::shared_ptr<AV::Image::Image> >::create(
+                                    widget->_p->activeWidget->getMedia()->observeCurrentImage(),
+                                    [weak](const std::shared_ptr<AV::Image::Image>& value)
+                                    {
+                                        if (auto widget = weak.lock())
+                                        {
+                                            widget->_p->currentImage = value;
+                                            widget->_levelsAutoUpdate();
+                                        }
+                                    });
                                 widget->_p->imageOptionsObserver = ValueObserver<AV::Render2D::ImageOptions>::create(
                                     widget->_p->activeWidget->getImageView()->observeImageOptions(),
                                     [weak](const AV::Render2D::ImageOptions& value)
@@ -718,6 +760,8 @@ namespace djv
                             else
                             {
                                 widget->_p->imageOptionsObserver.reset();
+                                widget->_p->currentImageObserver.reset();
+                                widget->_p->currentImage.reset();
                                 widget->_p->rotateObserver.reset();
                                 widget->_p->aspectRatioObserver.reset();
                             }
@@ -773,7 +817,13 @@ namespace djv
         {}
 
         ImageControlsWidget::~ImageControlsWidget()
-        {}
+        {
+            DJV_PRIVATE_PTR();
+            if (p.activeWidget && p.levelsAuto)
+            {
+                p.activeWidget->getMedia()->setStatsEnabled(false);
+            }
+        }
 
         std::shared_ptr<ImageControlsWidget> ImageControlsWidget::create(const std::shared_ptr<Core::Context>& context)
         {
@@ -855,6 +905,7 @@ namespace djv
             p.colorLayouts["Adjustments"]->setText(p.colorSliders["Saturation"], _getText(DJV_TEXT("image_controls_adjustments_saturation")) + ":");
             p.colorLayouts["Adjustments"]->setText(p.colorInvertCheckBox, _getText(DJV_TEXT("image_controls_adjustments_invert")) + ":");
 
+            p.colorLayouts["Levels"]->setText(p.levelsAutoCheckBox, _getText(DJV_TEXT("image_controls_levels_auto")) + ":");
             p.colorLayouts["Levels"]->setText(p.levelsSliders["InLow"], _getText(DJV_TEXT("image_controls_levels_in_low")) + ":");
             p.colorLayouts["Levels"]->setText(p.levelsSliders["InHigh"], _getText(DJV_TEXT("image_controls_levels_in_high")) + ":");
             p.colorLayouts["Levels"]->setText(p.levelsSliders["Gamma"], _getText(DJV_TEXT("image_controls_levels_gamma")) + ":");
@@ -882,6 +933,39 @@ namespace djv
             _widgetUpdate();
         }
 
+        void ImageControlsWidget::_levelsAutoUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            if (p.levelsAuto && p.currentImage && p.activeWidget)
+            {
+                if (const auto& stats = p.currentImage->getStats())
+                {
+                    // Set the input range from the color channels, ignoring
+                    // the alpha channel.
+                    const size_t channelCount = 2 == stats->channelCount || 4 == stats->channelCount ?
+                        (stats->channelCount - 1) :
+                        stats->channelCount;
+                    if (channelCount > 0)
+                    {
+                        float min = stats->min[0];
+                        float max = stats->max[0];
+                        for (size_t i = 1; i < channelCount; ++i)
+                        {
+                            min = std::min(min, stats->min[i]);
+                            max = std::max(max, stats->max[i]);
+                        }
+                        if (max > min)
+                        {
+                            p.imageOptions.levels.inLow = min;
+                            p.imageOptions.levels.inHigh = max;
+                            _widgetUpdate();
+                            p.activeWidget->getImageView()->setImageOptions(p.imageOptions);
+                        }
+                    }
+                }
+            }
+        }
+
         void ImageControlsWidget::_widgetUpdate()
         {
             DJV_PRIVATE_PTR();
@@ -901,6 +985,9 @@ namespace djv
             p.colorInvertCheckBox->setChecked(p.imageOptions.color.invert);
 
             p.levelsEnabledButton->setChecked(p.imageOptions.levelsEnabled);
+            p.levelsAutoCheckBox->setChecked(p.levelsAuto);
+            p.levelsSliders["InLow"]->setEnabled(!p.levelsAuto);
+            p.levelsSliders["InHigh"]->setEnabled(!p.levelsAuto);
             p.levelsSliders["InLow"]->setValue(p.imageOptions.levels.inLow);
             p.levelsSliders["InHigh"]->setValue(p.imageOptions.levels.inHigh);
             p.levelsSliders["Gamma"]->setValue(p.imageOptions.levels.gamma);
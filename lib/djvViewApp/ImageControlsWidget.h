@@ -44,6 +44,7 @@ namespace djv
             void _initEvent(Core::Event::Init&) override;
 
         private:
+            void _levelsAutoUpdate();
             void _widgetUpdate();
 
             DJV_PRIVATE();
@@ -58,6 +58,7 @@ namespace djv
         void ImageSettings::setColorControlsBellows(const std::map<std::string, bool>& value)
         {
             _p->controlControlsBellows->setIfChanged(value);
+            _setDirty();
         }
 
         int ImageSettings::getColorSpaceCurrentTab() const
@@ -73,11 +74,13 @@ namespace djv
         void ImageSettings::setColorSpaceCurrentTab(int value)
         {
             _p->colorSpaceCurrentTab = value;
+            _setDirty();
         }
 
         void ImageSettings::setColorCurrentTab(int value)
         {
             _p->colorCurrentTab = value;
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<UI::ImageRotate> > ImageSettings::observeRotate() const
@@ -93,11 +96,13 @@ namespace djv
         void ImageSettings::setRotate(UI::ImageRotate value)
         {
             _p->rotate->setIfChanged(value);
+            _setDirty();
         }
 
         void ImageSettings::setAspectRatio(UI::ImageAspectRatio value)
         {
             _p->aspectRatio->setIfChanged(value);
+            _setDirty();
         }
 
         const std::map<std::string, BBox2f>& ImageSettings::getWidgetGeom() const
@@ -108,6 +113,7 @@ namespace djv
         void ImageSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _setDirty();
         }
 
         void ImageSettings::load(const picojson::value & value)
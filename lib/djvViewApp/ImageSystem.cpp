@@ -316,6 +316,7 @@ namespace djv
         {
             auto out = std::shared_ptr<ImageSystem>(new ImageSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
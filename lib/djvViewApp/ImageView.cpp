@@ -53,6 +53,7 @@ namespace djv
         struct ImageView::Private
         {
             std::shared_ptr<ValueSubject<std::shared_ptr<AV::Image::Image> > > image;
+            std::shared_ptr<AV::Image::Image> proxyImage;
             std::shared_ptr<ValueSubject<AV::Render2D::ImageOptions> > imageOptions;
             AV::OCIO::Config ocioConfig;
             std::string outputColorSpace;
@@ -179,6 +180,15 @@ namespace djv
             }
         }
 
+        void ImageView::setProxyImage(const std::shared_ptr<AV::Image::Image>& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value == p.proxyImage)
+                return;
+            p.proxyImage = value;
+            _redraw();
+        }
+
         std::shared_ptr<IValueSubject<AV::Render2D::ImageOptions> > ImageView::observeImageOptions() const
         {
             return _p->imageOptions;
@@ -436,6 +446,15 @@ namespace djv
                 glm::mat3x3 m(1.F);
                 m = glm::translate(m, g.min + p.imagePos->get());
                 m *= UI::ImageWidget::getXForm(image, p.imageRotate->get(), glm::vec2(zoom, zoom), p.imageAspectRatio->get());
+                auto drawImage = image;
+                if (p.proxyImage && p.proxyImage->isValid())
+                {
+                    // Scale the proxy image up to the size of the image.
+                    m = glm::scale(m, glm::vec2(
+                        image->getWidth() / static_cast<float>(p.proxyImage->getWidth()),
+                        image->getHeight() / static_cast<float>(p.proxyImage->getHeight())));
+                    drawImage = p.proxyImage;
+                }
                 render->pushTransform(m);
                 render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F));
                 AV::Render2D::ImageOptions options(p.imageOptions->get());
@@ -454,7 +473,7 @@ namespace djv
                 }
                 options.colorSpace.output = p.outputColorSpace;
                 options.cache = AV::Render2D::ImageCache::Dynamic;
-                render->drawImage(image, glm::vec2(0.F, 0.F), options);
+                render->drawImage(drawImage, glm::vec2(0.F, 0.F), options);
                 render->popTransform();
             }
 
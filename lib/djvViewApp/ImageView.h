@@ -67,6 +67,10 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<std::shared_ptr<AV::Image::Image> > > observeImage() const;
             void setImage(const std::shared_ptr<AV::Image::Image>&);
 
+            //! Set a reduced size proxy image that is drawn in place of the
+            //! image, scaled to the size of the image.
+            void setProxyImage(const std::shared_ptr<AV::Image::Image>&);
+
             std::shared_ptr<Core::IValueSubject<AV::Render2D::ImageOptions> > observeImageOptions() const;
             void setImageOptions(const AV::Render2D::ImageOptions&);
 
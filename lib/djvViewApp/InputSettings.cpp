@@ -49,6 +49,7 @@ namespace djv
         void InputSettings::setScrollWheelSpeed(ScrollWheelSpeed value)
         {
             _p->scrollWheelSpeed->setIfChanged(value);
+            _setDirty();
         }
 
         void InputSettings::load(const picojson::value & value)
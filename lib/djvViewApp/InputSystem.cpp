@@ -39,6 +39,7 @@ namespace djv
         {
             auto out = std::shared_ptr<InputSystem>(new InputSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
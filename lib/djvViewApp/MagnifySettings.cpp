@@ -49,6 +49,7 @@ namespace djv
         void MagnifySettings::setMagnify(size_t value)
         {
             _p->magnify = value;
+            _setDirty();
         }
 
         const glm::vec2& MagnifySettings::getMagnifyPos() const
@@ -59,6 +60,7 @@ namespace djv
         void MagnifySettings::setMagnifyPos(const glm::vec2& value)
         {
             _p->magnifyPos = value;
+            _setDirty();
         }
 
         const std::map<std::string, BBox2f>& MagnifySettings::getWidgetGeom() const
@@ -69,6 +71,7 @@ namespace djv
         void MagnifySettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _setDirty();
         }
 
         void MagnifySettings::load(const picojson::value & value)
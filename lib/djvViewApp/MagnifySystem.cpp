@@ -59,6 +59,7 @@ namespace djv
         {
             auto out = std::shared_ptr<MagnifySystem>(new MagnifySystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
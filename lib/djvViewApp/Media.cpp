@@ -11,6 +11,7 @@
 
 #include <djvCore/Context.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/StringFormat.h>
 #include <djvCore/TextSystem.h>
 #include <djvCore/Timer.h>
@@ -50,23 +51,29 @@ namespace djv
             std::shared_ptr<ValueSubject<Frame::Sequence> > sequence;
             std::shared_ptr<ValueSubject<Frame::Index> > currentFrame;
             std::shared_ptr<ValueSubject<std::shared_ptr<AV::Image::Image> > > currentImage;
+            std::vector<std::shared_ptr<AV::Image::Image> > currentLayers;
+            bool allLayers = false;
+            bool statsEnabled = false;
+            std::shared_ptr<ValueSubject<std::shared_ptr<AV::Image::Image> > > proxyImage;
+            size_t proxyLayer = 0;
             std::shared_ptr<ValueSubject<Playback> > playback;
             std::shared_ptr<ValueSubject<PlaybackMode> > playbackMode;
             std::shared_ptr<ValueSubject<AV::IO::InOutPoints> > inOutPoints;
             std::shared_ptr<ValueSubject<bool> > audioEnabled;
             std::shared_ptr<ValueSubject<float> > volume;
             std::shared_ptr<ValueSubject<bool> > mute;
-            std::shared_ptr<ValueSubject<size_t> > threadCount;
             std::shared_ptr<ValueSubject<Frame::Sequence> > cacheSequence;
             std::shared_ptr<ValueSubject<Frame::Sequence> > cachedFrames;
             bool cacheEnabled = false;
             size_t cacheMaxByteCount = 0;
+            size_t proxyCacheMaxByteCount = 0;
             std::shared_ptr<ListSubject<std::shared_ptr<AnnotatePrimitive> > > annotations;
 
             std::shared_ptr<ValueSubject<size_t> > videoQueueMax;
             std::shared_ptr<ValueSubject<size_t> > videoQueueCount;
             std::shared_ptr<ValueSubject<size_t> > audioQueueMax;
             std::shared_ptr<ValueSubject<size_t> > audioQueueCount;
+            std::shared_ptr<ValueSubject<Core::FileSystem::ReadAheadStats> > readAheadStats;
             std::shared_ptr<AV::IO::IRead> read;
 
             AV::IO::Direction ioDirection = AV::IO::Direction::Forward;
@@ -107,13 +114,13 @@ namespace djv
             p.sequence = ValueSubject<Frame::Sequence>::create();
             p.currentFrame = ValueSubject<Frame::Index>::create(Frame::invalid);
             p.currentImage = ValueSubject<std::shared_ptr<AV::Image::Image> >::create();
+            p.proxyImage = ValueSubject<std::shared_ptr<AV::Image::Image> >::create();
             p.playback = ValueSubject<Playback>::create(Playback::First);
             p.playbackMode = ValueSubject<PlaybackMode>::create(PlaybackMode::First);
             p.inOutPoints = ValueSubject<AV::IO::InOutPoints>::create();
             p.volume = ValueSubject<float>::create(1.F);
             p.audioEnabled = ValueSubject<bool>::create(false);
             p.mute = ValueSubject<bool>::create(false);
-            p.threadCount = ValueSubject<size_t>::create(4);
             p.cacheSequence = ValueSubject<Frame::Sequence>::create();
             p.cachedFrames = ValueSubject<Frame::Sequence>::create();
             p.annotations = ListSubject<std::shared_ptr<AnnotatePrimitive> >::create();
@@ -122,6 +129,7 @@ namespace djv
             p.audioQueueMax = ValueSubject<size_t>::create();
             p.videoQueueCount = ValueSubject<size_t>::create();
             p.audioQueueCount = ValueSubject<size_t>::create();
+            p.readAheadStats = ValueSubject<Core::FileSystem::ReadAheadStats>::create();
 
             p.playbackTimer = Time::Timer::create(context);
             p.playbackTimer->setRepeating(true);
@@ -219,9 +227,20 @@ namespace djv
 
         void Media::setLayer(size_t value)
         {
-            if (_p->layer->setIfChanged(value))
+            DJV_PRIVATE_PTR();
+            if (p.layer->setIfChanged(value))
             {
-                _open();
+                // Once the user switches layers all of the layers are read
+                // together, so later switches do not need to re-open the file.
+                if (value < p.currentLayers.size() && p.currentLayers[value])
+                {
+                    p.currentImage->setIfChanged(p.currentLayers[value]);
+                }
+                else
+                {
+                    p.allLayers = true;
+                    _open();
+                }
             }
         }
 
@@ -260,6 +279,28 @@ namespace djv
             return _p->currentImage;
         }
 
+        std::shared_ptr<IValueSubject<std::shared_ptr<AV::Image::Image> > > Media::observeProxyImage() const
+        {
+            return _p->proxyImage;
+        }
+
+        bool Media::getProxyImage(Frame::Index index, std::shared_ptr<AV::Image::Image>& out) const
+        {
+            DJV_PRIVATE_PTR();
+            // The proxies are only read for the layer the file was opened with.
+            return p.read && p.layer->get() == p.proxyLayer && p.read->getProxy(index, out);
+        }
+
+        void Media::setStatsEnabled(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value != p.statsEnabled)
+            {
+                p.statsEnabled = value;
+                _open();
+            }
+        }
+
         std::shared_ptr<IValueSubject<Time::Speed> > Media::observeSpeed() const
         {
             return _p->speed;
@@ -348,6 +389,10 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (_p->playEveryFrame->setIfChanged(value))
             {
+                if (p.read)
+                {
+                    p.read->setPlayEveryFrame(value);
+                }
                 _seek(p.currentFrame->get());
                 p.audioEnabled->setIfChanged(_isAudioEnabled());
                 if (_hasAudioSyncPlayback())
@@ -387,6 +432,11 @@ namespace djv
             {
                 setPlayback(Playback::Stop);
                 _seek(p.currentFrame->get());
+
+                // Display the proxy image until the frame is read.
+                std::shared_ptr<AV::Image::Image> proxy;
+                getProxyImage(tmp, proxy);
+                p.proxyImage->setIfChanged(proxy);
             }
         }
 
@@ -512,7 +562,15 @@ namespace djv
 
         void Media::setPlaybackMode(PlaybackMode value)
         {
-            _p->playbackMode->setIfChanged(value);
+            DJV_PRIVATE_PTR();
+            if (p.playbackMode->setIfChanged(value))
+            {
+                if (p.read)
+                {
+                    p.read->setLoop(PlaybackMode::Once != value);
+                    p.read->setPingPong(PlaybackMode::PingPong == value);
+                }
+            }
         }
 
         void Media::setInOutPoints(const AV::IO::InOutPoints& value)
@@ -595,23 +653,6 @@ namespace djv
             _p->mute->setIfChanged(value);
         }
 
-        std::shared_ptr<IValueSubject<size_t> > Media::observeThreadCount() const
-        {
-            return _p->threadCount;
-        }
-
-        void Media::setThreadCount(size_t value)
-        {
-            DJV_PRIVATE_PTR();
-            if (p.threadCount->setIfChanged(value))
-            {
-                if (p.read)
-                {
-                    p.read->setThreadCount(value);
-                }
-            }
-        }
-
         bool Media::hasCache() const
         {
             DJV_PRIVATE_PTR();
@@ -658,6 +699,22 @@ namespace djv
                 p.read->setCacheMaxByteCount(p.cacheMaxByteCount);
             }
         }
+
+        size_t Media::getProxyCacheMaxByteCount() const
+        {
+            return _p->proxyCacheMaxByteCount;
+        }
+
+        void Media::setProxyCacheMaxByteCount(size_t value)
+        {
+            DJV_PRIVATE_PTR();
+            p.proxyCacheMaxByteCount = value;
+            if (p.read)
+            {
+                p.read->setProxyEnabled(p.proxyCacheMaxByteCount > 0);
+                p.read->setProxyMaxByteCount(p.proxyCacheMaxByteCount);
+            }
+        }
             
         std::shared_ptr<Core::IListSubject<std::shared_ptr<AnnotatePrimitive> > > Media::observeAnnotations() const
         {
@@ -694,6 +751,11 @@ namespace djv
             return _p->audioQueueCount;
         }
 
+        std::shared_ptr<IValueSubject<Core::FileSystem::ReadAheadStats> > Media::observeReadAheadStats() const
+        {
+            return _p->readAheadStats;
+        }
+
         bool Media::_hasAudio() const
         {
             DJV_PRIVATE_PTR();
@@ -720,17 +782,25 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (auto context = p.context.lock())
             {
+                p.currentLayers.clear();
                 try
                 {
                     AV::IO::ReadOptions options;
                     options.layer = p.layer->get();
+                    options.allLayers = p.allLayers;
+                    options.stats = p.statsEnabled;
                     options.videoQueueSize = videoQueueSize;
                     auto io = context->getSystemT<AV::IO::System>();
                     p.read = io->read(p.fileInfo, options);
-                    p.read->setThreadCount(p.threadCount->get());
-                    p.read->setLoop(true);
+                    p.read->setLoop(PlaybackMode::Once != p.playbackMode->get());
+                    p.read->setPlayEveryFrame(p.playEveryFrame->get());
+                    p.read->setPingPong(PlaybackMode::PingPong == p.playbackMode->get());
                     p.read->setCacheEnabled(p.cacheEnabled);
                     p.read->setCacheMaxByteCount(p.cacheMaxByteCount);
+                    p.read->setProxyEnabled(p.proxyCacheMaxByteCount > 0);
+                    p.read->setProxyMaxByteCount(p.proxyCacheMaxByteCount);
+                    p.proxyLayer = options.layer;
+                    p.proxyImage->setIfChanged(nullptr);
 
                     const auto info = p.read->getInfo().get();
                     p.info->setIfChanged(info);
@@ -859,6 +929,7 @@ namespace djv
                                         media->_p->audioQueueMax->setAlways(audioQueueMax);
                                         media->_p->audioQueueCount->setAlways(audioQueueCount);
                                     }
+                                    media->_p->readAheadStats->setAlways(media->_p->read->getReadAheadStats());
                                 }
                             }
                         });
@@ -883,6 +954,11 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.speed->setIfChanged(value))
             {
+                if (p.read)
+                {
+                    const float defaultSpeed = p.defaultSpeed->get().toFloat();
+                    p.read->setPlaybackSpeed(defaultSpeed > 0.F ? (value.toFloat() / defaultSpeed) : 1.F);
+                }
                 _seek(p.currentFrame->get());
                 p.audioEnabled->setIfChanged(_isAudioEnabled());
                 if (_hasAudioSyncPlayback())
@@ -1185,7 +1261,15 @@ namespace djv
                         p.realSpeedTime = now;
                         p.realSpeedFrameCount = 0;
                     }
-                    p.currentImage->setIfChanged(frame.image);
+                    if (playback != Playback::Stop || frame.frame == currentFrame)
+                    {
+                        p.proxyImage->setIfChanged(nullptr);
+                    }
+                    const size_t layer = p.layer->get();
+                    p.currentLayers = frame.layers;
+                    p.currentImage->setIfChanged(layer < frame.layers.size() && frame.layers[layer] ?
+                        frame.layers[layer] :
+                        frame.image);
                     if (p.playEveryFrame->get())
                     {
                         _setCurrentFrame(frame.frame);
@@ -77,6 +77,19 @@ namespace djv
 
             std::shared_ptr<Core::IValueSubject<std::shared_ptr<AV::Image::Image> > > observeCurrentImage() const;
 
+            //! Observe the reduced size proxy image that is displayed while
+            //! scrubbing, until the current image is read. This is null when
+            //! the current image is up to date.
+            std::shared_ptr<Core::IValueSubject<std::shared_ptr<AV::Image::Image> > > observeProxyImage() const;
+
+            //! Get the proxy image for a frame if it has been read.
+            bool getProxyImage(Core::Frame::Index, std::shared_ptr<AV::Image::Image>&) const;
+
+            //! Set whether the image statistics are computed when the images
+            //! are read (see AV::Image::Image::getStats()). Changing this
+            //! re-opens the file.
+            void setStatsEnabled(bool);
+
             ///@}
 
             //! \name Playback
@@ -126,15 +139,6 @@ namespace djv
 
             ///@}
 
-            //! \name I/O
-            ///@{
-
-            std::shared_ptr<Core::IValueSubject<size_t> > observeThreadCount() const;
-
-            void setThreadCount(size_t);
-
-            ///@}
-
             //! \name Memory Cache
             ///@{
 
@@ -147,6 +151,12 @@ namespace djv
             void setCacheEnabled(bool);
             void setCacheMaxByteCount(size_t);
 
+            //! Get the memory budget for the proxy images. The proxy images
+            //! are disabled when this is zero.
+            size_t getProxyCacheMaxByteCount() const;
+
+            void setProxyCacheMaxByteCount(size_t);
+
             ///@}
 
             //! \name Annotations
@@ -166,6 +176,7 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<size_t> > observeAudioQueueMax() const;
             std::shared_ptr<Core::IValueSubject<size_t> > observeVideoQueueCount() const;
             std::shared_ptr<Core::IValueSubject<size_t> > observeAudioQueueCount() const;
+            std::shared_ptr<Core::IValueSubject<Core::FileSystem::ReadAheadStats> > observeReadAheadStats() const;
 
             ///@}
 
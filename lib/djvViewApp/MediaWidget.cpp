@@ -105,6 +105,7 @@ namespace djv
             AV::IO::Info ioInfo;
             size_t layer = 0;
             std::shared_ptr<AV::Image::Image> image;
+            std::shared_ptr<AV::Image::Image> proxyImage;
             PlaybackSpeed playbackSpeed = PlaybackSpeed::First;
             Time::Speed defaultSpeed;
             Time::Speed customSpeed;
@@ -165,6 +166,7 @@ namespace djv
             std::shared_ptr<ValueObserver<AV::IO::Info> > ioInfoObserver;
             std::shared_ptr<ValueObserver<size_t> > layerObserver;
             std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > imageObserver;
+            std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > proxyImageObserver;
             std::shared_ptr<ValueObserver<Time::Speed> > speedObserver;
             std::shared_ptr<ValueObserver<PlaybackSpeed> > playbackSpeedObserver;
             std::shared_ptr<ValueObserver<Time::Speed> > defaultSpeedObserver;
@@ -818,6 +820,17 @@ namespace djv
                     }
                 });
 
+            p.proxyImageObserver = ValueObserver<std::shared_ptr<AV::Image::Image> >::create(
+                p.media->observeProxyImage(),
+                [weak](const std::shared_ptr<AV::Image::Image>& value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->proxyImage = value;
+                        widget->_imageUpdate();
+                    }
+                });
+
             p.speedObserver = ValueObserver<Time::Speed>::create(
                 p.media->observeSpeed(),
                 [weak](const Time::Speed& value)
@@ -1368,7 +1381,9 @@ namespace djv
         void MediaWidget::_imageUpdate()
         {
             DJV_PRIVATE_PTR();
-            p.imageView->setImage(p.active && p.frameStoreEnabled && p.frameStore ? p.frameStore : p.image);
+            const bool frameStore = p.active && p.frameStoreEnabled && p.frameStore;
+            p.imageView->setImage(frameStore ? p.frameStore : p.image);
+            p.imageView->setProxyImage(frameStore ? nullptr : p.proxyImage);
         }
 
         void MediaWidget::_speedUpdate()
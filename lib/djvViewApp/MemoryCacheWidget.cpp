@@ -30,12 +30,16 @@ namespace djv
             std::shared_ptr<UI::CheckBox> enabledCheckBox;
             std::shared_ptr<UI::IntSlider> maxGBSlider;
             std::shared_ptr<UI::Label> maxGBLabel;
+            std::shared_ptr<UI::Label> proxyLabel;
+            std::shared_ptr<UI::IntSlider> proxyMaxMBSlider;
+            std::shared_ptr<UI::Label> proxyMaxMBLabel;
             std::shared_ptr<UI::Label> percentageLabel;
             std::shared_ptr<UI::Label> percentageLabel2;
             std::shared_ptr<UI::VerticalLayout> layout;
 
             std::shared_ptr<ValueObserver<bool> > enabledObserver;
             std::shared_ptr<ValueObserver<int> > maxGBObserver;
+            std::shared_ptr<ValueObserver<int> > proxyMaxMBObserver;
             std::shared_ptr<ValueObserver<float> > percentageObserver;
         };
 
@@ -57,6 +61,14 @@ namespace djv
             p.maxGBLabel = UI::Label::create(context);
             p.maxGBLabel->setTextHAlign(UI::TextHAlign::Left);
 
+            p.proxyLabel = UI::Label::create(context);
+            p.proxyLabel->setTextHAlign(UI::TextHAlign::Left);
+            p.proxyLabel->setMargin(UI::MetricsRole::MarginSmall);
+            p.proxyMaxMBSlider = UI::IntSlider::create(context);
+            p.proxyMaxMBSlider->setRange(IntRange(0, 4096));
+            p.proxyMaxMBLabel = UI::Label::create(context);
+            p.proxyMaxMBLabel->setTextHAlign(UI::TextHAlign::Left);
+
             p.percentageLabel = UI::Label::create(context);
             p.percentageLabel->setTextHAlign(UI::TextHAlign::Left);
             p.percentageLabel2 = UI::Label::create(context);
@@ -76,6 +88,14 @@ namespace djv
             hLayout->setStretch(p.maxGBSlider, UI::RowStretch::Expand);
             hLayout->addChild(p.maxGBLabel);
             vLayout->addChild(hLayout);
+            vLayout->addChild(p.proxyLabel);
+            hLayout = UI::HorizontalLayout::create(context);
+            hLayout->setMargin(UI::MetricsRole::MarginSmall);
+            hLayout->setSpacing(UI::MetricsRole::SpacingSmall);
+            hLayout->addChild(p.proxyMaxMBSlider);
+            hLayout->setStretch(p.proxyMaxMBSlider, UI::RowStretch::Expand);
+            hLayout->addChild(p.proxyMaxMBLabel);
+            vLayout->addChild(hLayout);
             hLayout = UI::HorizontalLayout::create(context);
             hLayout->setMargin(UI::MetricsRole::MarginSmall);
             hLayout->setSpacing(UI::MetricsRole::SpacingSmall);
@@ -110,6 +130,18 @@ namespace djv
                         }
                     }
                 });
+            p.proxyMaxMBSlider->setValueCallback(
+                [contextWeak](int value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        auto settingsSystem = context->getSystemT<UI::Settings::System>();
+                        if (auto fileSettings = settingsSystem->getSettingsT<FileSettings>())
+                        {
+                            fileSettings->setProxyCacheMaxMB(value);
+                        }
+                    }
+                });
 
             auto weak = std::weak_ptr<MemoryCacheWidget>(
                 std::dynamic_pointer_cast<MemoryCacheWidget>(shared_from_this()));
@@ -135,6 +167,16 @@ namespace djv
                             widget->_p->maxGBSlider->setValue(value);
                         }
                     });
+
+                p.proxyMaxMBObserver = ValueObserver<int>::create(
+                    fileSettings->observeProxyCacheMaxMB(),
+                    [weak](int value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->proxyMaxMBSlider->setValue(value);
+                        }
+                    });
             }
 
             if (auto fileSystem = context->getSystemT<FileSystem>())
@@ -194,6 +236,12 @@ namespace djv
                 ss << Memory::Unit::GB;
                 p.maxGBLabel->setText(_getText(ss.str()));
             }
+            p.proxyLabel->setText(_getText(DJV_TEXT("memory_cache_proxy")) + ":");
+            {
+                std::stringstream ss;
+                ss << Memory::Unit::MB;
+                p.proxyMaxMBLabel->setText(_getText(ss.str()));
+            }
             p.percentageLabel->setText(_getText(DJV_TEXT("memory_cache_used")) + ":");
             {
                 std::stringstream ss;
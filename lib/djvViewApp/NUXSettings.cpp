@@ -49,6 +49,7 @@ namespace djv
         void NUXSettings::setNUX(bool value)
         {
             _p->nux->setIfChanged(value);
+            _setDirty();
         }
 
         void NUXSettings::load(const picojson::value & value)
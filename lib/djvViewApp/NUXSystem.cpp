@@ -428,6 +428,7 @@ namespace djv
         {
             auto out = std::shared_ptr<NUXSystem>(new NUXSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -60,6 +60,7 @@ namespace djv
         void PlaybackSettings::setStartPlayback(bool value)
         {
             _p->startPlayback->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<PlaybackSpeed> > PlaybackSettings::observePlaybackSpeed() const
@@ -70,6 +71,7 @@ namespace djv
         void PlaybackSettings::setPlaybackSpeed(PlaybackSpeed value)
         {
             _p->playbackSpeed->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<Time::Speed> > PlaybackSettings::observeCustomSpeed() const
@@ -80,6 +82,7 @@ namespace djv
         void PlaybackSettings::setCustomSpeed(const Time::Speed& value)
         {
             _p->customSpeed->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<bool> > PlaybackSettings::observePlayEveryFrame() const
@@ -90,6 +93,7 @@ namespace djv
         void PlaybackSettings::setPlayEveryFrame(bool value)
         {
             _p->playEveryFrame->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<PlaybackMode> > PlaybackSettings::observePlaybackMode() const
@@ -100,6 +104,7 @@ namespace djv
         void PlaybackSettings::setPlaybackMode(PlaybackMode value)
         {
             _p->playbackMode->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<bool> > PlaybackSettings::observePIP() const
@@ -110,6 +115,7 @@ namespace djv
         void PlaybackSettings::setPIP(bool value)
         {
             _p->pip->setIfChanged(value);
+            _setDirty();
         }
 
         void PlaybackSettings::load(const picojson::value & value)
@@ -644,6 +644,7 @@ namespace djv
         {
             auto out = std::shared_ptr<PlaybackSystem>(new PlaybackSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
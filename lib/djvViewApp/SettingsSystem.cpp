@@ -64,6 +64,7 @@ namespace djv
         {
             auto out = std::shared_ptr<SettingsSystem>(new SettingsSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
         
@@ -187,6 +187,17 @@ namespace djv
             _resize();
         }
 
+        void TimelinePIPWidget::setProxyImage(Frame::Index frame, const std::shared_ptr<AV::Image::Image>& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value)
+            {
+                p.currentFrame = frame;
+                p.imageWidget->setImage(value);
+                _textUpdate();
+            }
+        }
+
         void TimelinePIPWidget::setImageOptions(const AV::Render2D::ImageOptions& value)
         {
             DJV_PRIVATE_PTR();
@@ -23,6 +23,12 @@ namespace djv
 
     namespace AV
     {
+        namespace Image
+        {
+            class Image;
+
+        } // namespace Image
+
         namespace Render2D
         {
             class ImageOptions;
@@ -50,6 +56,9 @@ namespace djv
             void setFileInfo(const Core::FileSystem::FileInfo&);
             void setPos(const glm::vec2&, Core::Frame::Index, const Core::BBox2f&);
 
+            //! Display a proxy image until the frame is read.
+            void setProxyImage(Core::Frame::Index, const std::shared_ptr<AV::Image::Image>&);
+
             void setImageOptions(const AV::Render2D::ImageOptions&);
             void setImageRotate(UI::ImageRotate);
             void setImageAspectRatio(UI::ImageAspectRatio);
@@ -539,6 +539,11 @@ namespace djv
                     const auto& style = _getStyle();
                     const float s = style->getMetric(UI::MetricsRole::Spacing);
                     p.pipWidget->setPos(glm::vec2(pos.x, g.min.y - s), frame, parent->getGeometry().margin(-s));
+                    std::shared_ptr<AV::Image::Image> proxy;
+                    if (p.media && p.media->getProxyImage(frame, proxy))
+                    {
+                        p.pipWidget->setProxyImage(frame, proxy);
+                    }
                 }
             }
             if (p.pressedID)
@@ -51,6 +51,7 @@ namespace djv
         void ToolSettings::setMessagesPopup(bool value)
         {
             _p->messagesPopup->setIfChanged(value);
+            _setDirty();
         }
 
         std::map<std::string, bool> ToolSettings::getDebugBellowsState() const
@@ -61,6 +62,7 @@ namespace djv
         void ToolSettings::setDebugBellowsState(const std::map<std::string, bool>& value)
         {
             _p->debugBellowsState = value;
+            _setDirty();
         }
 
         const std::map<std::string, BBox2f>& ToolSettings::getWidgetGeom() const
@@ -71,6 +73,7 @@ namespace djv
         void ToolSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _setDirty();
         }
 
         void ToolSettings::load(const picojson::value & value)
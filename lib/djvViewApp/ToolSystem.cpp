@@ -313,6 +313,7 @@ namespace djv
         {
             auto out = std::shared_ptr<ToolSystem>(new ToolSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -59,6 +59,7 @@ namespace djv
         void ViewSettings::setWidgetCurrentTab(int value)
         {
             _p->widgetCurrentTab = value;
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<ImageViewLock> > ViewSettings::observeLock() const
@@ -69,6 +70,7 @@ namespace djv
         void ViewSettings::setLock(ImageViewLock value)
         {
             _p->lock->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<Core::IValueSubject<GridOptions> > ViewSettings::observeGridOptions() const
@@ -79,6 +81,7 @@ namespace djv
         void ViewSettings::setGridOptions(const GridOptions& value)
         {
             _p->gridOptions->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<Core::IValueSubject<HUDOptions> > ViewSettings::observeHUDOptions() const
@@ -89,6 +92,7 @@ namespace djv
         void ViewSettings::setHUDOptions(const HUDOptions& value)
         {
             _p->hudOptions->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<AV::Image::Color> > ViewSettings::observeBackgroundColor() const
@@ -99,6 +103,7 @@ namespace djv
         void ViewSettings::setBackgroundColor(const AV::Image::Color& value)
         {
             _p->backgroundColor->setIfChanged(value);
+            _setDirty();
         }
 
         const std::map<std::string, BBox2f>& ViewSettings::getWidgetGeom() const
@@ -109,6 +114,7 @@ namespace djv
         void ViewSettings::setWidgetGeom(const std::map<std::string, BBox2f>& value)
         {
             _p->widgetGeom = value;
+            _setDirty();
         }
 
         void ViewSettings::load(const picojson::value & value)
@@ -556,6 +556,7 @@ namespace djv
         {
             auto out = std::shared_ptr<ViewSystem>(new ViewSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
@@ -69,6 +69,7 @@ namespace djv
         void WindowSettings::setWindowSize(const glm::ivec2& value)
         {
             _p->windowSize = value;
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<int> > WindowSettings::observeFullscreenMonitor() const
@@ -79,6 +80,7 @@ namespace djv
         void WindowSettings::setFullscreenMonitor(int value)
         {
             _p->fullscreenMonitor->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<bool> > WindowSettings::observeMaximize() const
@@ -89,6 +91,7 @@ namespace djv
         void WindowSettings::setMaximize(bool value)
         {
             _p->maximize->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<bool> > WindowSettings::observeAutoHide() const
@@ -99,6 +102,7 @@ namespace djv
         void WindowSettings::setAutoHide(bool value)
         {
             _p->autoHide->setIfChanged(value);
+            _setDirty();
         }
 
         std::shared_ptr<IValueSubject<std::string> > WindowSettings::observeBackgroundImage() const
@@ -119,16 +123,19 @@ namespace djv
         void WindowSettings::setBackgroundImageScale(bool value)
         {
             _p->backgroundImageScale->setIfChanged(value);
+            _setDirty();
         }
 
         void WindowSettings::setBackgroundImageColorize(bool value)
         {
             _p->backgroundImageColorize->setIfChanged(value);
+            _setDirty();
         }
 
         void WindowSettings::setBackgroundImage(const std::string& value)
         {
             _p->backgroundImage->setIfChanged(value);
+            _setDirty();
         }
 
         void WindowSettings::load(const picojson::value & value)
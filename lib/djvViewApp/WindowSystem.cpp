@@ -242,6 +242,7 @@ namespace djv
         {
             auto out = std::shared_ptr<WindowSystem>(new WindowSystem);
             out->_init(context);
+            out->_setStartupEnd();
             return out;
         }
 
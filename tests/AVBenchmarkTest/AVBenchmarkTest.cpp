@@ -0,0 +1,840 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCmdLineApp/Application.h>
+
+#include <djvAV/DPX.h>
+#include <djvAV/IO.h>
+#include <djvAV/ImageAtlasPacker.h>
+#include <djvAV/ImageData.h>
+#include <djvAV/ImageStats.h>
+#include <djvAV/OpenGLMesh.h>
+#include <djvAV/Render2DImageProcessor.h>
+#include <djvAV/Render2DRasterizer.h>
+#include <djvAV/TriangleMesh.h>
+#include <djvAV/TriangleMeshBVH.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/Memory.h>
+
+#include <glm/geometric.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <set>
+#include <thread>
+
+using namespace djv;
+using namespace djv::AV;
+
+namespace
+{
+    //! Create a bumpy grid in the XZ plane.
+    std::shared_ptr<Geom::TriangleMesh> createGrid(size_t size)
+    {
+        auto out = std::make_shared<Geom::TriangleMesh>();
+        std::mt19937 rng;
+        std::uniform_real_distribution<float> height(0.F, .5F);
+        for (size_t y = 0; y <= size; ++y)
+        {
+            for (size_t x = 0; x <= size; ++x)
+            {
+                out->v.push_back(glm::vec3(x, height(rng), y));
+            }
+        }
+        for (size_t y = 0; y < size; ++y)
+        {
+            for (size_t x = 0; x < size; ++x)
+            {
+                const size_t i = y * (size + 1) + x + 1;
+                Geom::TriangleMesh::Triangle a;
+                a.v0.v = i;
+                a.v1.v = i + 1;
+                a.v2.v = i + size + 2;
+                out->triangles.push_back(a);
+                Geom::TriangleMesh::Triangle b;
+                b.v0.v = i;
+                b.v1.v = i + size + 2;
+                b.v2.v = i + size + 1;
+                out->triangles.push_back(b);
+            }
+        }
+        out->bboxUpdate();
+        return out;
+    }
+
+    //! Create a grid in the XZ plane with shared positions and texture
+    //! coordinates. Faceted grids have a normal for each quad.
+    Geom::TriangleMesh createTexturedGrid(size_t size, bool faceted)
+    {
+        Geom::TriangleMesh out;
+        for (size_t y = 0; y <= size; ++y)
+        {
+            for (size_t x = 0; x <= size; ++x)
+            {
+                out.v.push_back(glm::vec3(x, 0.F, y));
+                out.t.push_back(glm::vec2(x / static_cast<float>(size), y / static_cast<float>(size)));
+            }
+        }
+        for (size_t y = 0; y < size; ++y)
+        {
+            for (size_t x = 0; x < size; ++x)
+            {
+                const size_t i = y * (size + 1) + x + 1;
+                size_t n = 0;
+                if (faceted)
+                {
+                    out.n.push_back(glm::vec3(0.F, 1.F, 0.F));
+                    n = out.n.size();
+                }
+                Geom::TriangleMesh::Triangle a;
+                a.v0 = Geom::TriangleMesh::Vertex(i, i, n);
+                a.v1 = Geom::TriangleMesh::Vertex(i + 1, i + 1, n);
+                a.v2 = Geom::TriangleMesh::Vertex(i + size + 2, i + size + 2, n);
+                out.triangles.push_back(a);
+                Geom::TriangleMesh::Triangle b;
+                b.v0 = Geom::TriangleMesh::Vertex(i, i, n);
+                b.v1 = Geom::TriangleMesh::Vertex(i + size + 2, i + size + 2, n);
+                b.v2 = Geom::TriangleMesh::Vertex(i + size + 1, i + size + 1, n);
+                out.triangles.push_back(b);
+            }
+        }
+        out.bboxUpdate();
+        return out;
+    }
+
+    std::vector<Geom::Ray> createRays(size_t count, float size)
+    {
+        std::vector<Geom::Ray> out;
+        std::mt19937 rng;
+        std::uniform_real_distribution<float> pos(-1.F, size + 1.F);
+        std::uniform_real_distribution<float> dir(-.5F, .5F);
+        for (size_t i = 0; i < count; ++i)
+        {
+            out.push_back(Geom::Ray(
+                glm::vec3(pos(rng), 10.F, pos(rng)),
+                glm::normalize(glm::vec3(dir(rng), -1.F, dir(rng)))));
+        }
+        return out;
+    }
+
+    float getMilliseconds(
+        const std::chrono::steady_clock::time_point& t0,
+        const std::chrono::steady_clock::time_point& t1)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() / 1000.F;
+    }
+
+    void triangleMeshBVH(const std::shared_ptr<Core::Context>&)
+    {
+        auto mesh = createGrid(512);
+        const auto rays = createRays(10000, 512.F);
+
+        auto t0 = std::chrono::steady_clock::now();
+        auto bvh = mesh->getBVH();
+        auto t1 = std::chrono::steady_clock::now();
+        const float build = getMilliseconds(t0, t1);
+
+        t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < 100; ++i)
+        {
+            glm::vec3 hit;
+            Geom::TriangleMesh::intersect(rays[i].pos, rays[i].dir, *mesh, hit);
+        }
+        t1 = std::chrono::steady_clock::now();
+        const float mesh100 = getMilliseconds(t0, t1);
+
+        t0 = std::chrono::steady_clock::now();
+        for (const auto& i : rays)
+        {
+            Geom::RayHit hit;
+            bvh->intersect(i, hit);
+        }
+        t1 = std::chrono::steady_clock::now();
+        const float single = getMilliseconds(t0, t1);
+
+        t0 = std::chrono::steady_clock::now();
+        std::vector<Geom::RayHit> hits;
+        bvh->intersect(rays, hits);
+        t1 = std::chrono::steady_clock::now();
+        const float batch = getMilliseconds(t0, t1);
+
+        std::cout << "triangles: " << mesh->triangles.size() <<
+            ", nodes: " << bvh->getNodeCount() <<
+            ", build: " << build << "ms" <<
+            ", mesh: " << mesh100 * 10.F << "us/ray" <<
+            ", BVH: " << single * 1000.F / rays.size() << "us/ray" <<
+            ", BVH batch: " << batch * 1000.F / rays.size() << "us/ray" << std::endl;
+    }
+
+    void triangleMeshWeld(const std::shared_ptr<Core::Context>&)
+    {
+        const auto type = OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10;
+        for (const bool faceted : { false, true })
+        {
+            const auto mesh = createTexturedGrid(512, faceted);
+
+            auto t0 = std::chrono::steady_clock::now();
+            const auto data = OpenGL::VBO::convert(mesh, type);
+            auto t1 = std::chrono::steady_clock::now();
+            const float unindexed = getMilliseconds(t0, t1);
+
+            t0 = std::chrono::steady_clock::now();
+            std::vector<Geom::TriangleMesh::Vertex> vertices;
+            std::vector<uint32_t> indices;
+            Geom::TriangleMesh::weld(mesh, vertices, indices);
+            auto t2 = std::chrono::steady_clock::now();
+            Geom::TriangleMesh::optimizeVertexCache(indices, vertices.size());
+            auto t3 = std::chrono::steady_clock::now();
+            const auto indexedData = OpenGL::VBO::convert(mesh, vertices, type);
+            t1 = std::chrono::steady_clock::now();
+            const size_t indexedBytes = indexedData.size() + indices.size() * sizeof(uint32_t);
+
+            std::cout << (faceted ? "faceted" : "smooth") << " grid" <<
+                ", triangles: " << mesh.triangles.size() <<
+                ", unindexed: " << data.size() / 1024 << "KB " << unindexed << "ms" <<
+                ", indexed: " << indexedBytes / 1024 << "KB " << getMilliseconds(t0, t1) << "ms" <<
+                " (weld " << getMilliseconds(t0, t2) << "ms, optimize " << getMilliseconds(t2, t3) << "ms)" <<
+                ", vertices: " << vertices.size() <<
+                ", ACMR: " << Geom::TriangleMesh::getACMR(indices, 32) << std::endl;
+        }
+    }
+
+    void imageStats(const std::shared_ptr<Core::Context>&)
+    {
+        for (const auto type : { Image::Type::RGBA_U8, Image::Type::RGBA_F16, Image::Type::RGBA_F32 })
+        {
+            auto data = Image::Data::create(Image::Info(4096, 2160, type));
+            data->zero();
+            float times[2] = { 0.F, 0.F };
+            for (size_t i = 0; i < 2; ++i)
+            {
+                Image::StatsOptions options;
+                options.threadCount = 0 == i ? 1 : 0;
+                const auto t0 = std::chrono::steady_clock::now();
+                Image::getStats(*data, options);
+                const auto t1 = std::chrono::steady_clock::now();
+                times[i] = getMilliseconds(t0, t1);
+            }
+            std::cout << type << " 4096x2160" <<
+                ", single thread: " << times[0] << "ms" <<
+                ", parallel: " << times[1] << "ms" << std::endl;
+        }
+    }
+
+    void fileIO(const std::shared_ptr<Core::Context>&)
+    {
+        const std::string fileName = "AVBenchmarkTest.fileIO";
+        const size_t size = 256 * Core::Memory::megabyte;
+        std::vector<uint8_t> data(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[i] = static_cast<uint8_t>(i);
+        }
+        {
+            auto io = Core::FileSystem::FileIO::create();
+            io->open(fileName, Core::FileSystem::FileIO::Mode::Write);
+            io->write(data.data(), size);
+        }
+        for (auto readType : Core::FileSystem::getReadTypeEnums())
+        {
+            auto io = Core::FileSystem::FileIO::create();
+            io->setReadType(readType);
+            std::vector<uint8_t> buf(size);
+            const auto t0 = std::chrono::steady_clock::now();
+            io->open(fileName, Core::FileSystem::FileIO::Mode::Read);
+            io->read(buf.data(), size);
+            const auto t1 = std::chrono::steady_clock::now();
+            const float ms = getMilliseconds(t0, t1);
+            std::cout << readType << ": " << ms << "ms" << ", " <<
+                (size / static_cast<float>(Core::Memory::megabyte)) / (ms / 1000.F) << " MB/s" << std::endl;
+        }
+    }
+
+    void dpx(const std::shared_ptr<Core::Context>&)
+    {
+        struct Data
+        {
+            std::string name;
+            uint8_t bitDepth;
+            IO::DPX::Components packing;
+        };
+        const size_t w = 4096;
+        const size_t h = 2160;
+        for (const auto& i : {
+            Data({ "10-bit method A", 10, IO::DPX::Components::TypeA }),
+            Data({ "10-bit method B", 10, IO::DPX::Components::TypeB }),
+            Data({ "12-bit method A", 12, IO::DPX::Components::TypeA }),
+            Data({ "12-bit method B", 12, IO::DPX::Components::TypeB }),
+            Data({ "16-bit", 16, IO::DPX::Components::TypeA }) })
+        {
+            const size_t size = 10 == i.bitDepth ? (w * h) : (w * h * 3);
+            const size_t wordSize = 10 == i.bitDepth ? 4 : 2;
+            std::vector<uint8_t> in(size * wordSize, 0);
+            std::vector<uint8_t> out(size * wordSize);
+            float times[2] = { 0.F, 0.F };
+            for (size_t j = 0; j < 2; ++j)
+            {
+                const bool endian = 1 == j;
+                const auto t0 = std::chrono::steady_clock::now();
+                for (size_t y = 0; y < h; ++y)
+                {
+                    const size_t offset = y * (size / h) * wordSize;
+                    IO::DPX::convert(in.data() + offset, out.data() + offset, size / h, i.bitDepth, i.packing, endian);
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                times[j] = getMilliseconds(t0, t1);
+            }
+            std::cout << i.name << " 4096x2160: " << times[0] << "ms" << ", endian: " << times[1] << "ms" << std::endl;
+        }
+    }
+
+    //! Get a pixel value for the RLE encoded files. The left half of each
+    //! scanline compresses to runs and the right half to verbatim packets.
+    uint8_t getRLEValue(size_t x, size_t y, size_t c, size_t w)
+    {
+        return static_cast<uint8_t>(x < w / 2 ?
+            (y * 5 + c * 40) :
+            (x * 7 + y * 3 + c * 13));
+    }
+
+    struct RLEPacket
+    {
+        bool   run;
+        size_t start;
+        size_t count;
+    };
+
+    std::vector<RLEPacket> getRLEPackets(const std::vector<uint8_t>& values, size_t max)
+    {
+        std::vector<RLEPacket> out;
+        const size_t size = values.size();
+        size_t i = 0;
+        while (i < size)
+        {
+            size_t j = i + 1;
+            while (j < size && j - i < max && values[j] == values[i])
+            {
+                ++j;
+            }
+            if (j - i > 1)
+            {
+                out.push_back({ true, i, j - i });
+            }
+            else
+            {
+                while (j < size && j - i < max && !(j + 1 < size && values[j] == values[j + 1]))
+                {
+                    ++j;
+                }
+                out.push_back({ false, i, j - i });
+            }
+            i = j;
+        }
+        return out;
+    }
+
+    void writeU16BE(std::vector<uint8_t>& data, uint16_t value)
+    {
+        data.push_back(value >> 8);
+        data.push_back(value & 0xff);
+    }
+
+    void writeU32BE(std::vector<uint8_t>& data, uint32_t value)
+    {
+        writeU16BE(data, value >> 16);
+        writeU16BE(data, value & 0xffff);
+    }
+
+    void writeU16LE(std::vector<uint8_t>& data, uint16_t value)
+    {
+        data.push_back(value & 0xff);
+        data.push_back(value >> 8);
+    }
+
+    void setU16BE(std::vector<uint8_t>& data, size_t offset, uint16_t value)
+    {
+        data[offset] = value >> 8;
+        data[offset + 1] = value & 0xff;
+    }
+
+    void setU32BE(std::vector<uint8_t>& data, size_t offset, uint32_t value)
+    {
+        setU16BE(data, offset, value >> 16);
+        setU16BE(data, offset + 2, value & 0xffff);
+    }
+
+    void writeIFFChunk(std::vector<uint8_t>& data, const char* type, const std::vector<uint8_t>& chunk)
+    {
+        data.insert(data.end(), type, type + 4);
+        writeU32BE(data, static_cast<uint32_t>(chunk.size()));
+        data.insert(data.end(), chunk.begin(), chunk.end());
+        while (data.size() % 4)
+        {
+            data.push_back(0);
+        }
+    }
+
+    //! Create an RGBA IFF file with 64x64 RLE compressed tiles.
+    std::vector<uint8_t> createIFF(uint16_t w, uint16_t h)
+    {
+        const uint16_t tileSize = 64;
+        const uint16_t tilesX = w / tileSize;
+        const uint16_t tilesY = h / tileSize;
+        std::vector<uint8_t> out;
+        {
+            std::vector<uint8_t> tbhd;
+            writeU32BE(tbhd, w);
+            writeU32BE(tbhd, h);
+            writeU16BE(tbhd, 1);
+            writeU16BE(tbhd, 1);
+            writeU32BE(tbhd, 0x00000003);
+            writeU16BE(tbhd, 0);
+            writeU16BE(tbhd, tilesX * tilesY);
+            writeU32BE(tbhd, 1);
+            std::vector<uint8_t> cimg = { 'C', 'I', 'M', 'G' };
+            writeIFFChunk(cimg, "TBHD", tbhd);
+            writeIFFChunk(out, "FOR4", cimg);
+        }
+        std::vector<uint8_t> tbmp = { 'T', 'B', 'M', 'P' };
+        for (uint16_t ty = 0; ty < tilesY; ++ty)
+        {
+            for (uint16_t tx = 0; tx < tilesX; ++tx)
+            {
+                const uint16_t xmin = tx * tileSize;
+                const uint16_t ymin = ty * tileSize;
+                const uint16_t xmax = xmin + tileSize - 1;
+                const uint16_t ymax = ymin + tileSize - 1;
+                std::vector<uint8_t> rgba;
+                writeU16BE(rgba, xmin);
+                writeU16BE(rgba, ymin);
+                writeU16BE(rgba, xmax);
+                writeU16BE(rgba, ymax);
+                for (int c = 3; c >= 0; --c)
+                {
+                    std::vector<uint8_t> plane;
+                    for (size_t y = ymin; y <= ymax; ++y)
+                    {
+                        for (size_t x = xmin; x <= xmax; ++x)
+                        {
+                            plane.push_back(getRLEValue(x, y, c, w));
+                        }
+                    }
+                    for (const auto& packet : getRLEPackets(plane, 128))
+                    {
+                        rgba.push_back((packet.run ? 0x80 : 0) | static_cast<uint8_t>(packet.count - 1));
+                        rgba.insert(
+                            rgba.end(),
+                            plane.begin() + packet.start,
+                            plane.begin() + packet.start + (packet.run ? 1 : packet.count));
+                    }
+                }
+                writeIFFChunk(tbmp, "RGBA", rgba);
+            }
+        }
+        writeIFFChunk(out, "FOR4", tbmp);
+        return out;
+    }
+
+    //! Create an RGB SGI file with RLE compression.
+    std::vector<uint8_t> createSGI(uint16_t w, uint16_t h)
+    {
+        const size_t channels = 3;
+        std::vector<uint8_t> out(512, 0);
+        setU16BE(out, 0, 474);
+        out[2] = 1;
+        out[3] = 1;
+        setU16BE(out, 4, 3);
+        setU16BE(out, 6, w);
+        setU16BE(out, 8, h);
+        setU16BE(out, 10, static_cast<uint16_t>(channels));
+        const size_t tableSize = h * channels;
+        out.resize(out.size() + tableSize * 8, 0);
+        for (size_t c = 0; c < channels; ++c)
+        {
+            for (size_t y = 0; y < h; ++y)
+            {
+                const size_t offset = out.size();
+                std::vector<uint8_t> values;
+                for (size_t x = 0; x < w; ++x)
+                {
+                    values.push_back(getRLEValue(x, y, c, w));
+                }
+                for (const auto& packet : getRLEPackets(values, 127))
+                {
+                    out.push_back((packet.run ? 0 : 0x80) | static_cast<uint8_t>(packet.count));
+                    out.insert(
+                        out.end(),
+                        values.begin() + packet.start,
+                        values.begin() + packet.start + (packet.run ? 1 : packet.count));
+                }
+                out.push_back(0);
+                setU32BE(out, 512 + (y + h * c) * 4, static_cast<uint32_t>(offset));
+                setU32BE(out, 512 + (tableSize + y + h * c) * 4, static_cast<uint32_t>(out.size() - offset));
+            }
+        }
+        return out;
+    }
+
+    //! Create an RGBA RLA file.
+    std::vector<uint8_t> createRLA(uint16_t w, uint16_t h)
+    {
+        const size_t channels = 4;
+        std::vector<uint8_t> out(740, 0);
+        setU16BE(out, 2, w - 1);
+        setU16BE(out, 6, h - 1);
+        setU16BE(out, 10, w - 1);
+        setU16BE(out, 14, h - 1);
+        setU16BE(out, 20, 3);
+        setU16BE(out, 22, 1);
+        setU16BE(out, 658, 8);
+        setU16BE(out, 662, 8);
+        out.resize(out.size() + h * 4, 0);
+        for (size_t y = 0; y < h; ++y)
+        {
+            setU32BE(out, 740 + y * 4, static_cast<uint32_t>(out.size()));
+            for (size_t c = 0; c < channels; ++c)
+            {
+                std::vector<uint8_t> values;
+                for (size_t x = 0; x < w; ++x)
+                {
+                    values.push_back(getRLEValue(x, y, c, w));
+                }
+                std::vector<uint8_t> channel;
+                for (const auto& packet : getRLEPackets(values, 128))
+                {
+                    if (packet.run)
+                    {
+                        channel.push_back(static_cast<uint8_t>(packet.count - 1));
+                        channel.push_back(values[packet.start]);
+                    }
+                    else
+                    {
+                        channel.push_back(static_cast<uint8_t>(-static_cast<int>(packet.count)));
+                        channel.insert(
+                            channel.end(),
+                            values.begin() + packet.start,
+                            values.begin() + packet.start + packet.count);
+                    }
+                }
+                writeU16BE(out, static_cast<uint16_t>(channel.size()));
+                out.insert(out.end(), channel.begin(), channel.end());
+            }
+        }
+        return out;
+    }
+
+    //! Create an RGBA Targa file with RLE compression.
+    std::vector<uint8_t> createTarga(uint16_t w, uint16_t h)
+    {
+        const size_t channels = 4;
+        std::vector<uint8_t> out;
+        out.push_back(0);
+        out.push_back(0);
+        out.push_back(10);
+        writeU16LE(out, 0);
+        writeU16LE(out, 0);
+        out.push_back(0);
+        writeU16LE(out, 0);
+        writeU16LE(out, 0);
+        writeU16LE(out, w);
+        writeU16LE(out, h);
+        out.push_back(static_cast<uint8_t>(channels * 8));
+        out.push_back(0x28);
+        for (size_t y = 0; y < h; ++y)
+        {
+            std::vector<uint8_t> values;
+            for (size_t x = 0; x < w; ++x)
+            {
+                values.push_back(getRLEValue(x, y, 0, w));
+            }
+            for (const auto& packet : getRLEPackets(values, 128))
+            {
+                out.push_back((packet.run ? 0x80 : 0) | static_cast<uint8_t>(packet.count - 1));
+                for (size_t j = 0; j < (packet.run ? 1 : packet.count); ++j)
+                {
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        out.push_back(values[packet.start + j] + static_cast<uint8_t>(c * 40));
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    std::shared_ptr<Image::Image> readImage(
+        const std::shared_ptr<Core::Context>& context,
+        const std::string& fileName,
+        size_t decodeThreadCount)
+    {
+        std::shared_ptr<Image::Image> out;
+        auto io = context->getSystemT<IO::System>();
+        IO::ReadOptions options;
+        options.decodeThreadCount = decodeThreadCount;
+        auto read = io->read(Core::FileSystem::FileInfo(fileName), options);
+        bool running = true;
+        while (running)
+        {
+            {
+                std::lock_guard<std::mutex> lock(read->getMutex());
+                auto& readQueue = read->getVideoQueue();
+                if (!readQueue.isEmpty())
+                {
+                    out = readQueue.popFrame().image;
+                    running = false;
+                }
+                else if (readQueue.isFinished())
+                {
+                    running = false;
+                }
+            }
+            if (running)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        return out;
+    }
+
+    void ioDecode(const std::shared_ptr<Core::Context>& context)
+    {
+        const uint16_t w = 2048;
+        const uint16_t h = 1536;
+        struct Data
+        {
+            std::string fileName;
+            std::function<std::vector<uint8_t>(uint16_t, uint16_t)> create;
+        };
+        for (const auto& i : {
+            Data({ "AVBenchmarkTest.iff", createIFF }),
+            Data({ "AVBenchmarkTest.sgi", createSGI }),
+            Data({ "AVBenchmarkTest.rla", createRLA }),
+            Data({ "AVBenchmarkTest.tga", createTarga }) })
+        {
+            {
+                const auto data = i.create(w, h);
+                auto io = Core::FileSystem::FileIO::create();
+                io->open(i.fileName, Core::FileSystem::FileIO::Mode::Write);
+                io->write(data.data(), data.size());
+            }
+
+            // Read the file once first so it is in the page cache.
+            readImage(context, i.fileName, 1);
+            const size_t threadCounts[] = { 1, std::max(std::thread::hardware_concurrency(), 2U) };
+            float times[2] = { 0.F, 0.F };
+            for (size_t j = 0; j < 2; ++j)
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                auto image = readImage(context, i.fileName, threadCounts[j]);
+                const auto t1 = std::chrono::steady_clock::now();
+                if (!image)
+                {
+                    throw std::runtime_error(i.fileName + ": cannot read the file");
+                }
+                times[j] = getMilliseconds(t0, t1);
+            }
+            std::cout << i.fileName << " " << w << "x" << h <<
+                ", single thread: " << times[0] << "ms" <<
+                ", parallel: " << times[1] << "ms" << std::endl;
+        }
+    }
+
+    void imageAtlasPacker(const std::shared_ptr<Core::Context>&)
+    {
+        Image::AtlasPacker packer(2, 1024, 1);
+        std::mt19937 rng;
+        std::uniform_int_distribution<int> size(4, 48);
+        std::vector<Core::UID> uids;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < 20000; ++i)
+        {
+            Image::AtlasPackerItem item;
+            uids.push_back(packer.addItem(size(rng), size(rng), item));
+            if (uids.size() > 16)
+            {
+                packer.getItem(uids[uids.size() - 16], item);
+            }
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        std::cout << "items: " << packer.getItemCount() <<
+            ", evictions: " << packer.getEvictionCount() <<
+            ", used: " << packer.getPercentageUsed() << "%" <<
+            ", fragmentation: " << packer.getFragmentation() << "%" <<
+            ", 20000 adds: " << getMilliseconds(t0, t1) << "ms" << std::endl;
+    }
+
+    void render2DImageProcessor(const std::shared_ptr<Core::Context>&)
+    {
+        auto data = Image::Data::create(Image::Info(4096, 2160, Image::Type::RGBA_U8));
+        data->zero();
+        Render2D::ImageOptions options;
+        options.colorEnabled = true;
+        options.color.brightness = 1.5F;
+        options.levelsEnabled = true;
+        options.levels.gamma = 2.2F;
+        options.exposureEnabled = true;
+        options.softClipEnabled = true;
+        options.softClip = .2F;
+        float times[2] = { 0.F, 0.F };
+        for (size_t i = 0; i < 2; ++i)
+        {
+            auto processor = Render2D::ImageProcessor::create(options, 0 == i ? 1 : 0);
+            const auto t0 = std::chrono::steady_clock::now();
+            processor->process(*data);
+            const auto t1 = std::chrono::steady_clock::now();
+            times[i] = getMilliseconds(t0, t1);
+        }
+        std::cout << "4096x2160" <<
+            ", single thread: " << times[0] << "ms" <<
+            ", parallel: " << times[1] << "ms" << std::endl;
+    }
+
+    void render2DRasterizer(const std::shared_ptr<Core::Context>&)
+    {
+        const Image::Size size(1920, 1080);
+        auto image = Image::Image::create(Image::Info(640, 360, Image::Type::RGB_U8));
+        for (uint16_t y = 0; y < image->getHeight(); ++y)
+        {
+            uint8_t* p = image->getData(y);
+            for (uint16_t x = 0; x < image->getWidth(); ++x, p += 3)
+            {
+                p[0] = static_cast<uint8_t>(x);
+                p[1] = static_cast<uint8_t>(y);
+                p[2] = static_cast<uint8_t>(x + y);
+            }
+        }
+        glm::mat3x3 transform(1.F);
+        transform[2][0] = 100.F;
+        transform[2][1] = 100.F;
+        float times[2] = { 0.F, 0.F };
+        for (size_t i = 0; i < 2; ++i)
+        {
+            auto rasterizer = Render2D::Rasterizer::create(0 == i ? 1 : 0);
+            const auto t0 = std::chrono::steady_clock::now();
+            rasterizer->beginFrame(size);
+            rasterizer->setFillColor(Image::Color(.2F, .2F, .2F));
+            rasterizer->drawRect(Core::BBox2f(0.F, 0.F, size.w, size.h));
+            rasterizer->pushTransform(transform);
+            rasterizer->drawImage(image, glm::vec2(0.F, 0.F));
+            rasterizer->popTransform();
+            for (size_t j = 0; j < 200; ++j)
+            {
+                const float x = static_cast<float>((j * 97) % size.w);
+                const float y = static_cast<float>((j * 61) % size.h);
+                rasterizer->setFillColor(Image::Color(j % 3 / 2.F, j % 5 / 4.F, j % 7 / 6.F, .5F));
+                rasterizer->drawShadow(Core::BBox2f(x, y, 120.F, 40.F), 8.F);
+                rasterizer->drawPill(Core::BBox2f(x + 8.F, y + 8.F, 104.F, 24.F));
+                rasterizer->drawCircle(glm::vec2(y, x / 2.F), 20.F);
+                rasterizer->drawPolyline({ glm::vec2(x, y), glm::vec2(y, x / 2.F), glm::vec2(x / 2.F, y / 2.F) });
+            }
+            rasterizer->endFrame();
+            const auto t1 = std::chrono::steady_clock::now();
+            times[i] = getMilliseconds(t0, t1);
+        }
+        std::cout << "1920x1080" << ", single thread: " << times[0] << "ms" << ", parallel: " << times[1] << "ms" << std::endl;
+    }
+
+    struct Benchmark
+    {
+        std::string name;
+        std::function<void(const std::shared_ptr<Core::Context>&)> function;
+    };
+
+    const std::vector<Benchmark> benchmarks =
+    {
+        { "TriangleMeshBVH", triangleMeshBVH },
+        { "TriangleMeshWeld", triangleMeshWeld },
+        { "ImageStats", imageStats },
+        { "FileIO", fileIO },
+        { "DPX", dpx },
+        { "IODecode", ioDecode },
+        { "ImageAtlasPacker", imageAtlasPacker },
+        { "Render2DImageProcessor", render2DImageProcessor },
+        { "Render2DRasterizer", render2DRasterizer }
+    };
+
+} // namespace
+
+class Application : public CmdLine::Application
+{
+    DJV_NON_COPYABLE(Application);
+
+protected:
+    void _init(std::list<std::string>&);
+
+    Application();
+
+public:
+    static std::shared_ptr<Application> create(std::list<std::string>&);
+
+    void run() override;
+
+protected:
+    void _parseCmdLine(std::list<std::string>&) override;
+
+private:
+    std::set<std::string> _names;
+};
+
+void Application::_init(std::list<std::string>& args)
+{
+    CmdLine::Application::_init(args);
+    _parseCmdLine(args);
+}
+
+Application::Application()
+{}
+
+std::shared_ptr<Application> Application::create(std::list<std::string>& args)
+{
+    auto out = std::shared_ptr<Application>(new Application);
+    out->_init(args);
+    return out;
+}
+
+void Application::run()
+{
+    for (const auto& i : benchmarks)
+    {
+        if (_names.empty() || _names.find(i.name) != _names.end())
+        {
+            std::cout << i.name << std::endl;
+            i.function(shared_from_this());
+        }
+    }
+}
+
+void Application::_parseCmdLine(std::list<std::string>& args)
+{
+    CmdLine::Application::_parseCmdLine(args);
+
+    // The remaining arguments are the names of the benchmarks to run.
+    for (const auto& i : args)
+    {
+        _names.insert(i);
+    }
+    args.clear();
+}
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        auto args = Application::args(argc, argv);
+        auto app = Application::create(args);
+        app->run();
+        r = app->getExitCode();
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -94,6 +94,9 @@ public:
 
     void run() override;
 
+protected:
+    void _parseCmdLine(std::list<std::string>&) override;
+
 private:
     void _generateRandomNumbers();
     void _initRandomNumbers();
@@ -122,6 +125,7 @@ private:
 void Application::_init(std::list<std::string>& args)
 {
     CmdLine::Application::_init(args);
+    _parseCmdLine(args);
 
     _glfwWindow = getSystemT<AV::GLFW::System>()->getGLFWWindow();
     //glfwSetWindowSize(_glfwWindow, 1280, 720);
@@ -184,7 +188,29 @@ void Application::run()
         std::chrono::duration<float> delta = now - time;
         time = now;
         const float dt = delta.count();
-        std::cout << "FPS: " << (dt > 0.f ? 1.f / dt : 0.f) << std::endl;
+        std::cout << "FPS: " << (dt > 0.f ? 1.f / dt : 0.f) <<
+            ", texture atlas: " << _render2D->getTextureAtlasPercentage() << "%" <<
+            ", SDF texture atlas: " << _render2D->getSDFTextureAtlasPercentage() << "%" <<
+            ", glyph atlas misses: " << _render2D->getGlyphAtlasMissCount() << std::endl;
+    }
+}
+
+void Application::_parseCmdLine(std::list<std::string>& args)
+{
+    CmdLine::Application::_parseCmdLine(args);
+    auto i = args.begin();
+    while (i != args.end())
+    {
+        if ("-sdf" == *i)
+        {
+            // Draw the text with signed distance field glyphs.
+            i = args.erase(i);
+            getSystemT<AV::AVSystem>()->setSDFText(true);
+        }
+        else
+        {
+            ++i;
+        }
     }
 }
 
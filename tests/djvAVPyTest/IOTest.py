@@ -0,0 +1,48 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2020 Darby Johnston
+# All rights reserved.
+
+import djvCorePy.FileSystem as fs
+import djvCmdLineAppPy as c
+import djvAVPy.Image as i
+import djvAVPy.IO as io
+
+import sys
+import unittest
+
+class IOTest(unittest.TestCase):
+
+    def test_system(self):
+        app = c.Application.create(sys.argv)
+        s = io.System.get(app)
+        print("plugins: ", s.getPluginNames())
+        self.assertTrue(s.canRead(fs.FileInfo("IOTest.ppm")))
+
+    def test_readWrite(self):
+        app = c.Application.create(sys.argv)
+        s = io.System.get(app)
+        imageInfo = i.Info(16, 8, i.Type.RGB_U8)
+        image = i.Image.create(imageInfo)
+        v = memoryview(image)
+        for y in range(0, v.shape[0]):
+            for x in range(0, v.shape[1]):
+                for ch in range(0, v.shape[2]):
+                    v[y, x, ch] = 127
+        fileInfo = fs.FileInfo("AVPyIOTest.ppm")
+        write = s.write(fileInfo, io.Info(fileInfo.getFileName(), io.VideoInfo(imageInfo)))
+        write.addFrame(io.VideoFrame(0, image))
+        write.finish()
+        self.assertFalse(write.isRunning())
+
+        read = s.read(fileInfo)
+        info = read.getInfo()
+        self.assertEqual(len(info.video), 1)
+        self.assertEqual(info.video[0].info.size, imageInfo.size)
+        frames = [frame for frame in read]
+        self.assertEqual(len(frames), 1)
+        v = memoryview(frames[0].image)
+        self.assertEqual(v.shape, (8, 16, 3))
+        self.assertTrue(all(value == 127 for value in v.tobytes()))
+
+if __name__ == '__main__':
+    unittest.main()
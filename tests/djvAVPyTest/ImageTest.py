@@ -0,0 +1,49 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2020 Darby Johnston
+# All rights reserved.
+
+import djvAVPy.Image as i
+
+import unittest
+
+class ImageTest(unittest.TestCase):
+
+    def test_info(self):
+        info = i.Info(64, 32, i.Type.RGBA_U8)
+        self.assertEqual(info.size, i.Size(64, 32))
+        self.assertEqual(info.type, i.Type.RGBA_U8)
+        self.assertEqual(i.getChannelCount(info.type), 4)
+        self.assertEqual(info.getDataByteCount(), 64 * 32 * 4)
+
+    def test_buffer(self):
+        image = i.Image.create(i.Info(3, 2, i.Type.RGB_U16))
+        image.zero()
+        v = memoryview(image)
+        self.assertEqual(v.ndim, 3)
+        self.assertEqual(v.shape, (2, 3, 3))
+        self.assertEqual(v.strides, (18, 6, 2))
+        self.assertEqual(v.format, "H")
+        self.assertFalse(v.readonly)
+        v[1, 2, 0] = 65535
+        self.assertEqual(memoryview(image)[1, 2, 0], 65535)
+        self.assertEqual(memoryview(image).tolist()[1][2], [65535, 0, 0])
+
+    def test_mirror(self):
+        layout = i.Layout(i.Mirror(False, True))
+        image = i.Image.create(i.Info(2, 2, i.Type.L_F32, layout))
+        image.zero()
+        v = memoryview(image)
+        self.assertEqual(v.shape, (2, 2, 1))
+        self.assertEqual(v.strides, (-8, 4, 4))
+        self.assertEqual(v.format, "f")
+        v[0, 0, 0] = 1.0
+        self.assertEqual(v.tolist()[0][0], [1.0])
+
+    def test_u10(self):
+        image = i.Image.create(i.Info(4, 4, i.Type.RGB_U10))
+        v = memoryview(image)
+        self.assertEqual(v.shape, (4, 4))
+        self.assertEqual(v.itemsize, 4)
+
+if __name__ == '__main__':
+    unittest.main()
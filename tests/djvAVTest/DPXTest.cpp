@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/DPXTest.h>
+
+#include <djvAV/DPX.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/Memory.h>
+#include <djvCore/TextSystem.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            uint32_t getU10A(uint32_t r, uint32_t g, uint32_t b)
+            {
+                return (r << 22) | (g << 12) | (b << 2);
+            }
+
+            uint32_t getU10B(uint32_t r, uint32_t g, uint32_t b)
+            {
+                return (r << 20) | (g << 10) | b;
+            }
+
+        } // namespace
+
+        DPXTest::DPXTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::DPXTest", context)
+        {}
+
+        void DPXTest::run()
+        {
+            _convert();
+            _io();
+        }
+
+        void DPXTest::_convert()
+        {
+            for (const auto packing : { IO::DPX::Components::TypeA, IO::DPX::Components::TypeB })
+            {
+                for (const bool endian : { false, true })
+                {
+                    const uint32_t in[] =
+                    {
+                        IO::DPX::Components::TypeA == packing ? getU10A(1023, 512, 1) : getU10B(1023, 512, 1),
+                        IO::DPX::Components::TypeA == packing ? getU10A(0, 1, 2) : getU10B(0, 1, 2)
+                    };
+                    uint32_t data[2];
+                    memcpy(data, in, sizeof(in));
+                    if (endian)
+                    {
+                        Memory::endian(data, 2, 4);
+                    }
+                    uint32_t out[2];
+                    IO::DPX::convert(
+                        reinterpret_cast<const uint8_t*>(data),
+                        reinterpret_cast<uint8_t*>(out),
+                        2,
+                        10,
+                        packing,
+                        endian);
+                    DJV_ASSERT(getU10A(1023, 512, 1) == out[0]);
+                    DJV_ASSERT(getU10A(0, 1, 2) == out[1]);
+                }
+            }
+
+            for (const auto packing : { IO::DPX::Components::TypeA, IO::DPX::Components::TypeB })
+            {
+                for (const bool endian : { false, true })
+                {
+                    const uint16_t values[] = { 0, 1, 0x800, 0xfff };
+                    uint16_t data[4];
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        data[i] = IO::DPX::Components::TypeA == packing ? (values[i] << 4) : values[i];
+                    }
+                    if (endian)
+                    {
+                        Memory::endian(data, 4, 2);
+                    }
+                    uint16_t out[4];
+                    IO::DPX::convert(
+                        reinterpret_cast<const uint8_t*>(data),
+                        reinterpret_cast<uint8_t*>(out),
+                        4,
+                        12,
+                        packing,
+                        endian);
+                    DJV_ASSERT(0 == out[0]);
+                    DJV_ASSERT(0x0010 == out[1]);
+                    DJV_ASSERT(0x8008 == out[2]);
+                    DJV_ASSERT(0xffff == out[3]);
+                }
+            }
+
+            {
+                const uint16_t data[] = { 0x0102, 0x0304 };
+                uint16_t out[2];
+                IO::DPX::convert(
+                    reinterpret_cast<const uint8_t*>(data),
+                    reinterpret_cast<uint8_t*>(out),
+                    2,
+                    16,
+                    IO::DPX::Components::TypeA,
+                    true);
+                DJV_ASSERT(0x0201 == out[0]);
+                DJV_ASSERT(0x0403 == out[1]);
+            }
+        }
+
+        void DPXTest::_io()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto textSystem = context->getSystemT<TextSystem>();
+                struct Data
+                {
+                    Image::Type type;
+                    uint8_t bitDepth;
+                    IO::DPX::Components packing;
+                    uint32_t linePadding;
+                };
+                for (const auto& i : {
+                    Data({ Image::Type::RGB_U10, 10, IO::DPX::Components::TypeA, 8 }),
+                    Data({ Image::Type::RGB_U10, 10, IO::DPX::Components::TypeB, 0 }),
+                    Data({ Image::Type::RGB_U10, 10, IO::DPX::Components::TypeB, 4 }),
+                    Data({ Image::Type::RGB_U16, 12, IO::DPX::Components::TypeA, 0 }),
+                    Data({ Image::Type::RGB_U16, 12, IO::DPX::Components::TypeB, 6 }),
+                    Data({ Image::Type::RGB_U16, 16, IO::DPX::Components::TypeA, 2 }) })
+                {
+                    std::stringstream ss;
+                    ss << "DPXTest_" << i.type << "_" << static_cast<int>(i.bitDepth) << "_" <<
+                        static_cast<int>(i.packing) << "_" << i.linePadding << ".dpx";
+                    _print(ss.str());
+                    const std::string fileName = ss.str();
+                    const uint16_t w = 5;
+                    const uint16_t h = 3;
+                    const Image::Info imageInfo(w, h, i.type);
+
+                    // Write the file.
+                    for (const auto endian : { IO::DPX::Endian::MSB, IO::DPX::Endian::LSB })
+                    {
+                        {
+                            auto io = FileSystem::FileIO::create();
+                            io->open(fileName, FileSystem::FileIO::Mode::Write);
+                            IO::DPX::write(
+                                io,
+                                IO::Info(fileName, IO::VideoInfo(imageInfo)),
+                                IO::DPX::Version::_2_0,
+                                endian,
+                                IO::Cineon::ColorProfile::Raw);
+                            const std::vector<uint8_t> padding(i.linePadding, 0);
+                            for (uint16_t y = 0; y < h; ++y)
+                            {
+                                for (uint16_t x = 0; x < w; ++x)
+                                {
+                                    if (10 == i.bitDepth)
+                                    {
+                                        io->writeU32(IO::DPX::Components::TypeA == i.packing ?
+                                            getU10A(x, y, x + y) :
+                                            getU10B(x, y, x + y));
+                                    }
+                                    else
+                                    {
+                                        for (uint16_t c = 0; c < 3; ++c)
+                                        {
+                                            const uint16_t value = x * 100 + y * 10 + c;
+                                            io->writeU16(
+                                                12 == i.bitDepth && IO::DPX::Components::TypeA == i.packing ?
+                                                (value << 4) :
+                                                value);
+                                        }
+                                    }
+                                }
+                                if (y < h - 1)
+                                {
+                                    io->write(padding.data(), padding.size());
+                                }
+                            }
+                            IO::DPX::writeFinish(io);
+
+                            // Set the bit depth, packing, and line padding.
+                            io->setPos(803);
+                            io->writeU8(i.bitDepth);
+                            io->setPos(804);
+                            io->writeU16(static_cast<uint16_t>(i.packing));
+                            io->setPos(812);
+                            io->writeU32(i.linePadding);
+                        }
+
+                        // Read the file.
+                        auto io = FileSystem::FileIO::create();
+                        io->open(fileName, FileSystem::FileIO::Mode::Read);
+                        IO::Info info;
+                        info.video.resize(1);
+                        IO::Cineon::ColorProfile colorProfile = IO::Cineon::ColorProfile::Raw;
+                        const auto header = IO::DPX::read(io, info, colorProfile, textSystem);
+                        DJV_ASSERT(i.type == info.video[0].info.type);
+                        auto image = IO::DPX::readImage(info, header, io);
+                        DJV_ASSERT(Memory::getEndian() == image->getLayout().endian);
+                        for (uint16_t y = 0; y < h; ++y)
+                        {
+                            for (uint16_t x = 0; x < w; ++x)
+                            {
+                                if (10 == i.bitDepth)
+                                {
+                                    uint32_t value = 0;
+                                    memcpy(&value, image->getData(x, y), 4);
+                                    DJV_ASSERT(getU10A(x, y, x + y) == value);
+                                }
+                                else
+                                {
+                                    for (uint16_t c = 0; c < 3; ++c)
+                                    {
+                                        uint16_t value = 0;
+                                        memcpy(&value, image->getData(x, y) + c * 2, 2);
+                                        uint16_t expected = x * 100 + y * 10 + c;
+                                        if (12 == i.bitDepth)
+                                        {
+                                            expected = (expected << 4) | (expected >> 8);
+                                        }
+                                        DJV_ASSERT(expected == value);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
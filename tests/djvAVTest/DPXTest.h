@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class DPXTest : public Test::ITest
+        {
+        public:
+            DPXTest(const std::shared_ptr<Core::Context>&);
+
+            void run() override;
+
+        private:
+            void _convert();
+            void _io();
+        };
+
+    } // namespace AVTest
+} // namespace djv
@@ -27,6 +27,7 @@ namespace djv
             _textLine();
             _glyphInfo();
             _glyph();
+            _sdf();
             _system();
             _operators();
         }        
@@ -104,6 +105,37 @@ namespace djv
             }
         }
         
+        void FontSystemTest::_sdf()
+        {
+            auto data = Image::Data::create(Image::Info(11, 11, Image::Type::L_U8));
+            data->zero();
+            for (uint16_t y = 3; y <= 7; ++y)
+            {
+                for (uint16_t x = 3; x <= 7; ++x)
+                {
+                    *(data->getData(x, y)) = 255;
+                }
+            }
+            const uint16_t spread = 4;
+            auto sdf = Font::createSDF(*data, spread);
+            DJV_ASSERT(Image::Type::L_U8 == sdf->getType());
+            DJV_ASSERT(19 == sdf->getWidth());
+            DJV_ASSERT(19 == sdf->getHeight());
+
+            // The outline is half way between the inside and outside pixels.
+            DJV_ASSERT(143 == *(sdf->getData(7, 9)));
+            DJV_ASSERT(112 == *(sdf->getData(6, 9)));
+
+            // Values increase towards the center and are clamped outside of the spread.
+            for (uint16_t x = 1; x <= 9; ++x)
+            {
+                DJV_ASSERT(*(sdf->getData(x - 1, 9)) <= *(sdf->getData(x, 9)));
+            }
+            DJV_ASSERT(0 == *(sdf->getData(0, 0)));
+            DJV_ASSERT(0 == *(sdf->getData(0, 9)));
+            DJV_ASSERT(*(sdf->getData(9, 9)) > 128);
+        }
+
         void FontSystemTest::_system()
         {
             if (auto context = getContext().lock())
@@ -220,6 +252,78 @@ namespace djv
                     ss << "glyph cache percentage: " << system->getGlyphCachePercentage();
                     _print(ss.str());
                 }
+
+                // Repeat requests are answered from the text run cache.
+                measureFuture = system->measure(text, info);
+                DJV_ASSERT(measureFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                DJV_ASSERT(measure == measureFuture.get());
+                measureGlyphsFuture = system->measureGlyphs(text, info);
+                DJV_ASSERT(measureGlyphsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                DJV_ASSERT(measureGlyphs.size() == measureGlyphsFuture.get().size());
+                glyphsFuture = system->getGlyphs(text, info);
+                DJV_ASSERT(glyphsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                DJV_ASSERT(glyphs == glyphsFuture.get());
+                DJV_ASSERT(system->getTextRunCacheSize() > 0);
+                DJV_ASSERT(system->getTextRunCacheHitRate() > 0.F);
+                {
+                    std::stringstream ss;
+                    ss << "text run cache size: " << system->getTextRunCacheSize();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "text run cache percentage: " << system->getTextRunCachePercentage();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "text run cache hit rate: " << system->getTextRunCacheHitRate();
+                    _print(ss.str());
+                }
+
+                // Request enough new glyphs to be rasterized in parallel.
+                std::string ascii;
+                for (char c = 32; c < 127; ++c)
+                {
+                    ascii.push_back(c);
+                }
+                const Font::Info asciiInfo(1, 1, 21, dpiDefault);
+                glyphsFuture = system->getGlyphs(ascii, asciiInfo);
+                while (glyphsFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                {
+                    _tickFor(Time::getTime(Time::TimerValue::Fast));
+                }
+                glyphs = glyphsFuture.get();
+                DJV_ASSERT(ascii.size() == glyphs.size());
+                for (size_t i = 0; i < ascii.size(); ++i)
+                {
+                    DJV_ASSERT(glyphs[i]);
+                    DJV_ASSERT(static_cast<uint32_t>(ascii[i]) == glyphs[i]->info.code);
+                    DJV_ASSERT(asciiInfo == glyphs[i]->info.info);
+                }
+
+                // Signed distance field glyphs are shared between font sizes.
+                system->setSDFEnabled(true);
+                DJV_ASSERT(system->isSDFEnabled());
+                const Font::Info sdfInfo(1, 1, 24, dpiDefault);
+                const Font::Info sdfInfo2(1, 1, 96, dpiDefault);
+                glyphsFuture = system->getGlyphs("A", sdfInfo);
+                auto glyphsFuture2 = system->getGlyphs("A", sdfInfo2);
+                while (glyphsFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready ||
+                    glyphsFuture2.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                {
+                    _tickFor(Time::getTime(Time::TimerValue::Fast));
+                }
+                glyphs = glyphsFuture.get();
+                const auto glyphs2 = glyphsFuture2.get();
+                DJV_ASSERT(1 == glyphs.size() && 1 == glyphs2.size());
+                DJV_ASSERT(!glyphs[0]->imageData);
+                DJV_ASSERT(glyphs[0]->sdfData);
+                DJV_ASSERT(glyphs[0]->sdfData == glyphs2[0]->sdfData);
+                DJV_ASSERT(24.F / Font::sdfSize == glyphs[0]->sdfScale);
+                DJV_ASSERT(96.F / Font::sdfSize == glyphs2[0]->sdfScale);
+                DJV_ASSERT(1 == system->getSDFCacheSize());
+                system->setSDFEnabled(false);
             }
         }
 
@@ -21,6 +21,7 @@ namespace djv
             void _textLine();
             void _glyphInfo();
             void _glyph();
+            void _sdf();
             void _system();
             void _operators();
         };
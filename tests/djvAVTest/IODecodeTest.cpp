@@ -0,0 +1,520 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/IODecodeTest.h>
+
+#include <djvAV/IO.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/Timer.h>
+
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            const uint16_t w = 256;
+            const uint16_t h = 192;
+
+            // The left half of each scanline compresses to runs and the right
+            // half to verbatim packets.
+            uint16_t getValue(size_t x, size_t y, size_t c, size_t bytes)
+            {
+                const uint8_t value = static_cast<uint8_t>(x < w / 2 ?
+                    (y * 5 + c * 40) :
+                    (x * 7 + y * 3 + c * 13));
+                return 1 == bytes ? value : ((value << 8) | (255 - value));
+            }
+
+            struct Packet
+            {
+                bool   run;
+                size_t start;
+                size_t count;
+            };
+
+            std::vector<Packet> getPackets(const std::vector<uint32_t>& values, size_t max)
+            {
+                std::vector<Packet> out;
+                const size_t size = values.size();
+                size_t i = 0;
+                while (i < size)
+                {
+                    size_t j = i + 1;
+                    while (j < size && j - i < max && values[j] == values[i])
+                    {
+                        ++j;
+                    }
+                    if (j - i > 1)
+                    {
+                        out.push_back({ true, i, j - i });
+                    }
+                    else
+                    {
+                        while (j < size && j - i < max && !(j + 1 < size && values[j] == values[j + 1]))
+                        {
+                            ++j;
+                        }
+                        out.push_back({ false, i, j - i });
+                    }
+                    i = j;
+                }
+                return out;
+            }
+
+            void writeU8(std::vector<uint8_t>& data, uint8_t value)
+            {
+                data.push_back(value);
+            }
+
+            void writeU16BE(std::vector<uint8_t>& data, uint16_t value)
+            {
+                data.push_back(value >> 8);
+                data.push_back(value & 0xff);
+            }
+
+            void writeU32BE(std::vector<uint8_t>& data, uint32_t value)
+            {
+                writeU16BE(data, value >> 16);
+                writeU16BE(data, value & 0xffff);
+            }
+
+            void writeU16LE(std::vector<uint8_t>& data, uint16_t value)
+            {
+                data.push_back(value & 0xff);
+                data.push_back(value >> 8);
+            }
+
+            void writeValue(std::vector<uint8_t>& data, uint16_t value, size_t bytes)
+            {
+                if (1 == bytes)
+                {
+                    writeU8(data, static_cast<uint8_t>(value));
+                }
+                else
+                {
+                    writeU16BE(data, value);
+                }
+            }
+
+            void setU16BE(std::vector<uint8_t>& data, size_t offset, uint16_t value)
+            {
+                data[offset] = value >> 8;
+                data[offset + 1] = value & 0xff;
+            }
+
+            void setU32BE(std::vector<uint8_t>& data, size_t offset, uint32_t value)
+            {
+                setU16BE(data, offset, value >> 16);
+                setU16BE(data, offset + 2, value & 0xffff);
+            }
+
+            void writeChunk(std::vector<uint8_t>& data, const char* type, const std::vector<uint8_t>& chunk)
+            {
+                data.insert(data.end(), type, type + 4);
+                writeU32BE(data, static_cast<uint32_t>(chunk.size()));
+                data.insert(data.end(), chunk.begin(), chunk.end());
+                while (data.size() % 4)
+                {
+                    data.push_back(0);
+                }
+            }
+
+        } // namespace
+
+        IODecodeTest::IODecodeTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::IODecodeTest", context)
+        {}
+
+        void IODecodeTest::run()
+        {
+            _iff();
+            _sgi();
+            _rla();
+            _targa();
+        }
+
+        void IODecodeTest::_iff()
+        {
+            // Write a RLE compressed file with four tiles.
+            const Image::Info info(w, h, Image::Type::RGBA_U8);
+            std::vector<uint8_t> data;
+            {
+                std::vector<uint8_t> tbhd;
+                writeU32BE(tbhd, w);
+                writeU32BE(tbhd, h);
+                writeU16BE(tbhd, 1);
+                writeU16BE(tbhd, 1);
+                writeU32BE(tbhd, 0x00000003);
+                writeU16BE(tbhd, 0);
+                writeU16BE(tbhd, 4);
+                writeU32BE(tbhd, 1);
+                std::vector<uint8_t> cimg = { 'C', 'I', 'M', 'G' };
+                writeChunk(cimg, "TBHD", tbhd);
+                writeChunk(data, "FOR4", cimg);
+            }
+            std::vector<uint8_t> tbmp = { 'T', 'B', 'M', 'P' };
+            for (size_t ty = 0; ty < 2; ++ty)
+            {
+                for (size_t tx = 0; tx < 2; ++tx)
+                {
+                    const uint16_t xmin = static_cast<uint16_t>(tx * w / 2);
+                    const uint16_t ymin = static_cast<uint16_t>(ty * h / 2);
+                    const uint16_t xmax = static_cast<uint16_t>(xmin + w / 2 - 1);
+                    const uint16_t ymax = static_cast<uint16_t>(ymin + h / 2 - 1);
+                    std::vector<uint8_t> rgba;
+                    writeU16BE(rgba, xmin);
+                    writeU16BE(rgba, ymin);
+                    writeU16BE(rgba, xmax);
+                    writeU16BE(rgba, ymax);
+                    for (int c = 3; c >= 0; --c)
+                    {
+                        std::vector<uint32_t> plane;
+                        for (size_t y = ymin; y <= ymax; ++y)
+                        {
+                            for (size_t x = xmin; x <= xmax; ++x)
+                            {
+                                plane.push_back(getValue(x, y, c, 1));
+                            }
+                        }
+                        for (const auto& packet : getPackets(plane, 128))
+                        {
+                            writeU8(rgba, (packet.run ? 0x80 : 0) | static_cast<uint8_t>(packet.count - 1));
+                            for (size_t i = 0; i < (packet.run ? 1 : packet.count); ++i)
+                            {
+                                writeU8(rgba, static_cast<uint8_t>(plane[packet.start + i]));
+                            }
+                        }
+                    }
+                    writeChunk(tbmp, "RGBA", rgba);
+                }
+            }
+            writeChunk(data, "FOR4", tbmp);
+            const std::string fileName = "IODecodeTest.iff";
+            _write(fileName, data);
+
+            _read(fileName, info);
+        }
+
+        void IODecodeTest::_sgi()
+        {
+            struct Data
+            {
+                std::string fileName;
+                Image::Type type;
+                bool compression;
+            };
+            for (const auto& i : {
+                Data({ "IODecodeTest_rgb.sgi", Image::Type::RGB_U8, true }),
+                Data({ "IODecodeTest_l.sgi", Image::Type::L_U16, true }),
+                Data({ "IODecodeTest_raw.sgi", Image::Type::L_U16, false }) })
+            {
+                const Image::Info info(w, h, i.type);
+                const size_t channels = Image::getChannelCount(i.type);
+                const size_t bytes = Image::getByteCount(Image::getDataType(i.type));
+
+                // Write the header.
+                std::vector<uint8_t> data(512, 0);
+                setU16BE(data, 0, 474);
+                data[2] = i.compression ? 1 : 0;
+                data[3] = static_cast<uint8_t>(bytes);
+                setU16BE(data, 4, 3);
+                setU16BE(data, 6, w);
+                setU16BE(data, 8, h);
+                setU16BE(data, 10, static_cast<uint16_t>(channels));
+
+                if (i.compression)
+                {
+                    // Write the scanline tables and the RLE data.
+                    const size_t tableSize = h * channels;
+                    data.resize(data.size() + tableSize * 8, 0);
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        for (size_t y = 0; y < h; ++y)
+                        {
+                            const size_t offset = data.size();
+                            std::vector<uint32_t> values;
+                            for (size_t x = 0; x < w; ++x)
+                            {
+                                values.push_back(getValue(x, y, c, bytes));
+                            }
+                            for (const auto& packet : getPackets(values, 127))
+                            {
+                                const uint8_t count = (packet.run ? 0 : 0x80) | static_cast<uint8_t>(packet.count);
+                                writeValue(data, count, bytes);
+                                for (size_t j = 0; j < (packet.run ? 1 : packet.count); ++j)
+                                {
+                                    writeValue(data, static_cast<uint16_t>(values[packet.start + j]), bytes);
+                                }
+                            }
+                            writeValue(data, 0, bytes);
+                            setU32BE(data, 512 + (y + h * c) * 4, static_cast<uint32_t>(offset));
+                            setU32BE(data, 512 + (tableSize + y + h * c) * 4, static_cast<uint32_t>(data.size() - offset));
+                        }
+                    }
+                }
+                else
+                {
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        for (size_t y = 0; y < h; ++y)
+                        {
+                            for (size_t x = 0; x < w; ++x)
+                            {
+                                writeValue(data, getValue(x, y, c, bytes), bytes);
+                            }
+                        }
+                    }
+                }
+                _write(i.fileName, data);
+
+                _read(i.fileName, info);
+            }
+        }
+
+        void IODecodeTest::_rla()
+        {
+            struct Data
+            {
+                std::string fileName;
+                Image::Type type;
+                int16_t colorChannels;
+                int16_t matteChannels;
+            };
+            for (const auto& i : {
+                Data({ "IODecodeTest_rgba.rla", Image::Type::RGBA_U8, 3, 1 }),
+                Data({ "IODecodeTest_rgb.rla", Image::Type::RGB_U16, 3, 0 }) })
+            {
+                const Image::Info info(w, h, i.type);
+                const size_t channels = Image::getChannelCount(i.type);
+                const size_t bytes = Image::getByteCount(Image::getDataType(i.type));
+
+                // Write the header.
+                std::vector<uint8_t> data(740, 0);
+                setU16BE(data, 2, w - 1);
+                setU16BE(data, 6, h - 1);
+                setU16BE(data, 10, w - 1);
+                setU16BE(data, 14, h - 1);
+                setU16BE(data, 20, i.colorChannels);
+                setU16BE(data, 22, i.matteChannels);
+                setU16BE(data, 658, static_cast<uint16_t>(bytes * 8));
+                setU16BE(data, 662, static_cast<uint16_t>(bytes * 8));
+
+                // Write the scanline table and the RLE data. Each channel
+                // is stored as byte planes starting with the most
+                // significant byte.
+                data.resize(data.size() + h * 4, 0);
+                for (size_t y = 0; y < h; ++y)
+                {
+                    setU32BE(data, 740 + y * 4, static_cast<uint32_t>(data.size()));
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        std::vector<uint8_t> channel;
+                        for (size_t b = 0; b < bytes; ++b)
+                        {
+                            std::vector<uint32_t> values;
+                            for (size_t x = 0; x < w; ++x)
+                            {
+                                values.push_back((getValue(x, y, c, bytes) >> ((bytes - 1 - b) * 8)) & 0xff);
+                            }
+                            for (const auto& packet : getPackets(values, 128))
+                            {
+                                if (packet.run)
+                                {
+                                    writeU8(channel, static_cast<uint8_t>(packet.count - 1));
+                                    writeU8(channel, static_cast<uint8_t>(values[packet.start]));
+                                }
+                                else
+                                {
+                                    writeU8(channel, static_cast<uint8_t>(-static_cast<int>(packet.count)));
+                                    for (size_t j = 0; j < packet.count; ++j)
+                                    {
+                                        writeU8(channel, static_cast<uint8_t>(values[packet.start + j]));
+                                    }
+                                }
+                            }
+                        }
+                        writeU16BE(data, static_cast<uint16_t>(channel.size()));
+                        data.insert(data.end(), channel.begin(), channel.end());
+                    }
+                }
+                _write(i.fileName, data);
+
+                _read(i.fileName, info);
+            }
+        }
+
+        void IODecodeTest::_targa()
+        {
+            struct Data
+            {
+                std::string fileName;
+                Image::Type type;
+                size_t packetMax;
+                bool scanlines;
+            };
+            for (const auto& i : {
+                Data({ "IODecodeTest_rgba.tga", Image::Type::RGBA_U8, 128, true }),
+                Data({ "IODecodeTest_l.tga", Image::Type::L_U8, 100, false }) })
+            {
+                const Image::Info info(w, h, i.type);
+                const size_t channels = Image::getChannelCount(i.type);
+
+                // Write the header.
+                std::vector<uint8_t> data;
+                writeU8(data, 0);
+                writeU8(data, 0);
+                writeU8(data, 1 == channels ? 11 : 10);
+                writeU16LE(data, 0);
+                writeU16LE(data, 0);
+                writeU8(data, 0);
+                writeU16LE(data, 0);
+                writeU16LE(data, 0);
+                writeU16LE(data, w);
+                writeU16LE(data, h);
+                writeU8(data, static_cast<uint8_t>(channels * 8));
+                writeU8(data, 4 == channels ? 0x28 : 0x20);
+
+                // Write the RLE data. The second file uses packets that cross
+                // the scanline boundaries.
+                std::vector<uint32_t> values;
+                for (size_t y = 0; y < h; ++y)
+                {
+                    for (size_t x = 0; x < w; ++x)
+                    {
+                        uint32_t value = 0;
+                        for (size_t c = 0; c < channels; ++c)
+                        {
+                            const size_t bgr = channels >= 3 && c < 3 ? 2 - c : c;
+                            value |= getValue(x, y, bgr, 1) << (c * 8);
+                        }
+                        values.push_back(value);
+                    }
+                }
+                std::vector<Packet> packets;
+                if (i.scanlines)
+                {
+                    for (size_t y = 0; y < h; ++y)
+                    {
+                        const std::vector<uint32_t> scanline(values.begin() + y * w, values.begin() + (y + 1) * w);
+                        for (auto packet : getPackets(scanline, i.packetMax))
+                        {
+                            packet.start += y * w;
+                            packets.push_back(packet);
+                        }
+                    }
+                }
+                else
+                {
+                    for (size_t j = 0; j < values.size(); j += i.packetMax)
+                    {
+                        packets.push_back({ false, j, std::min(i.packetMax, values.size() - j) });
+                    }
+                }
+                for (const auto& packet : packets)
+                {
+                    writeU8(data, (packet.run ? 0x80 : 0) | static_cast<uint8_t>(packet.count - 1));
+                    for (size_t j = 0; j < (packet.run ? 1 : packet.count); ++j)
+                    {
+                        for (size_t c = 0; c < channels; ++c)
+                        {
+                            writeU8(data, (values[packet.start + j] >> (c * 8)) & 0xff);
+                        }
+                    }
+                }
+                _write(i.fileName, data);
+
+                _read(i.fileName, info);
+            }
+        }
+
+        void IODecodeTest::_write(const std::string& fileName, const std::vector<uint8_t>& data)
+        {
+            auto io = FileSystem::FileIO::create();
+            io->open(fileName, FileSystem::FileIO::Mode::Write);
+            io->write(data.data(), data.size());
+        }
+
+        void IODecodeTest::_read(const std::string& fileName, const Image::Info& info)
+        {
+            const size_t channels = Image::getChannelCount(info.type);
+            const size_t bytes = Image::getByteCount(Image::getDataType(info.type));
+            for (const size_t threadCount : { static_cast<size_t>(1), static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 2U)) })
+            {
+                auto image = _read(fileName, threadCount);
+                DJV_ASSERT(image);
+                DJV_ASSERT(image->getSize() == info.size);
+                DJV_ASSERT(image->getType() == info.type);
+                const bool endian = image->getLayout().endian != Memory::getEndian();
+                for (uint16_t y = 0; y < h; ++y)
+                {
+                    for (uint16_t x = 0; x < w; ++x)
+                    {
+                        const uint8_t* p = image->getData(x, y);
+                        for (size_t c = 0; c < channels; ++c, p += bytes)
+                        {
+                            uint16_t value = p[0];
+                            if (2 == bytes)
+                            {
+                                memcpy(&value, p, 2);
+                                if (endian)
+                                {
+                                    Memory::endian(&value, 1, 2);
+                                }
+                            }
+                            DJV_ASSERT(getValue(x, y, c, bytes) == value);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::shared_ptr<Image::Image> IODecodeTest::_read(const std::string& fileName, size_t decodeThreadCount)
+        {
+            std::shared_ptr<Image::Image> out;
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<AV::IO::System>();
+                IO::ReadOptions options;
+                options.decodeThreadCount = decodeThreadCount;
+                auto read = io->read(FileSystem::FileInfo(fileName), options);
+                bool running = true;
+                while (running)
+                {
+                    bool sleep = false;
+                    {
+                        std::lock_guard<std::mutex> lock(read->getMutex());
+                        auto& readQueue = read->getVideoQueue();
+                        if (!readQueue.isEmpty())
+                        {
+                            out = readQueue.popFrame().image;
+                            running = false;
+                        }
+                        else if (readQueue.isFinished())
+                        {
+                            running = false;
+                        }
+                        else
+                        {
+                            sleep = true;
+                        }
+                    }
+                    if (sleep)
+                    {
+                        std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                    }
+                }
+            }
+            return out;
+        }
+
+    } // namespace AVTest
+} // namespace djv
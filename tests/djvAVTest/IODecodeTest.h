@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+#include <djvAV/Image.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class IODecodeTest : public Test::ITest
+        {
+        public:
+            IODecodeTest(const std::shared_ptr<Core::Context>&);
+
+            void run() override;
+
+        private:
+            void _iff();
+            void _sgi();
+            void _rla();
+            void _targa();
+
+            void _write(const std::string& fileName, const std::vector<uint8_t>&);
+            void _read(const std::string& fileName, const AV::Image::Info&);
+            std::shared_ptr<AV::Image::Image> _read(const std::string& fileName, size_t decodeThreadCount);
+        };
+
+    } // namespace AVTest
+} // namespace djv
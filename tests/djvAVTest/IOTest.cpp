@@ -5,11 +5,15 @@
 #include <djvAVTest/IOTest.h>
 
 #include <djvAV/IO.h>
+#include <djvAV/Pixel.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/Math.h>
 #include <djvCore/String.h>
 #include <djvCore/Timer.h>
 
+#include <algorithm>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -31,7 +35,11 @@ namespace djv
             _audioFrame();
             _audioQueue();
             _cache();
+            _cachePlan();
+            _proxyCache();
+            _threadBalancer();
             _io();
+            _roi();
             _system();
             _operators();
         }
@@ -251,8 +259,383 @@ namespace djv
                     _print(ss.str());
                 }
             }
+
+            {
+                IO::Cache cache;
+                cache.setMax(10);
+                cache.setSequenceSize(10);
+                const std::vector<std::shared_ptr<Image::Image> > layers =
+                {
+                    Image::Image::create(Image::Info(1, 2, Image::Type::RGB_U8)),
+                    Image::Image::create(Image::Info(1, 2, Image::Type::L_F32))
+                };
+                cache.add(IO::VideoFrame(0, layers[0], layers));
+                DJV_ASSERT(cache.getTotalByteCount() == layers[0]->getDataByteCount() + layers[1]->getDataByteCount());
+                IO::VideoFrame frame;
+                DJV_ASSERT(cache.get(0, frame));
+                DJV_ASSERT(layers == frame.layers);
+                std::shared_ptr<AV::Image::Image> image;
+                DJV_ASSERT(cache.get(0, image));
+                DJV_ASSERT(layers[0] == image);
+            }
         }
         
+        void IOTest::_cachePlan()
+        {
+            {
+                // Stopped, the frames ahead of the playhead are read first
+                // followed by the frames behind.
+                IO::Cache cache;
+                cache.setMax(20);
+                cache.setSequenceSize(100);
+                cache.setCurrentFrame(50);
+                const auto& order = cache.getReadOrder();
+                DJV_ASSERT(20 == order.size());
+                for (size_t i = 0; i < 10; ++i)
+                {
+                    DJV_ASSERT(50 + static_cast<Frame::Index>(i) == order[i]);
+                    DJV_ASSERT(49 - static_cast<Frame::Index>(i) == order[10 + i]);
+                }
+                DJV_ASSERT(0.F == cache.getTime(50));
+                DJV_ASSERT(cache.getTime(51) < cache.getTime(52));
+                DJV_ASSERT(cache.getTime(59) < cache.getTime(49));
+                DJV_ASSERT(cache.getTime(60) < 0.F);
+                DJV_ASSERT(Frame::Sequence(Frame::Range(40, 59)) == cache.getSequence());
+
+                // Frames that are not planned are not added.
+                DJV_ASSERT(cache.add(55, Image::Image::create(Image::Info(1, 2, Image::Type::RGB_U8))));
+                DJV_ASSERT(!cache.add(60, Image::Image::create(Image::Info(1, 2, Image::Type::RGB_U8))));
+                DJV_ASSERT(cache.contains(55));
+                DJV_ASSERT(!cache.contains(60));
+
+                // Reverse.
+                cache.setDirection(IO::Direction::Reverse);
+                DJV_ASSERT(50 == order[0]);
+                DJV_ASSERT(49 == order[1]);
+                DJV_ASSERT(51 == order[10]);
+            }
+
+            {
+                // Skipping frames at double speed only plans every other frame.
+                IO::Cache cache;
+                cache.setMax(20);
+                cache.setSequenceSize(100);
+                cache.setSpeed(Time::Speed(24));
+                IO::Playhead playhead;
+                playhead.playback = true;
+                playhead.speed = 2.F;
+                playhead.everyFrame = false;
+                cache.setPlayhead(playhead);
+                cache.setCurrentFrame(50);
+                const auto& order = cache.getReadOrder();
+                DJV_ASSERT(50 == order[0]);
+                DJV_ASSERT(52 == order[1]);
+                DJV_ASSERT(54 == order[2]);
+                DJV_ASSERT(cache.getTime(51) < 0.F);
+                DJV_ASSERT(fuzzyCompare(cache.getTime(52), 1.F / 24.F, .0001F));
+
+                // Playing every frame at double speed.
+                playhead.everyFrame = true;
+                cache.setPlayhead(playhead);
+                DJV_ASSERT(51 == order[1]);
+                DJV_ASSERT(fuzzyCompare(cache.getTime(52), 1.F / 24.F, .0001F));
+            }
+
+            {
+                // Ping-pong playback turns around at the end of the range.
+                IO::Cache cache;
+                cache.setMax(10);
+                cache.setSequenceSize(10);
+                IO::Playhead playhead;
+                playhead.playback = true;
+                playhead.pingPong = true;
+                cache.setPlayhead(playhead);
+                cache.setCurrentFrame(8);
+                const auto& order = cache.getReadOrder();
+                DJV_ASSERT(std::vector<Frame::Index>({ 8, 9, 7, 6, 5, 4, 3, 2, 1, 0 }) == order);
+            }
+
+            {
+                // Without looping the plan stops at the end of the range.
+                IO::Cache cache;
+                cache.setMax(20);
+                cache.setSequenceSize(100);
+                IO::Playhead playhead;
+                playhead.loop = false;
+                cache.setPlayhead(playhead);
+                cache.setCurrentFrame(98);
+                const auto& order = cache.getReadOrder();
+                DJV_ASSERT(20 == order.size());
+                DJV_ASSERT(98 == order[0]);
+                DJV_ASSERT(99 == order[1]);
+                DJV_ASSERT(97 == order[2]);
+                DJV_ASSERT(cache.getTime(0) < 0.F);
+
+                // With looping the frames at the start are needed next.
+                playhead.loop = true;
+                cache.setPlayhead(playhead);
+                DJV_ASSERT(0 == order[2]);
+            }
+
+            {
+                // The frames needed furthest in the future are evicted.
+                IO::Cache cache;
+                cache.setMax(20);
+                cache.setSequenceSize(100);
+                cache.setCurrentFrame(50);
+                for (Frame::Index i = 40; i < 70; ++i)
+                {
+                    cache.add(i, Image::Image::create(Image::Info(1, 1, Image::Type::L_U8)));
+                }
+                DJV_ASSERT(20 == cache.getCount());
+                DJV_ASSERT(!cache.contains(60));
+                cache.setCurrentFrame(55);
+                DJV_ASSERT(cache.contains(45));
+                DJV_ASSERT(!cache.contains(44));
+                DJV_ASSERT(cache.contains(59));
+            }
+
+            {
+                // Frames that cannot be read before they are needed are read
+                // last when frames are skipped.
+                IO::Cache cache;
+                cache.setMax(20);
+                cache.setSequenceSize(100);
+                cache.setSpeed(Time::Speed(24));
+                IO::Playhead playhead;
+                playhead.playback = true;
+                playhead.everyFrame = false;
+                cache.setPlayhead(playhead);
+                cache.setCurrentFrame(50);
+                cache.setReadTime(.1F);
+                const auto& order = cache.getReadOrder();
+                DJV_ASSERT(20 == order.size());
+                DJV_ASSERT(53 == order[0]);
+                DJV_ASSERT(std::find(order.begin(), order.end(), 50) > std::find(order.begin(), order.end(), 55));
+                {
+                    std::stringstream ss;
+                    ss << "cache read order:";
+                    for (const auto i : order)
+                    {
+                        ss << " " << i;
+                    }
+                    _print(ss.str());
+                }
+
+                // Every frame is shown so the order is not changed.
+                playhead.everyFrame = true;
+                cache.setPlayhead(playhead);
+                DJV_ASSERT(50 == order[0]);
+            }
+
+            for (const auto direction : { IO::Direction::Forward, IO::Direction::Reverse })
+            {
+                for (const float speed : { 1.F, 2.F })
+                {
+                    // Moving the playhead gives the same plan as planning
+                    // from scratch, including across the ends of the range.
+                    IO::Playhead playhead;
+                    playhead.direction = direction;
+                    playhead.playback = true;
+                    playhead.speed = speed;
+                    playhead.everyFrame = false;
+                    IO::Cache cache;
+                    cache.setMax(20);
+                    cache.setSequenceSize(100);
+                    cache.setSpeed(Time::Speed(24));
+                    cache.setPlayhead(playhead);
+                    const Frame::Index step = (IO::Direction::Forward == direction ? 1 : -1) * static_cast<Frame::Index>(speed);
+                    Frame::Index frame = 0;
+                    for (size_t i = 0; i < 200; ++i)
+                    {
+                        frame = (frame + step + 100) % 100;
+                        cache.setCurrentFrame(frame);
+                        cache.add(frame, Image::Image::create(Image::Info(1, 1, Image::Type::L_U8)));
+                        cache.add(frame + step * 5, Image::Image::create(Image::Info(1, 1, Image::Type::L_U8)));
+                        IO::Cache fresh;
+                        fresh.setMax(20);
+                        fresh.setSequenceSize(100);
+                        fresh.setSpeed(Time::Speed(24));
+                        fresh.setPlayhead(playhead);
+                        fresh.setCurrentFrame(frame);
+                        DJV_ASSERT(fresh.getReadOrder() == cache.getReadOrder());
+                        DJV_ASSERT(fresh.getSequence() == cache.getSequence());
+                        for (Frame::Index j = 0; j < 100; ++j)
+                        {
+                            DJV_ASSERT(fuzzyCompare(fresh.getTime(j), cache.getTime(j), .0001F));
+                            DJV_ASSERT(!cache.contains(j) || fresh.getTime(j) >= 0.F);
+                        }
+                    }
+                }
+            }
+        }
+
+        void IOTest::_proxyCache()
+        {
+            {
+                const IO::ProxyCache cache;
+                DJV_ASSERT(0 == cache.getMaxByteCount());
+                DJV_ASSERT(0 == cache.getByteCount());
+                DJV_ASSERT(0 == cache.getCount());
+                DJV_ASSERT(cache.isFull());
+                DJV_ASSERT(Frame::Sequence() == cache.getFrames());
+                std::shared_ptr<AV::Image::Image> image;
+                DJV_ASSERT(!cache.get(0, image));
+            }
+
+            {
+                Image::Info info(100, 50, Image::Type::RGBA_F32);
+                info.pixelAspectRatio = 2.F;
+                const auto proxyInfo = IO::ProxyCache::getInfo(info);
+                DJV_ASSERT(Image::Size(25, 12) == proxyInfo.size);
+                DJV_ASSERT(Image::Type::RGBA_U8 == proxyInfo.type);
+                DJV_ASSERT(2.F == proxyInfo.pixelAspectRatio);
+                DJV_ASSERT(Image::Size(1, 1) == IO::ProxyCache::getInfo(Image::Info(2, 2, Image::Type::L_U16)).size);
+
+                auto image = Image::Image::create(info);
+                image->setPluginName("OpenEXR");
+                image->zero();
+                const auto proxy = IO::ProxyCache::create(*image);
+                DJV_ASSERT(proxyInfo == proxy->getInfo());
+                DJV_ASSERT("OpenEXR" == proxy->getPluginName());
+            }
+
+            {
+                IO::ProxyCache cache;
+                const auto info = Image::Info(4, 4, Image::Type::RGBA_U8);
+                cache.setMaxByteCount(info.getDataByteCount() * 3);
+                DJV_ASSERT(!cache.isFull());
+                for (Frame::Index i = 0; i < 5; ++i)
+                {
+                    DJV_ASSERT(cache.add(i * 2, Image::Image::create(info)));
+                }
+                DJV_ASSERT(cache.isFull());
+                DJV_ASSERT(3 == cache.getCount());
+                DJV_ASSERT(info.getDataByteCount() * 3 == cache.getByteCount());
+                DJV_ASSERT(!cache.contains(0));
+                DJV_ASSERT(!cache.contains(2));
+                DJV_ASSERT(cache.contains(4));
+                DJV_ASSERT(!cache.contains(5));
+
+                // Getting a proxy image makes it the most recently used.
+                std::shared_ptr<AV::Image::Image> image;
+                DJV_ASSERT(cache.get(4, image));
+                DJV_ASSERT(image);
+                DJV_ASSERT(cache.add(10, Image::Image::create(info)));
+                DJV_ASSERT(cache.contains(4));
+                DJV_ASSERT(!cache.contains(6));
+                DJV_ASSERT(cache.contains(8));
+                DJV_ASSERT(cache.contains(10));
+
+                cache.setMaxByteCount(info.getDataByteCount() * 2);
+                DJV_ASSERT(2 == cache.getCount());
+                DJV_ASSERT(!cache.contains(8));
+                DJV_ASSERT(!cache.add(12, Image::Image::create(Image::Info(8, 8, Image::Type::RGBA_U8))));
+                DJV_ASSERT(2 == cache.getCount());
+
+                cache.crop(Range::Range<Frame::Index>(1, 5));
+                DJV_ASSERT(1 == cache.getCount());
+                DJV_ASSERT(!cache.contains(10));
+                DJV_ASSERT(!cache.isFull());
+                {
+                    std::stringstream ss;
+                    ss << "proxy frames: " << cache.getFrames();
+                    _print(ss.str());
+                }
+                cache.clear();
+                DJV_ASSERT(0 == cache.getCount());
+                DJV_ASSERT(0 == cache.getByteCount());
+            }
+
+            {
+                DJV_ASSERT(IO::ProxyCache::getOrder(Range::Range<Frame::Index>(0, -1)).empty());
+                DJV_ASSERT(std::vector<Frame::Index>({ 5 }) == IO::ProxyCache::getOrder(Range::Range<Frame::Index>(5, 5)));
+                for (const Frame::Index size : { 2, 10, 100, 1000 })
+                {
+                    const auto order = IO::ProxyCache::getOrder(Range::Range<Frame::Index>(10, 10 + size - 1));
+                    DJV_ASSERT(static_cast<size_t>(size) == order.size());
+                    std::set<Frame::Index> frames(order.begin(), order.end());
+                    DJV_ASSERT(static_cast<size_t>(size) == frames.size());
+                    DJV_ASSERT(10 == *frames.begin());
+                    DJV_ASSERT(10 + size - 1 == *frames.rbegin());
+                    DJV_ASSERT(10 == order[0]);
+                }
+                const auto order = IO::ProxyCache::getOrder(Range::Range<Frame::Index>(0, 99));
+                std::stringstream ss;
+                ss << "proxy order:";
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    ss << " " << order[i];
+                }
+                _print(ss.str());
+                DJV_ASSERT(64 == order[1]);
+                DJV_ASSERT(32 == order[2]);
+                DJV_ASSERT(96 == order[3]);
+            }
+        }
+
+        void IOTest::_threadBalancer()
+        {
+            {
+                IO::ThreadBalancer balancer;
+                balancer.setThreadCount(16, false, true);
+                DJV_ASSERT(IO::ThreadSplit(1, 16) == balancer.getSplit());
+                DJV_ASSERT(balancer.isSettled());
+                balancer.setThreadCount(16, true, false);
+                DJV_ASSERT(IO::ThreadSplit(16, 1) == balancer.getSplit());
+            }
+
+            {
+                IO::ThreadBalancer balancer;
+                balancer.setThreadCount(16, true, true);
+                DJV_ASSERT(16 == balancer.getThreadCount());
+                for (const auto& i : balancer.getSplits())
+                {
+                    DJV_ASSERT(i.frameThreads * i.decodeThreads == 16);
+                }
+
+                // Simulate the decode throughput for each number of frame threads.
+                auto run = [this, &balancer](const std::map<size_t, float>& throughput)
+                {
+                    for (size_t i = 0; i < 100 && (i < 2 || !balancer.isSettled()); ++i)
+                    {
+                        const auto& split = balancer.getSplit();
+                        IO::DecodeStats stats;
+                        stats.frames = 32;
+                        stats.seconds = stats.frames * split.frameThreads / throughput.at(split.frameThreads);
+                        if (balancer.addSample(stats))
+                        {
+                            std::stringstream ss;
+                            ss << "Thread split: " << balancer.getSplit().frameThreads << "x" << balancer.getSplit().decodeThreads;
+                            _print(ss.str());
+                        }
+                    }
+                };
+                run({ { 1, 10.F }, { 2, 20.F }, { 4, 40.F }, { 8, 30.F }, { 16, 20.F } });
+                DJV_ASSERT(balancer.isSettled());
+                DJV_ASSERT(4 == balancer.getSplit().frameThreads);
+                DJV_ASSERT(4 == balancer.getSplit().decodeThreads);
+
+                run({ { 1, 5.F }, { 2, 10.F }, { 4, 15.F }, { 8, 25.F }, { 16, 40.F } });
+                DJV_ASSERT(balancer.isSettled());
+                DJV_ASSERT(16 == balancer.getSplit().frameThreads);
+                DJV_ASSERT(1 == balancer.getSplit().decodeThreads);
+            }
+
+            if (auto context = getContext().lock())
+            {
+                auto io = context->getSystemT<IO::System>();
+                const size_t threadCount = io->getThreadCount();
+                io->setThreadCount(8);
+                DJV_ASSERT(8 == io->getThreadCount());
+                for (const auto& i : io->observeThreadSplits()->get())
+                {
+                    DJV_ASSERT(i.second.frameThreads * i.second.decodeThreads == 8);
+                }
+                io->setThreadCount(threadCount);
+            }
+        }
+
         void IOTest::_io()
         {
             if (auto context = getContext().lock())
@@ -261,6 +644,7 @@ namespace djv
                 {
                     ".cin",
                     ".dpx",
+                    ".exr",
                     ".ppm",
                     ".png",
                     ".txt"
@@ -308,8 +692,13 @@ namespace djv
                                     {}
                                 }
 
+                                IO::ReadOptions roiOptions;
+                                roiOptions.roi = BBox2i(0, 0, size.w / 2, size.h / 2);
+                                roiOptions.scale = .5F;
+                                for (const auto& options : { IO::ReadOptions(), roiOptions })
                                 {
-                                    auto read = io->read(FileSystem::FileInfo(path));
+                                    auto read = io->read(FileSystem::FileInfo(path), options);
+                                    std::shared_ptr<Image::Image> readImage;
                                     bool running = true;
                                     while (running)
                                     {
@@ -322,6 +711,10 @@ namespace djv
                                                 if (!readQueue.isEmpty())
                                                 {
                                                     auto frame = readQueue.popFrame();
+                                                    if (!readImage)
+                                                    {
+                                                        readImage = frame.image;
+                                                    }
                                                 }
                                                 else if (readQueue.isFinished())
                                                 {
@@ -342,6 +735,18 @@ namespace djv
                                             std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
                                         }
                                     }
+
+                                    // The region of interest does not change the size of
+                                    // the image, and the scale can only make it smaller.
+                                    if (readImage)
+                                    {
+                                        DJV_ASSERT(readImage->getWidth() <= size.w);
+                                        DJV_ASSERT(readImage->getHeight() <= size.h);
+                                        if (1.F == options.scale)
+                                        {
+                                            DJV_ASSERT(size == readImage->getSize());
+                                        }
+                                    }
                                 }
                             }
                             catch (const std::exception&)
@@ -352,6 +757,89 @@ namespace djv
             }
         }
         
+        void IOTest::_roi()
+        {
+            if (auto context = getContext().lock())
+            {
+                // Write an image where each pixel contains its index.
+                const Image::Size size(32, 32);
+                const Image::Info imageInfo(size, Image::Type::L_F32);
+                auto image = Image::Image::create(imageInfo);
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    float* p = reinterpret_cast<float*>(image->getData(y));
+                    for (uint16_t x = 0; x < size.w; ++x)
+                    {
+                        p[x] = static_cast<float>(y * size.w + x);
+                    }
+                }
+                const FileSystem::FileInfo fileInfo("IOTestROI.exr");
+                auto io = context->getSystemT<AV::IO::System>();
+                try
+                {
+                    {
+                        IO::Info info;
+                        info.video.push_back(imageInfo);
+                        auto write = io->write(fileInfo, info);
+                        {
+                            std::lock_guard<std::mutex> lock(write->getMutex());
+                            auto& writeQueue = write->getVideoQueue();
+                            writeQueue.addFrame(IO::VideoFrame(0, image));
+                            writeQueue.setFinished(true);
+                        }
+                        while (write->isRunning())
+                        {}
+                    }
+
+                    // Read the image with a region of interest. The pixels inside
+                    // the region are decoded and the rest of the image is black.
+                    IO::ReadOptions options;
+                    options.roi = BBox2i(8, 4, 16, 8);
+                    options.scale = .5F;
+                    auto read = io->read(fileInfo, options);
+                    std::shared_ptr<Image::Image> readImage;
+                    while (!readImage)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(read->getMutex());
+                            auto& readQueue = read->getVideoQueue();
+                            if (!readQueue.isEmpty())
+                            {
+                                readImage = readQueue.popFrame().image;
+                            }
+                            else if (readQueue.isFinished())
+                            {
+                                break;
+                            }
+                        }
+                        if (!readImage)
+                        {
+                            std::this_thread::sleep_for(Time::getTime(Time::TimerValue::Fast));
+                        }
+                    }
+                    DJV_ASSERT(readImage);
+
+                    // Scanline files only have one level so the scale does not
+                    // change the size.
+                    DJV_ASSERT(size == readImage->getSize());
+                    std::vector<float> row(size.w);
+                    for (uint16_t y = 0; y < size.h; ++y)
+                    {
+                        Image::convert(readImage->getData(y), readImage->getType(), row.data(), Image::Type::L_F32, size.w);
+                        for (uint16_t x = 0; x < size.w; ++x)
+                        {
+                            const bool inside = options.roi.contains(glm::ivec2(x, y));
+                            DJV_ASSERT(row[x] == (inside ? static_cast<float>(y * size.w + x) : 0.F));
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    _print(e.what());
+                }
+            }
+        }
+
         void IOTest::_system()
         {
             if (auto context = getContext().lock())
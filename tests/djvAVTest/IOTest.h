@@ -24,7 +24,11 @@ namespace djv
             void _audioFrame();
             void _audioQueue();
             void _cache();
+            void _cachePlan();
+            void _proxyCache();
+            void _threadBalancer();
             void _io();
+            void _roi();
             void _system();
             void _operators();
         };
@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/ImageAtlasPackerTest.h>
+
+#include <djvAV/ImageAtlasPacker.h>
+
+#include <djvCore/Math.h>
+
+#include <random>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageAtlasPackerTest::ImageAtlasPackerTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageAtlasPackerTest", context)
+        {}
+        
+        void ImageAtlasPackerTest::run()
+        {
+            _add();
+            _evict();
+            _remove();
+            _stress();
+        }
+
+        void ImageAtlasPackerTest::_add()
+        {
+            Image::AtlasPacker packer(1, 64, 1);
+            DJV_ASSERT(1 == packer.getPageCount());
+            DJV_ASSERT(64 == packer.getPageSize());
+            DJV_ASSERT(1 == packer.getBorder());
+
+            Image::AtlasPackerItem item;
+            const UID uid = packer.addItem(10, 10, item);
+            DJV_ASSERT(uid != 0);
+            DJV_ASSERT(0 == item.page);
+            DJV_ASSERT(BBox2i(0, 0, 12, 12) == item.bbox);
+            DJV_ASSERT(packer.hasItem(uid));
+            Image::AtlasPackerItem item2;
+            DJV_ASSERT(packer.getItem(uid, item2));
+            DJV_ASSERT(item.bbox == item2.bbox);
+            DJV_ASSERT(1 == packer.getItemCount());
+            DJV_ASSERT(fuzzyCompare(packer.getPercentageUsed(), 144 / 4096.F * 100.F));
+
+            // Shorter items share the shelf.
+            const UID uid2 = packer.addItem(8, 8, item2);
+            DJV_ASSERT(uid2 != 0 && uid2 != uid);
+            DJV_ASSERT(BBox2i(12, 0, 10, 10) == item2.bbox);
+            DJV_ASSERT(!packer.isFree(0, BBox2i(0, 0, 1, 1)));
+            DJV_ASSERT(packer.isFree(0, BBox2i(22, 0, 42, 12)));
+            DJV_ASSERT(packer.isFree(0, BBox2i(0, 12, 64, 52)));
+
+            // Items larger than a page are rejected.
+            DJV_ASSERT(0 == packer.addItem(63, 63, item2));
+            DJV_ASSERT(0 == packer.addItem(0, 10, item2));
+        }
+
+        void ImageAtlasPackerTest::_evict()
+        {
+            Image::AtlasPacker packer(1, 32);
+            Image::AtlasPackerItem item;
+            const UID a = packer.addItem(16, 16, item);
+            const UID b = packer.addItem(16, 16, item);
+            const UID c = packer.addItem(16, 16, item);
+            const UID d = packer.addItem(16, 16, item);
+            DJV_ASSERT(a && b && c && d);
+            DJV_ASSERT(fuzzyCompare(packer.getPercentageUsed(), 100.F));
+            DJV_ASSERT(packer.getItem(a, item));
+
+            // The least recently used item is replaced.
+            const UID e = packer.addItem(16, 16, item);
+            DJV_ASSERT(e != 0);
+            DJV_ASSERT(BBox2i(16, 0, 16, 16) == item.bbox);
+            DJV_ASSERT(packer.hasItem(a));
+            DJV_ASSERT(!packer.hasItem(b));
+            DJV_ASSERT(1 == packer.getEvictionCount());
+
+            // A larger item evicts as many items as it needs.
+            const UID f = packer.addItem(32, 32, item);
+            DJV_ASSERT(f != 0);
+            DJV_ASSERT(1 == packer.getItemCount());
+            DJV_ASSERT(5 == packer.getEvictionCount());
+        }
+
+        void ImageAtlasPackerTest::_remove()
+        {
+            Image::AtlasPacker packer(2, 64);
+            Image::AtlasPackerItem item;
+            std::vector<UID> uids;
+            for (size_t i = 0; i < 16; ++i)
+            {
+                uids.push_back(packer.addItem(16, 8 + i % 4, item));
+            }
+            DJV_ASSERT(packer.getFragmentation() >= 0.F);
+            for (auto i : uids)
+            {
+                packer.removeItem(i);
+            }
+            DJV_ASSERT(0 == packer.getItemCount());
+            DJV_ASSERT(fuzzyCompare(packer.getPercentageUsed(), 0.F));
+            DJV_ASSERT(fuzzyCompare(packer.getFragmentation(), 0.F));
+            DJV_ASSERT(packer.isFree(0, BBox2i(0, 0, 64, 64)));
+            DJV_ASSERT(packer.addItem(64, 64, item) != 0);
+            DJV_ASSERT(0 == packer.getEvictionCount());
+
+            packer.clear();
+            DJV_ASSERT(0 == packer.getItemCount());
+            DJV_ASSERT(packer.isFree(0, BBox2i(0, 0, 64, 64)));
+        }
+
+        void ImageAtlasPackerTest::_stress()
+        {
+            Image::AtlasPacker packer(2, 1024, 1);
+            std::mt19937 rng;
+            std::uniform_int_distribution<int> size(4, 48);
+            std::vector<UID> uids;
+            for (size_t i = 0; i < 20000; ++i)
+            {
+                Image::AtlasPackerItem item;
+                const UID uid = packer.addItem(size(rng), size(rng), item);
+                DJV_ASSERT(uid != 0);
+                uids.push_back(uid);
+                if (uids.size() > 16)
+                {
+                    packer.getItem(uids[uids.size() - 16], item);
+                }
+            }
+
+            // The items in the atlas should not overlap.
+            std::vector<std::vector<BBox2i> > pages(packer.getPageCount());
+            for (auto i : uids)
+            {
+                Image::AtlasPackerItem item;
+                if (packer.hasItem(i) && packer.getItem(i, item))
+                {
+                    DJV_ASSERT(item.bbox.min.x >= 0 && item.bbox.max.x < 1024);
+                    DJV_ASSERT(item.bbox.min.y >= 0 && item.bbox.max.y < 1024);
+                    DJV_ASSERT(!packer.isFree(item.page, item.bbox));
+                    pages[item.page].push_back(item.bbox);
+                }
+            }
+            for (const auto& page : pages)
+            {
+                for (size_t i = 0; i < page.size(); ++i)
+                {
+                    for (size_t j = i + 1; j < page.size(); ++j)
+                    {
+                        DJV_ASSERT(!page[i].intersects(page[j]));
+                    }
+                }
+            }
+
+            std::stringstream ss;
+            ss << "stress items: " << packer.getItemCount() << ", ";
+            ss << "evictions: " << packer.getEvictionCount() << ", ";
+            ss << "used: " << packer.getPercentageUsed() << "%, ";
+            ss << "fragmentation: " << packer.getFragmentation() << "%";
+            _print(ss.str());
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
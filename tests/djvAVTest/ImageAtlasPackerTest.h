@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class ImageAtlasPackerTest : public Test::ITest
+        {
+        public:
+            ImageAtlasPackerTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _add();
+            void _evict();
+            void _remove();
+            void _stress();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
+
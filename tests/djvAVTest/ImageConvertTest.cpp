@@ -5,6 +5,7 @@
 #include <djvAVTest/ImageConvertTest.h>
 
 #include <djvAV/ImageConvert.h>
+#include <djvAV/ImageUtil.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/ResourceSystem.h>
@@ -46,6 +47,25 @@ namespace djv
                 }
                 //DJV_ASSERT(Image::U8Range.max == u8);
             }
+
+            {
+                const Image::Info info(4, 4, Image::Type::L_U8);
+                auto data = Image::Data::create(info);
+                for (uint16_t y = 0; y < 4; ++y)
+                {
+                    for (uint16_t x = 0; x < 4; ++x)
+                    {
+                        data->getData(x, y)[0] = y * 64 + x * 16;
+                    }
+                }
+                const Image::Info info2(2, 2, Image::Type::RGBA_U8);
+                auto data2 = Image::Data::create(info2);
+                Image::resize(*data, *data2);
+                DJV_ASSERT(40 == data2->getData(0, 0)[0]);
+                DJV_ASSERT(40 == data2->getData(0, 0)[2]);
+                DJV_ASSERT(Image::U8Range.max == data2->getData(0, 0)[3]);
+                DJV_ASSERT(200 == data2->getData(1, 1)[0]);
+            }
         }
                 
     } // namespace AVTest
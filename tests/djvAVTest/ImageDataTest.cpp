@@ -6,6 +6,7 @@
 
 #include <djvAV/ImageData.h>
 
+#include <djvCore/FileIO.h>
 #include <djvCore/Memory.h>
 
 using namespace djv::Core;
@@ -216,6 +217,31 @@ namespace djv
                 auto data2 = Image::Data::create(info);
                 DJV_ASSERT(data->getUID() != data2->getUID());
             }
+
+            {
+                const Image::Info info(2, 2, Image::Type::L_U8);
+                auto buffer = std::shared_ptr<std::vector<uint8_t> >(new std::vector<uint8_t>);
+                for (uint8_t i = 0; i < 4; ++i)
+                {
+                    buffer->push_back(i);
+                }
+                auto io = FileSystem::FileIO::create();
+                io->open("ImageDataTest", buffer);
+                auto data = Image::Data::create(info, io);
+                DJV_ASSERT(data->hasFileIO());
+                DJV_ASSERT(io->mmapP() == data->getData(0, 0));
+                DJV_ASSERT(3 == *data->getData(1, 1));
+                data->detach();
+                DJV_ASSERT(data->hasFileIO());
+                data->getData()[0] = 1;
+                DJV_ASSERT(!data->hasFileIO());
+                DJV_ASSERT(1 == *data->getData(0, 0));
+                DJV_ASSERT(0 == (*buffer)[0]);
+
+                io->setPos(1);
+                auto data2 = Image::Data::create(info, io);
+                DJV_ASSERT(!data2->hasFileIO());
+            }
         }
         
         void ImageDataTest::_util()
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/ImageStatsTest.h>
+
+#include <djvAV/Color.h>
+#include <djvAV/Image.h>
+#include <djvAV/ImageStats.h>
+#include <djvAV/ImageUtil.h>
+
+#include <djvCore/Math.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        ImageStatsTest::ImageStatsTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageStatsTest", context)
+        {}
+
+        void ImageStatsTest::run()
+        {
+            _stats();
+            _roi();
+            _image();
+        }
+
+        void ImageStatsTest::_stats()
+        {
+            {
+                const auto stats = Image::getStats(*Image::Data::create(Image::Info()));
+                DJV_ASSERT(0 == stats.pixelCount);
+            }
+            for (const size_t threadCount : { 1, 2, 3, 16 })
+            {
+                // Each scanline contains the values 0, 1, 2, 3.
+                auto data = Image::Data::create(Image::Info(4, 8, Image::Type::L_U8));
+                for (uint16_t y = 0; y < data->getHeight(); ++y)
+                {
+                    uint8_t* p = data->getData(y);
+                    for (uint16_t x = 0; x < data->getWidth(); ++x)
+                    {
+                        p[x] = static_cast<uint8_t>(x);
+                    }
+                }
+                Image::StatsOptions options;
+                options.histogramBins = 256;
+                options.threadCount = threadCount;
+                const auto stats = Image::getStats(*data, options);
+                std::stringstream ss;
+                ss << "threads: " << threadCount << ", min: " << stats.min[0] * 255.F << ", max: " <<
+                    stats.max[0] * 255.F << ", mean: " << stats.mean[0] * 255.F;
+                _print(ss.str());
+                DJV_ASSERT(1 == stats.channelCount);
+                DJV_ASSERT(32 == stats.pixelCount);
+                DJV_ASSERT(0.F == stats.min[0]);
+                DJV_ASSERT(fuzzyCompare(stats.max[0] * 255.F, 3.F, .001F));
+                DJV_ASSERT(fuzzyCompare(stats.mean[0] * 255.F, 1.5F, .001F));
+                DJV_ASSERT(256 == stats.histogram[0].size());
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    DJV_ASSERT(8 == stats.histogram[0][i]);
+                }
+            }
+            {
+                // Floating point values outside of 0-1 are clamped to the
+                // first and last histogram bins.
+                auto data = Image::Data::create(Image::Info(2, 1, Image::Type::RGB_F32));
+                float* p = reinterpret_cast<float*>(data->getData());
+                const float values[] = { -1.F, 0.5F, 2.F, 1.F, 0.5F, 0.F };
+                std::copy(values, values + 6, p);
+                Image::StatsOptions options;
+                options.histogramBins = 4;
+                const auto stats = Image::getStats(*data, options);
+                DJV_ASSERT(-1.F == stats.min[0]);
+                DJV_ASSERT(1.F == stats.max[0]);
+                DJV_ASSERT(0.F == stats.mean[0]);
+                DJV_ASSERT(1 == stats.histogram[0][0]);
+                DJV_ASSERT(1 == stats.histogram[0][3]);
+                DJV_ASSERT(2 == stats.histogram[1][2]);
+                DJV_ASSERT(2.F == stats.max[2]);
+                DJV_ASSERT(1 == stats.histogram[2][0]);
+                DJV_ASSERT(1 == stats.histogram[2][3]);
+            }
+        }
+
+        void ImageStatsTest::_roi()
+        {
+            // The left half of the image is black and the right half is white.
+            for (const bool mirror : { false, true })
+            {
+                Image::Layout layout;
+                layout.mirror.x = mirror;
+                auto data = Image::Data::create(Image::Info(8, 4, Image::Type::L_U16, layout));
+                for (uint16_t y = 0; y < data->getHeight(); ++y)
+                {
+                    uint16_t* p = reinterpret_cast<uint16_t*>(data->getData(y));
+                    for (uint16_t x = 0; x < data->getWidth(); ++x)
+                    {
+                        const bool white = mirror ? (x < 4) : (x >= 4);
+                        p[x] = white ? Image::U16Range.max : 0;
+                    }
+                }
+                Image::StatsOptions options;
+                options.roi = BBox2i(4, 1, 8, 8);
+                const auto stats = Image::getStats(*data, options);
+                DJV_ASSERT(BBox2i(4, 1, 4, 3) == stats.roi);
+                DJV_ASSERT(12 == stats.pixelCount);
+                DJV_ASSERT(1.F == stats.min[0]);
+                DJV_ASSERT(1.F == stats.mean[0]);
+                options.roi = BBox2i(2, 0, 4, 4);
+                const auto stats2 = Image::getStats(*data, options);
+                DJV_ASSERT(0.F == stats2.min[0]);
+                DJV_ASSERT(1.F == stats2.max[0]);
+                DJV_ASSERT(.5F == stats2.mean[0]);
+            }
+        }
+
+        void ImageStatsTest::_image()
+        {
+            auto image = Image::Image::create(Image::Info(16, 16, Image::Type::RGBA_U8));
+            DJV_ASSERT(!image->getStats());
+            for (uint16_t y = 0; y < image->getHeight(); ++y)
+            {
+                uint8_t* p = image->getData(y);
+                for (uint16_t x = 0; x < image->getWidth(); ++x, p += 4)
+                {
+                    p[0] = 255;
+                    p[1] = 0;
+                    p[2] = x < 8 ? 0 : 255;
+                    p[3] = 255;
+                }
+            }
+            DJV_ASSERT(Image::Color(255, 0, 127, 255) == Image::getAverageColor(image));
+            image->setStats(std::make_shared<Image::Stats>(Image::getStats(*image)));
+            DJV_ASSERT(image->getStats());
+            DJV_ASSERT(256 == image->getStats()->pixelCount);
+            DJV_ASSERT(Image::Color(255, 0, 127, 255) == Image::getAverageColor(image));
+        }
+
+    } // namespace AVTest
+} // namespace djv
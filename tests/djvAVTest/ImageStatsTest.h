@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class ImageStatsTest : public Test::ITest
+        {
+        public:
+            ImageStatsTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _stats();
+            void _roi();
+            void _image();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/Render2DImageProcessorTest.h>
+
+#include <djvAV/OpenGLOffscreenBuffer.h>
+#include <djvAV/Render2DImageProcessor.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Math.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+namespace _OCIO = OCIO_NAMESPACE;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            bool compare(const glm::vec4& a, const glm::vec4& b, float precision = .0001F)
+            {
+                return
+                    fuzzyCompare(a.x, b.x, precision) &&
+                    fuzzyCompare(a.y, b.y, precision) &&
+                    fuzzyCompare(a.z, b.z, precision) &&
+                    fuzzyCompare(a.w, b.w, precision);
+            }
+
+        } // namespace
+
+        Render2DImageProcessorTest::Render2DImageProcessorTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::Render2DImageProcessorTest", context)
+        {}
+
+        void Render2DImageProcessorTest::run()
+        {
+            _pixel();
+            _roi();
+            _gl();
+        }
+
+        void Render2DImageProcessorTest::_pixel()
+        {
+            auto data = Image::Data::create(Image::Info(1, 1, Image::Type::RGB_F32));
+            float* p = reinterpret_cast<float*>(data->getData());
+            p[0] = .25F;
+            p[1] = .5F;
+            p[2] = .75F;
+            const glm::vec4 in(.25F, .5F, .75F, 1.F);
+            auto processor = Render2D::ImageProcessor::create();
+            DJV_ASSERT(compare(in, processor->process(*data, glm::ivec2(0, 0))));
+            DJV_ASSERT(compare(glm::vec4(0.F, 0.F, 0.F, 0.F), processor->process(*data, glm::ivec2(1, 0))));
+
+            {
+                Render2D::ImageOptions options;
+                options.colorEnabled = true;
+                options.color.brightness = 2.F;
+                options.color.contrast = .5F;
+                options.color.saturation = .5F;
+                processor->setOptions(options);
+                glm::vec4 expected = glm::vec4(in.x, in.y, in.z, 1.F) * Render2D::colorMatrix(options.color);
+                expected.w = in.w;
+                DJV_ASSERT(compare(expected, processor->process(*data, glm::ivec2(0, 0))));
+
+                options.color = Render2D::ImageColor();
+                options.color.invert = true;
+                processor->setOptions(options);
+                DJV_ASSERT(compare(glm::vec4(.75F, .5F, .25F, 1.F), processor->process(*data, glm::ivec2(0, 0))));
+            }
+
+            {
+                Render2D::ImageOptions options;
+                options.levelsEnabled = true;
+                options.levels.inLow = .1F;
+                options.levels.inHigh = .8F;
+                options.levels.gamma = 2.F;
+                options.levels.outLow = .05F;
+                options.levels.outHigh = .9F;
+                processor->setOptions(options);
+                glm::vec4 expected = in;
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    expected[c] = powf((in[c] - .1F) / .8F, .5F) * .9F + .05F;
+                }
+                DJV_ASSERT(compare(expected, processor->process(*data, glm::ivec2(0, 0))));
+            }
+
+            {
+                Render2D::ImageOptions options;
+                options.exposureEnabled = true;
+                options.exposure.exposure = 1.F;
+                options.exposure.defog = .01F;
+                options.exposure.kneeLow = 0.F;
+                options.exposure.kneeHigh = 5.F;
+                processor->setOptions(options);
+                const Render2D::ExposureData exposure = Render2D::exposureData(options.exposure);
+                glm::vec4 expected = in;
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    float v = std::max(0.F, in[c] - exposure.d) * exposure.v;
+                    if (v > exposure.k)
+                    {
+                        v = exposure.k + logf((v - exposure.k) * exposure.f + 1.F) / exposure.f;
+                    }
+                    expected[c] = v * .332F;
+                }
+                const glm::vec4 result = processor->process(*data, glm::ivec2(0, 0));
+                std::stringstream ss;
+                ss << "exposure: " << result.x << " " << result.y << " " << result.z;
+                _print(ss.str());
+                DJV_ASSERT(compare(expected, result));
+            }
+
+            {
+                Render2D::ImageOptions options;
+                options.softClipEnabled = true;
+                options.softClip = .5F;
+                processor->setOptions(options);
+                const glm::vec4 result = processor->process(*data, glm::ivec2(0, 0));
+                DJV_ASSERT(fuzzyCompare(.25F, result.x, .0001F));
+                DJV_ASSERT(result.z > .5F && result.z < .75F);
+            }
+
+            {
+                Render2D::ImageOptions options;
+                options.channel = Render2D::ImageChannel::Green;
+                processor->setOptions(options);
+                DJV_ASSERT(compare(glm::vec4(.5F, .5F, .5F, 1.F), processor->process(*data, glm::ivec2(0, 0))));
+                options.channel = Render2D::ImageChannel::Alpha;
+                processor->setOptions(options);
+                DJV_ASSERT(compare(glm::vec4(1.F, 1.F, 1.F, 1.F), processor->process(*data, glm::ivec2(0, 0))));
+            }
+
+            {
+                // The color space conversion depends on the current
+                // OpenColorIO configuration. The 3D LUT should be close to
+                // the OpenColorIO CPU processor.
+                Render2D::ImageOptions options;
+                options.colorSpace = OCIO::Convert("linear", "sRGB");
+                try
+                {
+                    processor->setOptions(options);
+                    const glm::vec4 result = processor->process(*data, glm::ivec2(0, 0));
+                    std::stringstream ss;
+                    ss << "color space: " << result.x << " " << result.y << " " << result.z;
+                    _print(ss.str());
+
+                    auto config = _OCIO::GetCurrentConfig();
+                    auto ocioProcessor = config->getProcessor(
+                        options.colorSpace.input.c_str(),
+                        options.colorSpace.output.c_str());
+                    glm::vec4 expected = in;
+                    _OCIO::PackedImageDesc desc(&expected[0], 1, 1, 4);
+                    ocioProcessor->apply(desc);
+                    DJV_ASSERT(compare(expected, result, .01F));
+                }
+                catch (const std::exception& e)
+                {
+                    _print(e.what());
+                }
+            }
+        }
+
+        void Render2DImageProcessorTest::_roi()
+        {
+            // Each scanline contains the values 0, 1, 2, 3 and each row is
+            // offset by 4.
+            auto data = Image::Data::create(Image::Info(4, 2, Image::Type::L_U8));
+            for (uint16_t y = 0; y < data->getHeight(); ++y)
+            {
+                uint8_t* p = data->getData(y);
+                for (uint16_t x = 0; x < data->getWidth(); ++x)
+                {
+                    p[x] = static_cast<uint8_t>(y * 4 + x);
+                }
+            }
+            for (const size_t threadCount : { 1, 2, 3 })
+            {
+                auto processor = Render2D::ImageProcessor::create(Render2D::ImageOptions(), threadCount);
+                DJV_ASSERT(threadCount == processor->getThreadCount());
+
+                auto out = processor->process(*data, BBox2i(0, 0, 0, 0), Image::Type::L_U8);
+                DJV_ASSERT(Image::Size(4, 2) == out->getSize());
+                DJV_ASSERT(0 == out->getData(0, 0)[0]);
+                DJV_ASSERT(7 == out->getData(3, 1)[0]);
+
+                out = processor->process(*data, BBox2i(2, 1, 8, 8), Image::Type::L_U8);
+                DJV_ASSERT(Image::Size(2, 1) == out->getSize());
+                DJV_ASSERT(6 == out->getData(0, 0)[0]);
+                DJV_ASSERT(7 == out->getData(1, 0)[0]);
+
+                out = processor->process(*data, BBox2i(4, 2, 1, 1));
+                DJV_ASSERT(!out->isValid());
+
+                // The mirror options are applied in display coordinates.
+                Render2D::ImageOptions options;
+                options.mirror.x = true;
+                options.mirror.y = true;
+                processor->setOptions(options);
+                out = processor->process(*data, BBox2i(0, 0, 2, 1), Image::Type::L_U8);
+                DJV_ASSERT(7 == out->getData(0, 0)[0]);
+                DJV_ASSERT(6 == out->getData(1, 0)[0]);
+
+                // Mirroring in the image layout cancels out the options.
+                Image::Layout layout;
+                layout.mirror.x = true;
+                layout.mirror.y = true;
+                auto mirrored = Image::Data::create(Image::Info(4, 2, Image::Type::L_U8, layout));
+                memcpy(mirrored->getData(), data->getData(), data->getDataByteCount());
+                out = processor->process(*mirrored, BBox2i(0, 0, 2, 1), Image::Type::L_U8);
+                DJV_ASSERT(0 == out->getData(0, 0)[0]);
+                DJV_ASSERT(1 == out->getData(1, 0)[0]);
+            }
+        }
+
+        void Render2DImageProcessorTest::_gl()
+        {
+            if (auto context = getContext().lock())
+            {
+                // Compare the results with the OpenGL path. The rows are all
+                // the same so the orientation of the read back does not
+                // matter.
+                const Image::Size size(64, 4);
+                auto image = Image::Image::create(Image::Info(size, Image::Type::RGBA_U8));
+                for (uint16_t y = 0; y < size.h; ++y)
+                {
+                    uint8_t* p = image->getData(y);
+                    for (uint16_t x = 0; x < size.w; ++x, p += 4)
+                    {
+                        p[0] = static_cast<uint8_t>(x * 4);
+                        p[1] = static_cast<uint8_t>(255 - x * 4);
+                        p[2] = static_cast<uint8_t>(x * 2);
+                        p[3] = 255;
+                    }
+                }
+
+                std::vector<Render2D::ImageOptions> imageOptions;
+                imageOptions.push_back(Render2D::ImageOptions());
+                {
+                    Render2D::ImageOptions options;
+                    options.mirror.x = true;
+                    options.colorEnabled = true;
+                    options.color.brightness = 1.5F;
+                    options.color.contrast = .8F;
+                    options.color.saturation = 1.2F;
+                    options.color.invert = true;
+                    imageOptions.push_back(options);
+                }
+                {
+                    Render2D::ImageOptions options;
+                    options.levelsEnabled = true;
+                    options.levels.inLow = .1F;
+                    options.levels.gamma = 2.2F;
+                    options.levels.outHigh = .8F;
+                    options.exposureEnabled = true;
+                    options.exposure.exposure = 1.F;
+                    options.exposure.kneeLow = .5F;
+                    options.softClipEnabled = true;
+                    options.softClip = .2F;
+                    imageOptions.push_back(options);
+                }
+                {
+                    Render2D::ImageOptions options;
+                    options.channel = Render2D::ImageChannel::Red;
+                    imageOptions.push_back(options);
+                }
+                {
+                    Render2D::ImageOptions options;
+                    options.colorSpace = OCIO::Convert("linear", "sRGB");
+                    imageOptions.push_back(options);
+                }
+
+                auto offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(size, Image::Type::RGBA_F32);
+                auto render = context->getSystemT<AV::Render2D::Render>();
+                const auto imageFilterOptions = render->getImageFilterOptions();
+                render->setImageFilterOptions(Render2D::ImageFilterOptions(Render2D::ImageFilter::Nearest));
+                auto processor = Render2D::ImageProcessor::create();
+                for (const auto& i : imageOptions)
+                {
+                    try
+                    {
+                        processor->setOptions(i);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        // The color space may not be available in the current
+                        // OpenColorIO configuration.
+                        _print(e.what());
+                        continue;
+                    }
+
+                    offscreenBuffer->bind();
+                    render->beginFrame(size);
+                    render->setFillColor(Image::Color(1.F, 1.F, 1.F));
+                    render->drawImage(image, glm::vec2(0.F, 0.F), i);
+                    render->endFrame();
+                    auto gl = Image::Data::create(Image::Info(size, Image::Type::RGBA_F32));
+#if !defined(DJV_OPENGL_ES2)
+                    glBindFramebuffer(GL_READ_FRAMEBUFFER, offscreenBuffer->getID());
+                    glClampColor(GL_CLAMP_READ_COLOR, GL_FALSE);
+#endif // DJV_OPENGL_ES2
+                    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                    glReadPixels(0, 0, size.w, size.h, GL_RGBA, GL_FLOAT, gl->getData());
+                    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+                    auto cpu = processor->process(*image);
+                    float diff = 0.F;
+                    for (uint16_t x = 0; x < size.w; ++x)
+                    {
+                        const float* a = reinterpret_cast<const float*>(gl->getData(x, 0));
+                        const float* b = reinterpret_cast<const float*>(cpu->getData(x, 0));
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            diff = std::max(diff, std::abs(a[c] - b[c]));
+                        }
+                    }
+                    std::stringstream ss;
+                    ss << "OpenGL difference: " << diff;
+                    _print(ss.str());
+                    // The texture lookup for the color space uses a lower
+                    // precision interpolation than the CPU.
+                    DJV_ASSERT(diff < (i.colorSpace.isValid() ? .01F : .001F));
+                }
+                render->setImageFilterOptions(imageFilterOptions);
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class Render2DImageProcessorTest : public Test::ITest
+        {
+        public:
+            Render2DImageProcessorTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _pixel();
+            void _roi();
+            void _gl();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,349 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/Render2DRasterizerTest.h>
+
+#include <djvAV/Color.h>
+#include <djvAV/Render2DRasterizer.h>
+
+#include <djvCore/Math.h>
+
+#include <cstring>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            glm::vec4 getPixel(const Image::Data& data, uint16_t x, uint16_t y)
+            {
+                const float* p = reinterpret_cast<const float*>(data.getData(x, y));
+                return glm::vec4(p[0], p[1], p[2], p[3]);
+            }
+
+            bool compare(const glm::vec4& a, const glm::vec4& b, float precision = .0001F)
+            {
+                return
+                    fuzzyCompare(a.x, b.x, precision) &&
+                    fuzzyCompare(a.y, b.y, precision) &&
+                    fuzzyCompare(a.z, b.z, precision) &&
+                    fuzzyCompare(a.w, b.w, precision);
+            }
+
+            size_t getCoverage(const Image::Data& data)
+            {
+                size_t out = 0;
+                for (uint16_t y = 0; y < data.getHeight(); ++y)
+                {
+                    for (uint16_t x = 0; x < data.getWidth(); ++x)
+                    {
+                        if (getPixel(data, x, y).w > 0.F)
+                        {
+                            ++out;
+                        }
+                    }
+                }
+                return out;
+            }
+
+            glm::mat3x3 translate(float x, float y)
+            {
+                glm::mat3x3 out(1.F);
+                out[2][0] = x;
+                out[2][1] = y;
+                return out;
+            }
+
+            const glm::vec4 red(1.F, 0.F, 0.F, 1.F);
+            const glm::vec4 clear(0.F, 0.F, 0.F, 0.F);
+
+        } // namespace
+
+        Render2DRasterizerTest::Render2DRasterizerTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::Render2DRasterizerTest", context)
+        {}
+
+        void Render2DRasterizerTest::run()
+        {
+            _primitives();
+            _blend();
+            _images();
+            _text();
+            _threads();
+        }
+
+        void Render2DRasterizerTest::_primitives()
+        {
+            auto rasterizer = Render2D::Rasterizer::create();
+            const Image::Size size(32, 32);
+
+            {
+                rasterizer->beginFrame(size);
+                rasterizer->setFillColor(Image::Color(1.F, 0.F, 0.F));
+                rasterizer->drawRect(BBox2f(4.F, 4.F, 8.F, 8.F));
+                rasterizer->pushClipRect(BBox2f(0.F, 0.F, 8.F, 32.F));
+                rasterizer->drawRect(BBox2f(0.F, 16.F, 16.F, 8.F));
+                rasterizer->popClipRect();
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                DJV_ASSERT(size == out->getSize());
+                DJV_ASSERT(compare(red, getPixel(*out, 4, 4)));
+                DJV_ASSERT(compare(red, getPixel(*out, 11, 11)));
+                DJV_ASSERT(compare(clear, getPixel(*out, 12, 12)));
+                DJV_ASSERT(compare(clear, getPixel(*out, 3, 4)));
+                DJV_ASSERT(compare(red, getPixel(*out, 7, 16)));
+                DJV_ASSERT(compare(clear, getPixel(*out, 8, 16)));
+                DJV_ASSERT(8 * 8 + 8 * 8 == getCoverage(*out));
+            }
+
+            {
+                rasterizer->beginFrame(size);
+                rasterizer->drawCircle(glm::vec2(16.F, 16.F), 8.F);
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                DJV_ASSERT(compare(red, getPixel(*out, 16, 16)));
+                DJV_ASSERT(compare(clear, getPixel(*out, 9, 9)));
+                const size_t coverage = getCoverage(*out);
+                std::stringstream ss;
+                ss << "circle coverage: " << coverage;
+                _print(ss.str());
+                DJV_ASSERT(std::abs(static_cast<float>(coverage) - Math::pi * 8.F * 8.F) < 10.F);
+            }
+
+            {
+                rasterizer->beginFrame(size);
+                rasterizer->drawPill(BBox2f(2.F, 2.F, 20.F, 8.F));
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                DJV_ASSERT(compare(clear, getPixel(*out, 2, 2)));
+                DJV_ASSERT(getPixel(*out, 2, 5).w > 0.F);
+                DJV_ASSERT(getPixel(*out, 10, 2).w > 0.F);
+                DJV_ASSERT(getPixel(*out, 21, 6).w > 0.F);
+                DJV_ASSERT(compare(clear, getPixel(*out, 22, 6)));
+            }
+
+            {
+                rasterizer->beginFrame(size);
+                rasterizer->setLineWidth(1.F);
+                rasterizer->drawPolyline({ glm::vec2(2.F, 4.F), glm::vec2(16.F, 4.F), glm::vec2(30.F, 4.F) });
+                rasterizer->pushTransform(translate(0.F, 10.F));
+                rasterizer->drawPolyline({ glm::vec2(2.F, 4.F), glm::vec2(30.F, 4.F) });
+                rasterizer->popTransform();
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                DJV_ASSERT(getPixel(*out, 15, 3).w > 0.F);
+                DJV_ASSERT(getPixel(*out, 15, 4).w > 0.F);
+                DJV_ASSERT(compare(clear, getPixel(*out, 15, 2)));
+                DJV_ASSERT(compare(clear, getPixel(*out, 15, 5)));
+                DJV_ASSERT(getPixel(*out, 15, 13).w > 0.F);
+                DJV_ASSERT(getPixel(*out, 15, 14).w > 0.F);
+                DJV_ASSERT(2 * 28 * 2 == getCoverage(*out));
+            }
+
+            {
+                rasterizer->beginFrame(size);
+                rasterizer->setFillColor(Image::Color(0.F, 0.F, 0.F));
+                rasterizer->drawShadow(BBox2f(0.F, 0.F, 16.F, 1.F), Side::Left);
+                rasterizer->drawShadow(BBox2f(0.F, 8.F, 16.F, 16.F), 4.F);
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                DJV_ASSERT(getPixel(*out, 0, 0).w < getPixel(*out, 15, 0).w);
+                // The shadow color is multiplied by the fade and then alpha
+                // blended, the same as Render.
+                DJV_ASSERT(fuzzyCompare(powf(15.5F / 16.F, 2.F), getPixel(*out, 15, 0).w, .001F));
+                DJV_ASSERT(compare(clear, getPixel(*out, 0, 8)));
+                DJV_ASSERT(fuzzyCompare(.125F * .125F, getPixel(*out, 0, 16).w, .001F));
+                DJV_ASSERT(fuzzyCompare(1.F, getPixel(*out, 8, 16).w, .001F));
+            }
+        }
+
+        void Render2DRasterizerTest::_blend()
+        {
+            auto rasterizer = Render2D::Rasterizer::create();
+            const Image::Size size(4, 4);
+            rasterizer->beginFrame(size);
+            rasterizer->setFillColor(Image::Color(1.F, 1.F, 1.F));
+            rasterizer->drawRect(BBox2f(0.F, 0.F, 4.F, 4.F));
+            rasterizer->setFillColor(Image::Color(0.F, 0.F, 0.F));
+            rasterizer->setAlphaMult(.5F);
+            rasterizer->drawRect(BBox2f(0.F, 0.F, 2.F, 4.F));
+            rasterizer->setAlphaMult(1.F);
+            rasterizer->setColorMult(.5F);
+            rasterizer->setFillColor(Image::Color(1.F, 1.F, 1.F));
+            rasterizer->drawRect(BBox2f(2.F, 0.F, 2.F, 4.F));
+            auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+            DJV_ASSERT(compare(glm::vec4(.5F, .5F, .5F, .75F), getPixel(*out, 0, 0)));
+            DJV_ASSERT(compare(glm::vec4(.5F, .5F, .5F, 1.F), getPixel(*out, 3, 0)));
+        }
+
+        void Render2DRasterizerTest::_images()
+        {
+            auto image = Image::Image::create(Image::Info(4, 2, Image::Type::RGBA_U8));
+            for (uint16_t y = 0; y < 2; ++y)
+            {
+                uint8_t* p = image->getData(y);
+                for (uint16_t x = 0; x < 4; ++x, p += 4)
+                {
+                    p[0] = static_cast<uint8_t>(x * 64);
+                    p[1] = static_cast<uint8_t>(y * 255);
+                    p[2] = 0;
+                    p[3] = 255;
+                }
+            }
+            auto getImagePixel = [image](uint16_t x, uint16_t y)
+            {
+                const uint8_t* p = image->getData(x, y);
+                return glm::vec4(p[0] / 255.F, p[1] / 255.F, p[2] / 255.F, p[3] / 255.F);
+            };
+
+            auto rasterizer = Render2D::Rasterizer::create();
+            const Image::Size size(32, 32);
+
+            {
+                rasterizer->beginFrame(size);
+                rasterizer->drawImage(image, glm::vec2(10.F, 20.F));
+                Render2D::ImageOptions options;
+                options.mirror.x = true;
+                rasterizer->drawImage(image, glm::vec2(0.F, 0.F), options);
+                glm::mat3x3 scale(1.F);
+                scale[0][0] = 2.F;
+                scale[1][1] = 2.F;
+                rasterizer->pushTransform(translate(16.F, 0.F) * scale);
+                rasterizer->drawImage(image, glm::vec2(0.F, 0.F));
+                rasterizer->popTransform();
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                for (uint16_t y = 0; y < 2; ++y)
+                {
+                    for (uint16_t x = 0; x < 4; ++x)
+                    {
+                        DJV_ASSERT(compare(getImagePixel(x, y), getPixel(*out, 10 + x, 20 + y)));
+                        DJV_ASSERT(compare(getImagePixel(3 - x, y), getPixel(*out, x, y)));
+                        DJV_ASSERT(compare(getImagePixel(x, y), getPixel(*out, 16 + x * 2, y * 2)));
+                        DJV_ASSERT(compare(getImagePixel(x, y), getPixel(*out, 16 + x * 2 + 1, y * 2 + 1)));
+                    }
+                }
+                DJV_ASSERT(compare(clear, getPixel(*out, 14, 20)));
+                DJV_ASSERT(4 * 2 * 2 + 8 * 4 == getCoverage(*out));
+            }
+
+            {
+                // Mirroring in the image layout.
+                auto mirrored = Image::Image::create(Image::Info(Image::Size(4, 2), Image::Type::RGBA_U8, Image::Layout(Image::Mirror(false, true))));
+                memcpy(mirrored->getData(), image->getData(), image->getDataByteCount());
+                rasterizer->beginFrame(size);
+                rasterizer->drawImage(mirrored, glm::vec2(0.F, 0.F));
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                DJV_ASSERT(compare(getImagePixel(1, 1), getPixel(*out, 1, 0)));
+                DJV_ASSERT(compare(getImagePixel(1, 0), getPixel(*out, 1, 1)));
+            }
+
+            {
+                // Filled images use the red channel as the alpha.
+                rasterizer->beginFrame(size);
+                rasterizer->setFillColor(Image::Color(0.F, 1.F, 0.F));
+                rasterizer->drawFilledImage(image, glm::vec2(0.F, 0.F));
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                const glm::vec4 p = getPixel(*out, 2, 0);
+                const float a = 128.F / 255.F;
+                DJV_ASSERT(compare(glm::vec4(0.F, a, 0.F, a * a), p));
+                DJV_ASSERT(compare(clear, getPixel(*out, 0, 0)));
+            }
+
+            {
+                // Alpha blending.
+                auto transparent = Image::Image::create(Image::Info(2, 2, Image::Type::RGBA_F32));
+                float* p = reinterpret_cast<float*>(transparent->getData());
+                for (size_t i = 0; i < 4; ++i, p += 4)
+                {
+                    p[0] = .5F;
+                    p[1] = .5F;
+                    p[2] = .5F;
+                    p[3] = .5F;
+                }
+                rasterizer->beginFrame(size);
+                rasterizer->setFillColor(Image::Color(1.F, 0.F, 0.F));
+                rasterizer->drawRect(BBox2f(0.F, 0.F, 6.F, 2.F));
+                rasterizer->setFillColor(Image::Color(1.F, 1.F, 1.F));
+                Render2D::ImageOptions options;
+                options.alphaBlend = AlphaBlend::None;
+                rasterizer->drawImage(transparent, glm::vec2(0.F, 0.F), options);
+                options.alphaBlend = AlphaBlend::Premultiplied;
+                rasterizer->drawImage(transparent, glm::vec2(2.F, 0.F), options);
+                options.alphaBlend = AlphaBlend::Straight;
+                rasterizer->drawImage(transparent, glm::vec2(4.F, 0.F), options);
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                DJV_ASSERT(compare(glm::vec4(.5F, .5F, .5F, .5F), getPixel(*out, 0, 0)));
+                DJV_ASSERT(compare(glm::vec4(1.F, .5F, .5F, 1.F), getPixel(*out, 2, 0)));
+                DJV_ASSERT(compare(glm::vec4(.75F, .25F, .25F, .75F), getPixel(*out, 4, 0)));
+            }
+        }
+
+        void Render2DRasterizerTest::_text()
+        {
+            auto glyph = Font::Glyph::create();
+            glyph->imageData = Image::Data::create(Image::Info(4, 4, Image::Type::L_U8));
+            memset(glyph->imageData->getData(), 255, glyph->imageData->getDataByteCount());
+            glyph->offset = glm::vec2(1.F, 4.F);
+            glyph->advance = 6;
+
+            auto rasterizer = Render2D::Rasterizer::create();
+            const Image::Size size(16, 16);
+            for (size_t i = 0; i < 2; ++i)
+            {
+                // The second frame uses the cached glyph.
+                rasterizer->beginFrame(size);
+                rasterizer->setFillColor(Image::Color(0.F, 0.F, 1.F));
+                rasterizer->drawText({ glyph, glyph }, glm::vec2(2.F, 10.F));
+                auto out = rasterizer->endFrame(Image::Type::RGBA_F32);
+                DJV_ASSERT(compare(glm::vec4(0.F, 0.F, 1.F, 1.F), getPixel(*out, 3, 6)));
+                DJV_ASSERT(compare(glm::vec4(0.F, 0.F, 1.F, 1.F), getPixel(*out, 12, 9)));
+                DJV_ASSERT(compare(clear, getPixel(*out, 7, 6)));
+                DJV_ASSERT(compare(clear, getPixel(*out, 3, 10)));
+                DJV_ASSERT(4 * 4 * 2 == getCoverage(*out));
+            }
+        }
+
+        void Render2DRasterizerTest::_threads()
+        {
+            // Draw the same frame with one thread and with the hardware
+            // concurrency, the results should be identical.
+            const Image::Size size(1920, 1080);
+            auto image = Image::Image::create(Image::Info(640, 360, Image::Type::RGB_U8));
+            for (uint16_t y = 0; y < image->getHeight(); ++y)
+            {
+                uint8_t* p = image->getData(y);
+                for (uint16_t x = 0; x < image->getWidth(); ++x, p += 3)
+                {
+                    p[0] = static_cast<uint8_t>(x);
+                    p[1] = static_cast<uint8_t>(y);
+                    p[2] = static_cast<uint8_t>(x + y);
+                }
+            }
+            std::shared_ptr<Image::Data> out[2];
+            for (size_t i = 0; i < 2; ++i)
+            {
+                auto rasterizer = Render2D::Rasterizer::create(0 == i ? 1 : 0);
+                rasterizer->beginFrame(size);
+                rasterizer->setFillColor(Image::Color(.2F, .2F, .2F));
+                rasterizer->drawRect(BBox2f(0.F, 0.F, size.w, size.h));
+                rasterizer->pushTransform(translate(100.F, 100.F));
+                rasterizer->drawImage(image, glm::vec2(0.F, 0.F));
+                rasterizer->popTransform();
+                for (size_t j = 0; j < 200; ++j)
+                {
+                    const float x = static_cast<float>((j * 97) % size.w);
+                    const float y = static_cast<float>((j * 61) % size.h);
+                    rasterizer->setFillColor(Image::Color(j % 3 / 2.F, j % 5 / 4.F, j % 7 / 6.F, .5F));
+                    rasterizer->drawShadow(BBox2f(x, y, 120.F, 40.F), 8.F);
+                    rasterizer->drawPill(BBox2f(x + 8.F, y + 8.F, 104.F, 24.F));
+                    rasterizer->drawCircle(glm::vec2(y, x / 2.F), 20.F);
+                    rasterizer->drawPolyline({ glm::vec2(x, y), glm::vec2(y, x / 2.F), glm::vec2(x / 2.F, y / 2.F) });
+                }
+                out[i] = rasterizer->endFrame();
+            }
+            DJV_ASSERT(out[0]->getDataByteCount() == out[1]->getDataByteCount());
+            DJV_ASSERT(0 == memcmp(out[0]->getData(), out[1]->getData(), out[0]->getDataByteCount()));
+        }
+
+    } // namespace AVTest
+} // namespace djv
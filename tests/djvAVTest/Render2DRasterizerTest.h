@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class Render2DRasterizerTest : public Test::ITest
+        {
+        public:
+            Render2DRasterizerTest(const std::shared_ptr<Core::Context>&);
+
+            void run() override;
+
+        private:
+            void _primitives();
+            void _blend();
+            void _images();
+            void _text();
+            void _threads();
+        };
+
+    } // namespace AVTest
+} // namespace djv
@@ -4,6 +4,7 @@
 
 #include <djvAVTest/TagsTest.h>
 
+#include <djvAV/Image.h>
 #include <djvAV/Tags.h>
 
 using namespace djv::Core;
@@ -56,6 +57,46 @@ namespace djv
                 tags2.setTags(map);
                 DJV_ASSERT(tags == tags2);
             }
+
+            {
+                // Copies share the map until one of them is modified.
+                Tags tags;
+                tags.setTag("a", "1");
+                Tags tags2 = tags;
+                DJV_ASSERT(&tags.getTags() == &tags2.getTags());
+                tags2.setTag("b", "2");
+                DJV_ASSERT(&tags.getTags() != &tags2.getTags());
+                DJV_ASSERT(!tags.hasTag("b"));
+                DJV_ASSERT("2" == tags2.getTag("b"));
+            }
+
+            {
+                // Tags with the same values can share a single map.
+                Tags tags;
+                tags.setTag("a", "1");
+                tags.setTag("b", "2");
+                Tags tags2;
+                tags2.setTag("a", "1");
+                tags2.setTag("b", "2");
+                Tags tags3;
+                tags3.setTag("a", "1");
+                tags3.setTag("b", "3");
+                const Tags copy = tags;
+                tags.share();
+                tags2.share();
+                tags3.share();
+                DJV_ASSERT(&tags.getTags() == &tags2.getTags());
+                DJV_ASSERT(&tags.getTags() != &tags3.getTags());
+
+                // Modifying shared tags does not change the others.
+                tags2.setTag("c", "3");
+                DJV_ASSERT(!tags.hasTag("c"));
+                DJV_ASSERT(tags == copy);
+
+                auto image = Image::Image::create(Image::Info(1, 1, Image::Type::L_U8));
+                image->setTags(copy);
+                DJV_ASSERT(&tags.getTags() == &image->getTags().getTags());
+            }
         }
 
     } // namespace AVTest
@@ -33,6 +33,12 @@ namespace djv
                 auto system = context->getSystemT<ThumbnailSystem>();
                 auto infoFuture = system->getInfo(fileInfo);
                 auto imageFuture = system->getImage(fileInfo, Image::Size(32, 32));
+                auto imageLowFuture = system->getImage(
+                    fileInfo,
+                    Image::Size(16, 16),
+                    Image::Type::RGBA_U8,
+                    ThumbnailSystem::Priority::Low);
+                system->setImagePriority(imageLowFuture.uid, ThumbnailSystem::Priority::High);
                 
                 auto infoCancelFuture = system->getInfo(fileInfo);
                 auto imageCancelFuture = system->getImage(fileInfo, Image::Size(32, 32));
@@ -41,9 +47,11 @@ namespace djv
                 
                 IO::Info info;
                 std::shared_ptr<Image::Image> image;
+                std::shared_ptr<Image::Image> imageLow;
                 while (
                     infoFuture.future.valid() ||
-                    imageFuture.future.valid())
+                    imageFuture.future.valid() ||
+                    imageLowFuture.future.valid())
                 {
                     _tickFor(Time::getTime(Time::TimerValue::Fast));
                     if (infoFuture.future.valid() &&
@@ -56,6 +64,16 @@ namespace djv
                     {
                         image = imageFuture.future.get();
                     }
+                    if (imageLowFuture.future.valid() &&
+                        imageLowFuture.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        imageLow = imageLowFuture.future.get();
+                    }
+                }
+                if (imageLow)
+                {
+                    DJV_ASSERT(Image::Type::RGBA_U8 == imageLow->getType());
+                    DJV_ASSERT(imageLow->getWidth() <= 16 && imageLow->getHeight() <= 16);
                 }
                 
                 if (info.video.size())
@@ -82,6 +100,18 @@ namespace djv
                     _print(ss.str());
                 }
                 
+                {
+                    const auto stats = system->getStats();
+                    DJV_ASSERT(0 == stats.infoQueue);
+                    DJV_ASSERT(0 == stats.imageQueue);
+                    DJV_ASSERT(stats.latency50 <= stats.latency90);
+                    DJV_ASSERT(stats.latency90 <= stats.latency99);
+                    std::stringstream ss;
+                    ss << "workers: " << system->getWorkerCount() << ", latency: " << stats.latency50 << "/" <<
+                        stats.latency90 << "/" << stats.latency99;
+                    _print(ss.str());
+                }
+                
                 system->clearCache();
             }
         }
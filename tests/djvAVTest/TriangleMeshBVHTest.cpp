@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/TriangleMeshBVHTest.h>
+
+#include <djvAV/TriangleMesh.h>
+#include <djvAV/TriangleMeshBVH.h>
+
+#include <djvCore/Math.h>
+
+#include <glm/geometric.hpp>
+
+#include <random>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            //! Create a bumpy grid in the XZ plane.
+            std::shared_ptr<Geom::TriangleMesh> createGrid(size_t size)
+            {
+                auto out = std::make_shared<Geom::TriangleMesh>();
+                std::mt19937 rng;
+                std::uniform_real_distribution<float> height(0.F, .5F);
+                for (size_t y = 0; y <= size; ++y)
+                {
+                    for (size_t x = 0; x <= size; ++x)
+                    {
+                        out->v.push_back(glm::vec3(x, height(rng), y));
+                    }
+                }
+                for (size_t y = 0; y < size; ++y)
+                {
+                    for (size_t x = 0; x < size; ++x)
+                    {
+                        const size_t i = y * (size + 1) + x + 1;
+                        Geom::TriangleMesh::Triangle a;
+                        a.v0.v = i;
+                        a.v1.v = i + 1;
+                        a.v2.v = i + size + 2;
+                        out->triangles.push_back(a);
+                        Geom::TriangleMesh::Triangle b;
+                        b.v0.v = i;
+                        b.v1.v = i + size + 2;
+                        b.v2.v = i + size + 1;
+                        out->triangles.push_back(b);
+                    }
+                }
+                out->bboxUpdate();
+                return out;
+            }
+
+            std::vector<Geom::Ray> createRays(size_t count, float size)
+            {
+                std::vector<Geom::Ray> out;
+                std::mt19937 rng;
+                std::uniform_real_distribution<float> pos(-1.F, size + 1.F);
+                std::uniform_real_distribution<float> dir(-.5F, .5F);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    out.push_back(Geom::Ray(
+                        glm::vec3(pos(rng), 10.F, pos(rng)),
+                        glm::normalize(glm::vec3(dir(rng), -1.F, dir(rng)))));
+                }
+                return out;
+            }
+
+            bool intersectBruteForce(const Geom::Ray& ray, const Geom::TriangleMesh& mesh, float& t)
+            {
+                bool out = false;
+                for (const auto& i : mesh.triangles)
+                {
+                    glm::vec3 hit;
+                    glm::vec3 barycentric;
+                    if (Geom::TriangleMesh::intersectTriangle(
+                        ray.pos,
+                        ray.dir,
+                        mesh.v[i.v0.v - 1],
+                        mesh.v[i.v1.v - 1],
+                        mesh.v[i.v2.v - 1],
+                        hit,
+                        barycentric))
+                    {
+                        const float distance = glm::distance(ray.pos, hit);
+                        if (!out || distance < t)
+                        {
+                            t = distance;
+                            out = true;
+                        }
+                    }
+                }
+                return out;
+            }
+
+        } // namespace
+
+        TriangleMeshBVHTest::TriangleMeshBVHTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::TriangleMeshBVHTest", context)
+        {}
+        
+        void TriangleMeshBVHTest::run()
+        {
+            _empty();
+            _intersect();
+            _copy();
+        }
+
+        void TriangleMeshBVHTest::_empty()
+        {
+            Geom::TriangleMesh mesh;
+            auto bvh = mesh.getBVH();
+            DJV_ASSERT(0 == bvh->getTriangleCount());
+            DJV_ASSERT(0 == bvh->getNodeCount());
+            Geom::RayHit hit;
+            DJV_ASSERT(!bvh->intersect(Geom::Ray(glm::vec3(0.F, 0.F, 0.F), glm::vec3(0.F, 0.F, 1.F)), hit));
+            DJV_ASSERT(!hit.isValid());
+            DJV_ASSERT(!bvh->intersectAny(Geom::Ray(glm::vec3(0.F, 0.F, 0.F), glm::vec3(0.F, 0.F, 1.F))));
+        }
+
+        void TriangleMeshBVHTest::_intersect()
+        {
+            auto mesh = createGrid(64);
+            auto bvh = mesh->getBVH();
+            DJV_ASSERT(bvh == mesh->getBVH());
+            DJV_ASSERT(mesh->triangles.size() == bvh->getTriangleCount());
+            DJV_ASSERT(bvh->getNodeCount() > 0);
+
+            // Compare against a brute force search.
+            const auto rays = createRays(1000, 64.F);
+            std::vector<Geom::RayHit> hits;
+            bvh->intersect(rays, hits);
+            DJV_ASSERT(rays.size() == hits.size());
+            for (size_t i = 0; i < rays.size(); ++i)
+            {
+                float t = 0.F;
+                const bool bruteForce = intersectBruteForce(rays[i], *mesh, t);
+                Geom::RayHit hit;
+                DJV_ASSERT(bruteForce == bvh->intersect(rays[i], hit));
+                DJV_ASSERT(bruteForce == hits[i].isValid());
+                DJV_ASSERT(bruteForce == bvh->intersectAny(rays[i]));
+                if (bruteForce)
+                {
+                    DJV_ASSERT(fuzzyCompare(t, glm::distance(rays[i].pos, hit.pos), .1e-3F));
+                    DJV_ASSERT(fuzzyCompare(hit.t, hits[i].t));
+                    DJV_ASSERT(hit.triangle < mesh->triangles.size());
+                    const auto& triangle = mesh->triangles[hit.triangle];
+                    const glm::vec3 pos =
+                        mesh->v[triangle.v0.v - 1] * hit.barycentric.x +
+                        mesh->v[triangle.v1.v - 1] * hit.barycentric.y +
+                        mesh->v[triangle.v2.v - 1] * hit.barycentric.z;
+                    DJV_ASSERT(glm::distance(pos, hit.pos) < .1e-3F);
+
+                    glm::vec3 meshHit;
+                    DJV_ASSERT(Geom::TriangleMesh::intersect(rays[i].pos, rays[i].dir, *mesh, meshHit));
+                    DJV_ASSERT(glm::distance(meshHit, hit.pos) < .1e-3F);
+                }
+            }
+
+            // Hits past the maximum distance are ignored.
+            Geom::Ray ray(glm::vec3(32.F, 10.F, 32.F), glm::vec3(0.F, -1.F, 0.F), 5.F);
+            DJV_ASSERT(!bvh->intersectAny(ray));
+            ray.tMax = 20.F;
+            DJV_ASSERT(bvh->intersectAny(ray));
+
+            mesh->bvhReset();
+            DJV_ASSERT(bvh != mesh->getBVH());
+        }
+
+        void TriangleMeshBVHTest::_copy()
+        {
+            auto mesh = createGrid(8);
+            auto bvh = mesh->getBVH();
+
+            // Copies build their own hierarchy, so changing the copy does not
+            // leave it with the hierarchy of the original mesh.
+            Geom::TriangleMesh copy(*mesh);
+            for (auto& i : copy.v)
+            {
+                i.y += 100.F;
+            }
+            copy.bboxUpdate();
+            auto copyBVH = copy.getBVH();
+            DJV_ASSERT(copyBVH != bvh);
+            const Geom::Ray ray(glm::vec3(4.F, 10.F, 4.F), glm::vec3(0.F, -1.F, 0.F));
+            DJV_ASSERT(bvh->intersectAny(ray));
+            DJV_ASSERT(!copyBVH->intersectAny(ray));
+
+            Geom::TriangleMesh assigned;
+            assigned.getBVH();
+            assigned = *mesh;
+            DJV_ASSERT(mesh->triangles.size() == assigned.getBVH()->getTriangleCount());
+            DJV_ASSERT(assigned.getBVH() != bvh);
+
+            Geom::TriangleMesh moved(std::move(copy));
+            DJV_ASSERT(moved.getBVH() != copyBVH);
+            DJV_ASSERT(!moved.getBVH()->intersectAny(ray));
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class TriangleMeshBVHTest : public Test::ITest
+        {
+        public:
+            TriangleMeshBVHTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _empty();
+            void _intersect();
+            void _copy();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvAVTest/TriangleMeshWeldTest.h>
+
+#include <djvAV/OpenGLMesh.h>
+#include <djvAV/TriangleMesh.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            //! Create a grid in the XZ plane with shared positions and texture
+            //! coordinates, like a mesh read from an OBJ file. Faceted grids
+            //! have a normal for each quad.
+            Geom::TriangleMesh createGrid(size_t size, bool faceted)
+            {
+                Geom::TriangleMesh out;
+                for (size_t y = 0; y <= size; ++y)
+                {
+                    for (size_t x = 0; x <= size; ++x)
+                    {
+                        out.v.push_back(glm::vec3(x, 0.F, y));
+                        out.t.push_back(glm::vec2(x / static_cast<float>(size), y / static_cast<float>(size)));
+                    }
+                }
+                for (size_t y = 0; y < size; ++y)
+                {
+                    for (size_t x = 0; x < size; ++x)
+                    {
+                        const size_t i = y * (size + 1) + x + 1;
+                        size_t n = 0;
+                        if (faceted)
+                        {
+                            out.n.push_back(glm::vec3(0.F, 1.F, 0.F));
+                            n = out.n.size();
+                        }
+                        Geom::TriangleMesh::Triangle a;
+                        a.v0 = Geom::TriangleMesh::Vertex(i, i, n);
+                        a.v1 = Geom::TriangleMesh::Vertex(i + 1, i + 1, n);
+                        a.v2 = Geom::TriangleMesh::Vertex(i + size + 2, i + size + 2, n);
+                        out.triangles.push_back(a);
+                        Geom::TriangleMesh::Triangle b;
+                        b.v0 = Geom::TriangleMesh::Vertex(i, i, n);
+                        b.v1 = Geom::TriangleMesh::Vertex(i + size + 2, i + size + 2, n);
+                        b.v2 = Geom::TriangleMesh::Vertex(i + size + 1, i + size + 1, n);
+                        out.triangles.push_back(b);
+                    }
+                }
+                out.bboxUpdate();
+                return out;
+            }
+
+            std::vector<uint32_t> sortTriangles(const std::vector<uint32_t>& indices)
+            {
+                std::vector<std::vector<uint32_t> > triangles;
+                for (size_t i = 0; i < indices.size(); i += 3)
+                {
+                    triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+                }
+                std::sort(triangles.begin(), triangles.end());
+                std::vector<uint32_t> out;
+                for (const auto& i : triangles)
+                {
+                    out.insert(out.end(), i.begin(), i.end());
+                }
+                return out;
+            }
+
+            //! Get the sorted positions of the triangles.
+            std::vector<std::vector<float> > getTrianglePositions(const Geom::TriangleMesh& mesh)
+            {
+                std::vector<std::vector<float> > out;
+                for (const auto& i : mesh.triangles)
+                {
+                    std::vector<float> triangle;
+                    for (const auto& j : { i.v0, i.v1, i.v2 })
+                    {
+                        const auto& v = mesh.v[j.v - 1];
+                        triangle.insert(triangle.end(), { v.x, v.y, v.z });
+                    }
+                    out.push_back(triangle);
+                }
+                std::sort(out.begin(), out.end());
+                return out;
+            }
+
+        } // namespace
+
+        TriangleMeshWeldTest::TriangleMeshWeldTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::TriangleMeshWeldTest", context)
+        {}
+        
+        void TriangleMeshWeldTest::run()
+        {
+            _vertex();
+            _weld();
+            _optimize();
+            _weldMesh();
+        }
+
+        void TriangleMeshWeldTest::_vertex()
+        {
+            DJV_ASSERT(12 == sizeof(Geom::TriangleMesh::Vertex));
+            DJV_ASSERT(36 == sizeof(Geom::TriangleMesh::Triangle));
+            const Geom::TriangleMesh::Vertex vertex(1, 2, 3);
+            DJV_ASSERT(1 == vertex.v);
+            DJV_ASSERT(2 == vertex.t);
+            DJV_ASSERT(3 == vertex.n);
+        }
+
+        void TriangleMeshWeldTest::_weld()
+        {
+            {
+                Geom::TriangleMesh mesh;
+                std::vector<Geom::TriangleMesh::Vertex> vertices;
+                std::vector<uint32_t> indices;
+                Geom::TriangleMesh::weld(mesh, vertices, indices);
+                DJV_ASSERT(vertices.empty());
+                DJV_ASSERT(indices.empty());
+            }
+            for (const bool faceted : { false, true })
+            {
+                const auto mesh = createGrid(16, faceted);
+                std::vector<Geom::TriangleMesh::Vertex> vertices;
+                std::vector<uint32_t> indices;
+                Geom::TriangleMesh::weld(mesh, vertices, indices);
+                DJV_ASSERT(mesh.triangles.size() * 3 == indices.size());
+                if (!faceted)
+                {
+                    DJV_ASSERT(mesh.v.size() == vertices.size());
+                }
+                else
+                {
+                    // The quad normals split the vertices between quads.
+                    DJV_ASSERT(mesh.triangles.size() * 2 == vertices.size());
+                }
+                for (size_t i = 0; i < vertices.size(); ++i)
+                {
+                    for (size_t j = i + 1; j < std::min(vertices.size(), i + 16); ++j)
+                    {
+                        DJV_ASSERT(!(vertices[i] == vertices[j]));
+                    }
+                }
+                for (size_t i = 0; i < mesh.triangles.size(); ++i)
+                {
+                    const auto& triangle = mesh.triangles[i];
+                    DJV_ASSERT(triangle.v0 == vertices[indices[i * 3 + 0]]);
+                    DJV_ASSERT(triangle.v1 == vertices[indices[i * 3 + 1]]);
+                    DJV_ASSERT(triangle.v2 == vertices[indices[i * 3 + 2]]);
+                }
+
+                // The indexed data matches the unindexed data.
+                const auto type = OpenGL::VBOType::Pos3_F32_UV_U16_Normal_U10;
+                const size_t vertexByteCount = OpenGL::getVertexByteCount(type);
+                const auto data = OpenGL::VBO::convert(mesh, type);
+                const auto indexedData = OpenGL::VBO::convert(mesh, vertices, type);
+                DJV_ASSERT(vertices.size() * vertexByteCount == indexedData.size());
+                for (size_t i = 0; i < indices.size(); ++i)
+                {
+                    DJV_ASSERT(0 == memcmp(
+                        data.data() + i * vertexByteCount,
+                        indexedData.data() + indices[i] * vertexByteCount,
+                        vertexByteCount));
+                }
+            }
+        }
+
+        void TriangleMeshWeldTest::_optimize()
+        {
+            {
+                std::vector<uint32_t> indices;
+                Geom::TriangleMesh::optimizeVertexCache(indices, 0);
+                DJV_ASSERT(indices.empty());
+                DJV_ASSERT(0.F == Geom::TriangleMesh::getACMR(indices, 32));
+                indices = { 0, 1, 2 };
+                Geom::TriangleMesh::optimizeVertexCache(indices, 3);
+                DJV_ASSERT(std::vector<uint32_t>({ 0, 1, 2 }) == indices);
+                DJV_ASSERT(3.F == Geom::TriangleMesh::getACMR(indices, 32));
+            }
+
+            // Shuffle the triangles and check that the optimized order
+            // contains the same triangles with fewer cache misses.
+            const auto mesh = createGrid(64, false);
+            std::vector<Geom::TriangleMesh::Vertex> vertices;
+            std::vector<uint32_t> indices;
+            Geom::TriangleMesh::weld(mesh, vertices, indices);
+            std::vector<size_t> order(indices.size() / 3);
+            for (size_t i = 0; i < order.size(); ++i)
+            {
+                order[i] = i;
+            }
+            std::shuffle(order.begin(), order.end(), std::mt19937());
+            std::vector<uint32_t> shuffled;
+            for (const auto i : order)
+            {
+                shuffled.insert(shuffled.end(), indices.begin() + i * 3, indices.begin() + i * 3 + 3);
+            }
+            std::vector<uint32_t> optimized = shuffled;
+            Geom::TriangleMesh::optimizeVertexCache(optimized, vertices.size());
+            DJV_ASSERT(sortTriangles(shuffled) == sortTriangles(optimized));
+            const float shuffledACMR = Geom::TriangleMesh::getACMR(shuffled, 32);
+            const float optimizedACMR = Geom::TriangleMesh::getACMR(optimized, 32);
+            std::stringstream ss;
+            ss << "ACMR shuffled: " << shuffledACMR << ", optimized: " << optimizedACMR;
+            _print(ss.str());
+            DJV_ASSERT(optimizedACMR < shuffledACMR);
+            DJV_ASSERT(optimizedACMR < 1.F);
+        }
+
+        void TriangleMeshWeldTest::_weldMesh()
+        {
+            {
+                Geom::TriangleMesh mesh;
+                Geom::TriangleMesh::weld(mesh);
+                DJV_ASSERT(mesh.v.empty());
+                DJV_ASSERT(mesh.triangles.empty());
+            }
+
+            // Split the vertices of a grid for each triangle, like a mesh read
+            // from a file that does not share vertices, and check that welding
+            // shares them again.
+            const size_t size = 16;
+            const auto grid = createGrid(size, false);
+            Geom::TriangleMesh mesh;
+            auto split = [&grid, &mesh](const Geom::TriangleMesh::Vertex& value)
+            {
+                mesh.v.push_back(grid.v[value.v - 1]);
+                mesh.t.push_back(grid.t[value.t - 1]);
+                return Geom::TriangleMesh::Vertex(mesh.v.size(), mesh.t.size());
+            };
+            for (const auto& i : grid.triangles)
+            {
+                Geom::TriangleMesh::Triangle triangle;
+                triangle.v0 = split(i.v0);
+                triangle.v1 = split(i.v1);
+                triangle.v2 = split(i.v2);
+                mesh.triangles.push_back(triangle);
+            }
+            Geom::TriangleMesh::weld(mesh);
+            DJV_ASSERT(grid.v.size() == mesh.v.size());
+            DJV_ASSERT(grid.t.size() == mesh.t.size());
+            DJV_ASSERT(grid.triangles.size() == mesh.triangles.size());
+            DJV_ASSERT(getTrianglePositions(grid) == getTrianglePositions(mesh));
+            for (const auto& i : mesh.triangles)
+            {
+                for (const auto& j : { i.v0, i.v1, i.v2 })
+                {
+                    DJV_ASSERT(j.v > 0 && j.v <= mesh.v.size());
+                    DJV_ASSERT(j.t > 0 && j.t <= mesh.t.size());
+                    DJV_ASSERT(0 == j.n);
+                }
+            }
+
+            // Vertices with different colors are not merged.
+            Geom::TriangleMesh colorMesh = mesh;
+            colorMesh.c.resize(colorMesh.v.size(), glm::vec3(1.F, 1.F, 1.F));
+            colorMesh.v.push_back(colorMesh.v[0]);
+            colorMesh.c.push_back(glm::vec3(1.F, 0.F, 0.F));
+            colorMesh.triangles[0].v0.v = colorMesh.v.size();
+            Geom::TriangleMesh::weld(colorMesh);
+            DJV_ASSERT(mesh.v.size() + 1 == colorMesh.v.size());
+            DJV_ASSERT(colorMesh.v.size() == colorMesh.c.size());
+        }
+
+    } // namespace AVTest
+} // namespace djv
+
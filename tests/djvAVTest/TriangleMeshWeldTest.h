@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace AVTest
+    {
+        class TriangleMeshWeldTest : public Test::ITest
+        {
+        public:
+            TriangleMeshWeldTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _vertex();
+            void _weld();
+            void _optimize();
+            void _weldMesh();
+        };
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -65,6 +65,26 @@ namespace djv
                     ss << "fps averge: " << context->getFPSAverage();
                     _print(ss.str());
                 }
+
+                {
+                    const auto& timeline = context->getStartupTimeline();
+                    DJV_ASSERT(timeline.size() >= context->getSystems().size());
+                    for (size_t i = 1; i < timeline.size(); ++i)
+                    {
+                        DJV_ASSERT(timeline[i].start >= timeline[i - 1].start);
+                    }
+
+                    // Systems that are created by another system are nested
+                    // inside of it.
+                    for (size_t i = 0; i < timeline.size(); ++i)
+                    {
+                        const auto end = timeline[i].start + timeline[i].duration;
+                        for (size_t j = i + 1; j < timeline.size() && timeline[j].start < end; ++j)
+                        {
+                            DJV_ASSERT(timeline[j].start + timeline[j].duration <= end);
+                        }
+                    }
+                }
             }
         }
         
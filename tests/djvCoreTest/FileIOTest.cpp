@@ -5,6 +5,7 @@
 #include <djvCoreTest/FileIOTest.h>
 
 #include <djvCore/FileIO.h>
+#include <djvCore/Memory.h>
 
 #include <sstream>
 
@@ -27,6 +28,7 @@ namespace djv
             _error();
             _endian();
             _temp();
+            _readType();
         }
 
         void FileIOTest::_io()
@@ -109,6 +111,17 @@ namespace djv
                 DJV_ASSERT(_text2 == lines[2]);
             }
 
+            {
+                FileSystem::FileIO::writeAtomic(_fileName, _text.data(), _text.size());
+                FileSystem::FileIO::writeAtomic(_fileName, _text2.data(), _text2.size());
+
+                auto io = FileSystem::FileIO::create();
+                io->open(_fileName, FileSystem::FileIO::Mode::Read);
+                const std::string buf = FileSystem::FileIO::readContents(io);
+                _print(buf);
+                DJV_ASSERT(_text2 == buf);
+            }
+
             {
                 const int8_t   i8  = std::numeric_limits<int8_t>::max();
                 const uint8_t  u8  = std::numeric_limits<uint8_t>::max();
@@ -238,7 +251,74 @@ namespace djv
                 io->writeU8(i);
             }
         }
-        
+
+        void FileIOTest::_readType()
+        {
+            for (auto i : FileSystem::getReadTypeEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("Read type: " + _getText(ss.str()));
+            }
+
+            const size_t size = 16 * Memory::megabyte + 3;
+            std::vector<uint8_t> data(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                data[i] = static_cast<uint8_t>(i);
+            }
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(_fileName, FileSystem::FileIO::Mode::Write);
+                io->write(data.data(), size);
+            }
+
+            for (auto readType : FileSystem::getReadTypeEnums())
+            {
+                auto io = FileSystem::FileIO::create();
+                io->setReadType(readType);
+                DJV_ASSERT(readType == io->getReadType());
+                io->open(_fileName, FileSystem::FileIO::Mode::Read);
+                DJV_ASSERT(io->isOpen());
+                DJV_ASSERT(size == io->getSize());
+                std::vector<uint8_t> buf(size);
+                io->read(buf.data(), size);
+                DJV_ASSERT(data == buf);
+                DJV_ASSERT(io->isEOF());
+                switch (readType)
+                {
+                case FileSystem::ReadType::Normal:
+                    DJV_ASSERT(!io->mmapP());
+                    break;
+                case FileSystem::ReadType::MemoryMap:
+                    DJV_ASSERT(io->isMemoryMapped());
+                    DJV_ASSERT(io->mmapP() == io->mmapEnd());
+                    break;
+                case FileSystem::ReadType::DirectIO:
+                    DJV_ASSERT(!io->isMemoryMapped());
+                    DJV_ASSERT(io->mmapP() == io->mmapEnd());
+                    break;
+                default: break;
+                }
+
+                io->setPos(size - 1);
+                uint8_t value = 0;
+                io->readU8(&value);
+                DJV_ASSERT(data[size - 1] == value);
+            }
+
+            for (auto readType : FileSystem::getReadTypeEnums())
+            {
+                FileSystem::FileIO::writeLines(_fileName, {});
+                auto io = FileSystem::FileIO::create();
+                io->setReadType(readType);
+                io->open(_fileName, FileSystem::FileIO::Mode::Read);
+                DJV_ASSERT(io->isOpen());
+                DJV_ASSERT(0 == io->getSize());
+                DJV_ASSERT(io->isEOF());
+            }
+        }
+
     } // namespace CoreTest
 } // namespace djv
 
@@ -37,6 +37,7 @@ namespace djv
             {
                 auto out = std::shared_ptr<TestSystem>(new TestSystem);
                 out->_init(context);
+                out->_setStartupEnd();
                 return out;
             }
         };
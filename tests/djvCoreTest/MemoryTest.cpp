@@ -149,6 +149,24 @@ namespace djv
                 DJV_ASSERT(6 == p2[6]);
                 DJV_ASSERT(7 == p2[7]);
             }
+
+            {
+                DJV_ASSERT(0x0201 == Memory::byteSwap(static_cast<uint16_t>(0x0102)));
+                DJV_ASSERT(0x04030201 == Memory::byteSwap(static_cast<uint32_t>(0x01020304)));
+                DJV_ASSERT(0x0807060504030201 == Memory::byteSwap(static_cast<uint64_t>(0x0102030405060708)));
+            }
+
+            {
+                // Unaligned data.
+                uint8_t data[13];
+                for (uint8_t i = 0; i < 13; ++i)
+                {
+                    data[i] = i;
+                }
+                Memory::endian(data + 1, 3, 4);
+                const uint8_t result[] = { 0, 4, 3, 2, 1, 8, 7, 6, 5, 12, 11, 10, 9 };
+                DJV_ASSERT(0 == memcmp(data, result, 13));
+            }
         }
         
         void MemoryTest::_hash()
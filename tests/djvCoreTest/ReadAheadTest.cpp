@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCoreTest/ReadAheadTest.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/Memory.h>
+#include <djvCore/ReadAhead.h>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        namespace
+        {
+            std::string getFileName(size_t index)
+            {
+                std::stringstream ss;
+                ss << "ReadAheadTest." << index;
+                return ss.str();
+            }
+
+            void waitReady(const std::shared_ptr<FileSystem::ReadAhead>& readAhead, size_t count)
+            {
+                const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                while (readAhead->getStats().readyCount < count &&
+                    std::chrono::steady_clock::now() < timeout)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+
+        } // namespace
+
+        ReadAheadTest::ReadAheadTest(const std::shared_ptr<Context>& context) :
+            ITest("djv::CoreTest::ReadAheadTest", context)
+        {}
+        
+        void ReadAheadTest::run()
+        {
+            _enum();
+            _request();
+            _shared();
+            _cancel();
+            _open();
+            _buffer();
+        }
+
+        void ReadAheadTest::_enum()
+        {
+            for (auto i : FileSystem::getReadAheadBackendEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("Read-ahead backend: " + _getText(ss.str()));
+            }
+        }
+
+        void ReadAheadTest::_request()
+        {
+            std::vector<std::string> fileNames;
+            for (size_t i = 0; i < 10; ++i)
+            {
+                const std::string fileName = getFileName(i);
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Write);
+                io->write(fileName);
+                fileNames.push_back(fileName);
+            }
+
+            auto readAhead = FileSystem::ReadAhead::create(2);
+            {
+                std::stringstream ss;
+                ss << readAhead->getBackend();
+                _print("Backend: " + _getText(ss.str()));
+            }
+            readAhead->setMaxByteCount(1024);
+            DJV_ASSERT(1024 == readAhead->getMaxByteCount());
+            readAhead->request(fileNames);
+            waitReady(readAhead, fileNames.size());
+            for (const auto& i : fileNames)
+            {
+                auto data = readAhead->take(i);
+                DJV_ASSERT(data);
+                DJV_ASSERT(std::string(data->begin(), data->end()) == i);
+            }
+            DJV_ASSERT(!readAhead->take(fileNames[0]));
+            DJV_ASSERT(!readAhead->take("ReadAheadTest.missing"));
+
+            readAhead->request({ "ReadAheadTest.missing" });
+            DJV_ASSERT(!readAhead->take("ReadAheadTest.missing"));
+
+            readAhead->request(fileNames);
+            readAhead->request({ fileNames[1] });
+            waitReady(readAhead, 1);
+            auto data = readAhead->take(fileNames[1]);
+            DJV_ASSERT(data);
+            readAhead->clear();
+            DJV_ASSERT(!readAhead->take(fileNames[2]));
+
+            const auto stats = readAhead->getStats();
+            {
+                std::stringstream ss;
+                ss << "Hits: " << stats.hits;
+                _print(ss.str());
+            }
+            {
+                std::stringstream ss;
+                ss << "Misses: " << stats.misses;
+                _print(ss.str());
+            }
+            DJV_ASSERT(stats.hits >= 11);
+            DJV_ASSERT(stats == stats);
+        }
+
+        void ReadAheadTest::_shared()
+        {
+            std::vector<std::string> fileNames;
+            for (size_t i = 0; i < 10; ++i)
+            {
+                fileNames.push_back(getFileName(i));
+            }
+
+            auto readAhead = FileSystem::ReadAhead::create(1);
+            auto readAhead2 = FileSystem::ReadAhead::create(1);
+            DJV_ASSERT(readAhead->getBackend() == readAhead2->getBackend());
+            readAhead->setThreadCount(100);
+            readAhead->request(fileNames);
+            readAhead2->request({ fileNames[0], fileNames[1] });
+            waitReady(readAhead, fileNames.size());
+            waitReady(readAhead2, 2);
+            for (const auto& i : fileNames)
+            {
+                auto data = readAhead->take(i);
+                DJV_ASSERT(data);
+                DJV_ASSERT(std::string(data->begin(), data->end()) == i);
+            }
+            DJV_ASSERT(readAhead2->take(fileNames[0]));
+            DJV_ASSERT(readAhead2->take(fileNames[1]));
+            DJV_ASSERT(10 == readAhead->getStats().hits);
+            DJV_ASSERT(2 == readAhead2->getStats().hits);
+
+            readAhead2->request(fileNames);
+            readAhead2.reset();
+            readAhead->request(fileNames);
+            waitReady(readAhead, fileNames.size());
+            DJV_ASSERT(readAhead->take(fileNames[0]));
+        }
+
+        void ReadAheadTest::_cancel()
+        {
+            // Cancel the requests while another thread is waiting on them,
+            // the waits should return instead of blocking forever.
+            std::vector<std::string> fileNames;
+            const std::vector<uint8_t> buf(4 * Memory::megabyte, 0);
+            for (size_t i = 0; i < 8; ++i)
+            {
+                const std::string fileName = getFileName(i);
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Write);
+                io->write(buf.data(), buf.size());
+                fileNames.push_back(fileName);
+            }
+
+            for (size_t i = 0; i < 10; ++i)
+            {
+                auto readAhead = FileSystem::ReadAhead::create(4);
+                readAhead->request(fileNames);
+                std::thread thread(
+                    [readAhead, fileNames]
+                    {
+                        for (const auto& j : fileNames)
+                        {
+                            readAhead->take(j);
+                        }
+                    });
+                readAhead->clear();
+                thread.join();
+                DJV_ASSERT(0 == readAhead->getStats().readyCount);
+            }
+        }
+
+        void ReadAheadTest::_open()
+        {
+            const std::string fileName = getFileName(0);
+            auto readAhead = FileSystem::ReadAhead::create();
+            readAhead->request({ fileName });
+            for (size_t i = 0; i < 2; ++i)
+            {
+                auto io = FileSystem::FileIO::create();
+                readAhead->open(fileName, io);
+                DJV_ASSERT(io->isOpen());
+                DJV_ASSERT(io->getFileName() == fileName);
+                DJV_ASSERT(io->getSize() == fileName.size());
+                DJV_ASSERT(FileSystem::FileIO::readContents(io) == fileName);
+            }
+
+            try
+            {
+                auto io = FileSystem::FileIO::create();
+                readAhead->open("ReadAheadTest.missing", io);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+        }
+
+        void ReadAheadTest::_buffer()
+        {
+            auto buffer = std::shared_ptr<std::vector<uint8_t> >(new std::vector<uint8_t>);
+            buffer->push_back(0);
+            buffer->push_back(1);
+            buffer->push_back(2);
+            buffer->push_back(3);
+            auto io = FileSystem::FileIO::create();
+            io->open("ReadAheadTest.buffer", buffer);
+            DJV_ASSERT(io->isOpen());
+            DJV_ASSERT(4 == io->getSize());
+            DJV_ASSERT(!io->isEOF());
+
+            uint16_t value = 0;
+            io->setEndianConversion(true);
+            io->readU16(&value);
+            DJV_ASSERT((Memory::Endian::LSB == Memory::getEndian() ? 1 : 256) == value);
+            io->setEndianConversion(false);
+            io->seek(1);
+            uint8_t value2 = 0;
+            io->readU8(&value2);
+            DJV_ASSERT(3 == value2);
+            DJV_ASSERT(io->isEOF());
+
+            try
+            {
+                io->readU8(&value2);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            try
+            {
+                io->setPos(5);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            io->close();
+            DJV_ASSERT(!io->isOpen());
+        }
+
+    } // namespace CoreTest
+} // namespace djv
+
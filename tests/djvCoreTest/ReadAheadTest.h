@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        class ReadAheadTest : public Test::ITest
+        {
+        public:
+            ReadAheadTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+
+        private:
+            void _enum();
+            void _request();
+            void _shared();
+            void _cancel();
+            void _open();
+            void _buffer();
+        };
+        
+    } // namespace CoreTest
+} // namespace djv
+
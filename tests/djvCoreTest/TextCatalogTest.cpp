@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvCoreTest/TextCatalogTest.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/TextCatalog.h>
+
+#include <cstdio>
+#include <sstream>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        TextCatalogTest::TextCatalogTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::CoreTest::TextCatalogTest", context)
+        {}
+        
+        void TextCatalogTest::run()
+        {
+            _hash();
+            _lookup();
+            _io();
+        }
+
+        void TextCatalogTest::_hash()
+        {
+            DJV_ASSERT(14695981039346656037ULL == TextCatalog::getHash(std::string()));
+            DJV_ASSERT(0xaf63dc4c8601ec8cULL == TextCatalog::getHash("a"));
+            DJV_ASSERT(TextCatalog::getHash("a") != TextCatalog::getHash("a", 1));
+        }
+
+        void TextCatalogTest::_lookup()
+        {
+            {
+                auto catalog = TextCatalog::create({});
+                DJV_ASSERT(0 == catalog->getCount());
+                DJV_ASSERT(!catalog->getText("a"));
+                DJV_ASSERT(!catalog->getID("a"));
+            }
+
+            {
+                std::map<std::string, std::string> text;
+                for (size_t i = 0; i < 1000; ++i)
+                {
+                    std::stringstream ss;
+                    ss << "id_" << i;
+                    std::stringstream ss2;
+                    ss2 << "Text " << i;
+                    text[ss.str()] = ss2.str();
+                }
+                text["empty"] = std::string();
+                auto catalog = TextCatalog::create(text, 123);
+                DJV_ASSERT(123 == catalog->getKey());
+                DJV_ASSERT(text.size() == catalog->getCount());
+                for (const auto& i : text)
+                {
+                    const std::string* value = catalog->getText(i.first);
+                    DJV_ASSERT(value);
+                    DJV_ASSERT(i.second == *value);
+                    DJV_ASSERT(value == catalog->getText(i.first));
+                }
+                DJV_ASSERT(!catalog->getText("id_1000"));
+                DJV_ASSERT(!catalog->getText(std::string()));
+
+                const std::string* id = catalog->getID("Text 10");
+                DJV_ASSERT(id);
+                DJV_ASSERT("id_10" == *id);
+                DJV_ASSERT(!catalog->getID("Text 1000"));
+            }
+        }
+
+        void TextCatalogTest::_io()
+        {
+            const std::string fileName = "TextCatalogTest.catalog";
+            const std::map<std::string, std::string> text =
+            {
+                { "a", "1" },
+                { "b", "2" },
+                { "c", "3" }
+            };
+            TextCatalog::create(text, 1)->write(fileName);
+            {
+                auto catalog = TextCatalog::read(fileName);
+                DJV_ASSERT(1 == catalog->getKey());
+                DJV_ASSERT(text.size() == catalog->getCount());
+                for (const auto& i : text)
+                {
+                    const std::string* value = catalog->getText(i.first);
+                    DJV_ASSERT(value);
+                    DJV_ASSERT(i.second == *value);
+                }
+                catalog->write(fileName);
+            }
+
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Write);
+                io->write("Not a catalog");
+            }
+            try
+            {
+                TextCatalog::read(fileName);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+            std::remove(fileName.c_str());
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
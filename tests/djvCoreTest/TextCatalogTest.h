@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2004-2020 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        class TextCatalogTest : public Test::ITest
+        {
+        public:
+            TextCatalogTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+
+        private:
+            void _hash();
+            void _lookup();
+            void _io();
+        };
+        
+    } // namespace CoreTest
+} // namespace djv
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2019-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvSceneTest/BVHTest.h>
+
+#include <djvScene/BVH.h>
+#include <djvScene/MeshPrimitive.h>
+#include <djvScene/Scene.h>
+
+#include <djvAV/TriangleMesh.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace djv::Core;
+using namespace djv::AV;
+using namespace djv::Scene;
+
+namespace djv
+{
+    namespace SceneTest
+    {
+        namespace
+        {
+            //! Create a unit square in the XY plane.
+            std::shared_ptr<Geom::TriangleMesh> createSquare()
+            {
+                auto out = std::shared_ptr<Geom::TriangleMesh>(new Geom::TriangleMesh);
+                out->v.push_back(glm::vec3(0.F, 0.F, 0.F));
+                out->v.push_back(glm::vec3(1.F, 0.F, 0.F));
+                out->v.push_back(glm::vec3(1.F, 1.F, 0.F));
+                out->v.push_back(glm::vec3(0.F, 1.F, 0.F));
+                Geom::TriangleMesh::Triangle a;
+                a.v0 = Geom::TriangleMesh::Vertex(1);
+                a.v1 = Geom::TriangleMesh::Vertex(2);
+                a.v2 = Geom::TriangleMesh::Vertex(3);
+                out->triangles.push_back(a);
+                Geom::TriangleMesh::Triangle b;
+                b.v0 = Geom::TriangleMesh::Vertex(1);
+                b.v1 = Geom::TriangleMesh::Vertex(3);
+                b.v2 = Geom::TriangleMesh::Vertex(4);
+                out->triangles.push_back(b);
+                out->bboxUpdate();
+                return out;
+            }
+
+        } // namespace
+
+        BVHTest::BVHTest(const std::shared_ptr<Context>& context) :
+            ITest("djv::SceneTest::BVHTest", context)
+        {}
+        
+        void BVHTest::run()
+        {
+            _empty();
+            _intersect();
+        }
+
+        void BVHTest::_empty()
+        {
+            auto bvh = BVH::create(Scene::Scene::create());
+            DJV_ASSERT(0 == bvh->getInstanceCount());
+            const Geom::Ray ray(glm::vec3(0.F, 0.F, 1.F), glm::vec3(0.F, 0.F, -1.F));
+            BVHHit hit;
+            DJV_ASSERT(!bvh->intersect(ray, hit));
+            DJV_ASSERT(!hit.primitive);
+            DJV_ASSERT(!bvh->intersectAny(ray));
+        }
+
+        void BVHTest::_intersect()
+        {
+            // Two instances of the same mesh, the second one moved in front
+            // of the first one, and a hidden instance in front of both.
+            auto scene = Scene::Scene::create();
+            auto mesh = createSquare();
+            auto back = MeshPrimitive::create();
+            back->addMesh(mesh);
+            scene->addPrimitive(back);
+            auto front = MeshPrimitive::create();
+            front->addMesh(mesh);
+            front->setXForm(glm::translate(glm::mat4x4(1.F), glm::vec3(.5F, 0.F, 1.F)));
+            scene->addPrimitive(front);
+            auto hidden = MeshPrimitive::create();
+            hidden->addMesh(mesh);
+            hidden->setXForm(glm::translate(glm::mat4x4(1.F), glm::vec3(0.F, 0.F, 2.F)));
+            hidden->setVisible(false);
+            scene->addPrimitive(hidden);
+
+            auto bvh = BVH::create(scene);
+            DJV_ASSERT(2 == bvh->getInstanceCount());
+
+            // The nearest hit is the front instance, where they overlap.
+            const Geom::Ray ray(glm::vec3(.75F, .5F, 10.F), glm::vec3(0.F, 0.F, -1.F));
+            BVHHit hit;
+            DJV_ASSERT(bvh->intersect(ray, hit));
+            DJV_ASSERT(front == hit.primitive);
+            DJV_ASSERT(mesh == hit.mesh);
+            DJV_ASSERT(fuzzyCompare(hit.hit.pos.z, 1.F));
+            DJV_ASSERT(fuzzyCompare(hit.hit.t, 9.F));
+
+            // Only the back instance.
+            const Geom::Ray ray2(glm::vec3(.25F, .5F, 10.F), glm::vec3(0.F, 0.F, -1.F));
+            DJV_ASSERT(bvh->intersect(ray2, hit));
+            DJV_ASSERT(back == hit.primitive);
+            DJV_ASSERT(fuzzyCompare(hit.hit.pos.z, 0.F));
+
+            // Missing.
+            const Geom::Ray ray3(glm::vec3(5.F, 5.F, 10.F), glm::vec3(0.F, 0.F, -1.F));
+            DJV_ASSERT(!bvh->intersect(ray3, hit));
+            DJV_ASSERT(!bvh->intersectAny(ray3));
+            DJV_ASSERT(bvh->intersectAny(ray));
+
+            // A batch of rays gives the same results.
+            std::vector<BVHHit> hits;
+            bvh->intersect({ ray, ray2, ray3 }, hits);
+            DJV_ASSERT(3 == hits.size());
+            DJV_ASSERT(front == hits[0].primitive);
+            DJV_ASSERT(back == hits[1].primitive);
+            DJV_ASSERT(!hits[2].primitive);
+        }
+        
+    } // namespace SceneTest
+} // namespace djv
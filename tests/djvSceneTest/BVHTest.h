@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2019-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace SceneTest
+    {
+        class BVHTest : public Test::ITest
+        {
+        public:
+            BVHTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _empty();
+            void _intersect();
+        };
+        
+    } // namespace SceneTest
+} // namespace djv
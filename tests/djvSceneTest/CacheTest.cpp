@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2019-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvSceneTest/CacheTest.h>
+
+#include <djvScene/Cache.h>
+#include <djvScene/MeshPrimitive.h>
+#include <djvScene/Scene.h>
+
+#include <djvAV/TriangleMesh.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+
+#include <cstdio>
+
+using namespace djv::Core;
+using namespace djv::AV;
+using namespace djv::Scene;
+
+namespace djv
+{
+    namespace SceneTest
+    {
+        namespace
+        {
+            FileSystem::FileInfo createSourceFile(const std::string& fileName)
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(fileName, FileSystem::FileIO::Mode::Write);
+                io->write(fileName);
+                io->close();
+                return FileSystem::FileInfo(fileName);
+            }
+
+            std::shared_ptr<Geom::TriangleMesh> createMesh()
+            {
+                auto out = std::shared_ptr<Geom::TriangleMesh>(new Geom::TriangleMesh);
+                out->v.push_back(glm::vec3(0.F, 0.F, 0.F));
+                out->v.push_back(glm::vec3(1.F, 0.F, 0.F));
+                out->v.push_back(glm::vec3(1.F, 1.F, 0.F));
+                out->t.push_back(glm::vec2(0.F, 0.F));
+                out->t.push_back(glm::vec2(1.F, 1.F));
+                out->n.push_back(glm::vec3(0.F, 0.F, 1.F));
+                Geom::TriangleMesh::Triangle triangle;
+                triangle.v0 = Geom::TriangleMesh::Vertex(1, 1, 1);
+                triangle.v1 = Geom::TriangleMesh::Vertex(2, 0, 1);
+                triangle.v2 = Geom::TriangleMesh::Vertex(3, 2, 1);
+                out->triangles.push_back(triangle);
+                out->bboxUpdate();
+                return out;
+            }
+
+            std::shared_ptr<Scene::Scene> createScene(const std::shared_ptr<Geom::TriangleMesh>& mesh)
+            {
+                auto out = Scene::Scene::create();
+                auto primitive = MeshPrimitive::create();
+                primitive->setName("Mesh");
+                primitive->addMesh(mesh);
+                out->addPrimitive(primitive);
+                return out;
+            }
+
+        } // namespace
+
+        CacheTest::CacheTest(const std::shared_ptr<Context>& context) :
+            ITest("djv::SceneTest::CacheTest", context)
+        {}
+        
+        void CacheTest::run()
+        {
+            _io();
+            _corrupt();
+            _prune();
+        }
+
+        void CacheTest::_io()
+        {
+            const auto sourceFileInfo = createSourceFile("CacheTest.obj");
+            const std::string cacheFileName = "CacheTest.djvscene";
+            auto mesh = createMesh();
+            IO::Cache::write(cacheFileName, sourceFileInfo, createScene(mesh));
+            DJV_ASSERT(IO::Cache::isValid(cacheFileName, sourceFileInfo));
+
+            auto scene = IO::Cache::read(cacheFileName, sourceFileInfo);
+            DJV_ASSERT(scene);
+            const auto& primitives = scene->getPrimitives();
+            DJV_ASSERT(1 == primitives.size());
+            DJV_ASSERT("Mesh" == primitives[0]->getName());
+            const auto& meshes = primitives[0]->getMeshes();
+            DJV_ASSERT(1 == meshes.size());
+            DJV_ASSERT(mesh->v == meshes[0]->v);
+            DJV_ASSERT(mesh->t == meshes[0]->t);
+            DJV_ASSERT(mesh->n == meshes[0]->n);
+            DJV_ASSERT(mesh->triangles == meshes[0]->triangles);
+            DJV_ASSERT(mesh->bbox == meshes[0]->bbox);
+
+            const auto sourceFileInfo2 = createSourceFile("CacheTest2.obj");
+            DJV_ASSERT(!IO::Cache::isValid(cacheFileName, sourceFileInfo2));
+            DJV_ASSERT(!IO::Cache::read(cacheFileName, sourceFileInfo2));
+            DJV_ASSERT(!IO::Cache::read("CacheTest.missing", sourceFileInfo));
+        }
+
+        void CacheTest::_corrupt()
+        {
+            const auto sourceFileInfo = createSourceFile("CacheTest.obj");
+            const std::string cacheFileName = "CacheTest.djvscene";
+
+            auto mesh = createMesh();
+            mesh->triangles[0].v1.v = 4;
+            IO::Cache::write(cacheFileName, sourceFileInfo, createScene(mesh));
+            try
+            {
+                IO::Cache::read(cacheFileName, sourceFileInfo);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            mesh = createMesh();
+            mesh->triangles[0].v2.t = 3;
+            IO::Cache::write(cacheFileName, sourceFileInfo, createScene(mesh));
+            try
+            {
+                IO::Cache::read(cacheFileName, sourceFileInfo);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+
+            IO::Cache::write(cacheFileName, sourceFileInfo, createScene(createMesh()));
+            std::vector<uint8_t> data;
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(cacheFileName, FileSystem::FileIO::Mode::Read);
+                data.resize(io->getSize());
+                io->read(data.data(), data.size());
+            }
+            {
+                auto io = FileSystem::FileIO::create();
+                io->open(cacheFileName, FileSystem::FileIO::Mode::Write);
+                io->write(data.data(), data.size() / 2);
+            }
+            try
+            {
+                IO::Cache::read(cacheFileName, sourceFileInfo);
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+        }
+
+        void CacheTest::_prune()
+        {
+            const auto sourceFileInfo = createSourceFile("CacheTest.obj");
+            FileSystem::Path cachePath("CacheTestPrune");
+            if (!FileSystem::FileInfo(cachePath).doesExist())
+            {
+                FileSystem::Path::mkdir(cachePath);
+            }
+            const std::string cacheFileName = IO::Cache::getFileName(cachePath, sourceFileInfo);
+            IO::Cache::write(cacheFileName, sourceFileInfo, createScene(createMesh()));
+            IO::Cache::touch(cacheFileName);
+            const size_t size = FileSystem::FileInfo(cacheFileName).getSize();
+
+            IO::Cache::prune(cachePath, size);
+            DJV_ASSERT(FileSystem::FileInfo(cacheFileName).doesExist());
+            IO::Cache::prune(cachePath, size - 1);
+            DJV_ASSERT(!FileSystem::FileInfo(cacheFileName).doesExist());
+        }
+
+    } // namespace SceneTest
+} // namespace djv
+
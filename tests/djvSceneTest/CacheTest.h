@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2019-2020 Darby Johnston
+// All rights reserved.
+
+#include <djvTestLib/Test.h>
+
+namespace djv
+{
+    namespace SceneTest
+    {
+        class CacheTest : public Test::ITest
+        {
+        public:
+            CacheTest(const std::shared_ptr<Core::Context>&);
+            
+            void run() override;
+        
+        private:
+            void _io();
+            void _corrupt();
+            void _prune();
+        };
+        
+    } // namespace SceneTest
+} // namespace djv
+
@@ -27,9 +27,11 @@
 #include <djvCoreTest/PathTest.h>
 #include <djvCoreTest/PicoJSONTest.h>
 #include <djvCoreTest/RangeTest.h>
+#include <djvCoreTest/ReadAheadTest.h>
 #include <djvCoreTest/SpeedTest.h>
 #include <djvCoreTest/StringFormatTest.h>
 #include <djvCoreTest/StringTest.h>
+#include <djvCoreTest/TextCatalogTest.h>
 #include <djvCoreTest/TextSystemTest.h>
 #include <djvCoreTest/TimeTest.h>
 #include <djvCoreTest/ValueObserverTest.h>
@@ -39,18 +41,29 @@
 #include <djvAVTest/AudioDataTest.h>
 #include <djvAVTest/AudioTest.h>
 #include <djvAVTest/ColorTest.h>
+#include <djvAVTest/DPXTest.h>
 #include <djvAVTest/EnumTest.h>
 #include <djvAVTest/FontSystemTest.h>
+#include <djvAVTest/IODecodeTest.h>
 #include <djvAVTest/IOTest.h>
+#include <djvAVTest/ImageAtlasPackerTest.h>
 #include <djvAVTest/ImageConvertTest.h>
 #include <djvAVTest/ImageDataTest.h>
+#include <djvAVTest/ImageStatsTest.h>
 #include <djvAVTest/ImageTest.h>
 #include <djvAVTest/OCIOSystemTest.h>
 #include <djvAVTest/OCIOTest.h>
 #include <djvAVTest/PixelTest.h>
+#include <djvAVTest/Render2DImageProcessorTest.h>
+#include <djvAVTest/Render2DRasterizerTest.h>
 #include <djvAVTest/Render2DTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TagsTest.h>
+#include <djvAVTest/TriangleMeshBVHTest.h>
+#include <djvAVTest/TriangleMeshWeldTest.h>
+
+#include <djvSceneTest/BVHTest.h>
+#include <djvSceneTest/CacheTest.h>
 
 #include <djvUITest/EnumTest.h>
 #include <djvUITest/WidgetTest.h>
@@ -99,9 +112,11 @@ int main(int argc, char ** argv)
         tests.emplace_back(new CoreTest::PathTest(context));
         tests.emplace_back(new CoreTest::PicoJSONTest(context));
         tests.emplace_back(new CoreTest::RangeTest(context));
+        tests.emplace_back(new CoreTest::ReadAheadTest(context));
         tests.emplace_back(new CoreTest::SpeedTest(context));
         tests.emplace_back(new CoreTest::StringFormatTest(context));
         tests.emplace_back(new CoreTest::StringTest(context));
+        tests.emplace_back(new CoreTest::TextCatalogTest(context));
         tests.emplace_back(new CoreTest::TextSystemTest(context));
         tests.emplace_back(new CoreTest::TimeTest(context));
         tests.emplace_back(new CoreTest::ValueObserverTest(context));
@@ -111,18 +126,29 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AVTest::AudioDataTest(context));
         tests.emplace_back(new AVTest::AudioTest(context));
         tests.emplace_back(new AVTest::ColorTest(context));
+        tests.emplace_back(new AVTest::DPXTest(context));
         tests.emplace_back(new AVTest::EnumTest(context));
         tests.emplace_back(new AVTest::FontSystemTest(context));
+        tests.emplace_back(new AVTest::IODecodeTest(context));
         tests.emplace_back(new AVTest::IOTest(context));
+        tests.emplace_back(new AVTest::ImageAtlasPackerTest(context));
         tests.emplace_back(new AVTest::ImageConvertTest(context));
         tests.emplace_back(new AVTest::ImageDataTest(context));
+        tests.emplace_back(new AVTest::ImageStatsTest(context));
         tests.emplace_back(new AVTest::ImageTest(context));
         tests.emplace_back(new AVTest::OCIOSystemTest(context));
         tests.emplace_back(new AVTest::OCIOTest(context));
         tests.emplace_back(new AVTest::PixelTest(context));
+        tests.emplace_back(new AVTest::Render2DImageProcessorTest(context));
+        tests.emplace_back(new AVTest::Render2DRasterizerTest(context));
         tests.emplace_back(new AVTest::Render2DTest(context));
         tests.emplace_back(new AVTest::ThumbnailSystemTest(context));
         tests.emplace_back(new AVTest::TagsTest(context));
+        tests.emplace_back(new AVTest::TriangleMeshBVHTest(context));
+        tests.emplace_back(new AVTest::TriangleMeshWeldTest(context));
+
+        tests.emplace_back(new SceneTest::BVHTest(context));
+        tests.emplace_back(new SceneTest::CacheTest(context));
 
         tests.emplace_back(new UITest::EnumTest(context));
         tests.emplace_back(new UITest::WidgetTest(context));